@@ -72,6 +72,10 @@
  * globals
  */
 static bool quiet = false;				/* true ==> quiet mode */
+static struct json_limits entry_json_limits = {	/* resource limits on parsing an entry JSON file */
+    MAX_ENTRY_JSON_BYTES, MAX_ENTRY_JSON_DEPTH, MAX_ENTRY_JSON_NODES,
+    MAX_ENTRY_JSON_STR_LEN, MAX_ENTRY_JSON_NUM_LEN, MAX_ENTRY_JSON_MEMBERS
+};
 
 /*
  * usage message
@@ -495,7 +499,7 @@ main(int argc, char *argv[])
      * parse .info.json if it is open
      */
     if (info_stream != NULL) {
-	info_tree = parse_json_stream(info_stream, info_path, &info_valid);
+	info_tree = parse_json_stream_limits(info_stream, info_path, &entry_json_limits, &info_valid);
 	if (info_valid == false || info_tree == NULL) {
 	    err(4, __func__, "failed to parse JSON in .info.json file: %s", info_path); /*ooo*/
 	    not_reached();
@@ -507,7 +511,7 @@ main(int argc, char *argv[])
      * parse .auth.json if it is open
      */
     if (auth_stream != NULL) {
-	auth_tree = parse_json_stream(auth_stream, auth_path, &auth_valid);
+	auth_tree = parse_json_stream_limits(auth_stream, auth_path, &entry_json_limits, &auth_valid);
 	if (auth_valid == false || auth_tree == NULL) {
 	    err(4, __func__, "failed to parse JSON in .auth.json file: %s", auth_path); /*ooo*/
 	    not_reached();
@@ -762,6 +766,7 @@ main(int argc, char *argv[])
 	free_val_err(auth_val_err);
 	auth_val_err = NULL;
     }
+    json_sem_free_index(NULL);
     if (info_path != NULL) {
 	free(info_path);
 	info_path = NULL;
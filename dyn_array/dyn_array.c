@@ -71,6 +71,7 @@ const char *const dyn_array_version = DYN_ARRAY_VERSION;	/* library version form
  * external allocation functions
  */
 static bool dyn_array_grow(struct dyn_array *array, intmax_t elms_to_allocate);
+static intmax_t dyn_array_grow_count(struct dyn_array *array, intmax_t elms_needed);
 static enum ptr_compare compare_addr(void *a, void *b);
 static enum move_case determine_move_case(void *first_alloc, void *last_alloc, void *first_add, void *last_add);
 static char const *move_case_name(enum move_case mv_case);
@@ -206,6 +207,62 @@ dyn_array_grow(struct dyn_array *array, intmax_t elms_to_allocate)
 }
 
 
+/*
+ * dyn_array_grow_count - determine how many elements to grow a dynamic array by
+ *
+ * given:
+ *      array			pointer to the dynamic array
+ *      elms_needed		number of elements needed beyond those allocated
+ *
+ * returns:
+ *	number of elements to grow the allocation by, a multiple of array->chunk
+ *	that is >= elms_needed
+ *
+ * The number depends on the growth policy of the dynamic array: see
+ * enum dyn_array_growth and dyn_array_set_growth().
+ *
+ * NOTE: The array is assumed to have passed the firewall of the caller.
+ */
+static intmax_t
+dyn_array_grow_count(struct dyn_array *array, intmax_t elms_needed)
+{
+    intmax_t grow = 0;		/* number of elements to grow by */
+
+    /*
+     * grow by a percent of the allocation, if the policy is geometric
+     */
+    switch (array->growth) {
+    case DYN_ARRAY_GROW_GEOMETRIC:
+    case DYN_ARRAY_GROW_CAPPED:
+	if (array->grow_pct > 0 && array->allocated > INTMAX_MAX / array->grow_pct) {
+	    /* too big for a percent: let dyn_array_grow() report the size */
+	    grow = INTMAX_MAX / 2;
+	} else {
+	    grow = array->allocated * array->grow_pct / 100;
+	}
+	if (array->growth == DYN_ARRAY_GROW_CAPPED && grow > array->grow_cap) {
+	    grow = array->grow_cap;
+	}
+	break;
+    case DYN_ARRAY_GROW_CHUNK:
+    default:
+	grow = 0;
+	break;
+    }
+
+    /*
+     * grow by at least what is needed, in whole chunks
+     */
+    if (grow < elms_needed) {
+	grow = elms_needed;
+    }
+    if (grow <= INTMAX_MAX - array->chunk) {
+	grow = array->chunk * ((grow + (array->chunk - 1)) / array->chunk);
+    }
+    return grow;
+}
+
+
 /*
  * compare_addr - compare two addresses
  *
@@ -687,6 +744,10 @@ dyn_array_create(size_t elm_size, intmax_t chunk, intmax_t start_elm_count, bool
     /* Allocate a number of elements multiple of chunk */
     ret->allocated = chunk * ((start_elm_count + (chunk - 1)) / chunk);
     ret->chunk = chunk;
+    /* grow by a fixed chunk until dyn_array_set_growth() says otherwise */
+    ret->growth = DYN_ARRAY_GROW_CHUNK;
+    ret->grow_pct = 0;
+    ret->grow_cap = 0;
 
     /*
      * determine the size of the allocated area
@@ -901,8 +962,7 @@ dyn_array_append_set(struct dyn_array *array, void *array_to_add_p, intmax_t cou
 	/*
 	 * determine the new allocated data size that as need
 	 */
-	required_elements_to_allocate = array->chunk *
-		((count_of_elements_to_add - available_empty_elements + (array->chunk - 1)) / array->chunk);
+	required_elements_to_allocate = dyn_array_grow_count(array, count_of_elements_to_add - available_empty_elements);
 
 	/*
 	 * expand the allocated data and note of the data moved
@@ -1392,8 +1452,16 @@ dyn_array_seek(struct dyn_array *array, off_t offset, int whence)
      */
     } else {
 
-	/* grow the array */
-	moved = dyn_array_grow(array, setpoint - array->allocated);
+	/*
+	 * grow the array
+	 *
+	 * A fixed chunk dynamic array grows to just the setpoint, as it always has.
+	 */
+	if (array->growth == DYN_ARRAY_GROW_CHUNK) {
+	    moved = dyn_array_grow(array, setpoint - array->allocated);
+	} else {
+	    moved = dyn_array_grow(array, dyn_array_grow_count(array, setpoint - array->allocated));
+	}
     }
 
     /* set new in use count */
@@ -1537,6 +1605,9 @@ dyn_array_free(struct dyn_array *array)
     array->count = 0;
     array->allocated = 0;
     array->chunk = 0;
+    array->growth = DYN_ARRAY_GROW_CHUNK;
+    array->grow_pct = 0;
+    array->grow_cap = 0;
     if (dbg_allowed(DBG_VVVHIGH)) {
 	dbg(DBG_VVVHIGH, "in %s(array)", __func__);
     }
@@ -1546,3 +1617,269 @@ dyn_array_free(struct dyn_array *array)
 
     return;
 }
+
+
+/*
+ * dyn_array_set_growth - set how a dynamic array grows
+ *
+ * given:
+ *      array		- pointer to the dynamic array
+ *	growth		- DYN_ARRAY_GROW_CHUNK ==> grow by a fixed chunk
+ *			  DYN_ARRAY_GROW_GEOMETRIC ==> grow by grow_pct percent of the allocation
+ *			  DYN_ARRAY_GROW_CAPPED ==> grow by grow_pct percent of the allocation,
+ *						    but by no more than grow_cap elements
+ *	grow_pct	- percent of the allocation to grow by, ignored for DYN_ARRAY_GROW_CHUNK
+ *	grow_cap	- most elements to grow by at a time, ignored unless DYN_ARRAY_GROW_CAPPED
+ *
+ * A dynamic array formed by dyn_array_create() grows by a fixed chunk, so
+ * that n appends copy O(n^2) elements when the array moves.  A geometric
+ * growth, such as DYN_ARRAY_GROW_PCT, makes each append O(1) amortized at
+ * the cost of up to grow_pct percent of unused allocation.  The cap bounds
+ * that cost for very large arrays.
+ *
+ * Elements already allocated are not changed.
+ *
+ * NOTE: This function does not return on error.
+ */
+void
+dyn_array_set_growth(struct dyn_array *array, enum dyn_array_growth growth, intmax_t grow_pct, intmax_t grow_cap)
+{
+    /*
+     * Check preconditions (firewall) - sanity check args
+     */
+    if (array == NULL) {
+	err(131, __func__, "array arg is NULL");
+	not_reached();
+    }
+    switch (growth) {
+    case DYN_ARRAY_GROW_CHUNK:
+	grow_pct = 0;
+	grow_cap = 0;
+	break;
+    case DYN_ARRAY_GROW_GEOMETRIC:
+    case DYN_ARRAY_GROW_CAPPED:
+	if (grow_pct <= 0) {
+	    err(132, __func__, "grow_pct must be > 0: %jd", grow_pct);
+	    not_reached();
+	}
+	if (growth == DYN_ARRAY_GROW_CAPPED) {
+	    if (grow_cap <= 0) {
+		err(133, __func__, "grow_cap must be > 0: %jd", grow_cap);
+		not_reached();
+	    }
+	} else {
+	    grow_cap = 0;
+	}
+	break;
+    default:
+	err(134, __func__, "growth is an unknown enum value: %d", (int)growth);
+	not_reached();
+	break;
+    }
+
+    /*
+     * set the growth policy
+     */
+    array->growth = growth;
+    array->grow_pct = grow_pct;
+    array->grow_cap = grow_cap;
+    if (dbg_allowed(DBG_VVVHIGH)) {
+	dbg(DBG_VVVHIGH, "in %s(array, %d, %jd, %jd): allocated: %jd elements of size: %ju in use: %jd",
+		     __func__, (int)growth, grow_pct, grow_cap,
+		     dyn_array_alloced(array),
+		     (uintmax_t)array->elm_size,
+		     dyn_array_tell(array));
+    }
+    return;
+}
+
+
+/*
+ * dyn_array_reserve - allocate room for a number of elements in a dynamic array
+ *
+ * given:
+ *      array		- pointer to the dynamic array
+ *	elm_count	- number of elements the dynamic array is to have room for
+ *
+ * returns:
+ *	true ==> address of the array of elements moved during realloc()
+ *	false ==> address of the elements array did not move
+ *
+ * The allocation grows, by whole chunks, to at least elm_count elements so
+ * that elm_count elements may then be appended without a realloc().  The
+ * allocation is not changed if it already has room for elm_count elements.
+ * The number of elements in use is not changed.
+ *
+ * NOTE: This function does not return on error.
+ */
+bool
+dyn_array_reserve(struct dyn_array *array, intmax_t elm_count)
+{
+    bool moved = false;		/* true ==> location of the elements array moved during realloc() */
+    intmax_t needed = 0;	/* number of elements beyond those allocated */
+
+    /*
+     * Check preconditions (firewall) - sanity check args
+     */
+    if (array == NULL) {
+	err(135, __func__, "array arg is NULL");
+	not_reached();
+    }
+
+    /*
+     * Check preconditions (firewall) - sanity check array
+     */
+    if (array->data == NULL) {
+	err(136, __func__, "array->data in dynamic array is NULL");
+	not_reached();
+    }
+    if (array->elm_size <= 0) {
+	err(137, __func__, "array->elm_size in dynamic array must be > 0: %ju", (uintmax_t)array->elm_size);
+	not_reached();
+    }
+    if (array->chunk <= 0) {
+	err(138, __func__, "array->chunk in dynamic array must be > 0: %jd", array->chunk);
+	not_reached();
+    }
+    if (array->allocated <= 0) {
+	err(139, __func__, "array->allocated in dynamic array must be > 0: %jd", array->allocated);
+	not_reached();
+    }
+    if (array->count > array->allocated) {
+	err(140, __func__, "array->count: %jd in dynamic array must be <= array->allocated: %jd",
+			  array->count, array->allocated);
+	not_reached();
+    }
+
+    /*
+     * grow by whole chunks if there is not enough room
+     */
+    if (elm_count > array->allocated) {
+	needed = elm_count - array->allocated;
+	moved = dyn_array_grow(array, array->chunk * ((needed + (array->chunk - 1)) / array->chunk));
+    }
+    if (dbg_allowed(DBG_VVVVVHIGH)) {
+	dbg(DBG_VVVVVHIGH, "in %s(array, %jd): %s: allocated: %jd elements of size: %ju in use: %jd",
+		       __func__, elm_count,
+		       (moved == true ? "moved" : "in-place"),
+		       dyn_array_alloced(array),
+		       (uintmax_t)array->elm_size,
+		       dyn_array_tell(array));
+    }
+
+    /* return array moved condition */
+    return moved;
+}
+
+
+/*
+ * dyn_array_shrink_to_fit - free the allocated elements a dynamic array is not using
+ *
+ * given:
+ *      array		- pointer to the dynamic array
+ *
+ * returns:
+ *	true ==> address of the array of elements moved during realloc()
+ *	false ==> address of the elements array did not move
+ *
+ * The allocation shrinks to the fewest chunks that hold the elements in use,
+ * and to at least one chunk.  The guard chunk is kept.  Elements that are
+ * freed are zeroized first if array->zeroize is true.
+ *
+ * This is useful once a dynamic array that grows geometrically is done growing.
+ *
+ * NOTE: This function does not return on error.
+ */
+bool
+dyn_array_shrink_to_fit(struct dyn_array *array)
+{
+    void *data;			/* Reallocated array */
+    intmax_t new_allocated;	/* New number of elements allocated */
+    intmax_t old_bytes;		/* Old size of data in dynamic array */
+    intmax_t new_bytes;		/* New size of data in dynamic array after reallocation */
+    bool moved = false;		/* true ==> location of the elements array moved during realloc() */
+
+    /*
+     * Check preconditions (firewall) - sanity check args
+     */
+    if (array == NULL) {
+	err(141, __func__, "array arg is NULL");
+	not_reached();
+    }
+
+    /*
+     * Check preconditions (firewall) - sanity check array
+     */
+    if (array->data == NULL) {
+	err(142, __func__, "array->data in dynamic array is NULL");
+	not_reached();
+    }
+    if (array->elm_size <= 0) {
+	err(143, __func__, "array->elm_size in dynamic array must be > 0: %ju", (uintmax_t)array->elm_size);
+	not_reached();
+    }
+    if (array->chunk <= 0) {
+	err(144, __func__, "array->chunk in dynamic array must be > 0: %jd", array->chunk);
+	not_reached();
+    }
+    if (array->allocated <= 0) {
+	err(145, __func__, "array->allocated in dynamic array must be > 0: %jd", array->allocated);
+	not_reached();
+    }
+    if (array->count > array->allocated) {
+	err(146, __func__, "array->count: %jd in dynamic array must be <= array->allocated: %jd",
+			  array->count, array->allocated);
+	not_reached();
+    }
+
+    /*
+     * determine the size of the realloced area
+     */
+    if (array->count > 0) {
+	new_allocated = array->chunk * ((array->count + (array->chunk - 1)) / array->chunk);
+    } else {
+	new_allocated = array->chunk;
+    }
+    if (new_allocated >= array->allocated) {
+	/* nothing to free */
+	return false;
+    }
+    /* +array->chunk for guard chunk */
+    old_bytes = (array->allocated+array->chunk) * (intmax_t)array->elm_size;
+    new_bytes = (new_allocated+array->chunk) * (intmax_t)array->elm_size;
+
+    /*
+     * Zeroize the elements to be freed if requested
+     */
+    if (array->zeroize == true) {
+	memset((uint8_t *)array->data + new_bytes, 0, old_bytes - new_bytes);
+    }
+
+    /*
+     * reallocate array
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    data = realloc(array->data, (size_t)new_bytes);
+    if (data == NULL) {
+	errp(147, __func__, "failed to reallocate the dynamic array from a size of %jd bytes "
+			    "to a size of %jd bytes",
+			    old_bytes, new_bytes);
+	not_reached();
+    }
+    if (array->data != data) {
+	moved = true;
+    }
+    array->data = data;
+    array->allocated = new_allocated;
+    if (dbg_allowed(DBG_VVVVHIGH)) {
+	dbg(DBG_VVVVHIGH, "in %s(array): %s: allocated: %jd elements of size: %ju in use: %jd",
+			  __func__,
+			  (moved == true ? "moved" : "in-place"),
+			  dyn_array_alloced(array),
+			  (uintmax_t)array->elm_size,
+			  dyn_array_tell(array));
+    }
+
+    /* return array moved condition */
+    return moved;
+}
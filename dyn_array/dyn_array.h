@@ -59,7 +59,7 @@
 /*
  * official version
  */
-#define DYN_ARRAY_VERSION "2.3 2023-02-04"	/* format: major.minor YYYY-MM-DD */
+#define DYN_ARRAY_VERSION "2.4 2026-10-16"	/* format: major.minor YYYY-MM-DD */
 
 
 /*
@@ -122,6 +122,34 @@
 #define dyn_array_rewind(array) (dyn_array_seek((struct dyn_array *)(array), 0, SEEK_SET))
 
 
+/*
+ * definitions
+ */
+#define DYN_ARRAY_GROW_PCT (100)	/* default percent of the allocation to grow by: 100 ==> double */
+
+
+/*
+ * dyn_array_growth - how a dynamic array grows when it runs out of allocated elements
+ *
+ * DYN_ARRAY_GROW_CHUNK grows by the fewest chunks that hold the new elements.
+ * This is the growth of a dynamic array formed by dyn_array_create().
+ *
+ * DYN_ARRAY_GROW_GEOMETRIC grows by a percent of the elements already
+ * allocated, so that n appends copy O(n) elements in all.
+ *
+ * DYN_ARRAY_GROW_CAPPED grows as DYN_ARRAY_GROW_GEOMETRIC does, but by no
+ * more than a given number of elements at a time.
+ *
+ * Under each policy a dynamic array grows by a multiple of chunk, and by at
+ * least the number of elements needed.
+ */
+enum dyn_array_growth {
+    DYN_ARRAY_GROW_CHUNK = 0,	/* grow by a fixed chunk */
+    DYN_ARRAY_GROW_GEOMETRIC,	/* grow by a percent of the allocation */
+    DYN_ARRAY_GROW_CAPPED,	/* grow by a percent of the allocation up to a cap */
+};
+
+
 /*
  * dyn_array - a dynamic array of elements of the same type
  *
@@ -142,6 +170,9 @@ struct dyn_array
     intmax_t count;		/* Number of elements in use */
     intmax_t allocated;		/* Number of elements allocated (>= count) */
     intmax_t chunk;		/* Number of elements to expand by when allocating */
+    enum dyn_array_growth growth;	/* how the allocation grows when more elements are needed */
+    intmax_t grow_pct;		/* percent of the allocation to grow by if not DYN_ARRAY_GROW_CHUNK */
+    intmax_t grow_cap;		/* most elements to grow by at a time if DYN_ARRAY_GROW_CAPPED */
     void *data;			/* allocated dynamic array of identical things or NULL */
 };
 
@@ -162,6 +193,9 @@ extern bool dyn_array_concat_array(struct dyn_array *array, struct dyn_array *ot
 extern bool dyn_array_seek(struct dyn_array *array, off_t offset, int whence);
 extern void dyn_array_clear(struct dyn_array *array);
 extern void dyn_array_free(struct dyn_array *array);
+extern void dyn_array_set_growth(struct dyn_array *array, enum dyn_array_growth growth, intmax_t grow_pct, intmax_t grow_cap);
+extern bool dyn_array_reserve(struct dyn_array *array, intmax_t elm_count);
+extern bool dyn_array_shrink_to_fit(struct dyn_array *array);
 
 
 #endif		/* INCLUDE_DYN_ARRAY_H */
@@ -36,6 +36,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <time.h>
 
 /*
  * dyn_array_test - test the dynamic array facility
@@ -48,6 +49,8 @@
  */
 #define REQUIRED_ARGS (0)	/* number of required arguments on the command line */
 #define CHUNK (1024)		/* allocate CHUNK elements at a time */
+#define GROW_COUNT (1000000)	/* number of doubles to append when comparing growth policies */
+#define GROW_CAP (65536)	/* most elements a capped geometric dynamic array grows by at a time */
 
 /*
  * usage message
@@ -79,6 +82,8 @@ static const char * const usage_msg =
 #if !defined(DBG_USE)
 static int parse_verbosity(char const *optarg);
 #endif
+static bool growth_test(char const *name, enum dyn_array_growth growth, intmax_t grow_pct, intmax_t grow_cap,
+			intmax_t *grows);
 static void usage(int exitcode, char const *str, char const *prog) __attribute__((noreturn));
 
 int
@@ -89,6 +94,10 @@ main(int argc, char *argv[])
     double d;			/* test double */
     bool error = false;		/* true ==> test error found */
     intmax_t len = 0;		/* length of the dynamic array */
+    intmax_t alloced = 0;	/* number of elements allocated in the dynamic array */
+    intmax_t fixed_grows = 0;	/* number of times a fixed chunk dynamic array grew */
+    intmax_t geo_grows = 0;	/* number of times a geometric dynamic array grew */
+    intmax_t capped_grows = 0;	/* number of times a capped geometric dynamic array grew */
     int i;
 
     /*
@@ -208,6 +217,81 @@ main(int argc, char *argv[])
 	array = NULL;
     }
 
+    /*
+     * compare the growth policies
+     *
+     * A geometric dynamic array must grow far fewer times than a fixed
+     * chunk one, and a capped one must fall in between.  Timings are
+     * reported at -v 1 and higher, but not tested.
+     */
+    if (growth_test("fixed chunk", DYN_ARRAY_GROW_CHUNK, 0, 0, &fixed_grows) == false) {
+	error = true;
+    }
+    if (growth_test("geometric", DYN_ARRAY_GROW_GEOMETRIC, DYN_ARRAY_GROW_PCT, 0, &geo_grows) == false) {
+	error = true;
+    }
+    if (growth_test("capped geometric", DYN_ARRAY_GROW_CAPPED, DYN_ARRAY_GROW_PCT, GROW_CAP,
+		    &capped_grows) == false) {
+	error = true;
+    }
+    if (geo_grows >= capped_grows || capped_grows >= fixed_grows) {
+	warn(__func__, "expected geometric grows: %jd < capped geometric grows: %jd < fixed chunk grows: %jd",
+		       geo_grows, capped_grows, fixed_grows);
+	error = true;
+    }
+
+    /*
+     * appending after a reserve must not grow the dynamic array
+     */
+    array = dyn_array_create(sizeof(double), CHUNK, CHUNK, true);
+    if (dyn_array_reserve(array, GROW_COUNT)) {
+	dbg(DBG_LOW, "moved data after reserve");
+    }
+    alloced = dyn_array_alloced(array);
+    if (alloced < GROW_COUNT) {
+	warn(__func__, "dyn_array_alloced(array): %jd < %jd after reserve", alloced, (intmax_t)GROW_COUNT);
+	error = true;
+    }
+    for (d = 0.0; d < (double)GROW_COUNT; d += 1.0) {
+	if (dyn_array_append_value(array, &d)) {
+	    warn(__func__, "moved data after reserve while appending d: %f", d);
+	    error = true;
+	}
+    }
+    if (dyn_array_alloced(array) != alloced) {
+	warn(__func__, "dyn_array_alloced(array): %jd != %jd: grew after reserve",
+		       dyn_array_alloced(array), alloced);
+	error = true;
+    }
+
+    /*
+     * shrink to fit after a seek back, keeping the values in use
+     */
+    if (dyn_array_seek(array, GROW_COUNT / 2, SEEK_SET)) {
+	dbg(DBG_LOW, "moved data after seek");
+    }
+    if (dyn_array_shrink_to_fit(array)) {
+	dbg(DBG_LOW, "moved data after shrink to fit");
+    }
+    alloced = CHUNK * ((GROW_COUNT / 2 + (CHUNK - 1)) / CHUNK);
+    if (dyn_array_alloced(array) != alloced) {
+	warn(__func__, "dyn_array_alloced(array): %jd != %jd after shrink to fit", dyn_array_alloced(array), alloced);
+	error = true;
+    }
+    len = dyn_array_tell(array);
+    if (len != GROW_COUNT / 2) {
+	warn(__func__, "dyn_array_tell(array): %jd != %jd after shrink to fit", len, (intmax_t)(GROW_COUNT / 2));
+	error = true;
+    }
+    for (i = 0; i < GROW_COUNT / 2; ++i) {
+	if ((intmax_t)i != (intmax_t)dyn_array_value(array, double, i)) {
+	    warn(__func__, "value mismatch after shrink to fit %d != %f", i, dyn_array_value(array, double, i));
+	    error = true;
+	}
+    }
+    dyn_array_free(array);
+    array = NULL;
+
     /*
      * exit based on the test result
      */
@@ -218,6 +302,76 @@ main(int argc, char *argv[])
 }
 
 
+/*
+ * growth_test - time appending doubles to a dynamic array with a given growth policy
+ *
+ * given:
+ *	name		name of the growth policy for messages
+ *	growth		growth policy to test
+ *	grow_pct	percent of the allocation to grow by, see dyn_array_set_growth()
+ *	grow_cap	most elements to grow by at a time, see dyn_array_set_growth()
+ *	grows		pointer to where to place the number of times the dynamic array grew
+ *
+ * returns:
+ *	true ==> all values appended were found
+ *	false ==> some value was not found
+ */
+static bool
+growth_test(char const *name, enum dyn_array_growth growth, intmax_t grow_pct, intmax_t grow_cap,
+	    intmax_t *grows)
+{
+    struct dyn_array *array;	/* dynamic array to test */
+    struct timespec start;	/* time before appending */
+    struct timespec stop;	/* time after appending */
+    intmax_t alloced = 0;	/* number of elements allocated before an append */
+    intmax_t moves = 0;		/* number of appends that moved the data */
+    double d;			/* test double */
+    bool ok = true;		/* false ==> test error found */
+    int i;
+
+    /*
+     * firewall
+     */
+    if (name == NULL || grows == NULL) {
+	err(10, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    *grows = 0;
+
+    /*
+     * append doubles one at a time, counting the grows
+     */
+    array = dyn_array_create(sizeof(double), CHUNK, CHUNK, true);
+    dyn_array_set_growth(array, growth, grow_pct, grow_cap);
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    for (d = 0.0; d < (double)GROW_COUNT; d += 1.0) {
+	alloced = dyn_array_alloced(array);
+	if (dyn_array_append_value(array, &d)) {
+	    ++moves;
+	}
+	if (dyn_array_alloced(array) != alloced) {
+	    ++*grows;
+	}
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &stop);
+    dbg(DBG_LOW, "%s growth: appends: %d grows: %jd moves: %jd allocated: %jd time: %.6f sec",
+		 name, GROW_COUNT, *grows, moves, dyn_array_alloced(array),
+		 (double)(stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1e9);
+
+    /*
+     * verify values
+     */
+    for (i = 0; i < GROW_COUNT; ++i) {
+	if ((intmax_t)i != (intmax_t)dyn_array_value(array, double, i)) {
+	    warn(__func__, "%s growth: value mismatch %d != %f", name, i, dyn_array_value(array, double, i));
+	    ok = false;
+	}
+    }
+    dyn_array_free(array);
+    return ok;
+}
+
+
 #if !defined(DBG_USE)
 /*
  * parse_verbosity - parse -v optarg for our tools
@@ -41,7 +41,7 @@ static bool quiet = false;				/* true ==> quiet mode */
  */
 static const char * const usage_msg0 =
     "usage:\t%s [-h] [-V] [-v level] [-J level] [-q] [-L <num>{[t|s]}] [-I <num>{[t|s]}]\n"
-    "\t[-l lvl] [-m depth] [-K] [-o ofile] [-F fmt] file.json\n"
+    "\t[-l lvl] [-m depth] [-K] [-o ofile] [-F fmt] [-B dir] [-R limits] file.json\n"
     "\n"
     "\t-h\t\tPrint help and exit\n"
     "\t-V\t\tPrint version and exit\n"
@@ -84,6 +84,15 @@ static const char * const usage_msg0 =
     "\t\t\t1line\t\tOne line output\n"
     "\t\t\tnows\t\tOne line output, no extra whitespace\n"
     "\n"
+    "\t-B dir\t\tKeep a .jtree tape of file.json in the cache directory dir, so that later runs\n"
+    "\t\t\ton the unchanged file.json map the tape instead of parsing (def: do not cache)\n"
+    "\n"
+    "\t-R limits\tStop parsing file.json at the first resource limit it crosses (def: no limits)\n"
+    "\n"
+    "\t\t\tlimits is a comma separated list of name=value where name is one of: bytes,\n"
+    "\t\t\tdepth, nodes, string, number or members and a value of 0 means no limit.\n"
+    "\t\t\tUsing -R with -B is an error.\n"
+    "\n"
     "\tfile.json\tJSON file to parse (- ==> read from stdin)\n"
     "\n"
     "Exit codes:\n"
@@ -155,9 +164,10 @@ main(int argc, char **argv)
     extern char *optarg;
     extern int optind;
     struct jfmt *jfmt = NULL;	/* struct of all our options and other things */
-    size_t len = 0;			/* length of file contents */
     bool is_valid = false;		/* if file is valid json */
     int exit_code = 0;			/* for the end */
+    struct json_writer *writer = NULL;	/* buffered JSON writer of the output */
+    char *indent = NULL;		/* -I indent of each level */
     int i;
 
     jfmt = alloc_jfmt();		/* allocate our struct jfmt * */
@@ -174,7 +184,7 @@ main(int argc, char **argv)
      * parse args
      */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hVv:J:qL:I:l:m:Ko:F:")) != -1) {
+    while ((i = getopt(argc, argv, ":hVv:J:qL:I:l:m:Ko:F:B:R:")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 0 */
 	    free_jfmt(&jfmt);
@@ -254,6 +264,16 @@ main(int argc, char **argv)
 	    jfmt->common.format = JSON_FMT_TTY; /* assume default */
 	    jfmt->common.format = parse_json_util_format(&jfmt->common, "jfmt", optarg);
 	    break;
+	case 'B': /* -B dir - cache directory of .jtree tape files */
+	    jfmt->common.tape_dir = optarg;
+	    break;
+	case 'R': /* -R limits - resource limits of the parse */
+	    if (!json_util_parse_limits(optarg, &jfmt->common.limits)) {
+		usage(3, program, "invalid -R limits"); /*ooo*/
+		not_reached();
+	    }
+	    jfmt->common.limits_used = true;
+	    break;
 	case ':':   /* option requires an argument */
 	case '?':   /* illegal option */
 	default:    /* anything else but should not actually happen */
@@ -290,21 +310,22 @@ main(int argc, char **argv)
     }
 
     /*
-     * Read in contents of file.
+     * Read in contents of file (a regular file is mapped rather than copied).
      *
      * NOTE: why doesn't the jfmt_sanity_chks() function do this? Because this
      * is not so much about a sane environment as much as being unable to
      * continue after verify the command line is correct.
      */
-    jfmt->common.file_contents = read_all(jfmt->common.json_file, &len);
+    jfmt->common.file_contents = json_read_all_limits(jfmt->common.json_file, &jfmt->common.file_len,
+						   &jfmt->common.file_mapped,
+						   jfmt->common.limits_used ? &jfmt->common.limits : NULL);
     if (jfmt->common.file_contents == NULL) {
 	err(4, "jfmt", "could not read in file: %s", argv[0]); /*ooo*/
 	not_reached();
     }
 
-    jfmt->common.json_tree = parse_json(jfmt->common.file_contents, strlen(jfmt->common.file_contents),
-	    jfmt->common.json_file_path, &is_valid);
-    if (!is_valid || jfmt->common.json_tree == NULL) {
+    is_valid = json_util_parse_json(&jfmt->common);
+    if (!is_valid) {
 	if (jfmt->common.json_file != stdin) {
 	    fclose(jfmt->common.json_file);  /* close file prior to exiting */
 	    jfmt->common.json_file = NULL;   /* set to NULL even though we're exiting as a safety precaution */
@@ -331,8 +352,35 @@ main(int argc, char **argv)
 	}
     }
 
-    /* XXX - change this to format the file - XXX */
-    fpr(jfmt->common.outfile?jfmt->common.outfile:stdout, "jfmt", "%s", jfmt->common.file_contents);
+    /*
+     * a mapped tape is not a parse tree: form the tree from the tape
+     */
+    if (jfmt->common.json_tree == NULL && jfmt->common.json_tape != NULL) {
+	jfmt->common.json_tree = json_tape_to_tree(jfmt->common.json_tape);
+	if (jfmt->common.json_tree == NULL) {
+	    err(25, "jfmt", "%s: could not form the JSON parse tree from its tape", argv[0]);
+	    not_reached();
+	}
+    }
+
+    /*
+     * write the JSON, each level indented by the -I indent
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    indent = calloc(jfmt->common.indent_spaces + 1, sizeof(char));
+    if (indent == NULL) {
+	errp(26, "jfmt", "calloc of %ju bytes failed", jfmt->common.indent_spaces + 1);
+	not_reached();
+    }
+    memset(indent, jfmt->common.indent_tab ? '\t' : ' ', jfmt->common.indent_spaces);
+    writer = json_writer_create(jfmt->common.outfile?jfmt->common.outfile:stdout, 0, indent, NULL);
+    if (json_writer_tree(writer, NULL, jfmt->common.json_tree) == false ||
+	json_writer_free(writer) == false) {
+	err(27, "jfmt", "error writing the formatted JSON");
+	not_reached();
+    }
+    free(indent);
+    indent = NULL;
 
     /* free tree */
     json_tree_free(jfmt->common.json_tree, jfmt->common.max_depth);
@@ -377,16 +425,23 @@ jfmt_sanity_chks(struct jfmt *jfmt, char const *program, int *argc, char ***argv
 {
     /* firewall */
     if (jfmt == NULL) {
-	err(25, __func__, "NULL jfmt");
+	err(28, __func__, "NULL jfmt");
 	not_reached();
     } else if (argc == NULL) {
-	err(26, __func__, "NULL argc");
+	err(29, __func__, "NULL argc");
 	not_reached();
     } else if (argv == NULL || *argv == NULL || **argv == NULL) {
-	err(27, __func__, "NULL argv");
+	err(30, __func__, "NULL argv");
 	not_reached();
     } else if (program == NULL) {
-	err(28, __func__, "NULL program");
+	err(31, __func__, "NULL program");
+	not_reached();
+    }
+
+    /* use of -R with -B is an error: a mapped tape is not parsed, so it cannot be limited */
+    if (jfmt->common.limits_used && jfmt->common.tape_dir != NULL) {
+	free_jfmt(&jfmt);
+	err(3, __func__, "cannot use -R and -B together"); /*ooo*/
 	not_reached();
     }
 
@@ -46,6 +46,8 @@ alloc_jfmt(void)
     /* JSON file member variables */
     jfmt->common.is_stdin = false;			/* true if it's stdin */
     jfmt->common.file_contents = NULL;			/* file.json contents */
+    jfmt->common.file_len = 0;				/* length of file.json contents */
+    jfmt->common.file_mapped = false;			/* file.json contents not mapped */
     jfmt->common.json_file = NULL;			/* JSON file * */
     jfmt->common.json_file_path = NULL;			/* path to JSON file to read */
 
@@ -79,6 +81,11 @@ alloc_jfmt(void)
 
     /* parsing related */
     jfmt->common.max_depth = JSON_DEFAULT_MAX_DEPTH;		/* max depth to traverse set by -m depth */
+    jfmt->common.json_tree = NULL;
+    jfmt->common.tape_dir = NULL;				/* -B dir not used */
+    jfmt->common.limits_used = false;				/* -R limits not used */
+    memset(&jfmt->common.limits, 0, sizeof(jfmt->common.limits));
+    jfmt->common.json_tape = NULL;
 
     return jfmt;
 }
@@ -115,6 +122,14 @@ free_jfmt(struct jfmt **jfmt)
 	(*jfmt)->common.outfile_path = NULL;
     }
 
+    /* free the tape of the JSON */
+    json_tape_free((*jfmt)->common.json_tape);
+    (*jfmt)->common.json_tape = NULL;
+
+    /* free the file contents */
+    json_free_all((*jfmt)->common.file_contents, (*jfmt)->common.file_len, (*jfmt)->common.file_mapped);
+    (*jfmt)->common.file_contents = NULL;
+
     free(*jfmt);
     *jfmt = NULL;
 }
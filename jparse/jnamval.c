@@ -42,7 +42,7 @@ static bool quiet = false;				/* true ==> quiet mode */
 static const char * const usage_msg0 =
     "usage:\t%s [-h] [-V] [-v level] [-J level] [-q] [-L <num>{[t|s]}] [-I <num>{[t|s]}] [-t types]\n"
     "\t[-r types] [-p parts] [-l lvl] [-Q] [-D] [-d] [-i] [-s] [-f] [-c] [-C] [-g] [-e] [-n op=num]\n"
-    "\t[-S op=str] [-o ofile] [-N] [-H] [-m max_depth] [-K] [-F fmt] file.json [arg ...]\n"
+    "\t[-S op=str] [-o ofile] [-N] [-H] [-m max_depth] [-K] [-F fmt] [-B dir] [-R limits] file.json [arg ...]\n"
     "\n"
     "\t-h\t\tPrint help and exit\n"
     "\t-V\t\tPrint version and exit\n"
@@ -156,6 +156,15 @@ static const char * const usage_msg1 =
     "\t\t\t1line\t\tOne line output\n"
     "\t\t\tnows\t\tOne line output, no extra whitespace\n"
     "\n"
+    "\t-B dir\t\tKeep a .jtree tape of file.json in the cache directory dir, so that later runs\n"
+    "\t\t\ton the unchanged file.json map the tape instead of parsing (def: do not cache)\n"
+    "\n"
+    "\t-R limits\tStop parsing file.json at the first resource limit it crosses (def: no limits)\n"
+    "\n"
+    "\t\t\tlimits is a comma separated list of name=value where name is one of: bytes,\n"
+    "\t\t\tdepth, nodes, string, number or members and a value of 0 means no limit.\n"
+    "\t\t\tUsing -R with -B is an error.\n"
+    "\n"
     "\tfile.json\tJSON file to parse (- ==> read from stdin)\n"
     "\targ\t\tmatch arg(s)\n"
     "\n"
@@ -187,7 +196,6 @@ main(int argc, char **argv)
     extern char *optarg;
     extern int optind;
     struct jnamval *jnamval = NULL;	/* struct of all our options and other things */
-    size_t len = 0;			/* length of file contents */
     bool is_valid = false;		/* if file is valid json */
     int exit_code = 0;			/* for the end */
     int i;
@@ -206,7 +214,7 @@ main(int argc, char **argv)
      * parse args
      */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hVv:J:qL:I:t:r:p:l:QDdisfcCgen:S:o:m:KNHF:")) != -1) {
+    while ((i = getopt(argc, argv, ":hVv:J:qL:I:t:r:p:l:QDdisfcCgen:S:o:m:KNHF:B:R:")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 0 */
 	    free_jnamval(&jnamval);
@@ -357,6 +365,16 @@ main(int argc, char **argv)
 	    jnamval->common.format = JSON_FMT_TTY; /* assume default */
 	    jnamval->common.format = parse_json_util_format(&jnamval->common, "jnamval", optarg);
 	    break;
+	case 'B': /* -B dir - cache directory of .jtree tape files */
+	    jnamval->common.tape_dir = optarg;
+	    break;
+	case 'R': /* -R limits - resource limits of the parse */
+	    if (!json_util_parse_limits(optarg, &jnamval->common.limits)) {
+		usage(3, program, "invalid -R limits"); /*ooo*/
+		not_reached();
+	    }
+	    jnamval->common.limits_used = true;
+	    break;
 	case ':':   /* option requires an argument */
 	case '?':   /* illegal option */
 	default:    /* anything else but should not actually happen */
@@ -393,21 +411,22 @@ main(int argc, char **argv)
     }
 
     /*
-     * Read in contents of file.
+     * Read in contents of file (a regular file is mapped rather than copied).
      *
      * NOTE: why doesn't the jnamval_sanity_chks() function do this? Because this
      * is not so much about a sane environment as much as being unable to
      * continue after verifying the command line is correct.
      */
-    jnamval->common.file_contents = read_all(jnamval->common.json_file, &len);
+    jnamval->common.file_contents = json_read_all_limits(jnamval->common.json_file, &jnamval->common.file_len,
+						   &jnamval->common.file_mapped,
+						   jnamval->common.limits_used ? &jnamval->common.limits : NULL);
     if (jnamval->common.file_contents == NULL) {
 	err(4, "jnamval", "could not read in file: %s", argv[0]); /*ooo*/
 	not_reached();
     }
 
-    jnamval->common.json_tree = parse_json(jnamval->common.file_contents, strlen(jnamval->common.file_contents),
-	    jnamval->common.json_file_path, &is_valid);
-    if (!is_valid || jnamval->common.json_tree == NULL) {
+    is_valid = json_util_parse_json(&jnamval->common);
+    if (!is_valid) {
 	if (jnamval->common.json_file != stdin) {
 	    fclose(jnamval->common.json_file);  /* close file prior to exiting */
 	    jnamval->common.json_file = NULL;   /* set to NULL even though we're exiting as a safety precaution */
@@ -544,6 +563,13 @@ jnamval_sanity_chks(struct jnamval *jnamval, char const *program, int *argc, cha
 	}
     }
 
+    /* use of -R with -B is an error: a mapped tape is not parsed, so it cannot be limited */
+    if (jnamval->common.limits_used && jnamval->common.tape_dir != NULL) {
+	free_jnamval(&jnamval);
+	err(3, __func__, "cannot use -R and -B together"); /*ooo*/
+	not_reached();
+    }
+
     /*
      * shift argc and argv for further processing. They're a pointer to those in
      * main() so we have to dereference them here because main() also requires
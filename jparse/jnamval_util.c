@@ -47,6 +47,8 @@ alloc_jnamval(void)
     /* JSON file member variables */
     jnamval->common.is_stdin = false;			/* true if it's stdin */
     jnamval->common.file_contents = NULL;			/* file.json contents */
+    jnamval->common.file_len = 0;				/* length of file.json contents */
+    jnamval->common.file_mapped = false;			/* file.json contents not mapped */
     jnamval->common.json_file = NULL;			/* JSON file * */
     jnamval->common.json_file_path = NULL;			/* path to read */
 
@@ -114,6 +116,10 @@ alloc_jnamval(void)
     /* parsing related */
     jnamval->common.max_depth = JSON_DEFAULT_MAX_DEPTH;		/* max depth to traverse set by -m depth */
     jnamval->common.json_tree = NULL;
+    jnamval->common.tape_dir = NULL;				/* -B dir not used */
+    jnamval->common.limits_used = false;				/* -R limits not used */
+    memset(&jnamval->common.limits, 0, sizeof(jnamval->common.limits));
+    jnamval->common.json_tape = NULL;
 
     /* matches for -c / -C - subject to change */
     jnamval->json_name_val.total_matches = 0;
@@ -820,6 +826,14 @@ free_jnamval(struct jnamval **jnamval)
     /* free the compare lists too */
     free_jnamval_cmp_op_lists(*jnamval);
 
+    /* free the tape of the JSON */
+    json_tape_free((*jnamval)->common.json_tape);
+    (*jnamval)->common.json_tape = NULL;
+
+    /* free the file contents */
+    json_free_all((*jnamval)->common.file_contents, (*jnamval)->common.file_len, (*jnamval)->common.file_mapped);
+    (*jnamval)->common.file_contents = NULL;
+
     free(*jnamval);
     *jnamval = NULL;
 }
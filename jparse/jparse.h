@@ -49,10 +49,40 @@
  */
 #include "json_sem.h"
 
+/*
+ * json_event - event driven (SAX-style) JSON parser
+ */
+#include "json_event.h"
+
+/*
+ * json_index - SIMD structural index of a JSON document
+ */
+#include "json_index.h"
+
+/*
+ * json_lines - parse JSON Lines and RFC 7464 JSON text sequences
+ */
+#include "json_lines.h"
+
+/*
+ * json_tape - flat tape form of a JSON parse tree
+ */
+#include "json_tape.h"
+
+/*
+ * json_push - push parser for JSON that arrives in pieces
+ */
+#include "json_push.h"
+
+/*
+ * json_write - buffered JSON writer
+ */
+#include "json_write.h"
+
 /*
  * official jparse version
  */
-#define JPARSE_VERSION "1.1.4 2023-08-02"		/* format: major.minor YYYY-MM-DD */
+#define JPARSE_VERSION "1.1.12 2026-10-16"		/* format: major.minor YYYY-MM-DD */
 
 /*
  * definitions
@@ -77,7 +107,7 @@
 /*
  * official JSON parser version
  */
-#define JSON_PARSER_VERSION "1.1.4 2023-08-02"		/* library version format: major.minor YYYY-MM-DD */
+#define JSON_PARSER_VERSION "1.1.26 2026-10-16"		/* library version format: major.minor YYYY-MM-DD */
 
 
 /*
@@ -88,11 +118,6 @@ extern const char *const jparse_version;		/* jparse version format: major.minor
 /* lexer and parser specific variables */
 extern int jparse_debug;
 
-struct json_extra
-{
-    char const *filename;	/* filename being parsed ("-" means stdin) */
-};
-
 /*
  * lexer specific
  */
@@ -106,9 +131,14 @@ extern void jparse_error(JPARSE_LTYPE *yyltype, struct json **tree, yyscan_t sca
 /*
  * function prototypes for jparse.l
  */
+extern struct json *parse_json_ctx(char const *ptr, size_t len, char *buf, struct json_parse_ctx *ctx, bool *is_valid);
 extern struct json *parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid);
+extern struct json *parse_json_buf(char *buf, size_t len, char const *filename, bool *is_valid);
 extern struct json *parse_json_stream(FILE *stream, char const *filename, bool *is_valid);
 extern struct json *parse_json_file(char const *name, bool *is_valid);
+extern struct json *parse_json_stream_limits(FILE *stream, char const *filename, struct json_limits const *limits,
+					    bool *is_valid);
+extern struct json *parse_json_file_limits(char const *name, struct json_limits const *limits, bool *is_valid);
 
 
 #endif /* INCLUDE_JPARSE_H */
@@ -519,7 +519,7 @@ void yyfree ( void * , yyscan_t yyscanner );
 #include <unistd.h>
 #endif
 
-#define YY_EXTRA_TYPE struct json_extra *
+#define YY_EXTRA_TYPE struct json_parse_ctx *
 
 int yylex_init (yyscan_t* scanner);
 
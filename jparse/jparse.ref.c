@@ -806,7 +806,6 @@ static const flex_int32_t yy_rule_can_match_eol[16] =
 #include "jparse.h"
 
 extern int jparse_lex(JPARSE_STYPE *yylval_param, JPARSE_LTYPE *yylloc_param, yyscan_t scanner);
-static YY_BUFFER_STATE bs;
 
 /*
  * locations in the file / json block
@@ -854,7 +853,42 @@ static YY_BUFFER_STATE bs;
 				} \
 			    } \
 			}
-#line 806 "jparse.c"
+
+/*
+ * YY_USER_INIT - start counting lines at the line of the file on which the input starts
+ *
+ * YY_USER_ACTION counts lines from the last line of the previous token, so
+ * when the input is part of a larger file, such as a record of a JSON Lines
+ * file, the scanner starts at the line before the line of the file on which
+ * the input starts.  This is done on the first call to the scanner.
+ */
+#define YY_USER_INIT \
+			if (yyextra != NULL && yyextra->line > 1) { \
+			    yylloc->last_line = (int)(yyextra->line - 1); \
+			}
+
+/*
+ * JSON_NEST - count a JSON object or array token in the depth of the parse
+ *
+ * The invalid token is returned instead of tok when tok nests deeper than
+ * JSON_PARSE_MAX_DEPTH so that the parse stops.  See json_parse_nest().
+ */
+#define JSON_NEST(tok) \
+			((yyextra == NULL || \
+			  json_parse_nest(yyextra, yytext, yylloc->first_line, yylloc->first_column)) ? \
+			 JSON_LIMIT(tok) : token)
+
+/*
+ * JSON_LIMIT - check a token against the resource limits of the parse
+ *
+ * The invalid token is returned instead of tok when tok crosses a limit so
+ * that the parse stops.  See json_parse_limit().
+ */
+#define JSON_LIMIT(tok) \
+			((yyextra == NULL || yyextra->limits == NULL || \
+			  json_parse_limit(yyextra, yytext, (size_t)yyleng, yylloc->first_line, yylloc->first_column)) ? \
+			 (tok) : token)
+#line 840 "jparse.c"
 /*
  * Section 2: Patterns (regular expressions) and actions.
  */
@@ -875,7 +909,7 @@ static YY_BUFFER_STATE bs;
  *	    \"([^\n"]|\\\")*\"
  */
 /* Actions. */
-#line 827 "jparse.c"
+#line 861 "jparse.c"
 
 #define INITIAL 0
 
@@ -887,7 +921,7 @@ static YY_BUFFER_STATE bs;
 #include <unistd.h>
 #endif
 
-#define YY_EXTRA_TYPE struct json_extra *
+#define YY_EXTRA_TYPE struct json_parse_ctx *
 
 /* Holds the entire state of the reentrant scanner. */
 struct yyguts_t
@@ -1155,9 +1189,9 @@ YY_DECL
 		}
 
 	{
-#line 138 "./jparse.l"
+#line 172 "./jparse.l"
 
-#line 1109 "jparse.c"
+#line 1143 "jparse.c"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -1228,7 +1262,7 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 139 "./jparse.l"
+#line 173 "./jparse.l"
 {
 			    /*
 			     * Whitespace excluding newlines
@@ -1248,94 +1282,94 @@ YY_RULE_SETUP
 case 2:
 /* rule 2 can match eol */
 YY_RULE_SETUP
-#line 155 "./jparse.l"
+#line 189 "./jparse.l"
 {
 			    yycolumn = 1;
 			}
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 159 "./jparse.l"
+#line 193 "./jparse.l"
 {
 			    /* string */
-			    return JSON_STRING;
+			    return JSON_LIMIT(JSON_STRING);
 			}
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 164 "./jparse.l"
+#line 198 "./jparse.l"
 {
 			    /* number */
-			    return JSON_NUMBER;
+			    return JSON_LIMIT(JSON_NUMBER);
 			}
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 169 "./jparse.l"
+#line 203 "./jparse.l"
 {
 			    /* null object */
-			    return JSON_NULL;
+			    return JSON_LIMIT(JSON_NULL);
 			}
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 174 "./jparse.l"
+#line 208 "./jparse.l"
 {
 			    /* boolean: true */
-			    return JSON_TRUE;
+			    return JSON_LIMIT(JSON_TRUE);
 			}
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 178 "./jparse.l"
+#line 212 "./jparse.l"
 {
 			    /* boolean: false */
-			    return JSON_FALSE;
+			    return JSON_LIMIT(JSON_FALSE);
 			}
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 183 "./jparse.l"
+#line 217 "./jparse.l"
 {
 			    /* start of object */
-			    return JSON_OPEN_BRACE;
+			    return JSON_NEST(JSON_OPEN_BRACE);
 			}
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 187 "./jparse.l"
+#line 221 "./jparse.l"
 {
 			    /* end of object */
-			    return JSON_CLOSE_BRACE;
+			    return JSON_NEST(JSON_CLOSE_BRACE);
 			}
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 192 "./jparse.l"
+#line 226 "./jparse.l"
 {
 			    /* start of array */
-			    return JSON_OPEN_BRACKET;
+			    return JSON_NEST(JSON_OPEN_BRACKET);
 			}
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 196 "./jparse.l"
+#line 230 "./jparse.l"
 {
 			    /* end of array */
-			    return JSON_CLOSE_BRACKET;
+			    return JSON_NEST(JSON_CLOSE_BRACKET);
 			}
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 201 "./jparse.l"
+#line 235 "./jparse.l"
 {
 			    /* colon or 'equals' */
-			    return JSON_COLON;
+			    return JSON_LIMIT(JSON_COLON);
 			}
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 206 "./jparse.l"
+#line 240 "./jparse.l"
 {
 			    /* comma: name/value pair separator */
 			    return JSON_COMMA;
@@ -1343,10 +1377,12 @@ YY_RULE_SETUP
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 211 "./jparse.l"
+#line 245 "./jparse.l"
 {
 			    /* invalid token: any other character */
-			    warn(__func__, "at line %d column %d: invalid token: 0x%02x = <%c>", yylloc->first_line, yylloc->first_column, *yytext, *yytext);
+			    if (yyextra == NULL || yyextra->quiet == false) {
+				warn(__func__, "at line %d column %d: invalid token: 0x%02x = <%c>", yylloc->first_line, yylloc->first_column, *yytext, *yytext);
+			    }
 
 			    /*
 			     * This is a hack for better error messages with
@@ -1379,10 +1415,10 @@ YY_RULE_SETUP
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 244 "./jparse.l"
+#line 280 "./jparse.l"
 YY_FATAL_ERROR( "flex scanner jammed" );
 	YY_BREAK
-#line 1334 "jparse.c"
+#line 1370 "jparse.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -2544,7 +2580,7 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-#line 244 "./jparse.l"
+#line 280 "./jparse.l"
 
 
 /* Section 3: Code that's copied to the generated scanner */
@@ -2766,16 +2802,22 @@ low_byte_scan(char const *data, size_t len, size_t *low_bytes, size_t *nul_bytes
 
 
 /*
- * parse_json - parse a JSON document of a given length
+ * parse_json_ctx - parse a JSON document of a given length with a given parse context
  *
  * Given a pointer to char and a length, use the parser to determine if the json
  * is valid or not.
  *
+ * Everything the scanner, the parser and the conversion functions keep about
+ * the parse is kept in ctx, so parses with different contexts may run at the
+ * same time on different threads.
+ *
  * given:
  *
  *	ptr	    - pointer to start of json blob
  *	len	    - length of the json blob
- *	filename    - filename or NULL for stdin
+ *	buf	    - ptr as a writable buffer to scan in place or NULL to scan a copy of ptr
+ *	ctx	    - parse context set up by json_parse_ctx_init(), with ctx->limits
+ *		      set to limit the resources of the parse
  *	is_valid    - non-NULL printer to boolean to set depending on json validity
  *
  * return:
@@ -2789,12 +2831,12 @@ low_byte_scan(char const *data, size_t len, size_t *low_bytes, size_t *nul_bytes
  * enough (or otherwise if this information is requested).
  */
 struct json *
-parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
+parse_json_ctx(char const *ptr, size_t len, char *buf, struct json_parse_ctx *ctx, bool *is_valid)
 {
     struct json *tree = NULL;		/* the JSON parse tree */
     int ret = 0;			/* jparse_parse() return value */
     yyscan_t scanner;			/* scanner instance: is a void * */
-    struct json_extra extra;
+    YY_BUFFER_STATE bs = NULL;		/* scanner buffer of the blob */
 
     /*
      * firewall
@@ -2810,6 +2852,10 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
 	 */
 	*is_valid = true;
     }
+    if (ctx == NULL) {
+	err(39, __func__, "ctx is NULL");
+	not_reached();
+    }
 
     /*
      * firewall
@@ -2817,7 +2863,7 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
     if (ptr == NULL) {
 
 	/* this should never happen */
-	werr(39, __func__, "ptr is NULL");
+	werr(40, __func__, "ptr is NULL");
 
 	/* flag that we have invalid JSON */
 	*is_valid = false;
@@ -2827,33 +2873,59 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
 	return tree;
     }
 
-    if (filename == NULL) {
+    if (ctx->filename == NULL) {
 	json_dbg(JSON_DBG_HIGH, __func__, "filename is NULL, forcing it to be \"-\" for stdin");
-	filename = "-";	/* assume stdin */
+	ctx->filename = "-";	/* assume stdin */
+    }
+
+    /*
+     * do not scan a document that is longer than the limit
+     */
+    if (ctx->limits != NULL && ctx->limits->max_bytes > 0 && len > ctx->limits->max_bytes) {
+
+	/* report the limit */
+	if (ctx->quiet == false) {
+	    fpr(stderr, __func__, "JSON document length %ju exceeds the limit of %ju in file %s\n",
+		(uintmax_t)len, (uintmax_t)ctx->limits->max_bytes, ctx->filename);
+	}
+	ctx->limit_crossed = true;
+
+	/* flag that we have invalid JSON */
+	*is_valid = false;
+
+	/* return a blank JSON tree */
+	tree = json_alloc(JTYPE_UNSET);
+	return tree;
     }
 
     /*
      * initialise scanner
      */
     errno = 0;
-    ret = jparse_lex_init_extra(&extra, &scanner);
+    ret = jparse_lex_init_extra(ctx, &scanner);
     if (ret != 0) {
-	werrp(40, __func__, "jparse_lex_init_extra failed");
+	werrp(41, __func__, "jparse_lex_init_extra failed");
 	return NULL;
     }
-    extra.filename = filename;
 
     /*
      * scan the blob
+     *
+     * When given a buffer the scanner works directly in the buffer, otherwise
+     * yy_scan_bytes() gives the scanner its own copy of the blob.
      */
-    bs = yy_scan_bytes(ptr, (int)len, scanner);
+    if (buf != NULL) {
+	bs = yy_scan_buffer(buf, len + JSON_SCAN_PAD, scanner);
+    } else {
+	bs = yy_scan_bytes(ptr, (int)len, scanner);
+    }
     if (bs == NULL) {
 	/*
 	 * if unable to scan the bytes it indicates an internal error and
 	 * perhaps it should call err() instead but for now we make it a
 	 * non-fatal error as well.
 	 */
-	werr(41, __func__, "unable to scan string");
+	werr(42, __func__, "unable to scan string");
 
 	/* flag that we have invalid JSON */
 	*is_valid = false;
@@ -2866,7 +2938,8 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
 
     /*
      * we cannot set the column and probably line number without first having a
-     * buffer which is why the yy_scan_bytes() is called first.
+     * buffer which is why the yy_scan_bytes() (or yy_scan_buffer()) is called
+     * first.
      *
      * For why we set the column to 0 but the line to 1 see the comments with
      * the YY_USER_ACTION macro.
@@ -2886,11 +2959,21 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
 
     /*
      * parse the blob, passing into the parser the node and scanner
+     *
+     * Identical JSON member names of the parse share one copy of the name.
      */
+    ctx->names = json_intern_create();
+    json_parse_ctx_enter(ctx);
     ret = jparse_parse(&tree, scanner);
+    json_parse_ctx_leave(ctx);
+    json_parse_ctx_free(ctx);
+    json_intern_free(ctx->names);
+    ctx->names = NULL;
 
     /*
      * free memory associated with bytes scanned by yy_scan_bytes()
+     *
+     * NOTE: a buffer given to yy_scan_buffer() is NOT freed by this call.
      */
     yy_delete_buffer(bs, scanner);
     bs = NULL;
@@ -2926,26 +3009,117 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
 }
 
 
+/*
+ * parse_json - parse a JSON document of a given length
+ *
+ * Given a pointer to char and a length, use the parser to determine if the json
+ * is valid or not.
+ *
+ * given:
+ *
+ *	ptr	    - pointer to start of json blob
+ *	len	    - length of the json blob
+ *	filename    - filename or NULL for stdin
+ *	is_valid    - non-NULL printer to boolean to set depending on json validity
+ *
+ * return:
+ *	pointer to a JSON parse tree
+ *
+ * NOTE: The blob is copied for the scanner. See parse_json_buf() to scan a
+ * blob in place.
+ *
+ * NOTE: This function only warns on error. This is so that an entire report of
+ * all the problems can be given at the end if the verbosity level is high
+ * enough (or otherwise if this information is requested).
+ */
+struct json *
+parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
+{
+    struct json_parse_ctx ctx;		/* context of this parse */
+
+    json_parse_ctx_init(&ctx, filename, NULL);
+    return parse_json_ctx(ptr, len, NULL, &ctx, is_valid);
+}
+
+
+/*
+ * parse_json_buf - parse a JSON document in place
+ *
+ * This function is like parse_json() except that the scanner reads directly
+ * from buf instead of from a copy of it. This saves a copy of (possibly large)
+ * data such as that from json_read_all().
+ *
+ * given:
+ *
+ *	buf	    - writable buffer of len bytes followed by JSON_SCAN_PAD NUL bytes
+ *	len	    - length of the json blob, not counting the JSON_SCAN_PAD NUL bytes
+ *	filename    - filename or NULL for stdin
+ *	is_valid    - non-NULL printer to boolean to set depending on json validity
+ *
+ * return:
+ *	pointer to a JSON parse tree
+ *
+ * NOTE: While scanning, the scanner temporarily writes NUL bytes into buf.
+ * The contents of buf are restored by the time the scan reaches the end of buf.
+ *
+ * NOTE: This function only warns on error. This is so that an entire report of
+ * all the problems can be given at the end if the verbosity level is high
+ * enough (or otherwise if this information is requested).
+ */
+struct json *
+parse_json_buf(char *buf, size_t len, char const *filename, bool *is_valid)
+{
+    struct json_parse_ctx ctx;		/* context of this parse */
+
+    json_parse_ctx_init(&ctx, filename, NULL);
+    return parse_json_ctx(buf, len, buf, &ctx, is_valid);
+}
+
+
 /*
  * parse_json_stream - parse an open file stream for JSON data
  *
+ * given:
+ *	stream      - open file stream containing JSON data
+ *	filename    - name of file or NULL for stdin
+ *	is_valid    - non-NULL printer to boolean to set depending on json validity
+ *
+ * return:
+ *	pointer to a JSON parse tree
+ *
+ * NOTE: This function is parse_json_stream_limits() without resource limits.
+ */
+struct json *
+parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
+{
+    return parse_json_stream_limits(stream, filename, NULL, is_valid);
+}
+
+
+/*
+ * parse_json_stream_limits - parse an open file stream for JSON data within resource limits
+ *
  * Given an open file stream, we will read in all data (until EOF) and
  * then parse that data as if it were JSON.
  *
+ * A regular file is not read but mapped into memory by json_read_all_limits()
+ * and scanned in place, so its data is never copied.
+ *
  * given:
  *	stream      - open file stream containing JSON data
  *	filename    - name of file or NULL for stdin
+ *	limits	    - resource limits of the parse or NULL ==> no limits
  *	is_valid    - non-NULL printer to boolean to set depending on json validity
  *
  * return:
  *	pointer to a JSON parse tree
  *
- * If stream is NULL or stream is not open, or if read_all() fails,
+ * If stream is NULL or stream is not open, or if json_read_all_limits() fails,
  * then this function warns and sets *is_valid to false.
  *
  * NOTE: The reason this is in the scanner and not the parser is because
  *	 YY_BUFFER_STATE is part of the scanner and not the parser and that's required
- *	 for the parse_json_block() function.
+ *	 for the parse_json_ctx() function.
  *
  * NOTE: This function only warns on error. It does this via the called function
  *	 parse_json(). This is done so that an entire report of all the problems can
@@ -2953,20 +3127,22 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
  *	 this information is requested).
  */
 struct json *
-parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
+parse_json_stream_limits(FILE *stream, char const *filename, struct json_limits const *limits, bool *is_valid)
 {
+    struct json_parse_ctx ctx;		/* context of this parse */
     struct json *tree = NULL;		/* the JSON parse tree */
     char *data = NULL;			/* used to determine if there are NUL bytes in the file */
     size_t len = 0;			/* length of data read */
     bool low_byte_detected = false;	/* true ==> byte values [\x00-\x08\x0e-\x1f] detected in data */
     size_t nul_bytes = 0;		/* number of NUL bytes found */
     size_t low_bytes = 0;		/* number of low bytes that are not NUL found */
+    bool mapped = false;		/* true ==> data was mapped by json_read_all_limits() */
 
     /*
      * firewall
      */
     if (is_valid == NULL) {
-	err(42, __func__, "is_valid == NULL");
+	err(43, __func__, "is_valid == NULL");
 	not_reached();
     } else {
 	/*
@@ -2988,7 +3164,7 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
     if (stream == NULL) {
 
 	/* report NULL stream */
-	werr(43, __func__, "stream is NULL");
+	werr(44, __func__, "stream is NULL");
 
 	/* flag that we have invalid JSON */
 	*is_valid = false;
@@ -3000,7 +3176,7 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
     if (stream != stdin && fd_is_ready(__func__, false, fileno(stream)) == false) {
 
 	/* report closed stream */
-	werr(44, __func__, "stream is not open");
+	werr(45, __func__, "stream is not open");
 
 	/* flag that we have invalid JSON */
 	*is_valid = false;
@@ -3011,13 +3187,16 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
     }
 
     /*
-     * read the entire file into memory
+     * read (or map) the entire file into memory
+     *
+     * NOTE: A stream longer than the max_bytes limit is read no further than
+     *	     one byte beyond the limit.
      */
-    data = read_all(stream, &len);
+    data = json_read_all_limits(stream, &len, &mapped, limits);
     if (data == NULL) {
 
 	/* warn about read error */
-	werr(45, __func__, "could not read read stream");
+	werr(46, __func__, "could not read read stream");
 	clearerr_or_fclose(stream);
 
 	/* flag that we have invalid JSON */
@@ -3036,14 +3215,14 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
 
 	/* report invalid JSON */
 	if (low_bytes > 0 && nul_bytes > 0) {
-	    werr(46, __func__, "%ju low byte%s and %ju NUL byte%s detected: data block is NOT valid JSON",
+	    werr(47, __func__, "%ju low byte%s and %ju NUL byte%s detected: data block is NOT valid JSON",
 		    (uintmax_t)low_bytes, low_bytes > 1 ? "s":"",
 		    (uintmax_t)nul_bytes, nul_bytes > 1 ? "s":"");
 	} else if (low_bytes > 0) {
-	    werr(47, __func__, "%ju low byte%s detected: data block is NOT valid JSON",
+	    werr(48, __func__, "%ju low byte%s detected: data block is NOT valid JSON",
 		    (uintmax_t)low_bytes, low_bytes > 1 ? "s":"");
 	} else if (nul_bytes > 0) {
-	    werr(48, __func__, "%ju NUL byte%s detected: data block is NOT valid JSON",
+	    werr(49, __func__, "%ju NUL byte%s detected: data block is NOT valid JSON",
 		    (uintmax_t)nul_bytes, nul_bytes > 1 ? "s":"");
 	}
 
@@ -3054,10 +3233,8 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
 	*is_valid = false;
 
 	/* free data */
-	if (data != NULL) {
-	    free(data);
-	    data = NULL;
-	}
+	json_free_all(data, len, mapped);
+	data = NULL;
 
 	/* return a blank JSON tree */
 	tree = json_alloc(JTYPE_UNSET);
@@ -3067,14 +3244,14 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
     /*
      * JSON parse the data from the file
      */
-    json_dbg(JSON_DBG_HIGH, __func__, "calling parse_json on data block with length %ju:", (uintmax_t)len);
-    tree = parse_json(data, len, filename, is_valid);
+    json_dbg(JSON_DBG_HIGH, __func__, "calling parse_json_ctx on data block with length %ju:", (uintmax_t)len);
+    json_parse_ctx_init(&ctx, filename, NULL);
+    ctx.limits = limits;
+    tree = parse_json_ctx(data, len, data, &ctx, is_valid);
 
     /* free data */
-    if (data != NULL) {
-	free(data);
-	data = NULL;
-    }
+    json_free_all(data, len, mapped);
+    data = NULL;
 
     /*
      * clear error or close stream
@@ -3101,13 +3278,33 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
  * return:
  *	pointer to a JSON parse tree
  *
+ * NOTE: This function is parse_json_file_limits() without resource limits.
+ */
+struct json *
+parse_json_file(char const *name, bool *is_valid)
+{
+    return parse_json_file_limits(name, NULL, is_valid);
+}
+
+
+/*
+ * parse_json_file_limits   - parses file file within resource limits
+ *
+ * given:
+ *	name	    - filename of file to parse
+ *	limits	    - resource limits of the parse or NULL ==> no limits
+ *	is_valid    - non-NULL printer to boolean to set depending on json validity
+ *
+ * return:
+ *	pointer to a JSON parse tree
+ *
  * If name is NULL or the name is not a readable file (or is empty) or
- * if read_all() read_all() fails, then this function warns and sets *is_valid
+ * if json_read_all() fails, then this function warns and sets *is_valid
  * to false.
  *
  * NOTE: The reason this is in the scanner and not the parser is because
  *	 YY_BUFFER_STATE is part of the scanner and not the parser and that's required
- *	 for the parse_json_block() function.
+ *	 for the parse_json_ctx() function.
  *
  * NOTE: This function only warns on error. It does this via the called function
  *	 parse_json(). This is done so that an entire report of all the problems can
@@ -3115,7 +3312,7 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
  *	 this information is requested).
  */
 struct json *
-parse_json_file(char const *name, bool *is_valid)
+parse_json_file_limits(char const *name, struct json_limits const *limits, bool *is_valid)
 {
     struct json *tree = NULL;		/* the JSON parse tree */
     FILE *stream = NULL;		/* file stream to read from */
@@ -3124,7 +3321,7 @@ parse_json_file(char const *name, bool *is_valid)
      * firewall
      */
     if (is_valid == NULL) {
-	err(49, __func__, "is_valid == NULL");
+	err(50, __func__, "is_valid == NULL");
 	not_reached();
     } else {
 	/*
@@ -3137,7 +3334,7 @@ parse_json_file(char const *name, bool *is_valid)
     if (name == NULL) {
 
 	/* this should actually never happen if called from jparse */
-	werr(50, __func__, "passed NULL name");
+	werr(51, __func__, "passed NULL name");
 
 	/* flag that we have invalid JSON */
 	*is_valid = false;
@@ -3149,7 +3346,7 @@ parse_json_file(char const *name, bool *is_valid)
     if (*name == '\0') { /* strlen(name) == 0 */
 
 	/* warn about bogus name */
-	werr(51, __func__, "passed empty filename");
+	werr(52, __func__, "passed empty filename");
 
 	/* flag that we have invalid JSON */
 	*is_valid = false;
@@ -3175,7 +3372,7 @@ parse_json_file(char const *name, bool *is_valid)
 	 */
 	if (!exists(name)) {
 	    /* report missing file */
-	    werr(52, __func__, "passed filename that's not actually a file: %s", name);
+	    werr(53, __func__, "passed filename that's not actually a file: %s", name);
 
 	    /* flag that we have invalid JSON */
 	    *is_valid = false;
@@ -3187,7 +3384,7 @@ parse_json_file(char const *name, bool *is_valid)
 	}
 	if (!is_file(name)) {
 	    /* report that file is not a normal file */
-	    werr(53, __func__, "passed filename not a normal file: %s", name);
+	    werr(54, __func__, "passed filename not a normal file: %s", name);
 
 	    /* report invalid JSON */
 	    *is_valid = false;
@@ -3199,7 +3396,7 @@ parse_json_file(char const *name, bool *is_valid)
 	if (!is_read(name)) {
 
 	    /* report unreadable file */
-	    werr(54, __func__, "passed filename not a readable file: %s", name);
+	    werr(55, __func__, "passed filename not a readable file: %s", name);
 
 	    /* flag that we have invalid JSON */
 	    *is_valid = false;
@@ -3217,7 +3414,7 @@ parse_json_file(char const *name, bool *is_valid)
 	if (stream == NULL) {
 
 	    /* warn about file open error */
-	    werrp(55, __func__, "couldn't open file %s, ignoring", name);
+	    werrp(56, __func__, "couldn't open file %s, ignoring", name);
 
 	    /* flag that we have invalid JSON */
 	    *is_valid = false;
@@ -3231,7 +3428,7 @@ parse_json_file(char const *name, bool *is_valid)
     /*
      * JSON parse the open stream
      */
-    tree = parse_json_stream(stream, name, is_valid);
+    tree = parse_json_stream_limits(stream, name, limits, is_valid);
 
     /*
      * return the JSON parse tree tree
@@ -109,7 +109,7 @@
 #define YYPURE 2
 
 /* Push parsers.  */
-#define YYPUSH 0
+#define YYPUSH 1
 
 /* Pull parsers.  */
 #define YYPULL 1
@@ -119,13 +119,19 @@
 #define YYLTYPE         JPARSE_LTYPE
 /* Substitute the variable and function names.  */
 #define yyparse         jparse_parse
+#define yypush_parse    jparse_push_parse
+#define yypull_parse    jparse_pull_parse
+#define yypstate_new    jparse_pstate_new
+#define yypstate_clear  jparse_pstate_clear
+#define yypstate_delete jparse_pstate_delete
+#define yypstate        jparse_pstate
 #define yylex           jparse_lex
 #define yyerror         jparse_error
 #define yydebug         jparse_debug
 #define yynerrs         jparse_nerrs
 
 /* First part of user prologue.  */
-#line 51 "./jparse.y"
+#line 57 "./jparse.y"
 
 
 
@@ -142,6 +148,13 @@
  */
 #include "jparse.lex.h"
 
+/*
+ * The parser stack must hold JSON_PARSE_MAX_DEPTH nested JSON objects, each
+ * of which takes three entries: the {, the member name and the :.  The
+ * scanner stops the parse before it nests deeper (see json_parse_nest()).
+ */
+#define YYMAXDEPTH (3 * JSON_PARSE_MAX_DEPTH + 64)
+
 /*
  * bison debug information for development
  */
@@ -154,7 +167,7 @@ const char *const json_parser_version = JSON_PARSER_VERSION;	/* library version
 const char *const jparse_version = JPARSE_VERSION;		/* jparse version format: major.minor YYYY-MM-DD */
 
 
-#line 107 "jparse.tab.c"
+#line 120 "jparse.tab.c"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -574,9 +587,9 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   179,   179,   237,   268,   299,   330,   361,   391,   421,
-     453,   484,   514,   548,   587,   623,   654,   684,   718,   756,
-     789,   821
+       0,   192,   192,   250,   281,   312,   343,   374,   404,   434,
+     466,   497,   527,   561,   600,   636,   667,   697,   731,   769,
+     802,   834
 };
 #endif
 
@@ -964,6 +977,44 @@ int yydebug;
 #ifndef YYMAXDEPTH
 # define YYMAXDEPTH 10000
 #endif
+/* Parser data structure.  */
+struct yypstate
+  {
+    /* Number of syntax errors so far.  */
+    int yynerrs;
+
+    yy_state_fast_t yystate;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss;
+    yy_state_t *yyssp;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs;
+    YYSTYPE *yyvsp;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls;
+    YYLTYPE *yylsp;
+
+    yy_state_t yyesa[20];
+    yy_state_t *yyes;
+    YYPTRDIFF_T yyes_capacity;
+    /* Whether this instance has not started parsing yet.
+     * If 2, it corresponds to a finished parsing.  */
+    int yynew;
+  };
 
 
 /* Given a state stack such that *YYBOTTOM is its bottom, such that
@@ -1238,13 +1289,126 @@ yydestruct (const char *yymsg,
 
 
 
+int
+yyparse (struct json **tree, yyscan_t scanner)
+{
+  yypstate *yyps = yypstate_new ();
+  if (!yyps)
+    {
+      static YYLTYPE yyloc_default
+# if defined JPARSE_LTYPE_IS_TRIVIAL && JPARSE_LTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+      YYLTYPE yylloc = yyloc_default;
+      yyerror (&yylloc, tree, scanner, YY_("memory exhausted"));
+      return 2;
+    }
+  int yystatus = yypull_parse (yyps, tree, scanner);
+  yypstate_delete (yyps);
+  return yystatus;
+}
 
-/*----------.
-| yyparse.  |
-`----------*/
+int
+yypull_parse (yypstate *yyps, struct json **tree, yyscan_t scanner)
+{
+  YY_ASSERT (yyps);
+  static YYLTYPE yyloc_default
+# if defined JPARSE_LTYPE_IS_TRIVIAL && JPARSE_LTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+  YYLTYPE yylloc = yyloc_default;
+  int yystatus;
+  do {
+    YYSTYPE yylval;
+    int yychar = yylex (&yylval, &yylloc, scanner);
+    yystatus = yypush_parse (yyps, yychar, &yylval, &yylloc, tree, scanner);
+  } while (yystatus == YYPUSH_MORE);
+  return yystatus;
+}
+
+#define jparse_nerrs yyps->jparse_nerrs
+#define yystate yyps->yystate
+#define yyerrstatus yyps->yyerrstatus
+#define yyssa yyps->yyssa
+#define yyss yyps->yyss
+#define yyssp yyps->yyssp
+#define yyvsa yyps->yyvsa
+#define yyvs yyps->yyvs
+#define yyvsp yyps->yyvsp
+#define yylsa yyps->yylsa
+#define yyls yyps->yyls
+#define yylsp yyps->yylsp
+#define yystacksize yyps->yystacksize
+#define yyesa yyps->yyesa
+#define yyes yyps->yyes
+#define yyes_capacity yyps->yyes_capacity
+
+/* Initialize the parser data structure.  */
+static void
+yypstate_clear (yypstate *yyps)
+{
+  yynerrs = 0;
+  yystate = 0;
+  yyerrstatus = 0;
+
+  yyssp = yyss;
+  yyvsp = yyvs;
+  yylsp = yyls;
+
+  /* Initialize the state stack, in case yypcontext_expected_tokens is
+     called before the first call to yyparse. */
+  *yyssp = 0;
+  yyps->yynew = 1;
+}
+
+/* Initialize the parser data structure.  */
+yypstate *
+yypstate_new (void)
+{
+  yypstate *yyps;
+  yyps = YY_CAST (yypstate *, YYMALLOC (sizeof *yyps));
+  if (!yyps)
+    return YY_NULLPTR;
+  yystacksize = YYINITDEPTH;
+  yyss = yyssa;
+  yyvs = yyvsa;
+  yyls = yylsa;
+  yyes = yyesa;
+  yyes_capacity = 20;
+  if (YYMAXDEPTH < yyes_capacity)
+    yyes_capacity = YYMAXDEPTH;
+  yypstate_clear (yyps);
+  return yyps;
+}
+
+void
+yypstate_delete (yypstate *yyps)
+{
+  if (yyps)
+    {
+#ifndef yyoverflow
+      /* If the stack was reallocated but the parse did not complete, then the
+         stack still needs to be freed.  */
+      if (yyss != yyssa)
+        YYSTACK_FREE (yyss);
+#endif
+      if (yyes != yyesa)
+        YYSTACK_FREE (yyes);
+      YYFREE (yyps);
+    }
+}
+
+
+
+/*---------------.
+| yypush_parse.  |
+`---------------*/
 
 int
-yyparse (struct json **tree, yyscan_t scanner)
+yypush_parse (yypstate *yyps,
+              int yypushed_char, YYSTYPE const *yypushed_val, YYLTYPE *yypushed_loc, struct json **tree, yyscan_t scanner)
 {
 /* Lookahead token kind.  */
 int yychar;
@@ -1264,38 +1428,6 @@ static YYLTYPE yyloc_default
 ;
 YYLTYPE yylloc = yyloc_default;
 
-    /* Number of syntax errors so far.  */
-    int yynerrs = 0;
-
-    yy_state_fast_t yystate = 0;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus = 0;
-
-    /* Refer to the stacks through separate pointers, to allow yyoverflow
-       to reallocate them elsewhere.  */
-
-    /* Their size.  */
-    YYPTRDIFF_T yystacksize = YYINITDEPTH;
-
-    /* The state stack: array, bottom, top.  */
-    yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss = yyssa;
-    yy_state_t *yyssp = yyss;
-
-    /* The semantic value stack: array, bottom, top.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs = yyvsa;
-    YYSTYPE *yyvsp = yyvs;
-
-    /* The location stack: array, bottom, top.  */
-    YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls = yylsa;
-    YYLTYPE *yylsp = yyls;
-
-    yy_state_t yyesa[20];
-    yy_state_t *yyes = yyesa;
-    YYPTRDIFF_T yyes_capacity = 20 < YYMAXDEPTH ? 20 : YYMAXDEPTH;
-
   /* Whether LAC context is established.  A Boolean.  */
   int yy_lac_established = 0;
   int yyn;
@@ -1319,11 +1451,25 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
+  switch (yyps->yynew)
+    {
+    case 0:
+      yyn = yypact[yystate];
+      goto yyread_pushed_token;
+
+    case 2:
+      yypstate_clear (yyps);
+      break;
+
+    default:
+      break;
+    }
+
   YYDPRINTF ((stderr, "Starting parse\n"));
 
   yychar = JPARSE_EMPTY; /* Cause a token to be read.  */
 
-  yylsp[0] = yylloc;
+  yylsp[0] = *yypushed_loc;
   goto yysetstate;
 
 
@@ -1439,8 +1585,20 @@ yybackup:
   /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == JPARSE_EMPTY)
     {
+      if (!yyps->yynew)
+        {
+          YYDPRINTF ((stderr, "Return for a new token:\n"));
+          yyresult = YYPUSH_MORE;
+          goto yypushreturn;
+        }
+      yyps->yynew = 0;
+yyread_pushed_token:
       YYDPRINTF ((stderr, "Reading a token\n"));
-      yychar = yylex (&yylval, &yylloc, scanner);
+      yychar = yypushed_char;
+      if (yypushed_val)
+        yylval = *yypushed_val;
+      if (yypushed_loc)
+        yylloc = *yypushed_loc;
     }
 
   if (yychar <= JPARSE_EOF)
@@ -1539,7 +1697,7 @@ yyreduce:
     switch (yyn)
       {
   case 2: /* json: json_element  */
-#line 180 "./jparse.y"
+#line 193 "./jparse.y"
     {
 	/*
 	 * $$ = $json
@@ -1593,11 +1751,11 @@ yyreduce:
 					      "json: json_element");
 	}
     }
-#line 1546 "jparse.tab.c"
+#line 1704 "jparse.tab.c"
     break;
 
   case 3: /* json_value: json_object  */
-#line 238 "./jparse.y"
+#line 251 "./jparse.y"
     {
 	/*
 	 * $$ = $json_value
@@ -1626,11 +1784,11 @@ yyreduce:
 					       "json_value: json_object");
 	}
     }
-#line 1579 "jparse.tab.c"
+#line 1737 "jparse.tab.c"
     break;
 
   case 4: /* json_value: json_array  */
-#line 269 "./jparse.y"
+#line 282 "./jparse.y"
     {
 	/*
 	 * $$ = $json_value
@@ -1659,11 +1817,11 @@ yyreduce:
 					       "json_value: json_array");
 	}
     }
-#line 1612 "jparse.tab.c"
+#line 1770 "jparse.tab.c"
     break;
 
   case 5: /* json_value: json_string  */
-#line 300 "./jparse.y"
+#line 313 "./jparse.y"
     {
 	/*
 	 * $$ = $json_value
@@ -1692,11 +1850,11 @@ yyreduce:
 					       "json_value: json_string");
 	}
     }
-#line 1645 "jparse.tab.c"
+#line 1803 "jparse.tab.c"
     break;
 
   case 6: /* json_value: json_number  */
-#line 331 "./jparse.y"
+#line 344 "./jparse.y"
     {
 	/*
 	 * $$ = $json_value
@@ -1725,11 +1883,11 @@ yyreduce:
 					       "json_value: json_number");
 	}
     }
-#line 1678 "jparse.tab.c"
+#line 1836 "jparse.tab.c"
     break;
 
   case 7: /* json_value: "true"  */
-#line 362 "./jparse.y"
+#line 375 "./jparse.y"
     {
 	/*
 	 * $$ = $json_value
@@ -1757,11 +1915,11 @@ yyreduce:
 					       "json_value: JSON_TRUE");
 	}
     }
-#line 1710 "jparse.tab.c"
+#line 1868 "jparse.tab.c"
     break;
 
   case 8: /* json_value: "false"  */
-#line 392 "./jparse.y"
+#line 405 "./jparse.y"
     {
 	/*
 	 * $$ = $json_value
@@ -1789,11 +1947,11 @@ yyreduce:
 					     "json_value: JSON_FALSE");
 	}
     }
-#line 1742 "jparse.tab.c"
+#line 1900 "jparse.tab.c"
     break;
 
   case 9: /* json_value: "null"  */
-#line 422 "./jparse.y"
+#line 435 "./jparse.y"
     {
 	/*
 	 * $$ = $json_value
@@ -1821,11 +1979,11 @@ yyreduce:
 					       "json_value: JSON_NULL");
 	}
     }
-#line 1774 "jparse.tab.c"
+#line 1932 "jparse.tab.c"
     break;
 
   case 10: /* json_object: "{" json_members "}"  */
-#line 454 "./jparse.y"
+#line 467 "./jparse.y"
     {
 	/*
 	 * $$ = $json_object
@@ -1854,11 +2012,11 @@ yyreduce:
 					       "json_object: JSON_OPEN_BRACE json_members JSON_CLOSE_BRACE");
 	}
     }
-#line 1807 "jparse.tab.c"
+#line 1965 "jparse.tab.c"
     break;
 
   case 11: /* json_object: "{" "}"  */
-#line 485 "./jparse.y"
+#line 498 "./jparse.y"
     {
 	/*
 	 * $$ = $json_object
@@ -1884,11 +2042,11 @@ yyreduce:
 					       "json_object: JSON_OPEN_BRACE JSON_CLOSE_BRACE");
 	}
     }
-#line 1837 "jparse.tab.c"
+#line 1995 "jparse.tab.c"
     break;
 
   case 12: /* json_members: json_member  */
-#line 515 "./jparse.y"
+#line 528 "./jparse.y"
     {
 	/*
 	 * $$ = $json_members
@@ -1920,11 +2078,11 @@ yyreduce:
 					      "json_members: json_member");
 	}
     }
-#line 1873 "jparse.tab.c"
+#line 2031 "jparse.tab.c"
     break;
 
   case 13: /* json_members: json_members "," json_member  */
-#line 549 "./jparse.y"
+#line 562 "./jparse.y"
     {
 	/*
 	 * $$ = $json_members
@@ -1959,11 +2117,11 @@ yyreduce:
 					       "json_members: json_members JSON_COMMA json_member");
 	}
     }
-#line 1912 "jparse.tab.c"
+#line 2070 "jparse.tab.c"
     break;
 
   case 14: /* json_member: json_string ":" json_element  */
-#line 588 "./jparse.y"
+#line 601 "./jparse.y"
     {
 	/*
 	 * $$ = $json_member
@@ -1995,11 +2153,11 @@ yyreduce:
 					       "json_member: json_string JSON_COLON json_element");
 	}
     }
-#line 1948 "jparse.tab.c"
+#line 2106 "jparse.tab.c"
     break;
 
   case 15: /* json_array: "[" json_elements "]"  */
-#line 624 "./jparse.y"
+#line 637 "./jparse.y"
     {
 	/*
 	 * $$ = $json_array
@@ -2028,11 +2186,11 @@ yyreduce:
 					       "json_array: JSON_OPEN_BRACKET json_elements JSON_CLOSE_BRACKET");
 	}
     }
-#line 1981 "jparse.tab.c"
+#line 2139 "jparse.tab.c"
     break;
 
   case 16: /* json_array: "[" "]"  */
-#line 655 "./jparse.y"
+#line 668 "./jparse.y"
     {
 	/*
 	 * $$ = $json_array
@@ -2058,11 +2216,11 @@ yyreduce:
 					       "json_array: JSON_OPEN_BRACKET JSON_CLOSE_BRACKET");
 	}
     }
-#line 2011 "jparse.tab.c"
+#line 2169 "jparse.tab.c"
     break;
 
   case 17: /* json_elements: json_element  */
-#line 685 "./jparse.y"
+#line 698 "./jparse.y"
     {
 	/*
 	 * $$ = $json_elements
@@ -2094,11 +2252,11 @@ yyreduce:
 					       "json_elements: json_element");
 	}
     }
-#line 2047 "jparse.tab.c"
+#line 2205 "jparse.tab.c"
     break;
 
   case 18: /* json_elements: json_elements "," json_element  */
-#line 719 "./jparse.y"
+#line 732 "./jparse.y"
     {
 	/*
 	 * $$ = $json_elements
@@ -2132,11 +2290,11 @@ yyreduce:
 					       "json_elements: json_elements JSON_COMMA json_element");
 	}
     }
-#line 2085 "jparse.tab.c"
+#line 2243 "jparse.tab.c"
     break;
 
   case 19: /* json_element: json_value  */
-#line 757 "./jparse.y"
+#line 770 "./jparse.y"
     {
 	/*
 	 * $$ = $json_element
@@ -2165,11 +2323,11 @@ yyreduce:
 					       "json_element: json_value");
 	}
     }
-#line 2118 "jparse.tab.c"
+#line 2276 "jparse.tab.c"
     break;
 
   case 20: /* json_string: JSON_STRING  */
-#line 790 "./jparse.y"
+#line 803 "./jparse.y"
     {
 	/*
 	 * $$ = $json_string
@@ -2197,11 +2355,11 @@ yyreduce:
 					       "json_string: JSON_STRING");
 	}
     }
-#line 2150 "jparse.tab.c"
+#line 2308 "jparse.tab.c"
     break;
 
   case 21: /* json_number: JSON_NUMBER  */
-#line 822 "./jparse.y"
+#line 835 "./jparse.y"
     {
 	/*
 	 * $$ = $json_number
@@ -2229,11 +2387,11 @@ yyreduce:
 					       "json_number: JSON_NUMBER");
 	}
     }
-#line 2182 "jparse.tab.c"
+#line 2340 "jparse.tab.c"
     break;
 
 
-#line 2186 "jparse.tab.c"
+#line 2344 "jparse.tab.c"
 
         default: break;
       }
@@ -2430,17 +2588,34 @@ yyreturnlab:
                   YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, tree, scanner);
       YYPOPSTACK (1);
     }
-#ifndef yyoverflow
-  if (yyss != yyssa)
-    YYSTACK_FREE (yyss);
-#endif
-  if (yyes != yyesa)
-    YYSTACK_FREE (yyes);
+  yyps->yynew = 2;
+  goto yypushreturn;
+
+
+/*-------------------------.
+| yypushreturn -- return.  |
+`-------------------------*/
+yypushreturn:
 
   return yyresult;
 }
-
-#line 852 "./jparse.y"
+#undef jparse_nerrs
+#undef yystate
+#undef yyerrstatus
+#undef yyssa
+#undef yyss
+#undef yyssp
+#undef yyvsa
+#undef yyvs
+#undef yyvsp
+#undef yylsa
+#undef yyls
+#undef yylsp
+#undef yystacksize
+#undef yyesa
+#undef yyes
+#undef yyes_capacity
+#line 865 "./jparse.y"
 
 
 
@@ -2458,20 +2633,41 @@ yyreturnlab:
  *	format	    printf style format string
  *	...	    optional parameters based on the format
  *
+ * NOTE: The error is counted in the context of the parse and stderr is locked
+ *	 while the message is written so that the messages of parses running at
+ *	 the same time on other threads are not mixed into it.
  */
 void
 yyerror(JPARSE_LTYPE *yyltype, struct json **node, yyscan_t scanner, char const *format, ...)
 {
     va_list ap;		/* variable argument list */
     int ret;		/* libc function return value */
+    struct json_parse_ctx *ctx = NULL;	/* context of the parse */
 
     /*
      * firewall
      */
     if (scanner == NULL) {
-	err(56, __func__, "NULL scanner");
+	err(57, __func__, "NULL scanner");
 	not_reached();
     }
+
+    /*
+     * count the error in the context of the parse
+     */
+    ctx = jparse_get_extra(scanner);
+    if (ctx != NULL) {
+	++ctx->syntax_errors;
+
+	/*
+	 * a resource limit that stopped the parse was already reported and a
+	 * quiet parse reports nothing
+	 */
+	if (ctx->limit_crossed == true || ctx->quiet == true) {
+	    return;
+	}
+    }
+
     /*
      * stdarg variable argument list setup
      */
@@ -2481,6 +2677,7 @@ yyerror(JPARSE_LTYPE *yyltype, struct json **node, yyscan_t scanner, char const
     /*
      * generate an error message for the JSON parser and scanner
      */
+    flockfile(stderr);
     vfpr(stderr, __func__, format, ap);
     if (node != NULL && *node != NULL) {
 	fprint(stderr, " node type %s", json_item_type_name(*node));
@@ -2514,6 +2711,7 @@ yyerror(JPARSE_LTYPE *yyltype, struct json **node, yyscan_t scanner, char const
             warnp(__func__, "called from %s: unexpected fflush error while flushing stream", __func__);
         }
     }
+    funlockfile(stderr);
 
     /*
      * stdarg variable argument list clean up
@@ -104,7 +104,7 @@
 extern int jparse_debug;
 #endif
 /* "%code requires" blocks.  */
-#line 88 "./jparse.y"
+#line 101 "./jparse.y"
 
     #if !defined(JPARSE_LTYPE_IS_DECLARED)
     struct JPARSE_LTYPE
@@ -192,10 +192,23 @@ struct JPARSE_LTYPE
 
 
 
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
+#endif
+
+typedef struct jparse_pstate jparse_pstate;
+
+
 int jparse_parse (struct json **tree, yyscan_t scanner);
+int jparse_push_parse (jparse_pstate *ps,
+                  int pushed_char, JPARSE_STYPE const *pushed_val, JPARSE_LTYPE *pushed_loc, struct json **tree, yyscan_t scanner);
+int jparse_pull_parse (jparse_pstate *ps, struct json **tree, yyscan_t scanner);
+jparse_pstate *jparse_pstate_new (void);
+void jparse_pstate_delete (jparse_pstate *ps);
 
 /* "%code provides" blocks.  */
-#line 80 "./jparse.y"
+#line 93 "./jparse.y"
 
 #ifndef YY_DECL
 #define YY_DECL int jparse_lex(JPARSE_STYPE *yylval_param, JPARSE_LTYPE *yylloc_param, yyscan_t yyscanner)
@@ -203,6 +216,6 @@ int jparse_parse (struct json **tree, yyscan_t scanner);
 YY_DECL;
 #endif
 
-#line 156 "jparse.tab.h"
+#line 169 "jparse.tab.h"
 
 #endif /* !YY_JPARSE_JPARSE_TAB_H_INCLUDED  */
@@ -27,6 +27,12 @@
 /* we want a re-entrant parser */
 %define api.pure full
 
+/*
+ * we want jparse_parse() to pull tokens from the scanner and also a
+ * jparse_push_parse() that is pushed one token at a time (see json_push.c)
+ */
+%define api.push-pull both
+
 
 /* we need locations for better error reporting */
 %locations
@@ -64,6 +70,13 @@
  */
 #include "jparse.lex.h"
 
+/*
+ * The parser stack must hold JSON_PARSE_MAX_DEPTH nested JSON objects, each
+ * of which takes three entries: the {, the member name and the :.  The
+ * scanner stops the parse before it nests deeper (see json_parse_nest()).
+ */
+#define YYMAXDEPTH (3 * JSON_PARSE_MAX_DEPTH + 64)
+
 /*
  * bison debug information for development
  */
@@ -866,20 +879,41 @@ json_number:
  *	format	    printf style format string
  *	...	    optional parameters based on the format
  *
+ * NOTE: The error is counted in the context of the parse and stderr is locked
+ *	 while the message is written so that the messages of parses running at
+ *	 the same time on other threads are not mixed into it.
  */
 void
 yyerror(JPARSE_LTYPE *yyltype, struct json **node, yyscan_t scanner, char const *format, ...)
 {
     va_list ap;		/* variable argument list */
     int ret;		/* libc function return value */
+    struct json_parse_ctx *ctx = NULL;	/* context of the parse */
 
     /*
      * firewall
      */
     if (scanner == NULL) {
-	err(56, __func__, "NULL scanner");
+	err(57, __func__, "NULL scanner");
 	not_reached();
     }
+
+    /*
+     * count the error in the context of the parse
+     */
+    ctx = jparse_get_extra(scanner);
+    if (ctx != NULL) {
+	++ctx->syntax_errors;
+
+	/*
+	 * a resource limit that stopped the parse was already reported and a
+	 * quiet parse reports nothing
+	 */
+	if (ctx->limit_crossed == true || ctx->quiet == true) {
+	    return;
+	}
+    }
+
     /*
      * stdarg variable argument list setup
      */
@@ -889,6 +923,7 @@ yyerror(JPARSE_LTYPE *yyltype, struct json **node, yyscan_t scanner, char const
     /*
      * generate an error message for the JSON parser and scanner
      */
+    flockfile(stderr);
     vfpr(stderr, __func__, format, ap);
     if (node != NULL && *node != NULL) {
 	fprint(stderr, " node type %s", json_item_type_name(*node));
@@ -922,6 +957,7 @@ yyerror(JPARSE_LTYPE *yyltype, struct json **node, yyscan_t scanner, char const
             warnp(__func__, "called from %s: unexpected fflush error while flushing stream", __func__);
         }
     }
+    funlockfile(stderr);
 
     /*
      * stdarg variable argument list clean up
@@ -24,6 +24,8 @@
 
 #include <stdio.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
 
 /*
  * jparse_main - tool that parses a block of JSON input
@@ -40,7 +42,7 @@
  * usage message
  */
 static const char * const usage_msg =
-    "usage: %s [-h] [-v level] [-J level] [-q] [-V] [-s] arg\n"
+    "usage: %s [-h] [-v level] [-J level] [-q] [-V] [-s] [-c | -E | -I | -T] [-L [-t threads]] [-B dir] [-R limits] [-P size] arg\n"
     "\n"
     "\t-h\t\tprint help message and exit\n"
     "\t-v level\tset verbosity level (def level: %d)\n"
@@ -48,12 +50,24 @@ static const char * const usage_msg =
     "\t-q\t\tquiet mode: silence msg(), warn(), warnp() if -v 0 (def: not quiet)\n"
     "\t-V\t\tprint version string and exit\n"
     "\t-s\t\targ is a string (def: arg is a filename)\n"
+    "\t-c\t\tcheck syntax only, in a single pass without a scanner or parse tree (def: form a parse tree)\n"
+    "\t-E\t\tvalidate with the event parser, without forming a parse tree (def: form a parse tree)\n"
+    "\t-I\t\tvalidate with the SIMD structural index, without forming a parse tree (def: form a parse tree)\n"
+    "\t-T\t\tform a parse tree, then check that its tape forms the same parse tree (def: do not form a tape)\n"
+    "\t-L\t\targ is JSON Lines or an RFC 7464 JSON text sequence: parse each record (def: arg is one JSON text)\n"
+    "\t\t\t    NOTE: with -E, each record is validated without forming a parse tree\n"
+    "\t-t threads\tparse -L records on threads worker threads, 0 ==> one per CPU (def: 0)\n"
+    "\t-B dir\t\tuse the .jtree tape of file arg in the cache directory dir if it is of the file\n"
+    "\t\t\t    as it is now, otherwise parse the file and write its tape there (def: do not cache)\n"
+    "\t-R limits\tstop parsing at the first resource limit crossed: limits is a comma separated list of\n"
+    "\t\t\t    name=value, name one of bytes, depth, nodes, string, number or members (def: no limits)\n"
+    "\t-P size\t\tfeed arg to the push parser in pieces of at most size bytes (def: parse arg as a whole)\n"
     "\n"
     "\targ\t\tparse JSON for string (if -s), file (w/o -s), or stdin (if arg is -)\n"
     "\n"
     "Exit codes:\n"
     "    0\tJSON is valid\n"
-    "    1\tJSON is invalid\n"
+    "    1\tJSON is invalid, or with -L a record is invalid\n"
     "    2\t-h and help string printed or -V and version string printed\n"
     "    3\tcommand line error\n"
     "    >=4\tinternal error\n"
@@ -66,6 +80,11 @@ static const char * const usage_msg =
  * static functions
  */
 static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+static bool check_line(struct json_line *rec, void *ctx);
+static bool check_tape(struct json const *tree);
+static struct json *parse_json_cached(char const *path, char const *dir, bool want_tree, bool *is_valid);
+static struct json *parse_json_pushed(char const *arg, bool is_string, size_t size,
+				      struct json_limits const *limits, bool *is_valid);
 
 
 int
@@ -75,7 +94,20 @@ main(int argc, char **argv)
     extern char *optarg;	    /* option argument */
     extern int optind;		    /* argv index of the next arg */
     bool string_flag_used = false;  /* true ==> -S string was used */
+    bool event_flag_used = false;   /* true ==> -E was used */
+    bool index_flag_used = false;   /* true ==> -I was used */
+    bool check_flag_used = false;   /* true ==> -c was used */
+    bool tape_flag_used = false;    /* true ==> -T was used */
+    bool lines_flag_used = false;   /* true ==> -L was used */
+    bool threads_flag_used = false; /* true ==> -t threads was used */
+    intmax_t threads = 0;	    /* -t worker threads, 0 ==> one per CPU */
+    char const *tape_dir = NULL;    /* -B cache directory of .jtree tape files, or NULL */
+    struct json_limits limits;	    /* -R resource limits of the parse */
+    bool limits_flag_used = false;  /* true ==> -R limits was used */
+    intmax_t push_size = 0;	    /* -P size of the pieces fed to the push parser, 0 ==> no push parse */
+    struct json_parse_ctx ctx;	    /* context of the -s parse */
     bool valid_json = false;	    /* true ==> JSON parse was valid */
+    struct json_valid_err verr;	    /* -c location of the first error */
     struct json *tree = NULL;	    /* JSON parse tree or NULL */
     int arg_count = 0;		    /* number of args to process */
     int i;
@@ -83,8 +115,9 @@ main(int argc, char **argv)
     /*
      * parse args
      */
+    memset(&limits, 0, sizeof(limits));
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hv:qVsJ:")) != -1) {
+    while ((i = getopt(argc, argv, ":hv:qVsJ:cEITLt:B:R:P:")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 0 */
 	    usage(2, program, ""); /*ooo*/
@@ -121,6 +154,44 @@ main(int argc, char **argv)
 	case 's':
 	    string_flag_used = true;
 	    break;
+	case 'c':
+	    check_flag_used = true;
+	    break;
+	case 'E':
+	    event_flag_used = true;
+	    break;
+	case 'I':
+	    index_flag_used = true;
+	    break;
+	case 'T':
+	    tape_flag_used = true;
+	    break;
+	case 'L':
+	    lines_flag_used = true;
+	    break;
+	case 't':		/* -t threads */
+	    if (string_to_intmax(optarg, &threads) == false || threads < 0 || threads > JSON_LINES_MAX_THREADS) {
+		usage(3, program, "invalid -t threads"); /*ooo*/
+		not_reached();
+	    }
+	    threads_flag_used = true;
+	    break;
+	case 'B':		/* -B dir */
+	    tape_dir = optarg;
+	    break;
+	case 'R':		/* -R limits */
+	    if (json_util_parse_limits(optarg, &limits) == false) {
+		usage(3, program, "invalid -R limits"); /*ooo*/
+		not_reached();
+	    }
+	    limits_flag_used = true;
+	    break;
+	case 'P':		/* -P size */
+	    if (string_to_intmax(optarg, &push_size) == false || push_size <= 0) {
+		usage(3, program, "invalid -P size"); /*ooo*/
+		not_reached();
+	    }
+	    break;
 	case ':':   /* option requires an argument */
 	case '?':   /* illegal option */
 	default:    /* anything else but should not actually happen */
@@ -135,16 +206,162 @@ main(int argc, char **argv)
 	usage(3, program, "wrong number of arguments"); /*ooo*/
 	not_reached();
     }
+    if (event_flag_used == true && index_flag_used == true) {
+	usage(3, program, "-E and -I cannot be used together"); /*ooo*/
+	not_reached();
+    }
+    if (tape_flag_used == true && (event_flag_used == true || index_flag_used == true || lines_flag_used == true)) {
+	usage(3, program, "-T cannot be used with -E, -I or -L"); /*ooo*/
+	not_reached();
+    }
+    if (lines_flag_used == true && index_flag_used == true) {
+	usage(3, program, "-L and -I cannot be used together"); /*ooo*/
+	not_reached();
+    }
+    if (check_flag_used == true &&
+	(event_flag_used == true || index_flag_used == true || tape_flag_used == true ||
+	 lines_flag_used == true || tape_dir != NULL)) {
+	usage(3, program, "-c cannot be used with -E, -I, -T, -L or -B"); /*ooo*/
+	not_reached();
+    }
+    if (limits_flag_used == true &&
+	(check_flag_used == true || event_flag_used == true || index_flag_used == true ||
+	 lines_flag_used == true || tape_dir != NULL)) {
+	usage(3, program, "-R limits cannot be used with -c, -E, -I, -L or -B"); /*ooo*/
+	not_reached();
+    }
+    if (push_size > 0 &&
+	(check_flag_used == true || event_flag_used == true || index_flag_used == true ||
+	 lines_flag_used == true || tape_dir != NULL)) {
+	usage(3, program, "-P size cannot be used with -c, -E, -I, -L or -B"); /*ooo*/
+	not_reached();
+    }
+    if (threads_flag_used == true && lines_flag_used == false) {
+	usage(3, program, "-t threads requires -L"); /*ooo*/
+	not_reached();
+    }
+    if (tape_dir != NULL &&
+	(string_flag_used == true || event_flag_used == true || index_flag_used == true || lines_flag_used == true)) {
+	usage(3, program, "-B dir cannot be used with -s, -E, -I or -L"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * case: parse each record of -s arg
+     */
+    if (lines_flag_used == true && string_flag_used == true) {
+
+	/* parse arg as JSON Lines */
+	dbg(DBG_HIGH, "Calling parse_json_lines(\"%s\", %ju, NULL, %jd, %s, check_line, NULL):",
+		      argv[argc-1], (uintmax_t)strlen(argv[argc-1]), threads, event_flag_used ? "false" : "true");
+	valid_json = parse_json_lines(argv[argc-1], strlen(argv[argc-1]), NULL, (unsigned int)threads,
+				      !event_flag_used, check_line, NULL);
+
+    /*
+     * case: parse each record of file arg
+     */
+    } else if (lines_flag_used == true) {
+
+	/* parse arg as a JSON Lines filename */
+	dbg(DBG_HIGH, "Calling parse_json_lines_file(\"%s\", %jd, %s, check_line, NULL):",
+		      argv[argc-1], threads, event_flag_used ? "false" : "true");
+	valid_json = parse_json_lines_file(argv[argc-1], (unsigned int)threads, !event_flag_used, check_line, NULL);
+
+    /*
+     * case: check the syntax of -s arg
+     */
+    } else if (check_flag_used == true && string_flag_used == true) {
+
+	/* check arg as a block of json input */
+	dbg(DBG_HIGH, "Calling json_validate(\"%s\", %ju, &verr):",
+		      argv[argc-1], (uintmax_t)strlen(argv[argc-1]));
+	valid_json = json_validate(argv[argc-1], strlen(argv[argc-1]), &verr);
+	if (valid_json == false) {
+	    fpr(stderr, program, "%s in string at line %d column %d\n", verr.msg, verr.line, verr.column);
+	}
+
+    /*
+     * case: check the syntax of file arg
+     */
+    } else if (check_flag_used == true) {
+
+	/* check arg as a json filename */
+	dbg(DBG_HIGH, "Calling json_validate_file(\"%s\", &verr):", argv[argc-1]);
+	valid_json = json_validate_file(argv[argc-1], &verr);
+	if (valid_json == false) {
+	    fpr(stderr, program, "%s in file %s at line %d column %d\n", verr.msg, argv[argc-1], verr.line, verr.column);
+	}
+
+    /*
+     * case: validate -s arg with the structural index
+     */
+    } else if (index_flag_used == true && string_flag_used == true) {
+
+	/* index arg as a block of json input */
+	dbg(DBG_HIGH, "Calling json_index_valid(\"%s\", %ju, NULL):",
+		      argv[argc-1], (uintmax_t)strlen(argv[argc-1]));
+	valid_json = json_index_valid(argv[argc-1], strlen(argv[argc-1]), NULL);
+
+    /*
+     * case: validate file arg with the structural index
+     */
+    } else if (index_flag_used == true) {
+
+	/* index arg as a json filename */
+	dbg(DBG_HIGH, "Calling json_index_valid_file(\"%s\"):", argv[argc-1]);
+	valid_json = json_index_valid_file(argv[argc-1]);
+
+    /*
+     * case: validate -s arg with the event parser
+     */
+    } else if (event_flag_used == true && string_flag_used == true) {
+
+	/* parse arg as a block of json input */
+	dbg(DBG_HIGH, "Calling parse_json_events(\"%s\", %ju, NULL, JSON_INFINITE_DEPTH, NULL, NULL):",
+		      argv[argc-1], (uintmax_t)strlen(argv[argc-1]));
+	valid_json = parse_json_events(argv[argc-1], strlen(argv[argc-1]), NULL, JSON_INFINITE_DEPTH, NULL, NULL);
+
+    /*
+     * case: validate file arg with the event parser
+     */
+    } else if (event_flag_used == true) {
+
+	/* parse arg as a json filename */
+	dbg(DBG_HIGH, "Calling parse_json_events_file(\"%s\", JSON_INFINITE_DEPTH, NULL, NULL):", argv[argc-1]);
+	valid_json = parse_json_events_file(argv[argc-1], JSON_INFINITE_DEPTH, NULL, NULL);
+
+    /*
+     * case: feed -s arg or file arg to the push parser
+     */
+    } else if (push_size > 0) {
+
+	/* parse arg in pieces */
+	dbg(DBG_HIGH, "Calling parse_json_pushed(\"%s\", %s, %jd, %s, &valid_json):",
+		      argv[argc-1], string_flag_used ? "true" : "false", push_size, limits_flag_used ? "&limits" : "NULL");
+	tree = parse_json_pushed(argv[argc-1], string_flag_used, (size_t)push_size,
+				 limits_flag_used ? &limits : NULL, &valid_json);
 
     /*
      * case: process -s arg
      */
-    if (string_flag_used == true) {
+    } else if (string_flag_used == true) {
 
 	/* parse arg as a block of json input */
-	dbg(DBG_HIGH, "Calling parse_json(\"%s\", %ju, NULL, &valid_json):",
+	dbg(DBG_HIGH, "Calling parse_json_ctx(\"%s\", %ju, NULL, &ctx, &valid_json):",
 		      argv[argc-1], (uintmax_t)strlen(argv[argc-1]));
-	tree = parse_json(argv[argc-1], strlen(argv[argc-1]), NULL, &valid_json);
+	json_parse_ctx_init(&ctx, NULL, NULL);
+	ctx.limits = limits_flag_used ? &limits : NULL;
+	tree = parse_json_ctx(argv[argc-1], strlen(argv[argc-1]), NULL, &ctx, &valid_json);
+
+    /*
+     * case: process file arg with its tape in the cache directory
+     */
+    } else if (tape_dir != NULL) {
+
+	/* map the tape of arg, or parse arg as a json filename and cache its tape */
+	dbg(DBG_HIGH, "Calling parse_json_cached(\"%s\", \"%s\", %s, &valid_json):",
+		      argv[argc-1], tape_dir, tape_flag_used ? "true" : "false");
+	tree = parse_json_cached(argv[argc-1], tape_dir, tape_flag_used, &valid_json);
 
     /*
      * case: process file arg
@@ -152,17 +369,24 @@ main(int argc, char **argv)
     } else {
 
 	/* parse arg as a json filename */
-	dbg(DBG_HIGH, "Calling parse_json_file(\"%s\", &valid_json):", argv[argc-1]);
-	tree = parse_json_file(argv[argc-1], &valid_json);
+	dbg(DBG_HIGH, "Calling parse_json_file_limits(\"%s\", %s, &valid_json):",
+		      argv[argc-1], limits_flag_used ? "&limits" : "NULL");
+	tree = parse_json_file_limits(argv[argc-1], limits_flag_used ? &limits : NULL, &valid_json);
     }
 
     if (tree == NULL) {
-	warn(program, "JSON parse tree is NULL");
+	if (check_flag_used == false && event_flag_used == false && index_flag_used == false && lines_flag_used == false &&
+	    (tape_dir == NULL || tape_flag_used == true || valid_json == false)) {
+	    warn(program, "JSON parse tree is NULL");
+	}
     }
     /*
      * free the JSON parse tree
      */
     else {
+	if (tape_flag_used == true && valid_json == true) {
+	    valid_json = check_tape(tree);
+	}
 	json_tree_free(tree, JSON_INFINITE_DEPTH);
 	free(tree);
 	tree = NULL;
@@ -181,6 +405,301 @@ main(int argc, char **argv)
 }
 
 
+/*
+ * check_line - report an invalid JSON Lines record
+ *
+ * This is the parse_json_lines() callback for -L.
+ *
+ * given:
+ *	rec	parsed record
+ *	ctx	not used
+ *
+ * returns:
+ *	true ==> go on to the next record
+ */
+static bool
+check_line(struct json_line *rec, void *ctx)
+{
+    UNUSED_ARG(ctx);
+
+    /*
+     * firewall
+     */
+    if (rec == NULL) {
+	warn(__func__, "rec is NULL");
+	return false;
+    }
+
+    /*
+     * report an invalid record
+     */
+    if (rec->is_valid == false) {
+	warn(__func__, "record %ju at line %ju is invalid JSON", rec->num, rec->line);
+    } else {
+	dbg(DBG_VHIGH, "record %ju at line %ju is valid JSON", rec->num, rec->line);
+    }
+    return true;
+}
+
+
+/*
+ * check_tape - check that the tape of a parse tree forms the same parse tree
+ *
+ * The tape of tree is formed, a tree is formed from the tape and the tape
+ * of that tree must be equal to the first tape.
+ *
+ * given:
+ *	tree	JSON parse tree
+ *
+ * returns:
+ *	true ==> tape forms the same parse tree, false ==> it does not
+ */
+static bool
+check_tape(struct json const *tree)
+{
+    struct json_tape *tape = NULL;	/* tape of tree */
+    struct json *copy = NULL;		/* parse tree formed from tape */
+    struct json_tape *tape2 = NULL;	/* tape of copy */
+    bool same = false;			/* true ==> tape and tape2 are equal */
+
+    /*
+     * firewall
+     */
+    if (tree == NULL) {
+	warn(__func__, "tree is NULL");
+	return false;
+    }
+
+    /*
+     * form the tape of the tree and the tree of the tape
+     */
+    tape = json_tape_from_tree(tree);
+    if (tape == NULL) {
+	warn(__func__, "json_tape_from_tree() returned NULL");
+	return false;
+    }
+    if (dbg_allowed(DBG_VHIGH)) {
+	json_tape_fprint(stderr, tape);
+    }
+    copy = json_tape_to_tree(tape);
+    if (copy == NULL) {
+	warn(__func__, "json_tape_to_tree() returned NULL");
+	json_tape_free(tape);
+	return false;
+    }
+
+    /*
+     * the tape of the tree of the tape must be the tape
+     */
+    tape2 = json_tape_from_tree(copy);
+    if (tape2 == NULL) {
+	warn(__func__, "json_tape_from_tree() of the tree of the tape returned NULL");
+    } else {
+	same = json_tape_equal(tape, tape2);
+	if (same == false) {
+	    warn(__func__, "tape does not form the same JSON parse tree");
+	} else {
+	    dbg(DBG_MED, "tape of %ju words forms the same JSON parse tree", (uintmax_t)tape->count);
+	}
+    }
+
+    /*
+     * free everything
+     */
+    json_tape_free(tape2);
+    json_tape_free(tape);
+    json_tree_free(copy, JSON_INFINITE_DEPTH);
+    free(copy);
+    return same;
+}
+
+
+/*
+ * parse_json_cached - parse a JSON file, or map its tape
+ *
+ * If the .jtree tape file of path in dir is of the file as it is now, the
+ * file is valid JSON and is neither read nor parsed.  Otherwise the file
+ * is parsed and, if valid, the tape of its parse tree is written to dir.
+ *
+ * given:
+ *	path	    JSON file, or - ==> stdin, which is never cached
+ *	dir	    cache directory of .jtree tape files
+ *	want_tree   true ==> return the parse tree, forming it from the tape if need be
+ *	is_valid    pointer to set to true if the JSON is valid
+ *
+ * returns:
+ *	JSON parse tree, or NULL ==> invalid JSON, or a tape was used and want_tree is false
+ */
+static struct json *
+parse_json_cached(char const *path, char const *dir, bool want_tree, bool *is_valid)
+{
+    struct stat buf;			/* status of path */
+    char *name = NULL;			/* name of the tape file of path */
+    struct json_tape *tape = NULL;	/* tape of path */
+    struct json *tree = NULL;		/* JSON parse tree to return */
+
+    /*
+     * firewall
+     */
+    if (path == NULL || dir == NULL || is_valid == NULL) {
+	err(4, __func__, "called with NULL arg(s)"); /*ooo*/
+	not_reached();
+    }
+    *is_valid = false;
+
+    /*
+     * stdin and other than regular files are only parsed
+     */
+    if (strcmp(path, "-") == 0 || stat(path, &buf) != 0 || !S_ISREG(buf.st_mode)) {
+	return parse_json_file(path, is_valid);
+    }
+    name = json_tape_cache_name(path, dir);
+    if (name == NULL) {
+	return parse_json_file(path, is_valid);
+    }
+
+    /*
+     * case: the tape file is of the file as it is now
+     *
+     * NOTE: A tape that does not form a parse tree is parsed over.
+     */
+    tape = json_tape_map(name, &buf);
+    if (tape != NULL) {
+	dbg(DBG_MED, "using tape file: %s", name);
+	if (want_tree == true) {
+	    tree = json_tape_to_tree(tape);
+	    if (tree == NULL) {
+		warn(__func__, "json_tape_to_tree() of tape file: %s returned NULL", name);
+	    }
+	}
+	json_tape_free(tape);
+	tape = NULL;
+	if (want_tree == false || tree != NULL) {
+	    *is_valid = true;
+	    free(name);
+	    return tree;
+	}
+    }
+
+    /*
+     * parse the file and write its tape for the next run
+     */
+    tree = parse_json_file(path, is_valid);
+    if (*is_valid == true && tree != NULL) {
+	tape = json_tape_from_tree(tree);
+	if (tape != NULL) {
+	    (void) json_tape_write(tape, name, &buf);
+	    json_tape_free(tape);
+	}
+    }
+    free(name);
+    return tree;
+}
+
+
+/*
+ * parse_json_pushed - parse a JSON string or file fed to the push parser in pieces
+ *
+ * A file is read with read(2) a piece at a time and each piece is fed to
+ * the push parser as it is read, as bytes that arrive on a socket or pipe
+ * would be.
+ *
+ * given:
+ *	arg	    JSON string, or JSON file, or - ==> stdin
+ *	is_string   true ==> arg is a JSON string, false ==> arg is a file
+ *	size	    most bytes of a piece
+ *	limits	    resource limits of the parse, or NULL ==> no limits
+ *	is_valid    pointer to set to true if the JSON is valid
+ *
+ * returns:
+ *	JSON parse tree, or NULL
+ */
+static struct json *
+parse_json_pushed(char const *arg, bool is_string, size_t size, struct json_limits const *limits, bool *is_valid)
+{
+    struct json_push *push = NULL;	/* push parse state */
+    char *buf = NULL;			/* piece read from the file */
+    size_t len = 0;			/* length of arg */
+    size_t off = 0;			/* offset in arg of the next piece */
+    ssize_t ret = 0;			/* read(2) return */
+    int fd = -1;			/* file descriptor of the file */
+
+    /*
+     * firewall
+     */
+    if (arg == NULL || is_valid == NULL || size == 0) {
+	err(5, __func__, "called with NULL arg(s) or 0 size"); /*ooo*/
+	not_reached();
+    }
+    *is_valid = false;
+
+    /*
+     * case: feed the JSON string a piece at a time
+     */
+    if (is_string == true) {
+	push = json_push_create(NULL, limits);
+	len = strlen(arg);
+	for (off = 0; off < len; off += size) {
+	    if (json_push_feed(push, arg + off, len - off < size ? len - off : size) == false) {
+		break;
+	    }
+	}
+	return json_push_finish(push, is_valid);
+    }
+
+    /*
+     * open the file
+     */
+    if (strcmp(arg, "-") == 0) {
+	fd = STDIN_FILENO;
+    } else {
+	errno = 0;		/* pre-clear errno for warnp() */
+	fd = open(arg, O_RDONLY);
+	if (fd < 0) {
+	    warnp(__func__, "cannot open: %s", arg);
+	    return NULL;
+	}
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    buf = malloc(size);
+    if (buf == NULL) {
+	errp(6, __func__, "malloc of %ju bytes failed", (uintmax_t)size); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * feed each piece as it is read
+     */
+    push = json_push_create(arg, limits);
+    for (;;) {
+	errno = 0;		/* pre-clear errno for warnp() */
+	ret = read(fd, buf, size);
+	if (ret < 0 && errno == EINTR) {
+	    continue;
+	} else if (ret < 0) {
+	    warnp(__func__, "read error: %s", arg);
+	    json_push_free(push);
+	    push = NULL;
+	    break;
+	} else if (ret == 0 || json_push_feed(push, buf, (size_t)ret) == false) {
+	    break;
+	}
+    }
+
+    /*
+     * close the file
+     */
+    free(buf);
+    if (fd != STDIN_FILENO) {
+	(void) close(fd);
+    }
+    if (push == NULL) {
+	return NULL;
+    }
+    return json_push_finish(push, is_valid);
+}
+
+
 /*
  * usage - print usage to stderr
  *
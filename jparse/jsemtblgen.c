@@ -42,12 +42,14 @@
 #define REQUIRED_ARGS (1)	/* number of required arguments on the command line */
 #define CHUNK (16)		/* allocate CHUNK elements at a time */
 #define STRLEN(s)		(sizeof (s)-1)
+#define MAX_MATCH_MOD (65536)	/* largest modulus of a member name hash switch */
 
 
 /*
  * static globals
  */
 static bool h_mode = false;		/* -I - true ==> output as .h include file, false ==> output as .c src */
+static bool match_mode = false;		/* -C - true ==> also output the compiled match function */
 static char *tbl_name = "sem_tbl";	/* -N name - name of the semantic table */
 static char *def_func = NULL;		/* -D def_func - validate with def_func() unless overridden */
 static char *prefix = NULL;		/* -P prefix - validate JTYPE_MEMBER with prefix_name() or NULL */
@@ -64,7 +66,7 @@ static char *unknown_func = NULL;	/* -U func - validate nodes with unknown types
  * usage message
  */
 static const char * const usage_msg =
-    "usage: %s [-h] [-v level] [-J level] [-q] [-V] [-s] [-I] [-N name] [-D def_func] [-P prefix]\n"
+    "usage: %s [-h] [-v level] [-J level] [-q] [-V] [-s] [-I] [-C] [-N name] [-D def_func] [-P prefix]\n"
     "\t\t    [-1 func] [-S func] [-B func] [-0 func] [-M func] [-O func] [-A func] [-U func] json_arg\n"
     "\n"
     "\t-h\t\tprint help message and exit\n"
@@ -76,6 +78,11 @@ static const char * const usage_msg =
     "\n"
     "\t-I\t\toutput as .h include file (def: output as .c src)\n"
     "\n"
+    "\t-C\t\talso output the compiled match function name_match() of the table (def: do not)\n"
+    "\n"
+    "\t\t\tNOTE: With -I, the function declaration is output.\n"
+    "\t\t\tNOTE: name_match() is given to json_sem_check_match() along with the table.\n"
+    "\n"
     "\t-N name\t\tname of the semantics table (def: sem_tbl)\n"
     "\n"
     "\t-D def_func\tvalidate with def_func() unless overridden by another flag (def: NULL)\n"
@@ -240,13 +247,16 @@ static Word cwords[] = {
 /*
  * forward declarations
  */
-static void gen_sem_tbl(struct json *tree, unsigned int max_depth, ...);
-static void vupdate_tbl(struct json *node, unsigned int depth, va_list ap);
+static void gen_sem_tbl(struct json *tree, unsigned int max_depth, struct dyn_array *tbl);
+static void update_tbl(struct json *node, unsigned int depth, void *ctx);
 static int sem_cmp(void const *a, void const *b);
 static char *alloc_c_funct_name(char const *prefix, char const *str);
 static bool append_unique_str(struct dyn_array *tbl, char *str);
 static void print_sem_c_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name);
 static void print_sem_h_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name);
+static char *alloc_validate_name(struct json_sem const *p);
+static void print_match_return(struct dyn_array *tbl, intmax_t i, char const *indent);
+static void print_sem_c_match(struct dyn_array *tbl, char *tbl_name);
 static Word *find_member(Word *table, const char *string);
 static bool test_reserved(const char *string);
 static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
@@ -271,7 +281,7 @@ main(int argc, char **argv)
      * parse args
      */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hv:J:qVsIN:D:P:1:S:B:0:M:O:A:U:")) != -1) {
+    while ((i = getopt(argc, argv, ":hv:J:qVsICN:D:P:1:S:B:0:M:O:A:U:")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 0 */
 	    usage(2, program, ""); /*ooo*/
@@ -311,6 +321,9 @@ main(int argc, char **argv)
 	case 'I':
 	    h_mode = true;
 	    break;
+	case 'C':		/* -C - also output the compiled match function */
+	    match_mode = true;
+	    break;
 	case 'N':		/* -N name - name of the semantic table */
 	    tbl_name = optarg;
 	    break;
@@ -446,6 +459,9 @@ main(int argc, char **argv)
 	print_sem_h_src(tbl, tbl_name, cap_tbl_name);
     } else {
 	print_sem_c_src(tbl, tbl_name, cap_tbl_name);
+	if (match_mode == true) {
+	    print_sem_c_match(tbl, tbl_name);
+	}
     }
 
     /*
@@ -486,17 +502,13 @@ main(int argc, char **argv)
  *      tree        pointer to root of a JSON parse tree
  *      max_depth   maximum tree depth to descend, or 0 ==> infinite depth
  *                      NOTE: Use JSON_INFINITE_DEPTH for infinite depth
- *      ...         extra args for vcallback, required extra args:
- *
- *		tbl	dynamic array of semantic table entries
+ *      tbl         dynamic array of semantic table entries
  *
  * NOTE: This function does nothing if tree is NULL.
  */
 static void
-gen_sem_tbl(struct json *tree, unsigned int max_depth, ...)
+gen_sem_tbl(struct json *tree, unsigned int max_depth, struct dyn_array *tbl)
 {
-    va_list ap;		/* variable argument list */
-
     /*
      * firewall - nothing to do for a NULL tree
      */
@@ -504,26 +516,16 @@ gen_sem_tbl(struct json *tree, unsigned int max_depth, ...)
         return;
     }
 
-    /*
-     * stdarg variable argument list setup
-     */
-    va_start(ap, max_depth);
-
     /*
      * update semantic table from the parsed JSON node tree
      */
-    vjson_tree_walk(tree, max_depth, 0, true, vupdate_tbl, ap);
-
-    /*
-     * stdarg variable argument list cleanup
-     */
-    va_end(ap);
+    json_walk(tree, max_depth, 0, true, update_tbl, tbl);
     return;
 }
 
 
 /*
- * vupdate_tbl - tree walk callback to update semantic table for a given JSON node
+ * update_tbl - tree walk callback to update semantic table for a given JSON node
  *
  * If the JSON node is represented in the semantic table, update the count.
  * If the JSON node is not in the semantic table, this function will add a
@@ -536,19 +538,16 @@ gen_sem_tbl(struct json *tree, unsigned int max_depth, ...)
  * given:
  *	node    pointer to a JSON parser tree node to free
  *      depth   current tree depth (0 ==> top of tree)
- *      ap      variable argument list, required ap args:
- *
- *		tbl	dynamic array of semantic table entries
+ *      ctx     dynamic array of semantic table entries
  *
  * NOTE: This function does not return if given NULL pointers or on error.
  */
 static void
-vupdate_tbl(struct json *node, unsigned int depth, va_list ap)
+update_tbl(struct json *node, unsigned int depth, void *ctx)
 {
-    struct dyn_array *tbl = NULL;    /* semantic table - array of struct json_sem */
+    struct dyn_array *tbl = ctx;     /* semantic table - array of struct json_sem */
     struct json_sem *p = NULL;	     /* i-th entry in the semantics table */
     struct json_sem new;	     /* new semantic table entry */
-    va_list ap2;		     /* copy of va_list ap */
     intmax_t len = 0;		     /* number of semantic table entries */
     bool match = false;		     /* true ==> semantic table entry match found */
     intmax_t i;
@@ -561,17 +560,11 @@ vupdate_tbl(struct json *node, unsigned int depth, va_list ap)
 	not_reached();
     }
 
-    /*
-     * duplicate va_list ap
-     */
-    va_copy(ap2, ap);
-
     /*
      * obtain the array of struct json_sem
      */
-    tbl = va_arg(ap2, struct dyn_array *);
     if (tbl == NULL) {
-	err(14, __func__, "tbl va_arg is NULL");
+	err(14, __func__, "tbl is NULL");
 	not_reached();
     }
     len = dyn_array_tell(tbl);
@@ -659,11 +652,6 @@ vupdate_tbl(struct json *node, unsigned int depth, va_list ap)
 	 */
 	(void) dyn_array_append_value(tbl, &new);
     }
-
-    /*
-     * stdarg variable argument list cleanup
-     */
-    va_end(ap2);
     return;
 }
 
@@ -1416,6 +1404,14 @@ print_sem_h_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name)
     }
     dyn_array_free(unique_tbl);
 
+    /*
+     * print the compiled match function declaration if -C
+     */
+    if (match_mode == true) {
+	print("\nextern int %s_match(struct json const *node,\n\tunsigned int depth, "
+	      "struct json_sem *sem, bool *valid, struct json_sem_val_err **val_err);\n", tbl_name);
+    }
+
     /*
      * print semantic table trailer
      */
@@ -1425,6 +1421,330 @@ print_sem_h_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name)
 }
 
 
+/*
+ * alloc_validate_name - allocate the name of the validate function of a semantic table entry
+ *
+ * The name is the one print_sem_c_src() prints for the entry.
+ *
+ * given:
+ *	p	semantic table entry
+ *
+ * returns:
+ *	allocated validate function name, or NULL ==> entry has no validate function
+ *
+ * NOTE: This function does not return if given NULL pointers or on error.
+ */
+static char *
+alloc_validate_name(struct json_sem const *p)
+{
+    char *validate = def_func;	/* validation function name, starting with the default name, which may be NULL */
+
+    /*
+     * firewall
+     */
+    if (p == NULL) {
+	err(34, __func__, "p is NULL");
+	not_reached();
+    }
+
+    /*
+     * case: JSON MEMBER
+     *
+     * -M member_func overrides any member named function.
+     */
+    if (p->type == JTYPE_MEMBER) {
+	if (member_func != NULL) {
+	    return alloc_c_funct_name(prefix, member_func);
+	} else if (p->name != NULL) {
+	    return alloc_c_funct_name(prefix, p->name);
+	}
+	return NULL;
+    }
+
+    /*
+     * case: JSON non-MEMBER
+     */
+    switch (p->type) {
+    case JTYPE_NUMBER:
+	if (number_func != NULL) {
+	    validate = number_func;
+	}
+	break;
+    case JTYPE_STRING:
+	if (string_func != NULL) {
+	    validate = string_func;
+	}
+	break;
+    case JTYPE_BOOL:
+	if (bool_func != NULL) {
+	    validate = bool_func;
+	}
+	break;
+    case JTYPE_NULL:
+	if (null_func != NULL) {
+	    validate = null_func;
+	}
+	break;
+    case JTYPE_OBJECT:
+	if (object_func != NULL) {
+	    validate = object_func;
+	}
+	break;
+    case JTYPE_ARRAY:
+	if (array_func != NULL) {
+	    validate = array_func;
+	}
+	break;
+    default:
+	if (unknown_func != NULL) {
+	    validate = unknown_func;
+	}
+	break;
+    }
+    if (validate == NULL) {
+	return NULL;
+    }
+    return alloc_c_funct_name(prefix, validate);
+}
+
+
+/*
+ * print_match_return - print the code of a compiled match that returns a semantic table entry
+ *
+ * given:
+ *	tbl	dynamic array of sorted semantic table entries
+ *	i	index of the semantic table entry
+ *	indent	indent of the code
+ *
+ * NOTE: This function does not return on error.
+ */
+static void
+print_match_return(struct dyn_array *tbl, intmax_t i, char const *indent)
+{
+    struct json_sem *p = NULL;	/* semantic table entry */
+    char *func_name = NULL;	/* validate function name (allocated) or NULL */
+
+    p = dyn_array_addr(tbl, struct json_sem, i);
+    func_name = alloc_validate_name(p);
+    if (func_name != NULL) {
+	print("%s*valid = %s(node, depth, sem, val_err);\n", indent, func_name);
+	free(func_name);
+	func_name = NULL;
+    }
+    print("%sreturn %jd;\n", indent, i);
+    return;
+}
+
+
+/*
+ * print_sem_c_match - print the compiled match function of a sorted semantic table
+ *
+ * The function, tbl_name_match(), finds the first match of a JSON node in the
+ * semantic table print_sem_c_src() printed, as json_sem_find() would, with a
+ * switch on the depth and type of the node.  A JTYPE_MEMBER is found with a
+ * switch on the json_name_hash() of its name, modulo the smallest number that
+ * gives each name of that depth a case of its own, and a strcmp() of the names.
+ * The function calls the validate function of the match directly.
+ *
+ * given:
+ *	tbl		dynamic array of semantic table entries, sorted by print_sem_c_src()
+ *	tbl_name	name of the semantic table
+ *
+ * NOTE: This function does not return if given NULL pointers or on error.
+ */
+static void
+print_sem_c_match(struct dyn_array *tbl, char *tbl_name)
+{
+    struct json_sem *p = NULL;	/* semantic table entry */
+    struct json_sem *q = NULL;	/* another semantic table entry */
+    char **name = NULL;		/* semantic table names as C strings (allocated), NULL ==> no name */
+    uint32_t *hash = NULL;	/* json_name_hash() of each name */
+    bool *done = NULL;		/* true ==> the case of the entry has been printed */
+    uint32_t mod = 0;		/* modulus of a member name hash switch */
+    bool distinct = false;	/* true ==> each name of a member name hash switch has a case of its own */
+    intmax_t len = 0;		/* number of semantic table entries */
+    intmax_t start = 0;		/* first entry of a depth, or of a depth and type */
+    intmax_t end = 0;		/* entry after the last of a depth and type */
+    intmax_t i;
+    intmax_t j;
+    intmax_t k;
+
+    /*
+     * firewall
+     */
+    if (tbl == NULL) {
+	err(35, __func__, "tbl is NULL");
+	not_reached();
+    }
+    if (tbl_name == NULL) {
+	err(36, __func__, "tbl_name is NULL");
+	not_reached();
+    }
+    len = dyn_array_tell(tbl);
+
+    /*
+     * form the names as print_sem_c_src() printed them, and their hashes
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    name = calloc((size_t)len + 1, sizeof(name[0]));
+    if (name == NULL) {
+	errp(37, __func__, "calloc of %jd names failed", len + 1);
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    hash = calloc((size_t)len + 1, sizeof(hash[0]));
+    if (hash == NULL) {
+	errp(38, __func__, "calloc of %jd hashes failed", len + 1);
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    done = calloc((size_t)len + 1, sizeof(done[0]));
+    if (done == NULL) {
+	errp(39, __func__, "calloc of %jd flags failed", len + 1);
+	not_reached();
+    }
+    for (i=0; i < len; ++i) {
+	p = dyn_array_addr(tbl, struct json_sem, i);
+	if (p->type == JTYPE_MEMBER) {
+	    if (p->name == NULL) {
+		err(40, __func__, "semantic tbl[%jd] JTYPE_MEMBER name is NULL", i);
+		not_reached();
+	    }
+	    name[i] = alloc_c_funct_name(NULL, p->name);
+	    hash[i] = json_name_hash(name[i], strlen(name[i]));
+	}
+    }
+
+    /*
+     * print function header
+     */
+    print("\n\n/*\n * %s_match - find the first match of a JSON node in %s and validate it\n", tbl_name, tbl_name);
+    prstr(" *\n * See json_sem_check_match() for details.\n */\n");
+    print("int\n%s_match(struct json const *node, unsigned int depth, struct json_sem *sem,\n", tbl_name);
+    prstr("\tbool *valid, struct json_sem_val_err **val_err)\n{\n");
+    prstr("    char *name = NULL;\t\t/* decoded name of JTYPE_MEMBER node or NULL */\n");
+    prstr("    uint32_t hash = 0;\t\t/* json_name_hash() of name */\n");
+    prstr("    int ret;\t\t\t/* sem_node_name() result */\n\n");
+    prstr("    *valid = true;\n");
+    prstr("    ret = sem_node_name(node, depth, sem, &name, &hash);\n");
+    prstr("    if (ret < 0) {\n\treturn ret;\n    }\n");
+    prstr("    switch (depth) {\n");
+
+    /*
+     * print a case for each depth
+     *
+     * NOTE: The sorted semantic table has the entries of each depth, and each
+     *	     type within each depth, next to each other.
+     */
+    for (start=0; start < len; ) {
+	p = dyn_array_addr(tbl, struct json_sem, start);
+	print("    case %u:\n", p->depth);
+	prstr("\tswitch (node->type) {\n");
+
+	/*
+	 * print a case for each type of the depth
+	 */
+	for (i=start; i < len; i=end) {
+	    q = dyn_array_addr(tbl, struct json_sem, i);
+	    if (q->depth != p->depth) {
+		break;
+	    }
+	    for (end=i+1; end < len; ++end) {
+		struct json_sem *e = dyn_array_addr(tbl, struct json_sem, end);
+		if (e->depth != q->depth || e->type != q->type) {
+		    break;
+		}
+	    }
+	    print("\tcase %s:\n", json_type_name(q->type));
+
+	    /*
+	     * case: non-JTYPE_MEMBER - the first entry of the depth and type matches
+	     */
+	    if (q->type != JTYPE_MEMBER) {
+		print_match_return(tbl, i, "\t    ");
+		continue;
+	    }
+
+	    /*
+	     * case: JTYPE_MEMBER without a name - the first entry of the depth and type matches
+	     */
+	    prstr("\t    if (name == NULL) {\n");
+	    print_match_return(tbl, i, "\t\t");
+	    prstr("\t    }\n");
+
+	    /*
+	     * find the smallest modulus that gives each name a case of its own
+	     *
+	     * NOTE: Should no modulus do so, names that share a case are tested in turn.
+	     */
+	    for (mod=(uint32_t)(end-i); mod < MAX_MATCH_MOD; ++mod) {
+		distinct = true;
+		for (j=i; j < end && distinct == true; ++j) {
+		    for (k=j+1; k < end; ++k) {
+			if (hash[j] % mod == hash[k] % mod) {
+			    distinct = false;
+			    break;
+			}
+		    }
+		}
+		if (distinct == true) {
+		    break;
+		}
+	    }
+	    dbg(DBG_MED, "depth %u: %jd name(s) in %u case(s)%s", q->depth, end-i, mod,
+			 distinct ? "" : " with shared cases");
+
+	    /*
+	     * print the case of each name, in table order within each case
+	     */
+	    print("\t    switch (hash %% %uU) {\n", mod);
+	    for (j=i; j < end; ++j) {
+		if (done[j] == true) {
+		    continue;
+		}
+		print("\t    case %u:\n", hash[j] % mod);
+		for (k=j; k < end; ++k) {
+		    if (done[k] == false && hash[k] % mod == hash[j] % mod) {
+			print("\t\tif (strcmp(name, \"%s\") == 0) {\n", name[k]);
+			print_match_return(tbl, k, "\t\t    ");
+			prstr("\t\t}\n");
+			done[k] = true;
+		    }
+		}
+		prstr("\t\tbreak;\n");
+	    }
+	    prstr("\t    default:\n\t\tbreak;\n\t    }\n");
+	    prstr("\t    break;\n");
+	}
+	prstr("\tdefault:\n\t    break;\n\t}\n\tbreak;\n");
+	start = i;
+    }
+
+    /*
+     * print function trailer
+     */
+    prstr("    default:\n\tbreak;\n    }\n");
+    prstr("    return -1;\n}\n");
+
+    /*
+     * free names
+     */
+    for (i=0; i < len; ++i) {
+	if (name[i] != NULL) {
+	    free(name[i]);
+	    name[i] = NULL;
+	}
+    }
+    free(name);
+    name = NULL;
+    free(hash);
+    hash = NULL;
+    free(done);
+    done = NULL;
+    return;
+}
+
+
 /*
  * find_member - find an entry in a word table
  *
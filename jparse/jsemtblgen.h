@@ -66,17 +66,20 @@
 /*
  * official jsemtblgen version
  */
-#define JSEMTBLGEN_VERSION "1.0 2023-02-04"		/* format: major.minor YYYY-MM-DD */
+#define JSEMTBLGEN_VERSION "1.1 2026-10-16"		/* format: major.minor YYYY-MM-DD */
 
 
 /*
  * static functions
  */
-static void gen_sem_tbl(struct json *tree, unsigned int max_depth, ...);
-static void vupdate_tbl(struct json *node, unsigned int depth, va_list ap);
+static void gen_sem_tbl(struct json *tree, unsigned int max_depth, struct dyn_array *tbl);
+static void update_tbl(struct json *node, unsigned int depth, void *ctx);
 static int sem_cmp(void const *a, void const *b);
 static void print_sem_c_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name);
 static void print_sem_h_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name);
+static char *alloc_validate_name(struct json_sem const *p);
+static void print_match_return(struct dyn_array *tbl, intmax_t i, char const *indent);
+static void print_sem_c_match(struct dyn_array *tbl, char *tbl_name);
 
 
 
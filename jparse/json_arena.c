@@ -0,0 +1,592 @@
+/*
+ * json_arena - JSON parse tree arena allocator
+ *
+ * "Because freeing a tree one leaf at a time is for the birds." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdarg.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+
+/*
+ * static definitions
+ */
+#define ARENA_ROUND(n) (((n) + (JSON_ARENA_ALIGN-1)) & ~((size_t)(JSON_ARENA_ALIGN-1)))
+#define ARENA_HDR_SIZE (ARENA_ROUND(sizeof(struct json_arena_chunk)))
+#define ARENA_DATA(chunk) (((char *)(chunk)) + ARENA_HDR_SIZE)
+
+
+/*
+ * static functions
+ */
+static char *json_ctx_ref(struct json_parse_ctx const *ctx, char const *ptr, size_t len);
+static void json_arena_ref_nul(struct json *node, unsigned int depth, void *ctx);
+
+
+/*
+ * json_arena_create - create an empty JSON parse tree arena
+ *
+ * given:
+ *	chunk_size	usable bytes in a normal arena chunk, 0 ==> JSON_ARENA_CHUNK
+ *
+ * returns:
+ *	allocated empty arena
+ *
+ * NOTE: No arena memory is allocated until the first json_arena_alloc().
+ *
+ * NOTE: This function does not return on error.
+ */
+struct json_arena *
+json_arena_create(size_t chunk_size)
+{
+    struct json_arena *arena = NULL;	/* arena to return */
+
+    /*
+     * allocate the arena
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    arena = calloc(1, sizeof(*arena));
+    if (arena == NULL) {
+	errp(100, __func__, "calloc of %ju bytes failed", (uintmax_t)sizeof(*arena));
+	not_reached();
+    }
+
+    /*
+     * initialize the arena
+     */
+    if (chunk_size == 0) {
+	chunk_size = JSON_ARENA_CHUNK;
+    }
+    arena->chunk_size = ARENA_ROUND(chunk_size);
+    arena->head = NULL;
+    arena->chunk_count = 0;
+    arena->alloc_count = 0;
+    arena->alloc_bytes = 0;
+
+    dbg(DBG_VVHIGH, "created arena with chunk size: %ju", (uintmax_t)arena->chunk_size);
+    return arena;
+}
+
+
+/*
+ * json_arena_alloc - allocate zeroized memory from a JSON parse tree arena
+ *
+ * given:
+ *	arena	arena to allocate from
+ *	size	number of bytes to allocate
+ *
+ * returns:
+ *	pointer to size zeroized bytes aligned to JSON_ARENA_ALIGN
+ *
+ * NOTE: Requests larger than the arena chunk size are given a chunk of their own.
+ *
+ * NOTE: This function does not return on error.
+ * NOTE: This function will not return NULL.
+ */
+void *
+json_arena_alloc(struct json_arena *arena, size_t size)
+{
+    struct json_arena_chunk *chunk = NULL;	/* chunk to allocate from */
+    size_t csize = 0;				/* usable bytes of a new chunk */
+    void *ret = NULL;				/* allocated memory to return */
+
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	err(101, __func__, "arena is NULL");
+	not_reached();
+    }
+    if (size > SIZE_MAX - ARENA_HDR_SIZE - JSON_ARENA_ALIGN) {
+	err(102, __func__, "size: %ju is too large", (uintmax_t)size);
+	not_reached();
+    }
+    size = ARENA_ROUND(size > 0 ? size : 1);
+
+    /*
+     * allocate a new chunk if the current chunk is too full
+     */
+    chunk = arena->head;
+    if (chunk == NULL || chunk->size - chunk->used < size) {
+
+	/*
+	 * allocate a zeroized chunk
+	 *
+	 * A request that will not fit into a normal chunk is given its own chunk.
+	 * Such a chunk is linked behind the current chunk so that the remaining
+	 * space of the current chunk may still be used.
+	 */
+	csize = (size > arena->chunk_size) ? size : arena->chunk_size;
+	errno = 0;		/* pre-clear errno for errp() */
+	chunk = calloc(1, ARENA_HDR_SIZE + csize);
+	if (chunk == NULL) {
+	    errp(103, __func__, "calloc of %ju bytes failed", (uintmax_t)(ARENA_HDR_SIZE + csize));
+	    not_reached();
+	}
+	chunk->size = csize;
+	chunk->used = 0;
+	chunk->last = 0;
+	if (csize > arena->chunk_size && arena->head != NULL) {
+	    chunk->next = arena->head->next;
+	    arena->head->next = chunk;
+	} else {
+	    chunk->next = arena->head;
+	    arena->head = chunk;
+	}
+	++arena->chunk_count;
+    }
+
+    /*
+     * carve the allocation out of the chunk
+     */
+    ret = ARENA_DATA(chunk) + chunk->used;
+    chunk->last = chunk->used;
+    chunk->used += size;
+    ++arena->alloc_count;
+    arena->alloc_bytes += size;
+    return ret;
+}
+
+
+/*
+ * json_arena_grow - grow an arena allocation
+ *
+ * If ptr was the most recent allocation of the current arena chunk, and
+ * there is room in that chunk, the allocation is extended in place.
+ * Otherwise new memory is allocated from the arena and the old contents
+ * are copied into it.  The old memory is NOT reclaimed until the arena
+ * is reset or freed.
+ *
+ * given:
+ *	arena		arena to allocate from
+ *	ptr		previous arena allocation or NULL
+ *	old_size	size of the previous allocation in bytes
+ *	new_size	requested size in bytes
+ *
+ * returns:
+ *	pointer to new_size bytes whose first old_size bytes are those of ptr,
+ *	any remaining bytes are zeroized
+ *
+ * NOTE: This function does not return on error.
+ * NOTE: This function will not return NULL.
+ */
+void *
+json_arena_grow(struct json_arena *arena, void *ptr, size_t old_size, size_t new_size)
+{
+    struct json_arena_chunk *chunk = NULL;	/* current chunk */
+    size_t extra = 0;				/* additional rounded bytes needed */
+    void *ret = NULL;				/* allocated memory to return */
+
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	err(104, __func__, "arena is NULL");
+	not_reached();
+    }
+    if (ptr == NULL) {
+	return json_arena_alloc(arena, new_size);
+    }
+    if (new_size <= old_size) {
+	return ptr;
+    }
+
+    /*
+     * try to extend the most recent allocation in place
+     */
+    chunk = arena->head;
+    if (chunk != NULL && (char *)ptr == ARENA_DATA(chunk) + chunk->last &&
+	ARENA_ROUND(new_size) > chunk->used - chunk->last) {
+	extra = ARENA_ROUND(new_size) - (chunk->used - chunk->last);
+	if (chunk->size - chunk->used >= extra) {
+	    chunk->used += extra;
+	    arena->alloc_bytes += extra;
+	    return ptr;
+	}
+    }
+
+    /*
+     * allocate and copy
+     */
+    ret = json_arena_alloc(arena, new_size);
+    memcpy(ret, ptr, old_size);
+    return ret;
+}
+
+
+/*
+ * json_arena_reset - release all arena memory for reuse
+ *
+ * All but the most recently allocated normal chunk are freed, and that
+ * chunk is zeroized so that it may be used by the next parse.  This allows
+ * a batch of JSON documents to be parsed, one after another, without
+ * returning memory to the system in between.
+ *
+ * given:
+ *	arena	arena to reset
+ *
+ * NOTE: Every JSON parse tree allocated from arena becomes invalid.
+ *
+ * NOTE: This function does nothing if arena is NULL.
+ */
+void
+json_arena_reset(struct json_arena *arena)
+{
+    struct json_arena_chunk *chunk = NULL;	/* chunk to free */
+    struct json_arena_chunk *next = NULL;	/* next chunk to free */
+    struct json_arena_chunk *keep = NULL;	/* chunk to keep */
+
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	return;
+    }
+
+    /*
+     * free all chunks except for the first normal sized chunk
+     */
+    for (chunk = arena->head; chunk != NULL; chunk = next) {
+	next = chunk->next;
+	if (keep == NULL && chunk->size == arena->chunk_size) {
+	    keep = chunk;
+	} else {
+	    free(chunk);
+	}
+    }
+
+    /*
+     * zeroize the chunk that was kept
+     */
+    if (keep != NULL) {
+	memset(ARENA_DATA(keep), 0, keep->used);
+	keep->next = NULL;
+	keep->used = 0;
+	keep->last = 0;
+	arena->chunk_count = 1;
+    } else {
+	arena->chunk_count = 0;
+    }
+    arena->head = keep;
+    arena->alloc_count = 0;
+    arena->alloc_bytes = 0;
+    return;
+}
+
+
+/*
+ * json_arena_free - free an arena and everything allocated from it
+ *
+ * given:
+ *	arena	arena to free
+ *
+ * NOTE: Every JSON parse tree allocated from arena becomes invalid.
+ *
+ * NOTE: This function does nothing if arena is NULL.
+ */
+void
+json_arena_free(struct json_arena *arena)
+{
+    struct json_arena_chunk *chunk = NULL;	/* chunk to free */
+    struct json_arena_chunk *next = NULL;	/* next chunk to free */
+
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	return;
+    }
+
+    /*
+     * free all chunks and then the arena itself
+     */
+    dbg(DBG_VVHIGH, "freeing arena: chunks: %ju allocations: %ju bytes: %ju",
+		    arena->chunk_count, arena->alloc_count, arena->alloc_bytes);
+    for (chunk = arena->head; chunk != NULL; chunk = next) {
+	next = chunk->next;
+	free(chunk);
+    }
+    memset(arena, 0, sizeof(*arena));
+    free(arena);
+    return;
+}
+
+
+/*
+ * parse_json_arena - parse a JSON block of memory into an arena
+ *
+ * This function is identical to parse_json() except that every node, string
+ * and JSON object/array set of the returned JSON parse tree is allocated from
+ * arena.  The tree is released, all at once, by json_arena_free() or
+ * json_arena_reset().  An arena may hold the trees of more than one parse.
+ *
+ * given:
+ *	ptr		pointer to start of JSON blob
+ *	len		length of the JSON blob
+ *	filename	filename or NULL for stdin
+ *	is_valid	!= NULL ==> set to true or false depending on json validity
+ *	arena		arena to allocate the JSON parse tree from
+ *
+ * return:
+ *	pointer to a JSON parse tree
+ *
+ * NOTE: The returned tree must NOT be freed by json_tree_free() or free(3).
+ *
+ * NOTE: This function does not return if arena is NULL.
+ */
+struct json *
+parse_json_arena(char const *ptr, size_t len, char const *filename, bool *is_valid, struct json_arena *arena)
+{
+    struct json_parse_ctx ctx;		/* context of this parse */
+
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	err(105, __func__, "arena is NULL");
+	not_reached();
+    }
+
+    /*
+     * parse with the arena as the allocator
+     */
+    json_parse_ctx_init(&ctx, filename, arena);
+    return parse_json_ctx(ptr, len, NULL, &ctx, is_valid);
+}
+
+
+/*
+ * json_arena_ref - return a writable reference to text inside the input of the current parse
+ *
+ * During parse_json_arena_ref(), the scanner reads directly from a copy of the
+ * input that lives in the arena.  JSON strings and numbers found in that copy
+ * may be referenced by the parse tree instead of being duplicated.
+ *
+ * given:
+ *	ptr	start of text
+ *	len	length of text
+ *
+ * returns:
+ *	writable pointer to the text inside the input of the current parse,
+ *	or NULL ==> not parsing via parse_json_arena_ref() or ptr is not in its input
+ */
+char *
+json_arena_ref(char const *ptr, size_t len)
+{
+    return json_ctx_ref(json_parse_current, ptr, len);
+}
+
+
+/*
+ * json_ctx_ref - return a writable reference to text inside the input of a parse
+ *
+ * given:
+ *	ctx	context of a parse or NULL
+ *	ptr	start of text
+ *	len	length of text
+ *
+ * returns:
+ *	writable pointer to the text inside the input referenced by ctx,
+ *	or NULL ==> ctx references no input or ptr is not in its input
+ */
+static char *
+json_ctx_ref(struct json_parse_ctx const *ctx, char const *ptr, size_t len)
+{
+    size_t offset = 0;		/* offset of ptr in the referenced input */
+
+    /*
+     * case: no input is referenced
+     */
+    if (ctx == NULL || ctx->ref == NULL || ptr == NULL) {
+	return NULL;
+    }
+
+    /*
+     * case: text is not entirely inside the referenced input
+     */
+    if (ptr < ctx->ref || ptr > ctx->ref + ctx->ref_len) {
+	return NULL;
+    }
+    offset = (size_t)(ptr - ctx->ref);
+    if (len > ctx->ref_len - offset) {
+	return NULL;
+    }
+
+    /*
+     * return the writable reference
+     */
+    return ctx->ref + offset;
+}
+
+
+/*
+ * json_arena_ref_nul - NUL terminate JSON text referenced in the input
+ *
+ * This is a callback for json_walk().  The scanner uses the byte that
+ * follows a token while scanning, so referenced text may only be NUL
+ * terminated once the parse is complete.  The byte that follows a number is
+ * whitespace, a JSON structural character or the end of the input.  The byte
+ * that follows the text of a JSON string is its closing '"'.
+ *
+ * given:
+ *	node	pointer to a JSON parse tree node
+ *	depth	current tree depth (0 ==> top of tree)
+ *	ctx	pointer to the struct json_parse_ctx of the parse that formed the tree
+ */
+static void
+json_arena_ref_nul(struct json *node, unsigned int depth, void *ctx)
+{
+    struct json_parse_ctx const *parse = (struct json_parse_ctx const *)ctx;	/* context of the parse */
+    struct json_number *number = NULL;	/* JSON number inside node */
+    struct json_string *string = NULL;	/* JSON string inside node */
+    size_t len = 0;			/* length of referenced text */
+    char *ref = NULL;			/* referenced text or NULL */
+
+    UNUSED_ARG(depth);
+
+    /*
+     * firewall
+     */
+    if (node == NULL) {
+	return;
+    }
+
+    switch (node->type) {
+    case JTYPE_NUMBER:
+	number = &(node->item.number);
+	len = number->as_str_len;
+	ref = json_ctx_ref(parse, number->as_str, len);
+	break;
+    case JTYPE_STRING:
+	string = &(node->item.string);
+	len = string->as_str_len;
+	if (string->quote == true && len >= 2) {
+	    len -= 2;
+	}
+	ref = json_ctx_ref(parse, string->as_str, len);
+	break;
+    default:
+	break;
+    }
+
+    /*
+     * NUL terminate referenced text
+     *
+     * NOTE: json_ctx_ref() allows len to reach the end of the input, which
+     *	     is followed by JSON_SCAN_PAD NUL bytes.
+     */
+    if (ref != NULL) {
+	ref[len] = '\0';
+    }
+    return;
+}
+
+
+/*
+ * parse_json_arena_ref - parse a JSON block of memory into an arena without copying text
+ *
+ * This function is like parse_json_arena() except that the input is copied,
+ * once, into the arena and scanned in place.  JSON strings that decode to
+ * themselves, JSON member names and JSON numbers then refer to the text in
+ * that copy instead of being duplicated: their as_str (and for JSON strings
+ * that need no decoding, their str) points into the copy of the input.
+ * Only JSON strings with \-escapes are decoded into new arena memory.
+ *
+ * Referenced text is NUL terminated once the parse is complete so that it
+ * may be used as a C string, just like the text of a tree formed by parse_json().
+ * The lifetime of the input copy is the lifetime of the arena, so the caller
+ * may free or reuse ptr as soon as this function returns.
+ *
+ * given:
+ *	ptr		pointer to start of JSON blob
+ *	len		length of the JSON blob
+ *	filename	filename or NULL for stdin
+ *	is_valid	!= NULL ==> set to true or false depending on json validity
+ *	arena		arena to allocate the JSON parse tree from
+ *
+ * return:
+ *	pointer to a JSON parse tree
+ *
+ * NOTE: The returned tree must NOT be freed by json_tree_free() or free(3).
+ *
+ * NOTE: This function does not return if arena is NULL.
+ */
+struct json *
+parse_json_arena_ref(char const *ptr, size_t len, char const *filename, bool *is_valid, struct json_arena *arena)
+{
+    struct json_parse_ctx ctx;		/* context of this parse */
+    struct json *tree = NULL;		/* JSON parse tree */
+    char *buf = NULL;			/* arena copy of the input */
+
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	err(106, __func__, "arena is NULL");
+	not_reached();
+    }
+    if (ptr == NULL) {
+	/* let parse_json() report the NULL pointer */
+	return parse_json_arena(ptr, len, filename, is_valid, arena);
+    }
+
+    /*
+     * copy the input into the arena, followed by the NUL bytes the scanner requires
+     *
+     * NOTE: json_arena_alloc() returns zeroized memory.
+     */
+    buf = json_arena_alloc(arena, len + JSON_SCAN_PAD);
+    memcpy(buf, ptr, len);
+
+    /*
+     * parse the copy in place with the arena as the allocator
+     */
+    json_parse_ctx_init(&ctx, filename, arena);
+    ctx.ref = buf;
+    ctx.ref_len = len;
+    tree = parse_json_ctx(buf, len, buf, &ctx, is_valid);
+
+    /*
+     * NUL terminate the text referenced by the tree
+     */
+    if (tree != NULL) {
+	json_walk(tree, JSON_INFINITE_DEPTH, 0, false, json_arena_ref_nul, &ctx);
+    }
+
+    /*
+     * return the JSON parse tree
+     */
+    return tree;
+}
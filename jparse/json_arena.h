@@ -0,0 +1,90 @@
+/*
+ * json_arena - JSON parse tree arena allocator
+ *
+ * "Because freeing a tree one leaf at a time is for the birds." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_ARENA_H)
+#    define  INCLUDE_JSON_ARENA_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * util - entry common utility functions for the IOCCC toolkit
+ */
+#include "util.h"
+
+
+/*
+ * definitions
+ */
+#define JSON_ARENA_CHUNK (64*1024)	/* default usable bytes in an arena chunk */
+#define JSON_ARENA_ALIGN (16)		/* arena allocations are aligned to this many bytes */
+#define JSON_ARENA_SET_START (4)	/* initial number of pointers in an arena JSON object/array set */
+
+
+/*
+ * json_arena_chunk - a single block of arena memory
+ *
+ * The usable memory of a chunk immediately follows this header
+ * (rounded up to JSON_ARENA_ALIGN bytes).
+ */
+struct json_arena_chunk
+{
+    struct json_arena_chunk *next;	/* previously allocated chunk or NULL */
+    size_t size;			/* usable bytes in this chunk */
+    size_t used;			/* usable bytes handed out from this chunk */
+    size_t last;			/* offset of the most recent allocation in this chunk */
+};
+
+
+/*
+ * json_arena - a collection of chunks from which a JSON parse tree is allocated
+ *
+ * All nodes, strings and dynamic array storage of a JSON parse tree that was
+ * formed by parse_json_arena() come from the same arena.  The tree is freed
+ * in one step by json_arena_free() (or json_arena_reset()) and must NOT be
+ * passed to free(3): json_tree_free() and json_free() ignore arena nodes.
+ */
+struct json_arena
+{
+    size_t chunk_size;			/* usable bytes in a normal chunk */
+    struct json_arena_chunk *head;	/* most recently allocated chunk or NULL */
+    uintmax_t chunk_count;		/* number of chunks in the arena */
+    uintmax_t alloc_count;		/* number of allocations made from the arena */
+    uintmax_t alloc_bytes;		/* number of bytes handed out by the arena */
+};
+
+
+/*
+ * function prototypes
+ */
+extern struct json_arena *json_arena_create(size_t chunk_size);
+extern void *json_arena_alloc(struct json_arena *arena, size_t size);
+extern void *json_arena_grow(struct json_arena *arena, void *ptr, size_t old_size, size_t new_size);
+extern void json_arena_reset(struct json_arena *arena);
+extern void json_arena_free(struct json_arena *arena);
+extern struct json *parse_json_arena(char const *ptr, size_t len, char const *filename, bool *is_valid,
+				     struct json_arena *arena);
+extern char *json_arena_ref(char const *ptr, size_t len);
+extern struct json *parse_json_arena_ref(char const *ptr, size_t len, char const *filename, bool *is_valid,
+					 struct json_arena *arena);
+
+
+#endif /* INCLUDE_JSON_ARENA_H */
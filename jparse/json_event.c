@@ -0,0 +1,823 @@
+/*
+ * json_event - event driven (SAX-style) JSON parser
+ *
+ * "Because sometimes you only want to hear about the leaves as they fall." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+/*
+ * jparse.lex.h - generated by flex
+ */
+#include "jparse.lex.h"
+
+
+/*
+ * what the event parser expects to see next
+ */
+enum event_state {
+    EXPECT_VALUE = 0,		/* JSON value: top level, after : or after , in an array */
+    EXPECT_VALUE_OR_END,	/* JSON value or ] after [ */
+    EXPECT_NAME_OR_END,		/* member name or } after { */
+    EXPECT_NAME,		/* member name after , in an object */
+    EXPECT_COLON,		/* : after a member name */
+    EXPECT_COMMA_OR_END,	/* , or closing ] or } after a value */
+    EXPECT_EOF,			/* end of input after the top level value */
+};
+
+
+/*
+ * an open JSON object or array
+ */
+struct event_frame
+{
+    bool is_object;		/* true ==> JSON object, false ==> JSON array */
+    intmax_t count;		/* number of values or members completed so far */
+};
+
+
+/*
+ * state of a single event parse
+ */
+struct event_parse
+{
+    yyscan_t scanner;		/* flex scanner */
+    JPARSE_LTYPE lloc;		/* location of the current token */
+    struct json_parse_ctx ctx;	/* context of the parse, the extra data of the scanner */
+    struct dyn_array *stack;	/* stack of struct event_frame for the open objects and arrays */
+    enum event_state state;	/* what we expect next */
+    unsigned int max_depth;	/* maximum nesting depth, 0 ==> no limit */
+    bool (*callback)(struct json_event const *, void *);	/* event callback */
+    void *cb_ctx;		/* context passed unchanged to the callback */
+};
+
+
+/*
+ * static functions
+ */
+static bool event_emit(struct event_parse *ep, enum json_event_type type, struct json *node);
+static void event_error(struct event_parse *ep, char const *reason);
+static struct event_frame *event_top(struct event_parse *ep);
+static bool event_open(struct event_parse *ep, int tok);
+static bool event_close(struct event_parse *ep, int tok);
+static void event_value_done(struct event_parse *ep);
+static struct json *event_conv(struct event_parse *ep, int tok, char const *text, size_t len);
+static bool event_parse_stream(FILE *stream, char const *filename, uintmax_t line, bool quiet, unsigned int max_depth,
+			       bool (*callback)(struct json_event const *, void *), void *ctx);
+static bool event_parse_blob(char const *ptr, size_t len, char const *filename, uintmax_t line, bool quiet,
+			     unsigned int max_depth, bool (*callback)(struct json_event const *, void *), void *ctx);
+
+
+/*
+ * json_event_type_name - return a printable name of a JSON event type
+ *
+ * given:
+ *	type	JSON event type
+ *
+ * returns:
+ *	constant string with the name of the event type
+ */
+char const *
+json_event_type_name(enum json_event_type type)
+{
+    switch (type) {
+    case JSON_EVENT_UNSET:
+	return "JSON_EVENT_UNSET";
+    case JSON_EVENT_BEGIN_OBJECT:
+	return "JSON_EVENT_BEGIN_OBJECT";
+    case JSON_EVENT_END_OBJECT:
+	return "JSON_EVENT_END_OBJECT";
+    case JSON_EVENT_BEGIN_ARRAY:
+	return "JSON_EVENT_BEGIN_ARRAY";
+    case JSON_EVENT_END_ARRAY:
+	return "JSON_EVENT_END_ARRAY";
+    case JSON_EVENT_MEMBER:
+	return "JSON_EVENT_MEMBER";
+    case JSON_EVENT_VALUE:
+	return "JSON_EVENT_VALUE";
+    default:
+	break;
+    }
+    return "JSON_EVENT_UNKNOWN";
+}
+
+
+/*
+ * event_top - return the innermost open JSON object or array
+ *
+ * given:
+ *	ep	event parse state
+ *
+ * returns:
+ *	innermost open frame, or NULL ==> at top level
+ */
+static struct event_frame *
+event_top(struct event_parse *ep)
+{
+    intmax_t count = dyn_array_tell(ep->stack);
+
+    if (count <= 0) {
+	return NULL;
+    }
+    return dyn_array_addr(ep->stack, struct event_frame, count-1);
+}
+
+
+/*
+ * event_emit - pass an event to the event callback
+ *
+ * given:
+ *	ep	event parse state
+ *	type	type of event
+ *	node	converted JSON node for JSON_EVENT_MEMBER or JSON_EVENT_VALUE, else NULL
+ *
+ * returns:
+ *	true ==> continue parsing, false ==> callback requested that we stop
+ */
+static bool
+event_emit(struct event_parse *ep, enum json_event_type type, struct json *node)
+{
+    struct json_event event;		/* event to pass to the callback */
+    struct event_frame *top = NULL;	/* innermost open object or array */
+    bool ret = true;			/* callback return */
+
+    /*
+     * form the event
+     */
+    memset(&event, 0, sizeof(event));
+    top = event_top(ep);
+    event.type = type;
+    event.depth = (unsigned int)dyn_array_tell(ep->stack);
+    event.index = (top == NULL) ? -1 : top->count;
+    event.node = node;
+    event.filename = ep->ctx.filename;
+    event.line = ep->lloc.first_line;
+    event.column = ep->lloc.first_column;
+    json_dbg(JSON_DBG_VHIGH, __func__, "event: %s depth: %u index: %jd",
+				      json_event_type_name(type), event.depth, event.index);
+
+    /*
+     * call the callback, if any
+     */
+    if (ep->callback != NULL) {
+	ret = (*ep->callback)(&event, ep->cb_ctx);
+    }
+    return ret;
+}
+
+
+/*
+ * event_error - report a JSON syntax error found by the event parser
+ *
+ * given:
+ *	ep	event parse state
+ *	reason	why the current token is a syntax error
+ *
+ * NOTE: Nothing is reported when the scanner stopped the parse at a limit,
+ *	 as the scanner has already reported the limit.
+ */
+static void
+event_error(struct event_parse *ep, char const *reason)
+{
+    char const *text = jparse_get_text(ep->scanner);	/* text of the current token */
+
+    if (ep->ctx.quiet == true || ep->ctx.limit_crossed == true) {
+	return;
+    }
+    werr(100, __func__, "%s in file %s at line %d column %d: <%s>",
+		        reason, ep->ctx.filename, ep->lloc.first_line, ep->lloc.first_column,
+		        (text != NULL && *text != '\0') ? text : "end of file");
+    return;
+}
+
+
+/*
+ * event_value_done - account for a completed JSON value
+ *
+ * given:
+ *	ep	event parse state
+ */
+static void
+event_value_done(struct event_parse *ep)
+{
+    struct event_frame *top = event_top(ep);	/* innermost open object or array */
+
+    if (top == NULL) {
+	ep->state = EXPECT_EOF;
+    } else {
+	++top->count;
+	ep->state = EXPECT_COMMA_OR_END;
+    }
+    return;
+}
+
+
+/*
+ * event_open - begin a JSON object or array
+ *
+ * given:
+ *	ep	event parse state
+ *	tok	JSON_OPEN_BRACE or JSON_OPEN_BRACKET
+ *
+ * returns:
+ *	true ==> continue parsing, false ==> stop parsing
+ */
+static bool
+event_open(struct event_parse *ep, int tok)
+{
+    struct event_frame frame;		/* new open object or array */
+
+    /*
+     * enforce the maximum depth
+     */
+    if (ep->max_depth != JSON_INFINITE_DEPTH && (uintmax_t)dyn_array_tell(ep->stack) >= ep->max_depth) {
+	event_error(ep, "maximum depth exceeded");
+	return false;
+    }
+
+    /*
+     * announce and then open the object or array
+     */
+    memset(&frame, 0, sizeof(frame));
+    frame.is_object = (tok == JSON_OPEN_BRACE);
+    frame.count = 0;
+    if (!event_emit(ep, frame.is_object ? JSON_EVENT_BEGIN_OBJECT : JSON_EVENT_BEGIN_ARRAY, NULL)) {
+	return false;
+    }
+    (void) dyn_array_append_value(ep->stack, &frame);
+    ep->state = frame.is_object ? EXPECT_NAME_OR_END : EXPECT_VALUE_OR_END;
+    return true;
+}
+
+
+/*
+ * event_close - end a JSON object or array
+ *
+ * given:
+ *	ep	event parse state
+ *	tok	JSON_CLOSE_BRACE or JSON_CLOSE_BRACKET
+ *
+ * returns:
+ *	true ==> continue parsing, false ==> stop parsing
+ */
+static bool
+event_close(struct event_parse *ep, int tok)
+{
+    struct event_frame *top = event_top(ep);	/* innermost open object or array */
+    bool is_object = false;			/* true ==> closing an object */
+
+    /*
+     * the close must match the open
+     */
+    if (top == NULL || top->is_object != (tok == JSON_CLOSE_BRACE)) {
+	event_error(ep, "syntax error, unmatched close");
+	return false;
+    }
+    is_object = top->is_object;
+
+    /*
+     * close and then announce the object or array
+     */
+    (void) dyn_array_seek(ep->stack, -1, SEEK_CUR);
+    if (!event_emit(ep, is_object ? JSON_EVENT_END_OBJECT : JSON_EVENT_END_ARRAY, NULL)) {
+	return false;
+    }
+    event_value_done(ep);
+    return true;
+}
+
+
+/*
+ * event_conv - convert a JSON string, number, boolean or null token
+ *
+ * given:
+ *	ep	event parse state
+ *	tok	token returned by the scanner
+ *	text	text of the token
+ *	len	length of the token
+ *
+ * returns:
+ *	converted JSON parse tree node, or NULL ==> invalid token
+ */
+static struct json *
+event_conv(struct event_parse *ep, int tok, char const *text, size_t len)
+{
+    struct json *node = NULL;		/* converted JSON node */
+    bool valid = false;			/* true ==> node was parsed or converted */
+
+    /*
+     * convert using the same converters as the parse tree code
+     */
+    switch (tok) {
+    case JSON_STRING:
+	/* the scanner will match a NUL byte inside a JSON string */
+	if (strlen(text) != len) {
+	    event_error(ep, "NUL byte in JSON string");
+	    return NULL;
+	}
+	node = json_conv_string(text, len, true);
+	valid = VALID_JSON_NODE(&(node->item.string));
+	break;
+    case JSON_NUMBER:
+	node = json_conv_number(text, len);
+	valid = VALID_JSON_NODE(&(node->item.number));
+	break;
+    case JSON_TRUE:
+    case JSON_FALSE:
+	node = json_conv_bool(text, len);
+	valid = VALID_JSON_NODE(&(node->item.boolean));
+	break;
+    case JSON_NULL:
+	node = json_conv_null(text, len);
+	valid = VALID_JSON_NODE(&(node->item.null));
+	break;
+    default:
+	event_error(ep, "syntax error, unexpected token");
+	return NULL;
+    }
+
+    /*
+     * reject what cannot be converted
+     */
+    if (!valid) {
+	event_error(ep, "invalid JSON value");
+	json_free(node, 0);
+	free(node);
+	return NULL;
+    }
+    return node;
+}
+
+
+/*
+ * event_parse_stream - parse an open stream, issuing JSON events
+ *
+ * given:
+ *	stream		open stream to parse
+ *	filename	name of the stream, or NULL ==> stdin
+ *	line		line of the file on which the stream starts, 0 ==> 1
+ *	quiet		true ==> do not report syntax errors
+ *	max_depth	maximum nesting depth, or 0 ==> no limit
+ *			    NOTE: Use JSON_INFINITE_DEPTH for no limit.
+ *			    NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
+ *	callback	function to call for each event, or NULL ==> only validate
+ *	ctx		context passed unchanged to each callback, may be NULL
+ *
+ * returns:
+ *	true ==> stream was valid JSON,
+ *	false ==> invalid JSON, I/O error, or callback returned false
+ *
+ * NOTE: The stream is closed (unless it is stdin) before returning.
+ */
+static bool
+event_parse_stream(FILE *stream, char const *filename, uintmax_t line, bool quiet, unsigned int max_depth,
+		   bool (*callback)(struct json_event const *, void *), void *ctx)
+{
+    struct event_parse ep;		/* event parse state */
+    struct json *node = NULL;		/* converted JSON member name or value */
+    struct event_frame *top = NULL;	/* innermost open object or array */
+    char const *text = NULL;		/* text of the current token */
+    size_t len = 0;			/* length of the current token */
+    bool valid = false;			/* true ==> stream was valid JSON */
+    bool more = true;			/* true ==> keep parsing */
+    int tok = 0;			/* token returned by the scanner */
+    int ret = 0;			/* libc function return */
+
+    /*
+     * firewall
+     */
+    if (filename == NULL) {
+	json_dbg(JSON_DBG_HIGH, __func__, "filename is NULL, forcing it to be \"-\" for stdin");
+	filename = "-";
+	stream = stdin;
+    } else if (!strcmp(filename, "-") && stream == NULL) {
+	stream = stdin;
+    }
+    if (stream == NULL) {
+	werr(101, __func__, "stream is NULL");
+	return false;
+    }
+    if (stream != stdin && fileno(stream) >= 0 && fd_is_ready(__func__, false, fileno(stream)) == false) {
+	werr(102, __func__, "stream is not open");
+	return false;
+    }
+
+    /*
+     * initialize the event parse state
+     */
+    memset(&ep, 0, sizeof(ep));
+    json_parse_ctx_init(&ep.ctx, filename, NULL);
+    ep.ctx.line = line;
+    ep.ctx.quiet = quiet;
+    ep.max_depth = max_depth;
+    ep.callback = callback;
+    ep.cb_ctx = ctx;
+    ep.state = EXPECT_VALUE;
+    ep.stack = dyn_array_create(sizeof(struct event_frame), JSON_CHUNK, JSON_CHUNK, true);
+    if (ep.stack == NULL) {
+	errp(103, __func__, "dyn_array_create() returned NULL");
+	not_reached();
+    }
+
+    /*
+     * have the scanner read directly from the stream
+     *
+     * Unlike parse_json_stream() we do NOT read the entire stream into
+     * memory: the scanner buffers only as much input as the current token
+     * requires, so memory use is bounded by the nesting depth and the
+     * longest token rather than by the size of the JSON document.
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = jparse_lex_init_extra(&ep.ctx, &ep.scanner);
+    if (ret != 0) {
+	errp(104, __func__, "failed to initialize scanner");
+	not_reached();
+    }
+    jparse_set_in(stream, ep.scanner);
+
+    /*
+     * convert tokens in the context of this parse
+     *
+     * The converted nodes are not in an arena, even when the events are
+     * parsed while a tree is being parsed into an arena on the same thread.
+     */
+    json_parse_ctx_enter(&ep.ctx);
+
+    /*
+     * scan tokens until end of input, a syntax error or the callback says to stop
+     */
+    while (more) {
+
+	tok = jparse_lex(NULL, &ep.lloc, ep.scanner);
+	text = jparse_get_text(ep.scanner);
+	len = (size_t)jparse_get_leng(ep.scanner);
+
+	/*
+	 * case: end of input
+	 */
+	if (tok == JPARSE_EOF) {
+	    if (ep.state == EXPECT_EOF) {
+		valid = true;
+	    } else {
+		event_error(&ep, "syntax error, unexpected end of file");
+	    }
+	    break;
+	}
+
+	switch (ep.state) {
+
+	/*
+	 * case: expecting a JSON value (or a close for an empty array)
+	 */
+	case EXPECT_VALUE:
+	case EXPECT_VALUE_OR_END:
+	    if (tok == JSON_OPEN_BRACE || tok == JSON_OPEN_BRACKET) {
+		more = event_open(&ep, tok);
+	    } else if (tok == JSON_CLOSE_BRACKET && ep.state == EXPECT_VALUE_OR_END) {
+		more = event_close(&ep, tok);
+	    } else {
+		node = event_conv(&ep, tok, text, len);
+		if (node == NULL) {
+		    more = false;
+		    break;
+		}
+		more = event_emit(&ep, JSON_EVENT_VALUE, node);
+		json_free(node, 0);
+		free(node);
+		node = NULL;
+		event_value_done(&ep);
+	    }
+	    break;
+
+	/*
+	 * case: expecting a member name (or a close for an empty object)
+	 */
+	case EXPECT_NAME:
+	case EXPECT_NAME_OR_END:
+	    if (tok == JSON_CLOSE_BRACE && ep.state == EXPECT_NAME_OR_END) {
+		more = event_close(&ep, tok);
+	    } else if (tok == JSON_STRING) {
+		node = event_conv(&ep, tok, text, len);
+		if (node == NULL) {
+		    more = false;
+		    break;
+		}
+		more = event_emit(&ep, JSON_EVENT_MEMBER, node);
+		json_free(node, 0);
+		free(node);
+		node = NULL;
+		ep.state = EXPECT_COLON;
+	    } else {
+		event_error(&ep, "syntax error, expecting JSON_STRING");
+		more = false;
+	    }
+	    break;
+
+	/*
+	 * case: expecting : between member name and value
+	 */
+	case EXPECT_COLON:
+	    if (tok == JSON_COLON) {
+		ep.state = EXPECT_VALUE;
+	    } else {
+		event_error(&ep, "syntax error, expecting :");
+		more = false;
+	    }
+	    break;
+
+	/*
+	 * case: expecting , or the close of the innermost object or array
+	 */
+	case EXPECT_COMMA_OR_END:
+	    top = event_top(&ep);
+	    if (tok == JSON_COMMA && top != NULL) {
+		ep.state = top->is_object ? EXPECT_NAME : EXPECT_VALUE;
+	    } else if (tok == JSON_CLOSE_BRACE || tok == JSON_CLOSE_BRACKET) {
+		more = event_close(&ep, tok);
+	    } else {
+		event_error(&ep, "syntax error, expecting , or close");
+		more = false;
+	    }
+	    break;
+
+	/*
+	 * case: only the end of input may follow the top level value
+	 */
+	case EXPECT_EOF:
+	default:
+	    event_error(&ep, "syntax error, unexpected token after JSON value");
+	    more = false;
+	    break;
+	}
+    }
+
+    /*
+     * clean up
+     */
+    json_parse_ctx_leave(&ep.ctx);
+    jparse_lex_destroy(ep.scanner);
+    dyn_array_free(ep.stack);
+    clearerr_or_fclose(stream);
+    json_dbg(JSON_DBG_MED, __func__, "JSON events from %s are %s", filename, valid ? "valid" : "not valid");
+    return valid;
+}
+
+
+/*
+ * parse_json_events_stream - parse an open stream, issuing JSON events
+ *
+ * Instead of forming a JSON parse tree, as parse_json_stream() does, this
+ * function calls callback for each JSON event (see struct json_event).
+ * The stream is scanned as it is read: memory use is bounded by the nesting
+ * depth of the JSON rather than by the size of the stream.
+ *
+ * The callback is called with the event and ctx.  If callback returns
+ * false, parsing stops.
+ *
+ * given:
+ *	stream		open stream to parse
+ *	filename	name of the stream, or NULL ==> stdin
+ *	max_depth	maximum nesting depth, or 0 ==> no limit
+ *			    NOTE: Use JSON_INFINITE_DEPTH for no limit.
+ *			    NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
+ *	callback	function to call for each event, or NULL ==> only validate
+ *	ctx		context passed unchanged to each callback, may be NULL
+ *
+ * returns:
+ *	true ==> stream was valid JSON,
+ *	false ==> invalid JSON, I/O error, or callback returned false
+ *
+ * NOTE: Because events are issued as the stream is read, a callback may
+ *	 receive events for a JSON document that later turns out to be invalid.
+ *
+ * NOTE: The stream is closed (unless it is stdin) before returning.
+ */
+bool
+parse_json_events_stream(FILE *stream, char const *filename, unsigned int max_depth,
+			 bool (*callback)(struct json_event const *, void *), void *ctx)
+{
+    return event_parse_stream(stream, filename, 1, false, max_depth, callback, ctx);
+}
+
+
+/*
+ * event_parse_blob - parse a JSON block of memory, issuing JSON events
+ *
+ * given:
+ *	ptr		pointer to start of JSON blob
+ *	len		length of the JSON blob
+ *	filename	filename for messages, or NULL
+ *	line		line of the file on which the JSON blob starts, 0 ==> 1
+ *	quiet		true ==> do not report syntax errors
+ *	max_depth	maximum nesting depth, or 0 ==> no limit
+ *	callback	function to call for each event, or NULL ==> only validate
+ *	ctx		context passed unchanged to each callback, may be NULL
+ *
+ * returns:
+ *	true ==> JSON blob was valid JSON,
+ *	false ==> invalid JSON, or callback returned false
+ */
+static bool
+event_parse_blob(char const *ptr, size_t len, char const *filename, uintmax_t line, bool quiet,
+		 unsigned int max_depth, bool (*callback)(struct json_event const *, void *), void *ctx)
+{
+    FILE *stream = NULL;	/* stream reading from the JSON blob */
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL) {
+	werr(105, __func__, "ptr is NULL");
+	return false;
+    }
+    if (len == 0) {
+	werr(106, __func__, "len is 0: empty JSON is not valid JSON");
+	return false;
+    }
+    if (filename == NULL) {
+	filename = "-";
+    }
+
+    /*
+     * read the JSON blob as a stream
+     */
+    errno = 0;			/* pre-clear errno for werrp() */
+    stream = fmemopen((void *)ptr, len, "r");
+    if (stream == NULL) {
+	werrp(107, __func__, "fmemopen of %ju bytes failed", (uintmax_t)len);
+	return false;
+    }
+
+    /*
+     * parse the stream
+     */
+    return event_parse_stream(stream, filename, line, quiet, max_depth, callback, ctx);
+}
+
+
+/*
+ * parse_json_events - parse a JSON block of memory, issuing JSON events
+ *
+ * This is like parse_json_events_stream() for a block of memory.
+ *
+ * given:
+ *	ptr		pointer to start of JSON blob
+ *	len		length of the JSON blob
+ *	filename	filename for messages, or NULL
+ *	max_depth	maximum nesting depth, or 0 ==> no limit
+ *	callback	function to call for each event, or NULL ==> only validate
+ *	ctx		context passed unchanged to each callback, may be NULL
+ *
+ * returns:
+ *	true ==> JSON blob was valid JSON,
+ *	false ==> invalid JSON, or callback returned false
+ *
+ * NOTE: The JSON blob is read in place: it is not copied.
+ */
+bool
+parse_json_events(char const *ptr, size_t len, char const *filename, unsigned int max_depth,
+		  bool (*callback)(struct json_event const *, void *), void *ctx)
+{
+    return event_parse_blob(ptr, len, filename, 1, false, max_depth, callback, ctx);
+}
+
+
+/*
+ * parse_json_events_at - parse a JSON block of memory from a line of a file, issuing JSON events
+ *
+ * This is like parse_json_events() for a JSON blob that starts on a given
+ * line of a file, such as a record of a JSON Lines file: the lines of the
+ * events and of the syntax errors are lines of the file.
+ *
+ * given:
+ *	ptr		pointer to start of JSON blob
+ *	len		length of the JSON blob
+ *	filename	filename for messages, or NULL
+ *	line		line of the file on which the JSON blob starts, 0 ==> 1
+ *	quiet		true ==> do not report syntax errors
+ *	max_depth	maximum nesting depth, or 0 ==> no limit
+ *	callback	function to call for each event, or NULL ==> only validate
+ *	ctx		context passed unchanged to each callback, may be NULL
+ *
+ * returns:
+ *	true ==> JSON blob was valid JSON,
+ *	false ==> invalid JSON, or callback returned false
+ *
+ * NOTE: The JSON blob is read in place: it is not copied.
+ */
+bool
+parse_json_events_at(char const *ptr, size_t len, char const *filename, uintmax_t line, bool quiet,
+		     unsigned int max_depth, bool (*callback)(struct json_event const *, void *), void *ctx)
+{
+    return event_parse_blob(ptr, len, filename, line, quiet, max_depth, callback, ctx);
+}
+
+
+/*
+ * parse_json_events_file - parse a JSON file, issuing JSON events
+ *
+ * This is like parse_json_events_stream() for a named file.
+ *
+ * given:
+ *	name		name of file to parse, or "-" ==> stdin
+ *	max_depth	maximum nesting depth, or 0 ==> no limit
+ *	callback	function to call for each event, or NULL ==> only validate
+ *	ctx		context passed unchanged to each callback, may be NULL
+ *
+ * returns:
+ *	true ==> file was valid JSON,
+ *	false ==> invalid JSON, file error, or callback returned false
+ */
+bool
+parse_json_events_file(char const *name, unsigned int max_depth,
+		       bool (*callback)(struct json_event const *, void *), void *ctx)
+{
+    FILE *stream = NULL;	/* stream to read from */
+
+    /*
+     * firewall
+     */
+    if (name == NULL) {
+	werr(108, __func__, "passed NULL name");
+	return false;
+    }
+    if (*name == '\0') { /* strlen(name) == 0 */
+	werr(109, __func__, "passed empty filename");
+	return false;
+    }
+
+    /*
+     * if file is -, then we will parse stdin
+     */
+    if (strcmp(name, "-") == 0) {
+	stream = stdin;
+
+    /*
+     * case will read from a file
+     */
+    } else {
+
+	/*
+	 * validate filename
+	 */
+	if (!exists(name)) {
+	    werr(110, __func__, "passed filename that's not actually a file: %s", name);
+	    return false;
+	}
+	if (!is_file(name)) {
+	    werr(111, __func__, "passed filename not a normal file: %s", name);
+	    return false;
+	}
+	if (!is_read(name)) {
+	    werr(112, __func__, "passed filename not a readable file: %s", name);
+	    return false;
+	}
+
+	/*
+	 * open file for scanner to use
+	 */
+	errno = 0;		/* pre-clear errno for werrp() */
+	stream = fopen(name, "r");
+	if (stream == NULL) {
+	    werrp(113, __func__, "couldn't open file %s, ignoring", name);
+	    return false;
+	}
+    }
+
+    /*
+     * parse the open stream
+     */
+    return event_parse_stream(stream, name, 1, false, max_depth, callback, ctx);
+}
@@ -0,0 +1,99 @@
+/*
+ * json_event - event driven (SAX-style) JSON parser
+ *
+ * "Because sometimes you only want to hear about the leaves as they fall." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_EVENT_H)
+#    define  INCLUDE_JSON_EVENT_H
+
+
+#include <stdio.h>
+
+/*
+ * util - entry common utility functions for the IOCCC toolkit
+ */
+#include "util.h"
+
+/*
+ * json_parse - JSON parser support code
+ */
+#include "json_parse.h"
+
+
+/*
+ * JSON parse events
+ *
+ * Events are issued in document order.  For the JSON:
+ *
+ *	{ "a" : [ 1, true ] }
+ *
+ * the events are:
+ *
+ *	JSON_EVENT_BEGIN_OBJECT		depth 0
+ *	JSON_EVENT_MEMBER		depth 1		node: JTYPE_STRING "a"
+ *	JSON_EVENT_BEGIN_ARRAY		depth 1
+ *	JSON_EVENT_VALUE		depth 2		node: JTYPE_NUMBER 1
+ *	JSON_EVENT_VALUE		depth 2		node: JTYPE_BOOL true
+ *	JSON_EVENT_END_ARRAY		depth 1
+ *	JSON_EVENT_END_OBJECT		depth 0
+ */
+enum json_event_type {
+    JSON_EVENT_UNSET = 0,	/* event has not been set - must be the value 0 */
+    JSON_EVENT_BEGIN_OBJECT,	/* start of a JSON object: { */
+    JSON_EVENT_END_OBJECT,	/* end of a JSON object: } */
+    JSON_EVENT_BEGIN_ARRAY,	/* start of a JSON array: [ */
+    JSON_EVENT_END_ARRAY,	/* end of a JSON array: ] */
+    JSON_EVENT_MEMBER,		/* name of a JSON member, the value events follow */
+    JSON_EVENT_VALUE,		/* JSON string, number, boolean or null value */
+};
+
+
+/*
+ * json_event - a JSON parse event passed to an event callback
+ *
+ * The node, when not NULL, is a converted JSON parse tree node that is freed
+ * after the callback returns.  A callback that wishes to keep the information
+ * must copy it.
+ */
+struct json_event
+{
+    enum json_event_type type;	/* type of event */
+    unsigned int depth;		/* nesting depth of the event (0 ==> top level) */
+    intmax_t index;		/* index of the value or member within its parent, or -1 if top level */
+    struct json *node;		/* JSON_EVENT_MEMBER: name, JSON_EVENT_VALUE: value, else NULL */
+    char const *filename;	/* filename of the JSON document or "-" for stdin */
+    int line;			/* line number of the JSON token that caused the event */
+    int column;			/* column number of the JSON token that caused the event */
+};
+
+
+/*
+ * function prototypes
+ */
+extern char const *json_event_type_name(enum json_event_type type);
+extern bool parse_json_events(char const *ptr, size_t len, char const *filename, unsigned int max_depth,
+			      bool (*callback)(struct json_event const *, void *), void *ctx);
+extern bool parse_json_events_at(char const *ptr, size_t len, char const *filename, uintmax_t line, bool quiet,
+				 unsigned int max_depth, bool (*callback)(struct json_event const *, void *), void *ctx);
+extern bool parse_json_events_stream(FILE *stream, char const *filename, unsigned int max_depth,
+				     bool (*callback)(struct json_event const *, void *), void *ctx);
+extern bool parse_json_events_file(char const *name, unsigned int max_depth,
+				   bool (*callback)(struct json_event const *, void *), void *ctx);
+
+
+#endif /* INCLUDE_JSON_EVENT_H */
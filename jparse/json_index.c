@@ -0,0 +1,1336 @@
+/*
+ * json_index - SIMD structural index of a JSON document
+ *
+ * "Because sometimes you want to see the forest before you count the leaves." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+/*
+ * SIMD kernels are only compiled for x86-64 with a compiler that can
+ * target AVX2 on a per-function basis.
+ */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_INDEX_X86 (1)
+#include <immintrin.h>
+#endif
+
+
+/*
+ * byte classes of a block
+ *
+ * Bit i of each mask describes byte i of the block.
+ */
+struct index_masks
+{
+    uint64_t quote;		/* " */
+    uint64_t backslash;		/* \ */
+    uint64_t op;		/* { } [ ] : , */
+    uint64_t ws;		/* space, \t, \n, \r */
+    uint64_t ctrl;		/* bytes < 0x20 */
+};
+
+/*
+ * state carried from one block to the next
+ */
+struct index_carry
+{
+    uint64_t in_string;		/* all 1 bits ==> previous block ended inside a JSON string */
+    uint64_t escape;		/* 1 ==> first byte of the block is escaped by a \ */
+    uint64_t other;		/* 1 ==> last byte of the previous block was part of a scalar token */
+};
+
+/*
+ * byte class bits for the scalar kernel
+ */
+#define CLASS_QUOTE (0x01)
+#define CLASS_BACKSLASH (0x02)
+#define CLASS_OP (0x04)
+#define CLASS_WS (0x08)
+#define CLASS_CTRL (0x10)
+
+/*
+ * validation states
+ */
+enum index_state {
+    EXPECT_VALUE = 0,		/* a JSON value */
+    EXPECT_VALUE_OR_END,	/* a JSON value or ] (just after [) */
+    EXPECT_NAME,		/* a JSON member name (just after , in an object) */
+    EXPECT_NAME_OR_END,		/* a JSON member name or } (just after {) */
+    EXPECT_COLON,		/* : after a JSON member name */
+    EXPECT_COMMA_OR_END,	/* , or the end of the enclosing object or array */
+    EXPECT_EOF,			/* nothing more after the top level JSON value */
+};
+
+/*
+ * JSON grammar state of a validation
+ */
+struct index_grammar
+{
+    enum index_state state;	/* what the grammar expects next */
+    char *stack;		/* { or [ of each open object or array */
+    size_t depth;		/* number of open objects and arrays */
+    size_t stack_alloc;		/* bytes allocated for stack */
+};
+
+
+/*
+ * static declarations
+ */
+#define CTRL_WS (CLASS_CTRL|CLASS_WS)
+static uint8_t const index_class[BYTE_VALUES] = {	/* byte classes for the scalar kernel */
+    /* 0x00 - 0x1f: control bytes, of which \t \n \r are also whitespace */
+    CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL,
+    CLASS_CTRL, CTRL_WS,    CTRL_WS,    CLASS_CTRL, CLASS_CTRL, CTRL_WS,    CLASS_CTRL, CLASS_CTRL,
+    CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL,
+    CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL, CLASS_CTRL,
+    [' '] = CLASS_WS,
+    ['"'] = CLASS_QUOTE,
+    [','] = CLASS_OP,
+    [':'] = CLASS_OP,
+    ['['] = CLASS_OP,
+    ['\\'] = CLASS_BACKSLASH,
+    [']'] = CLASS_OP,
+    ['{'] = CLASS_OP,
+    ['}'] = CLASS_OP,
+};
+
+
+/*
+ * static functions
+ */
+static void classify_scalar(uint8_t const *p, struct index_masks *m);
+#if defined(JSON_INDEX_X86)
+static void classify_sse2(uint8_t const *p, struct index_masks *m);
+static void classify_avx2(uint8_t const *p, struct index_masks *m) __attribute__((target("avx2")));
+#endif
+static void index_block(struct json_index *idx, char const *ptr, size_t base, struct index_masks const *m,
+			struct index_carry *carry);
+static bool index_escape_valid(char const *ptr, size_t len, size_t off);
+static size_t index_scalar_len(char const *ptr, size_t len, size_t off);
+static bool index_number_valid(char const *str, size_t len);
+static char const *index_token(struct index_grammar *g, char const *ptr, size_t len, size_t off, size_t *scalar_len);
+static char const *index_string_end(char const *ptr, size_t len, size_t off, size_t *end);
+static void index_location(char const *ptr, size_t off, int *line, int *column);
+
+
+/*
+ * json_index_best_kernel - return the fastest kernel the CPU supports
+ *
+ * returns:
+ *	fastest supported kernel, never JSON_INDEX_KERNEL_AUTO
+ */
+enum json_index_kernel
+json_index_best_kernel(void)
+{
+#if defined(JSON_INDEX_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+	return JSON_INDEX_KERNEL_AVX2;
+    }
+    return JSON_INDEX_KERNEL_SSE2;
+#else
+    return JSON_INDEX_KERNEL_SCALAR;
+#endif
+}
+
+
+/*
+ * json_index_env_kernel - return the kernel named by JSON_INDEX_KERNEL
+ *
+ * The JSON_INDEX_KERNEL environment variable may be one of "auto", "scalar",
+ * "sse2" or "avx2".  An unknown name is warned about and ignored.
+ *
+ * returns:
+ *	kernel named by JSON_INDEX_KERNEL,
+ *	JSON_INDEX_KERNEL_AUTO if JSON_INDEX_KERNEL is unset, empty or unknown
+ */
+enum json_index_kernel
+json_index_env_kernel(void)
+{
+    char const *name = NULL;	/* value of JSON_INDEX_KERNEL */
+
+    name = getenv("JSON_INDEX_KERNEL");
+    if (name == NULL || *name == '\0' || strcmp(name, "auto") == 0) {
+	return JSON_INDEX_KERNEL_AUTO;
+    } else if (strcmp(name, "scalar") == 0) {
+	return JSON_INDEX_KERNEL_SCALAR;
+    } else if (strcmp(name, "sse2") == 0) {
+	return JSON_INDEX_KERNEL_SSE2;
+    } else if (strcmp(name, "avx2") == 0) {
+	return JSON_INDEX_KERNEL_AVX2;
+    }
+    warn(__func__, "unknown JSON_INDEX_KERNEL: %s, using auto", name);
+    return JSON_INDEX_KERNEL_AUTO;
+}
+
+
+/*
+ * json_index_kernel_name - return the name of a kernel
+ *
+ * given:
+ *	kernel	kernel
+ *
+ * returns:
+ *	name of the kernel as a constant string
+ */
+char const *
+json_index_kernel_name(enum json_index_kernel kernel)
+{
+    switch (kernel) {
+    case JSON_INDEX_KERNEL_AUTO:
+	return "auto";
+    case JSON_INDEX_KERNEL_SCALAR:
+	return "scalar";
+    case JSON_INDEX_KERNEL_SSE2:
+	return "sse2";
+    case JSON_INDEX_KERNEL_AVX2:
+	return "avx2";
+    default:
+	break;
+    }
+    return "unknown";
+}
+
+
+/*
+ * classify_scalar - classify a block one byte at a time
+ *
+ * given:
+ *	p	JSON_INDEX_BLOCK bytes to classify
+ *	m	where to store the byte classes
+ */
+static void
+classify_scalar(uint8_t const *p, struct index_masks *m)
+{
+    uint64_t bit = 1;	/* bit for the current byte */
+    uint8_t c;		/* class of the current byte */
+    int i;
+
+    memset(m, 0, sizeof(*m));
+    for (i=0; i < JSON_INDEX_BLOCK; ++i, bit <<= 1) {
+	c = index_class[p[i]];
+	if (c != 0) {
+	    if (c & CLASS_QUOTE) {
+		m->quote |= bit;
+	    } else if (c & CLASS_BACKSLASH) {
+		m->backslash |= bit;
+	    } else if (c & CLASS_OP) {
+		m->op |= bit;
+	    }
+	    if (c & CLASS_WS) {
+		m->ws |= bit;
+	    }
+	    if (c & CLASS_CTRL) {
+		m->ctrl |= bit;
+	    }
+	}
+    }
+    return;
+}
+
+
+#if defined(JSON_INDEX_X86)
+/*
+ * classify_sse2 - classify a block 16 bytes at a time
+ *
+ * given:
+ *	p	JSON_INDEX_BLOCK bytes to classify
+ *	m	where to store the byte classes
+ */
+static void
+classify_sse2(uint8_t const *p, struct index_masks *m)
+{
+    __m128i const quote = _mm_set1_epi8('"');
+    __m128i const backslash = _mm_set1_epi8('\\');
+    __m128i const lower = _mm_set1_epi8(0x20);	/* maps [ to { and ] to } */
+    __m128i const open = _mm_set1_epi8('{');
+    __m128i const close = _mm_set1_epi8('}');
+    __m128i const colon = _mm_set1_epi8(':');
+    __m128i const comma = _mm_set1_epi8(',');
+    __m128i const space = _mm_set1_epi8(' ');
+    __m128i const tab = _mm_set1_epi8('\t');
+    __m128i const nl = _mm_set1_epi8('\n');
+    __m128i const cr = _mm_set1_epi8('\r');
+    __m128i const ctrl = _mm_set1_epi8(0x1f);
+    __m128i x;		/* 16 bytes of the block */
+    __m128i l;		/* x with the 0x20 bit set */
+    int shift;		/* bit position of x in the masks */
+
+    memset(m, 0, sizeof(*m));
+    for (shift=0; shift < JSON_INDEX_BLOCK; shift += 16) {
+	x = _mm_loadu_si128((__m128i const *)(p + shift));
+	l = _mm_or_si128(x, lower);
+	m->quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, quote)) << shift;
+	m->backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, backslash)) << shift;
+	m->op |= (uint64_t)(uint16_t)_mm_movemask_epi8(
+		    _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(l, open), _mm_cmpeq_epi8(l, close)),
+				 _mm_or_si128(_mm_cmpeq_epi8(x, colon), _mm_cmpeq_epi8(x, comma)))) << shift;
+	m->ws |= (uint64_t)(uint16_t)_mm_movemask_epi8(
+		    _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, space), _mm_cmpeq_epi8(x, tab)),
+				 _mm_or_si128(_mm_cmpeq_epi8(x, nl), _mm_cmpeq_epi8(x, cr)))) << shift;
+	m->ctrl |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(x, ctrl), x)) << shift;
+    }
+    return;
+}
+
+
+/*
+ * classify_avx2 - classify a block 32 bytes at a time
+ *
+ * given:
+ *	p	JSON_INDEX_BLOCK bytes to classify
+ *	m	where to store the byte classes
+ */
+static void
+classify_avx2(uint8_t const *p, struct index_masks *m)
+{
+    __m256i const quote = _mm256_set1_epi8('"');
+    __m256i const backslash = _mm256_set1_epi8('\\');
+    __m256i const lower = _mm256_set1_epi8(0x20);	/* maps [ to { and ] to } */
+    __m256i const open = _mm256_set1_epi8('{');
+    __m256i const close = _mm256_set1_epi8('}');
+    __m256i const colon = _mm256_set1_epi8(':');
+    __m256i const comma = _mm256_set1_epi8(',');
+    __m256i const space = _mm256_set1_epi8(' ');
+    __m256i const tab = _mm256_set1_epi8('\t');
+    __m256i const nl = _mm256_set1_epi8('\n');
+    __m256i const cr = _mm256_set1_epi8('\r');
+    __m256i const ctrl = _mm256_set1_epi8(0x1f);
+    __m256i x;		/* 32 bytes of the block */
+    __m256i l;		/* x with the 0x20 bit set */
+    int shift;		/* bit position of x in the masks */
+
+    memset(m, 0, sizeof(*m));
+    for (shift=0; shift < JSON_INDEX_BLOCK; shift += 32) {
+	x = _mm256_loadu_si256((__m256i const *)(p + shift));
+	l = _mm256_or_si256(x, lower);
+	m->quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, quote)) << shift;
+	m->backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, backslash)) << shift;
+	m->op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(
+		    _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(l, open), _mm256_cmpeq_epi8(l, close)),
+				    _mm256_or_si256(_mm256_cmpeq_epi8(x, colon), _mm256_cmpeq_epi8(x, comma)))) << shift;
+	m->ws |= (uint64_t)(uint32_t)_mm256_movemask_epi8(
+		    _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, space), _mm256_cmpeq_epi8(x, tab)),
+				    _mm256_or_si256(_mm256_cmpeq_epi8(x, nl), _mm256_cmpeq_epi8(x, cr)))) << shift;
+	m->ctrl |= (uint64_t)(uint32_t)_mm256_movemask_epi8(
+		    _mm256_cmpeq_epi8(_mm256_min_epu8(x, ctrl), x)) << shift;
+    }
+    return;
+}
+#endif
+
+
+/*
+ * index_escape_valid - determine if a \ in a JSON string starts a valid escape
+ *
+ * given:
+ *	ptr	JSON document
+ *	len	length of the JSON document
+ *	off	offset of the \ in ptr
+ *
+ * returns:
+ *	true ==> valid JSON string escape, false ==> invalid
+ */
+static bool
+index_escape_valid(char const *ptr, size_t len, size_t off)
+{
+    int i;
+
+    if (off+1 >= len) {
+	return false;
+    }
+    switch (ptr[off+1]) {
+    case '"':	/*fallthrough*/
+    case '\\':	/*fallthrough*/
+    case '/':	/*fallthrough*/
+    case 'b':	/*fallthrough*/
+    case 'f':	/*fallthrough*/
+    case 'n':	/*fallthrough*/
+    case 'r':	/*fallthrough*/
+    case 't':
+	return true;
+    case 'u':
+	if (off+5 >= len) {
+	    return false;
+	}
+	for (i=2; i <= 5; ++i) {
+	    if (!isascii(ptr[off+i]) || !isxdigit(ptr[off+i])) {
+		return false;
+	    }
+	}
+	return true;
+    default:
+	break;
+    }
+    return false;
+}
+
+
+/*
+ * index_block - add the JSON tokens of a classified block to an index
+ *
+ * given:
+ *	idx	index to add to, with room for at least JSON_INDEX_BLOCK more offsets
+ *	ptr	JSON document
+ *	base	offset in ptr of the block
+ *	m	byte classes of the block
+ *	carry	state carried from the previous block, updated for the next block
+ */
+static void
+index_block(struct json_index *idx, char const *ptr, size_t base, struct index_masks const *m,
+	    struct index_carry *carry)
+{
+    uint64_t bs = m->backslash;	/* \ that may escape the next byte */
+    uint64_t escaped = 0;	/* bytes escaped by a \ */
+    uint64_t escapes = 0;	/* \ that escape the next byte */
+    uint64_t quotes = 0;	/* " that are not escaped */
+    uint64_t in_string = 0;	/* bytes from an opening " up to, but not including, the closing " */
+    uint64_t other = 0;		/* bytes of scalar tokens */
+    uint64_t tokens = 0;	/* bytes that start a JSON token */
+    uint64_t bad = 0;		/* string bytes that are in error */
+    size_t *pos = NULL;		/* next offset to store */
+    int i;
+
+    /*
+     * find escaped bytes
+     *
+     * A \ escapes the byte that follows it, unless the \ is itself escaped.
+     * A \ is rare in JSON, so we walk the \ bits one at a time.
+     */
+    if (carry->escape) {
+	escaped = 1;
+	bs &= ~(uint64_t)1;
+    }
+    carry->escape = 0;
+    while (bs != 0) {
+	i = __builtin_ctzll(bs);
+	bs &= bs - 1;
+	escapes |= (uint64_t)1 << i;
+	if (i == JSON_INDEX_BLOCK-1) {
+	    carry->escape = 1;
+	} else {
+	    escaped |= (uint64_t)1 << (i+1);
+	    bs &= ~((uint64_t)1 << (i+1));
+	}
+    }
+
+    /*
+     * find the bytes inside JSON strings
+     *
+     * The prefix XOR of the unescaped quotes has a 1 bit from each opening
+     * quote up to, but not including, the matching closing quote.
+     */
+    quotes = m->quote & ~escaped;
+    in_string = quotes;
+    in_string ^= in_string << 1;
+    in_string ^= in_string << 2;
+    in_string ^= in_string << 4;
+    in_string ^= in_string << 8;
+    in_string ^= in_string << 16;
+    in_string ^= in_string << 32;
+    in_string ^= carry->in_string;
+    carry->in_string = (uint64_t)0 - (in_string >> (JSON_INDEX_BLOCK-1));
+
+    /*
+     * check the JSON string contents
+     */
+    if (idx->str_err == NULL) {
+	bad = m->ctrl & in_string;
+	if (bad != 0) {
+	    idx->str_err = "JSON string contains a byte < 0x20";
+	    idx->str_err_pos = base + (size_t)__builtin_ctzll(bad);
+	}
+	bad = escapes & in_string;
+	while (bad != 0) {
+	    i = __builtin_ctzll(bad);
+	    bad &= bad - 1;
+	    if (index_escape_valid(ptr, idx->len, base + (size_t)i) == false) {
+		if (idx->str_err == NULL || base + (size_t)i < idx->str_err_pos) {
+		    idx->str_err = "JSON string contains an invalid \\-escape";
+		    idx->str_err_pos = base + (size_t)i;
+		}
+		break;
+	    }
+	}
+    }
+
+    /*
+     * find the bytes that start a JSON token
+     *
+     * A scalar token (number, true, false, null or something invalid) is a
+     * run of bytes outside of JSON strings that are neither whitespace,
+     * structural characters nor quotes.  Only the first byte of a run is
+     * indexed.
+     */
+    other = ~(m->op | m->ws | quotes | in_string);
+    tokens = (m->op & ~in_string) | (quotes & in_string) | (other & ~((other << 1) | carry->other));
+    carry->other = other >> (JSON_INDEX_BLOCK-1);
+
+    /*
+     * append the token offsets
+     */
+    pos = idx->pos + idx->count;
+    while (tokens != 0) {
+	*pos++ = base + (size_t)__builtin_ctzll(tokens);
+	tokens &= tokens - 1;
+    }
+    idx->count = (size_t)(pos - idx->pos);
+    return;
+}
+
+
+/*
+ * json_index_build - form the structural index of a JSON document
+ *
+ * given:
+ *	ptr	JSON document
+ *	len	length of the JSON document
+ *	kernel	kernel to classify bytes with, JSON_INDEX_KERNEL_AUTO ==> fastest
+ *		or the one named by the JSON_INDEX_KERNEL environment variable
+ *
+ * returns:
+ *	allocated structural index, free with json_index_free()
+ *
+ * NOTE: The document need not be NUL terminated and may be any size: the
+ *	 final partial block is copied and padded with whitespace.
+ *
+ * NOTE: This function does not return on error.
+ * NOTE: This function will not return NULL.
+ */
+struct json_index *
+json_index_build(char const *ptr, size_t len, enum json_index_kernel kernel)
+{
+    struct json_index *idx = NULL;	/* index to return */
+    struct index_masks m;		/* byte classes of a block */
+    struct index_carry carry;		/* state carried between blocks */
+    uint8_t tail[JSON_INDEX_BLOCK];	/* final partial block padded with spaces */
+    void (*classify)(uint8_t const *, struct index_masks *) = classify_scalar;	/* kernel function */
+    enum json_index_kernel best;	/* fastest supported kernel */
+    size_t *newpos = NULL;		/* reallocated offsets */
+    size_t base = 0;			/* offset of the current block */
+    size_t need = 0;			/* offsets needed for the current block */
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL && len > 0) {
+	err(100, __func__, "ptr is NULL");
+	not_reached();
+    }
+
+    /*
+     * select the kernel
+     *
+     * JSON_INDEX_KERNEL in the environment overrides JSON_INDEX_KERNEL_AUTO
+     * so that every kernel can be tested on the same CPU.
+     */
+    best = json_index_best_kernel();
+    if (kernel == JSON_INDEX_KERNEL_AUTO) {
+	kernel = json_index_env_kernel();
+    }
+    if (kernel == JSON_INDEX_KERNEL_AUTO || kernel > best) {
+	kernel = best;
+    }
+#if defined(JSON_INDEX_X86)
+    if (kernel == JSON_INDEX_KERNEL_AVX2) {
+	classify = classify_avx2;
+    } else if (kernel == JSON_INDEX_KERNEL_SSE2) {
+	classify = classify_sse2;
+    }
+#endif
+
+    /*
+     * allocate the index
+     *
+     * We guess one token for every 8 bytes and grow the index as needed.
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    idx = calloc(1, sizeof(*idx));
+    if (idx == NULL) {
+	errp(101, __func__, "calloc of %ju bytes failed", (uintmax_t)sizeof(*idx));
+	not_reached();
+    }
+    idx->len = len;
+    idx->kernel = kernel;
+    idx->alloc = len / 8 + JSON_INDEX_BLOCK;
+    errno = 0;			/* pre-clear errno for errp() */
+    idx->pos = malloc(idx->alloc * sizeof(idx->pos[0]));
+    if (idx->pos == NULL) {
+	errp(102, __func__, "malloc of %ju offsets failed", (uintmax_t)idx->alloc);
+	not_reached();
+    }
+
+    /*
+     * index each block
+     */
+    memset(&carry, 0, sizeof(carry));
+    for (base=0; base < len; base += JSON_INDEX_BLOCK) {
+
+	/*
+	 * make room for every byte of the block to be a token
+	 */
+	need = idx->count + JSON_INDEX_BLOCK;
+	if (need > idx->alloc) {
+	    idx->alloc = (idx->alloc * 2 > need) ? idx->alloc * 2 : need;
+	    errno = 0;			/* pre-clear errno for errp() */
+	    newpos = realloc(idx->pos, idx->alloc * sizeof(idx->pos[0]));
+	    if (newpos == NULL) {
+		errp(103, __func__, "realloc of %ju offsets failed", (uintmax_t)idx->alloc);
+		not_reached();
+	    }
+	    idx->pos = newpos;
+	}
+
+	/*
+	 * classify the block and index it
+	 */
+	if (len - base >= JSON_INDEX_BLOCK) {
+	    classify((uint8_t const *)ptr + base, &m);
+	} else {
+	    memset(tail, ' ', sizeof(tail));
+	    memcpy(tail, ptr + base, len - base);
+	    classify(tail, &m);
+	}
+	index_block(idx, ptr, base, &m, &carry);
+    }
+
+    /*
+     * a JSON string must be terminated
+     */
+    if (carry.in_string != 0 && idx->str_err == NULL) {
+	idx->str_err = "unterminated JSON string";
+	idx->str_err_pos = (idx->count > 0) ? idx->pos[idx->count-1] : 0;
+    }
+    json_dbg(JSON_DBG_VHIGH, __func__, "indexed %ju bytes into %ju tokens with the %s kernel",
+				       (uintmax_t)len, (uintmax_t)idx->count, json_index_kernel_name(kernel));
+    return idx;
+}
+
+
+/*
+ * json_index_free - free a structural index
+ *
+ * given:
+ *	idx	index to free
+ *
+ * NOTE: This function does nothing if idx is NULL.
+ */
+void
+json_index_free(struct json_index *idx)
+{
+    if (idx == NULL) {
+	return;
+    }
+    if (idx->pos != NULL) {
+	free(idx->pos);
+	idx->pos = NULL;
+    }
+    free(idx);
+    return;
+}
+
+
+/*
+ * index_scalar_len - return the length of a scalar token
+ *
+ * given:
+ *	ptr	JSON document
+ *	len	length of the JSON document
+ *	off	offset of the first byte of the scalar token
+ *
+ * returns:
+ *	number of bytes up to the next whitespace, structural character, quote or end
+ */
+static size_t
+index_scalar_len(char const *ptr, size_t len, size_t off)
+{
+    size_t end;		/* end of the scalar token */
+
+    for (end=off; end < len; ++end) {
+	switch (ptr[end]) {
+	case ' ':	/*fallthrough*/
+	case '\t':	/*fallthrough*/
+	case '\n':	/*fallthrough*/
+	case '\r':	/*fallthrough*/
+	case '{':	/*fallthrough*/
+	case '}':	/*fallthrough*/
+	case '[':	/*fallthrough*/
+	case ']':	/*fallthrough*/
+	case ':':	/*fallthrough*/
+	case ',':	/*fallthrough*/
+	case '"':
+	    return end - off;
+	default:
+	    break;
+	}
+    }
+    return end - off;
+}
+
+
+/*
+ * index_number_valid - determine if a scalar token is a JSON number
+ *
+ * A JSON number is of the form:
+ *
+ *	-?([1-9][0-9]*|0)(\.[0-9]+)?([Ee][-+]?[0-9]+)?
+ *
+ * given:
+ *	str	first byte of the scalar token
+ *	len	length of the scalar token
+ *
+ * returns:
+ *	true ==> str is a JSON number, false ==> it is not
+ */
+static bool
+index_number_valid(char const *str, size_t len)
+{
+    char const *p = str;	/* next byte to check */
+    char const *end = str+len;	/* end of the scalar token */
+
+    if (p < end && *p == '-') {
+	++p;
+    }
+    if (p >= end || !isascii(*p) || !isdigit(*p)) {
+	return false;
+    }
+    if (*p++ == '0') {
+	/* a leading 0 may not be followed by another digit */
+    } else {
+	while (p < end && isascii(*p) && isdigit(*p)) {
+	    ++p;
+	}
+    }
+    if (p < end && *p == '.') {
+	++p;
+	if (p >= end || !isascii(*p) || !isdigit(*p)) {
+	    return false;
+	}
+	while (p < end && isascii(*p) && isdigit(*p)) {
+	    ++p;
+	}
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+	++p;
+	if (p < end && (*p == '-' || *p == '+')) {
+	    ++p;
+	}
+	if (p >= end || !isascii(*p) || !isdigit(*p)) {
+	    return false;
+	}
+	while (p < end && isascii(*p) && isdigit(*p)) {
+	    ++p;
+	}
+    }
+    return p == end;
+}
+
+
+/*
+ * index_token - check the next JSON token against the JSON grammar
+ *
+ * given:
+ *	g		JSON grammar state, updated for the token that follows
+ *	ptr		JSON document
+ *	len		length of the JSON document
+ *	off		offset of the first byte of the token
+ *	scalar_len	where to store the length of a scalar token, or 0 ==> token is not a scalar
+ *
+ * returns:
+ *	NULL ==> token is valid here, else a description of the error
+ *
+ * NOTE: This function does not return on error.
+ */
+static char const *
+index_token(struct index_grammar *g, char const *ptr, size_t len, size_t off, size_t *scalar_len)
+{
+    char *newstack = NULL;		/* reallocated stack */
+    char const *msg = NULL;		/* error message or NULL ==> no error */
+    size_t slen = 0;			/* length of a scalar token */
+    bool value = false;			/* true ==> the token completes a JSON value */
+    char c = ptr[off];			/* first byte of the token */
+
+    *scalar_len = 0;
+    switch (g->state) {
+
+    /*
+     * case: member name and : of a JSON object
+     */
+    case EXPECT_NAME_OR_END:
+	if (c == '}') {
+	    --g->depth;
+	    value = true;
+	    break;
+	}
+	/*fallthrough*/
+    case EXPECT_NAME:
+	if (c == '"') {
+	    g->state = EXPECT_COLON;
+	} else {
+	    msg = "expected a JSON member name";
+	}
+	break;
+    case EXPECT_COLON:
+	if (c == ':') {
+	    g->state = EXPECT_VALUE;
+	} else {
+	    msg = "expected : after a JSON member name";
+	}
+	break;
+
+    /*
+     * case: , or the end of the enclosing JSON object or array
+     */
+    case EXPECT_COMMA_OR_END:
+	if (c == ',') {
+	    g->state = (g->stack[g->depth-1] == '{') ? EXPECT_NAME : EXPECT_VALUE;
+	} else if ((c == '}' && g->stack[g->depth-1] == '{') || (c == ']' && g->stack[g->depth-1] == '[')) {
+	    --g->depth;
+	    value = true;
+	} else {
+	    msg = "expected , or the end of a JSON object or array";
+	}
+	break;
+
+    /*
+     * case: a JSON value
+     */
+    case EXPECT_VALUE_OR_END:
+	if (c == ']') {
+	    --g->depth;
+	    value = true;
+	    break;
+	}
+	/*fallthrough*/
+    case EXPECT_VALUE:
+	switch (c) {
+	case '{':	/*fallthrough*/
+	case '[':
+	    if (g->depth >= JSON_PARSE_MAX_DEPTH) {
+		msg = "JSON nesting depth exceeds the limit of the parser";
+		break;
+	    }
+	    if (g->depth >= g->stack_alloc) {
+		g->stack_alloc = (g->stack_alloc > 0) ? g->stack_alloc * 2 : JSON_CHUNK;
+		errno = 0;			/* pre-clear errno for errp() */
+		newstack = realloc(g->stack, g->stack_alloc);
+		if (newstack == NULL) {
+		    errp(104, __func__, "realloc of %ju bytes failed", (uintmax_t)g->stack_alloc);
+		    not_reached();
+		}
+		g->stack = newstack;
+	    }
+	    g->stack[g->depth++] = c;
+	    g->state = (c == '{') ? EXPECT_NAME_OR_END : EXPECT_VALUE_OR_END;
+	    break;
+	case '"':
+	    value = true;
+	    break;
+	case '}':	/*fallthrough*/
+	case ']':	/*fallthrough*/
+	case ':':	/*fallthrough*/
+	case ',':
+	    msg = "expected a JSON value";
+	    break;
+	default:
+	    slen = index_scalar_len(ptr, len, off);
+	    *scalar_len = slen;
+	    if ((slen == 4 && strncmp(ptr+off, "true", 4) == 0) ||
+		(slen == 5 && strncmp(ptr+off, "false", 5) == 0) ||
+		(slen == 4 && strncmp(ptr+off, "null", 4) == 0) ||
+		index_number_valid(ptr+off, slen) == true) {
+		value = true;
+	    } else {
+		msg = "invalid JSON token";
+	    }
+	    break;
+	}
+	break;
+
+    /*
+     * case: only the end of input may follow the top level value
+     */
+    case EXPECT_EOF:
+    default:
+	msg = "unexpected token after JSON value";
+	break;
+    }
+
+    /*
+     * after a complete JSON value, expect what follows it
+     */
+    if (value == true) {
+	g->state = (g->depth > 0) ? EXPECT_COMMA_OR_END : EXPECT_EOF;
+    }
+    return msg;
+}
+
+
+/*
+ * json_index_validate - determine if an indexed JSON document is valid JSON
+ *
+ * The tokens of the index are checked against the JSON grammar without
+ * converting any JSON value and without forming a JSON parse tree.  Memory
+ * use, beyond that of the index, is bounded by the nesting depth of the JSON.
+ *
+ * given:
+ *	ptr	JSON document
+ *	len	length of the JSON document
+ *	idx	structural index of ptr from json_index_build()
+ *	err_pos	!= NULL ==> where to store the offset of the first error
+ *	err_msg	!= NULL ==> where to store a description of the first error
+ *
+ * returns:
+ *	true ==> valid JSON, false ==> invalid JSON
+ *
+ * NOTE: *err_pos and *err_msg are only set when false is returned.
+ */
+bool
+json_index_validate(char const *ptr, size_t len, struct json_index const *idx,
+		    size_t *err_pos, char const **err_msg)
+{
+    struct index_grammar g = { EXPECT_VALUE, NULL, 0, 0 };	/* JSON grammar state */
+    char const *msg = NULL;		/* error message or NULL ==> no error */
+    size_t off = 0;			/* offset of the current token */
+    size_t slen = 0;			/* length of a scalar token */
+    size_t k;
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL || idx == NULL) {
+	warn(__func__, "called with NULL arg(s)");
+	return false;
+    }
+
+    /*
+     * JSON string problems found while indexing
+     */
+    if (idx->str_err != NULL) {
+	if (err_pos != NULL) {
+	    *err_pos = idx->str_err_pos;
+	}
+	if (err_msg != NULL) {
+	    *err_msg = idx->str_err;
+	}
+	return false;
+    }
+
+    /*
+     * check each token against the JSON grammar
+     */
+    for (k=0; k < idx->count && msg == NULL; ++k) {
+	off = idx->pos[k];
+	msg = index_token(&g, ptr, len, off, &slen);
+    }
+
+    /*
+     * the document must be a single complete JSON value
+     */
+    if (msg == NULL && g.state != EXPECT_EOF) {
+	msg = "unexpected end of JSON";
+	off = len;
+    }
+    if (g.stack != NULL) {
+	free(g.stack);
+	g.stack = NULL;
+    }
+    if (msg != NULL) {
+	if (err_pos != NULL) {
+	    *err_pos = off;
+	}
+	if (err_msg != NULL) {
+	    *err_msg = msg;
+	}
+	return false;
+    }
+    return true;
+}
+
+
+/*
+ * index_string_end - find the end of a JSON string while checking its contents
+ *
+ * given:
+ *	ptr	JSON document
+ *	len	length of the JSON document
+ *	off	offset of the opening " of the JSON string
+ *	end	where to store the offset of the closing ", or of the first error
+ *
+ * returns:
+ *	NULL ==> valid JSON string, else a description of the error
+ */
+static char const *
+index_string_end(char const *ptr, size_t len, size_t off, size_t *end)
+{
+    uint8_t const *p = (uint8_t const *)ptr;	/* JSON document as bytes */
+    size_t i;
+
+    for (i=off+1; i < len; ++i) {
+
+	/* skip the bytes that need no checking */
+	if ((index_class[p[i]] & (CLASS_QUOTE|CLASS_BACKSLASH|CLASS_CTRL)) == 0) {
+	    continue;
+	}
+	*end = i;
+	if (p[i] == '"') {
+	    return NULL;
+	} else if (p[i] == '\\') {
+	    if (index_escape_valid(ptr, len, i) == false) {
+		return "JSON string contains an invalid \\-escape";
+	    }
+	    i += (p[i+1] == 'u') ? 5 : 1;
+	} else {
+	    return "JSON string contains a byte < 0x20";
+	}
+    }
+    *end = len;
+    return "unexpected end of JSON";
+}
+
+
+/*
+ * json_validate - determine if a JSON document is valid JSON
+ *
+ * This is the fast path for when only the validity of the JSON matters: the
+ * document is checked against the JSON grammar in a single pass, byte by
+ * byte, without a scanner, without forming a JSON parse tree and without
+ * converting any JSON value.  Unlike json_index_validate(), no index is
+ * formed: memory use is bounded by the nesting depth of the JSON.
+ *
+ * given:
+ *	ptr	JSON document
+ *	len	length of the JSON document
+ *	verr	!= NULL ==> where to store the location of the first error
+ *
+ * returns:
+ *	true ==> valid JSON, false ==> invalid JSON
+ *
+ * NOTE: *verr is only set when false is returned.
+ *
+ * NOTE: This function does not return on malloc error.
+ */
+bool
+json_validate(char const *ptr, size_t len, struct json_valid_err *verr)
+{
+    struct index_grammar g = { EXPECT_VALUE, NULL, 0, 0 };	/* JSON grammar state */
+    char const *msg = NULL;		/* error message or NULL ==> no error */
+    size_t off = 0;			/* offset of the current byte */
+    size_t end = 0;			/* offset of the closing " of a JSON string */
+    size_t slen = 0;			/* length of a scalar token */
+    uint8_t c;
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL) {
+	warn(__func__, "ptr is NULL");
+	if (verr != NULL) {
+	    memset(verr, 0, sizeof(*verr));
+	    verr->msg = "ptr is NULL";
+	}
+	return false;
+    }
+
+    /*
+     * check each token against the JSON grammar as it is found
+     */
+    while (off < len) {
+	c = (uint8_t)ptr[off];
+
+	/* skip whitespace */
+	if ((index_class[c] & CLASS_WS) != 0) {
+	    ++off;
+	    continue;
+	}
+
+	/* check the token */
+	msg = index_token(&g, ptr, len, off, &slen);
+	if (msg != NULL) {
+	    break;
+	}
+
+	/* move beyond the token */
+	if (c == '"') {
+	    msg = index_string_end(ptr, len, off, &end);
+	    if (msg != NULL) {
+		off = end;
+		break;
+	    }
+	    off = end + 1;
+	} else if (slen > 0) {
+	    off += slen;
+	} else {
+	    ++off;
+	}
+    }
+
+    /*
+     * the document must be a single complete JSON value
+     */
+    if (msg == NULL && g.state != EXPECT_EOF) {
+	msg = "unexpected end of JSON";
+	off = len;
+    }
+    if (g.stack != NULL) {
+	free(g.stack);
+	g.stack = NULL;
+    }
+    json_dbg(JSON_DBG_VHIGH, __func__, "JSON is %s", (msg == NULL) ? "valid" : "not valid");
+    if (msg != NULL) {
+	if (verr != NULL) {
+	    verr->pos = off;
+	    verr->msg = msg;
+	    index_location(ptr, off, &verr->line, &verr->column);
+	}
+	return false;
+    }
+    return true;
+}
+
+
+/*
+ * index_location - convert an offset into a line and column
+ *
+ * given:
+ *	ptr	JSON document
+ *	off	offset in ptr
+ *	line	where to store the line number, starting at 1
+ *	column	where to store the column number, starting at 1
+ */
+static void
+index_location(char const *ptr, size_t off, int *line, int *column)
+{
+    char const *p = ptr;	/* start of the current line */
+    char const *nl = NULL;	/* next newline */
+
+    *line = 1;
+    while ((nl = memchr(p, '\n', (size_t)(ptr + off - p))) != NULL) {
+	++*line;
+	p = nl + 1;
+    }
+    *column = (int)(ptr + off - p) + 1;
+    return;
+}
+
+
+/*
+ * json_index_valid - determine if a JSON block of memory is valid JSON via a structural index
+ *
+ * This is the SIMD structural index alternative to checking the validity
+ * reported by parse_json().  No JSON value is converted and no JSON parse
+ * tree is formed.
+ *
+ * given:
+ *	ptr		pointer to start of JSON blob
+ *	len		length of the JSON blob
+ *	filename	filename or NULL for stdin
+ *
+ * returns:
+ *	true ==> valid JSON, false ==> invalid JSON
+ *
+ * NOTE: When the JSON is invalid, the location of the first error is
+ *	 printed on stderr.
+ */
+bool
+json_index_valid(char const *ptr, size_t len, char const *filename)
+{
+    struct json_index *idx = NULL;	/* structural index of ptr */
+    char const *msg = NULL;		/* description of the first error */
+    size_t off = 0;			/* offset of the first error */
+    int line = 0;			/* line of the first error */
+    int column = 0;			/* column of the first error */
+    bool valid = false;			/* true ==> valid JSON */
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL) {
+	warn(__func__, "ptr is NULL");
+	return false;
+    }
+    if (filename == NULL) {
+	filename = "-";
+    }
+
+    /*
+     * index and validate
+     */
+    idx = json_index_build(ptr, len, JSON_INDEX_KERNEL_AUTO);
+    valid = json_index_validate(ptr, len, idx, &off, &msg);
+    json_index_free(idx);
+    idx = NULL;
+
+    /*
+     * report the first error
+     */
+    if (valid == false) {
+	index_location(ptr, off, &line, &column);
+	fpr(stderr, __func__, "%s in file %s at line %d column %d\n", msg, filename, line, column);
+    }
+    json_dbg(JSON_DBG_MED, __func__, "indexed JSON from %s is %s", filename, valid ? "valid" : "not valid");
+    return valid;
+}
+
+
+/*
+ * json_index_valid_file - determine if a file is valid JSON via a structural index
+ *
+ * given:
+ *	name	filename of file to check, "-" ==> stdin
+ *
+ * returns:
+ *	true ==> valid JSON, false ==> invalid JSON or the file could not be read
+ */
+bool
+json_index_valid_file(char const *name)
+{
+    FILE *stream = NULL;	/* open file stream */
+    char *data = NULL;		/* contents of the file */
+    size_t len = 0;		/* length of data */
+    bool mapped = false;	/* true ==> data was mapped into memory */
+    bool valid = false;		/* true ==> valid JSON */
+
+    /*
+     * firewall
+     */
+    if (name == NULL) {
+	warn(__func__, "name is NULL");
+	return false;
+    }
+
+    /*
+     * open the file, unless it is stdin
+     */
+    if (strcmp(name, "-") == 0) {
+	stream = stdin;
+    } else {
+	errno = 0;		/* pre-clear errno for warnp() */
+	stream = fopen(name, "r");
+	if (stream == NULL) {
+	    warnp(__func__, "couldn't open file %s", name);
+	    return false;
+	}
+    }
+
+    /*
+     * read the file
+     */
+    data = json_read_all(stream, &len, &mapped);
+    clearerr_or_fclose(stream);
+    if (data == NULL) {
+	warn(__func__, "couldn't read file %s", name);
+	return false;
+    }
+
+    /*
+     * validate the file
+     */
+    valid = json_index_valid(data, len, name);
+    json_free_all(data, len, mapped);
+    return valid;
+}
+
+
+/*
+ * json_validate_file - determine if a file is valid JSON
+ *
+ * given:
+ *	name	filename of file to check, "-" ==> stdin
+ *	verr	!= NULL ==> where to store the location of the first error
+ *
+ * returns:
+ *	true ==> valid JSON, false ==> invalid JSON or the file could not be read
+ *
+ * NOTE: *verr is only set when false is returned.  When the file could not
+ *	 be read, verr->msg says so and the location is 0.
+ */
+bool
+json_validate_file(char const *name, struct json_valid_err *verr)
+{
+    FILE *stream = NULL;	/* open file stream */
+    char *data = NULL;		/* contents of the file */
+    size_t len = 0;		/* length of data */
+    bool mapped = false;	/* true ==> data was mapped into memory */
+    bool valid = false;		/* true ==> valid JSON */
+
+    if (verr != NULL) {
+	memset(verr, 0, sizeof(*verr));
+	verr->msg = "couldn't read file";
+    }
+
+    /*
+     * firewall
+     */
+    if (name == NULL) {
+	warn(__func__, "name is NULL");
+	return false;
+    }
+
+    /*
+     * open the file, unless it is stdin
+     */
+    if (strcmp(name, "-") == 0) {
+	stream = stdin;
+    } else {
+	errno = 0;		/* pre-clear errno for warnp() */
+	stream = fopen(name, "r");
+	if (stream == NULL) {
+	    warnp(__func__, "couldn't open file %s", name);
+	    return false;
+	}
+    }
+
+    /*
+     * read the file
+     */
+    data = json_read_all(stream, &len, &mapped);
+    clearerr_or_fclose(stream);
+    if (data == NULL) {
+	warn(__func__, "couldn't read file %s", name);
+	return false;
+    }
+
+    /*
+     * validate the file
+     */
+    valid = json_validate(data, len, verr);
+    json_free_all(data, len, mapped);
+    json_dbg(JSON_DBG_MED, __func__, "JSON file %s is %s", name, valid ? "valid" : "not valid");
+    return valid;
+}
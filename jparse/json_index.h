@@ -0,0 +1,118 @@
+/*
+ * json_index - SIMD structural index of a JSON document
+ *
+ * "Because sometimes you want to see the forest before you count the leaves." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_INDEX_H)
+#    define  INCLUDE_JSON_INDEX_H
+
+
+#include <stdint.h>
+
+/*
+ * util - entry common utility functions for the IOCCC toolkit
+ */
+#include "util.h"
+
+
+/*
+ * definitions
+ */
+#define JSON_INDEX_BLOCK (64)	/* bytes classified at a time, one bit per byte in a uint64_t */
+
+
+/*
+ * kernels that classify a block of JSON_INDEX_BLOCK bytes
+ *
+ * JSON_INDEX_KERNEL_AUTO selects the fastest kernel the CPU supports, or the
+ * one named by the JSON_INDEX_KERNEL environment variable (see
+ * json_index_env_kernel()).
+ * A kernel that is not supported by the CPU, or that was not compiled in,
+ * is replaced by the fastest kernel that is.
+ */
+enum json_index_kernel {
+    JSON_INDEX_KERNEL_AUTO = 0,		/* fastest supported kernel - must be the value 0 */
+    JSON_INDEX_KERNEL_SCALAR,		/* one byte at a time via a table, works everywhere */
+    JSON_INDEX_KERNEL_SSE2,		/* 16 bytes at a time (x86-64) */
+    JSON_INDEX_KERNEL_AVX2,		/* 32 bytes at a time (x86-64 with AVX2) */
+};
+
+
+/*
+ * json_index - structural index of a JSON document
+ *
+ * The pos array holds, in increasing order, the offset of every byte that
+ * starts a JSON token outside of a JSON string:
+ *
+ *	{ } [ ] : ,	structural characters
+ *	"		the opening quote of a JSON string
+ *	other		the first byte of a number, true, false, null, or of
+ *			anything else that is not whitespace (an invalid token)
+ *
+ * For the JSON:
+ *
+ *	{ "a" : [ 1, true ] }
+ *
+ * the offsets are those of: { " : [ 1 , t ] }
+ *
+ * While indexing, the contents of every JSON string are checked: a string
+ * must be terminated, must not contain a byte < 0x20 and may only use the
+ * \" \\ \/ \b \f \n \r \t and \uxxxx escapes.  The first such problem is
+ * recorded in str_err and str_err_pos.
+ */
+struct json_index
+{
+    size_t *pos;		/* offsets of JSON tokens, in increasing order */
+    size_t count;		/* number of offsets in pos */
+    size_t alloc;		/* number of offsets allocated for pos */
+    size_t len;			/* length of the indexed JSON document */
+    char const *str_err;	/* first JSON string problem found, or NULL ==> none */
+    size_t str_err_pos;		/* if str_err != NULL, offset of the problem */
+    enum json_index_kernel kernel;	/* kernel that was used */
+};
+
+
+/*
+ * json_valid_err - location of the first error found by json_validate()
+ */
+struct json_valid_err
+{
+    size_t pos;			/* offset of the first error */
+    int line;			/* line of the first error, starting at 1 */
+    int column;			/* column of the first error, starting at 1 */
+    char const *msg;		/* description of the first error */
+};
+
+
+/*
+ * function prototypes
+ */
+extern enum json_index_kernel json_index_best_kernel(void);
+extern enum json_index_kernel json_index_env_kernel(void);
+extern char const *json_index_kernel_name(enum json_index_kernel kernel);
+extern struct json_index *json_index_build(char const *ptr, size_t len, enum json_index_kernel kernel);
+extern void json_index_free(struct json_index *idx);
+extern bool json_index_validate(char const *ptr, size_t len, struct json_index const *idx,
+				size_t *err_pos, char const **err_msg);
+extern bool json_index_valid(char const *ptr, size_t len, char const *filename);
+extern bool json_index_valid_file(char const *name);
+extern bool json_validate(char const *ptr, size_t len, struct json_valid_err *verr);
+extern bool json_validate_file(char const *name, struct json_valid_err *verr);
+
+
+#endif /* INCLUDE_JSON_INDEX_H */
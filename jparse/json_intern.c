@@ -0,0 +1,765 @@
+/*
+ * json_intern - JSON member name interning and JSON object member index
+ *
+ * "Because saying "name" ten thousand times does not make ten thousand names." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+
+/*
+ * static functions
+ */
+static void json_intern_grow(struct json_intern *tab);
+static uint32_t member_hash(struct json *member);
+static bool member_name_eq(struct json *member, uint32_t hash, char const *name, size_t len);
+static struct json_member_index *member_index_alloc(struct json *node, size_t size);
+static void member_index_insert(struct json_member_index *index, struct json **set, intmax_t pos);
+static struct json_member_index *member_index_build(struct json *node);
+
+
+/*
+ * json_name_hash - hash a JSON member name
+ *
+ * This is the 32-bit FNV-1a hash except that a hash of 0 is returned as 1
+ * so that a 0 hash may mean "not yet hashed".
+ *
+ * given:
+ *	str	decoded JSON member name
+ *	len	length of str
+ *
+ * returns:
+ *	non-zero hash of str
+ */
+uint32_t
+json_name_hash(char const *str, size_t len)
+{
+    uint32_t hash = 2166136261U;	/* FNV-1a offset basis */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (str == NULL) {
+	return 1;
+    }
+
+    /*
+     * hash the name
+     */
+    for (i=0; i < len; ++i) {
+	hash ^= (uint8_t)str[i];
+	hash *= 16777619U;		/* FNV-1a prime */
+    }
+    return (hash == 0) ? 1 : hash;
+}
+
+
+/*
+ * json_intern_create - create an empty JSON member name interning table
+ *
+ * returns:
+ *	allocated empty table
+ *
+ * NOTE: This function does not return on error.
+ */
+struct json_intern *
+json_intern_create(void)
+{
+    struct json_intern *tab = NULL;	/* table to return */
+
+    /*
+     * allocate the table
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    tab = calloc(1, sizeof(*tab));
+    if (tab == NULL) {
+	errp(100, __func__, "calloc of %ju bytes failed", (uintmax_t)sizeof(*tab));
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    tab->slot = calloc(JSON_INTERN_SLOTS, sizeof(tab->slot[0]));
+    if (tab->slot == NULL) {
+	errp(101, __func__, "calloc of %ju slots failed", (uintmax_t)JSON_INTERN_SLOTS);
+	not_reached();
+    }
+    tab->size = JSON_INTERN_SLOTS;
+    tab->count = 0;
+    tab->lookups = 0;
+    return tab;
+}
+
+
+/*
+ * json_intern_grow - double the number of slots of a JSON member name interning table
+ *
+ * given:
+ *	tab	table to grow
+ *
+ * NOTE: This function does not return on error.
+ */
+static void
+json_intern_grow(struct json_intern *tab)
+{
+    struct json_intern_name **slot = NULL;	/* new slots */
+    size_t size = 0;				/* number of new slots */
+    size_t i;
+    size_t j;
+
+    /*
+     * firewall
+     */
+    if (tab == NULL) {
+	err(102, __func__, "tab is NULL");
+	not_reached();
+    }
+
+    /*
+     * allocate the new slots
+     */
+    size = tab->size * 2;
+    errno = 0;			/* pre-clear errno for errp() */
+    slot = calloc(size, sizeof(slot[0]));
+    if (slot == NULL) {
+	errp(103, __func__, "calloc of %ju slots failed", (uintmax_t)size);
+	not_reached();
+    }
+
+    /*
+     * move every name into the new slots
+     */
+    for (i=0; i < tab->size; ++i) {
+	if (tab->slot[i] != NULL) {
+	    for (j = tab->slot[i]->hash & (size-1); slot[j] != NULL; j = (j+1) & (size-1)) {
+		/* linear probe */
+	    }
+	    slot[j] = tab->slot[i];
+	}
+    }
+    free(tab->slot);
+    tab->slot = slot;
+    tab->size = size;
+    return;
+}
+
+
+/*
+ * json_intern - intern a JSON member name
+ *
+ * If the table already holds the name, the name gains a reference and is
+ * returned: the caller is to release its own copy of the name (unless that
+ * copy belongs to an arena) and use the returned str instead.
+ *
+ * Otherwise the table takes over str as the shared copy of the name, which
+ * is returned with one reference for the caller.
+ *
+ * given:
+ *	tab	JSON member name interning table
+ *	str	decoded JSON member name, NUL terminated
+ *	len	length of str
+ *	hash	json_name_hash(str, len)
+ *	arena	!= NULL ==> str belongs to arena, NULL ==> str was malloced
+ *
+ * returns:
+ *	shared JSON member name
+ *
+ * NOTE: The shared str must not be modified.
+ *
+ * NOTE: This function does not return on error.
+ */
+struct json_intern_name *
+json_intern(struct json_intern *tab, char *str, size_t len, uint32_t hash, struct json_arena *arena)
+{
+    struct json_intern_name *name = NULL;	/* shared JSON member name */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (tab == NULL) {
+	err(104, __func__, "tab is NULL");
+	not_reached();
+    }
+    if (str == NULL) {
+	err(105, __func__, "str is NULL");
+	not_reached();
+    }
+
+    /*
+     * look for the name
+     */
+    ++tab->lookups;
+    for (i = hash & (tab->size-1); tab->slot[i] != NULL; i = (i+1) & (tab->size-1)) {
+	name = tab->slot[i];
+	if (name->hash == hash && name->len == len && memcmp(name->str, str, len) == 0) {
+	    ++name->refs;
+	    return name;
+	}
+    }
+
+    /*
+     * take over str as a new shared name
+     */
+    if (arena != NULL) {
+	name = json_arena_alloc(arena, sizeof(*name));
+    } else {
+	errno = 0;			/* pre-clear errno for errp() */
+	name = calloc(1, sizeof(*name));
+	if (name == NULL) {
+	    errp(106, __func__, "calloc of %ju bytes failed", (uintmax_t)sizeof(*name));
+	    not_reached();
+	}
+    }
+    name->str = str;
+    name->len = len;
+    name->hash = hash;
+    name->in_arena = (arena != NULL);
+    name->refs = 2;		/* one for the table and one for the caller */
+    tab->slot[i] = name;
+    ++tab->count;
+
+    /*
+     * keep the table at most half full
+     */
+    if (tab->count*2 >= tab->size) {
+	json_intern_grow(tab);
+    }
+    return name;
+}
+
+
+/*
+ * json_intern_release - release a reference to a shared JSON member name
+ *
+ * given:
+ *	name	shared JSON member name
+ *
+ * NOTE: A name that is not in an arena is freed when its last reference is released.
+ */
+void
+json_intern_release(struct json_intern_name *name)
+{
+    /*
+     * firewall
+     */
+    if (name == NULL || name->refs == 0) {
+	return;
+    }
+
+    /*
+     * free the name with its last reference
+     */
+    --name->refs;
+    if (name->refs == 0 && name->in_arena == false) {
+	if (name->str != NULL) {
+	    free(name->str);
+	    name->str = NULL;
+	}
+	free(name);
+    }
+    return;
+}
+
+
+/*
+ * json_intern_free - free a JSON member name interning table
+ *
+ * The references held by the table are released.  Names still referenced by
+ * a JSON parse tree live on until the tree is freed.
+ *
+ * given:
+ *	tab	table to free
+ *
+ * NOTE: This function does nothing if tab is NULL.
+ */
+void
+json_intern_free(struct json_intern *tab)
+{
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (tab == NULL) {
+	return;
+    }
+
+    /*
+     * release the references held by the table
+     */
+    json_dbg(JSON_DBG_VHIGH, __func__, "interned %ju member names as %ju distinct names",
+	     tab->lookups, (uintmax_t)tab->count);
+    if (tab->slot != NULL) {
+	for (i=0; i < tab->size; ++i) {
+	    if (tab->slot[i] != NULL) {
+		json_intern_release(tab->slot[i]);
+		tab->slot[i] = NULL;
+	    }
+	}
+	free(tab->slot);
+	tab->slot = NULL;
+    }
+    free(tab);
+    return;
+}
+
+
+/*
+ * member_hash - return the hash of the name of a JSON member
+ *
+ * given:
+ *	member	JSON member
+ *
+ * returns:
+ *	json_name_hash() of the decoded member name, or 0 ==> member has no decoded name
+ */
+static uint32_t
+member_hash(struct json *member)
+{
+    struct json_member *item = NULL;	/* JSON member inside member */
+
+    /*
+     * firewall
+     */
+    if (member == NULL || member->type != JTYPE_MEMBER) {
+	return 0;
+    }
+    item = &(member->item.member);
+    if (item->name_str == NULL) {
+	return 0;
+    }
+
+    /*
+     * hash the name if json_conv_member() did not
+     */
+    if (item->name_hash == 0) {
+	item->name_hash = json_name_hash(item->name_str, item->name_str_len);
+    }
+    return item->name_hash;
+}
+
+
+/*
+ * member_name_eq - determine if a JSON member has a given decoded name
+ *
+ * given:
+ *	member	JSON member
+ *	hash	json_name_hash() of name
+ *	name	decoded name
+ *	len	length of name
+ *
+ * returns:
+ *	true ==> member has the name, false ==> it does not
+ */
+static bool
+member_name_eq(struct json *member, uint32_t hash, char const *name, size_t len)
+{
+    struct json_member *item = NULL;	/* JSON member inside member */
+
+    if (member_hash(member) != hash) {
+	return false;
+    }
+    item = &(member->item.member);
+    return item->name_str_len == len && (item->name_str == name || memcmp(item->name_str, name, len) == 0);
+}
+
+
+/*
+ * member_index_alloc - allocate an empty JSON object member index
+ *
+ * given:
+ *	node	JSON object the index is for
+ *	size	number of slots (a power of 2)
+ *
+ * returns:
+ *	allocated empty index, or NULL ==> node is an arena node outside of a parse
+ *
+ * NOTE: The index of an arena node is allocated from the arena of the parse.
+ *
+ * NOTE: This function does not return on malloc error.
+ */
+static struct json_member_index *
+member_index_alloc(struct json *node, size_t size)
+{
+    struct json_member_index *index = NULL;	/* index to return */
+    struct json_arena *arena = NULL;		/* arena of the current parse or NULL */
+
+    /*
+     * allocate the index where the node lives
+     */
+    if (node->in_arena == true) {
+	if (json_parse_current != NULL) {
+	    arena = json_parse_current->arena;
+	}
+	if (arena == NULL) {
+	    /* arena trees may only be changed while they are being parsed */
+	    return NULL;
+	}
+	index = json_arena_alloc(arena, sizeof(*index));
+	index->slot = json_arena_alloc(arena, size * sizeof(index->slot[0]));
+    } else {
+	errno = 0;			/* pre-clear errno for errp() */
+	index = calloc(1, sizeof(*index));
+	if (index == NULL) {
+	    errp(107, __func__, "calloc of %ju bytes failed", (uintmax_t)sizeof(*index));
+	    not_reached();
+	}
+	errno = 0;			/* pre-clear errno for errp() */
+	index->slot = calloc(size, sizeof(index->slot[0]));
+	if (index->slot == NULL) {
+	    errp(108, __func__, "calloc of %ju slots failed", (uintmax_t)size);
+	    not_reached();
+	}
+    }
+    index->size = size;
+    index->count = 0;
+    index->dup = -1;
+    index->dup_count = 0;
+    index->in_arena = node->in_arena;
+    return index;
+}
+
+
+/*
+ * member_index_insert - add a member to a JSON object member index
+ *
+ * given:
+ *	index	JSON object member index with room for another member
+ *	set	set of members of the JSON object
+ *	pos	set position of the member to add
+ */
+static void
+member_index_insert(struct json_member_index *index, struct json **set, intmax_t pos)
+{
+    struct json *member = set[pos];		/* member to add */
+    struct json_member *item = NULL;		/* JSON member inside member */
+    uint32_t hash = 0;				/* hash of the member name */
+    size_t i;
+
+    ++index->count;
+    hash = member_hash(member);
+    if (hash == 0) {
+	/* a member without a decoded name cannot be found by name */
+	return;
+    }
+    item = &(member->item.member);
+
+    /*
+     * find the slot of the name, or an empty slot
+     */
+    for (i = hash & (index->size-1); index->slot[i] != 0; i = (i+1) & (index->size-1)) {
+	if (member_name_eq(set[index->slot[i]-1], hash, item->name_str, item->name_str_len)) {
+	    /* duplicate name - the first member keeps the slot */
+	    if (index->dup < 0) {
+		index->dup = pos;
+	    }
+	    ++index->dup_count;
+	    return;
+	}
+    }
+    index->slot[i] = pos + 1;
+    return;
+}
+
+
+/*
+ * member_index_build - build the member index of a JSON object
+ *
+ * given:
+ *	node	JSON object
+ *
+ * returns:
+ *	index of all members of node, or NULL ==> node cannot be indexed
+ */
+static struct json_member_index *
+member_index_build(struct json *node)
+{
+    struct json_object *item = &(node->item.object);	/* JSON object inside node */
+    struct json_member_index *index = NULL;		/* new index */
+    size_t size = JSON_MEMBER_INDEX_MIN * 2;		/* number of slots */
+    intmax_t i;
+
+    /*
+     * size the index to be at most half full
+     */
+    while (size < (size_t)item->len * 2) {
+	size *= 2;
+    }
+    index = member_index_alloc(node, size);
+    if (index == NULL) {
+	return NULL;
+    }
+
+    /*
+     * index every member
+     */
+    for (i=0; i < item->len; ++i) {
+	member_index_insert(index, item->set, i);
+    }
+    json_dbg(JSON_DBG_VHIGH, __func__, "indexed %jd members in %ju slots with %jd duplicate(s)",
+	     index->count, (uintmax_t)index->size, index->dup_count);
+    return index;
+}
+
+
+/*
+ * json_object_index_add - keep the member index of a JSON object up to date
+ *
+ * This function is called by json_object_add_member() after a member has been
+ * added to a JSON object.  Once a JSON object has JSON_MEMBER_INDEX_MIN members
+ * it is indexed, and from then on every added member is added to its index.
+ *
+ * given:
+ *	node	JSON object
+ *	pos	set position of the member that was added
+ *
+ * NOTE: This function does nothing if node is not a JTYPE_OBJECT.
+ */
+void
+json_object_index_add(struct json *node, intmax_t pos)
+{
+    struct json_object *item = NULL;		/* JSON object inside node */
+    struct json_member_index *index = NULL;	/* member index of the object */
+
+    /*
+     * firewall
+     */
+    if (node == NULL || node->type != JTYPE_OBJECT) {
+	return;
+    }
+    item = &(node->item.object);
+    if (pos < 0 || pos >= item->len || item->set == NULL) {
+	return;
+    }
+
+    /*
+     * case: small object - not indexed yet
+     */
+    if (item->index == NULL) {
+	if (item->len >= JSON_MEMBER_INDEX_MIN) {
+	    item->index = member_index_build(node);
+	}
+	return;
+    }
+    index = item->index;
+
+    /*
+     * rebuild a larger index when the index would become more than half full
+     */
+    if ((size_t)(index->count + 1) * 2 > index->size) {
+	json_member_index_free(index);
+	item->index = member_index_build(node);
+	return;
+    }
+    member_index_insert(index, item->set, pos);
+    return;
+}
+
+
+/*
+ * json_member_index_free - free a JSON object member index
+ *
+ * given:
+ *	index	JSON object member index to free
+ *
+ * NOTE: This function does nothing if index is NULL or belongs to an arena.
+ */
+void
+json_member_index_free(struct json_member_index *index)
+{
+    if (index == NULL || index->in_arena == true) {
+	return;
+    }
+    if (index->slot != NULL) {
+	free(index->slot);
+	index->slot = NULL;
+    }
+    free(index);
+    return;
+}
+
+
+/*
+ * json_object_lookup - find the first member of a JSON object with a given name
+ *
+ * A JSON object with a member index is searched via the index and so in
+ * constant time.  The members of any other JSON object are compared by name
+ * hash before they are compared by name.  Unlike json_object_find_member(),
+ * this function never builds an index and so does not change node.
+ *
+ * given:
+ *	node	JSON object
+ *	name	decoded name to find
+ *	len	length of name
+ *
+ * returns:
+ *	first JTYPE_MEMBER of node with the name, or NULL ==> no such member or node is not a JTYPE_OBJECT
+ */
+struct json *
+json_object_lookup(struct json const *node, char const *name, size_t len)
+{
+    struct json_object const *item = NULL;		/* JSON object inside node */
+    struct json_member_index const *index = NULL;	/* member index of the object */
+    uint32_t hash = 0;					/* hash of name */
+    intmax_t i;
+    size_t j;
+
+    /*
+     * firewall
+     */
+    if (node == NULL || name == NULL || node->type != JTYPE_OBJECT) {
+	return NULL;
+    }
+    item = &(node->item.object);
+    if (item->len <= 0 || item->set == NULL) {
+	return NULL;
+    }
+    hash = json_name_hash(name, len);
+    index = item->index;
+
+    /*
+     * case: no index - look at each member
+     */
+    if (index == NULL) {
+	for (i=0; i < item->len; ++i) {
+	    if (member_name_eq(item->set[i], hash, name, len)) {
+		return item->set[i];
+	    }
+	}
+	return NULL;
+    }
+
+    /*
+     * case: look up the name in the index
+     */
+    for (j = hash & (index->size-1); index->slot[j] != 0; j = (j+1) & (index->size-1)) {
+	if (member_name_eq(item->set[index->slot[j]-1], hash, name, len)) {
+	    return item->set[index->slot[j]-1];
+	}
+    }
+    return NULL;
+}
+
+
+/*
+ * json_object_find_member - find the first member of a JSON object with a given name
+ *
+ * This function is like json_object_lookup() except that a JSON object with
+ * at least JSON_MEMBER_INDEX_MIN members that has no member index is first
+ * indexed, so that this and later lookups take constant time.
+ *
+ * given:
+ *	node	JSON object
+ *	name	decoded name to find
+ *	len	length of name
+ *
+ * returns:
+ *	first JTYPE_MEMBER of node with the name, or NULL ==> no such member or node is not a JTYPE_OBJECT
+ */
+struct json *
+json_object_find_member(struct json *node, char const *name, size_t len)
+{
+    struct json_object *item = NULL;		/* JSON object inside node */
+
+    /*
+     * index a large object on first use
+     */
+    if (node != NULL && node->type == JTYPE_OBJECT) {
+	item = &(node->item.object);
+	if (item->index == NULL && item->len >= JSON_MEMBER_INDEX_MIN && item->set != NULL) {
+	    item->index = member_index_build(node);
+	}
+    }
+    return json_object_lookup(node, name, len);
+}
+
+
+/*
+ * json_object_find_dup - find the first JSON object member with the name of an earlier member
+ *
+ * given:
+ *	node	JSON object
+ *
+ * returns:
+ *	first JTYPE_MEMBER whose name was already used by an earlier member,
+ *	or NULL ==> all member names are different or node is not a JTYPE_OBJECT
+ */
+struct json *
+json_object_find_dup(struct json *node)
+{
+    struct json_object *item = NULL;		/* JSON object inside node */
+    struct json_member_index *index = NULL;	/* member index of the object */
+    struct json_member *member = NULL;		/* JSON member to check */
+    intmax_t i;
+    intmax_t j;
+
+    /*
+     * firewall
+     */
+    if (node == NULL || node->type != JTYPE_OBJECT) {
+	return NULL;
+    }
+    item = &(node->item.object);
+    if (item->len <= 1 || item->set == NULL) {
+	return NULL;
+    }
+
+    /*
+     * index the object if needed - a duplicate is found while indexing
+     */
+    if (item->index == NULL) {
+	item->index = member_index_build(node);
+    }
+    index = item->index;
+    if (index != NULL) {
+	return (index->dup < 0) ? NULL : item->set[index->dup];
+    }
+
+    /*
+     * case: no index - compare each member with the earlier members
+     */
+    for (i=1; i < item->len; ++i) {
+	if (member_hash(item->set[i]) == 0) {
+	    continue;
+	}
+	member = &(item->set[i]->item.member);
+	for (j=0; j < i; ++j) {
+	    if (member_name_eq(item->set[j], member->name_hash, member->name_str, member->name_str_len)) {
+		return item->set[i];
+	    }
+	}
+    }
+    return NULL;
+}
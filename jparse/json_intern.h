@@ -0,0 +1,121 @@
+/*
+ * json_intern - JSON member name interning and JSON object member index
+ *
+ * "Because saying "name" ten thousand times does not make ten thousand names." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_INTERN_H)
+#    define  INCLUDE_JSON_INTERN_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * util - entry common utility functions for the IOCCC toolkit
+ */
+#include "util.h"
+
+/*
+ * json_arena - JSON parse tree arena allocator
+ */
+#include "json_arena.h"
+
+
+/*
+ * definitions
+ */
+#define JSON_INTERN_SLOTS (64)		/* initial number of slots in a JSON member name interning table */
+#define JSON_MEMBER_INDEX_MIN (16)	/* JSON objects with fewer members are searched without an index */
+
+
+/*
+ * forward declarations
+ */
+struct json;			/* see json_parse.h */
+
+
+/*
+ * json_intern_name - a JSON member name shared by every member of a parse tree with that name
+ *
+ * The name itself, str, is the decoded JSON string of the first member found
+ * with that name: the table takes over that string instead of copying it.
+ *
+ * A name is shared by refs JSON strings plus, for as long as it exists, the
+ * table.  A name that is not in an arena is freed when the last reference
+ * is released by json_intern_release().
+ */
+struct json_intern_name
+{
+    char *str;			/* decoded JSON member name, NUL terminated */
+    size_t len;			/* length of str, not including final NUL */
+    uint32_t hash;		/* json_name_hash() of str */
+    bool in_arena;		/* true ==> name and str belong to a struct json_arena */
+    uintmax_t refs;		/* number of references to this name */
+};
+
+
+/*
+ * json_intern - table of the JSON member names of a parse
+ *
+ * The table is an open addressing hash table with linear probing.  The number
+ * of slots is a power of 2 that is at least twice the number of names.
+ */
+struct json_intern
+{
+    struct json_intern_name **slot;	/* hash table slots, NULL ==> empty slot */
+    size_t size;			/* number of slots (a power of 2) */
+    size_t count;			/* number of names in the table */
+    uintmax_t lookups;			/* number of names interned */
+};
+
+
+/*
+ * json_member_index - hash index of the members of a JSON object
+ *
+ * Each used slot holds the position, plus 1, of a member in the set of the
+ * JSON object.  Only the first member with a given name is indexed: a later
+ * member with the same name is a duplicate, which is counted instead.
+ */
+struct json_member_index
+{
+    intmax_t *slot;		/* member set position + 1, 0 ==> empty slot */
+    size_t size;		/* number of slots (a power of 2) */
+    intmax_t count;		/* number of members indexed, including duplicates */
+    intmax_t dup;		/* set position of the first duplicate member or -1 ==> no duplicate */
+    intmax_t dup_count;		/* number of duplicate members */
+    bool in_arena;		/* true ==> index belongs to a struct json_arena */
+};
+
+
+/*
+ * function prototypes
+ */
+extern uint32_t json_name_hash(char const *str, size_t len);
+extern struct json_intern *json_intern_create(void);
+extern void json_intern_free(struct json_intern *tab);
+extern struct json_intern_name *json_intern(struct json_intern *tab, char *str, size_t len, uint32_t hash,
+					   struct json_arena *arena);
+extern void json_intern_release(struct json_intern_name *name);
+extern void json_object_index_add(struct json *node, intmax_t pos);
+extern void json_member_index_free(struct json_member_index *index);
+extern struct json *json_object_lookup(struct json const *node, char const *name, size_t len);
+extern struct json *json_object_find_member(struct json *node, char const *name, size_t len);
+extern struct json *json_object_find_dup(struct json *node);
+
+
+#endif /* INCLUDE_JSON_INTERN_H */
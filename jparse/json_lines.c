@@ -0,0 +1,706 @@
+/*
+ * json_lines - parse JSON Lines and RFC 7464 JSON text sequences
+ *
+ * "Because one JSON text per file was never going to be enough." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+
+struct json_lines_worker;	/* see below */
+
+
+/*
+ * json_lines_pool - records shared by the worker threads of parse_json_lines()
+ *
+ * Worker threads split records from the input into a ring of window slots,
+ * parse them, and mark them done.  The calling thread delivers the done
+ * records to the callback in input order.  No more than window records are
+ * split but not yet delivered, which bounds the number of parse trees held.
+ *
+ * A parse tree is freed by the worker thread that formed it, as freeing
+ * memory on a thread other than the one that allocated it is much slower.
+ */
+struct json_lines_pool
+{
+    pthread_mutex_t lock;	/* guards the members below */
+    pthread_cond_t ready;	/* signaled when records are parsed or the input is used up */
+    pthread_cond_t space;	/* signaled when records are delivered */
+    char const *ptr;		/* JSON Lines or JSON text sequence */
+    size_t len;			/* length of ptr */
+    size_t pos;			/* offset in ptr of the next record to split */
+    uintmax_t line;		/* line number at pos */
+    uintmax_t num;		/* number of records split */
+    bool rfc7464;		/* true ==> RFC 7464 JSON text sequence, false ==> JSON Lines */
+    char const *filename;	/* filename for messages */
+    bool form_tree;		/* true ==> form a parse tree for each record */
+    struct json_line *ring;	/* records split but not yet delivered */
+    bool *done;			/* true ==> the record in the same ring slot has been parsed */
+    unsigned int *owner;	/* worker thread that parsed the record in the same ring slot */
+    struct json_lines_worker *worker;	/* worker threads */
+    uintmax_t window;		/* number of ring slots */
+    uintmax_t delivered;	/* number of records delivered */
+    bool stop;			/* true ==> split no more records */
+};
+
+
+/*
+ * json_lines_worker - a worker thread of parse_json_lines()
+ */
+struct json_lines_worker
+{
+    pthread_t thread;			/* worker thread */
+    unsigned int id;			/* index of this worker thread */
+    struct json_lines_pool *pool;	/* records shared by the worker threads */
+    struct dyn_array *garbage;		/* delivered parse trees for this thread to free */
+    struct dyn_array *spare;		/* parse trees being freed by this thread */
+};
+
+
+/*
+ * static functions
+ */
+static bool json_lines_blank(char const *ptr, size_t len);
+static bool json_lines_split(struct json_lines_pool *pool, struct json_line *rec);
+static void json_lines_parse(struct json_lines_pool *pool, struct json_line *rec, bool quiet);
+static void json_lines_free_trees(struct dyn_array *trees);
+static bool json_lines_deliver(struct json_line *rec, bool (*callback)(struct json_line *, void *), void *ctx);
+static void *json_lines_worker(void *arg);
+
+
+/*
+ * json_lines_blank - determine if text is only JSON whitespace
+ *
+ * given:
+ *	ptr	text to check
+ *	len	length of ptr
+ *
+ * returns:
+ *	true ==> text is empty or only JSON whitespace, false ==> text is not blank
+ */
+static bool
+json_lines_blank(char const *ptr, size_t len)
+{
+    size_t i;
+
+    for (i=0; i < len; ++i) {
+	if (ptr[i] != ' ' && ptr[i] != '\t' && ptr[i] != '\r' && ptr[i] != '\n') {
+	    return false;
+	}
+    }
+    return true;
+}
+
+
+/*
+ * json_lines_split - split the next record from the input
+ *
+ * A JSON Lines record ends at a newline, which is not part of the record.
+ * An RFC 7464 record starts after a record separator (RS) and ends at the
+ * next RS.  Blank records are skipped.
+ *
+ * given:
+ *	pool	records shared by the worker threads
+ *	rec	record to fill in
+ *
+ * returns:
+ *	true ==> rec is the next record, false ==> no more records
+ *
+ * NOTE: When there are worker threads, the pool lock must be held.
+ */
+static bool
+json_lines_split(struct json_lines_pool *pool, struct json_line *rec)
+{
+    char const *start = NULL;	/* start of the record */
+    char const *end = NULL;	/* end of the record or NULL ==> end of input */
+    char const *nl = NULL;	/* next newline in the record */
+    size_t rest = 0;		/* bytes left in the input */
+    size_t len = 0;		/* length of the record */
+    uintmax_t line = 0;		/* line number on which the record starts */
+
+    while (pool->pos < pool->len) {
+	start = pool->ptr + pool->pos;
+	rest = pool->len - pool->pos;
+	line = pool->line;
+
+	/*
+	 * find the end of the record
+	 */
+	if (pool->rfc7464 == true) {
+	    if (*start == JSON_LINES_RS) {
+		/* skip the record separator */
+		++pool->pos;
+		continue;
+	    }
+	    end = memchr(start, JSON_LINES_RS, rest);
+	    len = (end == NULL) ? rest : (size_t)(end - start);
+	    pool->pos += len;
+
+	    /* count the newlines within the record */
+	    for (nl = memchr(start, '\n', len); nl != NULL;
+		 nl = memchr(nl + 1, '\n', len - (size_t)(nl + 1 - start))) {
+		++pool->line;
+	    }
+	} else {
+	    end = memchr(start, '\n', rest);
+	    len = (end == NULL) ? rest : (size_t)(end - start);
+	    pool->pos += len;
+	    if (end != NULL) {
+		/* skip the newline */
+		++pool->pos;
+		++pool->line;
+	    }
+	}
+
+	/*
+	 * skip a blank record
+	 */
+	if (json_lines_blank(start, len) == true) {
+	    continue;
+	}
+
+	/*
+	 * return the record
+	 */
+	rec->num = ++pool->num;
+	rec->line = line;
+	rec->ptr = start;
+	rec->len = len;
+	rec->is_valid = false;
+	rec->tree = NULL;
+	return true;
+    }
+    return false;
+}
+
+
+/*
+ * json_lines_parse - parse a record
+ *
+ * Syntax errors are reported at the lines of the file on which they are
+ * found, not at lines of the record.
+ *
+ * given:
+ *	pool	records shared by the worker threads
+ *	rec	record to parse
+ *	quiet	true ==> do not report syntax errors
+ *
+ * NOTE: This function does not use the pool lock: it only reads pool members
+ *	 that do not change during parse_json_lines().
+ */
+static void
+json_lines_parse(struct json_lines_pool *pool, struct json_line *rec, bool quiet)
+{
+    struct json_parse_ctx ctx;		/* context of the parse of the record */
+
+    /*
+     * case: only validate the record
+     */
+    if (pool->form_tree == false) {
+	rec->is_valid = parse_json_events_at(rec->ptr, rec->len, pool->filename, rec->line, quiet,
+					     JSON_INFINITE_DEPTH, NULL, NULL);
+	return;
+    }
+
+    /*
+     * form the parse tree of the record
+     */
+    json_parse_ctx_init(&ctx, pool->filename, NULL);
+    ctx.line = rec->line;
+    ctx.quiet = quiet;
+    rec->tree = parse_json_ctx(rec->ptr, rec->len, NULL, &ctx, &rec->is_valid);
+    if (rec->is_valid == false && rec->tree != NULL) {
+	json_tree_free(rec->tree, JSON_INFINITE_DEPTH);
+	free(rec->tree);
+	rec->tree = NULL;
+    }
+    return;
+}
+
+
+/*
+ * json_lines_free_trees - free a set of parse trees
+ *
+ * given:
+ *	trees	dynamic array of struct json * to free, cleared on return
+ */
+static void
+json_lines_free_trees(struct dyn_array *trees)
+{
+    struct json *tree = NULL;	/* parse tree to free */
+    intmax_t i;
+
+    for (i=0; i < dyn_array_tell(trees); ++i) {
+	tree = dyn_array_value(trees, struct json *, i);
+	json_tree_free(tree, JSON_INFINITE_DEPTH);
+	free(tree);
+    }
+    dyn_array_clear(trees);
+    return;
+}
+
+
+/*
+ * json_lines_deliver - pass a parsed record to the callback
+ *
+ * given:
+ *	rec		parsed record
+ *	callback	function to call for the record, or NULL
+ *	ctx		context passed to callback
+ *
+ * returns:
+ *	true ==> continue with the next record, false ==> callback asked to stop
+ *
+ * NOTE: The parse tree of the record, if any, is freed unless the callback
+ *	 set rec->tree to NULL.
+ */
+static bool
+json_lines_deliver(struct json_line *rec, bool (*callback)(struct json_line *, void *), void *ctx)
+{
+    bool more = true;		/* true ==> continue with the next record */
+
+    if (callback != NULL) {
+	more = (*callback)(rec, ctx);
+    }
+    if (rec->tree != NULL) {
+	json_tree_free(rec->tree, JSON_INFINITE_DEPTH);
+	free(rec->tree);
+	rec->tree = NULL;
+    }
+    return more;
+}
+
+
+/*
+ * json_lines_worker - split and parse batches of records
+ *
+ * given:
+ *	arg	pointer to the struct json_lines_pool
+ *
+ * returns:
+ *	NULL
+ */
+static void *
+json_lines_worker(void *arg)
+{
+    struct json_lines_worker *self = (struct json_lines_worker *)arg;	/* this worker thread */
+    struct json_lines_pool *pool = self->pool;	/* records shared by the worker threads */
+    struct dyn_array *trees = NULL;	/* parse trees to free */
+    uintmax_t first = 0;	/* number of the first record of the batch */
+    uintmax_t count = 0;	/* number of records in the batch */
+    uintmax_t slot = 0;		/* ring slot of a record */
+    uintmax_t i;
+
+    (void) pthread_mutex_lock(&pool->lock);
+    while (pool->stop == false && pool->pos < pool->len) {
+
+	/*
+	 * free the delivered parse trees this thread formed, without the lock
+	 */
+	if (dyn_array_tell(self->garbage) > 0) {
+	    trees = self->garbage;
+	    self->garbage = self->spare;
+	    self->spare = trees;
+	    (void) pthread_mutex_unlock(&pool->lock);
+	    json_lines_free_trees(trees);
+	    (void) pthread_mutex_lock(&pool->lock);
+	    continue;
+	}
+
+	/*
+	 * wait until a batch fits in the ring
+	 */
+	if (pool->num - pool->delivered + JSON_LINES_BATCH > pool->window) {
+	    (void) pthread_cond_wait(&pool->space, &pool->lock);
+	    continue;
+	}
+
+	/*
+	 * split a batch of records
+	 */
+	first = pool->num;
+	for (count=0; count < JSON_LINES_BATCH; ++count) {
+	    slot = (first + count) % pool->window;
+	    if (json_lines_split(pool, &pool->ring[slot]) == false) {
+		break;
+	    }
+	    pool->done[slot] = false;
+	    pool->owner[slot] = self->id;
+	}
+	if (count == 0) {
+	    break;
+	}
+
+	/*
+	 * parse the batch without the lock
+	 */
+	(void) pthread_mutex_unlock(&pool->lock);
+	for (i=0; i < count; ++i) {
+	    json_lines_parse(pool, &pool->ring[(first + i) % pool->window], true);
+	}
+	(void) pthread_mutex_lock(&pool->lock);
+
+	/*
+	 * tell the calling thread the batch is ready
+	 */
+	for (i=0; i < count; ++i) {
+	    pool->done[(first + i) % pool->window] = true;
+	}
+	(void) pthread_cond_broadcast(&pool->ready);
+    }
+
+    /*
+     * the input is used up or the parse was stopped
+     *
+     * NOTE: parse trees delivered from now on are freed by parse_json_lines().
+     */
+    (void) pthread_cond_broadcast(&pool->ready);
+    (void) pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+
+/*
+ * parse_json_lines - parse each record of JSON Lines or of a JSON text sequence
+ *
+ * Input that starts with a record separator (RS, 0x1e) is parsed as an
+ * RFC 7464 JSON text sequence: each record starts after an RS.  Otherwise
+ * the input is parsed as JSON Lines: each line is a record.  Blank records
+ * are skipped.
+ *
+ * Records are parsed on a pool of worker threads and passed to the callback,
+ * on the calling thread, in input order.
+ *
+ * given:
+ *	ptr		pointer to the JSON Lines or JSON text sequence
+ *	len		length of ptr
+ *	filename	filename for messages, or NULL
+ *	threads		number of worker threads, 0 ==> one per online CPU
+ *	form_tree	true ==> form a parse tree for each valid record,
+ *			false ==> only validate each record with the event parser
+ *	callback	function to call for each record, or NULL
+ *	ctx		context passed to callback
+ *
+ * returns:
+ *	true ==> every record was valid JSON,
+ *	false ==> a record was not valid JSON, or callback returned false
+ *
+ * NOTE: The parse tree of a record, if any, is freed after the callback
+ *	 returns unless the callback set the tree of the record to NULL.
+ *
+ * NOTE: When threads is 1, or worker threads cannot be created, the records
+ *	 are parsed on the calling thread.
+ */
+bool
+parse_json_lines(char const *ptr, size_t len, char const *filename, unsigned int threads, bool form_tree,
+		 bool (*callback)(struct json_line *, void *), void *ctx)
+{
+    struct json_lines_pool pool;	/* records shared by the worker threads */
+    unsigned int workers = 0;		/* number of worker threads running */
+    struct json_line rec;		/* record being delivered */
+    struct json_line again;		/* invalid record parsed again to report its syntax errors */
+    uintmax_t slot = 0;			/* ring slot of the record being delivered */
+    long cpus = 0;			/* number of online CPUs */
+    bool valid = true;			/* true ==> every record was valid JSON */
+    bool more = true;			/* true ==> callback did not ask to stop */
+    unsigned int i;
+    int ret;
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL) {
+	warn(__func__, "ptr is NULL");
+	return false;
+    }
+    if (filename == NULL) {
+	filename = "-";
+    }
+
+    /*
+     * set up the records
+     */
+    memset(&pool, 0, sizeof(pool));
+    pool.ptr = ptr;
+    pool.len = len;
+    pool.pos = 0;
+    pool.line = 1;
+    pool.rfc7464 = (len > 0 && ptr[0] == JSON_LINES_RS);
+    pool.filename = filename;
+    pool.form_tree = form_tree;
+    json_dbg(JSON_DBG_MED, __func__, "parsing %ju bytes of %s from %s",
+	     (uintmax_t)len, pool.rfc7464 ? "JSON text sequence" : "JSON Lines", filename);
+
+    /*
+     * determine the number of worker threads
+     */
+    if (threads == 0) {
+	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	threads = (cpus > 0) ? (unsigned int)((cpus < JSON_LINES_MAX_THREADS) ? cpus : JSON_LINES_MAX_THREADS) : 1;
+    } else if (threads > JSON_LINES_MAX_THREADS) {
+	threads = JSON_LINES_MAX_THREADS;
+    }
+
+    /*
+     * start the worker threads
+     */
+    if (threads > 1) {
+	pool.window = (uintmax_t)threads * JSON_LINES_BATCH * JSON_LINES_WINDOW;
+	pool.ring = calloc((size_t)pool.window, sizeof(pool.ring[0]));
+	if (pool.ring == NULL) {
+	    errp(100, __func__, "calloc of %ju records failed", pool.window);
+	    not_reached();
+	}
+	pool.done = calloc((size_t)pool.window, sizeof(pool.done[0]));
+	if (pool.done == NULL) {
+	    errp(101, __func__, "calloc of %ju record flags failed", pool.window);
+	    not_reached();
+	}
+	pool.owner = calloc((size_t)pool.window, sizeof(pool.owner[0]));
+	if (pool.owner == NULL) {
+	    errp(102, __func__, "calloc of %ju record owners failed", pool.window);
+	    not_reached();
+	}
+	pool.worker = calloc(threads, sizeof(pool.worker[0]));
+	if (pool.worker == NULL) {
+	    errp(103, __func__, "calloc of %u threads failed", threads);
+	    not_reached();
+	}
+	if (pthread_mutex_init(&pool.lock, NULL) != 0 ||
+	    pthread_cond_init(&pool.ready, NULL) != 0 ||
+	    pthread_cond_init(&pool.space, NULL) != 0) {
+	    err(104, __func__, "failed to initialize the worker thread pool");
+	    not_reached();
+	}
+	for (i=0; i < threads; ++i) {
+	    pool.worker[i].id = i;
+	    pool.worker[i].pool = &pool;
+	    pool.worker[i].garbage = dyn_array_create(sizeof(struct json *), JSON_CHUNK, JSON_LINES_BATCH, false);
+	    pool.worker[i].spare = dyn_array_create(sizeof(struct json *), JSON_CHUNK, JSON_LINES_BATCH, false);
+	}
+	for (i=0; i < threads; ++i) {
+	    ret = pthread_create(&pool.worker[i].thread, NULL, json_lines_worker, &pool.worker[i]);
+	    if (ret != 0) {
+		errno = ret;
+		warnp(__func__, "could only start %u of %u worker threads", i, threads);
+		break;
+	    }
+	    ++workers;
+	}
+	json_dbg(JSON_DBG_HIGH, __func__, "started %u worker threads", workers);
+    }
+
+    /*
+     * case: parse the records on the calling thread
+     */
+    if (workers == 0) {
+	while (more == true && json_lines_split(&pool, &rec) == true) {
+	    json_lines_parse(&pool, &rec, false);
+	    if (rec.is_valid == false) {
+		valid = false;
+	    }
+	    more = json_lines_deliver(&rec, callback, ctx);
+	}
+
+    /*
+     * case: deliver the records parsed by the worker threads in input order
+     */
+    } else {
+	(void) pthread_mutex_lock(&pool.lock);
+	for (;;) {
+	    if (pool.delivered < pool.num) {
+
+		/*
+		 * deliver the next record once it is parsed
+		 */
+		slot = pool.delivered % pool.window;
+		if (pool.done[slot] == true) {
+		    rec = pool.ring[slot];
+		    (void) pthread_mutex_unlock(&pool.lock);
+		    if (rec.is_valid == false) {
+			valid = false;
+
+			/*
+			 * report the syntax errors of the record in input order
+			 *
+			 * Worker threads parse quietly so that their messages
+			 * are not interleaved: an invalid record is parsed
+			 * again on this thread to report them.
+			 */
+			if (more == true) {
+			    again = rec;
+			    json_lines_parse(&pool, &again, false);
+			}
+		    }
+		    if (more == true && callback != NULL) {
+			more = (*callback)(&rec, ctx);
+		    }
+		    (void) pthread_mutex_lock(&pool.lock);
+
+		    /* hand the parse tree back to the worker thread that formed it */
+		    if (rec.tree != NULL) {
+			(void) dyn_array_append_value(pool.worker[pool.owner[slot]].garbage, &rec.tree);
+			rec.tree = NULL;
+		    }
+		    ++pool.delivered;
+		    if (more == false) {
+			pool.stop = true;
+		    }
+
+		    /* wake the worker threads once there is room for another batch */
+		    if (pool.delivered % JSON_LINES_BATCH == 0 || pool.stop == true) {
+			(void) pthread_cond_broadcast(&pool.space);
+		    }
+		    continue;
+		}
+
+	    /*
+	     * all records delivered: done when no more records will be split
+	     */
+	    } else if (pool.stop == true || pool.pos >= pool.len) {
+		break;
+	    }
+	    (void) pthread_cond_wait(&pool.ready, &pool.lock);
+	}
+	pool.stop = true;
+	(void) pthread_cond_broadcast(&pool.space);
+	(void) pthread_mutex_unlock(&pool.lock);
+
+	/*
+	 * wait for the worker threads to finish
+	 */
+	for (i=0; i < workers; ++i) {
+	    (void) pthread_join(pool.worker[i].thread, NULL);
+	}
+    }
+
+    /*
+     * free the worker thread pool and any parse trees the worker threads left
+     */
+    if (threads > 1) {
+	for (i=0; i < threads; ++i) {
+	    json_lines_free_trees(pool.worker[i].garbage);
+	    dyn_array_free(pool.worker[i].garbage);
+	    pool.worker[i].garbage = NULL;
+	    dyn_array_free(pool.worker[i].spare);
+	    pool.worker[i].spare = NULL;
+	}
+	(void) pthread_cond_destroy(&pool.space);
+	(void) pthread_cond_destroy(&pool.ready);
+	(void) pthread_mutex_destroy(&pool.lock);
+	free(pool.worker);
+	pool.worker = NULL;
+	free(pool.owner);
+	pool.owner = NULL;
+	free(pool.done);
+	pool.done = NULL;
+	free(pool.ring);
+	pool.ring = NULL;
+    }
+    json_dbg(JSON_DBG_MED, __func__, "parsed %ju records from %s: %s",
+	     pool.num, filename, valid ? "all valid" : "not all valid");
+    return valid && more;
+}
+
+
+/*
+ * parse_json_lines_file - parse each record of a JSON Lines or JSON text sequence file
+ *
+ * This is like parse_json_lines() for a named file.
+ *
+ * given:
+ *	name		filename of file to parse, "-" ==> stdin
+ *	threads		number of worker threads, 0 ==> one per online CPU
+ *	form_tree	true ==> form a parse tree for each valid record,
+ *			false ==> only validate each record with the event parser
+ *	callback	function to call for each record, or NULL
+ *	ctx		context passed to callback
+ *
+ * returns:
+ *	true ==> every record was valid JSON,
+ *	false ==> a record was not valid JSON, the file could not be read,
+ *		  or callback returned false
+ */
+bool
+parse_json_lines_file(char const *name, unsigned int threads, bool form_tree,
+		      bool (*callback)(struct json_line *, void *), void *ctx)
+{
+    FILE *stream = NULL;	/* open file stream */
+    char *data = NULL;		/* contents of the file */
+    size_t len = 0;		/* length of data */
+    bool mapped = false;	/* true ==> data was mapped into memory */
+    bool valid = false;		/* true ==> every record was valid JSON */
+
+    /*
+     * firewall
+     */
+    if (name == NULL) {
+	warn(__func__, "name is NULL");
+	return false;
+    }
+
+    /*
+     * open the file, unless it is stdin
+     */
+    if (strcmp(name, "-") == 0) {
+	stream = stdin;
+    } else {
+	errno = 0;		/* pre-clear errno for warnp() */
+	stream = fopen(name, "r");
+	if (stream == NULL) {
+	    warnp(__func__, "couldn't open file %s", name);
+	    return false;
+	}
+    }
+
+    /*
+     * read the file
+     */
+    data = json_read_all(stream, &len, &mapped);
+    clearerr_or_fclose(stream);
+    if (data == NULL) {
+	warn(__func__, "couldn't read file %s", name);
+	return false;
+    }
+
+    /*
+     * parse the records of the file
+     */
+    valid = parse_json_lines(data, len, name, threads, form_tree, callback, ctx);
+    json_free_all(data, len, mapped);
+    return valid;
+}
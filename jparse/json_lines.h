@@ -0,0 +1,74 @@
+/*
+ * json_lines - parse JSON Lines and RFC 7464 JSON text sequences
+ *
+ * "Because one JSON text per file was never going to be enough." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_LINES_H)
+#    define  INCLUDE_JSON_LINES_H
+
+
+#include <stdio.h>
+
+/*
+ * util - entry common utility functions for the IOCCC toolkit
+ */
+#include "util.h"
+
+/*
+ * json_parse - JSON parser support code
+ */
+#include "json_parse.h"
+
+
+/*
+ * definitions
+ */
+#define JSON_LINES_RS (0x1e)		/* RFC 7464 record separator (ASCII RS) */
+#define JSON_LINES_BATCH (64)		/* records a worker thread parses at a time */
+#define JSON_LINES_WINDOW (4)		/* batches per worker thread that may be parsed ahead of delivery */
+#define JSON_LINES_MAX_THREADS (256)	/* most worker threads used to parse records */
+
+
+/*
+ * json_line - a record of JSON Lines or of an RFC 7464 JSON text sequence
+ *
+ * Records are passed to the callback of parse_json_lines() in input order.
+ * When a parse tree was formed for the record, the tree is freed after the
+ * callback returns, unless the callback keeps the tree by setting tree to NULL.
+ */
+struct json_line
+{
+    uintmax_t num;		/* record number (1 ==> first record) */
+    uintmax_t line;		/* line number on which the record starts */
+    char const *ptr;		/* text of the record, NOT NUL terminated */
+    size_t len;			/* length of the text of the record */
+    bool is_valid;		/* true ==> record is valid JSON */
+    struct json *tree;		/* JSON parse tree of a valid record or NULL */
+};
+
+
+/*
+ * function prototypes
+ */
+extern bool parse_json_lines(char const *ptr, size_t len, char const *filename, unsigned int threads, bool form_tree,
+			     bool (*callback)(struct json_line *, void *), void *ctx);
+extern bool parse_json_lines_file(char const *name, unsigned int threads, bool form_tree,
+				  bool (*callback)(struct json_line *, void *), void *ctx);
+
+
+#endif /* INCLUDE_JSON_LINES_H */
@@ -29,7 +29,11 @@
 #include <limits.h>
 #include <inttypes.h>
 #include <math.h>
+#include <float.h>
 #include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /*
  * dbg - info, debug, warning, error, and usage message facility
@@ -52,6 +56,12 @@
 #include "json_util.h"
 
 
+/*
+ * global variables
+ */
+_Thread_local struct json_parse_ctx *json_parse_current = NULL;	/* context of the current parse or NULL */
+
+
 /*
  * JSON encoding of an octet in a JSON string
  *
@@ -158,9 +168,55 @@ struct encode jenc[JSON_BYTE_VALUES] = {
 };
 
 
+/*
+ * JSON number conversion without strtold(3) and friends
+ *
+ * A JSON number with no more than JSON_MANT_DIGITS significant digits, and
+ * whose decimal exponent is small enough that the power of 10 is exactly
+ * representable, is converted with a single multiply or divide.  All other
+ * JSON numbers are converted by the C library.
+ */
+#define JSON_MANT_DIGITS (19)		/* decimal digits that always fit into a uint64_t */
+#define JSON_MAX_EXP10 (99999)		/* decimal exponents beyond this are left to the C library */
+#define JSON_FLT_POW10_MAX (10)		/* largest power of 10 exactly representable as a float */
+#define JSON_DBL_POW10_MAX (22)		/* largest power of 10 exactly representable as a double */
+#if LDBL_MANT_DIG == 64 || LDBL_MANT_DIG == 113
+#define JSON_LDBL_POW10_MAX (27)	/* largest power of 10 exactly representable as a long double */
+#define JSON_LDBL_MANT_MAX (UINT64_MAX)	/* largest mantissa exactly representable as a long double */
+#elif LDBL_MANT_DIG == DBL_MANT_DIG
+#define JSON_LDBL_POW10_MAX (JSON_DBL_POW10_MAX)
+#define JSON_LDBL_MANT_MAX ((uint64_t)1 << DBL_MANT_DIG)
+#endif
+static long double const json_pow10[] = {
+    1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L,
+    1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+    1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+};
+
+
 /* for json number strings */
+static bool json_digits(char const *str, size_t len, bool *neg, uint64_t *mant, int *exp10);
+static long double json_strtold(char const *str, size_t len, char **endptr);
+static double json_strtod(char const *str, size_t len, char **endptr);
+static float json_strtof(char const *str, size_t len, char **endptr);
+static uintmax_t json_strtoumax(char const *str, size_t len, char **endptr);
+static intmax_t json_strtoimax(char const *str, size_t len, char **endptr);
 static bool json_process_decimal(struct json_number *item, char const *str, size_t len);
 static bool json_process_floating(struct json_number *item, char const *str, size_t len);
+/* for JSON parse tree storage */
+static size_t json_decode_run(char const *ptr, size_t len);
+static bool json_utf8_byte(uint8_t byte, int *need, uint8_t *lo, uint8_t *hi);
+static char *json_decode_alloc(char const *ptr, size_t len, size_t *retlen, bool *has_nul, bool *utf8,
+			       struct json_arena *arena);
+static void json_decode_release(char *str, struct json_arena *arena);
+static bool json_decode_same(char const *ptr, size_t len, bool *has_nul, bool *utf8);
+static void *json_tree_calloc(size_t size);
+static struct dyn_array *json_set_create(void);
+static void json_member_intern(struct json_string *item, uint32_t hash, bool in_arena);
+static void json_set_append(struct json *node, struct dyn_array *s, struct json *value);
+/* for the context of the current parse */
+static struct json_arena *json_parse_ctx_arena(void);
+static struct json_intern *json_parse_ctx_names(void);
 
 
 /*
@@ -200,53 +256,111 @@ char *
 json_encode(char const *ptr, size_t len, size_t *retlen, bool skip_quote)
 {
     char *ret = NULL;	    /* allocated encoding string or NULL */
-    char *beyond = NULL;    /* beyond the end of the allocated encoding string */
-    ssize_t mlen = 0;	    /* length of allocated encoded string */
-    char *p;		    /* next place to encode */
-    size_t i;
+    size_t bufsize = 0;	    /* allocated size of ret */
 
     /*
-     * firewall
+     * encode into a new buffer
      */
-    if (ptr == NULL) {
-	/* error - clear allocated length */
-	if (retlen != NULL) {
-	    *retlen = 0;
+    return json_encode_buf(ptr, len, &ret, &bufsize, retlen, skip_quote);
+}
+
+
+/*
+ * json_encode_run - return the length of a run of bytes that JSON encode to themselves
+ *
+ * A run ends at the first byte < 0x20, ", \ or 0x7f: the bytes that jenc[]
+ * encodes as a \-escape.  All other bytes may be copied in bulk.
+ *
+ * given:
+ *	ptr	start of memory block to scan
+ *	len	length of block to scan in bytes
+ *
+ * returns:
+ *	number of bytes at the start of ptr that JSON encode to themselves
+ */
+size_t
+json_encode_run(char const *ptr, size_t len)
+{
+    uint8_t const *p = (uint8_t const *)ptr;	/* next byte to examine */
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i const quote = _mm_set1_epi8('"');
+    __m128i const backslash = _mm_set1_epi8('\\');
+    __m128i const del = _mm_set1_epi8(0x7f);
+    __m128i const ctrl = _mm_set1_epi8(0x1f);
+    __m128i x;		/* 16 bytes to examine */
+    int stop;		/* bit mask of bytes that end the run */
+
+    /*
+     * examine 16 bytes at a time
+     */
+    for (; i+16 <= len; i += 16) {
+	x = _mm_loadu_si128((__m128i const *)(p + i));
+	stop = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+					      _mm_or_si128(_mm_cmpeq_epi8(x, del),
+							   _mm_cmpeq_epi8(_mm_min_epu8(x, ctrl), x))));
+	if (stop != 0) {
+	    return i + (size_t)__builtin_ctz((unsigned int)stop);
 	}
-	warn(__func__, "called with NULL ptr");
-	return NULL;
     }
+#endif
 
     /*
-     * count the bytes that will be in the encoded allocated string
+     * examine the remaining bytes one at a time
      */
-    for (i=0; i < len; ++i) {
-	mlen += jenc[(uint8_t)(ptr[i])].len;
-    }
-    if (mlen < 0) { /* paranoia */
-	/* error - clear allocated length */
-	if (retlen != NULL) {
-	    *retlen = 0;
+    for (; i < len; ++i) {
+	if (jenc[p[i]].len != 1) {
+	    break;
 	}
-	warn(__func__, "mlen #0: %ju < 0", (uintmax_t)mlen);
-	return NULL;
     }
+    return i;
+}
+
+
+/*
+ * json_encode_buf - JSON encode a block of memory into a reusable buffer
+ *
+ * The buffer *buf, of *bufsize bytes, is enlarged with realloc() when the
+ * encoding does not fit, so the same buffer may be used to encode any number
+ * of blocks without allocating memory for each one.  Runs of bytes that JSON
+ * encode to themselves are copied in bulk.
+ *
+ * given:
+ *	ptr		start of memory block to encode
+ *	len		length of block to encode in bytes
+ *	buf		pointer to malloced buffer or pointer to NULL
+ *	bufsize		pointer to allocated size of *buf (0 if *buf is NULL)
+ *	retlen		address of where to store encoded length, if retlen != NULL
+ *	skip_quote	true ==> ignore any double quotes if they are both
+ *				 at the start and end of the memory block
+ *			false ==> process all bytes in the block
+ *
+ * returns:
+ *	*buf holding the NUL terminated JSON encoding of the block, or NULL ==> error
+ *	NOTE: retlen, if non-NULL, is set to 0 on error
+ *
+ * NOTE: The caller must free(*buf) when done with the buffer, even on error.
+ */
+char *
+json_encode_buf(char const *ptr, size_t len, char **buf, size_t *bufsize, size_t *retlen, bool skip_quote)
+{
+    char *p = NULL;	    /* next place to encode */
+    char *newbuf = NULL;    /* reallocated buffer */
+    size_t mlen = 0;	    /* length of encoded string */
+    size_t run = 0;	    /* length of a run of bytes that encode to themselves */
+    uint8_t c = 0;	    /* byte to encode */
+    size_t i;
 
     /*
-     * malloc the encoded string
+     * firewall
      */
-    ret = malloc((size_t)mlen + 1 + 1);
-    if (ret == NULL) {
-	/* error - clear allocated length */
-	if (retlen != NULL) {
-	    *retlen = 0;
-	}
-	warn(__func__, "malloc of %ju bytes failed", (uintmax_t)(mlen + 1 + 1));
+    if (retlen != NULL) {
+	*retlen = 0;	    /* until we know better */
+    }
+    if (ptr == NULL || buf == NULL || bufsize == NULL) {
+	warn(__func__, "called with NULL arg(s)");
 	return NULL;
     }
-    ret[mlen] = '\0';   /* terminate string */
-    ret[mlen + 1] = '\0';   /* paranoia */
-    beyond = &(ret[mlen]);
 
     /*
      * skip any enclosing quotes if requested
@@ -256,51 +370,62 @@ json_encode(char const *ptr, size_t len, size_t *retlen, bool skip_quote)
      * a '"'.
      */
     if (skip_quote == true && len > 1 && ptr[0] == '"' && ptr[len-1] == '"') {
-	i = 1;	/* start encoding on the next byte beyond the " */
-	--len;	/* do not encode the last byte */
-    } else {
-	i = 0;	/* start encoding at the first byte */
+	++ptr;	/* start encoding on the next byte beyond the " */
+	len -= 2; /* do not encode the last byte */
     }
 
     /*
-     * JSON encode each byte
+     * count the bytes that will be in the encoded string
      */
-    for (p=ret; i < len; ++i) {
-	if (p+jenc[(uint8_t)(ptr[i])].len > beyond) {
-	    /* error - clear allocated length */
-	    if (retlen != NULL) {
-		*retlen = 0;
-	    }
-	    if (ret != NULL) {
-		free(ret);
-		ret = NULL;
-	    }
-	    warn(__func__, "encoding ran beyond end of allocated encoded string");
+    for (i=0; i < len; ++i) {
+	run = json_encode_run(ptr+i, len-i);
+	mlen += run;
+	i += run;
+	if (i < len) {
+	    mlen += jenc[(uint8_t)(ptr[i])].len;
+	}
+    }
+
+    /*
+     * enlarge the buffer if needed
+     */
+    if (*buf == NULL || *bufsize < mlen + 1 + 1) {
+	errno = 0;		/* pre-clear errno for warnp() */
+	newbuf = realloc(*buf, mlen + 1 + 1);
+	if (newbuf == NULL) {
+	    warnp(__func__, "realloc of %ju bytes failed", (uintmax_t)(mlen + 1 + 1));
 	    return NULL;
 	}
-	strcpy(p, jenc[(uint8_t)(ptr[i])].enc);
-	p += jenc[(uint8_t)(ptr[i])].len;
+	*buf = newbuf;
+	*bufsize = mlen + 1 + 1;
     }
-    *p = '\0';	/* paranoia */
-    mlen = p - ret; /* paranoia */
-    if (mlen < 0) { /* paranoia */
-	warn(__func__, "mlen #1: %ju < 0", (uintmax_t)mlen);
-	if (ret != NULL) {
-	    free(ret);
-	    ret = NULL;
+
+    /*
+     * JSON encode each run and each byte that needs a \-escape
+     */
+    for (i=0, p=*buf; i < len; ++i) {
+	run = json_encode_run(ptr+i, len-i);
+	memcpy(p, ptr+i, run);
+	p += run;
+	i += run;
+	if (i < len) {
+	    c = (uint8_t)(ptr[i]);
+	    memcpy(p, jenc[c].enc, jenc[c].len);
+	    p += jenc[c].len;
 	}
-	return NULL;
     }
+    p[0] = '\0';	/* terminate string */
+    p[1] = '\0';	/* paranoia */
 
     /*
      * return result
      */
-    dbg(DBG_VVVHIGH, "returning from json_encode(ptr, %ju, *%ju, %s)",
+    dbg(DBG_VVVHIGH, "returning from json_encode_buf(ptr, %ju, *%ju, %s)",
 		     (uintmax_t)len, (uintmax_t)mlen, booltostr(skip_quote));
     if (retlen != NULL) {
-	*retlen = (size_t)mlen;
+	*retlen = mlen;
     }
-    return ret;
+    return *buf;
 }
 
 
@@ -783,34 +908,163 @@ jencchk(void)
 
 
 /*
- * json_decode - return the decoding of a JSON encoded block of memory
+ * json_decode_run - return the length of a run of bytes that decode to themselves
+ *
+ * A run ends at the first \, ", byte < 0x20 or byte >= 0x80.  Such bytes need
+ * a closer look by json_decode_alloc() but all other bytes may be copied in bulk.
+ *
+ * given:
+ *	ptr	start of memory block to scan
+ *	len	length of block to scan in bytes
+ *
+ * returns:
+ *	number of bytes at the start of ptr that decode to themselves
+ */
+static size_t
+json_decode_run(char const *ptr, size_t len)
+{
+    uint8_t const *p = (uint8_t const *)ptr;	/* next byte to examine */
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i const quote = _mm_set1_epi8('"');
+    __m128i const backslash = _mm_set1_epi8('\\');
+    __m128i const ctrl = _mm_set1_epi8(0x1f);
+    __m128i x;		/* 16 bytes to examine */
+    int stop;		/* bit mask of bytes that end the run */
+
+    /*
+     * examine 16 bytes at a time
+     */
+    for (; i+16 <= len; i += 16) {
+	x = _mm_loadu_si128((__m128i const *)(p + i));
+	stop = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+					      _mm_cmpeq_epi8(_mm_min_epu8(x, ctrl), x))) |
+	       _mm_movemask_epi8(x);
+	if (stop != 0) {
+	    return i + (size_t)__builtin_ctz((unsigned int)stop);
+	}
+    }
+#endif
+
+    /*
+     * examine the remaining bytes one at a time
+     */
+    for (; i < len; ++i) {
+	if (p[i] < 0x20 || p[i] >= 0x80 || p[i] == '"' || p[i] == '\\') {
+	    break;
+	}
+    }
+    return i;
+}
+
+
+/*
+ * json_utf8_byte - check the next byte of decoded output for UTF-8 validity
+ *
+ * given:
+ *	byte	next non-ASCII byte of decoded output
+ *	need	number of continuation bytes still needed by the current UTF-8 sequence
+ *	lo	lowest allowed value of the next continuation byte
+ *	hi	highest allowed value of the next continuation byte
+ *
+ * returns:
+ *	true ==> byte continues or starts a valid UTF-8 sequence, false ==> invalid UTF-8
+ *
+ * NOTE: Overlong encodings, UTF-16 surrogates and values beyond U+10FFFF are
+ *	 not valid UTF-8.  On return *need, *lo and *hi are ready for the next byte.
+ */
+static bool
+json_utf8_byte(uint8_t byte, int *need, uint8_t *lo, uint8_t *hi)
+{
+    /*
+     * case: continuation byte of a UTF-8 sequence
+     */
+    if (*need > 0) {
+	if (byte < *lo || byte > *hi) {
+	    *need = 0;
+	    return false;
+	}
+	--*need;
+	*lo = 0x80;
+	*hi = 0xbf;
+	return true;
+    }
+
+    /*
+     * case: first byte of a UTF-8 sequence
+     */
+    *lo = 0x80;
+    *hi = 0xbf;
+    if (byte >= 0xc2 && byte <= 0xdf) {
+	*need = 1;
+    } else if (byte >= 0xe0 && byte <= 0xef) {
+	*need = 2;
+	if (byte == 0xe0) {
+	    *lo = 0xa0;		/* no overlong 3 byte forms */
+	} else if (byte == 0xed) {
+	    *hi = 0x9f;		/* no UTF-16 surrogates */
+	}
+    } else if (byte >= 0xf0 && byte <= 0xf4) {
+	*need = 3;
+	if (byte == 0xf0) {
+	    *lo = 0x90;		/* no overlong 4 byte forms */
+	} else if (byte == 0xf4) {
+	    *hi = 0x8f;		/* nothing beyond U+10FFFF */
+	}
+    } else {
+	return false;
+    }
+    return true;
+}
+
+
+/*
+ * json_decode_alloc - decode a JSON encoded block of memory into malloced or arena memory
+ *
+ * The JSON encoded block is decoded in a single pass: runs of bytes that decode
+ * to themselves are copied in bulk and only \-escapes and the bytes that end a
+ * run are examined one at a time.  As a decoded string is never longer than the
+ * JSON encoded block, len + 2 bytes are allocated up front.
+ *
+ * A \u00xx escape decodes to the single byte xx.  Any other \uxxxx escape
+ * decodes to the UTF-8 encoding of the code point, with a \uxxxx\uxxxx UTF-16
+ * surrogate pair decoding to a single code point.  A lone surrogate decodes as
+ * if it were a code point but makes the result invalid UTF-8.  As a UTF-8
+ * sequence may be written as \u00xx escapes of its bytes, "\u00c3\u00a9" is
+ * as valid UTF-8 as "\xc3\xa9" is.
  *
  * given:
  *	ptr	start of memory block to decode
  *	len	length of block to decode in bytes
  *	retlen	address of where to store allocated length, if retlen != NULL
  *	has_nul	if != NULL and we find an encoded NUL byte we will do *has_nul = true
+ *	utf8	if != NULL, *utf8 = true ==> decoded string is valid UTF-8, else false
+ *	arena	!= NULL ==> allocate the decoded string from arena, NULL ==> malloc
  *
  * returns:
  *	allocated JSON decoding of a block, or NULL ==> error
  *	NOTE: retlen, if non-NULL, is set to 0 on error
  */
-char *
-json_decode(char const *ptr, size_t len, size_t *retlen, bool *has_nul)
+static char *
+json_decode_alloc(char const *ptr, size_t len, size_t *retlen, bool *has_nul, bool *utf8,
+		  struct json_arena *arena)
 {
-    char *ret = NULL;	    /* allocated encoding string or NULL */
-    char *beyond = NULL;    /* beyond the end of the allocated encoding string */
-    size_t mlen = 0;	    /* length of allocated encoded string */
-    char *p = NULL;	    /* next place to encode */
+    char *ret = NULL;	    /* allocated decoding string or NULL */
+    size_t mlen = 0;	    /* length of decoded string */
+    char *p = NULL;	    /* next place to decode */
+    size_t run = 0;	    /* length of a run of bytes that decode to themselves */
+    uint8_t c = 0;	    /* byte to decode */
     char n = 0;		    /* next character beyond a \\ */
-    char a = 0;		    /* first hex character after \u */
     int xa = 0;		    /* first hex character numeric value */
-    char b = 0;		    /* second hex character after \u */
     int xb = 0;		    /* second hex character numeric value */
-    char c = 0;		    /* character to decode or third hex character after \u */
-    int xc = 0;		    /* 3nd hex character numeric value */
-    char d = 0;		    /* fourth hex character after \u */
+    int xc = 0;		    /* third hex character numeric value */
     int xd = 0;		    /* fourth hex character numeric value */
+    uint32_t code = 0;	    /* code point of \uxxxx */
+    uint32_t low = 0;	    /* low surrogate of a \uxxxx\uxxxx pair */
+    bool valid_utf8 = true; /* true ==> decoded string is valid UTF-8 so far */
+    int need = 0;	    /* UTF-8 continuation bytes still needed */
+    uint8_t lo = 0x80;	    /* lowest allowed next UTF-8 continuation byte */
+    uint8_t hi = 0xbf;	    /* highest allowed next UTF-8 continuation byte */
     size_t i;
 
     /*
@@ -826,19 +1080,71 @@ json_decode(char const *ptr, size_t len, size_t *retlen, bool *has_nul)
     }
 
     /*
-     * count the bytes that will be in the decoded allocated string
+     * allocate decoded string
      */
-    for (i=0; i < len; ++i) {
+    if (arena != NULL) {
+	ret = json_arena_alloc(arena, len + 1 + 1);
+    } else {
+	ret = malloc(len + 1 + 1);
+    }
+    if (ret == NULL) {
+	/* error - clear allocated length */
+	if (retlen != NULL) {
+	    *retlen = 0;
+	}
+	warn(__func__, "malloc of %ju bytes failed", (uintmax_t)(len + 1 + 1));
+	return NULL;
+    }
+
+    /*
+     * JSON string decode
+     */
+    for (i=0, p=ret; i < len; ++i) {
+
+	/*
+	 * copy a run of bytes that decode to themselves
+	 */
+	run = json_decode_run(ptr+i, len-i);
+	if (run > 0) {
+	    if (need > 0) {
+		/* ASCII inside a UTF-8 sequence */
+		valid_utf8 = false;
+		need = 0;
+	    }
+	    memcpy(p, ptr+i, run);
+	    p += run;
+	    i += run;
+	    if (i >= len) {
+		break;
+	    }
+	}
+
+	/*
+	 * examine the byte that ended the run
+	 */
+	c = (uint8_t)ptr[i];
 
 	/*
-	 * examine the current character
+	 * case: non-ASCII byte
 	 */
-	c = (char)((uint8_t)(ptr[i]));
+	if (c >= 0x80) {
+	    if (json_utf8_byte(c, &need, &lo, &hi) == false) {
+		valid_utf8 = false;
+	    }
+	    *p++ = (char)c;
+	    continue;
+	}
 
 	/*
-	 * valid non-\-escaped characters count as 1
+	 * case: byte that is not a \-escape
 	 */
-        if (c != '\\') {
+	if (c != '\\') {
+
+	    if (need > 0) {
+		/* ASCII inside a UTF-8 sequence */
+		valid_utf8 = false;
+		need = 0;
+	    }
 
 	    /*
 	     * disallow characters that should have been escaped
@@ -853,315 +1159,367 @@ json_decode(char const *ptr, size_t len, size_t *retlen, bool *has_nul)
 		if (retlen != NULL) {
 		    *retlen = 0;
 		}
-		warn(__func__, "found non-\\-escaped char: 0x%02x", (uint8_t)c);
+		warn(__func__, "found non-\\-escaped char: 0x%02x", c);
+		json_decode_release(ret, arena);
 		return NULL;
 		break;
-	    case '"':   /*fallthrough*/
-	    case '\\':
+	    case '"':
 		/* error - clear allocated length */
 		if (retlen != NULL) {
 		    *retlen = 0;
 		}
 		warn(__func__, "found \\-escaped char: %c", c);
+		json_decode_release(ret, arena);
 		return NULL;
 		break;
 
 	    /*
-	     * count a valid character
+	     * copy other control characters as is
 	     */
 	    default:
-		++mlen;
+		if (c == '\0' && has_nul != NULL) {
+		    *has_nul = true; /* record NUL byte */
+		}
+		*p++ = (char)c;
 		break;
 	    }
+	    continue;
+	}
 
 	/*
-	 * valid \-escaped characters count as 2 or 6
+	 * there must be at least one more character beyond \
 	 */
-	} else {
+	if (i+1 >= len) {
+	    /* error - clear allocated length */
+	    if (retlen != NULL) {
+		*retlen = 0;
+	    }
+	    warn(__func__, "found \\ at end of buffer, missing next character");
+	    json_decode_release(ret, arena);
+	    return NULL;
+	}
+
+	/*
+	 * look at the next character beyond \
+	 */
+	n = ptr[i+1];
+
+	/*
+	 * only a \u00xx escape may go on with a UTF-8 sequence, as any other
+	 * \c escape decodes to ASCII
+	 */
+	if (need > 0 && n != 'u') {
+	    /* ASCII inside a UTF-8 sequence */
+	    valid_utf8 = false;
+	    need = 0;
+	}
+
+	/*
+	 * decode single \c escaped pairs
+	 */
+	switch (n) {
+	case 'b':	/* ASCII backspace */
+	    ++i;
+	    *p++ = '\b';
+	    break;
+	case 't':	/* ASCII horizontal tab */
+	    ++i;
+	    *p++ = '\t';
+	    break;
+	case 'n':	/* ASCII line feed */
+	    ++i;
+	    *p++ = '\n';
+	    break;
+	case 'f':	/* ASCII form feed */
+	    ++i;
+	    *p++ = '\f';
+	    break;
+	case 'r':	/* ASCII carriage return */
+	    ++i;
+	    *p++ = '\r';
+	    break;
+	case '"':	/*fallthrough*/
+	case '/':	/*fallthrough*/
+	case '\\':
+	    ++i;
+	    *p++ = n;	/* escape decodes to itself */
+	    break;
+
+	/*
+	 * decode \uxxxx
+	 */
+	case 'u':
 
 	    /*
-	     * there must be at least one more character beyond \
+	     * there must be at least five more characters beyond \
 	     */
-	    if (i+1 >= len) {
+	    if (i+5 >= len) {
 		/* error - clear allocated length */
 		if (retlen != NULL) {
 		    *retlen = 0;
 		}
-		warn(__func__, "found \\ at end of buffer, missing next character");
+		warn(__func__, "found \\u, but not enough for 4 hex chars at end of buffer");
+		json_decode_release(ret, arena);
 		return NULL;
 	    }
+	    xa = hexval[(uint8_t)(ptr[i+2])];
+	    xb = hexval[(uint8_t)(ptr[i+3])];
+	    xc = hexval[(uint8_t)(ptr[i+4])];
+	    xd = hexval[(uint8_t)(ptr[i+5])];
 
 	    /*
-	     * look at the next character beyond \
-	     */
-	    n = (char)((uint8_t)(ptr[i+1]));
-
-	    /*
-	     * process single \c escaped pairs
+	     * the next 4 characters beyond \u must be hex characters
 	     */
-	    switch (n) {
-	    case 'b':	/*fallthrough*/
-	    case 't':	/*fallthrough*/
-	    case 'n':	/*fallthrough*/
-	    case 'f':	/*fallthrough*/
-	    case 'r':	/*fallthrough*/
-	    case '"':	/*fallthrough*/
-	    case '/':	/*fallthrough*/
-	    case '\\':
-		/*
-		 * count \c escaped pair as 1 character
-		 */
-		++mlen;
-		++i;
-		break;
+	    if (!isxdigit(ptr[i+2]) || !isxdigit(ptr[i+3]) || !isxdigit(ptr[i+4]) || !isxdigit(ptr[i+5])) {
+		/* error - clear allocated length */
+		if (retlen != NULL) {
+		    *retlen = 0;
+		}
+		warn(__func__, "\\u, not followed by 4 hex chars");
+		json_decode_release(ret, arena);
+		return NULL;
+	    }
+	    i += 5;
+	    code = (uint32_t)((xa << 12) | (xb << 8) | (xc << 4) | xd);
 
 	    /*
-	     * process \uxxxx where x is a hex character
+	     * case: \u00xx is the single byte xx
 	     */
-	    case 'u':
-
-		/*
-		 * there must be at least five more characters beyond \
-		 */
-		if (i+5 >= len) {
-		    /* error - clear allocated length */
-		    if (retlen != NULL) {
-			*retlen = 0;
-		    }
-		    warn(__func__, "found \\u, but not enough for 4 hex chars at end of buffer");
-		    return NULL;
+	    if (code < 0x100) {
+		if (code == 0 && has_nul != NULL) {
+		    *has_nul = true; /* record NUL byte */
 		}
-		a = (char)((uint8_t)(ptr[i+2]));
-		b = (char)((uint8_t)(ptr[i+3]));
-		c = (char)((uint8_t)(ptr[i+4]));
-		d = (char)((uint8_t)(ptr[i+5]));
-
-		/*
-		 * the next 4 characters beyond \u must be hex characters
-		 */
-		if (isxdigit(a) && isxdigit(b) && isxdigit(c) && isxdigit(d)) {
-
-		    /*
-		     * case: \u00xx is 1 character
-		     */
-		    if (a == '0' && b == '0') {
-			++mlen;
-			i += 5;
-
-			if (c == '0' && d == '0' && has_nul != NULL) {
-			    *has_nul = true; /* set has_nul to true */
-			}
-		    /*
-		     * case: count \uxxxx as 2 characters
-		     */
-		    } else {
-			mlen += 2;
-			i += 5;
+		if (code >= 0x80) {
+		    /* a byte of a UTF-8 sequence may be written as a \u00xx escape */
+		    if (json_utf8_byte((uint8_t)code, &need, &lo, &hi) == false) {
+			valid_utf8 = false;
 		    }
-		    break;
-
-		/*
-		 * case: \uxxxx is invalid because xxxx is not HEX
-		 */
-		} else {
-			warn(__func__, "\\u, not followed by 4 hex chars");
-			return NULL;
+		} else if (need > 0) {
+		    /* ASCII inside a UTF-8 sequence */
+		    valid_utf8 = false;
+		    need = 0;
 		}
+		*p++ = (char)code;
 		break;
+	    }
+	    if (need > 0) {
+		/* a whole code point inside a UTF-8 sequence */
+		valid_utf8 = false;
+		need = 0;
+	    }
 
 	    /*
-	     * found invalid JSON \-escape character
+	     * case: \uxxxx\uxxxx UTF-16 surrogate pair
 	     */
-	    default:
-		/* error - clear allocated length */
-		if (retlen != NULL) {
-		    *retlen = 0;
+	    if (code >= 0xd800 && code <= 0xdbff && i+6 < len && ptr[i+1] == '\\' && ptr[i+2] == 'u' &&
+		isxdigit(ptr[i+3]) && isxdigit(ptr[i+4]) && isxdigit(ptr[i+5]) && isxdigit(ptr[i+6])) {
+		low = (uint32_t)((hexval[(uint8_t)(ptr[i+3])] << 12) | (hexval[(uint8_t)(ptr[i+4])] << 8) |
+				 (hexval[(uint8_t)(ptr[i+5])] << 4) | hexval[(uint8_t)(ptr[i+6])]);
+		if (low >= 0xdc00 && low <= 0xdfff) {
+		    i += 6;
+		    code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
 		}
-		warn(__func__, "found invalid JSON \\-escape: followed by 0x%02x", (uint8_t)c);
-		return NULL;
 	    }
-	}
-    }
-
-    /*
-     * allocated decoded string
-     */
-    ret = malloc(mlen + 1 + 1);
-    if (ret == NULL) {
-	/* error - clear allocated length */
-	if (retlen != NULL) {
-	    *retlen = 0;
-	}
-	warn(__func__, "malloc of %ju bytes failed", (uintmax_t)(mlen + 1 + 1));
-	return NULL;
-    }
-    ret[mlen] = '\0';   /* terminate string */
-    ret[mlen + 1] = '\0';   /* paranoia */
-    beyond = &(ret[mlen]);
 
-    /*
-     * JSON string decode
-     *
-     * In the above counting code, prior to the malloc for the decoded string,
-     * we already determined that the JSON encoded block of memory is valid.
-     */
-    for (i=0, p=ret; i < len; ++i) {
+	    /*
+	     * a lone UTF-16 surrogate is not valid UTF-8
+	     */
+	    if (code >= 0xd800 && code <= 0xdfff) {
+		valid_utf8 = false;
+	    }
 
-	/*
-	 * examine the current character
-	 */
-	c = (char)((uint8_t)(ptr[i]));
+	    /*
+	     * UTF-8 encode the code point
+	     */
+	    if (code < 0x800) {
+		*p++ = (char)(0xc0 | (code >> 6));
+		*p++ = (char)(0x80 | (code & 0x3f));
+	    } else if (code < 0x10000) {
+		*p++ = (char)(0xe0 | (code >> 12));
+		*p++ = (char)(0x80 | ((code >> 6) & 0x3f));
+		*p++ = (char)(0x80 | (code & 0x3f));
+	    } else {
+		*p++ = (char)(0xf0 | (code >> 18));
+		*p++ = (char)(0x80 | ((code >> 12) & 0x3f));
+		*p++ = (char)(0x80 | ((code >> 6) & 0x3f));
+		*p++ = (char)(0x80 | (code & 0x3f));
+	    }
+	    break;
 
 	/*
-	 * paranoia
+	 * found invalid JSON \-escape character
 	 */
-	if (p >= beyond) {
+	default:
 	    /* error - clear allocated length */
 	    if (retlen != NULL) {
 		*retlen = 0;
 	    }
-	    warn(__func__, "ran beyond end of decoded string");
+	    warn(__func__, "found invalid JSON \\-escape: followed by 0x%02x", (uint8_t)n);
+	    json_decode_release(ret, arena);
 	    return NULL;
 	}
+    }
+    if (need > 0) {
+	/* truncated UTF-8 sequence */
+	valid_utf8 = false;
+    }
 
-	/*
-	 * case: JSON decode non \-escape character
-	 */
-	if (c != '\\') {
-	    /* no translation encoding */
-	    *p++ = c;
+    /*
+     * terminate the decoded string
+     */
+    mlen = (size_t)(p - ret);
+    ret[mlen] = '\0';	    /* terminate string */
+    ret[mlen + 1] = '\0';   /* paranoia */
 
-	/*
-	 * case: JSON decode \-escape character
-	 */
-	} else {
+    /*
+     * return result
+     */
+    dbg(DBG_VVVHIGH, "returning from json_decode(ptr, %ju, *%ju, %s)",
+		     (uintmax_t)len, (uintmax_t)mlen, has_nul != NULL ? booltostr(*has_nul) : "false");
+    if (retlen != NULL) {
+	*retlen = mlen;
+    }
+    if (utf8 != NULL) {
+	*utf8 = valid_utf8;
+    }
+    return ret;
+}
 
-	    /*
-	     * look at the next character beyond \
-	     */
-	    n = (char)((uint8_t)(ptr[i+1]));
 
-	    /*
-	     * decode single \c escaped pairs
-	     */
-	    switch (n) {
-	    case 'b':	/* ASCII backspace */
-		++i;
-		*p++ = '\b';
-		break;
-	    case 't':	/* ASCII horizontal tab */
-		++i;
-		*p++ = '\t';
-		break;
-	    case 'n':	/* ASCII line feed */
-		++i;
-		*p++ = '\n';
-		break;
-	    case 'f':	/* ASCII form feed */
-		++i;
-		*p++ = '\f';
-		break;
-	    case 'r':	/* ASCII carriage return */
-		++i;
-		*p++ = '\r';
-		break;
-	    case 'a':	/* ASCII bell */
-		++i;
-		*p++ = '\a';
-		break;
-	    case 'v':	/* ASCII vertical tab */
-		++i;
-		*p++ = '\v';
-		break;
-	    case 'e':	/* ASCII escape */
-		++i;
-		*p++ = 0x0b;  /* not all C compilers understand \e */
-		break;
-	    case '"':	/*fallthrough*/
-	    case '/':	/*fallthrough*/
-	    case '\\':
-		++i;
-		*p++ = n;	/* escape decodes to itself */
-		break;
+/*
+ * json_decode_release - release a partially decoded string after an error
+ *
+ * given:
+ *	str	string allocated by json_decode_alloc()
+ *	arena	arena str was allocated from or NULL ==> str was malloced
+ *
+ * NOTE: Arena memory is not released until the arena is reset or freed.
+ */
+static void
+json_decode_release(char *str, struct json_arena *arena)
+{
+    if (str != NULL && arena == NULL) {
+	free(str);
+    }
+    return;
+}
 
-	    /*
-	     * decode \uxxxx
-	     */
-	    case 'u':
-
-		/*
-		 * there must be at least five more characters beyond \
-		 */
-		if (i+5 >= len) {
-		    /* error - clear allocated length */
-		    if (retlen != NULL) {
-			*retlen = 0;
-		    }
-		    warn(__func__, "found \\u while decoding, but not enough for 4 hex chars at end of buffer");
-		    return NULL;
-		}
-		xa = hexval[(uint8_t)(ptr[i+2])];
-		xb = hexval[(uint8_t)(ptr[i+3])];
-		xc = hexval[(uint8_t)(ptr[i+4])];
-		xd = hexval[(uint8_t)(ptr[i+5])];
-
-		/*
-		 * case: \u00xx
-		 */
-		if (xa == 0 && xb == 0) {
-		    /* single byte \u00xx */
-		    i += 5;
-		    *p++ = (char)((xc << 4) | xd);
-
-		    if (xc == 0 && xd == 0 && has_nul != NULL) {
-			*has_nul = true; /* record NUL byte */
-		    }
-		/*
-		 * case: \uxxxx
-		 */
-		} else {
-
-		    /*
-		     * paranoia
-		     */
-		    if (p+1 >= beyond) {
-			/* error - clear allocated length */
-			if (retlen != NULL) {
-			    *retlen = 0;
-			}
-			warn(__func__, "ran beyond end of decoded string for non-UTF-8 \\u encoding");
-			return NULL;
-		    }
-		    /* double byte \uxxxx */
-		    i += 5;
-		    *p++ = (char)((xa << 4) | xb);
-		    *p++ = (char)((xc << 4) | xd);
-		}
-		break;
 
-	    /*
-	     * unknown \c escaped pairs
-	     */
-	    default:
-		/* error - clear allocated length */
-		if (retlen != NULL) {
-		    *retlen = 0;
-		}
-		warn(__func__, "found invalid JSON \\-escape while decoding: followed by 0x%02x", (uint8_t)c);
-		return NULL;
-	    }
-	}
-     }
+/*
+ * json_decode_same - determine if a JSON encoded block of memory decodes to itself
+ *
+ * A block decodes to itself when it has no \-escapes and no byte that
+ * json_decode_alloc() would reject.  Such a block need not be decoded into a
+ * copy: the JSON encoded bytes may be used as the decoded string.
+ *
+ * given:
+ *	ptr	start of memory block to examine
+ *	len	length of block to examine in bytes
+ *	has_nul	if != NULL and we find a NUL byte we will do *has_nul = true
+ *	utf8	if != NULL, *utf8 = true ==> block is valid UTF-8, else false
+ *
+ * returns:
+ *	true ==> block decodes to itself, false ==> block must be decoded by json_decode_alloc()
+ *
+ * NOTE: When false is returned, *has_nul and *utf8 are not to be trusted.
+ */
+static bool
+json_decode_same(char const *ptr, size_t len, bool *has_nul, bool *utf8)
+{
+    bool valid_utf8 = true; /* true ==> block is valid UTF-8 so far */
+    int need = 0;	    /* UTF-8 continuation bytes still needed */
+    uint8_t lo = 0x80;	    /* lowest allowed next UTF-8 continuation byte */
+    uint8_t hi = 0xbf;	    /* highest allowed next UTF-8 continuation byte */
+    uint8_t c = 0;	    /* byte that ended a run */
+    size_t run = 0;	    /* length of a run of bytes that decode to themselves */
+    size_t i;
 
     /*
-     * return result
+     * firewall
      */
-    dbg(DBG_VVVHIGH, "returning from json_decode(ptr, %ju, *%ju, %s)",
-		     (uintmax_t)len, (uintmax_t)mlen, has_nul != NULL ? booltostr(*has_nul) : "false");
-    if (retlen != NULL) {
-	*retlen = mlen;
+    if (ptr == NULL) {
+	return false;
     }
-    return ret;
+
+    /*
+     * examine the bytes that end each run of bytes that decode to themselves
+     */
+    for (i=0; i < len; ++i) {
+	run = json_decode_run(ptr+i, len-i);
+	if (run > 0) {
+	    if (need > 0) {
+		/* ASCII inside a UTF-8 sequence */
+		valid_utf8 = false;
+		need = 0;
+	    }
+	    i += run;
+	    if (i >= len) {
+		break;
+	    }
+	}
+	c = (uint8_t)ptr[i];
+	if (c >= 0x80) {
+	    if (json_utf8_byte(c, &need, &lo, &hi) == false) {
+		valid_utf8 = false;
+	    }
+	    continue;
+	}
+	if (need > 0) {
+	    /* ASCII inside a UTF-8 sequence */
+	    valid_utf8 = false;
+	    need = 0;
+	}
+
+	/*
+	 * \-escapes and characters that should have been escaped need json_decode_alloc()
+	 */
+	switch (c) {
+	case '\\':	/*fallthrough*/
+	case '"':	/*fallthrough*/
+	case '\b':	/*fallthrough*/
+	case '\t':	/*fallthrough*/
+	case '\n':	/*fallthrough*/
+	case '\f':	/*fallthrough*/
+	case '\r':
+	    return false;
+	    break;
+	case '\0':
+	    if (has_nul != NULL) {
+		*has_nul = true; /* record NUL byte */
+	    }
+	    break;
+	default:
+	    break;
+	}
+    }
+    if (need > 0) {
+	/* truncated UTF-8 sequence */
+	valid_utf8 = false;
+    }
+    if (utf8 != NULL) {
+	*utf8 = valid_utf8;
+    }
+    return true;
+}
+
+
+/*
+ * json_decode - return the decoding of a JSON encoded block of memory
+ *
+ * given:
+ *	ptr	start of memory block to decode
+ *	len	length of block to decode in bytes
+ *	retlen	address of where to store allocated length, if retlen != NULL
+ *	has_nul	if != NULL and we find an encoded NUL byte we will do *has_nul = true
+ *
+ * returns:
+ *	allocated JSON decoding of a block, or NULL ==> error
+ *	NOTE: retlen, if non-NULL, is set to 0 on error
+ */
+char *
+json_decode(char const *ptr, size_t len, size_t *retlen, bool *has_nul)
+{
+    return json_decode_alloc(ptr, len, retlen, has_nul, NULL, NULL);
 }
 
 
@@ -1605,7 +1963,7 @@ json_alloc(enum item_type type)
      * allocate the JSON parse tree item
      */
     errno = 0;			/* pre-clear errno for errp() */
-    ret = calloc(1, sizeof(*ret));
+    ret = json_tree_calloc(sizeof(*ret));
     if (ret == NULL) {
 	errp(180, __func__, "calloc #0 error allocating %ju bytes", (uintmax_t)sizeof(*ret));
 	not_reached();
@@ -1615,6 +1973,7 @@ json_alloc(enum item_type type)
      * initialize the JSON parse tree item
      */
     ret->type = type;
+    ret->in_arena = (json_parse_ctx_arena() != NULL);
     ret->parent = NULL;
 
     /*
@@ -1705,6 +2064,7 @@ json_alloc(enum item_type type)
 	    item->converted = false;
 	    item->set = NULL;
 	    item->s = NULL;
+	    item->index = NULL;
 	};
 	break;
     case JTYPE_ARRAY:
@@ -1740,6 +2100,365 @@ json_alloc(enum item_type type)
 }
 
 
+/*
+ * json_digits - split a JSON number string into a decimal mantissa and exponent
+ *
+ * The JSON number string, with length len, is reduced to the value:
+ *
+ *	(*mant) * 10^(*exp10)
+ *
+ * where *mant has at most JSON_MANT_DIGITS significant decimal digits.
+ * Zero digits that do not fit into *mant are folded into *exp10.
+ *
+ * given:
+ *	str	JSON number string, need not be NUL terminated
+ *	len	length of the JSON number string
+ *	neg	where to store true if the JSON number string starts with -
+ *	mant	where to store the decimal mantissa
+ *	exp10	where to store the decimal exponent
+ *
+ * returns:
+ *	true ==> *mant * 10^(*exp10) is exactly the value of the JSON number string
+ *	false ==> too many non-zero digits, the exponent is too large or the
+ *		  string is not a JSON number
+ *
+ * NOTE: This function does not use the locale: only the '.' is a decimal point.
+ */
+static bool
+json_digits(char const *str, size_t len, bool *neg, uint64_t *mant, int *exp10)
+{
+    char const *p = str;	/* next character to scan */
+    char const *end = str+len;	/* end of the JSON number string */
+    uint64_t m = 0;		/* decimal mantissa */
+    int digits = 0;		/* number of digits in m */
+    long e = 0;			/* decimal exponent */
+    long x = 0;			/* explicit exponent after e or E */
+    bool xneg = false;		/* true ==> explicit exponent is negative */
+    int d;
+
+    /*
+     * firewall
+     */
+    if (str == NULL || len <= 0 || neg == NULL || mant == NULL || exp10 == NULL) {
+	return false;
+    }
+
+    /*
+     * sign
+     */
+    *neg = false;
+    if (*p == '-') {
+	*neg = true;
+	++p;
+    }
+    if (p >= end || *p < '0' || *p > '9') {
+	return false;
+    }
+
+    /*
+     * integer digits
+     */
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+	d = *p - '0';
+	if (m == 0 && d == 0) {
+	    continue;	/* leading zero */
+	}
+	if (digits < JSON_MANT_DIGITS) {
+	    m = m*10 + (uint64_t)d;
+	    ++digits;
+	} else if (d == 0) {
+	    ++e;	/* zero beyond the mantissa */
+	} else {
+	    return false;
+	}
+    }
+
+    /*
+     * fraction digits
+     */
+    if (p < end && *p == '.') {
+	++p;
+	if (p >= end || *p < '0' || *p > '9') {
+	    return false;
+	}
+	for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+	    d = *p - '0';
+	    if (m == 0 && d == 0) {
+		--e;	/* leading zero of the fraction */
+		continue;
+	    }
+	    if (digits < JSON_MANT_DIGITS) {
+		m = m*10 + (uint64_t)d;
+		++digits;
+		--e;
+	    } else if (d != 0) {
+		return false;
+	    }
+	}
+    }
+
+    /*
+     * exponent
+     */
+    if (p < end && (*p == 'e' || *p == 'E')) {
+	++p;
+	if (p < end && (*p == '-' || *p == '+')) {
+	    xneg = (*p == '-');
+	    ++p;
+	}
+	if (p >= end || *p < '0' || *p > '9') {
+	    return false;
+	}
+	for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+	    x = x*10 + (*p - '0');
+	    if (x > JSON_MAX_EXP10) {
+		return false;
+	    }
+	}
+	e += (xneg ? -x : x);
+    }
+    if (p != end || e < -JSON_MAX_EXP10 || e > JSON_MAX_EXP10) {
+	return false;
+    }
+
+    *mant = m;
+    *exp10 = (int)e;
+    return true;
+}
+
+
+/*
+ * json_strtold - convert a JSON number string to a long double
+ *
+ * When the JSON number has no more than JSON_MANT_DIGITS significant digits
+ * and a small enough exponent, the value is the result of a single long double
+ * multiply or divide of two exactly representable values, and is thus correctly
+ * rounded.  Otherwise strtold(3) is used.
+ *
+ * given:
+ *	str	JSON number as a NUL terminated C-style string
+ *	len	length of the JSON number that is not whitespace
+ *	endptr	where to store a pointer to the end of the converted JSON number
+ *
+ * returns:
+ *	the same as strtold(3), including errno on error
+ */
+static long double
+json_strtold(char const *str, size_t len, char **endptr)
+{
+    bool neg = false;		/* true ==> JSON number is negative */
+    uint64_t mant = 0;		/* decimal mantissa */
+    int exp10 = 0;		/* decimal exponent */
+    long double val = 0.0L;	/* converted value */
+
+#if defined(JSON_LDBL_POW10_MAX)
+    if (json_digits(str, len, &neg, &mant, &exp10) == true &&
+	mant <= JSON_LDBL_MANT_MAX &&
+	exp10 >= -JSON_LDBL_POW10_MAX && exp10 <= JSON_LDBL_POW10_MAX) {
+	val = (long double)mant;
+	if (exp10 < 0) {
+	    val /= json_pow10[-exp10];
+	} else {
+	    val *= json_pow10[exp10];
+	}
+	errno = 0;
+	if (endptr != NULL) {
+	    *endptr = (char *)(str+len);
+	}
+	return (neg ? -val : val);
+    }
+#endif
+
+    return strtold(str, endptr);
+}
+
+
+/*
+ * json_strtod - convert a JSON number string to a double
+ *
+ * This function is like json_strtold() except for a double.
+ *
+ * given:
+ *	str	JSON number as a NUL terminated C-style string
+ *	len	length of the JSON number that is not whitespace
+ *	endptr	where to store a pointer to the end of the converted JSON number
+ *
+ * returns:
+ *	the same as strtod(3), including errno on error
+ */
+static double
+json_strtod(char const *str, size_t len, char **endptr)
+{
+    bool neg = false;		/* true ==> JSON number is negative */
+    uint64_t mant = 0;		/* decimal mantissa */
+    int exp10 = 0;		/* decimal exponent */
+    double val = 0.0;		/* converted value */
+
+#if FLT_EVAL_METHOD == 0
+    if (json_digits(str, len, &neg, &mant, &exp10) == true &&
+	mant <= ((uint64_t)1 << DBL_MANT_DIG) &&
+	exp10 >= -JSON_DBL_POW10_MAX && exp10 <= JSON_DBL_POW10_MAX) {
+	val = (double)mant;
+	if (exp10 < 0) {
+	    val /= (double)json_pow10[-exp10];
+	} else {
+	    val *= (double)json_pow10[exp10];
+	}
+	errno = 0;
+	if (endptr != NULL) {
+	    *endptr = (char *)(str+len);
+	}
+	return (neg ? -val : val);
+    }
+#endif
+
+    return strtod(str, endptr);
+}
+
+
+/*
+ * json_strtof - convert a JSON number string to a float
+ *
+ * This function is like json_strtold() except for a float.
+ *
+ * given:
+ *	str	JSON number as a NUL terminated C-style string
+ *	len	length of the JSON number that is not whitespace
+ *	endptr	where to store a pointer to the end of the converted JSON number
+ *
+ * returns:
+ *	the same as strtof(3), including errno on error
+ */
+static float
+json_strtof(char const *str, size_t len, char **endptr)
+{
+    bool neg = false;		/* true ==> JSON number is negative */
+    uint64_t mant = 0;		/* decimal mantissa */
+    int exp10 = 0;		/* decimal exponent */
+    float val = 0.0f;		/* converted value */
+
+#if FLT_EVAL_METHOD == 0
+    if (json_digits(str, len, &neg, &mant, &exp10) == true &&
+	mant <= ((uint64_t)1 << FLT_MANT_DIG) &&
+	exp10 >= -JSON_FLT_POW10_MAX && exp10 <= JSON_FLT_POW10_MAX) {
+	val = (float)mant;
+	if (exp10 < 0) {
+	    val /= (float)json_pow10[-exp10];
+	} else {
+	    val *= (float)json_pow10[exp10];
+	}
+	errno = 0;
+	if (endptr != NULL) {
+	    *endptr = (char *)(str+len);
+	}
+	return (neg ? -val : val);
+    }
+#endif
+
+    return strtof(str, endptr);
+}
+
+
+/*
+ * json_strtoumax - convert a JSON integer string to an uintmax_t
+ *
+ * given:
+ *	str	JSON integer as a NUL terminated C-style string
+ *	len	length of the JSON integer that is not whitespace
+ *	endptr	where to store a pointer to the first character after the digits
+ *
+ * returns:
+ *	the same as strtoumax(3) with a base of 10, including errno on error
+ *
+ * NOTE: Unlike strtoumax(3), leading whitespace and a leading + or - are not
+ *	 converted: such a str is an error (EINVAL).
+ */
+static uintmax_t
+json_strtoumax(char const *str, size_t len, char **endptr)
+{
+    char const *p = str;	/* next digit to convert */
+    char const *end = str+len;	/* end of the JSON integer string */
+    uintmax_t val = 0;		/* converted value */
+    unsigned int d;
+
+    errno = 0;
+    if (endptr != NULL) {
+	*endptr = (char *)str;
+    }
+    if (p >= end || *p < '0' || *p > '9') {
+	errno = EINVAL;
+	return 0;
+    }
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+	d = (unsigned int)(*p - '0');
+	if (val > (UINTMAX_MAX - d) / 10) {
+	    errno = ERANGE;
+	    val = UINTMAX_MAX;
+	    /* consume the remaining digits as strtoumax(3) does */
+	    while (p < end && *p >= '0' && *p <= '9') {
+		++p;
+	    }
+	    break;
+	}
+	val = val*10 + d;
+    }
+    if (endptr != NULL) {
+	*endptr = (char *)p;
+    }
+    return val;
+}
+
+
+/*
+ * json_strtoimax - convert a JSON integer string to an intmax_t
+ *
+ * given:
+ *	str	JSON integer as a NUL terminated C-style string
+ *	len	length of the JSON integer that is not whitespace
+ *	endptr	where to store a pointer to the first character after the digits
+ *
+ * returns:
+ *	the same as strtoimax(3) with a base of 10, including errno on error
+ *
+ * NOTE: Unlike strtoimax(3), leading whitespace and a leading + are not
+ *	 converted: such a str is an error (EINVAL).
+ */
+static intmax_t
+json_strtoimax(char const *str, size_t len, char **endptr)
+{
+    uintmax_t mag = 0;		/* magnitude of the JSON integer */
+    char *end = NULL;		/* first character after the digits */
+
+    /*
+     * case: >= 0
+     */
+    if (len <= 0 || str[0] != '-') {
+	mag = json_strtoumax(str, len, endptr);
+	if (errno == 0 && mag > (uintmax_t)INTMAX_MAX) {
+	    errno = ERANGE;
+	    return INTMAX_MAX;
+	}
+	return (errno == ERANGE) ? INTMAX_MAX : (intmax_t)mag;
+    }
+
+    /*
+     * case: < 0
+     */
+    mag = json_strtoumax(str+1, len-1, &end);
+    if (endptr != NULL) {
+	*endptr = (end == str+1) ? (char *)str : end;
+    }
+    if (errno != 0) {
+	return (errno == ERANGE) ? INTMAX_MIN : 0;
+    }
+    if (mag > (uintmax_t)INTMAX_MAX + 1) {
+	errno = ERANGE;
+	return INTMAX_MIN;
+    }
+    return (mag == 0) ? 0 : -(intmax_t)(mag - 1) - 1;
+}
+
+
 /*
  * json_process_decimal - process a JSON integer string
  *
@@ -1763,6 +2482,8 @@ static bool
 json_process_decimal(struct json_number *item, char const *str, size_t len)
 {
     char *endptr;			/* first invalid character or str */
+    intmax_t maxint = 0;		/* converted negative JSON integer */
+    uintmax_t umaxint = 0;		/* converted JSON integer >= 0 */
     size_t str_len = 0;			/* length as a C string, of str */
 
     /*
@@ -1836,239 +2557,50 @@ json_process_decimal(struct json_number *item, char const *str, size_t len)
     }
 
     /*
-     * attempt to convert to the largest possible integer
+     * convert to the largest possible integer
+     *
+     * NOTE: Narrower integer types are range checked on demand by the
+     *	     json_number_int8(), etc. accessor functions.
      */
     if (item->is_negative) {
 
 	/* case: negative, try for largest signed integer */
 	errno = 0;			/* pre-clear errno for errp() */
-	item->as_maxint = strtoimax(str, &endptr, 10);
+	maxint = json_strtoimax(str, len, &endptr);
 	if (errno == ERANGE || errno == EINVAL || endptr == str || endptr == NULL) {
 	    if (errno == ERANGE) {
-		dbg(DBG_VVVHIGH, "negative integer out of range, strtoimax failed to convert");
+		dbg(DBG_VVVHIGH, "negative integer out of range, json_strtoimax failed to convert");
 	    } else {
-		dbg(DBG_VVVHIGH, "invalid negative integer, strtoimax failed to convert");
+		dbg(DBG_VVVHIGH, "invalid negative integer, json_strtoimax failed to convert");
 	    }
 	    return false;	/* processing failed */
 	}
-	item->maxint_sized = true;
-	dbg(DBG_VVVHIGH, "strtoimax for <%s> returned: %jd", str, item->as_maxint);
-
-	/* case int8_t: range check */
-	if (item->as_maxint >= (intmax_t)INT8_MIN && item->as_maxint <= (intmax_t)INT8_MAX) {
-	    item->int8_sized = true;
-	    item->as_int8 = (int8_t)item->as_maxint;
-	}
-
-	/* case uint8_t: cannot be because JSON string is < 0 */
-	item->uint8_sized = false;
-
-	/* case int16_t: range check */
-	if (item->as_maxint >= (intmax_t)INT16_MIN && item->as_maxint <= (intmax_t)INT16_MAX) {
-	    item->int16_sized = true;
-	    item->as_int16 = (int16_t)item->as_maxint;
-	}
+	item->as_maxint = maxint;
+	dbg(DBG_VVVHIGH, "json_strtoimax for <%s> returned: %jd", str, item->as_maxint);
 
-	/* case uint16_t: cannot be because JSON string is < 0 */
-	item->uint16_sized = false;
+    } else {
 
-	/* case int32_t: range check */
-	if (item->as_maxint >= (intmax_t)INT32_MIN && item->as_maxint <= (intmax_t)INT32_MAX) {
-	    item->int32_sized = true;
-	    item->as_int32 = (int32_t)item->as_maxint;
+	/* case: positive, try for largest unsigned integer */
+	errno = 0;			/* pre-clear errno for errp() */
+	umaxint = json_strtoumax(str, len, &endptr);
+	if (errno == ERANGE || errno == EINVAL || endptr == str || endptr == NULL) {
+	    if (errno == ERANGE) {
+		dbg(DBG_VVVHIGH, "positive integer out of range, json_strtoumax failed to convert");
+	    } else {
+		dbg(DBG_VVVHIGH, "invalid positive integer, json_strtoumax failed to convert");
+	    }
+	    return false;	/* processing failed */
 	}
+	item->as_umaxint = umaxint;
+	dbg(DBG_VVVHIGH, "json_strtoumax for <%s> returned: %ju", str, item->as_umaxint);
+    }
+    item->integer_converted = true;
 
-	/* case uint32_t: cannot be because JSON string is < 0 */
-	item->uint32_sized = false;
-
-	/* case int64_t: range check */
-	if (item->as_maxint >= (intmax_t)INT64_MIN && item->as_maxint <= (intmax_t)INT64_MAX) {
-	    item->int64_sized = true;
-	    item->as_int64 = (int64_t)item->as_maxint;
-	}
-
-	/* case uint64_t: cannot be because JSON string is < 0 */
-	item->uint64_sized = false;
-
-	/* case int: range check */
-	if (item->as_maxint >= (intmax_t)INT_MIN && item->as_maxint <= (intmax_t)INT_MAX) {
-	    item->int_sized = true;
-	    item->as_int = (int)item->as_maxint;
-	}
-
-	/* case unsigned int: cannot be because JSON string is < 0 */
-	item->uint_sized = false;
-
-	/* case long: range check */
-	if (item->as_maxint >= (intmax_t)LONG_MIN && item->as_maxint <= (intmax_t)LONG_MAX) {
-	    item->long_sized = true;
-	    item->as_long = (long)item->as_maxint;
-	}
-
-	/* case unsigned long: cannot be because JSON string is < 0 */
-	item->ulong_sized = false;
-
-	/* case long long: range check */
-	if (item->as_maxint >= (intmax_t)LLONG_MIN && item->as_maxint <= (intmax_t)LLONG_MAX) {
-	    item->longlong_sized = true;
-	    item->as_longlong = (long long)item->as_maxint;
-	}
-
-	/* case unsigned long long: cannot be because JSON string is < 0 */
-	item->ulonglong_sized = false;
-
-	/* case size_t: cannot be because JSON string is < 0 */
-	item->size_sized = false;
-
-	/* case ssize_t: range check */
-	if (item->as_maxint >= (intmax_t)SSIZE_MIN && item->as_maxint <= (intmax_t)SSIZE_MAX) {
-	    item->ssize_sized = true;
-	    item->as_ssize = (ssize_t)item->as_maxint;
-	}
-
-	/* case off_t: range check */
-	if (item->as_maxint >= (intmax_t)OFF_MIN && item->as_maxint <= (intmax_t)OFF_MAX) {
-	    item->off_sized = true;
-	    item->as_off = (off_t)item->as_maxint;
-	}
-
-	/* case intmax_t: was handled by the above call to strtoimax() */
-
-	/* case uintmax_t: cannot be because JSON string is < 0 */
-	item->umaxint_sized = false;
-
-    } else {
-
-	/* case: positive, try for largest unsigned integer */
-	errno = 0;			/* pre-clear errno for errp() */
-	item->as_umaxint = strtoumax(str, &endptr, 10);
-	if (errno == ERANGE || errno == EINVAL || endptr == str || endptr == NULL) {
-	    if (errno == ERANGE) {
-		dbg(DBG_VVVHIGH, "positive integer out of range, strtoumax failed to convert");
-	    } else {
-		dbg(DBG_VVVHIGH, "invalid positive integer, strtoumax failed to convert");
-	    }
-	    return false;	/* processing failed */
-	}
-	item->umaxint_sized = true;
-	dbg(DBG_VVVHIGH, "strtoumax for <%s> returned: %ju", str, item->as_umaxint);
-
-	/* case int8_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)INT8_MAX) {
-	    item->int8_sized = true;
-	    item->as_int8 = (int8_t)item->as_umaxint;
-	}
-
-	/* case uint8_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)UINT8_MAX) {
-	    item->uint8_sized = true;
-	    item->as_uint8 = (uint8_t)item->as_umaxint;
-	}
-
-	/* case int16_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)INT16_MAX) {
-	    item->int16_sized = true;
-	    item->as_int16 = (int16_t)item->as_umaxint;
-	}
-
-	/* case uint16_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)UINT16_MAX) {
-	    item->uint16_sized = true;
-	    item->as_uint16 = (uint16_t)item->as_umaxint;
-	}
-
-	/* case int32_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)INT32_MAX) {
-	    item->int32_sized = true;
-	    item->as_int32 = (int32_t)item->as_umaxint;
-	}
-
-	/* case uint32_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)UINT32_MAX) {
-	    item->uint32_sized = true;
-	    item->as_uint32 = (uint32_t)item->as_umaxint;
-	}
-
-	/* case int64_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)INT64_MAX) {
-	    item->int64_sized = true;
-	    item->as_int64 = (int64_t)item->as_umaxint;
-	}
-
-	/* case uint64_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)UINT64_MAX) {
-	    item->uint64_sized = true;
-	    item->as_uint64 = (uint64_t)item->as_umaxint;
-	}
-
-	/* case int: bounds check */
-	if (item->as_umaxint <= (uintmax_t)INT_MAX) {
-	    item->int_sized = true;
-	    item->as_int = (int)item->as_umaxint;
-	}
-
-	/* case unsigned int: bounds check */
-	if (item->as_umaxint <= (uintmax_t)UINT_MAX) {
-	    item->uint_sized = true;
-	    item->as_uint = (unsigned int)item->as_umaxint;
-	}
-
-	/* case long: bounds check */
-	if (item->as_umaxint <= (uintmax_t)LONG_MAX) {
-	    item->long_sized = true;
-	    item->as_long = (long)item->as_umaxint;
-	}
-
-	/* case unsigned long: bounds check */
-	if (item->as_umaxint <= (uintmax_t)ULONG_MAX) {
-	    item->ulong_sized = true;
-	    item->as_ulong = (unsigned long)item->as_umaxint;
-	}
-
-	/* case long long: bounds check */
-	if (item->as_umaxint <= (uintmax_t)LLONG_MAX) {
-	    item->longlong_sized = true;
-	    item->as_longlong = (long long)item->as_umaxint;
-	}
-
-	/* case unsigned long long: bounds check */
-	if (item->as_umaxint <= (uintmax_t)ULLONG_MAX) {
-	    item->ulonglong_sized = true;
-	    item->as_ulonglong = (unsigned long long)item->as_umaxint;
-	}
-
-	/* case ssize_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)SSIZE_MAX) {
-	    item->ssize_sized = true;
-	    item->as_ssize = (ssize_t)item->as_umaxint;
-	}
-
-	/* case size_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)SIZE_MAX) {
-	    item->size_sized = true;
-	    item->as_size = (size_t)item->as_umaxint;
-	}
-
-	/* case off_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)OFF_MAX) {
-	    item->off_sized = true;
-	    item->as_off = (off_t)item->as_umaxint;
-	}
-
-	/* case intmax_t: bounds check */
-	if (item->as_umaxint <= (uintmax_t)INTMAX_MAX) {
-	    item->maxint_sized = true;
-	    item->as_maxint = (intmax_t)item->as_umaxint;
-	}
-
-	/* case uintmax_t: was handled by the above call to strtoumax() */
-    }
-
-    /*
-     * processing was successful
-     */
-    return true;
-}
+    /*
+     * processing was successful
+     */
+    return true;
+}
 
 
 /*
@@ -2315,23 +2847,26 @@ json_process_floating(struct json_number *item, char const *str, size_t len)
 
     /*
      * convert to largest floating point value
+     *
+     * NOTE: The double and float values are converted on demand by the
+     *	     json_number_double() and json_number_float() accessor functions.
      */
     errno = 0;			/* pre-clear errno for errp() */
-    item->as_longdouble = strtold(str, &endptr);
+    item->as_longdouble = json_strtold(str, len, &endptr);
     if (errno == ERANGE || endptr == str || endptr == NULL) {
 	if (errno == ERANGE) {
 	    /* if range problem we know it's parsable */
 	    item->parsed = true;
 	}
-	dbg(DBG_VVVHIGH, "strtold failed to convert");
+	dbg(DBG_VVVHIGH, "json_strtold failed to convert");
+	item->as_longdouble = 0.0L;
 	return false;	/* processing failed */
     }
-    item->longdouble_sized = true;
     item->as_longdouble_int = (item->as_longdouble == floorl(item->as_longdouble));
-    dbg(DBG_VVVHIGH, "strtold for <%s> returned as %%Lg: %.22Lg", str, item->as_longdouble);
-    dbg(DBG_VVVHIGH, "strtold for <%s> returned as %%Le: %.22Le", str, item->as_longdouble);
-    dbg(DBG_VVVHIGH, "strtold for <%s> returned as %%Lf: %.22Lf", str, item->as_longdouble);
-    dbg(DBG_VVVHIGH, "strtold returned an integer value: %s", booltostr(item->as_longdouble_int));
+    dbg(DBG_VVVHIGH, "json_strtold for <%s> returned as %%Lg: %.22Lg", str, item->as_longdouble);
+    dbg(DBG_VVVHIGH, "json_strtold for <%s> returned as %%Le: %.22Le", str, item->as_longdouble);
+    dbg(DBG_VVVHIGH, "json_strtold for <%s> returned as %%Lf: %.22Lf", str, item->as_longdouble);
+    dbg(DBG_VVVHIGH, "json_strtold returned an integer value: %s", booltostr(item->as_longdouble_int));
 
     /*
      * note if value < 0
@@ -2339,50 +2874,7 @@ json_process_floating(struct json_number *item, char const *str, size_t len)
     if (item->as_longdouble < 0) {
 	item->is_negative = true;
     }
-
-    /*
-     * convert to double
-     */
-    errno = 0;			/* pre-clear conversion test */
-    item->as_double = strtod(str, &endptr);
-    if (errno == ERANGE || endptr == str || endptr == NULL) {
-	if (errno == ERANGE) {
-	    /* if range problem we know it's parsable */
-	    item->parsed = true;
-	}
-	item->double_sized = false;
-	dbg(DBG_VVVHIGH, "strtod for <%s> failed", str);
-    } else {
-	item->double_sized = true;
-	item->parsed = true;
-	item->as_double_int = (item->as_double == floor(item->as_double));
-	dbg(DBG_VVVHIGH, "strtod for <%s> returned as %%lg: %.22lg", str, item->as_double);
-	dbg(DBG_VVVHIGH, "strtod for <%s> returned as %%le: %.22le", str, item->as_double);
-	dbg(DBG_VVVHIGH, "strtod for <%s> returned as %%lf: %.22lf", str, item->as_double);
-	dbg(DBG_VVVHIGH, "strtod returned an integer value: %s", booltostr(item->as_double_int));
-    }
-
-    /*
-     * convert to float
-     */
-    errno = 0;			/* pre-clear conversion test */
-    item->as_float = strtof(str, &endptr);
-    if (errno == ERANGE || endptr == str || endptr == NULL) {
-	if (errno == ERANGE) {
-	    /* if range issue we know it's parsable */
-	    item->parsed = true;
-	}
-	item->float_sized = false;
-	dbg(DBG_VVVHIGH, "strtof for <%s> failed", str);
-    } else {
-	item->parsed = true;
-	item->float_sized = true;
-	item->as_float_int = (item->as_longdouble == floorl(item->as_longdouble));
-	dbg(DBG_VVVHIGH, "strtof for <%s> returned as %%g: %.22g", str, (double)item->as_float);
-	dbg(DBG_VVVHIGH, "strtof for <%s> returned as %%e: %.22e", str, (double)item->as_float);
-	dbg(DBG_VVVHIGH, "strtof for <%s> returned as %%f: %.22f", str, (double)item->as_float);
-	dbg(DBG_VVVHIGH, "strtof returned an integer value: %s", booltostr(item->as_float_int));
-    }
+    item->parsed = true;
 
     /*
      * processing was successful
@@ -2450,37 +2942,11 @@ json_conv_number(char const *ptr, size_t len)
     item->is_negative = false;
     item->is_floating = false;
     item->is_e_notation = false;
-    /* integer values */
     item->is_integer = false;
-    item->int8_sized = false;
-    item->uint8_sized = false;
-    item->int16_sized = false;
-    item->uint16_sized = false;
-    item->int32_sized = false;
-    item->uint32_sized = false;
-    item->int64_sized = false;
-    item->uint64_sized = false;
-    item->int_sized = false;
-    item->uint_sized = false;
-    item->long_sized = false;
-    item->ulong_sized = false;
-    item->longlong_sized = false;
-    item->ulonglong_sized = false;
-    item->ssize_sized = false;
-    item->size_sized = false;
-    item->off_sized = false;
-    item->maxint_sized = false;
-    item->umaxint_sized = false;
-    /* floating point values */
-    item->float_sized = false;
-    item->as_float = 0.0f;
-    item->as_float_int = false;
-    item->double_sized = false;
-    item->as_double = 0.0;
-    item->as_double_int = false;
-    item->longdouble_sized = false;
-    item->as_longdouble = 0.0L;
+    /* converted value */
+    item->integer_converted = false;
     item->as_longdouble_int = false;
+    item->as_longdouble = 0.0L;
 
     /*
      * firewall
@@ -2500,17 +2966,23 @@ json_conv_number(char const *ptr, size_t len)
     }
 
     /*
-     * duplicate the JSON integer string
+     * duplicate the JSON integer string, unless it may be referenced in the input
+     *
+     * NOTE: A referenced number is NUL terminated by parse_json_arena_ref()
+     *	     once the parse is complete.
      */
-    errno = 0;			/* pre-clear errno for errp() */
-    item->as_str = calloc(len+1+1, sizeof(char));
+    item->as_str = json_arena_ref(ptr, len);
     if (item->as_str == NULL) {
-	errp(182, __func__, "calloc #1 error allocating %ju bytes", (uintmax_t)(len+1+1));
-	not_reached();
+	errno = 0;			/* pre-clear errno for errp() */
+	item->as_str = json_tree_calloc(len+1+1);
+	if (item->as_str == NULL) {
+	    errp(182, __func__, "calloc #1 error allocating %ju bytes", (uintmax_t)(len+1+1));
+	    not_reached();
+	}
+	strncpy(item->as_str, ptr, len);
+	item->as_str[len] = '\0';	/* paranoia */
+	item->as_str[len+1] = '\0';	/* paranoia */
     }
-    strncpy(item->as_str, ptr, len);
-    item->as_str[len] = '\0';	/* paranoia */
-    item->as_str[len+1] = '\0';	/* paranoia */
 
     /*
      * ignore whitespace
@@ -2689,178 +3161,1006 @@ json_conv_number_str(char const *str, size_t *retlen)
     return ret;
 }
 
-
 /*
- * json_conv_string - convert JSON encoded string to C string
- *
- * A JSON string is of the form:
- *
- *      "([^\n"]|\\")*"
+ * json_number_signed - obtain a converted JSON integer within signed limits
  *
  * given:
- *	ptr	pointer to buffer containing a JSON encoded string
- *	len	length, starting at ptr, of the JSON encoded string
- *	quote	true ==>  ignore JSON double quotes: both ptr[0] & ptr[len-1]
- *			  must be '"'
- *		false ==> the entire ptr is to be converted
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	min	smallest value of the signed C type
+ *	max	largest value of the signed C type
+ *	ret	where to store the value, if ret != NULL and the value is within limits
  *
  * returns:
- *	allocated JSON parser tree node converted JSON string
- *
- * NOTE: This function will not return on malloc error.
- * NOTE: This function will not return NULL.
- *
- * NOTE: We let this function decide whether the string is actually valid
- * according to the JSON standard so the regex above is for the parser even if
- * it would theoretically allow invalid JSON strings.
+ *	true ==> item is a converted JSON integer >= min and <= max
+ *	false ==> item is NULL, not a converted JSON integer or out of range
  */
-struct json *
-json_conv_string(char const *ptr, size_t len, bool quote)
+static bool
+json_number_signed(struct json_number const *item, intmax_t min, intmax_t max, intmax_t *ret)
 {
-    struct json *ret = NULL;		    /* JSON parser tree node to return */
-    struct json_string *item = NULL;	    /* JSON string item inside JSON parser tree node */
-
-    /*
-     * allocate an initialized JSON parse tree item
-     */
-    ret = json_alloc(JTYPE_STRING);
-    if (ret == NULL) {
-	errp(184, __func__, "json_alloc(JTYPE_STRING) returned NULL");
-	not_reached();
-    }
-
-    /*
-     * initialize the JSON item
-     */
-    item = &(ret->item.string);
-    item->as_str = NULL;
-    item->str = NULL;
-    item->converted = false;
-    item->parsed = false;
-    item->quote = false;
-    item->same = false;
-    item->has_nul = false;
-    item->slash = false;
-    item->posix_safe = false;
-    item->first_alphanum = false;
-    item->upper = false;
-
     /*
      * firewall
      */
-    if (ptr == NULL) {
-	warn(__func__, "called with NULL string");
-	return ret;
+    if (item == NULL || item->integer_converted == false) {
+	return false;
     }
 
     /*
-     * case: JSON surrounding '"'s are to be ignored
+     * range check the stored integer
      */
-    item->as_str_len = len;	/* save length of as_str */
-    if (quote == true) {
-
-	/*
-	 * firewall
-	 */
-	if (len < 2) {
-	    warn(__func__, "quote === true: called with len: %ju < 2", (uintmax_t)len);
-	    return ret;
+    if (item->is_negative) {
+	if (item->as_maxint < min || item->as_maxint > max) {
+	    return false;
 	}
-	if (ptr[0] != '"') {
-	    warn(__func__, "quote === true: string does NOT start with a \"");
-	    return ret;
+	if (ret != NULL) {
+	    *ret = item->as_maxint;
 	}
-	if (ptr[len-1] != '"') {
-	    warn(__func__, "quote === true: string does NOT end with a \"");
-	    return ret;
+    } else {
+	if (item->as_umaxint > (uintmax_t)max) {
+	    return false;
+	}
+	if (ret != NULL) {
+	    *ret = (intmax_t)item->as_umaxint;
 	}
-
-	/*
-	 * ignore JSON surrounding '"'s
-	 */
-	item->quote = true;
-	++ptr;
-	len -= 2;
     }
+    return true;
+}
 
-    /*
-     * duplicate the JSON string
-     */
-    errno = 0;			/* pre-clear errno for errp() */
-    item->as_str = calloc(len+1+1, sizeof(char));
-    if (item->as_str == NULL) {
-	errp(185, __func__, "calloc #1 error allocating %ju bytes", (uintmax_t)(len+1+1));
-	not_reached();
-    }
-    strncpy(item->as_str, ptr, len);
-    item->as_str[len] = '\0';	/* paranoia */
-    item->as_str[len+1] = '\0';	/* paranoia */
 
+/*
+ * json_number_unsigned - obtain a converted JSON integer within an unsigned limit
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	max	largest value of the unsigned C type
+ *	ret	where to store the value, if ret != NULL and the value is within limits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer >= 0 and <= max
+ *	false ==> item is NULL, not a converted JSON integer, < 0 or out of range
+ */
+static bool
+json_number_unsigned(struct json_number const *item, uintmax_t max, uintmax_t *ret)
+{
     /*
-     * decode the JSON encoded string
+     * firewall
      */
-    /* decode the entire string */
-    item->str = json_decode(item->as_str, len, &(item->str_len), &(item->has_nul));
-    if (item->str == NULL) {
-	warn(__func__, "quote === %s: JSON string decode failed for: <%s>",
-		       booltostr(quote), item->as_str);
-	return ret;
+    if (item == NULL || item->integer_converted == false || item->is_negative) {
+	return false;
     }
-    item->converted = true;	/* JSON decoding successful */
-    item->parsed = true;	/* JSON parsed successful */
 
     /*
-     * determine if decoded string is identical to the original JSON encoded string
-     *
-     * NOTE: We use memcmp() because there might be NUL bytes in the 'char *'
-     * and strcmp() would stop at the first '\0'.
+     * range check the stored integer
      */
-    if (item->as_str_len == item->str_len && memcmp(item->as_str, item->str, item->as_str_len) == 0) {
-	item->same = true;	/* decoded string same an original JSON encoded string (perhaps sans '"'s) */
+    if (item->as_umaxint > max) {
+	return false;
     }
-
-    /*
-     * determine POSIX state of the decoded string
-     */
-    posix_safe_chk(item->str, item->str_len, &item->slash, &item->posix_safe, &item->first_alphanum, &item->upper);
-    json_dbg(JSON_DBG_VHIGH, __func__, "JSON return type: %s", json_item_type_name(ret));
-
-    /*
-     * return the JSON parse tree item
-     */
-    return ret;
+    if (ret != NULL) {
+	*ret = item->as_umaxint;
+    }
+    return true;
 }
 
-
 /*
- * json_conv_string_str - convert JSON encoded string to C string
- *
- * This is a simplified interface for json_conv_string(). See that function for details.
+ * json_number_int8 - obtain a JSON number as an int8_t
  *
  * given:
- *	str	encoded JSON string in the from of a NUL terminated C-style string
- *	retlen	address of where to store length of str, if retlen != NULL
- *	quote	true ==> ignore JSON double quotes, both str[0] & str[len-1]
- *		must be '"', false ==> the entire str is to be converted
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
  *
  * returns:
- *	allocated JSON parser tree node converted JSON string
- *
- * NOTE: retlen, if non-NULL, is set to 0 on error
- *
- * NOTE: This function will not return on malloc error.
- * NOTE: This function will not return NULL.
+ *	true ==> item is a converted JSON integer that fits into an int8_t
+ *	false ==> item is NULL or does not fit into an int8_t
  */
-struct json *
-json_conv_string_str(char const *str, size_t *retlen, bool quote)
+bool
+json_number_int8(struct json_number const *item, int8_t *ret)
 {
-    struct json *ret = NULL;		    /* JSON parser tree node to return */
-    size_t len = 0;			    /* length of string to encode */
+    intmax_t val = 0;		/* converted JSON integer */
 
-    /*
-     * firewall
-     *
-     * NOTE: We will let the json_conv_string() handle the arg firewall
+    if (json_number_signed(item, (intmax_t)INT8_MIN, (intmax_t)INT8_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (int8_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_uint8 - obtain a JSON number as an uint8_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an uint8_t
+ *	false ==> item is NULL or does not fit into an uint8_t
+ */
+bool
+json_number_uint8(struct json_number const *item, uint8_t *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)UINT8_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (uint8_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_int16 - obtain a JSON number as an int16_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an int16_t
+ *	false ==> item is NULL or does not fit into an int16_t
+ */
+bool
+json_number_int16(struct json_number const *item, int16_t *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)INT16_MIN, (intmax_t)INT16_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (int16_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_uint16 - obtain a JSON number as an uint16_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an uint16_t
+ *	false ==> item is NULL or does not fit into an uint16_t
+ */
+bool
+json_number_uint16(struct json_number const *item, uint16_t *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)UINT16_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (uint16_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_int32 - obtain a JSON number as an int32_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an int32_t
+ *	false ==> item is NULL or does not fit into an int32_t
+ */
+bool
+json_number_int32(struct json_number const *item, int32_t *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)INT32_MIN, (intmax_t)INT32_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (int32_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_uint32 - obtain a JSON number as an uint32_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an uint32_t
+ *	false ==> item is NULL or does not fit into an uint32_t
+ */
+bool
+json_number_uint32(struct json_number const *item, uint32_t *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)UINT32_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (uint32_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_int64 - obtain a JSON number as an int64_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an int64_t
+ *	false ==> item is NULL or does not fit into an int64_t
+ */
+bool
+json_number_int64(struct json_number const *item, int64_t *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)INT64_MIN, (intmax_t)INT64_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (int64_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_uint64 - obtain a JSON number as an uint64_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an uint64_t
+ *	false ==> item is NULL or does not fit into an uint64_t
+ */
+bool
+json_number_uint64(struct json_number const *item, uint64_t *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)UINT64_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (uint64_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_int - obtain a JSON number as an int
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an int
+ *	false ==> item is NULL or does not fit into an int
+ */
+bool
+json_number_int(struct json_number const *item, int *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)INT_MIN, (intmax_t)INT_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (int)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_uint - obtain a JSON number as an unsigned int
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an unsigned int
+ *	false ==> item is NULL or does not fit into an unsigned int
+ */
+bool
+json_number_uint(struct json_number const *item, unsigned int *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)UINT_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (unsigned int)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_long - obtain a JSON number as a long
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into a long
+ *	false ==> item is NULL or does not fit into a long
+ */
+bool
+json_number_long(struct json_number const *item, long *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)LONG_MIN, (intmax_t)LONG_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (long)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_ulong - obtain a JSON number as an unsigned long
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an unsigned long
+ *	false ==> item is NULL or does not fit into an unsigned long
+ */
+bool
+json_number_ulong(struct json_number const *item, unsigned long *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)ULONG_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (unsigned long)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_longlong - obtain a JSON number as a long long
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into a long long
+ *	false ==> item is NULL or does not fit into a long long
+ */
+bool
+json_number_longlong(struct json_number const *item, long long *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)LLONG_MIN, (intmax_t)LLONG_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (long long)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_ulonglong - obtain a JSON number as an unsigned long long
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an unsigned long long
+ *	false ==> item is NULL or does not fit into an unsigned long long
+ */
+bool
+json_number_ulonglong(struct json_number const *item, unsigned long long *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)ULLONG_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (unsigned long long)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_ssize - obtain a JSON number as a ssize_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into a ssize_t
+ *	false ==> item is NULL or does not fit into a ssize_t
+ */
+bool
+json_number_ssize(struct json_number const *item, ssize_t *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)SSIZE_MIN, (intmax_t)SSIZE_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (ssize_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_size - obtain a JSON number as a size_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into a size_t
+ *	false ==> item is NULL or does not fit into a size_t
+ */
+bool
+json_number_size(struct json_number const *item, size_t *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)SIZE_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (size_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_off - obtain a JSON number as an off_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an off_t
+ *	false ==> item is NULL or does not fit into an off_t
+ */
+bool
+json_number_off(struct json_number const *item, off_t *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)OFF_MIN, (intmax_t)OFF_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (off_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_maxint - obtain a JSON number as an intmax_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an intmax_t
+ *	false ==> item is NULL or does not fit into an intmax_t
+ */
+bool
+json_number_maxint(struct json_number const *item, intmax_t *ret)
+{
+    intmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_signed(item, (intmax_t)INTMAX_MIN, (intmax_t)INTMAX_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (intmax_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_umaxint - obtain a JSON number as an uintmax_t
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON integer that fits into an uintmax_t
+ *	false ==> item is NULL or does not fit into an uintmax_t
+ */
+bool
+json_number_umaxint(struct json_number const *item, uintmax_t *ret)
+{
+    uintmax_t val = 0;		/* converted JSON integer */
+
+    if (json_number_unsigned(item, (uintmax_t)UINTMAX_MAX, &val) == false) {
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = (uintmax_t)val;
+    }
+    return true;
+}
+
+/*
+ * json_number_float - obtain a JSON number as a float
+ *
+ * The float is converted from the JSON number string when this function
+ * is called: it is not stored in the struct json_number.
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *	is_int	where to store if the value is an integer, if is_int != NULL
+ *		and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON floating point number that fits into a float
+ *	false ==> item is NULL, not a converted JSON floating point number or does not fit into a float
+ *
+ * NOTE: *is_int reports whether the long double value, not the float value,
+ *	 is an integer.
+ */
+bool
+json_number_float(struct json_number const *item, float *ret, bool *is_int)
+{
+    char *endptr = NULL;	/* first invalid character or str */
+    float val = 0.0f;		/* converted value */
+
+    bool ld_int = false;	/* true ==> long double value is an integer */
+
+    /*
+     * firewall
+     */
+    if (json_number_longdouble(item, NULL, &ld_int) == false || item->first == NULL) {
+	return false;
+    }
+
+    /*
+     * convert to float
+     */
+    errno = 0;			/* pre-clear conversion test */
+    val = json_strtof(item->first, item->number_len, &endptr);
+    if (errno == ERANGE || endptr == item->first || endptr == NULL) {
+	dbg(DBG_VVVHIGH, "json_strtof for <%s> failed", item->first);
+	return false;
+    }
+    dbg(DBG_VVVHIGH, "json_strtof for <%s> returned as %%g: %.22g", item->first, (double)val);
+    if (ret != NULL) {
+	*ret = val;
+    }
+    if (is_int != NULL) {
+	*is_int = ld_int;
+    }
+    return true;
+}
+
+
+/*
+ * json_number_double - obtain a JSON number as a double
+ *
+ * The double is converted from the JSON number string when this function
+ * is called: it is not stored in the struct json_number.
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *	is_int	where to store if the value is an integer, if is_int != NULL
+ *		and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON floating point number that fits into a double
+ *	false ==> item is NULL, not a converted JSON floating point number or does not fit into a double
+ */
+bool
+json_number_double(struct json_number const *item, double *ret, bool *is_int)
+{
+    char *endptr = NULL;	/* first invalid character or str */
+    double val = 0.0;		/* converted value */
+
+    /*
+     * firewall
+     */
+    if (json_number_longdouble(item, NULL, NULL) == false || item->first == NULL) {
+	return false;
+    }
+
+    /*
+     * convert to double
+     */
+    errno = 0;			/* pre-clear conversion test */
+    val = json_strtod(item->first, item->number_len, &endptr);
+    if (errno == ERANGE || endptr == item->first || endptr == NULL) {
+	dbg(DBG_VVVHIGH, "json_strtod for <%s> failed", item->first);
+	return false;
+    }
+    dbg(DBG_VVVHIGH, "json_strtod for <%s> returned as %%lg: %.22lg", item->first, val);
+    if (ret != NULL) {
+	*ret = val;
+    }
+    if (is_int != NULL) {
+	*is_int = (val == floor(val));
+    }
+    return true;
+}
+
+
+/*
+ * json_number_longdouble - obtain a JSON number as a long double
+ *
+ * A JSON number that uses floating point or e notation and that is not also
+ * a converted JSON integer has its long double value stored in the struct
+ * json_number.  When the JSON number is also a converted JSON integer, the
+ * integer value is stored instead and the long double is converted when this
+ * function is called.
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	ret	where to store the value, if ret != NULL and the value fits
+ *	is_int	where to store if the value is an integer, if is_int != NULL
+ *		and the value fits
+ *
+ * returns:
+ *	true ==> item is a converted JSON floating point number
+ *	false ==> item is NULL, not a JSON floating point number or was not converted
+ */
+bool
+json_number_longdouble(struct json_number const *item, long double *ret, bool *is_int)
+{
+    char *endptr = NULL;	/* first invalid character or str */
+    long double val = 0.0L;	/* converted value */
+
+    /*
+     * firewall
+     */
+    if (item == NULL || item->converted == false || (item->is_floating == false && item->is_e_notation == false)) {
+	return false;
+    }
+
+    /*
+     * case: the stored value is the long double value
+     */
+    if (item->integer_converted == false) {
+	if (ret != NULL) {
+	    *ret = item->as_longdouble;
+	}
+	if (is_int != NULL) {
+	    *is_int = item->as_longdouble_int;
+	}
+	return true;
+    }
+
+    /*
+     * case: the stored value is the integer value - convert to long double
+     */
+    if (item->first == NULL) {
+	return false;
+    }
+    errno = 0;			/* pre-clear conversion test */
+    val = json_strtold(item->first, item->number_len, &endptr);
+    if (errno == ERANGE || endptr == item->first || endptr == NULL) {
+	dbg(DBG_VVVHIGH, "json_strtold for <%s> failed", item->first);
+	return false;
+    }
+    if (ret != NULL) {
+	*ret = val;
+    }
+    if (is_int != NULL) {
+	*is_int = (val == floorl(val));
+    }
+    return true;
+}
+
+
+/*
+ * json_number_expand - fill in every C form of a JSON number
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *	exp	pointer to the structure to fill in
+ *
+ * NOTE: Values that do not fit into a C type are left as 0 with the
+ *	 matching _sized set to false.
+ *
+ * NOTE: This function does nothing if exp is NULL, and zeroizes *exp
+ *	 if item is NULL.
+ */
+void
+json_number_expand(struct json_number const *item, struct json_number_expanded *exp)
+{
+    /*
+     * firewall
+     */
+    if (exp == NULL) {
+	warn(__func__, "called with NULL exp");
+	return;
+    }
+    memset(exp, 0, sizeof(*exp));
+    if (item == NULL) {
+	warn(__func__, "called with NULL item");
+	return;
+    }
+
+    /*
+     * copy the common information
+     */
+    exp->parsed = item->parsed;
+    exp->converted = item->converted;
+    exp->as_str = item->as_str;
+    exp->first = item->first;
+    exp->as_str_len = item->as_str_len;
+    exp->number_len = item->number_len;
+    exp->is_negative = item->is_negative;
+    exp->is_floating = item->is_floating;
+    exp->is_e_notation = item->is_e_notation;
+    exp->is_integer = item->is_integer;
+
+    /*
+     * integer values
+     */
+    exp->int8_sized = json_number_int8(item, &exp->as_int8);
+    exp->uint8_sized = json_number_uint8(item, &exp->as_uint8);
+    exp->int16_sized = json_number_int16(item, &exp->as_int16);
+    exp->uint16_sized = json_number_uint16(item, &exp->as_uint16);
+    exp->int32_sized = json_number_int32(item, &exp->as_int32);
+    exp->uint32_sized = json_number_uint32(item, &exp->as_uint32);
+    exp->int64_sized = json_number_int64(item, &exp->as_int64);
+    exp->uint64_sized = json_number_uint64(item, &exp->as_uint64);
+    exp->int_sized = json_number_int(item, &exp->as_int);
+    exp->uint_sized = json_number_uint(item, &exp->as_uint);
+    exp->long_sized = json_number_long(item, &exp->as_long);
+    exp->ulong_sized = json_number_ulong(item, &exp->as_ulong);
+    exp->longlong_sized = json_number_longlong(item, &exp->as_longlong);
+    exp->ulonglong_sized = json_number_ulonglong(item, &exp->as_ulonglong);
+    exp->ssize_sized = json_number_ssize(item, &exp->as_ssize);
+    exp->size_sized = json_number_size(item, &exp->as_size);
+    exp->off_sized = json_number_off(item, &exp->as_off);
+    exp->maxint_sized = json_number_maxint(item, &exp->as_maxint);
+    exp->umaxint_sized = json_number_umaxint(item, &exp->as_umaxint);
+
+    /*
+     * floating point values
+     */
+    exp->float_sized = json_number_float(item, &exp->as_float, &exp->as_float_int);
+    exp->double_sized = json_number_double(item, &exp->as_double, &exp->as_double_int);
+    exp->longdouble_sized = json_number_longdouble(item, &exp->as_longdouble, &exp->as_longdouble_int);
+    return;
+}
+
+
+/*
+ * json_conv_string - convert JSON encoded string to C string
+ *
+ * A JSON string is of the form:
+ *
+ *      "([^\n"]|\\")*"
+ *
+ * given:
+ *	ptr	pointer to buffer containing a JSON encoded string
+ *	len	length, starting at ptr, of the JSON encoded string
+ *	quote	true ==>  ignore JSON double quotes: both ptr[0] & ptr[len-1]
+ *			  must be '"'
+ *		false ==> the entire ptr is to be converted
+ *
+ * returns:
+ *	allocated JSON parser tree node converted JSON string
+ *
+ * NOTE: This function will not return on malloc error.
+ * NOTE: This function will not return NULL.
+ *
+ * NOTE: We let this function decide whether the string is actually valid
+ * according to the JSON standard so the regex above is for the parser even if
+ * it would theoretically allow invalid JSON strings.
+ */
+struct json *
+json_conv_string(char const *ptr, size_t len, bool quote)
+{
+    struct json *ret = NULL;		    /* JSON parser tree node to return */
+    struct json_string *item = NULL;	    /* JSON string item inside JSON parser tree node */
+
+    /*
+     * allocate an initialized JSON parse tree item
+     */
+    ret = json_alloc(JTYPE_STRING);
+    if (ret == NULL) {
+	errp(184, __func__, "json_alloc(JTYPE_STRING) returned NULL");
+	not_reached();
+    }
+
+    /*
+     * initialize the JSON item
+     */
+    item = &(ret->item.string);
+    item->as_str = NULL;
+    item->str = NULL;
+    item->converted = false;
+    item->parsed = false;
+    item->quote = false;
+    item->same = false;
+    item->has_nul = false;
+    item->utf8 = false;
+    item->slash = false;
+    item->posix_safe = false;
+    item->first_alphanum = false;
+    item->upper = false;
+    memset(&item->prop, 0, sizeof(item->prop));
+    item->interned = NULL;
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL) {
+	warn(__func__, "called with NULL string");
+	return ret;
+    }
+
+    /*
+     * case: JSON surrounding '"'s are to be ignored
+     */
+    item->as_str_len = len;	/* save length of as_str */
+    if (quote == true) {
+
+	/*
+	 * firewall
+	 */
+	if (len < 2) {
+	    warn(__func__, "quote === true: called with len: %ju < 2", (uintmax_t)len);
+	    return ret;
+	}
+	if (ptr[0] != '"') {
+	    warn(__func__, "quote === true: string does NOT start with a \"");
+	    return ret;
+	}
+	if (ptr[len-1] != '"') {
+	    warn(__func__, "quote === true: string does NOT end with a \"");
+	    return ret;
+	}
+
+	/*
+	 * ignore JSON surrounding '"'s
+	 */
+	item->quote = true;
+	++ptr;
+	len -= 2;
+    }
+
+    /*
+     * duplicate the JSON string, unless it may be referenced in the input
+     *
+     * NOTE: A referenced string is NUL terminated by parse_json_arena_ref()
+     *	     once the parse is complete.
+     */
+    item->as_str = json_arena_ref(ptr, len);
+    if (item->as_str != NULL && json_decode_same(item->as_str, len, &(item->has_nul), &(item->utf8))) {
+
+	/*
+	 * the referenced JSON string decodes to itself
+	 */
+	item->str = item->as_str;
+	item->str_len = len;
+    } else {
+
+	/*
+	 * decode a JSON string that does not decode to itself, duplicating
+	 * it first if it is not referenced in the input
+	 */
+	if (item->as_str == NULL) {
+	    errno = 0;			/* pre-clear errno for errp() */
+	    item->as_str = json_tree_calloc(len+1+1);
+	    if (item->as_str == NULL) {
+		errp(185, __func__, "calloc #1 error allocating %ju bytes", (uintmax_t)(len+1+1));
+		not_reached();
+	    }
+	    strncpy(item->as_str, ptr, len);
+	    item->as_str[len] = '\0';	/* paranoia */
+	    item->as_str[len+1] = '\0';	/* paranoia */
+	}
+
+	/*
+	 * decode the JSON encoded string
+	 */
+	/* decode the entire string */
+	item->has_nul = false;
+	item->str = json_decode_alloc(item->as_str, len, &(item->str_len), &(item->has_nul), &(item->utf8),
+				      json_parse_ctx_arena());
+	if (item->str == NULL) {
+	    warn(__func__, "quote === %s: JSON string decode failed for: <%.*s>",
+			   booltostr(quote), (int)len, item->as_str);
+	    return ret;
+	}
+    }
+    item->converted = true;	/* JSON decoding successful */
+    item->parsed = true;	/* JSON parsed successful */
+
+    /*
+     * determine if decoded string is identical to the original JSON encoded string
+     *
+     * NOTE: We use memcmp() because there might be NUL bytes in the 'char *'
+     * and strcmp() would stop at the first '\0'.
+     */
+    if (item->as_str_len == item->str_len && memcmp(item->as_str, item->str, item->as_str_len) == 0) {
+	item->same = true;	/* decoded string same an original JSON encoded string (perhaps sans '"'s) */
+    }
+
+    /*
+     * determine POSIX state, and the other properties, of the decoded string in a single scan
+     */
+    str_prop_chk(item->str, item->str_len, &item->prop);
+    item->slash = item->prop.slash;
+    item->posix_safe = item->prop.posix_safe;
+    item->first_alphanum = item->prop.first_alphanum;
+    item->upper = item->prop.upper;
+    json_dbg(JSON_DBG_VHIGH, __func__, "JSON return type: %s", json_item_type_name(ret));
+
+    /*
+     * return the JSON parse tree item
+     */
+    return ret;
+}
+
+
+/*
+ * json_conv_string_str - convert JSON encoded string to C string
+ *
+ * This is a simplified interface for json_conv_string(). See that function for details.
+ *
+ * given:
+ *	str	encoded JSON string in the from of a NUL terminated C-style string
+ *	retlen	address of where to store length of str, if retlen != NULL
+ *	quote	true ==> ignore JSON double quotes, both str[0] & str[len-1]
+ *		must be '"', false ==> the entire str is to be converted
+ *
+ * returns:
+ *	allocated JSON parser tree node converted JSON string
+ *
+ * NOTE: retlen, if non-NULL, is set to 0 on error
+ *
+ * NOTE: This function will not return on malloc error.
+ * NOTE: This function will not return NULL.
+ */
+struct json *
+json_conv_string_str(char const *str, size_t *retlen, bool quote)
+{
+    struct json *ret = NULL;		    /* JSON parser tree node to return */
+    size_t len = 0;			    /* length of string to encode */
+
+    /*
+     * firewall
+     *
+     * NOTE: We will let the json_conv_string() handle the arg firewall
      */
     if (str == NULL) {
 	/* the firewall in json_conv_string() called below will handle the NULL str case */
@@ -2954,7 +4254,7 @@ json_conv_bool(char const *ptr, size_t len)
      * duplicate the JSON encoded string
      */
     errno = 0;			/* pre-clear errno for errp() */
-    item->as_str = malloc(len+1+1);
+    item->as_str = json_tree_calloc(len+1+1);
     if (item->as_str == NULL) {
 	errp(188, __func__, "malloc #1 error allocating %ju bytes", (uintmax_t)(len+1+1));
 	not_reached();
@@ -3109,7 +4409,7 @@ json_conv_null(char const *ptr, size_t len)
      * duplicate the JSON string
      */
     errno = 0;			/* pre-clear errno for errp() */
-    item->as_str = malloc(len+1+1);
+    item->as_str = json_tree_calloc(len+1+1);
     if (item->as_str == NULL) {
 	errp(191, __func__, "malloc #1 error allocating %ju bytes", (uintmax_t)(len+1+1));
 	not_reached();
@@ -3169,33 +4469,99 @@ json_conv_null_str(char const *str, size_t *retlen)
      *
      * NOTE: We will let the json_conv_null() handle the arg firewall
      */
-    if (str == NULL) {
-	/* the firewall in json_conv_null() called below will handle the NULL str case */
-	warn(__func__, "called with NULL str");
-    } else {
-	len = strlen(str);
+    if (str == NULL) {
+	/* the firewall in json_conv_null() called below will handle the NULL str case */
+	warn(__func__, "called with NULL str");
+    } else {
+	len = strlen(str);
+    }
+
+    /*
+     * convert to json_conv_null() call
+     */
+    ret = json_conv_null(str, len);
+    if (ret == NULL) {
+	err(192, __func__, "json_conv_null() returned NULL");
+	not_reached();
+    }
+
+    /*
+     * save length if allowed
+     */
+    if (retlen != NULL) {
+	*retlen = len;
+    }
+
+    /*
+     * return the JSON parse tree item
+     */
+    return ret;
+}
+
+
+/*
+ * json_member_intern - replace the text of a JSON member name with its shared copy
+ *
+ * The decoded name is replaced by the copy of the name shared by every member
+ * of the parse with that name.  When the JSON encoded name is the same text,
+ * because no decoding was needed, it too is replaced by the shared copy.
+ * Text that is replaced is freed unless it belongs to an arena.
+ *
+ * given:
+ *	item		JSON string that is the name of a JSON member
+ *	hash		json_name_hash() of the decoded name
+ *	in_arena	true ==> text of item belongs to an arena
+ *
+ * NOTE: This function does nothing if item was not decoded.
+ */
+static void
+json_member_intern(struct json_string *item, uint32_t hash, bool in_arena)
+{
+    struct json_intern_name *shared = NULL;	/* shared JSON member name */
+    char *str = NULL;				/* decoded name before interning */
+    size_t as_len = 0;				/* length of as_str sans JSON '"'s */
+    bool same_text = false;			/* true ==> as_str is the same text as str */
+
+    /*
+     * firewall
+     */
+    if (item == NULL || item->str == NULL || item->as_str == NULL || json_parse_ctx_names() == NULL) {
+	return;
     }
 
     /*
-     * convert to json_conv_null() call
+     * determine if the JSON encoded name is the same text as the decoded name
      */
-    ret = json_conv_null(str, len);
-    if (ret == NULL) {
-	err(192, __func__, "json_conv_null() returned NULL");
-	not_reached();
+    str = item->str;
+    as_len = item->as_str_len;
+    if (item->quote == true && as_len >= 2) {
+	as_len -= 2;
     }
+    same_text = (item->as_str == str) ||
+		(as_len == item->str_len && memcmp(item->as_str, str, as_len) == 0);
 
     /*
-     * save length if allowed
+     * find or make the shared copy of the name
      */
-    if (retlen != NULL) {
-	*retlen = len;
+    shared = json_intern(json_parse_ctx_names(), str, item->str_len, hash, in_arena ? json_parse_ctx_arena() : NULL);
+    item->interned = shared;
+    if (shared->str != str) {
+	if (in_arena == false) {
+	    free(str);
+	}
+	item->str = shared->str;
     }
 
     /*
-     * return the JSON parse tree item
+     * share the JSON encoded name too, if it is the same text
      */
-    return ret;
+    if (same_text == true && item->as_str != item->str) {
+	if (in_arena == false && item->as_str != str) {
+	    free(item->as_str);
+	}
+	item->as_str = item->str;
+    }
+    return;
 }
 
 
@@ -3253,6 +4619,7 @@ json_conv_member(struct json *name, struct json *value)
     item->parsed = false;
     item->name_as_str = NULL;
     item->name_str = NULL;
+    item->name_hash = 0;
     item->name = NULL;
     item->value = NULL;
 
@@ -3325,6 +4692,16 @@ json_conv_member(struct json *name, struct json *value)
     }
     item->name_as_str_len = item2->as_str_len;
     item->name_str_len = item2->str_len;
+    item->name_hash = json_name_hash(item->name_str, item->name_str_len);
+
+    /*
+     * share one copy of each member name of the parse
+     */
+    if (json_parse_ctx_names() != NULL && item2->interned == NULL) {
+	json_member_intern(item2, item->name_hash, ret->in_arena);
+	item->name_as_str = item2->as_str;
+	item->name_str = item2->str;
+    }
 
     /*
      * return the JSON parse tree item
@@ -3375,11 +4752,12 @@ json_create_object(void)
     item->len = 0;
     item->set = NULL;
     item->s = NULL;
+    item->index = NULL;
 
     /*
      * create a dynamic array to store JSON objects
      */
-    item->s = dyn_array_create(sizeof (struct json *), JSON_CHUNK, JSON_CHUNK, true);
+    item->s = json_set_create();
     if (item->s == NULL) {
 	errp(197, __func__, "dyn_array_create() returned NULL");
 	not_reached();
@@ -3470,10 +4848,14 @@ json_object_add_member(struct json *node, struct json *member)
     /*
      * append member
      */
-    moved = dyn_array_append_value(item->s, &member);
-    if (moved == true) {
-	dbg(DBG_HIGH, "in %s(): dyn_array_append_value moved data",
-		      __func__);
+    if (node->in_arena == true) {
+	json_set_append(node, item->s, member);
+    } else {
+	moved = dyn_array_append_value(item->s, &member);
+	if (moved == true) {
+	    dbg(DBG_HIGH, "in %s(): dyn_array_append_value moved data",
+			  __func__);
+	}
     }
 
     /*
@@ -3482,6 +4864,11 @@ json_object_add_member(struct json *node, struct json *member)
     item->len = dyn_array_tell(item->s);
     item->set = dyn_array_addr(item->s, struct json *, 0);
 
+    /*
+     * index the member by name, once the object is large enough to be indexed
+     */
+    json_object_index_add(node, item->len - 1);
+
     json_dbg(JSON_DBG_VHIGH, __func__, "JSON object node type: %s", json_item_type_name(node));
     json_dbg(JSON_DBG_VHIGH, __func__, "JSON object member type: %s", json_item_type_name(member));
 
@@ -3532,7 +4919,7 @@ json_create_elements(void)
     /*
      * create a dynamic array to store JSON values
      */
-    item->s = dyn_array_create(sizeof (struct json *), JSON_CHUNK, JSON_CHUNK, true);
+    item->s = json_set_create();
     if (item->s == NULL) {
 	errp(204, __func__, "dyn_array_create() returned NULL");
 	not_reached();
@@ -3636,10 +5023,14 @@ json_elements_add_value(struct json *node, struct json *value)
     /*
      * append value
      */
-    moved = dyn_array_append_value(item->s, &value);
-    if (moved == true) {
-	dbg(DBG_HIGH, "in %s(): dyn_array_append_value moved data",
-		      __func__);
+    if (node->in_arena == true) {
+	json_set_append(node, item->s, value);
+    } else {
+	moved = dyn_array_append_value(item->s, &value);
+	if (moved == true) {
+	    dbg(DBG_HIGH, "in %s(): dyn_array_append_value moved data",
+			  __func__);
+	}
     }
 
     /*
@@ -3697,7 +5088,7 @@ json_create_array(void)
     /*
      * create a dynamic array to store JSON arrays
      */
-    item->s = dyn_array_create(sizeof (struct json *), JSON_CHUNK, JSON_CHUNK, true);
+    item->s = json_set_create();
     if (item->s == NULL) {
 	errp(212, __func__, "dyn_array_create() returned NULL");
 	not_reached();
@@ -3718,3 +5109,468 @@ json_create_array(void)
      */
     return ret;
 }
+
+
+/*
+ * json_tree_calloc - allocate zeroized JSON parse tree storage
+ *
+ * When a parse is using an arena (see parse_json_arena()), the storage
+ * comes from that arena, otherwise it comes from calloc(3).
+ *
+ * given:
+ *	size	number of bytes to allocate
+ *
+ * returns:
+ *	pointer to size zeroized bytes, or NULL ==> calloc(3) error
+ */
+static void *
+json_tree_calloc(size_t size)
+{
+    if (json_parse_ctx_arena() != NULL) {
+	return json_arena_alloc(json_parse_ctx_arena(), size);
+    }
+    return calloc(1, size);
+}
+
+
+/*
+ * json_set_create - create the dynamic array of a JSON object, array or elements
+ *
+ * When a parse is using an arena (see parse_json_arena()), both the
+ * dynamic array and its data come from that arena, and the data is
+ * grown by json_set_append() instead of by dyn_array_append_value().
+ *
+ * returns:
+ *	dynamic array of struct json pointers, or NULL ==> dyn_array_create() error
+ */
+static struct dyn_array *
+json_set_create(void)
+{
+    struct dyn_array *s = NULL;		/* dynamic array to return */
+
+    /*
+     * case: not using an arena
+     *
+     * A large JSON array or object would be copied over and over were it to
+     * grow by a fixed chunk, so it doubles instead, as an arena set does.
+     */
+    if (json_parse_ctx_arena() == NULL) {
+	s = dyn_array_create(sizeof (struct json *), JSON_CHUNK, JSON_CHUNK, true);
+	if (s != NULL) {
+	    dyn_array_set_growth(s, DYN_ARRAY_GROW_GEOMETRIC, DYN_ARRAY_GROW_PCT, 0);
+	}
+	return s;
+    }
+
+    /*
+     * form a dynamic array in the arena
+     *
+     * Most JSON objects and arrays are small, so we start with room for
+     * only a few pointers and double as needed.
+     */
+    s = json_arena_alloc(json_parse_ctx_arena(), sizeof(*s));
+    s->elm_size = sizeof (struct json *);
+    s->zeroize = true;
+    s->count = 0;
+    s->allocated = JSON_ARENA_SET_START;
+    s->chunk = JSON_ARENA_SET_START;
+    s->data = json_arena_alloc(json_parse_ctx_arena(), (size_t)s->allocated * s->elm_size);
+    return s;
+}
+
+
+/*
+ * json_set_append - append a JSON node to an arena dynamic array
+ *
+ * given:
+ *	node	arena JSON object or elements node that owns s
+ *	s	dynamic array formed by json_set_create() while using an arena
+ *	value	JSON node to append
+ *
+ * NOTE: This function does not return on error.
+ */
+static void
+json_set_append(struct json *node, struct dyn_array *s, struct json *value)
+{
+    intmax_t allocated = 0;		/* new number of allocated pointers */
+
+    /*
+     * firewall
+     */
+    if (json_parse_ctx_arena() == NULL) {
+	err(213, __func__, "arena node: %s is being modified outside of parse_json_arena()",
+			   json_item_type_name(node));
+	not_reached();
+    }
+
+    /*
+     * double the set if full
+     */
+    if (s->count >= s->allocated) {
+	allocated = s->allocated * 2;
+	s->data = json_arena_grow(json_parse_ctx_arena(), s->data, (size_t)s->allocated * s->elm_size,
+						  (size_t)allocated * s->elm_size);
+	s->allocated = allocated;
+	s->chunk = allocated;
+	json_dbg(JSON_DBG_VHIGH, __func__, "grew arena set of %s to %jd",
+				 json_item_type_name(node), s->allocated);
+    }
+
+    /*
+     * append the value
+     */
+    ((struct json **)(s->data))[s->count] = value;
+    ++s->count;
+    return;
+}
+
+
+/*
+ * json_parse_ctx_arena - return the arena of the current parse
+ *
+ * returns:
+ *	arena the current parse allocates from, or NULL ==> no parse or no arena
+ */
+static struct json_arena *
+json_parse_ctx_arena(void)
+{
+    return json_parse_current != NULL ? json_parse_current->arena : NULL;
+}
+
+
+/*
+ * json_parse_ctx_names - return the member name table of the current parse
+ *
+ * returns:
+ *	member name table of the current parse, or NULL ==> no parse or no table
+ */
+static struct json_intern *
+json_parse_ctx_names(void)
+{
+    return json_parse_current != NULL ? json_parse_current->names : NULL;
+}
+
+
+/*
+ * json_parse_ctx_init - initialize the context of a parse
+ *
+ * given:
+ *	ctx		pointer to the context to initialize
+ *	filename	filename being parsed or NULL ==> stdin
+ *	arena		arena to allocate the parse tree from or NULL ==> calloc(3)
+ *
+ * NOTE: This function does not return if ctx is NULL.
+ */
+void
+json_parse_ctx_init(struct json_parse_ctx *ctx, char const *filename, struct json_arena *arena)
+{
+    /*
+     * firewall
+     */
+    if (ctx == NULL) {
+	err(214, __func__, "ctx is NULL");
+	not_reached();
+    }
+
+    /*
+     * initialize the context
+     */
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->filename = filename != NULL ? filename : "-";
+    ctx->arena = arena;
+    return;
+}
+
+
+/*
+ * json_parse_ctx_enter - make a context the context of the current parse
+ *
+ * The context that was current on the calling thread is saved in ctx and
+ * is made current again by json_parse_ctx_leave().
+ *
+ * given:
+ *	ctx	pointer to the context of a parse that is starting
+ *
+ * NOTE: This function does not return if ctx is NULL.
+ */
+void
+json_parse_ctx_enter(struct json_parse_ctx *ctx)
+{
+    /*
+     * firewall
+     */
+    if (ctx == NULL) {
+	err(215, __func__, "ctx is NULL");
+	not_reached();
+    }
+
+    /*
+     * stack the context on top of the one in use
+     */
+    ctx->prev = json_parse_current;
+    json_parse_current = ctx;
+    return;
+}
+
+
+/*
+ * json_parse_ctx_leave - restore the context in use before json_parse_ctx_enter()
+ *
+ * given:
+ *	ctx	pointer to the context of a parse that is complete
+ *
+ * NOTE: This function does not return if ctx is NULL or is not the current context.
+ */
+void
+json_parse_ctx_leave(struct json_parse_ctx *ctx)
+{
+    /*
+     * firewall
+     */
+    if (ctx == NULL) {
+	err(216, __func__, "ctx is NULL");
+	not_reached();
+    }
+    if (ctx != json_parse_current) {
+	err(217, __func__, "ctx is not the context of the current parse");
+	not_reached();
+    }
+
+    /*
+     * restore the enclosing context
+     */
+    json_parse_current = ctx->prev;
+    ctx->prev = NULL;
+    return;
+}
+
+
+/*
+ * json_parse_ctx_free - free what the context of a parse holds once the parse is done
+ *
+ * A context may be entered and left more than once during its parse, as a
+ * push parse does for each piece of the JSON, so what the context holds is
+ * not freed by json_parse_ctx_leave().
+ *
+ * given:
+ *	ctx	pointer to the context of a parse that is done
+ *
+ * NOTE: Neither ctx itself nor the parse tree is freed.
+ *
+ * NOTE: This function does not return if ctx is NULL.
+ */
+void
+json_parse_ctx_free(struct json_parse_ctx *ctx)
+{
+    /*
+     * firewall
+     */
+    if (ctx == NULL) {
+	err(219, __func__, "ctx is NULL");
+	not_reached();
+    }
+
+    /*
+     * free the member counts of the resource limits
+     */
+    if (ctx->members != NULL) {
+	free(ctx->members);
+	ctx->members = NULL;
+    }
+    ctx->members_alloc = 0;
+    return;
+}
+
+
+/*
+ * json_parse_nest - count the open JSON objects and arrays of a parse
+ *
+ * This function is called by the scanner for every {, [, } and ] token,
+ * before json_parse_limit().  When a { or [ would nest deeper than
+ * JSON_PARSE_MAX_DEPTH, the depth is reported on stderr, unless the parse is
+ * quiet, and false is returned so that the scanner stops the parse.
+ *
+ * given:
+ *	ctx	context of the parse
+ *	text	text of the token
+ *	line	line of the token
+ *	column	column of the token
+ *
+ * returns:
+ *	true ==> token is within JSON_PARSE_MAX_DEPTH,
+ *	false ==> token nests too deep
+ */
+bool
+json_parse_nest(struct json_parse_ctx *ctx, char const *text, int line, int column)
+{
+    /*
+     * firewall
+     */
+    if (ctx == NULL || text == NULL) {
+	return true;
+    }
+    if (ctx->limit_crossed == true) {
+	return false;
+    }
+
+    /*
+     * count the token
+     */
+    switch (text[0]) {
+    case '{':	/*fallthrough*/
+    case '[':
+	if (ctx->depth >= JSON_PARSE_MAX_DEPTH) {
+	    if (ctx->quiet == false) {
+		fpr(stderr, __func__, "JSON nesting depth %ju exceeds the limit of %ju in file %s at line %d column %d\n",
+		    ctx->depth + 1, (uintmax_t)JSON_PARSE_MAX_DEPTH,
+		    (ctx->filename != NULL) ? ctx->filename : "-", line, column);
+	    }
+	    ctx->limit_crossed = true;
+	    return false;
+	}
+	++ctx->depth;
+	break;
+    case '}':	/*fallthrough*/
+    case ']':
+	if (ctx->depth > 0) {
+	    --ctx->depth;
+	}
+	break;
+    default:
+	break;
+    }
+    return true;
+}
+
+
+/*
+ * json_parse_limit - check a scanned JSON token against the resource limits of a parse
+ *
+ * This function is called by the scanner for every JSON token except
+ * whitespace.  When the token crosses a limit, the limit is reported on
+ * stderr, unless the parse is quiet, and false is returned so that the
+ * scanner stops the parse.
+ *
+ * given:
+ *	ctx	context of the parse
+ *	text	text of the token
+ *	len	length of the token
+ *	line	line of the token
+ *	column	column of the token
+ *
+ * returns:
+ *	true ==> token is within the limits or the parse has no limits,
+ *	false ==> token crossed a limit
+ *
+ * NOTE: This function does not return on malloc error.
+ */
+bool
+json_parse_limit(struct json_parse_ctx *ctx, char const *text, size_t len, int line, int column)
+{
+    struct json_limits const *lim = NULL;	/* resource limits of the parse */
+    uintmax_t *members = NULL;			/* reallocated member counts */
+    uintmax_t alloc = 0;			/* number of member counts to allocate */
+    char const *what = NULL;			/* limit crossed or NULL ==> none */
+    uintmax_t amount = 0;			/* amount that crossed the limit */
+    uintmax_t limit = 0;			/* limit that was crossed */
+
+    /*
+     * firewall
+     */
+    if (ctx == NULL || ctx->limits == NULL || text == NULL) {
+	return true;
+    }
+    if (ctx->limit_crossed == true) {
+	return false;
+    }
+    lim = ctx->limits;
+
+    /*
+     * check the token
+     */
+    switch (text[0]) {
+    case '{':	/*fallthrough*/
+    case '[':
+	/* the scanner has counted the object or array in the depth */
+	++ctx->nodes;
+	if (lim->max_depth > 0 && ctx->depth > lim->max_depth) {
+	    what = "JSON nesting depth";
+	    amount = ctx->depth;
+	    limit = lim->max_depth;
+	    break;
+	}
+
+	/* start counting the members of the object */
+	if (lim->max_members > 0) {
+	    if (ctx->depth > ctx->members_alloc) {
+		alloc = (ctx->members_alloc > 0) ? ctx->members_alloc * 2 : JSON_CHUNK;
+		errno = 0;			/* pre-clear errno for errp() */
+		members = realloc(ctx->members, (size_t)alloc * sizeof(ctx->members[0]));
+		if (members == NULL) {
+		    errp(218, __func__, "realloc of %ju member counts failed", alloc);
+		    not_reached();
+		}
+		ctx->members = members;
+		ctx->members_alloc = alloc;
+	    }
+	    ctx->members[ctx->depth-1] = 0;
+	}
+	break;
+    case '}':	/*fallthrough*/
+    case ']':
+	break;
+    case ':':
+	/* a : is the start of a JSON member of the innermost object */
+	++ctx->nodes;
+	if (lim->max_members > 0 && ctx->depth > 0 && ctx->members != NULL) {
+	    ++ctx->members[ctx->depth-1];
+	    if (ctx->members[ctx->depth-1] > lim->max_members) {
+		what = "JSON object member count";
+		amount = ctx->members[ctx->depth-1];
+		limit = lim->max_members;
+	    }
+	}
+	break;
+    case ',':
+	break;
+    case '"':
+	++ctx->nodes;
+	if (lim->max_str_len > 0 && len > lim->max_str_len) {
+	    what = "JSON string length";
+	    amount = (uintmax_t)len;
+	    limit = (uintmax_t)lim->max_str_len;
+	}
+	break;
+    case 't':	/*fallthrough*/
+    case 'f':	/*fallthrough*/
+    case 'n':
+	++ctx->nodes;
+	break;
+    default:
+	++ctx->nodes;
+	if (lim->max_num_len > 0 && len > lim->max_num_len) {
+	    what = "JSON number length";
+	    amount = (uintmax_t)len;
+	    limit = (uintmax_t)lim->max_num_len;
+	}
+	break;
+    }
+    if (what == NULL && lim->max_nodes > 0 && ctx->nodes > lim->max_nodes) {
+	what = "JSON parse tree node count";
+	amount = ctx->nodes;
+	limit = lim->max_nodes;
+    }
+
+    /*
+     * report the limit that was crossed
+     */
+    if (what != NULL) {
+	if (ctx->quiet == false) {
+	    fpr(stderr, __func__, "%s %ju exceeds the limit of %ju in file %s at line %d column %d\n",
+		what, amount, limit, (ctx->filename != NULL) ? ctx->filename : "-", line, column);
+	}
+	ctx->limit_crossed = true;
+	return false;
+    }
+    return true;
+}
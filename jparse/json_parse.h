@@ -25,6 +25,16 @@
  */
 #include "util.h"
 
+/*
+ * json_arena - JSON parse tree arena allocator
+ */
+#include "json_arena.h"
+
+/*
+ * json_intern - JSON member name interning
+ */
+#include "json_intern.h"
+
 
 /*
  * definitions
@@ -79,14 +89,19 @@ struct encode
  * the number of bytes, starting with first, that contain the actual
  * JSON number string.
  *
- * If is_floating == false, then the JSON number was attempted to be converted
- * as an integer.  In this case the "integer values" fields will be used and
- * the "floating point values" fields will be unused (set to false, or 0.0);
+ * If is_integer == true, then the JSON number was attempted to be converted
+ * as an integer.  If integer_converted == true, the value is in as_maxint when
+ * is_negative == true, or in as_umaxint otherwise.
+ *
+ * If is_floating == true or is_e_notation == true, then the JSON number was
+ * attempted to be converted as a floating point value.  If converted == true,
+ * and integer_converted == false, the value is in as_longdouble.
  *
- * If is_floating == true then, then the JSON number was attempted to be converted
- * as a floating point value. In this case the "floating point values" fields
- * will be used, and the "integer values" fields will be unused (set to false,
- * or 0).
+ * Only the widest C form of a JSON number is stored.  Use the json_number_int8(),
+ * json_number_size(), json_number_double(), etc. accessor functions to obtain
+ * the value in a given C type.  Such a function returns false if the number
+ * does not fit into that type.  Narrower floating point values are converted
+ * from the JSON number string only when asked for.
  *
  * A JSON number string is of the form:
  *
@@ -123,6 +138,44 @@ struct json_number
     bool is_e_notation;		/* true ==> e notation used such as 1e10, false ==> no e notation found */
     bool is_integer;		/* true ==> converted to some integer type below */
 
+    bool integer_converted;	/* true ==> JSON integer value is in as_maxint or as_umaxint */
+    bool as_longdouble_int;	/* if floating point was converted, true ==> as_longdouble is an integer */
+
+    /* widest converted C value, if converted == true */
+    union {
+	intmax_t as_maxint;		/* integer_converted && is_negative: JSON integer value */
+	uintmax_t as_umaxint;		/* integer_converted && !is_negative: JSON integer value */
+	long double as_longdouble;	/* !integer_converted: JSON floating point value */
+    };
+};
+
+
+/*
+ * every C form of a JSON number
+ *
+ * The json_number_expand() function fills in this structure from a
+ * struct json_number by calling each of the json_number_int8(), etc.
+ * accessor functions.  Each value is 0 unless the matching _sized is true.
+ * This is for test suites and debugging: it is about four times the size
+ * of a struct json_number.
+ */
+struct json_number_expanded
+{
+    bool parsed;		/* true ==> able to parse correctly */
+    bool converted;		/* true ==> able to convert JSON number string to some form of C value */
+
+    char *as_str;		/* allocated copy of the original allocated JSON number, NUL terminated */
+    char *first;		/* first whitespace character */
+
+    size_t as_str_len;		/* length of as_str */
+    size_t number_len;		/* length of JSON number, w/o leading or trailing whitespace and NUL bytes */
+
+    bool is_negative;		/* true ==> value < 0 */
+
+    bool is_floating;		/* true ==> as_str had a '.' in it such as 1.234, false ==> no '.' found */
+    bool is_e_notation;		/* true ==> e notation used such as 1e10, false ==> no e notation found */
+    bool is_integer;		/* true ==> converted to some integer type below */
+
     /* integer values */
 
     bool int8_sized;		/* true ==> converted JSON integer to C int8_t */
@@ -231,11 +284,15 @@ struct json_string
 
     bool same;			/* true => as_str same as str, JSON decoding not required */
     bool has_nul;		/* true ==> decoded JSON string has a NUL byte inside it */
+    bool utf8;			/* true ==> decoded JSON string is valid UTF-8 */
 
     bool slash;			/* true ==> / was found after decoding */
     bool posix_safe;		/* true ==> all chars are POSIX portable safe plus + and maybe / after decoding */
     bool first_alphanum;	/* true ==> first char is alphanumeric after decoding */
     bool upper;			/* true ==> UPPER case chars found after decoding */
+    struct str_prop prop;	/* properties of the decoded string, found when the above were */
+
+    struct json_intern_name *interned;	/* != NULL ==> str is a shared JSON member name, else NULL */
 };
 
 
@@ -325,6 +382,7 @@ struct json_member
 
     size_t name_as_str_len;	/* length of name_as_str, not including final NUL */
     size_t name_str_len;	/* length of name_str, not including final NUL */
+    uint32_t name_hash;		/* json_name_hash() of name_str or 0 ==> not hashed */
 
     struct json *name;		/* JSON string name */
     struct json *value;		/* JSON value */
@@ -355,6 +413,7 @@ struct json_object
     struct json **set;		/* set of JSON members belonging to the object */
 
     struct dyn_array *s;	/* dynamic array managed storage for the JSON object */
+    struct json_member_index *index;	/* hash index of members by name or NULL ==> not indexed */
 };
 
 
@@ -438,6 +497,7 @@ enum item_type {
 struct json
 {
     enum item_type type;		/* union item specifier */
+    bool in_arena;			/* true ==> node and its storage belong to a struct json_arena */
     union json_union {
 	struct json_number number;	/* JTYPE_NUMBER - value is number (integer or floating point) */
 	struct json_string string;	/* JTYPE_STRING - value is a string */
@@ -456,9 +516,73 @@ struct json
 };
 
 
+/*
+ * JSON_PARSE_MAX_DEPTH - deepest nesting of JSON objects and arrays that any parse accepts
+ *
+ * The parser, the event and push parsers and the validators all stop at
+ * this depth so that they agree on what is valid JSON.  The parser stack
+ * (YYMAXDEPTH in jparse.y) is sized to hold it.
+ */
+#define JSON_PARSE_MAX_DEPTH (10000)
+
+
+/*
+ * json_limits - resource limits of a parse
+ *
+ * A parse stops at the first token that crosses a limit.  A limit of 0 means
+ * no limit.  The nodes are those of the JSON parse tree that the parse would
+ * form: every JSON value and every JSON member and its name.
+ */
+struct json_limits
+{
+    size_t max_bytes;		/* longest JSON document, in bytes */
+    uintmax_t max_depth;	/* deepest nesting of JSON objects and arrays */
+    uintmax_t max_nodes;	/* most JSON parse tree nodes */
+    size_t max_str_len;		/* longest JSON string, in bytes as encoded with its '"'s */
+    size_t max_num_len;		/* longest JSON number, in bytes */
+    uintmax_t max_members;	/* most members of a JSON object */
+};
+
+
+/*
+ * json_parse_ctx - the state of a single parse
+ *
+ * Each parse has its own context, which lives for the duration of the parse
+ * and is shared by nothing else.  The scanner and parser reach it as their
+ * extra data and the conversion functions through json_parse_current, so
+ * that parses on different threads, or a parse started by a callback of
+ * another parse, never share state.
+ *
+ * When the input is part of a larger file, such as a record of a JSON Lines
+ * file, line is the line of the file on which the input starts so that
+ * messages give lines of the file rather than of the input.
+ */
+struct json_parse_ctx
+{
+    char const *filename;		/* filename being parsed ("-" means stdin) */
+    uintmax_t line;			/* line of the file on which the input starts, 0 ==> 1 */
+    bool quiet;				/* true ==> do not report syntax errors and limits */
+    struct json_arena *arena;		/* arena the parse tree is allocated from or NULL */
+    char *ref;				/* input referenced by the parse tree or NULL */
+    size_t ref_len;			/* length of ref */
+    struct json_intern *names;		/* member name table of the parse or NULL */
+    uintmax_t syntax_errors;		/* number of syntax errors reported by the parser */
+    struct json_limits const *limits;	/* resource limits of the parse or NULL ==> no limits */
+    bool limit_crossed;			/* true ==> the parse was stopped by a resource limit */
+    uintmax_t depth;			/* number of open JSON objects and arrays */
+    uintmax_t nodes;			/* number of JSON parse tree nodes scanned, if limits != NULL */
+    uintmax_t *members;			/* members of each open JSON object by depth or NULL */
+    uintmax_t members_alloc;		/* number of elements allocated for members */
+    struct json_parse_ctx *prev;	/* context of the enclosing parse on this thread or NULL */
+};
+
+
 /*
  * global variables
+ *
+ * NOTE: This is the context of the parse in progress on the calling thread.
  */
+extern _Thread_local struct json_parse_ctx *json_parse_current;	/* context of the current parse or NULL */
 
 /*
  * external data structures
@@ -472,6 +596,9 @@ extern struct encode jenc[];
  * external function declarations
  */
 extern char *json_encode(char const *ptr, size_t len, size_t *retlen, bool skip_quote);
+extern size_t json_encode_run(char const *ptr, size_t len);
+extern char *json_encode_buf(char const *ptr, size_t len, char **buf, size_t *bufsize, size_t *retlen,
+			     bool skip_quote);
 extern char *json_encode_str(char const *str, size_t *retlen, bool skip_quote);
 extern void jencchk(void);
 extern char *json_decode(char const *ptr, size_t len, size_t *retlen, bool *has_nul);
@@ -485,6 +612,29 @@ extern struct json *parse_json_member(struct json *name, struct json *value);
 extern struct json *json_alloc(enum item_type type);
 extern struct json *json_conv_number(char const *ptr, size_t len);
 extern struct json *json_conv_number_str(char const *str, size_t *retlen);
+extern bool json_number_int8(struct json_number const *item, int8_t *ret);
+extern bool json_number_uint8(struct json_number const *item, uint8_t *ret);
+extern bool json_number_int16(struct json_number const *item, int16_t *ret);
+extern bool json_number_uint16(struct json_number const *item, uint16_t *ret);
+extern bool json_number_int32(struct json_number const *item, int32_t *ret);
+extern bool json_number_uint32(struct json_number const *item, uint32_t *ret);
+extern bool json_number_int64(struct json_number const *item, int64_t *ret);
+extern bool json_number_uint64(struct json_number const *item, uint64_t *ret);
+extern bool json_number_int(struct json_number const *item, int *ret);
+extern bool json_number_uint(struct json_number const *item, unsigned int *ret);
+extern bool json_number_long(struct json_number const *item, long *ret);
+extern bool json_number_ulong(struct json_number const *item, unsigned long *ret);
+extern bool json_number_longlong(struct json_number const *item, long long *ret);
+extern bool json_number_ulonglong(struct json_number const *item, unsigned long long *ret);
+extern bool json_number_ssize(struct json_number const *item, ssize_t *ret);
+extern bool json_number_size(struct json_number const *item, size_t *ret);
+extern bool json_number_off(struct json_number const *item, off_t *ret);
+extern bool json_number_maxint(struct json_number const *item, intmax_t *ret);
+extern bool json_number_umaxint(struct json_number const *item, uintmax_t *ret);
+extern bool json_number_float(struct json_number const *item, float *ret, bool *is_int);
+extern bool json_number_double(struct json_number const *item, double *ret, bool *is_int);
+extern bool json_number_longdouble(struct json_number const *item, long double *ret, bool *is_int);
+extern void json_number_expand(struct json_number const *item, struct json_number_expanded *exp);
 extern struct json *json_conv_string(char const *ptr, size_t len, bool quote);
 extern struct json *json_conv_string_str(char const *str, size_t *retlen, bool quote);
 extern struct json *json_conv_bool(char const *ptr, size_t len);
@@ -497,6 +647,12 @@ extern struct json *json_object_add_member(struct json *node, struct json *membe
 extern struct json *json_create_elements(void);
 extern struct json *json_elements_add_value(struct json *node, struct json *value);
 extern struct json *json_create_array(void);
+extern void json_parse_ctx_init(struct json_parse_ctx *ctx, char const *filename, struct json_arena *arena);
+extern void json_parse_ctx_enter(struct json_parse_ctx *ctx);
+extern void json_parse_ctx_leave(struct json_parse_ctx *ctx);
+extern void json_parse_ctx_free(struct json_parse_ctx *ctx);
+extern bool json_parse_nest(struct json_parse_ctx *ctx, char const *text, int line, int column);
+extern bool json_parse_limit(struct json_parse_ctx *ctx, char const *text, size_t len, int line, int column);
 
 
 #endif /* INCLUDE_JSON_PARSE_H */
@@ -0,0 +1,529 @@
+/*
+ * json_push - push parser for JSON that arrives in pieces
+ *
+ * "Because sometimes the JSON is still on its way." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+/*
+ * jparse.lex.h - generated by flex
+ */
+#include "jparse.lex.h"
+
+
+/*
+ * json_push - state of a push parse
+ *
+ * The bytes fed to the parse are held until they end on a token boundary:
+ * a point that no token of the scanner can span.  The bytes before the last
+ * such boundary are then scanned, and each token is pushed to the bison push
+ * parser, so only the bytes of an incomplete token are held between pieces.
+ *
+ * A boundary is just before a run of whitespace or just after a structural
+ * character outside of a JSON string, or just after a '"' that must close a
+ * JSON string.  Note that a \" can both continue and close a JSON_STRING of
+ * the scanner (see jparse.l), so that the scanner's string ends at the last
+ * '"' before the first '"' that is not preceded by a \, or before the first
+ * control byte.
+ */
+struct json_push
+{
+    struct json_parse_ctx ctx;	/* context of the parse, the extra data of the scanner */
+    yyscan_t scanner;		/* flex scanner */
+    jparse_pstate *pstate;	/* bison push parser */
+    JPARSE_LTYPE lloc;		/* location of the current token */
+    struct json *tree;		/* JSON parse tree formed by the parser */
+    int status;			/* YYPUSH_MORE ==> parse goes on, 0 ==> valid JSON, else invalid JSON */
+    uintmax_t total;		/* number of bytes fed */
+    size_t linenum;		/* line number of the last byte fed */
+    size_t byte_pos;		/* byte position of the last byte fed within its line */
+
+    char *held;			/* bytes fed but not yet scanned */
+    size_t held_len;		/* number of bytes held */
+    size_t held_alloc;		/* number of bytes allocated for held */
+    size_t seen;		/* bytes of held looked at for token boundaries */
+    size_t cut;			/* bytes of held before the last token boundary */
+    bool in_string;		/* true ==> the bytes seen end inside a JSON string */
+    size_t str_start;		/* offset in held of the '"' that opens the JSON string */
+    size_t str_quote;		/* offset in held of the last \" of the JSON string or SIZE_MAX */
+};
+
+
+/*
+ * static functions
+ */
+static bool push_low_byte(struct json_push *push, char const *buf, size_t len);
+static void push_bound(struct json_push *push);
+static void push_scan(struct json_push *push, size_t len, bool eof);
+
+
+/*
+ * push_low_byte - look for a byte a JSON document may not have in a piece
+ *
+ * The document as a whole cannot be pre-scanned for [\x00-\x08\x0e-\x1f]
+ * bytes, as parse_json_stream() does, so each piece is scanned as it is fed.
+ * Only the first such byte is reported: the parse ends there.
+ *
+ * given:
+ *	push	push parse state
+ *	buf	piece of the JSON document
+ *	len	length of the piece
+ *
+ * returns:
+ *	true ==> a NUL or low byte was found,
+ *	false ==> no NUL or low byte was found
+ */
+static bool
+push_low_byte(struct json_push *push, char const *buf, size_t len)
+{
+    unsigned char c;	/* byte being looked at */
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+	c = (unsigned char)buf[i];
+
+	/* count this byte within the line */
+	++push->byte_pos;
+
+	if (c == '\n') {
+	    ++push->linenum;
+	    push->byte_pos = 0;
+	} else if (c == '\0') {
+	    werr(100, __func__, "invalid NUL (0) byte detected in line: %zu byte position: %zu",
+		     push->linenum, push->byte_pos);
+	    return true;
+	} else if (c <= 0x08 || (c >= 0x0e && c <= 0x1f)) {
+	    werr(101, __func__, "invalid LOW byte 0x%02x detected in line: %zu byte position: %zu",
+		     c, push->linenum, push->byte_pos);
+	    return true;
+	}
+    }
+    return false;
+}
+
+
+/*
+ * push_bound - find the last token boundary of the bytes held
+ *
+ * given:
+ *	push	push parse state
+ *
+ * Only the bytes held that were not seen before are looked at.
+ */
+static void
+push_bound(struct json_push *push)
+{
+    unsigned char c;	/* byte being looked at */
+    size_t i;
+
+    for (i = push->seen; i < push->held_len; ++i) {
+	c = (unsigned char)push->held[i];
+
+	/*
+	 * case: outside of a JSON string
+	 */
+	if (push->in_string == false) {
+	    switch (c) {
+	    case '"':
+		push->in_string = true;
+		push->str_start = i;
+		push->str_quote = SIZE_MAX;
+		break;
+	    case ' ':
+	    case '\t':
+	    case '\r':
+	    case '\n':
+		/* whitespace is only cut before, as the column of a token depends on the run it follows */
+		if (i > 0 && strchr(" \t\r\n", push->held[i - 1]) == NULL) {
+		    push->cut = i;
+		}
+		break;
+	    case '{':
+	    case '}':
+	    case '[':
+	    case ']':
+	    case ',':
+	    case ':':
+		push->cut = i + 1;
+		break;
+	    default:
+		break;
+	    }
+
+	/*
+	 * case: '"' in a JSON string
+	 */
+	} else if (c == '"') {
+	    if (push->held[i - 1] == '\\') {
+		/* \" may continue or close the JSON string */
+		push->str_quote = i;
+	    } else {
+		/* the JSON string must close here */
+		push->in_string = false;
+		push->cut = i + 1;
+	    }
+
+	/*
+	 * case: control byte in a JSON string
+	 *
+	 * The scanner's JSON string ends at the last \" or, when there is
+	 * none, the opening '"' is an invalid token: go on just after it.
+	 */
+	} else if (c >= 0x01 && c <= 0x1f) {
+	    i = (push->str_quote != SIZE_MAX) ? push->str_quote : push->str_start;
+	    push->in_string = false;
+	    push->cut = i + 1;
+	}
+    }
+    push->seen = push->held_len;
+    return;
+}
+
+
+/*
+ * push_scan - scan bytes held and push their tokens to the parser
+ *
+ * given:
+ *	push	push parse state
+ *	len	number of bytes at the start of held to scan
+ *	eof	true ==> the bytes end the JSON document
+ *
+ * The bytes scanned are no longer held.
+ */
+static void
+push_scan(struct json_push *push, size_t len, bool eof)
+{
+    YY_BUFFER_STATE bs = NULL;	/* scanner buffer of the bytes */
+    int tok = 0;		/* token returned by the scanner */
+
+    /*
+     * scan a copy of the bytes
+     */
+    bs = jparse__scan_bytes(push->held, (int)len, push->scanner);
+    if (bs == NULL) {
+	werr(102, __func__, "unable to scan %ju bytes", (uintmax_t)len);
+	push->status = 1;
+	return;
+    }
+
+    /*
+     * push each token until the end of the bytes or of the parse
+     *
+     * The parser reduces a token before this returns when it can, so a
+     * grammar action finds the text of the token in the scanner just as
+     * it does in jparse_parse().
+     */
+    json_parse_ctx_enter(&push->ctx);
+    while (push->status == YYPUSH_MORE) {
+	tok = jparse_lex(NULL, &push->lloc, push->scanner);
+	if (tok == JPARSE_EOF && eof == false) {
+	    break;
+	}
+	push->status = jparse_push_parse(push->pstate, tok, NULL, &push->lloc, &push->tree, push->scanner);
+	if (tok == JPARSE_EOF) {
+	    break;
+	}
+    }
+    json_parse_ctx_leave(&push->ctx);
+    jparse__delete_buffer(bs, push->scanner);
+
+    /*
+     * hold only what was not scanned
+     */
+    if (push->held_len > len) {
+	memmove(push->held, push->held + len, push->held_len - len);
+    }
+    push->held_len -= len;
+    push->seen -= len;
+    push->cut -= len;
+    if (push->in_string) {
+	push->str_start -= len;
+	if (push->str_quote != SIZE_MAX) {
+	    push->str_quote -= len;
+	}
+    }
+    return;
+}
+
+
+/*
+ * json_push_create - start a push parse
+ *
+ * given:
+ *	filename	filename for messages, or NULL ==> "-"
+ *	limits		resource limits of the parse, or NULL ==> no limits
+ *
+ * returns:
+ *	push parse state to give to json_push_feed() and json_push_finish()
+ *
+ * NOTE: This function does not return on error.
+ */
+struct json_push *
+json_push_create(char const *filename, struct json_limits const *limits)
+{
+    struct json_push *push = NULL;	/* push parse state */
+    int ret = 0;			/* libc function return */
+
+    /*
+     * allocate the push parse state
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    push = calloc(1, sizeof(*push));
+    if (push == NULL) {
+	errp(103, __func__, "calloc of struct json_push failed");
+	not_reached();
+    }
+    json_parse_ctx_init(&push->ctx, filename, NULL);
+    push->ctx.limits = limits;
+    push->status = YYPUSH_MORE;
+    push->str_quote = SIZE_MAX;
+    push->linenum = 1;
+
+    /*
+     * identical JSON member names of the parse share one copy of the name
+     */
+    push->ctx.names = json_intern_create();
+
+    /*
+     * initialize the scanner and the parser
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = jparse_lex_init_extra(&push->ctx, &push->scanner);
+    if (ret != 0) {
+	errp(104, __func__, "failed to initialize scanner");
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    push->pstate = jparse_pstate_new();
+    if (push->pstate == NULL) {
+	errp(105, __func__, "failed to create push parser");
+	not_reached();
+    }
+    return push;
+}
+
+
+/*
+ * json_push_feed - give the next piece of the JSON document to a push parse
+ *
+ * The tokens that the piece completes are scanned and parsed before this
+ * returns.  The bytes of a token that is not yet complete are held for the
+ * next piece.
+ *
+ * given:
+ *	push	push parse state from json_push_create()
+ *	buf	next piece of the JSON document
+ *	len	length of the piece, which may be 0
+ *
+ * returns:
+ *	true ==> the parse goes on,
+ *	false ==> the JSON is invalid, or a resource limit was crossed
+ *
+ * NOTE: Once this returns false the remaining pieces need not be fed: the
+ *	 parse is only to be given to json_push_finish() or json_push_free().
+ */
+bool
+json_push_feed(struct json_push *push, char const *buf, size_t len)
+{
+    size_t alloc = 0;		/* bytes to allocate for held */
+    char *held = NULL;		/* reallocated held */
+
+    /*
+     * firewall
+     */
+    if (push == NULL) {
+	werr(106, __func__, "push is NULL");
+	return false;
+    }
+    if (buf == NULL && len > 0) {
+	werr(107, __func__, "buf is NULL");
+	return false;
+    }
+    if (push->status != YYPUSH_MORE) {
+	return false;
+    }
+    if (len == 0) {
+	return true;
+    }
+
+    /*
+     * do not hold a document that is longer than the limit
+     */
+    push->total += len;
+    if (push->ctx.limits != NULL && push->ctx.limits->max_bytes > 0 && push->total > push->ctx.limits->max_bytes) {
+	fpr(stderr, __func__, "JSON document length of at least %ju exceeds the limit of %ju in file %s\n",
+	    push->total, (uintmax_t)push->ctx.limits->max_bytes, push->ctx.filename);
+	push->ctx.limit_crossed = true;
+	push->status = 1;
+	return false;
+    }
+
+    /*
+     * a piece with a NUL or low byte is not valid JSON
+     */
+    if (push_low_byte(push, buf, len)) {
+	werr(108, __func__, "NUL or low byte detected: data block is NOT valid JSON");
+	push->status = 1;
+	return false;
+    }
+
+    /*
+     * hold the piece after the bytes already held
+     */
+    if (push->held_len + len > push->held_alloc) {
+	alloc = push->held_alloc > 0 ? push->held_alloc * 2 : JSON_PUSH_CHUNK;
+	if (alloc < push->held_len + len) {
+	    alloc = push->held_len + len;
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	held = realloc(push->held, alloc);
+	if (held == NULL) {
+	    errp(109, __func__, "realloc of %ju bytes failed", (uintmax_t)alloc);
+	    not_reached();
+	}
+	push->held = held;
+	push->held_alloc = alloc;
+    }
+    memcpy(push->held + push->held_len, buf, len);
+    push->held_len += len;
+
+    /*
+     * parse up to the last token boundary
+     */
+    push_bound(push);
+    if (push->cut > 0) {
+	push_scan(push, push->cut, false);
+    }
+    return push->status == YYPUSH_MORE;
+}
+
+
+/*
+ * json_push_finish - end a push parse
+ *
+ * The bytes still held are parsed as the end of the JSON document and the
+ * push parse state is freed.
+ *
+ * given:
+ *	push		push parse state from json_push_create()
+ *	is_valid	non-NULL pointer to boolean to set depending on json validity
+ *
+ * returns:
+ *	pointer to a JSON parse tree, as parse_json() returns
+ *
+ * NOTE: This function does not return if is_valid is NULL.
+ */
+struct json *
+json_push_finish(struct json_push *push, bool *is_valid)
+{
+    struct json *tree = NULL;	/* the JSON parse tree */
+
+    /*
+     * firewall
+     */
+    if (is_valid == NULL) {
+	err(110, __func__, "is_valid is NULL");
+	not_reached();
+    }
+    if (push == NULL) {
+	werr(111, __func__, "push is NULL");
+	*is_valid = false;
+	return json_alloc(JTYPE_UNSET);
+    }
+
+    /*
+     * parse what is held as the end of the JSON document
+     */
+    if (push->status == YYPUSH_MORE) {
+	push_scan(push, push->held_len, true);
+    }
+    if (push->status == 0) {
+	json_dbg(JSON_DBG_LOW, __func__, "valid JSON");
+	*is_valid = true;
+    } else {
+	json_dbg(JSON_DBG_LOW, __func__, "invalid JSON");
+	*is_valid = false;
+    }
+
+    /*
+     * keep the tree and free the rest
+     */
+    tree = push->tree;
+    push->tree = NULL;
+    json_push_free(push);
+    return tree;
+}
+
+
+/*
+ * json_push_free - abandon a push parse
+ *
+ * given:
+ *	push	push parse state from json_push_create(), or NULL
+ *
+ * NOTE: The parse tree, if any, is freed too.  Use json_push_finish() to
+ *	 keep the parse tree.
+ */
+void
+json_push_free(struct json_push *push)
+{
+    /*
+     * firewall
+     */
+    if (push == NULL) {
+	return;
+    }
+
+    /*
+     * free the push parse state
+     */
+    if (push->tree != NULL) {
+	json_tree_free(push->tree, JSON_INFINITE_DEPTH);
+	free(push->tree);
+	push->tree = NULL;
+    }
+    jparse_pstate_delete(push->pstate);
+    jparse_lex_destroy(push->scanner);
+    json_parse_ctx_free(&push->ctx);
+    json_intern_free(push->ctx.names);
+    push->ctx.names = NULL;
+    if (push->held != NULL) {
+	free(push->held);
+	push->held = NULL;
+    }
+    free(push);
+    return;
+}
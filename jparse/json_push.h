@@ -0,0 +1,66 @@
+/*
+ * json_push - push parser for JSON that arrives in pieces
+ *
+ * "Because sometimes the JSON is still on its way." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_PUSH_H)
+#    define  INCLUDE_JSON_PUSH_H
+
+
+#include <stdio.h>
+
+/*
+ * util - entry common utility functions for the IOCCC toolkit
+ */
+#include "util.h"
+
+/*
+ * json_parse - JSON parser support code
+ */
+#include "json_parse.h"
+
+
+/*
+ * definitions
+ */
+#define JSON_PUSH_CHUNK (65536)		/* initial allocation of the bytes held for an incomplete token */
+
+
+/*
+ * json_push - state of a push parse
+ *
+ * A push parse is given the JSON document a piece at a time, in pieces of
+ * any size, by json_push_feed(), and forms the same parse tree that
+ * parse_json() forms for the whole document.  Only the bytes of a token
+ * that is not yet complete are held between pieces.
+ *
+ * The members are private to json_push.c.
+ */
+struct json_push;
+
+
+/*
+ * function prototypes
+ */
+extern struct json_push *json_push_create(char const *filename, struct json_limits const *limits);
+extern bool json_push_feed(struct json_push *push, char const *buf, size_t len);
+extern struct json *json_push_finish(struct json_push *push, bool *is_valid);
+extern void json_push_free(struct json_push *push);
+
+
+#endif /* INCLUDE_JSON_PUSH_H */
@@ -28,6 +28,9 @@
 
 
 #include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
 
 /*
  * dbg - info, debug, warning, error, and usage message facility
@@ -85,10 +88,150 @@ static struct json_sem_val_err sem_val_err_NULL = {
 };
 
 
+/*
+ * sem_index_slot - slot of a JSON semantic table index
+ *
+ * A slot with a name holds the first JSON semantic table entry of that depth,
+ * JTYPE_MEMBER type and name.  A slot without a name holds the first entry of
+ * its depth and type, and the first entry of its depth and type that matches
+ * a JTYPE_MEMBER of any name.
+ */
+struct sem_index_slot
+{
+    unsigned int depth;		/* JSON parse tree node depth */
+    enum item_type type;	/* type of JSON node, JTYPE_UNSET ==> empty slot */
+    char const *name;		/* JTYPE_MEMBER name or NULL ==> any name */
+    uint32_t hash;		/* sem_index_hash() of depth, type and name */
+    int first;			/* index of first JSON semantic table entry */
+    int any_name;		/* index of first entry that matches any name or -1 ==> none */
+};
+
+
+/*
+ * sem_index - index of a JSON semantic table by depth, type and name
+ *
+ * The index is an open addressing hash table with linear probing.  The number
+ * of slots is a power of 2 that is at least twice the number of keys.
+ */
+struct sem_index
+{
+    struct sem_index_slot *slot;	/* hash table slots */
+    size_t size;			/* number of slots (a power of 2) */
+};
+
+
+/*
+ * sem_cache - index of a JSON semantic table, kept for later checks of the table
+ *
+ * The index of a table is built the first time that the table is checked and
+ * is kept on the sem_cache list, so that a table that is checked again and
+ * again is indexed once.  The list is guarded by sem_cache_lock.  An index is
+ * not changed once built, so it is read without the lock.
+ *
+ * An index is found by the address and length of its table and by the
+ * sem_table_sum() of the table, so that a table that was changed, or freed
+ * and another allocated at the same address, is indexed again.  The list is
+ * freed at exit.
+ */
+struct sem_cache
+{
+    struct json_sem const *sem;		/* indexed JSON semantic table */
+    int len;				/* number of JSON semantic table entries */
+    uint64_t sum;			/* sem_table_sum() of the JSON semantic table */
+    struct sem_index index;		/* index of the JSON semantic table */
+    struct sem_cache *next;		/* next indexed JSON semantic table or NULL */
+};
+
+static struct sem_cache *sem_cache = NULL;			/* indexed JSON semantic tables */
+static bool sem_cache_atexit = false;				/* true ==> sem_cache_free() registered */
+static pthread_mutex_t sem_cache_lock = PTHREAD_MUTEX_INITIALIZER;	/* guards sem_cache */
+
+
+/*
+ * sem_walk_ctx - json_walk() context of sem_walk()
+ */
+struct sem_walk_ctx
+{
+    struct json_sem *sem;		/* JSON semantic table (ends with a JTYPE_UNSET JSON type) */
+    struct sem_index const *index;	/* index of the JSON semantic table or NULL ==> use match */
+    int (*match)(struct json const *, unsigned int, struct json_sem *, bool *, struct json_sem_val_err **);
+					/* compiled match of the JSON semantic table or NULL ==> use index */
+    int len;				/* number of JSON semantic table entries */
+    struct dyn_array *count_err;	/* dynamic array of JSON semantic count errors */
+    struct dyn_array *val_err;		/* dynamic array of JSON semantic validation errors */
+    unsigned int *count;		/* number of times each JSON semantic was matched */
+    bool fail_fast;			/* true ==> check no more nodes once an error is found */
+    uintmax_t errors;			/* number of errors appended by the walk */
+};
+
+
+/*
+ * sem_node - a JSON parse tree node to check, listed in walk order
+ */
+struct sem_node
+{
+    struct json *node;		/* JSON parse tree node */
+    unsigned int depth;		/* tree depth of node (0 ==> top of tree) */
+};
+
+
+struct sem_worker;	/* see below */
+
+
+/*
+ * sem_pool - JSON parse tree nodes shared by the worker threads of a semantic check
+ *
+ * Each worker thread checks its own run of the nodes, in walk order, with its
+ * own counts and errors.  With fail-fast, a worker thread stops once a worker
+ * thread with an earlier run of nodes has found an error.
+ */
+struct sem_pool
+{
+    pthread_mutex_t lock;	/* guards first_err */
+    struct dyn_array *nodes;	/* struct sem_node of the JSON parse tree in walk order */
+    unsigned int first_err;	/* lowest worker thread that found an error, or number of workers ==> none */
+};
+
+
+/*
+ * sem_worker - a worker thread of a semantic check
+ */
+struct sem_worker
+{
+    pthread_t thread;		/* worker thread */
+    bool started;		/* true ==> thread was started and must be joined */
+    unsigned int id;		/* index of this worker thread */
+    struct sem_pool *pool;	/* nodes shared by the worker threads */
+    intmax_t first;		/* index in pool->nodes of the first node to check */
+    intmax_t end;		/* index in pool->nodes beyond the last node to check */
+    struct sem_walk_ctx walk;	/* counts and errors of this worker thread */
+};
+
+
 /*
  * static functions
  */
-static void sem_walk(struct json *node, unsigned int depth, va_list ap);
+static uint32_t sem_index_hash(unsigned int depth, enum item_type type, uint32_t name_hash);
+static struct sem_index_slot *sem_index_slot(struct sem_index const *index, unsigned int depth,
+					     enum item_type type, char const *name, uint32_t name_hash);
+static bool sem_index_build(struct sem_index *index, struct json_sem *sem, int len);
+static uint64_t sem_table_sum(struct json_sem const *sem, int len);
+static struct sem_index const *sem_index_get(struct json_sem *sem, int len);
+static void sem_cache_free(void);
+static int sem_index_find(struct sem_index const *index, struct json *node, unsigned int depth,
+			  struct json_sem *sem);
+static void sem_walk(struct json *node, unsigned int depth, void *ctx);
+static void sem_collect(struct json *node, unsigned int depth, void *ctx);
+static void *sem_worker(void *arg);
+static bool sem_check_parallel(struct json *node, unsigned int max_depth, struct sem_walk_ctx *walk,
+			       unsigned int threads, uintmax_t min_nodes);
+static uintmax_t sem_check(struct json *node, unsigned int max_depth, struct json_sem *sem,
+			   int (*match)(struct json const *, unsigned int, struct json_sem *, bool *,
+					struct json_sem_val_err **),
+			   struct json_sem_opt const *opt,
+			   struct dyn_array **pcount_err, struct dyn_array **pval_err);
+static void sem_count_chk(struct json_sem *sem, unsigned int const *counts, struct dyn_array *count_err,
+			  bool fail_fast);
 
 
 /*
@@ -1213,13 +1356,59 @@ sem_member_value_str_or_null(struct json const *node, unsigned int depth, struct
 
 
 /*
- * sem_member_value_int - return pointer to int from a JSON number value of JTYPE_MEMBER
+ * sem_member_value_str_prop - obtain the properties of the decoded JSON string value of JTYPE_MEMBER
+ *
+ * The properties of each decoded JSON string are found when the string is
+ * decoded (see str_prop_chk()), so a validate function that tests the string
+ * may use them instead of scanning the string again.
+ *
+ * given:
+ *	node	JSON parse node being checked
+ *
+ * returns:
+ *	pointer to the properties of the decoded JSON string value of the JTYPE_MEMBER,
+ *	or NULL ==> node is not a JTYPE_MEMBER with a decoded JSON string value,
+ *		    or the decoded JSON string has a NUL byte inside it
+ *
+ * NOTE: A decoded JSON string with a NUL byte inside it is tested as a C string
+ *	 that ends at the NUL byte, so its properties are not returned.
+ */
+struct str_prop const *
+sem_member_value_str_prop(struct json const *node)
+{
+    struct json *value = NULL;		/* JTYPE_MEMBER value */
+    struct json_string const *item = NULL;	/* JTYPE_STRING value */
+
+    /*
+     * firewall - must be a JTYPE_MEMBER with a decoded JTYPE_STRING value
+     */
+    if (node == NULL || node->type != JTYPE_MEMBER) {
+	return NULL;
+    }
+    value = node->item.member.value;
+    if (value == NULL || value->type != JTYPE_STRING) {
+	return NULL;
+    }
+    item = &(value->item.string);
+    if (item->converted == false || item->str == NULL || item->has_nul == true) {
+	return NULL;
+    }
+
+    /*
+     * return the properties found when the string was decoded
+     */
+    return &(item->prop);
+}
+
+
+/*
+ * sem_member_value_int - obtain an int from a JSON number value of JTYPE_MEMBER
  *
  * Given a JSON node of type JTYPE_MEMBER, look at the value of the JSON member
- * and if it is a JTYPE_NUMBER (JSON number), return a pointer to a converted int
- * or return NULL on error or invalid input.
+ * and if it is a JTYPE_NUMBER (JSON number), store the converted int in *value
+ * or return false on error or invalid input.
  *
- * If the JTYPE_NUMBER (JSON number) cannot be returned as an int, NULL is returned.
+ * If the JTYPE_NUMBER (JSON number) cannot be converted to an int, false is returned.
  *
  * given:
  *	node	JSON parse node being checked
@@ -1228,18 +1417,19 @@ sem_member_value_str_or_null(struct json const *node, unsigned int depth, struct
  *	name	name of caller function (NULL ==> "((NULL))")
  *	val_err	pointer to address where to place a JSON semantic validation error,
  *		NULL ==> do not report a JSON semantic validation error
+ *	value	where to store the JTYPE_NUMBER as an int, if value != NULL
  *
  * returns:
- *	!= NULL ==> decoded JTYPE_NUMBER as an int from the value part of JTYPE_MEMBER
+ *	true ==> decoded JTYPE_NUMBER as an int from the value part of JTYPE_MEMBER
  *	    The val_err arg is ignored
- *	NULL ==> invalid arguments or JSON conversion error
+ *	false ==> invalid arguments or JSON conversion error
  *	    If val_err != NULL then *val_err is JSON semantic validation error (struct json_sem_val_err)
  */
-int *
+bool
 sem_member_value_int(struct json const *node, unsigned int depth, struct json_sem *sem,
-		     char const *name, struct json_sem_val_err **val_err)
+		     char const *name, struct json_sem_val_err **val_err, int *value)
 {
-    struct json *value = NULL;			/* value of JTYPE_MEMBER */
+    struct json *mval = NULL;			/* value of JTYPE_MEMBER */
     struct json_number *inum = NULL;		/* JTYPE_MEMBER value as JTYPE_NUMBER */
 
     /*
@@ -1248,55 +1438,55 @@ sem_member_value_int(struct json const *node, unsigned int depth, struct json_se
      * NOTE: The sem_member_value() call checks args via sem_chk_null_args().
      * NOTE: The sem_member_value() call verifies that node is of type JTYPE_MEMBER.
      */
-    value = sem_member_value(node, depth, sem, name, val_err);
-    if (value == NULL) {
+    mval = sem_member_value(node, depth, sem, name, val_err);
+    if (mval == NULL) {
 	/* sem_member_value() will have set *val_err */
-	return NULL;
+	return false;
     }
 
     /*
      * validate JSON parse node value type
      */
-    if (value->type != JTYPE_NUMBER) {
+    if (mval->type != JTYPE_NUMBER) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(66, node, depth, sem, name, "node value type %s != JTYPE_BOOL",
-				    json_type_name(value->type));
+				    json_type_name(mval->type));
 	}
-	return NULL;
+	return false;
     }
-    inum = &(value->item.number);
+    inum = &(mval->item.number);
     if (!VALID_JSON_NODE(inum)) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(67, node, depth, sem, name, "node value JTYPE_NUMBER converted is false");
 	}
-	return NULL;
+	return false;
     }
 
     /*
      * validate JTYPE_NUMBER was able to be converted into an int
      */
-    if (inum->int_sized == false) {
+    if (json_number_int(inum, value) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(68, node, depth, sem, name, "node value JTYPE_NUMBER was unable to convert to an int");
 	}
-	return NULL;
+	return false;
     }
 
     /*
-     * case success: return JSON boolean
+     * case success: return converted int
      */
-    return &(inum->as_int);
+    return true;
 }
 
 
 /*
- * sem_member_value_size_t - return pointer to size_t from a JSON number value of JTYPE_MEMBER
+ * sem_member_value_size_t - obtain a size_t from a JSON number value of JTYPE_MEMBER
  *
  * Given a JSON node of type JTYPE_MEMBER, look at the value of the JSON member
- * and if it is a JTYPE_NUMBER (JSON number), return a pointer to a converted
- * size_t or return NULL on error or invalid input.
+ * and if it is a JTYPE_NUMBER (JSON number), store the converted size_t in
+ * *value or return false on error or invalid input.
  *
- * If the JTYPE_NUMBER (JSON number) cannot be returned as a size_t, NULL is returned.
+ * If the JTYPE_NUMBER (JSON number) cannot be converted to a size_t, false is returned.
  *
  * given:
  *	node	JSON parse node being checked
@@ -1305,18 +1495,19 @@ sem_member_value_int(struct json const *node, unsigned int depth, struct json_se
  *	name	name of caller function (NULL ==> "((NULL))")
  *	val_err	pointer to address where to place a JSON semantic validation error,
  *		NULL ==> do not report a JSON semantic validation error
+ *	value	where to store the JTYPE_NUMBER as a size_t, if value != NULL
  *
  * returns:
- *	!= NULL ==> decoded JTYPE_NUMBER as a size_t from the value part of JTYPE_MEMBER
+ *	true ==> decoded JTYPE_NUMBER as a size_t from the value part of JTYPE_MEMBER
  *	    The val_err arg is ignored
- *	NULL ==> invalid arguments or JSON conversion error
+ *	false ==> invalid arguments or JSON conversion error
  *	    If val_err != NULL then *val_err is JSON semantic validation error (struct json_sem_val_err)
  */
-size_t *
+bool
 sem_member_value_size_t(struct json const *node, unsigned int depth, struct json_sem *sem,
-			         char const *name, struct json_sem_val_err **val_err)
+			char const *name, struct json_sem_val_err **val_err, size_t *value)
 {
-    struct json *value = NULL;			/* value of JTYPE_MEMBER */
+    struct json *mval = NULL;			/* value of JTYPE_MEMBER */
     struct json_number *snum = NULL;		/* JTYPE_MEMBER value as JTYPE_NUMBER */
 
     /*
@@ -1325,55 +1516,55 @@ sem_member_value_size_t(struct json const *node, unsigned int depth, struct json
      * NOTE: The sem_member_value() call checks args via sem_chk_null_args().
      * NOTE: The sem_member_value() call verifies that node is of type JTYPE_MEMBER.
      */
-    value = sem_member_value(node, depth, sem, name, val_err);
-    if (value == NULL) {
+    mval = sem_member_value(node, depth, sem, name, val_err);
+    if (mval == NULL) {
 	/* sem_member_value() will have set *val_err */
-	return NULL;
+	return false;
     }
 
     /*
      * validate JSON parse node value type
      */
-    if (value->type != JTYPE_NUMBER) {
+    if (mval->type != JTYPE_NUMBER) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(69, node, depth, sem, name, "node value type %s != JTYPE_BOOL",
-				    json_type_name(value->type));
+				    json_type_name(mval->type));
 	}
-	return NULL;
+	return false;
     }
-    snum = &(value->item.number);
+    snum = &(mval->item.number);
     if (!VALID_JSON_NODE(snum)) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(70, node, depth, sem, name, "node value JTYPE_NUMBER converted is false");
 	}
-	return NULL;
+	return false;
     }
 
     /*
      * validate JTYPE_NUMBER was able to be converted into a size_t
      */
-    if (snum->size_sized == false) {
+    if (json_number_size(snum, value) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(71, node, depth, sem, name, "node value JTYPE_NUMBER was unable to convert to a size_t");
 	}
-	return NULL;
+	return false;
     }
 
     /*
-     * case success: return JSON boolean
+     * case success: return converted size_t
      */
-    return &(snum->as_size);
+    return true;
 }
 
 
 /*
- * sem_member_value_time_t - return pointer to time_t from a JSON number value of JTYPE_MEMBER
+ * sem_member_value_time_t - obtain a time_t from a JSON number value of JTYPE_MEMBER
  *
  * Given a JSON node of type JTYPE_MEMBER, look at the value of the JSON member
- * and if it is a JTYPE_NUMBER (JSON number), return a pointer to a time_t
- * or return NULL on error or invalid input.
+ * and if it is a JTYPE_NUMBER (JSON number), store the converted time_t in
+ * *value or return false on error or invalid input.
  *
- * If the JTYPE_NUMBER (JSON number) cannot be returned as a time_t, NULL is returned.
+ * If the JTYPE_NUMBER (JSON number) cannot be converted to a time_t, false is returned.
  *
  * given:
  *	node	JSON parse node being checked
@@ -1382,20 +1573,22 @@ sem_member_value_size_t(struct json const *node, unsigned int depth, struct json
  *	name	name of caller function (NULL ==> "((NULL))")
  *	val_err	pointer to address where to place a JSON semantic validation error,
  *		NULL ==> do not report a JSON semantic validation error
+ *	value	where to store the JTYPE_NUMBER as a time_t, if value != NULL
  *
  * returns:
- *	!= NULL ==> decoded JTYPE_NUMBER as a time_t from the value part of JTYPE_MEMBER
+ *	true ==> decoded JTYPE_NUMBER as a time_t from the value part of JTYPE_MEMBER
  *	    The val_err arg is ignored
- *	NULL ==> invalid arguments or JSON conversion error
+ *	false ==> invalid arguments or JSON conversion error
  *	    If val_err != NULL then *val_err is JSON semantic validation error (struct json_sem_val_err)
  */
-time_t *
+bool
 sem_member_value_time_t(struct json const *node, unsigned int depth, struct json_sem *sem,
-		        char const *name, struct json_sem_val_err **val_err)
+		        char const *name, struct json_sem_val_err **val_err, time_t *value)
 {
-    struct json *value = NULL;			/* value of JTYPE_MEMBER */
+    struct json *mval = NULL;			/* value of JTYPE_MEMBER */
     struct json_number *inum = NULL;		/* JTYPE_MEMBER value as JTYPE_NUMBER */
-    time_t *ret;				/* pointer converted time_t to return */
+    intmax_t maxint = 0;			/* JTYPE_NUMBER as a signed integer */
+    uintmax_t umaxint = 0;			/* JTYPE_NUMBER as an unsigned integer */
 
     /*
      * obtain JTYPE_MEMBER value
@@ -1403,28 +1596,28 @@ sem_member_value_time_t(struct json const *node, unsigned int depth, struct json
      * NOTE: The sem_member_value() call checks args via sem_chk_null_args().
      * NOTE: The sem_member_value() call verifies that node is of type JTYPE_MEMBER.
      */
-    value = sem_member_value(node, depth, sem, name, val_err);
-    if (value == NULL) {
+    mval = sem_member_value(node, depth, sem, name, val_err);
+    if (mval == NULL) {
 	/* sem_member_value() will have set *val_err */
-	return NULL;
+	return false;
     }
 
     /*
      * validate JSON parse node value type
      */
-    if (value->type != JTYPE_NUMBER) {
+    if (mval->type != JTYPE_NUMBER) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(72, node, depth, sem, name, "node value type %s != JTYPE_BOOL",
-				    json_type_name(value->type));
+				    json_type_name(mval->type));
 	}
-	return NULL;
+	return false;
     }
-    inum = &(value->item.number);
+    inum = &(mval->item.number);
     if (!VALID_JSON_NODE(inum)) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(73, node, depth, sem, name, "node value JTYPE_NUMBER converted is false");
 	}
-	return NULL;
+	return false;
     }
 
     /*
@@ -1439,34 +1632,38 @@ sem_member_value_time_t(struct json const *node, unsigned int depth, struct json
 	    if (val_err != NULL) {
 		*val_err = werr_sem_val(74, node, depth, sem, name, "node negative JTYPE_NUMBER with unsigned time_t");
 	    }
-	    return NULL;
+	    return false;
 	}
-	if (inum->umaxint_sized == false) {
+	if (json_number_umaxint(inum, &umaxint) == false) {
 	    if (val_err != NULL) {
-		*val_err = werr_sem_val(75, node, depth, sem, name, "JTYPE_NUMBER umaxint_sized false with unsigned time_t");
+		*val_err = werr_sem_val(75, node, depth, sem, name, "JTYPE_NUMBER does not fit into uintmax_t with unsigned time_t");
 	    }
-	    return NULL;
+	    return false;
+	}
+	if (value != NULL) {
+	    *value = (time_t)umaxint;
 	}
-	ret = (time_t *)&(inum->as_umaxint);
 
     } else {
 
 	/*
 	 * case: time_t is signed
 	 */
-	if (inum->maxint_sized == false) {
+	if (json_number_maxint(inum, &maxint) == false) {
 	    if (val_err != NULL) {
-		*val_err = werr_sem_val(76, node, depth, sem, name, "JTYPE_NUMBER maxint_sized false with signed time_t");
+		*val_err = werr_sem_val(76, node, depth, sem, name, "JTYPE_NUMBER does not fit into intmax_t with signed time_t");
 	    }
-	    return NULL;
+	    return false;
+	}
+	if (value != NULL) {
+	    *value = (time_t)maxint;
 	}
-	ret = (time_t *)&(inum->as_maxint);
     }
 
     /*
-     * case success: return JSON boolean
+     * case success: return converted time_t
      */
-    return ret;
+    return true;
 }
 
 
@@ -1585,6 +1782,9 @@ sem_object_find_name(struct json const *node, unsigned int depth, struct json_se
 {
     struct json_object const *item = NULL;	/* JSON member */
     bool valid = false;				/* true ==> JSON node is converted and valid JTYPE */
+    struct json *found = NULL;			/* member found via the JSON object member index */
+    size_t memname_len = 0;			/* length of memname */
+    uint32_t memname_hash = 0;			/* json_name_hash() of memname */
     int i;
 
     /*
@@ -1639,45 +1839,76 @@ sem_object_find_name(struct json const *node, unsigned int depth, struct json_se
     }
 
     /*
-     * search the JSON member array for the named member
+     * case: indexed JSON object - look up the named member
      */
-    for (i=0; i < item->len; ++i) {
-	struct json *s = item->set[i];		/* set member under the JTYPE_OBJECT */
-	char *smemname = NULL;			/* name of set member */
+    memname_len = strlen(memname);
+    if (item->index != NULL) {
+	found = json_object_lookup(node, memname, memname_len);
+	if (found != NULL) {
+	    valid = sem_node_valid(found, depth+1, sem, name, val_err);
+	    if (valid == false) {
+		/* sem_node_valid() will have set *val_err */
+		return NULL;
+	    }
+	    /* found match */
+	    return found;
+	}
+    } else {
 
 	/*
-	 * firewall - validate set member (must be a valid JTYPE_MEMBER with non-NULL
+	 * search the JSON member array for the named member
+	 *
+	 * Each JTYPE_MEMBER carries the hash of its name, so most members that
+	 * do not match are passed over without comparing names.
 	 */
-	if (s == NULL) {
-	    if (val_err != NULL) {
-		*val_err = werr_sem_val(84, node, depth, sem, name, "JTYPE_OBJECT set[%d] is NULL", i);
+	memname_hash = json_name_hash(memname, memname_len);
+	for (i=0; i < item->len; ++i) {
+	    struct json *s = item->set[i];		/* set member under the JTYPE_OBJECT */
+	    struct json_member const *member = NULL;	/* the JTYPE_MEMBER set member */
+	    char *smemname = NULL;			/* name of set member */
+
+	    /*
+	     * firewall - validate set member (must be a valid JTYPE_MEMBER with non-NULL
+	     */
+	    if (s == NULL) {
+		if (val_err != NULL) {
+		    *val_err = werr_sem_val(84, node, depth, sem, name, "JTYPE_OBJECT set[%d] is NULL", i);
+		}
+		return NULL;
 	    }
-	    return NULL;
-	}
-	valid = sem_node_valid(s, depth+1, sem, name, val_err);
-	if (valid == false) {
-	    /* sem_node_valid() will have set *val_err */
-	    return NULL;
-	}
-	if (s->type != JTYPE_MEMBER) {
-	    if (val_err != NULL) {
-		*val_err = werr_sem_val(85, node, depth+1, sem, name, "JTYPE_OBJECT set[%d] type: %s != JTYPE_MEMBER",
-					i, json_type_name(s->type));
+	    valid = sem_node_valid(s, depth+1, sem, name, val_err);
+	    if (valid == false) {
+		/* sem_node_valid() will have set *val_err */
+		return NULL;
+	    }
+	    if (s->type != JTYPE_MEMBER) {
+		if (val_err != NULL) {
+		    *val_err = werr_sem_val(85, node, depth+1, sem, name, "JTYPE_OBJECT set[%d] type: %s != JTYPE_MEMBER",
+					    i, json_type_name(s->type));
+		}
+		return NULL;
 	    }
-	    return NULL;
-	}
 
-	/*
-	 * try to match the smemname with this set member
-	 */
-	smemname = sem_member_name_decoded_str(s, depth+1, sem, name, val_err);
-	if (smemname == NULL) {
-	    /* sem_member_name_decoded_str() will have set *val_err */
-	    return NULL;
-	}
-	if (strcmp(memname, smemname) == 0) {
-	    /* found match */
-	    return s;
+	    /*
+	     * try to match the smemname with this set member
+	     */
+	    smemname = sem_member_name_decoded_str(s, depth+1, sem, name, val_err);
+	    if (smemname == NULL) {
+		/* sem_member_name_decoded_str() will have set *val_err */
+		return NULL;
+	    }
+	    if (smemname == memname) {
+		/* found match - same shared member name */
+		return s;
+	    }
+	    member = &(s->item.member);
+	    if (member->name_hash != 0 && member->name_hash != memname_hash) {
+		continue; /* no match */
+	    }
+	    if (member->name_str_len == memname_len && memcmp(memname, smemname, memname_len) == 0) {
+		/* found match */
+		return s;
+	    }
 	}
     }
 
@@ -1739,8 +1970,27 @@ json_sem_zero_count(struct json_sem *sem)
  */
 void
 json_sem_count_chk(struct json_sem *sem, struct dyn_array *count_err)
+{
+    sem_count_chk(sem, NULL, count_err, false);
+    return;
+}
+
+
+/*
+ * sem_count_chk - validate semantic counts
+ *
+ * given:
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	counts		number of times each JSON semantic was matched or NULL ==> use the counts in sem
+ *	count_err	dynamic array of JSON semantic count errors
+ *	fail_fast	true ==> return after the first count error
+ */
+static void
+sem_count_chk(struct json_sem *sem, unsigned int const *counts, struct dyn_array *count_err,
+	      bool fail_fast)
 {
     struct json_sem_count_err count;	/* semantic count error */
+    unsigned int found = 0;		/* number of times sem[i] was matched */
     int i;
 
     /*
@@ -1760,25 +2010,26 @@ json_sem_count_chk(struct json_sem *sem, struct dyn_array *count_err)
      */
     for (i=0; sem[i].type != JTYPE_UNSET; ++i) {
 
+	/*
+	 * obtain the count
+	 */
+	found = (counts != NULL) ? counts[i] : sem[i].count;
+
 	/*
 	 * case: count is too small
 	 */
-	if (sem[i].count < sem[i].min) {
+	if (found < sem[i].min) {
 
 	    /*
 	     * form count is too small error
 	     */
 	    count.node = NULL;
 	    count.sem = &(sem[i]);
-	    count.count = sem[i].count;
+	    count.count = found;
 	    count.bad_min = true;
 	    count.bad_max = false;
 	    count.unknown_node = false;
-	    if (count.sem != NULL) {
-		count.sem_index = count.sem->sem_index;
-	    } else {
-		count.sem_index = -1;
-	    }
+	    count.sem_index = i;
 	    count.diagnostic = calloc(BUFSIZ+1, sizeof(char));
 	    if (count.diagnostic == NULL) {
 		count.diagnostic = "calloc BUFSIZ calloc failed for count is too small";
@@ -1788,32 +2039,31 @@ json_sem_count_chk(struct json_sem *sem, struct dyn_array *count_err)
 		      json_type_name(sem[i].type), sem[i].depth,
 		      (sem[i].name != NULL) ? " member name: " : "",
 		      (sem[i].name != NULL) ? sem[i].name : "",
-		      sem[i].count, sem[i].min);
+		      found, sem[i].min);
 		count.malloced = true;
 	    }
 
 	    /* save semantic count error */
 	    dyn_array_append_value(count_err, &count);
+	    if (fail_fast == true) {
+		return;
+	    }
 
 	/*
 	 * case: count is too large
 	 */
-	} else if (sem[i].max > 0 && sem[i].count > sem[i].max) {
+	} else if (sem[i].max > 0 && found > sem[i].max) {
 
 	    /*
 	     * form count is too large error
 	     */
 	    count.node = NULL;
 	    count.sem = &(sem[i]);
-	    count.count = sem[i].count;
+	    count.count = found;
 	    count.bad_min = false;
 	    count.bad_max = true;
 	    count.unknown_node = false;
-	    if (count.sem != NULL) {
-		count.sem_index = count.sem->sem_index;
-	    } else {
-		count.sem_index = -1;
-	    }
+	    count.sem_index = i;
 	    count.diagnostic = calloc(BUFSIZ+1, sizeof(char));
 	    if (count.diagnostic == NULL) {
 		count.diagnostic = "calloc BUFSIZ calloc failed for count is too small";
@@ -1823,12 +2073,15 @@ json_sem_count_chk(struct json_sem *sem, struct dyn_array *count_err)
 		      json_type_name(sem[i].type), sem[i].depth,
 		      (sem[i].name != NULL) ? " member name: " : "",
 		      (sem[i].name != NULL) ? sem[i].name : "",
-		      sem[i].count, sem[i].max);
+		      found, sem[i].max);
 		count.malloced = true;
 	    }
 
 	    /* save semantic count error */
 	    dyn_array_append_value(count_err, &count);
+	    if (fail_fast == true) {
+		return;
+	    }
 	}
     }
     return;
@@ -1851,39 +2104,19 @@ json_sem_count_chk(struct json_sem *sem, struct dyn_array *count_err)
 int
 json_sem_find(struct json *node, unsigned int depth, struct json_sem *sem)
 {
-    bool test = false;		/* JSON node test result */
     char *name = NULL;		/* name of JTYPE_MEMBER node or NULL */
     enum item_type type;	/* type of JSON node */
+    int ret;			/* sem_node_name() result */
     int i;
 
-    /*
-     * firewall - args
-     */
-    if (node == NULL) {
-	warn(__func__, "node is NULL");
-	return -2;
-    }
-    if (sem == NULL) {
-	warn(__func__, "sem is NULL");
-	return -3;
-    }
-
     /*
      * obtain information about the JSON node
      */
-    type = node->type;
-    if (type == JTYPE_MEMBER) {
-        /* sem_member_name_decoded_str() call checks args via sem_chk_null_args() */
-	/* sem_member_name_decoded_str() also calls sem_node_valid() */
-	/* determine name of JTYPE_MEMBER or return NULL */
-	name = sem_member_name_decoded_str(node, depth, sem, __func__, NULL);
-    } else {
-	test = sem_node_valid(node, depth, sem, __func__, NULL);
-	if (test == false) {
-	    warn(__func__, "JSON node is invalid");
-	    return -4;
-	}
+    ret = sem_node_name(node, depth, sem, &name, NULL);
+    if (ret < 0) {
+	return ret;
     }
+    type = node->type;
 
     /*
      * search the JSON semantic table
@@ -1927,109 +2160,587 @@ json_sem_find(struct json *node, unsigned int depth, struct json_sem *sem)
 
 
 /*
- * sem_walk - JSON parse tree semantic tree check walk
+ * sem_node_name - check a JSON node and obtain its name for a JSON semantic table search
  *
  * given:
- *	node	pointer to a JSON parser tree node to free
- *	depth	current tree depth (0 ==> top of tree)
- *	ap	variable argument list, required ap args:
- *
- *		sem		JSON semantic table (ends with a JTYPE_UNSET JSON type)
- *		count_err	dynamic array of JSON semantic count errors
- *		val_err		dynamic array of JSON semantic validation errors
- *
- * NOTE: This function does nothing if node == NULL.
+ *	node		pointer to a JSON parse tree
+ *	depth		depth of node in the JSON parse tree (0 ==> tree root)
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	pname		where to place the decoded name of a JTYPE_MEMBER node,
+ *			    or NULL ==> not a JTYPE_MEMBER or a JTYPE_MEMBER without a name
+ *	phash		!= NULL ==> where to place the json_name_hash() of the name,
+ *			    or 0 ==> no name
  *
- * NOTE: This function does nothing if the node type is invalid.
+ * returns:
+ *	0 ==> node may be searched for in the JSON semantic table
+ *	< -1 ==> invalid JSON node, or NULL ptr
  */
-static void
-sem_walk(struct json *node, unsigned int depth, va_list ap)
+int
+sem_node_name(struct json const *node, unsigned int depth, struct json_sem *sem, char **pname, uint32_t *phash)
 {
-    va_list ap2;			/* copy of va_list ap */
-    struct json_sem *sem = NULL;	/* JSON semantic table (ends with a JTYPE_UNSET JSON type) */
-    struct dyn_array *count_err = NULL;	/* dynamic array of JSON semantic count errors */
-    struct dyn_array *val_err = NULL;	/* dynamic array of JSON semantic validation errors */
-    bool test = false;			/* validation test result */
-    struct json_sem_val_err *error = NULL;/* pointer to semantic validation error */
-    struct json_sem_count_err count;	/* semantic count error */
-    int index = -1;			/* semantic array index match or -1 ==> no march or < -1 ==> error */
+    struct json_member const *item = NULL;	/* JTYPE_MEMBER inside node */
+    bool test = false;		/* JSON node test result */
 
     /*
-     * firewall - nothing to do for a NULL node
+     * firewall - args
      */
     if (node == NULL) {
-	return;
+	warn(__func__, "node is NULL");
+	return -2;
     }
-
-    /*
-     * duplicate va_list ap
-     */
-    va_copy(ap2, ap);
-
-    /*
-     * obtain the stream, json_dbg_used, and json_dbg args
-     */
-    sem = va_arg(ap2, struct json_sem *);
     if (sem == NULL) {
-	va_end(ap2); /* stdarg variable argument list cleanup */
-	return;
+	warn(__func__, "sem is NULL");
+	return -3;
     }
-    count_err = va_arg(ap2, struct dyn_array *);
-    if (count_err == NULL) {
-	va_end(ap2); /* stdarg variable argument list cleanup */
-	return;
+    if (pname == NULL) {
+	warn(__func__, "pname is NULL");
+	return -5;
     }
-    val_err = va_arg(ap2, struct dyn_array *);
-    if (val_err == NULL) {
-	va_end(ap2); /* stdarg variable argument list cleanup */
-	return;
+    *pname = NULL;
+    if (phash != NULL) {
+	*phash = 0;
     }
 
     /*
-     * search for node match in the semantic table
-     */
-    index = json_sem_find(node, depth, sem);
-
-    /*
-     * process search result
+     * obtain information about the JSON node
      */
-    if (index >= 0) {
-
-	/*
-	 * semantic table match, count node use
-	 *
-	 * NOTE: We always count a match regardless of validation status
-	 */
-	++(sem[index].count);
+    if (node->type == JTYPE_MEMBER) {
+        /* sem_member_name_decoded_str() call checks args via sem_chk_null_args() */
+	/* sem_member_name_decoded_str() also calls sem_node_valid() */
+	/* determine name of JTYPE_MEMBER or return NULL */
+	*pname = sem_member_name_decoded_str(node, depth, sem, __func__, NULL);
 
 	/*
-	 * execute validation function is available
+	 * A JTYPE_MEMBER carries the hash of its name, unless it was not hashed.
 	 */
-	if (sem[index].validate != NULL) {
-
+	if (phash != NULL && *pname != NULL) {
+	    item = &(node->item.member);
+	    if (item->name_hash != 0 && *pname == item->name_str) {
+		*phash = item->name_hash;
+	    } else {
+		*phash = json_name_hash(*pname, strlen(*pname));
+	    }
+	}
+    } else {
+	test = sem_node_valid(node, depth, sem, __func__, NULL);
+	if (test == false) {
+	    warn(__func__, "JSON node is invalid");
+	    return -4;
+	}
+    }
+    return 0;
+}
+
+
+/*
+ * sem_index_hash - hash the key of a JSON semantic table index slot
+ *
+ * given:
+ *	depth		JSON parse tree node depth
+ *	type		type of JSON node
+ *	name_hash	json_name_hash() of the JTYPE_MEMBER name or 0 ==> any name
+ *
+ * returns:
+ *	hash of depth, type and name
+ */
+static uint32_t
+sem_index_hash(unsigned int depth, enum item_type type, uint32_t name_hash)
+{
+    uint32_t hash = name_hash;	/* hash to return */
+
+    hash ^= (uint32_t)depth * 0x9e3779b1U;
+    hash ^= (uint32_t)type * 0x85ebca6bU;
+    hash ^= hash >> 15;
+    hash *= 0x2c1b3c6dU;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+
+/*
+ * sem_index_slot - find the slot of a key in a JSON semantic table index
+ *
+ * given:
+ *	index		index of a JSON semantic table
+ *	depth		JSON parse tree node depth
+ *	type		type of JSON node
+ *	name		JTYPE_MEMBER name or NULL ==> any name
+ *	name_hash	json_name_hash() of name, or 0 when name is NULL
+ *
+ * returns:
+ *	slot of the key, or the empty slot where the key belongs
+ */
+static struct sem_index_slot *
+sem_index_slot(struct sem_index const *index, unsigned int depth, enum item_type type,
+	       char const *name, uint32_t name_hash)
+{
+    struct sem_index_slot *slot = NULL;	/* slot being probed */
+    uint32_t hash;			/* hash of the key */
+    size_t i;
+
+    hash = sem_index_hash(depth, type, name_hash);
+    for (i = hash & (index->size-1); ; i = (i+1) & (index->size-1)) {
+	slot = &(index->slot[i]);
+	if (slot->type == JTYPE_UNSET) {
+	    return slot;
+	}
+	if (slot->hash == hash && slot->depth == depth && slot->type == type &&
+	    ((name == NULL && slot->name == NULL) ||
+	     (name != NULL && slot->name != NULL && strcmp(name, slot->name) == 0))) {
+	    return slot;
+	}
+    }
+}
+
+
+/*
+ * sem_index_build - index a JSON semantic table by depth, type and name
+ *
+ * A JTYPE_MEMBER entry with a 0 name_len or a NULL name matches a JTYPE_MEMBER
+ * of any name, as it does for json_sem_find().  The length of a name is that
+ * of the string as name_len is only used to tell if an entry has a name.
+ *
+ * given:
+ *	index		index to build
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	len		number of JSON semantic table entries
+ *
+ * returns:
+ *	true ==> index built, free index->slot when done
+ *	false ==> calloc error
+ */
+static bool
+sem_index_build(struct sem_index *index, struct json_sem *sem, int len)
+{
+    struct sem_index_slot *slot = NULL;	/* slot of a key */
+    bool any_name = false;		/* true ==> entry matches a JTYPE_MEMBER of any name */
+    uint32_t name_hash;			/* json_name_hash() of an entry name */
+    int i;
+
+    /*
+     * size the index to be at most half full
+     *
+     * Each entry adds at most two keys: one for its depth and type, and one
+     * for its depth, type and name.
+     */
+    index->size = 16;
+    while (index->size < (size_t)len * 4) {
+	index->size *= 2;
+    }
+    index->slot = calloc(index->size, sizeof(index->slot[0]));
+    if (index->slot == NULL) {
+	warn(__func__, "calloc of %ju slots failed", (uintmax_t)index->size);
+	return false;
+    }
+
+    /*
+     * index each entry, in table order, so that each slot holds the first match
+     */
+    for (i=0; i < len; ++i) {
+
+	/*
+	 * key: depth and type
+	 */
+	any_name = (sem[i].type != JTYPE_MEMBER || sem[i].name_len == 0 || sem[i].name == NULL);
+	slot = sem_index_slot(index, sem[i].depth, sem[i].type, NULL, 0);
+	if (slot->type == JTYPE_UNSET) {
+	    slot->depth = sem[i].depth;
+	    slot->type = sem[i].type;
+	    slot->name = NULL;
+	    slot->hash = sem_index_hash(sem[i].depth, sem[i].type, 0);
+	    slot->first = i;
+	    slot->any_name = -1;
+	}
+	if (any_name == true) {
+	    if (slot->any_name < 0) {
+		slot->any_name = i;
+	    }
+	    continue;
+	}
+
+	/*
+	 * key: depth, type and name
+	 */
+	name_hash = json_name_hash(sem[i].name, strlen(sem[i].name));
+	slot = sem_index_slot(index, sem[i].depth, sem[i].type, sem[i].name, name_hash);
+	if (slot->type == JTYPE_UNSET) {
+	    slot->depth = sem[i].depth;
+	    slot->type = sem[i].type;
+	    slot->name = sem[i].name;
+	    slot->hash = sem_index_hash(sem[i].depth, sem[i].type, name_hash);
+	    slot->first = i;
+	    slot->any_name = -1;
+	}
+    }
+    json_dbg(JSON_DBG_VHIGH, __func__, "indexed %d JSON semantic table entries in %ju slots",
+	     len, (uintmax_t)index->size);
+    return true;
+}
+
+
+/*
+ * sem_table_sum - checksum what a JSON semantic table index is built from
+ *
+ * The sum is a 64-bit FNV-1a hash of the depth, type, name_len and name of
+ * each entry.  The address of each name is summed as well as its bytes
+ * because the index points to the names of the table.
+ *
+ * given:
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	len		number of JSON semantic table entries
+ *
+ * returns:
+ *	checksum of the JSON semantic table
+ */
+static uint64_t
+sem_table_sum(struct json_sem const *sem, int len)
+{
+    uint64_t sum = 0xcbf29ce484222325ULL;	/* FNV-1a offset basis */
+    uint64_t word[4];				/* fields of an entry to add to the sum */
+    char const *p;
+    int i;
+    int j;
+
+    for (i=0; i < len; ++i) {
+	word[0] = (uint64_t)sem[i].depth;
+	word[1] = (uint64_t)sem[i].type;
+	word[2] = (uint64_t)sem[i].name_len;
+	word[3] = (uint64_t)(uintptr_t)sem[i].name;
+	for (j=0; j < 4; ++j) {
+	    sum ^= word[j];
+	    sum *= 0x100000001b3ULL;	/* FNV-1a 64-bit prime */
+	}
+	if (sem[i].name != NULL) {
+	    for (p = sem[i].name; *p != '\0'; ++p) {
+		sum ^= (uint64_t)(unsigned char)*p;
+		sum *= 0x100000001b3ULL;
+	    }
+	}
+    }
+    return sum;
+}
+
+
+/*
+ * sem_index_get - index a JSON semantic table, or return its index from an earlier check
+ *
+ * The index is built the first time that the table is checked.  Threads that
+ * check the same table at the same time wait for the one that builds it.
+ * An index of an earlier table at the same address and of the same length,
+ * but with a different sem_table_sum(), is freed and the table is indexed again.
+ *
+ * given:
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	len		number of JSON semantic table entries
+ *
+ * returns:
+ *	index of the JSON semantic table, which must not be freed,
+ *	or NULL ==> the table could not be indexed
+ */
+static struct sem_index const *
+sem_index_get(struct json_sem *sem, int len)
+{
+    struct sem_cache **pcache = NULL;	/* link to the cached index */
+    struct sem_cache *cache = NULL;	/* cached index of the table */
+    uint64_t sum;			/* sem_table_sum() of the table */
+    int ret;				/* pthread_mutex_lock() return */
+
+    /*
+     * find the index of the table, or else index the table
+     */
+    sum = sem_table_sum(sem, len);
+    ret = pthread_mutex_lock(&sem_cache_lock);
+    if (ret != 0) {
+	errno = ret;
+	warnp(__func__, "pthread_mutex_lock failed");
+	return NULL;
+    }
+    pcache = &sem_cache;
+    while (*pcache != NULL) {
+	cache = *pcache;
+	if (cache->sem != sem || cache->len != len) {
+	    pcache = &cache->next;
+	    continue;
+	}
+	if (cache->sum == sum) {
+	    break;
+	}
+
+	/*
+	 * the index is of an earlier table at this address: free it
+	 */
+	json_dbg(JSON_DBG_HIGH, __func__, "JSON semantic table changed, indexing it again");
+	*pcache = cache->next;
+	free(cache->index.slot);
+	cache->index.slot = NULL;
+	free(cache);
+    }
+    cache = *pcache;
+    if (cache == NULL) {
+	cache = calloc(1, sizeof(*cache));
+	if (cache == NULL) {
+	    warn(__func__, "calloc of the JSON semantic table index failed");
+	} else if (sem_index_build(&cache->index, sem, len) == false) {
+	    free(cache);
+	    cache = NULL;
+	} else {
+	    cache->sem = sem;
+	    cache->len = len;
+	    cache->sum = sum;
+	    cache->next = sem_cache;
+	    sem_cache = cache;
+
 	    /*
-	     * try to validate
+	     * free the kept indexes at exit
 	     */
-	    test = sem[index].validate(node, depth, sem, &error);
+	    if (sem_cache_atexit == false && atexit(sem_cache_free) == 0) {
+		sem_cache_atexit = true;
+	    }
+	}
+    }
+    (void) pthread_mutex_unlock(&sem_cache_lock);
+    return (cache != NULL) ? &cache->index : NULL;
+}
+
+
+/*
+ * sem_cache_free - free the index kept of every JSON semantic table
+ *
+ * This function is registered with atexit() when the first index is kept.
+ */
+static void
+sem_cache_free(void)
+{
+    json_sem_free_index(NULL);
+    return;
+}
+
+
+/*
+ * json_sem_free_index - free the index kept of a JSON semantic table
+ *
+ * json_sem_check() keeps the index of each JSON semantic table that it has
+ * checked.  An index no longer matches a table that is changed, but freeing
+ * the index of a table that is to be changed or freed releases its memory
+ * at once.  No check of the table may be in progress.  The indexes that are
+ * still kept are freed at exit.
+ *
+ * given:
+ *	sem		pointer to a JSON semantic table or NULL ==> free the index of every table
+ */
+void
+json_sem_free_index(struct json_sem *sem)
+{
+    struct sem_cache **pcache = NULL;	/* link to the cached index */
+    struct sem_cache *cache = NULL;	/* cached index to free */
+    int ret;				/* pthread_mutex_lock() return */
+
+    /*
+     * unlink and free the index of the table, or of every table
+     */
+    ret = pthread_mutex_lock(&sem_cache_lock);
+    if (ret != 0) {
+	errno = ret;
+	warnp(__func__, "pthread_mutex_lock failed");
+	return;
+    }
+    pcache = &sem_cache;
+    while (*pcache != NULL) {
+	cache = *pcache;
+	if (sem != NULL && cache->sem != sem) {
+	    pcache = &cache->next;
+	    continue;
+	}
+	*pcache = cache->next;
+	free(cache->index.slot);
+	cache->index.slot = NULL;
+	free(cache);
+    }
+    (void) pthread_mutex_unlock(&sem_cache_lock);
+    return;
+}
+
+
+/*
+ * sem_index_find - given JSON node, find first match in an indexed JSON semantic table
+ *
+ * This function returns what json_sem_find() returns, without a scan of the
+ * JSON semantic table.
+ *
+ * given:
+ *	index		index of the JSON semantic table from sem_index_build()
+ *	node		pointer to a JSON parse tree
+ *	depth		depth of node in the JSON parse tree (0 ==> tree root)
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *
+ * returns:
+ *	>=0 ==> index into JSON semantic table for first match
+ *	-1  ==> no JSON semantic table match found
+ *	< -1 ==> invalid JSON node, or NULL ptr, or internal error
+ */
+static int
+sem_index_find(struct sem_index const *index, struct json *node, unsigned int depth, struct json_sem *sem)
+{
+    struct sem_index_slot const *slot = NULL;	/* slot of the depth and type of node */
+    struct sem_index_slot const *named = NULL;	/* slot of the depth, type and name of node */
+    char *name = NULL;				/* name of JTYPE_MEMBER node or NULL */
+    uint32_t name_hash = 0;			/* json_name_hash() of name */
+    int ret;					/* sem_node_name() result */
+
+    /*
+     * firewall - args
+     */
+    if (index == NULL || index->slot == NULL) {
+	warn(__func__, "index is NULL");
+	return -5;
+    }
+
+    /*
+     * obtain information about the JSON node
+     */
+    ret = sem_node_name(node, depth, sem, &name, &name_hash);
+    if (ret < 0) {
+	return ret;
+    }
+
+    /*
+     * find the first entry of the depth and type of the node
+     */
+    slot = sem_index_slot(index, depth, node->type, NULL, 0);
+    if (slot->type == JTYPE_UNSET) {
+	return -1;	/* no match */
+    }
+    if (node->type != JTYPE_MEMBER || name == NULL) {
+	return slot->first;	/* match found */
+    }
+
+    /*
+     * case: JTYPE_MEMBER - the first entry with the name or that matches any name
+     */
+    named = sem_index_slot(index, depth, node->type, name, name_hash);
+    if (named->type == JTYPE_UNSET) {
+	return slot->any_name;	/* match found or -1 ==> no match */
+    }
+    if (slot->any_name >= 0 && slot->any_name < named->first) {
+	return slot->any_name;	/* match found */
+    }
+    return named->first;	/* match found */
+}
+
+
+/*
+ * sem_walk - JSON parse tree semantic tree check walk
+ *
+ * given:
+ *	node	pointer to a JSON parser tree node to free
+ *	depth	current tree depth (0 ==> top of tree)
+ *	ctx	pointer to a struct sem_walk_ctx holding:
+ *
+ *		sem		JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *		index		index of the JSON semantic table
+ *		count_err	dynamic array of JSON semantic count errors
+ *		val_err		dynamic array of JSON semantic validation errors
+ *		count		number of times each JSON semantic was matched
+ *		fail_fast	true ==> check no more nodes once an error is found
+ *		errors		number of errors appended by the walk
+ *
+ * NOTE: This function does nothing if node == NULL or ctx == NULL.
+ *
+ * NOTE: This function does nothing if the node type is invalid.
+ */
+static void
+sem_walk(struct json *node, unsigned int depth, void *ctx)
+{
+    struct sem_walk_ctx *walk = (struct sem_walk_ctx *)ctx;	/* semantic table and error arrays */
+    struct json_sem *sem = NULL;	/* JSON semantic table (ends with a JTYPE_UNSET JSON type) */
+    struct dyn_array *count_err = NULL;	/* dynamic array of JSON semantic count errors */
+    struct dyn_array *val_err = NULL;	/* dynamic array of JSON semantic validation errors */
+    bool test = true;			/* validation test result */
+    struct json_sem_val_err *error = NULL;/* pointer to semantic validation error */
+    struct json_sem_count_err count;	/* semantic count error */
+    int index = -1;			/* semantic array index match or -1 ==> no march or < -1 ==> error */
+
+    /*
+     * firewall - nothing to do for a NULL node
+     */
+    if (node == NULL || walk == NULL) {
+	return;
+    }
+
+    /*
+     * obtain the semantic table and error arrays
+     */
+    sem = walk->sem;
+    count_err = walk->count_err;
+    val_err = walk->val_err;
+    if (sem == NULL || (walk->index == NULL && walk->match == NULL) ||
+	count_err == NULL || val_err == NULL || walk->count == NULL) {
+	return;
+    }
+
+    /*
+     * with fail-fast, check no more nodes once an error is found
+     */
+    if (walk->fail_fast == true && walk->errors > 0) {
+	return;
+    }
+
+    /*
+     * search for node match in the semantic table
+     *
+     * A compiled match also calls the validate function of the match it finds.
+     */
+    if (walk->match != NULL) {
+	index = walk->match(node, depth, sem, &test, &error);
+	if (index >= walk->len) {
+	    warn(__func__, "compiled match returned %d >= semantic table length %d", index, walk->len);
+	    index = -6;
+	}
+    } else {
+	index = sem_index_find(walk->index, node, depth, sem);
+    }
+
+    /*
+     * process search result
+     */
+    if (index >= 0) {
+
+	/*
+	 * semantic table match, count node use
+	 *
+	 * NOTE: We always count a match regardless of validation status
+	 */
+	++(walk->count[index]);
+
+	/*
+	 * execute validation function is available, unless a compiled match already has
+	 */
+	if (walk->match == NULL && sem[index].validate != NULL) {
 
 	    /*
-	     * case: validation failed
+	     * try to validate
 	     */
-	    if (test == false) {
+	    test = sem[index].validate(node, depth, sem, &error);
+	}
 
-		/* be sure we have a validation error message */
-		if (error == NULL) {
-		    /* error is NULL, assume sem_val_err_NULL */
-		    error = &sem_val_err_NULL;
+	/*
+	 * case: validation failed
+	 */
+	if (test == false) {
 
-		/* record semantic table index */
-		} else {
-		    error->sem_index = sem[index].sem_index;
-		}
+	    /* be sure we have a validation error message */
+	    if (error == NULL) {
+		/* error is NULL, assume sem_val_err_NULL */
+		error = &sem_val_err_NULL;
 
-		/* save validation error message */
-		dyn_array_append_value(val_err, error);
+	    /* record semantic table index */
+	    } else {
+		error->sem_index = index;
 	    }
+
+	    /* save validation error message */
+	    dyn_array_append_value(val_err, error);
+	    ++walk->errors;
 	}
 
     } else if (index == -1) {
@@ -2065,6 +2776,7 @@ sem_walk(struct json *node, unsigned int depth, va_list ap)
 
 		    /* also save validation error message */
 		    dyn_array_append_value(val_err, error);
+		    ++walk->errors;
 
 		} else {
 		    snmsg(count.diagnostic, BUFSIZ, "depth: %u type: %s name: \"%s\"; unexpected node",
@@ -2079,6 +2791,7 @@ sem_walk(struct json *node, unsigned int depth, va_list ap)
 
 	/* save semantic count error */
 	dyn_array_append_value(count_err, &count);
+	++walk->errors;
 
     } else {
 
@@ -2104,16 +2817,300 @@ sem_walk(struct json *node, unsigned int depth, va_list ap)
 
 	/* save semantic count error */
 	dyn_array_append_value(count_err, &count);
+	++walk->errors;
     }
+    return;
+}
+
+
+/*
+ * sem_collect - list a JSON parse tree node for a parallel semantic check
+ *
+ * given:
+ *	node	pointer to a JSON parser tree node to list
+ *	depth	current tree depth (0 ==> top of tree)
+ *	ctx	pointer to a dynamic array of struct sem_node
+ *
+ * NOTE: This function does nothing if node == NULL or ctx == NULL.
+ */
+static void
+sem_collect(struct json *node, unsigned int depth, void *ctx)
+{
+    struct dyn_array *nodes = (struct dyn_array *)ctx;	/* nodes of the JSON parse tree in walk order */
+    struct sem_node item;				/* node to list */
 
     /*
-     * stdarg variable argument list cleanup
+     * firewall - nothing to do for a NULL node
+     */
+    if (node == NULL || nodes == NULL) {
+	return;
+    }
+
+    /*
+     * list the node
      */
-    va_end(ap2);
+    item.node = node;
+    item.depth = depth;
+    (void) dyn_array_append_value(nodes, &item);
     return;
 }
 
 
+/*
+ * sem_worker - check a run of JSON parse tree nodes on a worker thread
+ *
+ * given:
+ *	arg	pointer to the struct sem_worker of this thread
+ *
+ * returns:
+ *	NULL
+ */
+static void *
+sem_worker(void *arg)
+{
+    struct sem_worker *self = (struct sem_worker *)arg;	/* this worker thread */
+    struct sem_pool *pool = NULL;			/* nodes shared by the worker threads */
+    struct sem_node *item = NULL;			/* node being checked */
+    bool stop = false;					/* true ==> an earlier run of nodes has an error */
+    intmax_t i;
+
+    /*
+     * firewall
+     */
+    if (self == NULL || self->pool == NULL || self->pool->nodes == NULL) {
+	warn(__func__, "worker thread or its pool is NULL");
+	return NULL;
+    }
+    pool = self->pool;
+
+    /*
+     * check each node of the run, in walk order
+     */
+    for (i=self->first; i < self->end; ++i) {
+
+	/*
+	 * with fail-fast, stop once a worker thread with an earlier run of nodes has found an error
+	 */
+	if (self->walk.fail_fast == true && (i - self->first) % JSON_SEM_BATCH == 0) {
+	    (void) pthread_mutex_lock(&pool->lock);
+	    stop = (pool->first_err < self->id);
+	    (void) pthread_mutex_unlock(&pool->lock);
+	    if (stop == true) {
+		break;
+	    }
+	}
+
+	/*
+	 * check the node
+	 */
+	item = dyn_array_addr(pool->nodes, struct sem_node, i);
+	sem_walk(item->node, item->depth, &self->walk);
+
+	/*
+	 * with fail-fast, stop at the first error and tell the worker threads with later runs of nodes
+	 */
+	if (self->walk.fail_fast == true && self->walk.errors > 0) {
+	    (void) pthread_mutex_lock(&pool->lock);
+	    if (self->id < pool->first_err) {
+		pool->first_err = self->id;
+	    }
+	    (void) pthread_mutex_unlock(&pool->lock);
+	    break;
+	}
+    }
+    return NULL;
+}
+
+
+/*
+ * sem_check_parallel - check the nodes of a JSON parse tree on worker threads
+ *
+ * The nodes of the JSON parse tree are listed in walk order and split into
+ * runs of at least min_nodes nodes, one per worker thread.  The first run is
+ * checked on the calling thread with the counts and errors of walk.  The
+ * other runs are checked with their own counts and errors, which are then
+ * merged into those of walk in the order of the runs, so that the errors are
+ * the same, and in the same order, as those of a walk on the calling thread.
+ *
+ * With fail-fast, the merge stops after the first run that has an error.
+ *
+ * given:
+ *	node		pointer to a JSON parse tree
+ *	max_depth	maximum tree depth to descend, or 0 ==> infinite depth
+ *	walk		semantic tree check walk context of the calling thread
+ *	threads		most worker threads, including the calling thread
+ *	min_nodes	fewest nodes checked by a worker thread
+ *
+ * returns:
+ *	true ==> the nodes of the JSON parse tree were checked,
+ *	false ==> no node was checked because memory could not be allocated
+ */
+static bool
+sem_check_parallel(struct json *node, unsigned int max_depth, struct sem_walk_ctx *walk,
+		   unsigned int threads, uintmax_t min_nodes)
+{
+    struct sem_pool pool;		/* nodes shared by the worker threads */
+    struct sem_worker *worker = NULL;	/* worker threads */
+    struct sem_worker *w = NULL;	/* worker thread being started, joined or merged */
+    uintmax_t nodes = 0;		/* number of nodes in the JSON parse tree */
+    unsigned int workers = 0;		/* number of worker threads, including the calling thread */
+    bool merge = true;			/* true ==> merge the counts and errors of the next run */
+    int ret;				/* pthread_create() return */
+    unsigned int i;
+    int j;
+
+    /*
+     * firewall
+     */
+    if (node == NULL || walk == NULL || walk->count == NULL ||
+	walk->count_err == NULL || walk->val_err == NULL) {
+	warn(__func__, "node or walk context is NULL");
+	return false;
+    }
+    if (min_nodes == 0) {
+	min_nodes = JSON_SEM_MIN_NODES;
+    }
+
+    /*
+     * list the nodes of the JSON parse tree in walk order
+     */
+    pool.nodes = dyn_array_create(sizeof(struct sem_node), JSON_CHUNK, JSON_CHUNK, false);
+    if (pool.nodes == NULL) {
+	warn(__func__, "dyn_array_create() failed to create the node list");
+	return false;
+    }
+    json_walk(node, max_depth, 0, true, sem_collect, pool.nodes);
+    nodes = (uintmax_t)dyn_array_tell(pool.nodes);
+
+    /*
+     * give each worker thread at least min_nodes nodes
+     */
+    workers = (nodes / min_nodes < threads) ? (unsigned int)(nodes / min_nodes) : threads;
+    if (workers < 1) {
+	workers = 1;
+    }
+    json_dbg(JSON_DBG_HIGH, __func__, "checking %ju nodes on %u worker threads", nodes, workers);
+
+    /*
+     * set up the run of nodes of each worker thread
+     */
+    worker = calloc(workers, sizeof(worker[0]));
+    if (worker == NULL) {
+	warn(__func__, "calloc of %u worker threads failed", workers);
+	dyn_array_free(pool.nodes);
+	return false;
+    }
+    pool.first_err = workers;
+    (void) pthread_mutex_init(&pool.lock, NULL);
+    for (i=0; i < workers; ++i) {
+	w = &worker[i];
+	w->id = i;
+	w->pool = &pool;
+	w->first = (intmax_t)(nodes * i / workers);
+	w->end = (intmax_t)(nodes * (i+1) / workers);
+	w->walk = *walk;
+	w->walk.errors = 0;
+	if (i > 0) {
+	    w->walk.count = calloc((size_t)walk->len + 1, sizeof(w->walk.count[0]));
+	    w->walk.count_err = dyn_array_create(sizeof(struct json_sem_count_err), JSON_CHUNK, JSON_CHUNK, true);
+	    w->walk.val_err = dyn_array_create(sizeof(struct json_sem_val_err), JSON_CHUNK, JSON_CHUNK, true);
+	    if (w->walk.count == NULL || w->walk.count_err == NULL || w->walk.val_err == NULL) {
+		warn(__func__, "failed to allocate the counts and errors of worker thread %u", i);
+		for (j=(int)i; j > 0; --j) {
+		    w = &worker[j];
+		    if (w->walk.count != NULL) {
+			free(w->walk.count);
+			w->walk.count = NULL;
+		    }
+		    if (w->walk.count_err != NULL) {
+			dyn_array_free(w->walk.count_err);
+			w->walk.count_err = NULL;
+		    }
+		    if (w->walk.val_err != NULL) {
+			dyn_array_free(w->walk.val_err);
+			w->walk.val_err = NULL;
+		    }
+		}
+		(void) pthread_mutex_destroy(&pool.lock);
+		free(worker);
+		worker = NULL;
+		dyn_array_free(pool.nodes);
+		return false;
+	    }
+	}
+    }
+
+    /*
+     * start the worker threads, other than the first run which is checked on this thread
+     */
+    for (i=1; i < workers; ++i) {
+	ret = pthread_create(&worker[i].thread, NULL, sem_worker, &worker[i]);
+	if (ret != 0) {
+	    errno = ret;
+	    warnp(__func__, "could only start %u of %u worker threads", i-1, workers-1);
+	    break;
+	}
+	worker[i].started = true;
+    }
+
+    /*
+     * check the first run of nodes on this thread
+     */
+    (void) sem_worker(&worker[0]);
+    walk->errors += worker[0].walk.errors;
+    if (walk->fail_fast == true && worker[0].walk.errors > 0) {
+	merge = false;
+    }
+
+    /*
+     * wait for each worker thread, or check its run of nodes on this thread if
+     * the thread could not be started, and merge its counts and errors in order
+     */
+    for (i=1; i < workers; ++i) {
+	w = &worker[i];
+	if (w->started == true) {
+	    (void) pthread_join(w->thread, NULL);
+	} else if (merge == true) {
+	    (void) sem_worker(w);
+	}
+
+	/*
+	 * merge, or with fail-fast after an earlier error, discard, the counts and errors of the run
+	 */
+	if (merge == true) {
+	    for (j=0; j < walk->len; ++j) {
+		walk->count[j] += w->walk.count[j];
+	    }
+	    (void) dyn_array_concat_array(walk->count_err, w->walk.count_err);
+	    (void) dyn_array_concat_array(walk->val_err, w->walk.val_err);
+	    walk->errors += w->walk.errors;
+	    if (walk->fail_fast == true && w->walk.errors > 0) {
+		merge = false;
+	    }
+	    dyn_array_free(w->walk.count_err);
+	    dyn_array_free(w->walk.val_err);
+	} else {
+	    free_count_err(w->walk.count_err);
+	    free_val_err(w->walk.val_err);
+	}
+	w->walk.count_err = NULL;
+	w->walk.val_err = NULL;
+	free(w->walk.count);
+	w->walk.count = NULL;
+    }
+
+    /*
+     * free the worker threads and the node list
+     */
+    (void) pthread_mutex_destroy(&pool.lock);
+    free(worker);
+    worker = NULL;
+    dyn_array_free(pool.nodes);
+    pool.nodes = NULL;
+    return true;
+}
+
+
 /*
  * json_sem_check - check a JSON parse tree against a JSON semantic table
  *
@@ -2133,11 +3130,19 @@ sem_walk(struct json *node, unsigned int depth, va_list ap)
  * function returns false (indicating a JSON semantic validation error is found),
  * the *pval_err dynamic array is appended with the given JSON semantic validation error.
  *
- * Once the JSON parse tree is traversed, the counts in the JSON semantic table
- * are checked against the minimum and maximum allowed counts.  When a count
+ * Once the JSON parse tree is traversed, the number of matches of each JSON semantic
+ * table entry is checked against the minimum and maximum allowed counts.  When a count
  * is found to be out of range, JSON semantic count error is appended to
  * the *pcount_err dynamic array.
  *
+ * The matches are counted by this call and not in the count of each JSON semantic
+ * table entry: the JSON semantic table is only read, so the same table may be used
+ * by calls on other threads at the same time.
+ *
+ * Before the walk, the JSON semantic table is indexed by depth, type and member
+ * name so that the first match of each node, the same one json_sem_find() finds,
+ * is found without a scan of the table.
+ *
  * given:
  *	node		pointer to a JSON parse tree
  *	max_depth	maximum tree depth to descend, or 0 ==> infinite depth
@@ -2164,9 +3169,150 @@ sem_walk(struct json *node, unsigned int depth, va_list ap)
 uintmax_t
 json_sem_check(struct json *node, unsigned int max_depth, struct json_sem *sem,
 	       struct dyn_array **pcount_err, struct dyn_array **pval_err)
+{
+    return sem_check(node, max_depth, sem, NULL, NULL, pcount_err, pval_err);
+}
+
+
+/*
+ * json_sem_check_match - check a JSON parse tree with a compiled JSON semantic table match
+ *
+ * This function checks a JSON parse tree as json_sem_check() does, except that
+ * the first match of each node, and its validation, comes from a call of match
+ * instead of from an index of the JSON semantic table.
+ *
+ * The match function is generated by jsemtblgen -C, along with the JSON semantic
+ * table it matches, so that it finds each node with a switch on the depth, type
+ * and hash of the name of the node and calls the validate function of the
+ * match directly.  When the match has a validate function that returns false,
+ * the match sets *valid to false and *val_err to the JSON semantic validation
+ * error, if any.  The JSON semantic table is still used for the minimum and
+ * maximum counts and to report errors.
+ *
+ * given:
+ *	node		pointer to a JSON parse tree
+ *	max_depth	maximum tree depth to descend, or 0 ==> infinite depth
+ *			    NOTE: Use JSON_INFINITE_DEPTH for infinite depth
+ *			    NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	match		compiled match of the JSON semantic table, returns:
+ *			    >=0 ==> index into JSON semantic table for first match
+ *			    -1  ==> no JSON semantic table match found
+ *			    < -1 ==> invalid JSON node, or NULL ptr, or internal error
+ *	pcount_err	pointer to dynamic array of JSON semantic count errors,
+ *			    NOTE: If *pcount_err == NULL, the dynamic array will be created,
+ *				  If *pcount_err != NULL, the existing dynamic array will be used.
+ *	pval_err	pointer to dynamic array of JSON semantic validation errors
+ *			    NOTE: If *pcount_err == NULL, the dynamic array will be created,
+ *				  If *pcount_err != NULL, the existing dynamic array will be used.
+ *
+ * return:
+ *	0 ==> JSON parse tree is semantically consistent with the JSON semantic table,
+ *	> 0  ==> number of errors (count+validation+internal) found
+ */
+uintmax_t
+json_sem_check_match(struct json *node, unsigned int max_depth, struct json_sem *sem,
+		     int (*match)(struct json const *, unsigned int, struct json_sem *, bool *,
+				  struct json_sem_val_err **),
+		     struct dyn_array **pcount_err, struct dyn_array **pval_err)
+{
+    /*
+     * firewall - check args
+     */
+    if (match == NULL) {
+	warn(__func__, "match is NULL");
+	return 1;
+    }
+    return sem_check(node, max_depth, sem, match, NULL, pcount_err, pval_err);
+}
+
+
+/*
+ * json_sem_check_opt - check a JSON parse tree against a JSON semantic table, with options
+ *
+ * This function checks a JSON parse tree as json_sem_check() does, or when
+ * match != NULL as json_sem_check_match() does, with the options of opt.
+ *
+ * With opt->fail_fast, the check stops at the first JSON node, in walk order,
+ * that has an error, and the minimum and maximum counts are only checked when
+ * no node has an error, up to the first count error.  The caller then gets a
+ * yes/no answer along with the first error.
+ *
+ * With opt->threads other than 1, the nodes of the JSON parse tree are listed
+ * in walk order and split into runs of at least opt->min_nodes nodes that are
+ * checked on worker threads.  Large JSON arrays, such as the manifest of an
+ * entry, are split across the runs.  The counts and errors of the runs are
+ * merged in walk order, so the errors are the same, and in the same order, as
+ * those found on a single thread.  The validate functions of the JSON semantic
+ * table, or of the compiled match, must be safe to call on several threads at
+ * the same time.
+ *
+ * given:
+ *	node		pointer to a JSON parse tree
+ *	max_depth	maximum tree depth to descend, or 0 ==> infinite depth
+ *			    NOTE: Use JSON_INFINITE_DEPTH for infinite depth
+ *			    NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	match		compiled match of the JSON semantic table or NULL ==> index the table
+ *	opt		how to check the JSON parse tree or NULL ==> as json_sem_check()
+ *	pcount_err	pointer to dynamic array of JSON semantic count errors,
+ *			    NOTE: If *pcount_err == NULL, the dynamic array will be created,
+ *				  If *pcount_err != NULL, the existing dynamic array will be used.
+ *	pval_err	pointer to dynamic array of JSON semantic validation errors
+ *			    NOTE: If *pcount_err == NULL, the dynamic array will be created,
+ *				  If *pcount_err != NULL, the existing dynamic array will be used.
+ *
+ * return:
+ *	0 ==> JSON parse tree is semantically consistent with the JSON semantic table,
+ *	> 0  ==> number of errors (count+validation+internal) found
+ *
+ * NOTE: When worker threads cannot be started, their runs of nodes are checked
+ *	 on the calling thread.
+ */
+uintmax_t
+json_sem_check_opt(struct json *node, unsigned int max_depth, struct json_sem *sem,
+		   int (*match)(struct json const *, unsigned int, struct json_sem *, bool *,
+				struct json_sem_val_err **),
+		   struct json_sem_opt const *opt,
+		   struct dyn_array **pcount_err, struct dyn_array **pval_err)
+{
+    return sem_check(node, max_depth, sem, match, opt, pcount_err, pval_err);
+}
+
+
+/*
+ * sem_check - check a JSON parse tree against a JSON semantic table
+ *
+ * given:
+ *	node		pointer to a JSON parse tree
+ *	max_depth	maximum tree depth to descend, or 0 ==> infinite depth
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	match		compiled match of the JSON semantic table or NULL ==> index the table
+ *	opt		how to check the JSON parse tree or NULL ==> all nodes on the calling thread
+ *	pcount_err	pointer to dynamic array of JSON semantic count errors
+ *	pval_err	pointer to dynamic array of JSON semantic validation errors
+ *
+ * return:
+ *	0 ==> JSON parse tree is semantically consistent with the JSON semantic table,
+ *	> 0  ==> number of errors (count+validation+internal) found
+ *
+ * See json_sem_check() and json_sem_check_opt() for details.
+ */
+static uintmax_t
+sem_check(struct json *node, unsigned int max_depth, struct json_sem *sem,
+	  int (*match)(struct json const *, unsigned int, struct json_sem *, bool *,
+		       struct json_sem_val_err **),
+	  struct json_sem_opt const *opt,
+	  struct dyn_array **pcount_err, struct dyn_array **pval_err)
 {
     struct dyn_array *count_err = NULL;		/* JSON semantic count errors */
     struct dyn_array *val_err = NULL;		/* JSON semantic validation errors */
+    struct sem_walk_ctx walk;			/* semantic tree check walk context */
+    struct sem_index const *index = NULL;	/* index of the JSON semantic table */
+    unsigned int *count = NULL;			/* number of times each JSON semantic was matched */
+    int len = 0;				/* number of JSON semantic table entries */
+    unsigned int threads = 1;			/* most worker threads, including the calling thread */
+    long cpus = 0;				/* number of online CPUs */
     uintmax_t errors = 0;			/* number of errors (count+validation+internal) */
 
     /*
@@ -2230,23 +3376,78 @@ json_sem_check(struct json *node, unsigned int max_depth, struct json_sem *sem,
     }
 
     /*
-     * zero semantic counts
+     * start with no matches
      *
-     * NOTE: This is very important because the semantic tables have counts
-     *	     that are initialized with the count of the reference JSON file
-     *	     that jsemcgen.sh used to generate them.
+     * NOTE: The counts in the semantic tables are those of the reference JSON
+     *	     file that jsemcgen.sh used to generate them, so they are not used.
      */
-    json_sem_zero_count(sem);
+    for (len=0; sem[len].type != JTYPE_UNSET; ++len) {
+	/* count the JSON semantic table entries */
+    }
+    count = calloc((size_t)len + 1, sizeof(count[0]));
+    if (count == NULL) {
+	warn(__func__, "calloc of %d counts failed", len + 1);
+	return 1;
+    }
+
+    /*
+     * index the JSON semantic table so that each node is found without a scan of the table
+     *
+     * NOTE: The table is indexed the first time that it is checked and the
+     *	     index is kept for later checks.  A compiled match of the table
+     *	     needs no index.
+     */
+    if (match == NULL && (index = sem_index_get(sem, len)) == NULL) {
+	warn(__func__, "failed to index the JSON semantic table");
+	free(count);
+	count = NULL;
+	return 1;
+    }
 
     /*
      * perform a semantic scan of the JSON parse tree
      */
-    json_tree_walk(node, max_depth, 0, true, sem_walk, sem, count_err, val_err);
+    walk.sem = sem;
+    walk.index = index;
+    walk.match = match;
+    walk.len = len;
+    walk.count_err = count_err;
+    walk.val_err = val_err;
+    walk.count = count;
+    walk.fail_fast = (opt != NULL) ? opt->fail_fast : false;
+    walk.errors = 0;
+
+    /*
+     * determine the number of worker threads
+     */
+    if (opt != NULL) {
+	threads = opt->threads;
+	if (threads == 0) {
+	    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	    threads = (cpus > 0) ? (unsigned int)((cpus < JSON_SEM_MAX_THREADS) ? cpus : JSON_SEM_MAX_THREADS) : 1;
+	} else if (threads > JSON_SEM_MAX_THREADS) {
+	    threads = JSON_SEM_MAX_THREADS;
+	}
+    }
+
+    /*
+     * check the nodes on worker threads, or else on this thread
+     */
+    if (threads <= 1 ||
+	sem_check_parallel(node, max_depth, &walk, threads, opt->min_nodes) == false) {
+	json_walk(node, max_depth, 0, true, sem_walk, &walk);
+    }
 
     /*
      * check semantic table counts
+     *
+     * NOTE: With fail-fast, the counts are incomplete once a node has an error.
      */
-    json_sem_count_chk(sem, count_err);
+    if (walk.fail_fast == false || walk.errors == 0) {
+	sem_count_chk(sem, count, count_err, walk.fail_fast);
+    }
+    free(count);
+    count = NULL;
 
     /*
      * count errors, if any
@@ -47,6 +47,9 @@
  */
 #define INF (0)			/* special max value for no limit */
 #define INF_DEPTH (UINT_MAX)	/* no depth */
+#define JSON_SEM_MIN_NODES (4096)	/* fewest JSON parse tree nodes checked by a worker thread */
+#define JSON_SEM_MAX_THREADS (256)	/* most worker threads used to check a JSON parse tree */
+#define JSON_SEM_BATCH (64)		/* nodes a worker thread checks between looks for an earlier error */
 
 
  /*
@@ -95,7 +98,7 @@ struct json_sem
     enum item_type type;	/* type of JSON node, JTYPE_UNSET ==> end of table */
     unsigned int min;		/* minimum allowed count */
     unsigned int max;		/* maximum allowed count, 0 ==> infinite */
-    unsigned int count;		/* number of times this JSON semantic was matched */
+    unsigned int count;		/* number of times this JSON semantic was matched (not set by json_sem_check()) */
     int sem_index;		/* index of sem in JSON semantic table or -1 ==> end of the table */
     size_t name_len;		/* if type == JTYPE_MEMBER length of name_str (not including final NUL) or 0 */
     bool (* validate)(struct json const *node,
@@ -105,6 +108,28 @@ struct json_sem
 };
 
 
+/*
+ * json_sem_opt - how json_sem_check_opt() checks a JSON parse tree
+ *
+ * With fail_fast, the check stops at the first JSON node, in walk order, that
+ * has an error, or else at the first JSON semantic table entry that was matched
+ * too few or too many times, so that the caller gets a yes/no answer.
+ *
+ * With more than one thread, the nodes of the JSON parse tree, in walk order,
+ * are split into runs of at least min_nodes nodes that are checked on worker
+ * threads.  The counts and errors of each run are merged in walk order, so the
+ * errors are the same, and in the same order, as when the tree is checked on
+ * the calling thread.  The validate functions of the JSON semantic table must
+ * then be safe to call on several threads at the same time.
+ */
+struct json_sem_opt
+{
+    bool fail_fast;		/* true ==> stop at the first error */
+    unsigned int threads;	/* most worker threads, 0 ==> one per online CPU, 1 ==> none */
+    uintmax_t min_nodes;	/* fewest nodes a worker thread checks, 0 ==> JSON_SEM_MIN_NODES */
+};
+
+
 /*
  * str_or_null - report if a JSON JTYPE_MEMBER value is a valid JSON_STRING or a valid JSON_NULL
  *
@@ -146,23 +171,35 @@ extern bool *sem_member_value_bool(struct json const *node, unsigned int depth,
 extern struct str_or_null sem_member_value_str_or_null(struct json const *node, unsigned int depth,
 						       struct json_sem *sem,
 						       char const *name, struct json_sem_val_err **val_err);
-extern int *sem_member_value_int(struct json const *node, unsigned int depth, struct json_sem *sem,
-			         char const *name, struct json_sem_val_err **val_err);
-
-extern size_t *sem_member_value_size_t(struct json const *node, unsigned int depth, struct json_sem *sem,
-			         char const *name, struct json_sem_val_err **val_err);
-extern time_t *sem_member_value_time_t(struct json const *node, unsigned int depth, struct json_sem *sem,
-				       char const *name, struct json_sem_val_err **val_err);
+extern struct str_prop const *sem_member_value_str_prop(struct json const *node);
+extern bool sem_member_value_int(struct json const *node, unsigned int depth, struct json_sem *sem,
+				 char const *name, struct json_sem_val_err **val_err, int *value);
+extern bool sem_member_value_size_t(struct json const *node, unsigned int depth, struct json_sem *sem,
+				    char const *name, struct json_sem_val_err **val_err, size_t *value);
+extern bool sem_member_value_time_t(struct json const *node, unsigned int depth, struct json_sem *sem,
+				    char const *name, struct json_sem_val_err **val_err, time_t *value);
 extern struct json *sem_node_parent(struct json const *node, unsigned int depth, struct json_sem *sem,
 				    char const *name, struct json_sem_val_err **val_err);
 extern struct json *sem_object_find_name(struct json const *node, unsigned int depth, struct json_sem *sem,
 				         char const *name, struct json_sem_val_err **val_err,
 				         char const *memname);
 extern void json_sem_zero_count(struct json_sem *sem);
+extern int sem_node_name(struct json const *node, unsigned int depth, struct json_sem *sem,
+			 char **pname, uint32_t *phash);
 extern int json_sem_find(struct json *node, unsigned int depth, struct json_sem *sem);
 extern void json_sem_count_chk(struct json_sem *sem, struct dyn_array *count_err);
 extern uintmax_t json_sem_check(struct json *node, unsigned int max_depth, struct json_sem *sem,
 				struct dyn_array **pcount_err, struct dyn_array **pval_err);
+extern uintmax_t json_sem_check_match(struct json *node, unsigned int max_depth, struct json_sem *sem,
+				      int (*match)(struct json const *, unsigned int, struct json_sem *, bool *,
+						   struct json_sem_val_err **),
+				      struct dyn_array **pcount_err, struct dyn_array **pval_err);
+extern uintmax_t json_sem_check_opt(struct json *node, unsigned int max_depth, struct json_sem *sem,
+				    int (*match)(struct json const *, unsigned int, struct json_sem *, bool *,
+						 struct json_sem_val_err **),
+				    struct json_sem_opt const *opt,
+				    struct dyn_array **pcount_err, struct dyn_array **pval_err);
+extern void json_sem_free_index(struct json_sem *sem);
 extern void free_count_err(struct dyn_array *count_err);
 extern void free_val_err(struct dyn_array *val_err);
 extern void fprint_count_err(FILE *stream, char const *prefix, struct json_sem_count_err *sem_count_err, char const *postfix);
@@ -0,0 +1,1719 @@
+/*
+ * json_tape - flat tape form of a JSON parse tree
+ *
+ * "Because sometimes the shortest path between two nodes is a straight line." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+
+/*
+ * definitions
+ */
+#define TAPE_MIN_ALLOC (64)	/* fewest elements allocated when a tape array first grows */
+
+
+/*
+ * tape_frame - a JSON object or array being put on a tape
+ */
+struct tape_frame
+{
+    struct json const *node;	/* JSON object or array */
+    intmax_t next;		/* index in the set of node of the next member or value */
+    size_t start;		/* tape index of the start word of node */
+};
+
+
+/*
+ * tape_open - a JSON object or elements being formed from a tape
+ */
+struct tape_open
+{
+    struct json *node;		/* JSON object or elements, NOT yet linked into the tree */
+    struct json *name;		/* name of the member whose value node is, or NULL */
+};
+
+
+/*
+ * static functions
+ */
+static void *tape_grow(void *ptr, size_t *alloc, size_t need, size_t size);
+static void tape_word(struct json_tape *tape, enum json_tape_tag tag, size_t payload);
+static bool tape_text(struct json_tape *tape, char const *ptr, size_t len, uint32_t *off);
+static bool tape_string(struct json_tape *tape, struct json_string const *item);
+static bool tape_number(struct json_tape *tape, struct json_number const *item);
+static bool tape_value(struct json_tape *tape, struct json const *node,
+		       struct tape_frame **stack, size_t *alloc, size_t *used);
+static bool tape_link(struct json *node, struct tape_open *stack, size_t used, struct json **name, struct json **tree);
+static bool tape_text_ok(struct json_tape const *tape, size_t off, size_t len);
+static struct json_tape_string const *tape_str_at(struct json_tape const *tape, size_t pos);
+static size_t tape_layout(size_t count, size_t str_count, size_t num_count, size_t text_len, size_t *off);
+static bool tape_section(FILE *stream, void const *ptr, size_t len, size_t off, size_t *written);
+
+
+/*
+ * tape_grow - make room for need elements in an array of a tape
+ *
+ * given:
+ *	ptr	array, or NULL ==> nothing allocated yet
+ *	alloc	pointer to the number of elements allocated for ptr
+ *	need	number of elements needed
+ *	size	size of an element
+ *
+ * returns:
+ *	array with room for at least need elements
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+static void *
+tape_grow(void *ptr, size_t *alloc, size_t need, size_t size)
+{
+    size_t new_alloc = 0;	/* elements to allocate */
+    void *new_ptr = NULL;	/* reallocated array */
+
+    /*
+     * firewall
+     */
+    if (alloc == NULL) {
+	err(100, __func__, "alloc is NULL");
+	not_reached();
+    }
+
+    /*
+     * case: there is already room
+     */
+    if (ptr != NULL && need <= *alloc) {
+	return ptr;
+    }
+
+    /*
+     * double the array, or more if that is not enough
+     */
+    new_alloc = (*alloc < TAPE_MIN_ALLOC) ? TAPE_MIN_ALLOC : *alloc * 2;
+    if (new_alloc < need) {
+	new_alloc = need;
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    new_ptr = realloc(ptr, new_alloc * size);
+    if (new_ptr == NULL) {
+	errp(101, __func__, "realloc of %ju elements of %ju bytes failed", (uintmax_t)new_alloc, (uintmax_t)size);
+	not_reached();
+    }
+    *alloc = new_alloc;
+    return new_ptr;
+}
+
+
+/*
+ * tape_word - add a word to the end of a tape
+ *
+ * given:
+ *	tape	tape to add to
+ *	tag	what the word is
+ *	payload	payload of the word
+ *
+ * NOTE: This function does not return on an allocation error or if payload
+ *	 is too large for a tape word.
+ */
+static void
+tape_word(struct json_tape *tape, enum json_tape_tag tag, size_t payload)
+{
+    /*
+     * firewall
+     */
+    if (tape == NULL) {
+	err(102, __func__, "tape is NULL");
+	not_reached();
+    }
+    if ((uintmax_t)payload > (uintmax_t)JSON_TAPE_PAYLOAD_MAX) {
+	err(103, __func__, "payload: %ju is too large for a tape word", (uintmax_t)payload);
+	not_reached();
+    }
+
+    /*
+     * add the word
+     */
+    tape->word = tape_grow(tape->word, &tape->alloc, tape->count + 1, sizeof(tape->word[0]));
+    tape->word[tape->count++] = JSON_TAPE_WORD(tag, payload);
+    return;
+}
+
+
+/*
+ * tape_text - add bytes to the text of a tape
+ *
+ * given:
+ *	tape	tape to add to
+ *	ptr	bytes to add
+ *	len	number of bytes to add
+ *	off	set to the offset in the text of the tape of the added bytes,
+ *		which are NUL terminated
+ *
+ * returns:
+ *	true ==> bytes added, false ==> the text would be longer than JSON_TAPE_TEXT_MAX
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+static bool
+tape_text(struct json_tape *tape, char const *ptr, size_t len, uint32_t *off)
+{
+    /*
+     * firewall
+     */
+    if (tape == NULL || off == NULL) {
+	err(104, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    if (ptr == NULL && len > 0) {
+	err(105, __func__, "ptr is NULL");
+	not_reached();
+    }
+    if ((uintmax_t)len >= (uintmax_t)JSON_TAPE_TEXT_MAX - (uintmax_t)tape->text_len) {
+	warn(__func__, "text of the tape would be longer than %ju bytes", (uintmax_t)JSON_TAPE_TEXT_MAX);
+	return false;
+    }
+
+    /*
+     * add the bytes and a NUL
+     */
+    tape->text = tape_grow(tape->text, &tape->text_alloc, tape->text_len + len + 1, 1);
+    *off = (uint32_t)tape->text_len;
+    if (len > 0) {
+	memcpy(tape->text + tape->text_len, ptr, len);
+    }
+    tape->text[tape->text_len + len] = '\0';
+    tape->text_len += len + 1;
+    return true;
+}
+
+
+/*
+ * tape_string - add a JSON string word to the end of a tape
+ *
+ * given:
+ *	tape	tape to add to
+ *	item	JSON string to add
+ *
+ * returns:
+ *	true ==> JSON string added,
+ *	false ==> the JSON string has no text or the text of the tape is full
+ */
+static bool
+tape_string(struct json_tape *tape, struct json_string const *item)
+{
+    struct json_tape_string *rec = NULL;	/* JSON string of the tape */
+    size_t len = 0;				/* length of the JSON encoded string sans '"'s */
+    uint32_t off = 0;				/* offset in the text of the decoded string */
+
+    /*
+     * firewall
+     */
+    if (tape == NULL || item == NULL) {
+	warn(__func__, "called with NULL arg(s)");
+	return false;
+    }
+    if (item->as_str == NULL) {
+	warn(__func__, "JSON string has no text");
+	return false;
+    }
+
+    /*
+     * as_str never holds the surrounding '"'s, but when quote is true
+     * as_str_len counts them
+     */
+    len = item->as_str_len;
+    if (item->quote == true) {
+	len = (len >= 2) ? len - 2 : 0;
+    }
+
+    /*
+     * add the JSON string
+     *
+     * A decoded string that is the JSON encoded string shares its text.
+     */
+    tape->str = tape_grow(tape->str, &tape->str_alloc, tape->str_count + 1, sizeof(tape->str[0]));
+    rec = &tape->str[tape->str_count];
+    memset(rec, 0, sizeof(*rec));
+    if (tape_text(tape, item->as_str, len, &rec->as_str) == false) {
+	return false;
+    }
+    rec->as_str_len = (uint32_t)len;
+    if (item->str != NULL && item->str_len == len && memcmp(item->str, item->as_str, len) == 0) {
+	rec->str_len = rec->as_str_len;
+	rec->flags |= JSON_TAPE_STR_SAME;
+    } else {
+	/* the decoded string follows the JSON encoded string */
+	if (tape_text(tape, item->str, (item->str != NULL) ? item->str_len : 0, &off) == false) {
+	    return false;
+	}
+	rec->str_len = (item->str != NULL) ? (uint32_t)item->str_len : 0;
+    }
+    rec->flags |= item->converted ? JSON_TAPE_STR_CONVERTED : 0;
+    rec->flags |= item->quote ? JSON_TAPE_STR_QUOTE : 0;
+    rec->flags |= item->has_nul ? JSON_TAPE_STR_HAS_NUL : 0;
+    tape_word(tape, JSON_TAPE_STRING, tape->str_count);
+    ++tape->str_count;
+    return true;
+}
+
+
+/*
+ * tape_number - add a JSON number word to the end of a tape
+ *
+ * given:
+ *	tape	tape to add to
+ *	item	JSON number to add
+ *
+ * returns:
+ *	true ==> JSON number added,
+ *	false ==> the JSON number has no text or the text of the tape is full
+ */
+static bool
+tape_number(struct json_tape *tape, struct json_number const *item)
+{
+    struct json_tape_number *rec = NULL;	/* JSON number of the tape */
+
+    /*
+     * firewall
+     */
+    if (tape == NULL || item == NULL) {
+	warn(__func__, "called with NULL arg(s)");
+	return false;
+    }
+    if (item->as_str == NULL) {
+	warn(__func__, "JSON number has no text");
+	return false;
+    }
+
+    /*
+     * add the JSON number
+     */
+    tape->num = tape_grow(tape->num, &tape->num_alloc, tape->num_count + 1, sizeof(tape->num[0]));
+    rec = &tape->num[tape->num_count];
+    memset(rec, 0, sizeof(*rec));
+    if (tape_text(tape, item->as_str, item->as_str_len, &rec->as_str) == false) {
+	return false;
+    }
+    rec->as_str_len = (uint32_t)item->as_str_len;
+    rec->flags |= item->converted ? JSON_TAPE_NUM_CONVERTED : 0;
+    rec->flags |= item->is_negative ? JSON_TAPE_NUM_NEGATIVE : 0;
+    rec->flags |= item->is_floating ? JSON_TAPE_NUM_FLOATING : 0;
+    rec->flags |= item->is_e_notation ? JSON_TAPE_NUM_E_NOTATION : 0;
+    rec->flags |= item->is_integer ? JSON_TAPE_NUM_INTEGER : 0;
+    rec->flags |= item->integer_converted ? JSON_TAPE_NUM_INTEGER_CONVERTED : 0;
+    tape_word(tape, JSON_TAPE_NUMBER, tape->num_count);
+    ++tape->num_count;
+    return true;
+}
+
+
+/*
+ * tape_value - add the word of a JSON value to the end of a tape
+ *
+ * A JSON object or array gets a start word that is completed when its end
+ * word is added, and is pushed on the stack so that what it holds is added
+ * next.
+ *
+ * given:
+ *	tape	tape to add to
+ *	node	JSON value to add
+ *	stack	pointer to the stack of JSON objects and arrays being added
+ *	alloc	pointer to the number of frames allocated for *stack
+ *	used	pointer to the number of frames in use on *stack
+ *
+ * returns:
+ *	true ==> JSON value added, false ==> node is not a JSON value
+ */
+static bool
+tape_value(struct json_tape *tape, struct json const *node,
+	   struct tape_frame **stack, size_t *alloc, size_t *used)
+{
+    /*
+     * firewall
+     */
+    if (tape == NULL || node == NULL || stack == NULL || alloc == NULL || used == NULL) {
+	warn(__func__, "called with NULL arg(s)");
+	return false;
+    }
+
+    /*
+     * add the value
+     */
+    switch (node->type) {
+    case JTYPE_NUMBER:
+	return tape_number(tape, &node->item.number);
+
+    case JTYPE_STRING:
+	return tape_string(tape, &node->item.string);
+
+    case JTYPE_BOOL:
+	tape_word(tape, node->item.boolean.value ? JSON_TAPE_TRUE : JSON_TAPE_FALSE, 0);
+	return true;
+
+    case JTYPE_NULL:
+	tape_word(tape, JSON_TAPE_NULL, 0);
+	return true;
+
+    case JTYPE_OBJECT:
+    case JTYPE_ARRAY:
+	*stack = tape_grow(*stack, alloc, *used + 1, sizeof((*stack)[0]));
+	(*stack)[*used].node = node;
+	(*stack)[*used].next = 0;
+	(*stack)[*used].start = tape->count;
+	++*used;
+	/* the payload is set when the end word is added */
+	tape_word(tape, node->type == JTYPE_OBJECT ? JSON_TAPE_OBJECT : JSON_TAPE_ARRAY, 0);
+	return true;
+
+    default:
+	warn(__func__, "node type is not a JSON value: %s", json_item_type_name(node));
+	return false;
+    }
+}
+
+
+/*
+ * json_tape_from_tree - form the tape of a JSON parse tree
+ *
+ * The tree is walked once, in document order, keeping the path from node
+ * down to the JSON object or array being added on an explicit stack, so
+ * that the depth of the tree is not limited by the size of the C stack.
+ * The tree is not changed.
+ *
+ * given:
+ *	node	top of a JSON parse tree
+ *
+ * returns:
+ *	allocated tape, free with json_tape_free(), or
+ *	NULL ==> node is NULL or the tree holds a node that is not part of a JSON value
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+struct json_tape *
+json_tape_from_tree(struct json const *node)
+{
+    struct json_tape *tape = NULL;	/* tape to return */
+    struct tape_frame *stack = NULL;	/* JSON objects and arrays being added */
+    size_t alloc = 0;			/* number of frames allocated for stack */
+    size_t used = 0;			/* number of frames in use on stack */
+    struct tape_frame *top = NULL;	/* innermost JSON object or array being added */
+    struct json * const *set = NULL;	/* members or values of top->node */
+    intmax_t len = 0;			/* number of members or values of top->node */
+    struct json const *child = NULL;	/* next member or value of top->node */
+    struct json_member const *member = NULL;	/* child as a JSON member */
+    bool object = false;		/* true ==> top->node is a JSON object */
+
+    /*
+     * firewall
+     */
+    if (node == NULL) {
+	warn(__func__, "node is NULL");
+	return NULL;
+    }
+
+    /*
+     * allocate the tape
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    tape = calloc(1, sizeof(*tape));
+    if (tape == NULL) {
+	errp(106, __func__, "calloc of %ju bytes failed", (uintmax_t)sizeof(*tape));
+	not_reached();
+    }
+
+    /*
+     * add the top of the document, then what each JSON object and array holds
+     */
+    if (tape_value(tape, node, &stack, &alloc, &used) == false) {
+	goto bad;
+    }
+    while (used > 0) {
+	top = &stack[used-1];
+	object = (top->node->type == JTYPE_OBJECT);
+	if (object == true) {
+	    set = top->node->item.object.set;
+	    len = top->node->item.object.len;
+	} else {
+	    set = top->node->item.array.set;
+	    len = top->node->item.array.len;
+	}
+
+	/*
+	 * case: all of top->node has been added
+	 */
+	if (set == NULL || top->next >= len) {
+	    tape_word(tape, object ? JSON_TAPE_OBJECT_END : JSON_TAPE_ARRAY_END, (size_t)top->next);
+	    tape->word[top->start] = JSON_TAPE_WORD(object ? JSON_TAPE_OBJECT : JSON_TAPE_ARRAY, tape->count);
+	    --used;
+	    continue;
+	}
+
+	/*
+	 * add the name of a member
+	 */
+	child = set[top->next++];
+	if (child == NULL) {
+	    warn(__func__, "NULL node in a JSON %s", object ? "object" : "array");
+	    goto bad;
+	}
+	if (object == true) {
+	    if (child->type != JTYPE_MEMBER) {
+		warn(__func__, "JSON object holds a node that is not a member: %s", json_item_type_name(child));
+		goto bad;
+	    }
+	    member = &child->item.member;
+	    if (member->name == NULL || member->name->type != JTYPE_STRING || member->value == NULL) {
+		warn(__func__, "JSON member without a JSON string name or a value");
+		goto bad;
+	    }
+	    if (tape_string(tape, &member->name->item.string) == false) {
+		goto bad;
+	    }
+	    child = member->value;
+	}
+
+	/*
+	 * add the member value or array value
+	 *
+	 * NOTE: This may move the stack, so top must not be used after this.
+	 */
+	if (tape_value(tape, child, &stack, &alloc, &used) == false) {
+	    goto bad;
+	}
+    }
+    if (stack != NULL) {
+	free(stack);
+	stack = NULL;
+    }
+    json_dbg(JSON_DBG_VHIGH, __func__, "tape has %ju words, %ju strings, %ju numbers and %ju bytes of text",
+				       (uintmax_t)tape->count, (uintmax_t)tape->str_count,
+				       (uintmax_t)tape->num_count, (uintmax_t)tape->text_len);
+    return tape;
+
+bad:
+    if (stack != NULL) {
+	free(stack);
+	stack = NULL;
+    }
+    json_tape_free(tape);
+    return NULL;
+}
+
+
+/*
+ * tape_link - link a node formed from a tape word into the tree being formed
+ *
+ * given:
+ *	node	node formed from a tape word, NOT linked into any tree
+ *	stack	JSON objects and elements being formed, innermost last
+ *	used	number of frames in use on stack
+ *	name	pointer to the name of the next member of the innermost JSON object, or NULL
+ *	tree	pointer to the top of the tree, or NULL
+ *
+ * returns:
+ *	true ==> node linked, false ==> node cannot be linked and was not linked
+ */
+static bool
+tape_link(struct json *node, struct tape_open *stack, size_t used, struct json **name, struct json **tree)
+{
+    struct json *open = NULL;	/* innermost JSON object or elements being formed */
+
+    /*
+     * firewall
+     */
+    if (node == NULL || name == NULL || tree == NULL || (stack == NULL && used > 0)) {
+	warn(__func__, "called with NULL arg(s)");
+	return false;
+    }
+
+    /*
+     * case: node is the top of the tree
+     */
+    if (used == 0) {
+	if (*tree != NULL) {
+	    warn(__func__, "more than one JSON value at the top of the tape");
+	    return false;
+	}
+	*tree = node;
+	return true;
+    }
+
+    /*
+     * case: node is a member name or member value
+     */
+    open = stack[used-1].node;
+    if (open->type == JTYPE_OBJECT) {
+	if (*name == NULL) {
+	    if (node->type != JTYPE_STRING) {
+		warn(__func__, "JSON member name is not a JSON string");
+		return false;
+	    }
+	    *name = node;
+	    return true;
+	}
+	(void) json_object_add_member(open, json_conv_member(*name, node));
+	*name = NULL;
+	return true;
+    }
+
+    /*
+     * case: node is an array value
+     */
+    (void) json_elements_add_value(open, node);
+    return true;
+}
+
+
+/*
+ * json_tape_to_tree - form the JSON parse tree of a tape
+ *
+ * The tape is read once, in order.  The nodes are formed by the same
+ * conversion functions as those of the parser from the text of the tape,
+ * so the tree is the one the tape was formed from.  Like the parser, a
+ * JSON object or array is linked into the tree once all it holds has been
+ * formed: until then it is kept on an explicit stack, so that the depth
+ * of the tree is not limited by the size of the C stack.
+ *
+ * given:
+ *	tape	tape formed by json_tape_from_tree()
+ *
+ * returns:
+ *	allocated JSON parse tree, free with json_tree_free(), or
+ *	NULL ==> tape is NULL, empty or is not a valid tape
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+struct json *
+json_tape_to_tree(struct json_tape const *tape)
+{
+    struct json *tree = NULL;		/* top of the JSON parse tree */
+    struct tape_open *stack = NULL;	/* JSON objects and elements being formed */
+    size_t alloc = 0;			/* number of frames allocated for stack */
+    size_t used = 0;			/* number of frames in use on stack */
+    struct json *name = NULL;		/* name of the next member of the innermost JSON object, or NULL */
+    struct json *node = NULL;		/* node formed from a tape word */
+    struct json_tape_string const *str = NULL;	/* JSON string of a tape word */
+    struct json_tape_number const *num = NULL;	/* JSON number of a tape word */
+    char *quoted = NULL;		/* JSON encoded string of a tape word with its '"'s */
+    size_t quoted_alloc = 0;		/* bytes allocated for quoted */
+    enum json_tape_tag tag = JSON_TAPE_NONE;	/* tag of a tape word */
+    size_t payload = 0;			/* payload of a tape word */
+    size_t pos = 0;			/* tape index */
+
+    /*
+     * firewall
+     */
+    if (tape == NULL) {
+	warn(__func__, "tape is NULL");
+	return NULL;
+    }
+    if (tape->word == NULL || tape->count == 0) {
+	warn(__func__, "tape is empty");
+	return NULL;
+    }
+
+    /*
+     * form a node from each tape word
+     */
+    for (pos=0; pos < tape->count; ++pos) {
+	tag = JSON_TAPE_WORD_TAG(tape->word[pos]);
+	payload = JSON_TAPE_WORD_PAYLOAD(tape->word[pos]);
+	switch (tag) {
+	case JSON_TAPE_OBJECT:
+	case JSON_TAPE_ARRAY:
+	    if (used > 0 && stack[used-1].node->type == JTYPE_OBJECT && name == NULL) {
+		warn(__func__, "tape word %ju: JSON member name is not a JSON string", (uintmax_t)pos);
+		goto bad;
+	    }
+	    /* like the parser, collect array values as JSON elements and then change them into a JSON array */
+	    stack = tape_grow(stack, &alloc, used + 1, sizeof(stack[0]));
+	    stack[used].node = (tag == JSON_TAPE_OBJECT) ? json_create_object() : json_create_elements();
+	    stack[used].name = name;
+	    name = NULL;
+	    ++used;
+	    continue;
+
+	case JSON_TAPE_OBJECT_END:
+	case JSON_TAPE_ARRAY_END:
+	    if (used == 0 || name != NULL ||
+		(tag == JSON_TAPE_OBJECT_END) != (stack[used-1].node->type == JTYPE_OBJECT)) {
+		warn(__func__, "tape word %ju: unmatched end of a JSON %s", (uintmax_t)pos,
+			       (tag == JSON_TAPE_OBJECT_END) ? "object" : "array");
+		goto bad;
+	    }
+	    --used;
+	    node = stack[used].node;
+	    name = stack[used].name;
+	    if (node->type == JTYPE_ELEMENTS) {
+		node = parse_json_array(node);
+	    }
+	    break;
+
+	case JSON_TAPE_STRING:
+	    if (payload >= tape->str_count) {
+		warn(__func__, "tape word %ju: no JSON string %ju", (uintmax_t)pos, (uintmax_t)payload);
+		goto bad;
+	    }
+	    str = &tape->str[payload];
+	    if (tape_text_ok(tape, str->as_str, str->as_str_len) == false) {
+		warn(__func__, "tape word %ju: JSON string %ju is not in the text", (uintmax_t)pos, (uintmax_t)payload);
+		goto bad;
+	    }
+	    if ((str->flags & JSON_TAPE_STR_QUOTE) != 0) {
+		/* the tape does not keep the '"'s */
+		quoted = tape_grow(quoted, &quoted_alloc, (size_t)str->as_str_len + 2, 1);
+		quoted[0] = '"';
+		memcpy(quoted + 1, tape->text + str->as_str, str->as_str_len);
+		quoted[str->as_str_len + 1] = '"';
+		node = json_conv_string(quoted, (size_t)str->as_str_len + 2, true);
+	    } else {
+		node = json_conv_string(tape->text + str->as_str, str->as_str_len, false);
+	    }
+	    if (node != NULL && (node->item.string.as_str == NULL || node->item.string.str == NULL ||
+				 node->item.string.converted != ((str->flags & JSON_TAPE_STR_CONVERTED) != 0))) {
+		warn(__func__, "tape word %ju: JSON string %ju does not convert as it did", (uintmax_t)pos, (uintmax_t)payload);
+		goto bad;
+	    }
+	    break;
+
+	case JSON_TAPE_NUMBER:
+	    if (payload >= tape->num_count) {
+		warn(__func__, "tape word %ju: no JSON number %ju", (uintmax_t)pos, (uintmax_t)payload);
+		goto bad;
+	    }
+	    num = &tape->num[payload];
+	    if (tape_text_ok(tape, num->as_str, num->as_str_len) == false) {
+		warn(__func__, "tape word %ju: JSON number %ju is not in the text", (uintmax_t)pos, (uintmax_t)payload);
+		goto bad;
+	    }
+	    node = json_conv_number(tape->text + num->as_str, num->as_str_len);
+	    if (node != NULL && node->item.number.converted != ((num->flags & JSON_TAPE_NUM_CONVERTED) != 0)) {
+		warn(__func__, "tape word %ju: JSON number %ju does not convert as it did", (uintmax_t)pos, (uintmax_t)payload);
+		goto bad;
+	    }
+	    break;
+
+	case JSON_TAPE_TRUE:
+	    node = json_conv_bool("true", sizeof("true")-1);
+	    break;
+
+	case JSON_TAPE_FALSE:
+	    node = json_conv_bool("false", sizeof("false")-1);
+	    break;
+
+	case JSON_TAPE_NULL:
+	    node = json_conv_null("null", sizeof("null")-1);
+	    break;
+
+	default:
+	    warn(__func__, "tape word %ju: unknown tag: 0x%02x", (uintmax_t)pos, (unsigned int)tag);
+	    goto bad;
+	}
+	if (node == NULL) {
+	    warn(__func__, "tape word %ju: conversion returned NULL", (uintmax_t)pos);
+	    goto bad;
+	}
+
+	/*
+	 * link the node into the tree
+	 */
+	if (tape_link(node, stack, used, &name, &tree) == false) {
+	    warn(__func__, "tape word %ju: cannot link the JSON %s", (uintmax_t)pos, json_item_type_name(node));
+	    goto bad;
+	}
+	node = NULL;
+    }
+    if (used > 0) {
+	warn(__func__, "tape ends inside a JSON %s", (stack[used-1].node->type == JTYPE_OBJECT) ? "object" : "array");
+	goto bad;
+    }
+    if (name != NULL) {
+	warn(__func__, "tape ends with a JSON member name");
+	goto bad;
+    }
+    if (stack != NULL) {
+	free(stack);
+	stack = NULL;
+    }
+    if (quoted != NULL) {
+	free(quoted);
+	quoted = NULL;
+    }
+    return tree;
+
+bad:
+    if (node != NULL) {
+	json_tree_free(node, JSON_INFINITE_DEPTH);
+	free(node);
+	node = NULL;
+    }
+    if (name != NULL) {
+	json_tree_free(name, JSON_INFINITE_DEPTH);
+	free(name);
+	name = NULL;
+    }
+    while (used > 0) {
+	--used;
+	json_tree_free(stack[used].node, JSON_INFINITE_DEPTH);
+	free(stack[used].node);
+	if (stack[used].name != NULL) {
+	    json_tree_free(stack[used].name, JSON_INFINITE_DEPTH);
+	    free(stack[used].name);
+	}
+    }
+    if (stack != NULL) {
+	free(stack);
+	stack = NULL;
+    }
+    if (quoted != NULL) {
+	free(quoted);
+	quoted = NULL;
+    }
+    if (tree != NULL) {
+	json_tree_free(tree, JSON_INFINITE_DEPTH);
+	free(tree);
+	tree = NULL;
+    }
+    return NULL;
+}
+
+
+/*
+ * json_tape_free - free a tape
+ *
+ * given:
+ *	tape	tape formed by json_tape_from_tree() or json_tape_map(), or NULL
+ */
+void
+json_tape_free(struct json_tape *tape)
+{
+    /*
+     * firewall
+     */
+    if (tape == NULL) {
+	return;
+    }
+
+    /*
+     * case: the arrays are in the mapping of a .jtree tape file
+     */
+    if (tape->map != NULL) {
+	unmap_all(tape->map, tape->map_len, 0);
+	tape->map = NULL;
+	free(tape);
+	return;
+    }
+
+    /*
+     * free the tape
+     */
+    if (tape->word != NULL) {
+	free(tape->word);
+	tape->word = NULL;
+    }
+    if (tape->str != NULL) {
+	free(tape->str);
+	tape->str = NULL;
+    }
+    if (tape->num != NULL) {
+	free(tape->num);
+	tape->num = NULL;
+    }
+    if (tape->text != NULL) {
+	free(tape->text);
+	tape->text = NULL;
+    }
+    free(tape);
+    return;
+}
+
+
+/*
+ * json_tape_equal - determine if two tapes hold the same JSON
+ *
+ * Two tapes are equal when they have the same words and their JSON strings
+ * and numbers have the same text and were converted the same way.
+ *
+ * given:
+ *	a	a tape
+ *	b	another tape
+ *
+ * returns:
+ *	true ==> tapes are equal, false ==> tapes differ or an arg is NULL
+ */
+bool
+json_tape_equal(struct json_tape const *a, struct json_tape const *b)
+{
+    struct json_tape_string const *sa = NULL;	/* JSON string of a */
+    struct json_tape_string const *sb = NULL;	/* JSON string of b */
+    struct json_tape_number const *na = NULL;	/* JSON number of a */
+    struct json_tape_number const *nb = NULL;	/* JSON number of b */
+    size_t pos = 0;				/* tape index */
+
+    /*
+     * firewall
+     */
+    if (a == NULL || b == NULL) {
+	warn(__func__, "called with NULL arg(s)");
+	return false;
+    }
+
+    /*
+     * compare each word
+     */
+    if (a->count != b->count) {
+	return false;
+    }
+    for (pos=0; pos < a->count; ++pos) {
+	switch (JSON_TAPE_WORD_TAG(a->word[pos])) {
+	case JSON_TAPE_STRING:
+	    sa = tape_str_at(a, pos);
+	    sb = tape_str_at(b, pos);
+	    if (sa == NULL || sb == NULL) {
+		return false;
+	    }
+	    if (sa->as_str_len != sb->as_str_len || sa->str_len != sb->str_len || sa->flags != sb->flags ||
+		memcmp(a->text + sa->as_str, b->text + sb->as_str, sa->as_str_len) != 0 ||
+		memcmp(a->text + JSON_TAPE_STR_OFF(sa), b->text + JSON_TAPE_STR_OFF(sb), sa->str_len) != 0) {
+		return false;
+	    }
+	    break;
+
+	case JSON_TAPE_NUMBER:
+	    na = json_tape_num(a, pos);
+	    nb = json_tape_num(b, pos);
+	    if (na == NULL || nb == NULL) {
+		return false;
+	    }
+	    if (na->as_str_len != nb->as_str_len || na->flags != nb->flags ||
+		memcmp(a->text + na->as_str, b->text + nb->as_str, na->as_str_len) != 0) {
+		return false;
+	    }
+	    break;
+
+	default:
+	    if (a->word[pos] != b->word[pos]) {
+		return false;
+	    }
+	    break;
+	}
+    }
+    return true;
+}
+
+
+/*
+ * json_tape_tag - what a tape word is
+ *
+ * given:
+ *	tape	tape
+ *	pos	tape index
+ *
+ * returns:
+ *	tag of the tape word, or JSON_TAPE_NONE ==> tape is NULL or pos is beyond the tape
+ */
+enum json_tape_tag
+json_tape_tag(struct json_tape const *tape, size_t pos)
+{
+    if (tape == NULL || pos >= tape->count) {
+	return JSON_TAPE_NONE;
+    }
+    return JSON_TAPE_WORD_TAG(tape->word[pos]);
+}
+
+
+/*
+ * json_tape_next - skip over a JSON value of a tape
+ *
+ * given:
+ *	tape	tape
+ *	pos	tape index of a JSON value
+ *
+ * returns:
+ *	tape index just beyond the JSON value at pos, skipping all that a
+ *	JSON object or array holds
+ */
+size_t
+json_tape_next(struct json_tape const *tape, size_t pos)
+{
+    enum json_tape_tag tag = JSON_TAPE_NONE;	/* tag of the word at pos */
+
+    if (tape == NULL) {
+	return 0;
+    }
+    if (pos >= tape->count) {
+	return tape->count;
+    }
+    tag = JSON_TAPE_WORD_TAG(tape->word[pos]);
+    if (tag == JSON_TAPE_OBJECT || tag == JSON_TAPE_ARRAY) {
+	return JSON_TAPE_WORD_PAYLOAD(tape->word[pos]);
+    }
+    return pos + 1;
+}
+
+
+/*
+ * json_tape_len - number of members of a JSON object or values of a JSON array
+ *
+ * given:
+ *	tape	tape
+ *	pos	tape index of a JSON object or array
+ *
+ * returns:
+ *	number of members or values, or 0 ==> pos is not a JSON object or array
+ */
+size_t
+json_tape_len(struct json_tape const *tape, size_t pos)
+{
+    enum json_tape_tag tag = json_tape_tag(tape, pos);	/* tag of the word at pos */
+    size_t beyond = 0;					/* tape index just beyond the container */
+
+    if (tag != JSON_TAPE_OBJECT && tag != JSON_TAPE_ARRAY) {
+	return 0;
+    }
+    beyond = JSON_TAPE_WORD_PAYLOAD(tape->word[pos]);
+    if (beyond <= pos + 1 || beyond > tape->count) {
+	return 0;
+    }
+    return JSON_TAPE_WORD_PAYLOAD(tape->word[beyond-1]);
+}
+
+
+/*
+ * tape_text_ok - determine if NUL terminated bytes are in the text of a tape
+ *
+ * A tape formed by json_tape_from_tree() always passes, but the offsets of a
+ * tape mapped from a .jtree tape file are only as good as the file.
+ *
+ * given:
+ *	tape	tape
+ *	off	offset in the text of the bytes
+ *	len	number of bytes, not including the final NUL
+ *
+ * returns:
+ *	true ==> the bytes and their final NUL are in the text, false ==> they are not
+ */
+static bool
+tape_text_ok(struct json_tape const *tape, size_t off, size_t len)
+{
+    if (tape == NULL || tape->text == NULL || off >= tape->text_len || len >= tape->text_len - off) {
+	return false;
+    }
+    return tape->text[off + len] == '\0';
+}
+
+
+/*
+ * tape_str_at - JSON string of a tape word
+ *
+ * given:
+ *	tape	tape
+ *	pos	tape index of a JSON string
+ *
+ * returns:
+ *	JSON string whose text is in the text of the tape, or
+ *	NULL ==> pos is not such a JSON string
+ */
+static struct json_tape_string const *
+tape_str_at(struct json_tape const *tape, size_t pos)
+{
+    struct json_tape_string const *str = NULL;	/* JSON string at pos */
+    size_t payload = 0;				/* payload of the word at pos */
+
+    if (json_tape_tag(tape, pos) != JSON_TAPE_STRING) {
+	return NULL;
+    }
+    payload = JSON_TAPE_WORD_PAYLOAD(tape->word[pos]);
+    if (payload >= tape->str_count) {
+	return NULL;
+    }
+    str = &tape->str[payload];
+    if (tape_text_ok(tape, str->as_str, str->as_str_len) == false || tape_text_ok(tape, JSON_TAPE_STR_OFF(str), str->str_len) == false) {
+	return NULL;
+    }
+    return str;
+}
+
+
+/*
+ * json_tape_str - decoded JSON string of a tape word
+ *
+ * given:
+ *	tape	tape
+ *	pos	tape index of a JSON string
+ *	len	if non-NULL, set to the length of the decoded string
+ *
+ * returns:
+ *	NUL terminated decoded string, or NULL ==> pos is not a JSON string
+ */
+char const *
+json_tape_str(struct json_tape const *tape, size_t pos, size_t *len)
+{
+    struct json_tape_string const *str = tape_str_at(tape, pos);	/* JSON string at pos */
+
+    if (str == NULL) {
+	return NULL;
+    }
+    if (len != NULL) {
+	*len = str->str_len;
+    }
+    return tape->text + JSON_TAPE_STR_OFF(str);
+}
+
+
+/*
+ * json_tape_num - JSON number of a tape word
+ *
+ * given:
+ *	tape	tape
+ *	pos	tape index of a JSON number
+ *
+ * returns:
+ *	JSON number, or NULL ==> pos is not a JSON number
+ */
+struct json_tape_number const *
+json_tape_num(struct json_tape const *tape, size_t pos)
+{
+    size_t payload = 0;		/* payload of the word at pos */
+
+    if (json_tape_tag(tape, pos) != JSON_TAPE_NUMBER) {
+	return NULL;
+    }
+    payload = JSON_TAPE_WORD_PAYLOAD(tape->word[pos]);
+    if (payload >= tape->num_count ||
+	tape_text_ok(tape, tape->num[payload].as_str, tape->num[payload].as_str_len) == false) {
+	return NULL;
+    }
+    return &tape->num[payload];
+}
+
+
+/*
+ * json_tape_iter_init - start iterating over a JSON object or array of a tape
+ *
+ * Example use - print the member names of the JSON object at tape index 0
+ *
+ *	struct json_tape_iter iter;
+ *	size_t name;
+ *	size_t value;
+ *	...
+ *	if (json_tape_iter_init(&iter, tape, 0)) {
+ *	    while (json_tape_iter_next(&iter, &name, &value)) {
+ *		printf("%s\n", json_tape_str(tape, name, NULL));
+ *	    }
+ *	}
+ *
+ * given:
+ *	iter	iterator to start
+ *	tape	tape
+ *	pos	tape index of a JSON object or array
+ *
+ * returns:
+ *	true ==> iter started, false ==> pos is not a JSON object or array
+ */
+bool
+json_tape_iter_init(struct json_tape_iter *iter, struct json_tape const *tape, size_t pos)
+{
+    enum json_tape_tag tag = json_tape_tag(tape, pos);	/* tag of the word at pos */
+    size_t beyond = 0;					/* tape index just beyond the container */
+
+    /*
+     * firewall
+     */
+    if (iter == NULL) {
+	warn(__func__, "iter is NULL");
+	return false;
+    }
+    memset(iter, 0, sizeof(*iter));
+    iter->tape = tape;
+    if (tag != JSON_TAPE_OBJECT && tag != JSON_TAPE_ARRAY) {
+	return false;
+    }
+    beyond = JSON_TAPE_WORD_PAYLOAD(tape->word[pos]);
+    if (beyond <= pos + 1 || beyond > tape->count) {
+	return false;
+    }
+
+    /*
+     * start at the first member or value
+     */
+    iter->pos = pos + 1;
+    iter->end = beyond - 1;
+    iter->object = (tag == JSON_TAPE_OBJECT);
+    return true;
+}
+
+
+/*
+ * json_tape_iter_next - next member of a JSON object or value of a JSON array
+ *
+ * given:
+ *	iter	iterator started by json_tape_iter_init()
+ *	name	if non-NULL, set to the tape index of the member name, or for
+ *		a JSON array to the tape index of the value
+ *	value	if non-NULL, set to the tape index of the member value or array value
+ *
+ * returns:
+ *	true ==> *name and *value set, false ==> no more members or values
+ */
+bool
+json_tape_iter_next(struct json_tape_iter *iter, size_t *name, size_t *value)
+{
+    size_t n = 0;	/* tape index of the member name or array value */
+    size_t v = 0;	/* tape index of the member value or array value */
+
+    /*
+     * firewall
+     */
+    if (iter == NULL || iter->pos >= iter->end) {
+	return false;
+    }
+
+    /*
+     * step over the member or value
+     */
+    n = iter->pos;
+    v = (iter->object == true) ? n + 1 : n;
+    iter->pos = json_tape_next(iter->tape, v);
+    if (name != NULL) {
+	*name = n;
+    }
+    if (value != NULL) {
+	*value = v;
+    }
+    return true;
+}
+
+
+/*
+ * json_tape_find_member - find a member of a JSON object of a tape by name
+ *
+ * The members are compared in order, so this finds the first member with
+ * the name.  The member values are skipped over without being looked at.
+ *
+ * given:
+ *	tape	tape
+ *	pos	tape index of a JSON object
+ *	name	decoded member name to find
+ *	len	length of name
+ *	value	if non-NULL and a member was found, set to the tape index of its value
+ *
+ * returns:
+ *	true ==> member found, false ==> no such member or pos is not a JSON object
+ */
+bool
+json_tape_find_member(struct json_tape const *tape, size_t pos, char const *name, size_t len, size_t *value)
+{
+    struct json_tape_iter iter;	/* iterator over the members */
+    size_t n = 0;		/* tape index of a member name */
+    size_t v = 0;		/* tape index of a member value */
+    char const *str = NULL;	/* member name */
+    size_t str_len = 0;		/* length of str */
+
+    /*
+     * firewall
+     */
+    if (name == NULL) {
+	warn(__func__, "name is NULL");
+	return false;
+    }
+    if (json_tape_tag(tape, pos) != JSON_TAPE_OBJECT) {
+	return false;
+    }
+
+    /*
+     * compare each member name
+     */
+    (void) json_tape_iter_init(&iter, tape, pos);
+    while (json_tape_iter_next(&iter, &n, &v)) {
+	str = json_tape_str(tape, n, &str_len);
+	if (str != NULL && str_len == len && memcmp(str, name, len) == 0) {
+	    if (value != NULL) {
+		*value = v;
+	    }
+	    return true;
+	}
+    }
+    return false;
+}
+
+
+/*
+ * json_tape_fprint - print the words of a tape
+ *
+ * Each word is printed on a line of its own: its tape index, its tag and,
+ * for a JSON object or array its payload, for a JSON string its JSON
+ * encoded text and for a JSON number its text.
+ *
+ * given:
+ *	stream	open stream to print on
+ *	tape	tape to print
+ */
+void
+json_tape_fprint(FILE *stream, struct json_tape const *tape)
+{
+    size_t pos = 0;		/* tape index */
+    size_t payload = 0;		/* payload of the word at pos */
+    enum json_tape_tag tag = JSON_TAPE_NONE;	/* tag of the word at pos */
+    struct json_tape_string const *str = NULL;	/* JSON string at pos */
+    struct json_tape_number const *num = NULL;	/* JSON number at pos */
+
+    /*
+     * firewall
+     */
+    if (stream == NULL || tape == NULL) {
+	warn(__func__, "called with NULL arg(s)");
+	return;
+    }
+
+    /*
+     * print each word
+     */
+    for (pos=0; pos < tape->count; ++pos) {
+	tag = JSON_TAPE_WORD_TAG(tape->word[pos]);
+	payload = JSON_TAPE_WORD_PAYLOAD(tape->word[pos]);
+	switch (tag) {
+	case JSON_TAPE_OBJECT:
+	case JSON_TAPE_OBJECT_END:
+	case JSON_TAPE_ARRAY:
+	case JSON_TAPE_ARRAY_END:
+	    fprint(stream, "%ju\t%c\t%ju\n", (uintmax_t)pos, (char)tag, (uintmax_t)payload);
+	    break;
+	case JSON_TAPE_STRING:
+	    str = tape_str_at(tape, pos);
+	    if (str != NULL) {
+		fprint(stream, "%ju\t%c\t\"%s\"\n", (uintmax_t)pos, (char)tag, tape->text + str->as_str);
+	    } else {
+		fprint(stream, "%ju\t%c\t??\n", (uintmax_t)pos, (char)tag);
+	    }
+	    break;
+	case JSON_TAPE_NUMBER:
+	    num = json_tape_num(tape, pos);
+	    fprint(stream, "%ju\t%c\t%s\n", (uintmax_t)pos, (char)tag, (num != NULL) ? tape->text + num->as_str : "??");
+	    break;
+	case JSON_TAPE_TRUE:
+	case JSON_TAPE_FALSE:
+	case JSON_TAPE_NULL:
+	    fprint(stream, "%ju\t%c\n", (uintmax_t)pos, (char)tag);
+	    break;
+	default:
+	    fprint(stream, "%ju\t?\t0x%016jx\n", (uintmax_t)pos, (uintmax_t)tape->word[pos]);
+	    break;
+	}
+    }
+    return;
+}
+
+
+/*
+ * json_tape_cache_name - name of the .jtree tape file of a JSON file
+ *
+ * Without a cache directory the tape file is next to the JSON file.  In a
+ * cache directory the tape file name is the basename of the JSON file and a
+ * hash of its real path, so that JSON files of the same name in different
+ * directories have different tape files.
+ *
+ * given:
+ *	path	path of a JSON file
+ *	dir	cache directory, or NULL ==> path with JSON_TAPE_FILE_SUFFIX appended
+ *
+ * returns:
+ *	allocated tape file name, or
+ *	NULL ==> path is NULL or the real path of path cannot be determined
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+char *
+json_tape_cache_name(char const *path, char const *dir)
+{
+    char *real = NULL;		/* real path of path */
+    char const *base = NULL;	/* basename of path */
+    uint32_t hash = 0;		/* json_name_hash() of real */
+    char *name = NULL;		/* tape file name to return */
+    size_t len = 0;		/* allocated length of name */
+
+    /*
+     * firewall
+     */
+    if (path == NULL) {
+	warn(__func__, "path is NULL");
+	return NULL;
+    }
+
+    /*
+     * case: the tape file is next to the JSON file
+     */
+    if (dir == NULL) {
+	len = strlen(path) + sizeof(JSON_TAPE_FILE_SUFFIX);
+	errno = 0;		/* pre-clear errno for errp() */
+	name = malloc(len);
+	if (name == NULL) {
+	    errp(107, __func__, "malloc of %ju bytes failed", (uintmax_t)len);
+	    not_reached();
+	}
+	snprintf(name, len, "%s%s", path, JSON_TAPE_FILE_SUFFIX);
+	return name;
+    }
+
+    /*
+     * the tape file is in the cache directory
+     */
+    errno = 0;			/* pre-clear errno for warnp() */
+    real = realpath(path, NULL);
+    if (real == NULL) {
+	warnp(__func__, "cannot determine the real path of: %s", path);
+	return NULL;
+    }
+    hash = json_name_hash(real, strlen(real));
+    base = strrchr(real, '/');
+    base = (base == NULL) ? real : base + 1;
+    len = strlen(dir) + 1 + strlen(base) + 1 + 8 + sizeof(JSON_TAPE_FILE_SUFFIX);
+    errno = 0;			/* pre-clear errno for errp() */
+    name = malloc(len);
+    if (name == NULL) {
+	errp(108, __func__, "malloc of %ju bytes failed", (uintmax_t)len);
+	not_reached();
+    }
+    snprintf(name, len, "%s/%s.%08x%s", dir, base, (unsigned int)hash, JSON_TAPE_FILE_SUFFIX);
+    free(real);
+    real = NULL;
+    return name;
+}
+
+
+/*
+ * tape_layout - where the arrays of a tape are in a .jtree tape file
+ *
+ * given:
+ *	count		number of tape words
+ *	str_count	number of JSON strings
+ *	num_count	number of JSON numbers
+ *	text_len	bytes of text
+ *	off		array of 4 offsets set to where the words, the JSON
+ *			strings, the JSON numbers and the text start
+ *
+ * returns:
+ *	size of the .jtree tape file
+ *
+ * NOTE: The caller must make sure that the counts are not so large that
+ *	 the size of the file does not fit in a size_t.
+ */
+static size_t
+tape_layout(size_t count, size_t str_count, size_t num_count, size_t text_len, size_t *off)
+{
+#define TAPE_ALIGN(x) ((((x) + JSON_TAPE_FILE_ALIGN - 1) / JSON_TAPE_FILE_ALIGN) * JSON_TAPE_FILE_ALIGN)
+
+    off[0] = TAPE_ALIGN(sizeof(struct json_tape_file));
+    off[1] = TAPE_ALIGN(off[0] + count * sizeof(uint64_t));
+    off[2] = TAPE_ALIGN(off[1] + str_count * sizeof(struct json_tape_string));
+    off[3] = TAPE_ALIGN(off[2] + num_count * sizeof(struct json_tape_number));
+    return off[3] + text_len;
+
+#undef TAPE_ALIGN
+}
+
+
+/*
+ * tape_section - write an array of a tape to a .jtree tape file
+ *
+ * given:
+ *	stream	open stream of the tape file
+ *	ptr	array to write, or NULL ==> len must be 0
+ *	len	number of bytes to write
+ *	off	offset in the tape file where the array starts
+ *	written	pointer to the number of bytes written so far, updated
+ *
+ * returns:
+ *	true ==> array written, false ==> write error
+ */
+static bool
+tape_section(FILE *stream, void const *ptr, size_t len, size_t off, size_t *written)
+{
+    /*
+     * firewall
+     */
+    if (stream == NULL || written == NULL || (ptr == NULL && len > 0) || off < *written) {
+	warn(__func__, "called with bad arg(s)");
+	return false;
+    }
+
+    /*
+     * pad to the start of the array, then write it
+     */
+    while (*written < off) {
+	if (putc('\0', stream) == EOF) {
+	    return false;
+	}
+	++*written;
+    }
+    if (len > 0 && fwrite(ptr, 1, len, stream) != len) {
+	return false;
+    }
+    *written += len;
+    return true;
+}
+
+
+/*
+ * json_tape_write - write a tape to a .jtree tape file
+ *
+ * The tape file is written to a temporary file in the same directory and
+ * then renamed, so that a reader never maps a partly written tape file.
+ *
+ * given:
+ *	tape	tape to write
+ *	name	name of the tape file, see json_tape_cache_name()
+ *	src	status of the JSON file the tape was formed from
+ *
+ * returns:
+ *	true ==> tape file written, false ==> tape file not written
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+bool
+json_tape_write(struct json_tape const *tape, char const *name, struct stat const *src)
+{
+    struct json_tape_file head;	/* header of the tape file */
+    size_t off[4];		/* where each array of the tape starts */
+    size_t written = 0;		/* bytes written to the tape file */
+    char *tmp = NULL;		/* name of the temporary file */
+    size_t tmp_len = 0;		/* allocated length of tmp */
+    int fd = -1;		/* file descriptor of the temporary file */
+    FILE *stream = NULL;	/* open stream of the temporary file */
+
+    /*
+     * firewall
+     */
+    if (tape == NULL || name == NULL || src == NULL) {
+	warn(__func__, "called with NULL arg(s)");
+	return false;
+    }
+    if (tape->word == NULL || tape->count == 0) {
+	warn(__func__, "tape is empty");
+	return false;
+    }
+
+    /*
+     * form the header
+     */
+    memset(&head, 0, sizeof(head));
+    memcpy(head.magic, JSON_TAPE_FILE_MAGIC, sizeof(head.magic));
+    head.version = JSON_TAPE_FILE_VERSION;
+    head.order = JSON_TAPE_FILE_ORDER;
+    head.str_size = (uint32_t)sizeof(struct json_tape_string);
+    head.num_size = (uint32_t)sizeof(struct json_tape_number);
+    head.src_size = (uint64_t)src->st_size;
+    head.src_mtime = (int64_t)src->st_mtime;
+    head.src_ctime = (int64_t)src->st_ctime;
+    head.src_dev = (uint64_t)src->st_dev;
+    head.src_ino = (uint64_t)src->st_ino;
+    head.count = tape->count;
+    head.str_count = tape->str_count;
+    head.num_count = tape->num_count;
+    head.text_len = tape->text_len;
+    (void) tape_layout(tape->count, tape->str_count, tape->num_count, tape->text_len, off);
+
+    /*
+     * open a temporary file next to the tape file
+     */
+    tmp_len = strlen(name) + sizeof(".XXXXXX");
+    errno = 0;			/* pre-clear errno for errp() */
+    tmp = malloc(tmp_len);
+    if (tmp == NULL) {
+	errp(109, __func__, "malloc of %ju bytes failed", (uintmax_t)tmp_len);
+	not_reached();
+    }
+    snprintf(tmp, tmp_len, "%s.XXXXXX", name);
+    errno = 0;			/* pre-clear errno for warnp() */
+    fd = mkstemp(tmp);
+    if (fd < 0) {
+	warnp(__func__, "cannot create a temporary file for: %s", name);
+	free(tmp);
+	tmp = NULL;
+	return false;
+    }
+    errno = 0;			/* pre-clear errno for warnp() */
+    stream = fdopen(fd, "w");
+    if (stream == NULL) {
+	warnp(__func__, "fdopen of: %s failed", tmp);
+	(void) close(fd);
+	goto bad;
+    }
+
+    /*
+     * write the header and the arrays of the tape
+     */
+    errno = 0;			/* pre-clear errno for warnp() */
+    if (tape_section(stream, &head, sizeof(head), 0, &written) == false ||
+	tape_section(stream, tape->word, tape->count * sizeof(tape->word[0]), off[0], &written) == false ||
+	tape_section(stream, tape->str, tape->str_count * sizeof(tape->str[0]), off[1], &written) == false ||
+	tape_section(stream, tape->num, tape->num_count * sizeof(tape->num[0]), off[2], &written) == false ||
+	tape_section(stream, tape->text, tape->text_len, off[3], &written) == false) {
+	warnp(__func__, "write to: %s failed", tmp);
+	(void) fclose(stream);
+	goto bad;
+    }
+    errno = 0;			/* pre-clear errno for warnp() */
+    if (fclose(stream) != 0) {
+	warnp(__func__, "close of: %s failed", tmp);
+	goto bad;
+    }
+
+    /*
+     * replace the tape file
+     */
+    errno = 0;			/* pre-clear errno for warnp() */
+    if (rename(tmp, name) != 0) {
+	warnp(__func__, "cannot rename: %s to: %s", tmp, name);
+	goto bad;
+    }
+    json_dbg(JSON_DBG_MED, __func__, "wrote %ju bytes to tape file: %s", (uintmax_t)written, name);
+    free(tmp);
+    tmp = NULL;
+    return true;
+
+bad:
+    (void) unlink(tmp);
+    free(tmp);
+    tmp = NULL;
+    return false;
+}
+
+
+/*
+ * json_tape_map - map the tape of a .jtree tape file
+ *
+ * Only the header is checked, so the time this takes does not depend on
+ * the size of the tape: the JSON file is not read and the tape is not
+ * scanned.  The accessors check the offsets of the tape before using them.
+ *
+ * given:
+ *	name	name of the tape file, see json_tape_cache_name()
+ *	src	status of the JSON file the tape should be of
+ *
+ * returns:
+ *	tape in the mapping of the tape file, free with json_tape_free(), or
+ *	NULL ==> no tape file, or the tape file is not one for this system
+ *		 or is not of the JSON file as it is now
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+struct json_tape *
+json_tape_map(char const *name, struct stat const *src)
+{
+    FILE *stream = NULL;		/* open stream of the tape file */
+    void *map = NULL;			/* mapping of the tape file */
+    size_t size = 0;			/* size of the tape file */
+    struct json_tape_file const *head = NULL;	/* header of the tape file */
+    size_t off[4];			/* where each array of the tape starts */
+    struct json_tape *tape = NULL;	/* tape to return */
+
+    /*
+     * firewall
+     */
+    if (name == NULL || src == NULL) {
+	warn(__func__, "called with NULL arg(s)");
+	return NULL;
+    }
+
+    /*
+     * map the tape file
+     */
+    stream = fopen(name, "r");
+    if (stream == NULL) {
+	json_dbg(JSON_DBG_MED, __func__, "no tape file: %s", name);
+	return NULL;
+    }
+    map = map_all(stream, &size, 0);
+    (void) fclose(stream);
+    stream = NULL;
+    if (map == NULL) {
+	json_dbg(JSON_DBG_MED, __func__, "cannot map tape file: %s", name);
+	return NULL;
+    }
+
+    /*
+     * check the header
+     */
+    head = map;
+    if (size < sizeof(*head) || memcmp(head->magic, JSON_TAPE_FILE_MAGIC, sizeof(head->magic)) != 0 ||
+	head->version != JSON_TAPE_FILE_VERSION || head->order != JSON_TAPE_FILE_ORDER ||
+	head->str_size != sizeof(struct json_tape_string) || head->num_size != sizeof(struct json_tape_number)) {
+	json_dbg(JSON_DBG_MED, __func__, "not a tape file for this system: %s", name);
+	goto stale;
+    }
+    if (head->src_size != (uint64_t)src->st_size || head->src_mtime != (int64_t)src->st_mtime ||
+	head->src_ctime != (int64_t)src->st_ctime || head->src_dev != (uint64_t)src->st_dev ||
+	head->src_ino != (uint64_t)src->st_ino) {
+	json_dbg(JSON_DBG_MED, __func__, "tape file is not of the JSON file as it is now: %s", name);
+	goto stale;
+    }
+    if (head->count == 0 || head->count > size / sizeof(uint64_t) ||
+	head->str_count > size / sizeof(struct json_tape_string) ||
+	head->num_count > size / sizeof(struct json_tape_number) || head->text_len > size ||
+	tape_layout((size_t)head->count, (size_t)head->str_count, (size_t)head->num_count,
+		    (size_t)head->text_len, off) != size) {
+	json_dbg(JSON_DBG_MED, __func__, "tape file has a bad layout: %s", name);
+	goto stale;
+    }
+
+    /*
+     * the tape is the mapping
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    tape = calloc(1, sizeof(*tape));
+    if (tape == NULL) {
+	errp(110, __func__, "calloc of %ju bytes failed", (uintmax_t)sizeof(*tape));
+	not_reached();
+    }
+    tape->word = (uint64_t *)((char *)map + off[0]);
+    tape->count = tape->alloc = (size_t)head->count;
+    tape->str = (head->str_count > 0) ? (struct json_tape_string *)((char *)map + off[1]) : NULL;
+    tape->str_count = tape->str_alloc = (size_t)head->str_count;
+    tape->num = (head->num_count > 0) ? (struct json_tape_number *)((char *)map + off[2]) : NULL;
+    tape->num_count = tape->num_alloc = (size_t)head->num_count;
+    tape->text = (head->text_len > 0) ? (char *)map + off[3] : NULL;
+    tape->text_len = tape->text_alloc = (size_t)head->text_len;
+    tape->map = map;
+    tape->map_len = size;
+    json_dbg(JSON_DBG_MED, __func__, "mapped tape file: %s", name);
+    return tape;
+
+stale:
+    unmap_all(map, size, 0);
+    return NULL;
+}
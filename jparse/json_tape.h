@@ -0,0 +1,241 @@
+/*
+ * json_tape - flat tape form of a JSON parse tree
+ *
+ * "Because sometimes the shortest path between two nodes is a straight line." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_TAPE_H)
+#    define  INCLUDE_JSON_TAPE_H
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+/*
+ * util - entry common utility functions for the IOCCC toolkit
+ */
+#include "util.h"
+
+/*
+ * json_parse - JSON parser support code
+ */
+#include "json_parse.h"
+
+
+/*
+ * definitions
+ */
+#define JSON_TAPE_TAG_SHIFT (56)	/* a tape word is an 8 bit tag above a 56 bit payload */
+#define JSON_TAPE_PAYLOAD_MAX ((UINT64_C(1) << JSON_TAPE_TAG_SHIFT) - 1)	/* largest payload */
+#define JSON_TAPE_WORD(tag, payload) ((((uint64_t)(tag)) << JSON_TAPE_TAG_SHIFT) | ((uint64_t)(payload)))
+#define JSON_TAPE_WORD_TAG(word) ((enum json_tape_tag)((word) >> JSON_TAPE_TAG_SHIFT))
+#define JSON_TAPE_WORD_PAYLOAD(word) ((size_t)((word) & JSON_TAPE_PAYLOAD_MAX))
+
+#define JSON_TAPE_FILE_MAGIC "JTREE\r\n\032"	/* first 8 bytes of a .jtree tape file */
+#define JSON_TAPE_FILE_VERSION (2)		/* version of the .jtree tape file format */
+#define JSON_TAPE_FILE_ORDER (0x01020304)	/* byte order mark of a .jtree tape file */
+#define JSON_TAPE_FILE_ALIGN (16)		/* alignment of each array in a .jtree tape file */
+#define JSON_TAPE_FILE_SUFFIX ".jtree"		/* suffix of a .jtree tape file */
+#define JSON_TAPE_TEXT_MAX (UINT32_MAX)		/* most bytes of text of a tape */
+
+/* flags of a struct json_tape_string */
+#define JSON_TAPE_STR_CONVERTED (0x01)	/* the string was decoded */
+#define JSON_TAPE_STR_QUOTE (0x02)	/* the struct json_string included the surrounding '"'s */
+#define JSON_TAPE_STR_HAS_NUL (0x04)	/* decoded string has a NUL byte inside it */
+#define JSON_TAPE_STR_SAME (0x08)	/* decoded string is the JSON encoded string: they share their text */
+#define JSON_TAPE_STR_OFF(rec) ((((rec)->flags & JSON_TAPE_STR_SAME) != 0) ? (size_t)(rec)->as_str : \
+				(size_t)(rec)->as_str + (size_t)(rec)->as_str_len + 1)	/* offset of decoded string */
+
+/* flags of a struct json_tape_number */
+#define JSON_TAPE_NUM_CONVERTED (0x01)	/* the JSON number was converted to a C value */
+#define JSON_TAPE_NUM_NEGATIVE (0x02)	/* value < 0 */
+#define JSON_TAPE_NUM_FLOATING (0x04)	/* the JSON number had a '.' in it */
+#define JSON_TAPE_NUM_E_NOTATION (0x08)	/* the JSON number used e notation */
+#define JSON_TAPE_NUM_INTEGER (0x10)	/* the JSON number is an integer */
+#define JSON_TAPE_NUM_INTEGER_CONVERTED (0x20)	/* the JSON number was converted to a C integer */
+
+
+/*
+ * json_tape_tag - what a tape word is
+ *
+ * The tags are printable so that a dumped tape may be read by a human.
+ */
+enum json_tape_tag {
+    JSON_TAPE_NONE = 0,			/* not a tape word - must be the value 0 */
+    JSON_TAPE_OBJECT = '{',		/* payload: tape index just beyond the matching JSON_TAPE_OBJECT_END */
+    JSON_TAPE_OBJECT_END = '}',		/* payload: number of members in the object */
+    JSON_TAPE_ARRAY = '[',		/* payload: tape index just beyond the matching JSON_TAPE_ARRAY_END */
+    JSON_TAPE_ARRAY_END = ']',		/* payload: number of values in the array */
+    JSON_TAPE_STRING = '"',		/* payload: index in str of the struct json_tape_string */
+    JSON_TAPE_NUMBER = '0',		/* payload: index in num of the struct json_tape_number */
+    JSON_TAPE_TRUE = 't',		/* payload: 0 */
+    JSON_TAPE_FALSE = 'f',		/* payload: 0 */
+    JSON_TAPE_NULL = 'n',		/* payload: 0 */
+};
+
+
+/*
+ * json_tape_string - a JSON string of a tape
+ *
+ * Both forms of the string are in the text of the tape and are NUL terminated.
+ * The JSON encoded form is kept without its enclosing '"'s and the decoded
+ * form follows its NUL.  A string with nothing to decode, which is most
+ * strings, has its text once: both forms share it and JSON_TAPE_STR_SAME is
+ * set.  JSON_TAPE_STR_OFF() gives the offset of the decoded form.
+ */
+struct json_tape_string
+{
+    uint32_t as_str;		/* offset in text of the JSON encoded string, without its '"'s */
+    uint32_t as_str_len;	/* length of the JSON encoded string, without its '"'s */
+    uint32_t str_len;		/* length of the decoded string, not including final NUL */
+    uint8_t flags;		/* JSON_TAPE_STR_ flags */
+};
+
+
+/*
+ * json_tape_number - a JSON number of a tape
+ *
+ * The JSON number text, exactly as in the struct json_number as_str, is
+ * in the text of the tape.  The value is not kept: json_conv_number() of
+ * the text gives the struct json_number the tape was formed from.
+ */
+struct json_tape_number
+{
+    uint32_t as_str;		/* offset in text of the NUL terminated JSON number */
+    uint32_t as_str_len;	/* length of the JSON number */
+    uint8_t flags;		/* JSON_TAPE_NUM_ flags */
+};
+
+
+/*
+ * json_tape - a JSON document as a flat tape
+ *
+ * The tape holds one word for each JSON value, in document order, with the
+ * value at tape index 0 being the top of the document.  A JSON object or
+ * array is a start word, the words of what it holds and an end word: the
+ * start word gives the tape index just beyond the end word, so that a
+ * reader may skip over the container, and the end word gives the number of
+ * members or values.  Each member of an object is the JSON_TAPE_STRING word
+ * of its name followed by the word(s) of its value.  For the JSON:
+ *
+ *	{ "a" : [ 1, true ] }
+ *
+ * the tape, as printed by json_tape_fprint(), is:
+ *
+ *	0	{	7
+ *	1	"	"a"
+ *	2	[	6
+ *	3	0	1
+ *	4	t
+ *	5	]	2
+ *	6	}	1
+ *
+ * JSON strings and numbers are kept apart from the words, in str and num,
+ * and their text in text, so that walking the words only touches the words.
+ * Offsets in the text are 32 bits, so the text of a tape is at most
+ * JSON_TAPE_TEXT_MAX bytes.
+ */
+struct json_tape
+{
+    uint64_t *word;		/* tape words */
+    size_t count;		/* number of tape words */
+    size_t alloc;		/* number of tape words allocated */
+
+    struct json_tape_string *str;	/* JSON strings of the tape */
+    size_t str_count;		/* number of JSON strings */
+    size_t str_alloc;		/* number of JSON strings allocated */
+
+    struct json_tape_number *num;	/* JSON numbers of the tape */
+    size_t num_count;		/* number of JSON numbers */
+    size_t num_alloc;		/* number of JSON numbers allocated */
+
+    char *text;			/* text of the JSON strings and numbers */
+    size_t text_len;		/* bytes of text in use */
+    size_t text_alloc;		/* bytes of text allocated */
+
+    void *map;			/* != NULL ==> the arrays are in this mapping of a .jtree tape file */
+    size_t map_len;		/* length of map */
+};
+
+
+/*
+ * json_tape_file - header of a .jtree tape file
+ *
+ * A .jtree tape file is this header followed by the words, the JSON
+ * strings, the JSON numbers and the text of a tape, each starting on a
+ * multiple of JSON_TAPE_FILE_ALIGN bytes.  The tape holds no pointers, so
+ * a mapping of the file is the tape.  The file is only for the system that
+ * wrote it: a file of a different byte order or structure layout is
+ * ignored.
+ *
+ * The src_ fields identify the JSON file the tape was formed from: a tape
+ * file whose JSON file has since changed is ignored.
+ */
+struct json_tape_file
+{
+    char magic[8];		/* JSON_TAPE_FILE_MAGIC */
+    uint32_t version;		/* JSON_TAPE_FILE_VERSION */
+    uint32_t order;		/* JSON_TAPE_FILE_ORDER in the byte order of the writer */
+    uint32_t str_size;		/* sizeof(struct json_tape_string) of the writer */
+    uint32_t num_size;		/* sizeof(struct json_tape_number) of the writer */
+    uint64_t src_size;		/* size of the JSON file */
+    int64_t src_mtime;		/* modification time of the JSON file */
+    int64_t src_ctime;		/* status change time of the JSON file */
+    uint64_t src_dev;		/* device of the JSON file */
+    uint64_t src_ino;		/* inode of the JSON file */
+    uint64_t count;		/* number of tape words */
+    uint64_t str_count;		/* number of JSON strings */
+    uint64_t num_count;		/* number of JSON numbers */
+    uint64_t text_len;		/* bytes of text */
+};
+
+
+/*
+ * json_tape_iter - iterator over the members of an object or the values of an array
+ */
+struct json_tape_iter
+{
+    struct json_tape const *tape;	/* tape being iterated */
+    size_t pos;			/* tape index of the next member or value */
+    size_t end;			/* tape index of the end word of the container */
+    bool object;		/* true ==> iterating over the members of an object */
+};
+
+
+/*
+ * function prototypes
+ */
+extern struct json_tape *json_tape_from_tree(struct json const *node);
+extern struct json *json_tape_to_tree(struct json_tape const *tape);
+extern void json_tape_free(struct json_tape *tape);
+extern bool json_tape_equal(struct json_tape const *a, struct json_tape const *b);
+extern enum json_tape_tag json_tape_tag(struct json_tape const *tape, size_t pos);
+extern size_t json_tape_next(struct json_tape const *tape, size_t pos);
+extern size_t json_tape_len(struct json_tape const *tape, size_t pos);
+extern char const *json_tape_str(struct json_tape const *tape, size_t pos, size_t *len);
+extern struct json_tape_number const *json_tape_num(struct json_tape const *tape, size_t pos);
+extern bool json_tape_iter_init(struct json_tape_iter *iter, struct json_tape const *tape, size_t pos);
+extern bool json_tape_iter_next(struct json_tape_iter *iter, size_t *name, size_t *value);
+extern bool json_tape_find_member(struct json_tape const *tape, size_t pos, char const *name, size_t len, size_t *value);
+extern void json_tape_fprint(FILE *stream, struct json_tape const *tape);
+extern char *json_tape_cache_name(char const *path, char const *dir);
+extern bool json_tape_write(struct json_tape const *tape, char const *name, struct stat const *src);
+extern struct json_tape *json_tape_map(char const *name, struct stat const *src);
+
+
+#endif /* INCLUDE_JSON_TAPE_H */
@@ -24,6 +24,7 @@
 #include <math.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <limits.h>
 #include <ctype.h>
 
@@ -42,6 +43,11 @@
  */
 #include "json_util.h"
 
+/*
+ * jparse - JSON parser, for parse_json_buf() and the tape functions
+ */
+#include "jparse.h"
+
 
 /*
  * global variables
@@ -94,6 +100,30 @@ int const hexval[BYTE_VALUES] = {
  * static declarations
  */
 static void fprnumber(FILE *stream, char *prestr, struct json_number *item, char *midstr, char *poststr);
+static void json_free_node(struct json *node, unsigned int depth, void *ctx);
+static void json_tree_free_node(struct json *node, unsigned int depth, void *ctx);
+static void json_fprint_node(struct json *node, unsigned int depth, void *ctx);
+static void json_vwalk_node(struct json *node, unsigned int depth, void *ctx);
+
+
+/*
+ * json_fprint_ctx - json_walk() context of json_fprint_node()
+ */
+struct json_fprint_ctx
+{
+    FILE *stream;		/* stream to print on */
+    int json_dbg_lvl;		/* print if JSON_DBG_FORCED OR if <= json_verbosity_level */
+};
+
+
+/*
+ * json_vwalk - json_walk() context of json_vwalk_node()
+ */
+struct json_vwalk
+{
+    void (*vcallback)(struct json *, unsigned int, va_list);	/* callback in va_list form */
+    va_list ap;							/* variable argument list for vcallback */
+};
 
 
 
@@ -360,9 +390,9 @@ json_putc(uint8_t const c, FILE *stream)
      * write JSON encoding to stream
      */
     errno = 0;	    /* pre-clear errno for warnp */
-    ret = fprintf(stream, "%s", jenc[c].enc);
-    if (chk_stdio_printf_err(stream, ret)) {
-	warnp(__func__, "fprintf #1 error");
+    ret = fputs(jenc[c].enc, stream);
+    if (ret == EOF) {
+	warnp(__func__, "fputs #1 error");
 	return false;
     }
     return true;
@@ -400,7 +430,9 @@ bool
 json_fprintf_str(FILE *stream, char const *str)
 {
     int ret;			/* libc function return */
-    char const *p;
+    size_t len = 0;		/* length of str */
+    size_t run = 0;		/* length of a run of bytes that encode to themselves */
+    size_t i;
 
     /*
      * firewall
@@ -435,9 +467,22 @@ json_fprintf_str(FILE *stream, char const *str)
 
     /*
      * print name, JSON encoded
-     */
-    for (p=str; *p != '\0'; ++p) {
-	if (json_putc((uint8_t const)*p, stream) != true) {
+     *
+     * Runs of bytes that JSON encode to themselves are written in bulk and
+     * only the bytes that need a \-escape are encoded one at a time.
+     */
+    len = strlen(str);
+    for (i=0; i < len; ++i) {
+	run = json_encode_run(str+i, len-i);
+	if (run > 0) {
+	    errno = 0;			/* pre-clear errno for warnp() */
+	    if (fwrite(str+i, 1, run, stream) != run) {
+		warnp(__func__, "fwrite error for %ju bytes", (uintmax_t)run);
+		return false;
+	    }
+	    i += run;
+	}
+	if (i < len && json_putc((uint8_t const)str[i], stream) != true) {
 	    warn(__func__, "json_putc #0 error");
 	    return false;
 	}
@@ -1068,9 +1113,34 @@ json_free(struct json *node, unsigned int depth, ...)
 void
 vjson_free(struct json *node, unsigned int depth, va_list ap)
 {
-    UNUSED_ARG(depth);
     UNUSED_ARG(ap);
 
+    /*
+     * free the JSON parse tree node
+     */
+    json_free_node(node, depth, NULL);
+    return;
+}
+
+
+/*
+ * json_free_node - free storage of a single JSON parse tree node in json_walk() form
+ *
+ * given:
+ *	node	pointer to a JSON parser tree node to free
+ *	depth	current tree depth (0 ==> top of tree)
+ *	ctx	ignored, may be NULL
+ *
+ * NOTE: This function does nothing if node == NULL.
+ *
+ * NOTE: This function does nothing if the node type is invalid.
+ */
+static void
+json_free_node(struct json *node, unsigned int depth, void *ctx)
+{
+    UNUSED_ARG(depth);
+    UNUSED_ARG(ctx);
+
     /*
      * firewall - nothing to do for a NULL node
      */
@@ -1078,6 +1148,13 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 	return;
     }
 
+    /*
+     * arena nodes are freed all at once by json_arena_free()
+     */
+    if (node->in_arena == true) {
+	return;
+    }
+
     /*
      * free internals based in node type
      */
@@ -1111,6 +1188,16 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 	    struct json_string *item = &(node->item.string);
 
 	    /* free internal storage */
+	    if (item->interned != NULL) {
+		/* a shared member name is freed with its last reference */
+		if (item->as_str != NULL && item->as_str != item->str) {
+		    free(item->as_str);
+		}
+		item->as_str = NULL;
+		item->str = NULL;
+		json_intern_release(item->interned);
+		item->interned = NULL;
+	    }
 	    if (item->as_str != NULL) {
 		free(item->as_str);
 		item->as_str = NULL;
@@ -1181,6 +1268,10 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 	    struct json_object *item = &(node->item.object);
 
 	    /* free internal storage */
+	    if (item->index != NULL) {
+		json_member_index_free(item->index);
+		item->index = NULL;
+	    }
 	    if (item->s != NULL) {
 		dyn_array_free(item->s);
 		item->s = NULL;
@@ -1251,7 +1342,7 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 /*
  * json_tree_free - free storage of a JSON parse tree
  *
- * This function uses the json_tree_walk() interface to walk
+ * This function uses the json_walk() interface to walk
  * the JSON parse tree and free all nodes under a given node.
  *
  * given:
@@ -1260,12 +1351,16 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
  *			NOTE: Use JSON_INFINITE_DEPTH for infinite depth.
  *			NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
  *
- * NOTE: This function will free the internals of a JSON parser tree node.
- *	 It is up to the caller to free the top level struct json if needed.
+ * NOTE: This function will free every node under the given node and the
+ *	 internals of the given node.  It is up to the caller to free the top
+ *	 level struct json if needed.
  *
  * NOTE: If the pointer to allocated storage == NULL,
  *	 this function does nothing.
  *
+ * NOTE: A JSON parse tree formed by parse_json_arena() is not freed here:
+ *	 this function does nothing for such a tree.  Use json_arena_free().
+ *
  * NOTE: This function does nothing if node == NULL.
  *
  * NOTE: This function does nothing if the node type is invalid.
@@ -1273,8 +1368,6 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 void
 json_tree_free(struct json *node, unsigned int max_depth, ...)
 {
-    va_list ap;		/* variable argument list */
-
     /*
      * firewall - nothing to do for a NULL node
      */
@@ -1283,19 +1376,53 @@ json_tree_free(struct json *node, unsigned int max_depth, ...)
     }
 
     /*
-     * stdarg variable argument list setup
+     * an arena tree is freed all at once by json_arena_free()
      */
-    va_start(ap, max_depth);
+    if (node->in_arena == true) {
+	return;
+    }
 
     /*
      * free the JSON parse tree
      */
-    vjson_tree_walk(node, max_depth, 0, true, vjson_free, ap);
+    json_walk(node, max_depth, 0, true, json_tree_free_node, NULL);
+    return;
+}
 
+
+/*
+ * json_tree_free_node - free a JSON parse tree node for json_tree_free()
+ *
+ * This frees the internals of the node and, unless the node is the top of
+ * the tree being freed, the struct json itself.  Because json_tree_free()
+ * walks in post-order, nothing under the node is visited after this call.
+ *
+ * given:
+ *	node	pointer to a JSON parser tree node to free
+ *	depth	current tree depth (0 ==> top of tree)
+ *	ctx	ignored, may be NULL
+ */
+static void
+json_tree_free_node(struct json *node, unsigned int depth, void *ctx)
+{
     /*
-     * stdarg variable argument list cleanup
+     * firewall - nothing to do for a NULL node
      */
-    va_end(ap);
+    if (node == NULL) {
+	return;
+    }
+
+    /*
+     * free the internals of the node
+     */
+    json_free_node(node, depth, ctx);
+
+    /*
+     * free the node, unless it is the top of the tree
+     */
+    if (depth > 0) {
+	free(node);
+    }
     return;
 }
 
@@ -1383,6 +1510,8 @@ json_fprint(struct json *node, unsigned int depth, ...)
 static void
 fprnumber(FILE *stream, char *prestr, struct json_number *item, char *midstr, char *poststr)
 {
+    struct json_number_expanded num;	/* every C form of item */
+
     /*
      * firewall - must be -J 3 or more
      */
@@ -1409,6 +1538,11 @@ fprnumber(FILE *stream, char *prestr, struct json_number *item, char *midstr, ch
 	poststr = "((NULL))";
     }
 
+    /*
+     * obtain every C form of the JSON number
+     */
+    json_number_expand(item, &num);
+
     /*
      * print the first prestr
      */
@@ -1430,31 +1564,31 @@ fprnumber(FILE *stream, char *prestr, struct json_number *item, char *midstr, ch
 			item->is_floating?"F":"",
 			item->is_e_notation?"E":"",
 			item->is_integer?"I":"",
-			item->int8_sized?"8":"",
-			item->uint8_sized?"u8":"",
-			item->int16_sized?"16":"",
-			item->uint16_sized?"u16":"",
-			item->int32_sized?"32":"",
-			item->uint32_sized?"u32":"",
-			item->int64_sized?"64":"",
-			item->uint64_sized?"u64":"",
-			item->int_sized?"i":"",
-			item->uint_sized?"ui":"",
-			item->long_sized?"l":"",
-			item->ulong_sized?"ul":"",
-			item->longlong_sized?"ll":"",
-			item->ulonglong_sized?"ull":"",
-			item->ssize_sized?"SS":"",
-			item->size_sized?"s":"",
-			item->off_sized?"o":"",
-			item->maxint_sized?"m":"",
-			item->umaxint_sized?"um":"",
-			item->float_sized?"f":"",
-			item->as_float_int?"fi":"",
-			item->double_sized?"d":"",
-			item->as_double_int?"di":"",
-			item->longdouble_sized?"ld":"",
-			item->as_longdouble_int?"ldi":"");
+			num.int8_sized?"8":"",
+			num.uint8_sized?"u8":"",
+			num.int16_sized?"16":"",
+			num.uint16_sized?"u16":"",
+			num.int32_sized?"32":"",
+			num.uint32_sized?"u32":"",
+			num.int64_sized?"64":"",
+			num.uint64_sized?"u64":"",
+			num.int_sized?"i":"",
+			num.uint_sized?"ui":"",
+			num.long_sized?"l":"",
+			num.ulong_sized?"ul":"",
+			num.longlong_sized?"ll":"",
+			num.ulonglong_sized?"ull":"",
+			num.ssize_sized?"SS":"",
+			num.size_sized?"s":"",
+			num.off_sized?"o":"",
+			num.maxint_sized?"m":"",
+			num.umaxint_sized?"um":"",
+			num.float_sized?"f":"",
+			num.as_float_int?"fi":"",
+			num.double_sized?"d":"",
+			num.as_double_int?"di":"",
+			num.longdouble_sized?"ld":"",
+			num.as_longdouble_int?"ldi":"");
     } else {
 
 	/* -J 3 */ fprint(stream, "%s%s%s%s%s%s%s",
@@ -1464,44 +1598,44 @@ fprnumber(FILE *stream, char *prestr, struct json_number *item, char *midstr, ch
 			item->is_negative?"-":"", item->is_floating?"F":"",
 			item->is_e_notation?"E":"",
 			item->is_integer?"I":"");
-	if (item->int8_sized) {
-	    fprint(stream, "%s", item->int8_sized?"8":"");
-	} else if (item->uint8_sized) {
-	    fprint(stream, "%s", item->uint8_sized?"u8":"");
-	} else if (item->int16_sized) {
-	    fprint(stream, "%s", item->int16_sized?"16":"");
-	} else if (item->uint16_sized) {
-	    fprint(stream, "%s", item->uint16_sized?"u16":"");
-	} else if (item->int32_sized) {
-	    fprint(stream, "%s", item->int32_sized?"32":"");
-	} else if (item->uint32_sized) {
-	    fprint(stream, "%s", item->uint32_sized?"u32":"");
-	} else if (item->int64_sized) {
-	    fprint(stream, "%s", item->int64_sized?"64":"");
-	} else if (item->uint64_sized) {
-	    fprint(stream, "%s", item->uint64_sized?"u64":"");
-	} if (item->ssize_sized) {
-	    fprint(stream, "%s", item->ssize_sized?"SS":"");
-	} else if (item->size_sized) {
-	    fprint(stream, "%s", item->size_sized?"s":"");
-	} if (item->off_sized) {
-	    fprint(stream, "%s", item->off_sized?"o":"");
-	} if (item->maxint_sized) {
-	    fprint(stream, "%s", item->maxint_sized?"m":"");
-	} else if (item->umaxint_sized) {
-	    fprint(stream, "%s", item->umaxint_sized?"um":"");
-	} if (item->as_float_int) {
-	    fprint(stream, "%s", item->as_float_int?"fi":"");
-	} else if (item->float_sized) {
-	    fprint(stream, "%s", item->float_sized?"f":"");
-	} else if (item->as_double_int) {
-	    fprint(stream, "%s", item->as_double_int?"di":"");
-	} else if (item->double_sized) {
-	    fprint(stream, "%s", item->double_sized?"d":"");
-	} else if (item->as_longdouble_int) {
-	    fprint(stream, "%s", item->as_longdouble_int?"ldi":"");
-	} else if (item->longdouble_sized) {
-	    fprint(stream, "%s", item->longdouble_sized?"ld":"");
+	if (num.int8_sized) {
+	    fprint(stream, "%s", num.int8_sized?"8":"");
+	} else if (num.uint8_sized) {
+	    fprint(stream, "%s", num.uint8_sized?"u8":"");
+	} else if (num.int16_sized) {
+	    fprint(stream, "%s", num.int16_sized?"16":"");
+	} else if (num.uint16_sized) {
+	    fprint(stream, "%s", num.uint16_sized?"u16":"");
+	} else if (num.int32_sized) {
+	    fprint(stream, "%s", num.int32_sized?"32":"");
+	} else if (num.uint32_sized) {
+	    fprint(stream, "%s", num.uint32_sized?"u32":"");
+	} else if (num.int64_sized) {
+	    fprint(stream, "%s", num.int64_sized?"64":"");
+	} else if (num.uint64_sized) {
+	    fprint(stream, "%s", num.uint64_sized?"u64":"");
+	} if (num.ssize_sized) {
+	    fprint(stream, "%s", num.ssize_sized?"SS":"");
+	} else if (num.size_sized) {
+	    fprint(stream, "%s", num.size_sized?"s":"");
+	} if (num.off_sized) {
+	    fprint(stream, "%s", num.off_sized?"o":"");
+	} if (num.maxint_sized) {
+	    fprint(stream, "%s", num.maxint_sized?"m":"");
+	} else if (num.umaxint_sized) {
+	    fprint(stream, "%s", num.umaxint_sized?"um":"");
+	} if (num.as_float_int) {
+	    fprint(stream, "%s", num.as_float_int?"fi":"");
+	} else if (num.float_sized) {
+	    fprint(stream, "%s", num.float_sized?"f":"");
+	} else if (num.as_double_int) {
+	    fprint(stream, "%s", num.as_double_int?"di":"");
+	} else if (num.double_sized) {
+	    fprint(stream, "%s", num.double_sized?"d":"");
+	} else if (num.as_longdouble_int) {
+	    fprint(stream, "%s", num.as_longdouble_int?"ldi":"");
+	} else if (num.longdouble_sized) {
+	    fprint(stream, "%s", num.longdouble_sized?"ld":"");
 	}
     }
 
@@ -1551,10 +1685,8 @@ fprnumber(FILE *stream, char *prestr, struct json_number *item, char *midstr, ch
 void
 vjson_fprint(struct json *node, unsigned int depth, va_list ap)
 {
-    FILE *stream = NULL;	/* stream to print on */
-    int json_dbg_lvl = JSON_DBG_DEFAULT;	/* JSON debug level if json_dbg_used == true */
-    char const *tname = NULL;	/* name of the node type */
-    va_list ap2;		/* copy of va_list ap */
+    struct json_fprint_ctx fprint_ctx;	/* stream and JSON debug level */
+    va_list ap2;			/* copy of va_list ap */
 
     /*
      * firewall - nothing to do for a NULL node
@@ -1571,12 +1703,53 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
     /*
      * obtain the stream, json_dbg_used, and json_dbg args
      */
-    stream = va_arg(ap2, FILE *);
+    fprint_ctx.stream = va_arg(ap2, FILE *);
+    fprint_ctx.json_dbg_lvl = va_arg(ap2, int);
+
+    /*
+     * stdarg variable argument list cleanup
+     */
+    va_end(ap2);
+
+    /*
+     * print the JSON parse tree node
+     */
+    json_fprint_node(node, depth, &fprint_ctx);
+    return;
+}
+
+
+/*
+ * json_fprint_node - print a line about a JSON parse tree node in json_walk() form
+ *
+ * given:
+ *	node	pointer to a JSON parser tree node to print
+ *	depth	current tree depth (0 ==> top of tree)
+ *	ctx	pointer to a struct json_fprint_ctx
+ *
+ * NOTE: This function does nothing if node == NULL or ctx == NULL.
+ *
+ * NOTE: This function does nothing if the stream in ctx is NULL.
+ */
+static void
+json_fprint_node(struct json *node, unsigned int depth, void *ctx)
+{
+    struct json_fprint_ctx *fprint_ctx = (struct json_fprint_ctx *)ctx;	/* stream and JSON debug level */
+    FILE *stream = NULL;	/* stream to print on */
+    int json_dbg_lvl = JSON_DBG_DEFAULT;	/* JSON debug level if json_dbg_used == true */
+    char const *tname = NULL;	/* name of the node type */
+
+    /*
+     * firewall - nothing to do for a NULL node
+     */
+    if (node == NULL || fprint_ctx == NULL) {
+	return;
+    }
+    stream = fprint_ctx->stream;
     if (stream == NULL) {
-	va_end(ap2); /* stdarg variable argument list cleanup */
 	return;
     }
-    json_dbg_lvl = va_arg(ap2, int);
+    json_dbg_lvl = fprint_ctx->json_dbg_lvl;
 
     /*
      * check JSON debug level if allowed
@@ -1584,7 +1757,6 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
     if (dbg_output_allowed == false ||
         (json_dbg_lvl != JSON_DBG_FORCED && json_dbg_lvl > json_verbosity_level)) {
 	/* tree output disabled by json_verbosity_level */
-	va_end(ap2); /* stdarg variable argument list cleanup */
 	return;
     }
 
@@ -1603,7 +1775,6 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
     tname = json_item_type_name(node);
     if (tname == NULL) {
 	warn(__func__, "json_item_type_name returned NULL");
-	va_end(ap2); /* stdarg variable argument list cleanup */
 	return;
     }
     fprint(stream, "lvl: %u\ttype: %s", depth, tname);
@@ -1953,11 +2124,6 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
      * print final newline
      */
     fprstr(stream, "\n");
-
-    /*
-     * stdarg variable argument list cleanup
-     */
-    va_end(ap2);
     return;
 }
 
@@ -1965,7 +2131,7 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
 /*
  * json_tree_print - print lines for an entire JSON parse tree.
  *
- * This function uses the json_tree_walk() interface to walk
+ * This function uses the json_walk() interface to walk
  * the JSON parse tree and print lines about all tree nodes.
  *
  * If dbg_output_allowed == false, this function will not print.
@@ -2002,13 +2168,14 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
  *
  * NOTE: This function does nothing if the node type is invalid.
  *
- * NOTE: this function is a wrapper to vjson_tree_walk() with the callback
- * vjson_fprint().
+ * NOTE: this function is a wrapper to json_walk() with the callback
+ * json_fprint_node(), the json_walk() form of vjson_fprint().
  */
 void
 json_tree_print(struct json *node, unsigned int max_depth, ...)
 {
-    va_list ap;		/* variable argument list */
+    struct json_fprint_ctx fprint_ctx;	/* stream and JSON debug level */
+    va_list ap;				/* variable argument list */
 
     /*
      * firewall - nothing to do for a NULL node
@@ -2023,14 +2190,20 @@ json_tree_print(struct json *node, unsigned int max_depth, ...)
     va_start(ap, max_depth);
 
     /*
-     * print the JSON parse tree
+     * obtain the stream and json_dbg_lvl args
      */
-    vjson_tree_walk(node, max_depth, 0, true, vjson_fprint, ap);
+    fprint_ctx.stream = va_arg(ap, FILE *);
+    fprint_ctx.json_dbg_lvl = va_arg(ap, int);
 
     /*
      * stdarg variable argument list cleanup
      */
     va_end(ap);
+
+    /*
+     * print the JSON parse tree
+     */
+    json_walk(node, max_depth, 0, true, json_fprint_node, &fprint_ctx);
     return;
 }
 
@@ -2119,6 +2292,273 @@ json_dbg_tree_print(int json_dbg_lvl, char const *name, struct json *tree, unsig
 }
 
 
+/*
+ * json_walk - walk a JSON parse tree calling a function on each node
+ *
+ * Walk a JSON parse tree, Depth-first, in either Post-order (LRN) or
+ * Pre-order (NLR).  See:
+ *
+ *	https://en.wikipedia.org/wiki/Tree_traversal#Post-order,_LRN
+ *	https://en.wikipedia.org/wiki/Tree_traversal#Pre-order,_NLR
+ *
+ * Example use - count the nodes of an entire JSON parse tree
+ *
+ *	static void
+ *	count_node(struct json *node, unsigned int depth, void *ctx)
+ *	{
+ *	    ++*(uintmax_t *)ctx;
+ *	}
+ *	...
+ *	uintmax_t count = 0;
+ *	json_walk(tree, JSON_DEFAULT_MAX_DEPTH, 0, true, count_node, &count);
+ *
+ * given:
+ *	node	    pointer to a JSON parse tree
+ *	max_depth   maximum tree depth to descend, or 0 ==> infinite depth
+ *			NOTE: Use JSON_INFINITE_DEPTH for infinite depth
+ *			NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
+ *	depth	    current tree depth (0 ==> top of tree)
+ *	post_order  true ==> walk tree in post-order (LRN), false ==> walk in pre-order (NLR)
+ *	callback    function to operate JSON parse tree node
+ *	ctx	    context passed unchanged to each callback, may be NULL
+ *
+ * Unlike a recursive walk, this function keeps the path from node down to the
+ * current node on an explicit stack of struct json_walk_frame.  The first
+ * JSON_WALK_STACK frames are on the C stack: only a deeper tree moves the
+ * stack to allocated storage.  Thus the depth of a tree that may be walked
+ * is not limited by the size of the C stack.
+ *
+ * In post-order, the callback for a node is called after the callbacks for
+ * all of the nodes under it, so the callback may free the node.  In
+ * pre-order, the callback for a node is called before any node under it
+ * is visited.  In either order, the callback must NOT change the set of
+ * nodes under a node that has not yet been walked.
+ *
+ * If max_depth is >= 0 and the tree depth > max_depth, then this function
+ * will NOT operate on a node below max_depth and it will NOT descend any
+ * further into the tree below that node.
+ *
+ * NOTE: This function warns but does not do anything if an arg is NULL.
+ *
+ * NOTE: This function does not return on a stack allocation error.
+ */
+void
+json_walk(struct json *node, unsigned int max_depth, unsigned int depth, bool post_order,
+	  void (*callback)(struct json *, unsigned int, void *), void *ctx)
+{
+    struct json_walk_frame stack[JSON_WALK_STACK];	/* initial walk stack */
+    struct json_walk_frame *frame = stack;		/* walk stack, stack or allocated */
+    struct json_walk_frame *top = NULL;			/* frame of the node being walked */
+    struct json_walk_frame *new_frame = NULL;		/* reallocated walk stack */
+    size_t size = JSON_WALK_STACK;			/* number of frames in the walk stack */
+    size_t used = 0;					/* number of frames in use */
+    struct json *child = NULL;				/* next node under top->node to walk */
+
+    /*
+     * firewall
+     */
+    if (node == NULL) {
+	warn(__func__, "node is NULL");
+	return;
+    }
+    if (callback == NULL) {
+	warn(__func__, "callback is NULL");
+	return;
+    }
+
+    /*
+     * do nothing if we are too deep
+     */
+    if (max_depth != JSON_INFINITE_DEPTH && depth > max_depth) {
+	warn(__func__, "tree walk descent stopped, tree depth: %u > max_depth: %u", depth, max_depth);
+	return;
+    }
+
+    /*
+     * push the top node
+     */
+    frame[0].node = node;
+    frame[0].depth = depth;
+    frame[0].next = 0;
+    used = 1;
+    if (post_order == false) {
+	(*callback)(node, depth, ctx);
+    }
+
+    /*
+     * walk until the stack is empty
+     */
+    while (used > 0) {
+	top = &frame[used-1];
+
+	/*
+	 * find the next node under the node being walked, if any
+	 */
+	child = NULL;
+	switch (top->node->type) {
+
+	case JTYPE_UNSET:	/* JSON item has not been set - must be the value 0 */
+	case JTYPE_NUMBER:	/* JSON item is number - see struct json_number */
+	case JTYPE_STRING:	/* JSON item is a string - see struct json_string */
+	case JTYPE_BOOL:	/* JSON item is a boolean - see struct json_boolean */
+	case JTYPE_NULL:	/* JSON item is a null - see struct json_null */
+	    /* case: terminal JSON tree leaf node */
+	    top->next = -1;
+	    break;
+
+	case JTYPE_MEMBER:	/* JSON item is a member */
+	    {
+		struct json_member *item = &(top->node->item.member);
+
+		/* JSON member name (left branch) node, then JSON member value (right branch) node */
+		if (top->next == 0) {
+		    child = item->name;
+		    top->next = 1;
+		} else if (top->next == 1) {
+		    child = item->value;
+		    top->next = 2;
+		} else {
+		    top->next = -1;
+		}
+	    }
+	    break;
+
+	case JTYPE_OBJECT:	/* JSON item is a { members } */
+	    {
+		struct json_object *item = &(top->node->item.object);
+
+		/* each object member in order */
+		if (item->set != NULL && top->next < item->len) {
+		    child = item->set[top->next++];
+		} else {
+		    top->next = -1;
+		}
+	    }
+	    break;
+
+	case JTYPE_ARRAY:	/* JSON item is a [ elements ] */
+	    {
+		struct json_array *item = &(top->node->item.array);
+
+		/* each array value in order */
+		if (item->set != NULL && top->next < item->len) {
+		    child = item->set[top->next++];
+		} else {
+		    top->next = -1;
+		}
+	    }
+	    break;
+
+	case JTYPE_ELEMENTS:	/* JSON items is zero or more JSON values */
+	    {
+		struct json_elements *item = &(top->node->item.elements);
+
+		/* each JSON value in order */
+		if (item->set != NULL && top->next < item->len) {
+		    child = item->set[top->next++];
+		} else {
+		    top->next = -1;
+		}
+	    }
+	    break;
+
+	default:
+	    warn(__func__, "node type is unknown: %d", top->node->type);
+	    /* nothing we can traverse, nor operate on */
+	    --used;
+	    continue;
+	}
+
+	/*
+	 * case: every node under the node being walked has been walked
+	 */
+	if (top->next < 0) {
+	    /* case: post-order (LRN) */
+	    if (post_order == true) {
+		(*callback)(top->node, top->depth, ctx);
+	    }
+	    --used;
+	    continue;
+	}
+
+	/*
+	 * skip a NULL node or a node that is too deep
+	 */
+	if (child == NULL) {
+	    warn(__func__, "node is NULL");
+	    continue;
+	}
+	if (max_depth != JSON_INFINITE_DEPTH && top->depth+1 > max_depth) {
+	    warn(__func__, "tree walk descent stopped, tree depth: %u > max_depth: %u", top->depth+1, max_depth);
+	    continue;
+	}
+
+	/*
+	 * grow the walk stack if full
+	 */
+	if (used >= size) {
+	    if (frame == stack) {
+		new_frame = malloc(sizeof(*frame) * size * 2);
+		if (new_frame == NULL) {
+		    errp(43, __func__, "malloc of %ju walk stack frames failed", (uintmax_t)(size * 2));
+		    not_reached();
+		}
+		memcpy(new_frame, stack, sizeof(stack));
+	    } else {
+		new_frame = realloc(frame, sizeof(*frame) * size * 2);
+		if (new_frame == NULL) {
+		    errp(44, __func__, "realloc of %ju walk stack frames failed", (uintmax_t)(size * 2));
+		    not_reached();
+		}
+	    }
+	    frame = new_frame;
+	    size *= 2;
+	    top = &frame[used-1];
+	}
+
+	/*
+	 * push the node under the node being walked
+	 */
+	frame[used].node = child;
+	frame[used].depth = top->depth+1;
+	frame[used].next = 0;
+	++used;
+
+	/* case: pre-order (NLR) */
+	if (post_order == false) {
+	    (*callback)(child, top->depth+1, ctx);
+	}
+    }
+
+    /*
+     * free an allocated walk stack
+     */
+    if (frame != stack) {
+	free(frame);
+	frame = NULL;
+    }
+    return;
+}
+
+
+/*
+ * json_vwalk_node - adapt a callback in va_list form to json_walk()
+ *
+ * given:
+ *	node	pointer to a JSON parse tree node
+ *	depth	current tree depth (0 ==> top of tree)
+ *	ctx	pointer to a struct json_vwalk
+ */
+static void
+json_vwalk_node(struct json *node, unsigned int depth, void *ctx)
+{
+    struct json_vwalk *vwalk = (struct json_vwalk *)ctx;
+
+    (*(vwalk->vcallback))(node, depth, vwalk->ap);
+    return;
+}
+
+
 /*
  * json_tree_walk - walk a JSON parse tree calling a function on each node
  *
@@ -2154,6 +2594,8 @@ json_dbg_tree_print(int json_dbg_lvl, char const *name, struct json *tree, unsig
  * returns. In this case it will NOT operate on the node and it will NOT descend
  * any further into the tree.
  *
+ * NOTE: New code should use json_walk() with a typed context instead.
+ *
  * NOTE: This function warns but does not do anything if an arg is NULL.
  */
 void
@@ -2229,13 +2671,15 @@ json_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, bo
  * In this case it will NOT operate on the node, or will be descend and further
  * into the tree.
  *
+ * NOTE: This function is a wrapper to json_walk().
+ *
  * NOTE: This function warns but does not do anything if an arg is NULL.
  */
 void
 vjson_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, bool post_order,
 		void (*vcallback)(struct json *, unsigned int, va_list), va_list ap)
 {
-    int i;
+    struct json_vwalk vwalk;	/* vcallback and its variable argument list */
 
     /*
      * firewall
@@ -2250,134 +2694,333 @@ vjson_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, b
     }
 
     /*
-     * do nothing if we are too deep
+     * walk the tree, calling vcallback on each node
      */
-    if (max_depth != JSON_INFINITE_DEPTH && depth > max_depth) {
-	warn(__func__, "tree walk descent stopped, tree depth: %u > max_depth: %u", depth, max_depth);
-	return;
-    }
-
-    /*
-     * walk based on type of node
-     */
-    switch (node->type) {
-
-    case JTYPE_UNSET:	/* JSON item has not been set - must be the value 0 */
-    case JTYPE_NUMBER:	/* JSON item is number - see struct json_number */
-    case JTYPE_STRING:	/* JSON item is a string - see struct json_string */
-    case JTYPE_BOOL:	/* JSON item is a boolean - see struct json_boolean */
-    case JTYPE_NULL:	/* JSON item is a null - see struct json_null */
+    vwalk.vcallback = vcallback;
+    va_copy(vwalk.ap, ap);
+    json_walk(node, max_depth, depth, post_order, json_vwalk_node, &vwalk);
+    va_end(vwalk.ap); /* stdarg variable argument list cleanup */
+    return;
+}
 
-	/* case: terminal JSON tree leaf node */
-	/* perform function operation on this terminal parse tree node */
-	(*vcallback)(node, depth, ap);
-	break;
+/*
+ * json_read_all - read all JSON data from an open stream for in place scanning
+ *
+ * A non-empty regular file is mapped into memory by map_all() so that the
+ * data is neither copied nor read before it is scanned.  Any other stream
+ * (stdin from a pipe or terminal, etc.) is read by read_all().  Either way
+ * the returned data is writable and is followed by (at least) JSON_SCAN_PAD
+ * NUL bytes so that it may be given directly to parse_json_buf().
+ *
+ * given:
+ *	stream	    - an open file stream to read from
+ *	psize	    - if psize != NULL, *psize is the amount of data read
+ *	mapped	    - if mapped != NULL, *mapped is true if data was mapped
+ *
+ * returns:
+ *	data read from stream, or NULL if an error occurred
+ *
+ * NOTE: As the data may contain NUL bytes, strlen() of the returned data may
+ *	 be less than *psize.
+ *
+ * NOTE: The returned data must be released by json_free_all(), NOT by free(3).
+ *
+ * NOTE: This function does not return if stream is NULL.
+ */
+char *
+json_read_all(FILE *stream, size_t *psize, bool *mapped)
+{
+    return json_read_all_limits(stream, psize, mapped, NULL);
+}
 
-    case JTYPE_MEMBER:	/* JSON item is a member */
-	/* case: pre-order (NLR) */
-	if (post_order == false) {
-	    (*vcallback)(node, depth, ap);
-	}
 
-	/* descend the tree */
-	{
-	    struct json_member *item = &(node->item.member);
+/*
+ * json_read_all_limits - read JSON data from an open stream for in place scanning within resource limits
+ *
+ * This function is json_read_all() except that a stream that is read rather
+ * than mapped is read no further than one byte beyond the max_bytes limit,
+ * so that a stream longer than the limit is not read to its end.  A *psize
+ * greater than max_bytes means that the stream is longer than the limit, for
+ * which parse_json_ctx() reports the limit without scanning the data.
+ *
+ * given:
+ *	stream	    - an open file stream to read from
+ *	psize	    - if psize != NULL, *psize is the amount of data read
+ *	mapped	    - if mapped != NULL, *mapped is true if data was mapped
+ *	limits	    - resource limits of the parse or NULL ==> no limits
+ *
+ * returns:
+ *	data read from stream, or NULL if an error occurred
+ *
+ * NOTE: The returned data must be released by json_free_all(), NOT by free(3).
+ *
+ * NOTE: This function does not return if stream is NULL.
+ */
+char *
+json_read_all_limits(FILE *stream, size_t *psize, bool *mapped, struct json_limits const *limits)
+{
+    char *data = NULL;		/* data to return */
+    char *padded = NULL;	/* data reallocated with room for the pad */
+    size_t len = 0;		/* length of the data */
+    size_t max = 0;		/* most data to read, 0 ==> all */
 
-	    /* perform function operation on JSON member name (left branch) node */
-	    vjson_tree_walk(item->name, max_depth, depth+1, post_order, vcallback, ap);
+    /*
+     * firewall
+     */
+    if (stream == NULL) {
+	err(42, __func__, "stream is NULL"); /*ooo*/
+	not_reached();
+    }
+    if (psize != NULL) {
+	*psize = 0;
+    }
+    if (mapped != NULL) {
+	*mapped = false;
+    }
 
-	    /* perform function operation on JSON member value (right branch) node */
-	    vjson_tree_walk(item->value, max_depth, depth+1, post_order, vcallback, ap);
+    /*
+     * try to map a regular file
+     */
+    data = map_all(stream, &len, JSON_SCAN_PAD);
+    if (data != NULL) {
+	if (psize != NULL) {
+	    *psize = len;
 	}
-
-	/* finally perform function operation on the parent node */
-	/* case: post-order (LRN) */
-	if (post_order == true) {
-	    (*vcallback)(node, depth, ap);
+	if (mapped != NULL) {
+	    *mapped = true;
 	}
-	break;
+	return data;
+    }
 
-    case JTYPE_OBJECT:	/* JSON item is a { members } */
-	/* case: pre-order (NLR) */
-	if (post_order == false) {
-	    (*vcallback)(node, depth, ap);
-	}
+    /*
+     * otherwise read the stream, but no more than one byte beyond the limit
+     */
+    if (limits != NULL && limits->max_bytes > 0 && limits->max_bytes < SIZE_MAX) {
+	max = limits->max_bytes + 1;
+    }
+    data = read_all_max(stream, &len, max);
+    if (data == NULL) {
+	return NULL;
+    }
 
-	/* descend the tree */
-	{
-	    struct json_object *item = &(node->item.object);
+    /*
+     * be sure the scanner pad follows the data
+     *
+     * NOTE: read_all() only promises a single NUL byte after the data.
+     */
+    errno = 0;			/* pre-clear errno for warnp() */
+    padded = realloc(data, len + JSON_SCAN_PAD);
+    if (padded == NULL) {
+	warnp(__func__, "realloc of %ju bytes failed", (uintmax_t)(len + JSON_SCAN_PAD));
+	free(data);
+	return NULL;
+    }
+    memset(padded + len, 0, JSON_SCAN_PAD);
+    if (psize != NULL) {
+	*psize = len;
+    }
+    return padded;
+}
 
-	    /* perform function operation on each object member in order */
-	    if (item->set != NULL) {
-		for (i=0; i < item->len; ++i) {
-		    vjson_tree_walk(item->set[i], max_depth, depth+1, post_order, vcallback, ap);
-		}
-	    }
-	}
 
-	/* finally perform function operation on the parent node */
-	/* case: post-order (LRN) */
-	if (post_order == true) {
-	    (*vcallback)(node, depth, ap);
-	}
-	break;
+/*
+ * json_free_all - release data returned by json_read_all()
+ *
+ * given:
+ *	data	    - data returned by json_read_all()
+ *	size	    - amount of data as returned by json_read_all()
+ *	mapped	    - mapped flag as returned by json_read_all()
+ *
+ * NOTE: This function does nothing if data is NULL.
+ */
+void
+json_free_all(char *data, size_t size, bool mapped)
+{
+    /*
+     * firewall
+     */
+    if (data == NULL) {
+	return;
+    }
 
-    case JTYPE_ARRAY:	/* JSON item is a [ elements ] */
-	/* case: pre-order (NLR) */
-	if (post_order == false) {
-	    (*vcallback)(node, depth, ap);
-	}
+    /*
+     * release the data
+     */
+    if (mapped) {
+	unmap_all(data, size, JSON_SCAN_PAD);
+    } else {
+	free(data);
+    }
+    return;
+}
 
-	/* descend the tree */
-	{
-	    struct json_array *item = &(node->item.array);
+/*
+ * json_util_parse_json - parse the JSON of a json util, or map its tape
+ *
+ * With a -B cache directory and a regular JSON file, the .jtree tape file
+ * of the JSON file in the cache directory is mapped first.  If the tape file
+ * is of the JSON file as it is now, the JSON is valid and is not parsed:
+ * json_tree is left NULL and json_tape is the mapped tape.  Otherwise the
+ * JSON is parsed and, if valid, the tape of the parse tree is written to
+ * the cache directory for the next run.
+ *
+ * given:
+ *	json_util	- pointer to struct json_util whose file_contents have been read
+ *
+ * returns:
+ *	true ==> valid JSON: json_tree and/or json_tape set,
+ *	false ==> invalid JSON
+ *
+ * NOTE: This function does not return if json_util is NULL.
+ */
+bool
+json_util_parse_json(struct json_util *json_util)
+{
+    struct stat buf;		/* status of the JSON file */
+    char *name = NULL;		/* name of the .jtree tape file */
+    struct json_parse_ctx ctx;	/* context of the parse */
+    bool is_valid = false;	/* true ==> JSON is valid */
 
-	    /* perform function operation on each object member in order */
-	    if (item->set != NULL) {
-		for (i=0; i < item->len; ++i) {
-		    vjson_tree_walk(item->set[i], max_depth, depth+1, post_order, vcallback, ap);
-		}
+    /*
+     * firewall
+     */
+    if (json_util == NULL) {
+	err(43, __func__, "json_util is NULL"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * try the tape file of a regular JSON file
+     */
+    if (json_util->tape_dir != NULL && json_util->json_file != NULL && json_util->json_file != stdin &&
+	json_util->json_file_path != NULL && fstat(fileno(json_util->json_file), &buf) == 0 && S_ISREG(buf.st_mode)) {
+	name = json_tape_cache_name(json_util->json_file_path, json_util->tape_dir);
+	if (name != NULL) {
+	    json_util->json_tape = json_tape_map(name, &buf);
+	    if (json_util->json_tape != NULL) {
+		dbg(DBG_MED, "using tape file: %s", name);
+		free(name);
+		name = NULL;
+		return true;
 	    }
 	}
+    }
 
-	/* finally perform function operation on the parent node */
-	/* case: post-order (LRN) */
-	if (post_order == true) {
-	    (*vcallback)(node, depth, ap);
+    /*
+     * parse the JSON, within the -R resource limits if any
+     */
+    json_parse_ctx_init(&ctx, json_util->json_file_path, NULL);
+    ctx.limits = json_util->limits_used ? &json_util->limits : NULL;
+    json_util->json_tree = parse_json_ctx(json_util->file_contents, json_util->file_len,
+					  json_util->file_contents, &ctx, &is_valid);
+    if (is_valid == false || json_util->json_tree == NULL) {
+	if (name != NULL) {
+	    free(name);
+	    name = NULL;
 	}
-	break;
+	return false;
+    }
 
-    case JTYPE_ELEMENTS:	/* JSON items is zero or more JSON values */
-	/* case: pre-order (NLR) */
-	if (post_order == false) {
-	    (*vcallback)(node, depth, ap);
+    /*
+     * write the tape file for the next run
+     *
+     * NOTE: A tape file that cannot be written only costs the next run a parse.
+     */
+    if (name != NULL) {
+	json_util->json_tape = json_tape_from_tree(json_util->json_tree);
+	if (json_util->json_tape != NULL) {
+	    (void) json_tape_write(json_util->json_tape, name, &buf);
 	}
+	free(name);
+	name = NULL;
+    }
+    return true;
+}
 
-	/* descend the tree */
-	{
-	    struct json_elements *item = &(node->item.elements);
+/* json_util_parse_limits - parse the resource limits of the -R option
+ *
+ * given:
+ *
+ *	optarg		- the option argument
+ *	limits		- pointer to the struct json_limits to set
+ *
+ * Returns true if successfully parsed.
+ *
+ * The option argument is a comma separated list of name=value where name
+ * is one of:
+ *
+ *	bytes		- longest JSON document, in bytes
+ *	depth		- deepest nesting of JSON objects and arrays
+ *	nodes		- most JSON parse tree nodes
+ *	string		- longest JSON string, in bytes with its '"'s
+ *	number		- longest JSON number, in bytes
+ *	members		- most members of a JSON object
+ *
+ * and value is the limit, 0 meaning no limit.  A limit that is not given
+ * is left as it was.  For example:
+ *
+ *	-R bytes=1048576,depth=64,string=4096
+ */
+bool
+json_util_parse_limits(char const *optarg, struct json_limits *limits)
+{
+    char const *p = NULL;	/* next name=value */
+    char const *eq = NULL;	/* = of name=value */
+    char *end = NULL;		/* end of the value */
+    size_t len = 0;		/* length of name=value */
+    size_t name_len = 0;	/* length of name */
+    uintmax_t value = 0;	/* value of name=value */
 
-	    /* perform function operation on each object member in order */
-	    if (item->set != NULL) {
-		for (i=0; i < item->len; ++i) {
-		    vjson_tree_walk(item->set[i], max_depth, depth+1, post_order, vcallback, ap);
-		}
-	    }
+    /* firewall checks */
+    if (optarg == NULL || *optarg == '\0') {
+	warn(__func__, "NULL or empty optarg");
+	return false;
+    } else if (limits == NULL) {
+	warn(__func__, "NULL limits");
+	return false;
+    }
+
+    /*
+     * parse each name=value
+     */
+    for (p = optarg; *p != '\0'; p += (*p == ',') ? 1 : 0) {
+	len = strcspn(p, ",");
+	eq = memchr(p, '=', len);
+	if (eq == NULL || eq == p) {
+	    warn(__func__, "limit is not name=value: %.*s", (int)len, p);
+	    return false;
 	}
+	name_len = (size_t)(eq - p);
 
-	/* finally perform function operation on the parent node */
-	/* case: post-order (LRN) */
-	if (post_order == true) {
-	    (*vcallback)(node, depth, ap);
+	/* parse the value */
+	errno = 0;		/* pre-clear errno for strtoumax() */
+	value = strtoumax(eq+1, &end, 10);
+	if (!isascii(eq[1]) || !isdigit(eq[1]) || end != p+len || errno != 0 || value > SIZE_MAX) {
+	    warn(__func__, "invalid limit value: %.*s", (int)len, p);
+	    return false;
 	}
-	break;
 
-    default:
-	warn(__func__, "node type is unknown: %d", node->type);
-	/* nothing we can traverse */
-	break;
+	/* set the limit */
+	if (name_len == 5 && strncmp(p, "bytes", 5) == 0) {
+	    limits->max_bytes = (size_t)value;
+	} else if (name_len == 5 && strncmp(p, "depth", 5) == 0) {
+	    limits->max_depth = value;
+	} else if (name_len == 5 && strncmp(p, "nodes", 5) == 0) {
+	    limits->max_nodes = value;
+	} else if (name_len == 6 && strncmp(p, "string", 6) == 0) {
+	    limits->max_str_len = (size_t)value;
+	} else if (name_len == 6 && strncmp(p, "number", 6) == 0) {
+	    limits->max_num_len = (size_t)value;
+	} else if (name_len == 7 && strncmp(p, "members", 7) == 0) {
+	    limits->max_members = value;
+	} else {
+	    warn(__func__, "unknown limit: %.*s", (int)name_len, p);
+	    return false;
+	}
+	dbg(DBG_LOW, "limit %.*s set to %ju", (int)name_len, p, value);
+	p += len;
     }
-    return;
+    return true;
 }
 
 /* json_util_parse_number_range	- parse a number range for options -l, -N, -n
@@ -48,6 +48,8 @@
 #define JSON_CHUNK (16)			/* number of pointers to allocate at a time in dynamic array */
 #define JSON_DEFAULT_MAX_DEPTH (256)	/* a sane parse tree depth to use */
 #define JSON_INFINITE_DEPTH (0)		/* no limit on parse tree depth to walk */
+#define JSON_SCAN_PAD (2)		/* NUL bytes the scanner requires after an in place JSON buffer */
+#define JSON_WALK_STACK (64)		/* json_walk() stack frames before the stack is allocated */
 
 
 /*
@@ -104,6 +106,16 @@ enum JSON_UTIL_OUTPUT_FMT
 
 /* structures */
 
+/*
+ * json_walk_frame - a JSON parse tree node on the json_walk() stack
+ */
+struct json_walk_frame
+{
+    struct json *node;		/* JSON parse tree node being walked */
+    unsigned int depth;		/* tree depth of node (0 ==> top of tree) */
+    intmax_t next;		/* index of the next node under node to walk, -1 ==> all walked */
+};
+
 /* structures for jval and jnamval */
 
 /* for comparison of numbers / strings - options -n and -S */
@@ -184,6 +196,8 @@ struct json_util
     bool is_stdin;				/* reading from stdin */
     FILE *json_file;				/* FILE * to json file */
     char *file_contents;			/* file contents */
+    size_t file_len;				/* length of file contents */
+    bool file_mapped;				/* true ==> file_contents was mapped by json_read_all() */
     char *json_file_path;			/* path to JSON file to read */
 
     /* out file related to -o */
@@ -208,6 +222,12 @@ struct json_util
 
     uintmax_t max_depth;			/* max depth to traverse set by -m depth */
     struct json *json_tree;			/* json tree if valid merely as a convenience */
+
+    char *tape_dir;				/* -B cache directory of .jtree tape files, or NULL */
+    struct json_tape *json_tape;		/* tape of the JSON if -B used, or NULL */
+
+    bool limits_used;				/* -R specified */
+    struct json_limits limits;			/* -R resource limits of the parse */
 };
 /*
  * global variables
@@ -244,11 +264,19 @@ extern void vjson_fprint(struct json *node, unsigned int depth, va_list ap);
 extern void json_tree_print(struct json *node, unsigned int max_depth, ...);
 extern void json_dbg_tree_print(int json_dbg_lvl, char const *name, struct json *tree, unsigned int max_depth);
 extern void json_tree_free(struct json *node, unsigned int max_depth, ...);
+extern void json_walk(struct json *node, unsigned int max_depth, unsigned int depth, bool post_order,
+		      void (*callback)(struct json *, unsigned int, void *), void *ctx);
 extern void json_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, bool post_order,
 			   void (*vcallback)(struct json *, unsigned int, va_list), ...);
 extern void vjson_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, bool post_order,
 			    void (*vcallback)(struct json *, unsigned int, va_list), va_list ap);
+extern char *json_read_all(FILE *stream, size_t *psize, bool *mapped);
+extern char *json_read_all_limits(FILE *stream, size_t *psize, bool *mapped, struct json_limits const *limits);
+extern void json_free_all(char *data, size_t size, bool mapped);
+extern bool json_util_parse_json(struct json_util *json_util);
 
+/* for -R option */
+bool json_util_parse_limits(char const *optarg, struct json_limits *limits);
 /* for number range option -l */
 bool json_util_parse_number_range(const char *option, char *optarg, bool allow_negative, struct json_util_number *number);
 bool json_util_number_in_range(intmax_t number, intmax_t total_matches, struct json_util_number *range);
@@ -0,0 +1,1087 @@
+/*
+ * json_write - buffered JSON writer
+ *
+ * "Because sometimes the JSON has to go back out again." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+
+/*
+ * json_writer_level - a JSON object or array that a JSON writer is in
+ */
+struct json_writer_level
+{
+    bool object;		/* true ==> JSON object, false ==> JSON array */
+    bool one_line;		/* true ==> written on a single line */
+    uintmax_t count;		/* number of members or values written */
+};
+
+
+/*
+ * json_writer - state of a buffered JSON writer
+ */
+struct json_writer
+{
+    FILE *stream;		/* stream the output buffer is written to */
+    char *buf;			/* output buffer */
+    size_t len;			/* bytes in the output buffer */
+    size_t size;		/* size of the output buffer */
+    bool failed;		/* true ==> a write to the stream failed or the writer was misused */
+
+    char *indent;		/* text written once for each level of indentation */
+    size_t indent_len;		/* length of indent */
+    char *name_sep;		/* text written between a member name and its value */
+    size_t name_sep_len;	/* length of name_sep */
+
+    struct json_writer_level *level;	/* JSON objects and arrays the writer is in, outermost first */
+    size_t depth;		/* number of JSON objects and arrays the writer is in */
+    size_t level_alloc;		/* number of levels allocated */
+};
+
+
+/*
+ * two decimal digits of each value 0 thru 99
+ */
+static char const digit_pair[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+
+/*
+ * static functions
+ */
+static void writer_drain(struct json_writer *w);
+static void writer_put(struct json_writer *w, char const *ptr, size_t len);
+static void writer_putc(struct json_writer *w, char c);
+static void writer_str(struct json_writer *w, char const *str, size_t len);
+static void writer_indent(struct json_writer *w, size_t depth);
+static bool writer_begin(struct json_writer *w, char const *name, size_t len, bool encoded);
+static bool writer_done(struct json_writer *w);
+static bool writer_open(struct json_writer *w, char const *name, size_t len, bool encoded, bool object, bool one_line);
+static bool writer_node(struct json_writer *w, char const *name, size_t len, bool encoded, struct json const *node);
+static size_t fmt_uintmax(char *end, uintmax_t value);
+
+
+/*
+ * writer_drain - write the output buffer of a JSON writer to its stream
+ *
+ * given:
+ *	w	JSON writer
+ *
+ * Only the first failed write is reported.
+ */
+static void
+writer_drain(struct json_writer *w)
+{
+    if (w->len > 0) {
+	errno = 0;		/* pre-clear errno for warnp() */
+	if (fwrite(w->buf, 1, w->len, w->stream) != w->len && w->failed == false) {
+	    warnp(__func__, "fwrite error for %ju bytes", (uintmax_t)w->len);
+	    w->failed = true;
+	}
+	w->len = 0;
+    }
+    return;
+}
+
+
+/*
+ * writer_put - add bytes to the output buffer of a JSON writer
+ *
+ * given:
+ *	w	JSON writer
+ *	ptr	bytes to add
+ *	len	number of bytes to add
+ *
+ * Bytes that would not fit in an empty output buffer are written directly.
+ */
+static void
+writer_put(struct json_writer *w, char const *ptr, size_t len)
+{
+    if (len > w->size - w->len) {
+	writer_drain(w);
+	if (len >= w->size) {
+	    errno = 0;		/* pre-clear errno for warnp() */
+	    if (fwrite(ptr, 1, len, w->stream) != len && w->failed == false) {
+		warnp(__func__, "fwrite error for %ju bytes", (uintmax_t)len);
+		w->failed = true;
+	    }
+	    return;
+	}
+    }
+    memcpy(w->buf + w->len, ptr, len);
+    w->len += len;
+    return;
+}
+
+
+/*
+ * writer_putc - add a byte to the output buffer of a JSON writer
+ *
+ * given:
+ *	w	JSON writer
+ *	c	byte to add
+ */
+static void
+writer_putc(struct json_writer *w, char c)
+{
+    if (w->len == w->size) {
+	writer_drain(w);
+    }
+    w->buf[w->len++] = c;
+    return;
+}
+
+
+/*
+ * writer_str - add a JSON encoded string, with its '"'s, to the output buffer
+ *
+ * given:
+ *	w	JSON writer
+ *	str	string to JSON encode
+ *	len	length of str
+ *
+ * Runs of bytes that JSON encode to themselves are added in bulk and only
+ * the bytes that need a \-escape are encoded one at a time.
+ */
+static void
+writer_str(struct json_writer *w, char const *str, size_t len)
+{
+    size_t run = 0;		/* length of a run of bytes that encode to themselves */
+    uint8_t c;			/* byte that needs a \-escape */
+    size_t i;
+
+    writer_putc(w, '"');
+    for (i=0; i < len; ++i) {
+	run = json_encode_run(str+i, len-i);
+	if (run > 0) {
+	    writer_put(w, str+i, run);
+	    i += run;
+	}
+	if (i < len) {
+	    c = (uint8_t)str[i];
+	    writer_put(w, jenc[c].enc, jenc[c].len);
+	}
+    }
+    writer_putc(w, '"');
+    return;
+}
+
+
+/*
+ * writer_indent - add a newline and the indentation of a level
+ *
+ * given:
+ *	w	JSON writer
+ *	depth	number of indents to add
+ */
+static void
+writer_indent(struct json_writer *w, size_t depth)
+{
+    size_t i;
+
+    writer_putc(w, '\n');
+    for (i=0; i < depth; ++i) {
+	writer_put(w, w->indent, w->indent_len);
+    }
+    return;
+}
+
+
+/*
+ * writer_begin - add what comes before a JSON value
+ *
+ * Before a value in a JSON object or array comes the ',' after the member
+ * or value before it, the newline and indentation of the value, and in a
+ * JSON object the member name.
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	len	length of name
+ *	encoded	true ==> name is already JSON encoded, without its '"'s
+ *
+ * returns:
+ *	true ==> the value may be added,
+ *	false ==> the writer has failed, or name is not right for where the value is
+ */
+static bool
+writer_begin(struct json_writer *w, char const *name, size_t len, bool encoded)
+{
+    struct json_writer_level *lvl = NULL;	/* JSON object or array the value is in */
+
+    /*
+     * firewall
+     */
+    if (w == NULL) {
+	warn(__func__, "called with NULL writer");
+	return false;
+    }
+    if (w->failed == true) {
+	return false;
+    }
+
+    /*
+     * case: top level
+     */
+    if (w->depth == 0) {
+	if (name != NULL) {
+	    warn(__func__, "member name: %s given for a JSON value at the top level", name);
+	    w->failed = true;
+	    return false;
+	}
+	return true;
+    }
+
+    /*
+     * case: in a JSON object or array
+     */
+    lvl = &w->level[w->depth - 1];
+    if (lvl->object == true && name == NULL) {
+	warn(__func__, "JSON value in a JSON object has no member name");
+	w->failed = true;
+	return false;
+    } else if (lvl->object == false && name != NULL) {
+	warn(__func__, "member name: %s given for a JSON value in a JSON array", name);
+	w->failed = true;
+	return false;
+    }
+    if (lvl->count > 0) {
+	writer_putc(w, ',');
+	if (lvl->one_line == true) {
+	    writer_putc(w, ' ');
+	}
+    }
+    if (lvl->one_line == false) {
+	writer_indent(w, w->depth);
+    }
+    ++lvl->count;
+
+    /*
+     * add the member name
+     */
+    if (name != NULL) {
+	if (encoded == true) {
+	    writer_putc(w, '"');
+	    writer_put(w, name, len);
+	    writer_putc(w, '"');
+	} else {
+	    writer_str(w, name, len);
+	}
+	writer_put(w, w->name_sep, w->name_sep_len);
+    }
+    return true;
+}
+
+
+/*
+ * writer_done - end a JSON value
+ *
+ * A JSON value at the top level is followed by a newline.
+ *
+ * given:
+ *	w	JSON writer
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+static bool
+writer_done(struct json_writer *w)
+{
+    if (w->depth == 0) {
+	writer_putc(w, '\n');
+    }
+    return !w->failed;
+}
+
+
+/*
+ * writer_open - begin a JSON object or array
+ *
+ * given:
+ *	w		JSON writer
+ *	name		member name in a JSON object, NULL in a JSON array or at the top level
+ *	len		length of name
+ *	encoded		true ==> name is already JSON encoded, without its '"'s
+ *	object		true ==> JSON object, false ==> JSON array
+ *	one_line	true ==> write the JSON object or array on a single line
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+static bool
+writer_open(struct json_writer *w, char const *name, size_t len, bool encoded, bool object, bool one_line)
+{
+    struct json_writer_level *level = NULL;	/* reallocated levels */
+    size_t alloc = 0;				/* number of levels to allocate */
+
+    if (writer_begin(w, name, len, encoded) == false) {
+	return false;
+    }
+
+    /*
+     * what a single line JSON object or array holds is on that line too
+     */
+    if (w->depth > 0 && w->level[w->depth - 1].one_line == true) {
+	one_line = true;
+    }
+
+    /*
+     * enter the new level
+     */
+    if (w->depth == w->level_alloc) {
+	alloc = w->level_alloc > 0 ? w->level_alloc * 2 : 16;
+	errno = 0;		/* pre-clear errno for errp() */
+	level = realloc(w->level, alloc * sizeof(w->level[0]));
+	if (level == NULL) {
+	    errp(100, __func__, "realloc of %ju levels failed", (uintmax_t)alloc);
+	    not_reached();
+	}
+	w->level = level;
+	w->level_alloc = alloc;
+    }
+    w->level[w->depth].object = object;
+    w->level[w->depth].one_line = one_line;
+    w->level[w->depth].count = 0;
+    ++w->depth;
+    writer_putc(w, object ? '{' : '[');
+    return !w->failed;
+}
+
+
+/*
+ * writer_node - add a JSON parse tree node and all below it
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	len	length of name
+ *	encoded	true ==> name is already JSON encoded, without its '"'s
+ *	node	JSON parse tree node
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed or the tree holds a node that is not part of a JSON value
+ */
+static bool
+writer_node(struct json_writer *w, char const *name, size_t len, bool encoded, struct json const *node)
+{
+    struct json const *member = NULL;	/* member of a JSON object */
+    struct json_string const *mname = NULL;	/* name of a member */
+    intmax_t i;
+
+    /*
+     * firewall
+     */
+    if (node == NULL) {
+	warn(__func__, "called with NULL node");
+	w->failed = true;
+	return false;
+    }
+
+    switch (node->type) {
+    case JTYPE_OBJECT:
+	if (writer_open(w, name, len, encoded, true, false) == false) {
+	    return false;
+	}
+	for (i=0; i < node->item.object.len; ++i) {
+	    member = node->item.object.set[i];
+	    if (member == NULL || member->type != JTYPE_MEMBER || member->item.member.name == NULL ||
+		member->item.member.name->type != JTYPE_STRING ||
+		member->item.member.name->item.string.as_str == NULL) {
+		warn(__func__, "JSON object member %jd is not a named JSON member", i);
+		w->failed = true;
+		return false;
+	    }
+	    mname = &member->item.member.name->item.string;
+	    if (writer_node(w, mname->as_str, strlen(mname->as_str), true, member->item.member.value) == false) {
+		return false;
+	    }
+	}
+	return json_writer_end(w);
+
+    case JTYPE_ARRAY:
+	if (writer_open(w, name, len, encoded, false, false) == false) {
+	    return false;
+	}
+	for (i=0; i < node->item.array.len; ++i) {
+	    if (writer_node(w, NULL, 0, false, node->item.array.set[i]) == false) {
+		return false;
+	    }
+	}
+	return json_writer_end(w);
+
+    case JTYPE_STRING:
+	if (node->item.string.as_str == NULL) {
+	    warn(__func__, "JSON string has no text");
+	    w->failed = true;
+	    return false;
+	}
+	if (writer_begin(w, name, len, encoded) == false) {
+	    return false;
+	}
+	/* as_str is the JSON encoded string without its '"'s */
+	writer_putc(w, '"');
+	writer_put(w, node->item.string.as_str, strlen(node->item.string.as_str));
+	writer_putc(w, '"');
+	return writer_done(w);
+
+    case JTYPE_NUMBER:
+	if (node->item.number.first == NULL || node->item.number.number_len == 0) {
+	    warn(__func__, "JSON number has no text");
+	    w->failed = true;
+	    return false;
+	}
+	if (writer_begin(w, name, len, encoded) == false) {
+	    return false;
+	}
+	writer_put(w, node->item.number.first, node->item.number.number_len);
+	return writer_done(w);
+
+    case JTYPE_BOOL:
+	if (writer_begin(w, name, len, encoded) == false) {
+	    return false;
+	}
+	if (node->item.boolean.value == true) {
+	    writer_put(w, "true", LITLEN("true"));
+	} else {
+	    writer_put(w, "false", LITLEN("false"));
+	}
+	return writer_done(w);
+
+    case JTYPE_NULL:
+	if (writer_begin(w, name, len, encoded) == false) {
+	    return false;
+	}
+	writer_put(w, "null", LITLEN("null"));
+	return writer_done(w);
+
+    default:
+	warn(__func__, "node type: %s is not a JSON value", json_type_name(node->type));
+	w->failed = true;
+	return false;
+    }
+}
+
+
+/*
+ * fmt_uintmax - format an unsigned integer in decimal
+ *
+ * The digits are formed two at a time, from the last digit back.
+ *
+ * given:
+ *	end	just beyond the end of a buffer of at least 20 bytes
+ *	value	value to format
+ *
+ * returns:
+ *	number of digits just before end
+ */
+static size_t
+fmt_uintmax(char *end, uintmax_t value)
+{
+    char *p = end;	/* next digit goes just before p */
+    unsigned int two;	/* two digits of value */
+
+    while (value >= 100) {
+	two = (unsigned int)(value % 100);
+	value /= 100;
+	p -= 2;
+	p[0] = digit_pair[two * 2];
+	p[1] = digit_pair[two * 2 + 1];
+    }
+    if (value >= 10) {
+	p -= 2;
+	p[0] = digit_pair[value * 2];
+	p[1] = digit_pair[value * 2 + 1];
+    } else {
+	*--p = (char)('0' + value);
+    }
+    return (size_t)(end - p);
+}
+
+
+/*
+ * json_writer_create - create a buffered JSON writer
+ *
+ * given:
+ *	stream		open stream to write to
+ *	buf_size	size of the output buffer, or 0 ==> JSON_WRITER_BUF
+ *	indent		text for each level of indentation, or NULL ==> JSON_WRITER_INDENT
+ *	name_sep	text between a member name and its value, or NULL ==> JSON_WRITER_NAME_SEP
+ *
+ * returns:
+ *	JSON writer to give to the other json_writer functions
+ *
+ * NOTE: This function does not return on error.
+ */
+struct json_writer *
+json_writer_create(FILE *stream, size_t buf_size, char const *indent, char const *name_sep)
+{
+    struct json_writer *w = NULL;	/* JSON writer */
+
+    /*
+     * firewall
+     */
+    if (stream == NULL) {
+	err(101, __func__, "stream is NULL");
+	not_reached();
+    }
+    if (buf_size == 0) {
+	buf_size = JSON_WRITER_BUF;
+    }
+    if (indent == NULL) {
+	indent = JSON_WRITER_INDENT;
+    }
+    if (name_sep == NULL) {
+	name_sep = JSON_WRITER_NAME_SEP;
+    }
+
+    /*
+     * allocate the writer
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    w = calloc(1, sizeof(*w));
+    if (w == NULL) {
+	errp(102, __func__, "calloc of struct json_writer failed");
+	not_reached();
+    }
+    w->stream = stream;
+    w->size = buf_size;
+    errno = 0;			/* pre-clear errno for errp() */
+    w->buf = malloc(buf_size);
+    if (w->buf == NULL) {
+	errp(103, __func__, "malloc of %ju bytes failed", (uintmax_t)buf_size);
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    w->indent = strdup(indent);
+    if (w->indent == NULL) {
+	errp(104, __func__, "strdup of indent failed");
+	not_reached();
+    }
+    w->indent_len = strlen(indent);
+    errno = 0;			/* pre-clear errno for errp() */
+    w->name_sep = strdup(name_sep);
+    if (w->name_sep == NULL) {
+	errp(105, __func__, "strdup of name_sep failed");
+	not_reached();
+    }
+    w->name_sep_len = strlen(name_sep);
+    return w;
+}
+
+
+/*
+ * json_writer_object - begin a JSON object
+ *
+ * The members of the JSON object are the values written until the
+ * matching json_writer_end().
+ *
+ * given:
+ *	w		JSON writer
+ *	name		member name in a JSON object, NULL in a JSON array or at the top level
+ *	one_line	true ==> write the JSON object on a single line
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_object(struct json_writer *w, char const *name, bool one_line)
+{
+    return writer_open(w, name, name != NULL ? strlen(name) : 0, false, true, one_line);
+}
+
+
+/*
+ * json_writer_array - begin a JSON array
+ *
+ * The values of the JSON array are the values written until the matching
+ * json_writer_end().
+ *
+ * given:
+ *	w		JSON writer
+ *	name		member name in a JSON object, NULL in a JSON array or at the top level
+ *	one_line	true ==> write the JSON array on a single line
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_array(struct json_writer *w, char const *name, bool one_line)
+{
+    return writer_open(w, name, name != NULL ? strlen(name) : 0, false, false, one_line);
+}
+
+
+/*
+ * json_writer_end - end the innermost JSON object or array
+ *
+ * given:
+ *	w	JSON writer
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed, or is not in a JSON object or array
+ */
+bool
+json_writer_end(struct json_writer *w)
+{
+    struct json_writer_level *lvl = NULL;	/* JSON object or array being ended */
+
+    /*
+     * firewall
+     */
+    if (w == NULL) {
+	warn(__func__, "called with NULL writer");
+	return false;
+    }
+    if (w->failed == true) {
+	return false;
+    }
+    if (w->depth == 0) {
+	warn(__func__, "not in a JSON object or array");
+	w->failed = true;
+	return false;
+    }
+
+    /*
+     * leave the level
+     */
+    lvl = &w->level[w->depth - 1];
+    --w->depth;
+    if (lvl->count > 0 && lvl->one_line == false) {
+	writer_indent(w, w->depth);
+    }
+    writer_putc(w, lvl->object ? '}' : ']');
+    return writer_done(w);
+}
+
+
+/*
+ * json_writer_string - write a JSON string
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	value	string to JSON encode, or NULL ==> write null
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_string(struct json_writer *w, char const *name, char const *value)
+{
+    if (writer_begin(w, name, name != NULL ? strlen(name) : 0, false) == false) {
+	return false;
+    }
+    if (value == NULL) {
+	writer_put(w, "null", LITLEN("null"));
+    } else {
+	writer_str(w, value, strlen(value));
+    }
+    return writer_done(w);
+}
+
+
+/*
+ * json_writer_intmax - write a JSON integer
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	value	integer to write
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_intmax(struct json_writer *w, char const *name, intmax_t value)
+{
+    char num[1 + 3 * sizeof(uintmax_t)];	/* '-' and the digits of value */
+    size_t len = 0;				/* length of the digits */
+
+    if (writer_begin(w, name, name != NULL ? strlen(name) : 0, false) == false) {
+	return false;
+    }
+    if (value < 0) {
+	len = fmt_uintmax(num + sizeof(num), (uintmax_t)0 - (uintmax_t)value);
+	num[sizeof(num) - len - 1] = '-';
+	++len;
+    } else {
+	len = fmt_uintmax(num + sizeof(num), (uintmax_t)value);
+    }
+    writer_put(w, num + sizeof(num) - len, len);
+    return writer_done(w);
+}
+
+
+/*
+ * json_writer_uintmax - write a JSON integer that is not negative
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	value	integer to write
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_uintmax(struct json_writer *w, char const *name, uintmax_t value)
+{
+    char num[3 * sizeof(uintmax_t)];		/* digits of value */
+    size_t len = 0;				/* length of the digits */
+
+    if (writer_begin(w, name, name != NULL ? strlen(name) : 0, false) == false) {
+	return false;
+    }
+    len = fmt_uintmax(num + sizeof(num), value);
+    writer_put(w, num + sizeof(num) - len, len);
+    return writer_done(w);
+}
+
+
+/*
+ * json_writer_time_t - write a JSON integer from a time_t
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	value	time to write
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_time_t(struct json_writer *w, char const *name, time_t value)
+{
+    if ((time_t)-1 > 0) {
+	/* case: unsigned time_t */
+	return json_writer_uintmax(w, name, (uintmax_t)value);
+    }
+    /* case: signed time_t */
+    return json_writer_intmax(w, name, (intmax_t)value);
+}
+
+
+/*
+ * json_writer_double - write a JSON number from a floating point value
+ *
+ * An integral value that a double holds exactly is written as a JSON
+ * integer.  Any other value is written with the fewest significant digits
+ * that read back as the same value.
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	value	value to write
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed, or value is not finite
+ */
+bool
+json_writer_double(struct json_writer *w, char const *name, double value)
+{
+    char num[32];		/* formatted value */
+    int len = 0;		/* length of the formatted value */
+    int prec;
+
+    /*
+     * firewall
+     */
+    if (!isfinite(value)) {
+	warn(__func__, "JSON has no number for an infinite or NaN value");
+	if (w != NULL) {
+	    w->failed = true;
+	}
+	return false;
+    }
+
+    /*
+     * case: integral value that a double holds exactly
+     */
+    if (value == trunc(value) && fabs(value) <= 9007199254740992.0) {
+	return json_writer_intmax(w, name, (intmax_t)value);
+    }
+
+    /*
+     * find the fewest significant digits that read back as value
+     */
+    if (writer_begin(w, name, name != NULL ? strlen(name) : 0, false) == false) {
+	return false;
+    }
+    for (prec = 15; prec <= 17; ++prec) {
+	len = snprintf(num, sizeof(num), "%.*g", prec, value);
+	if (strtod(num, NULL) == value) {
+	    break;
+	}
+    }
+    if (len <= 0 || (size_t)len >= sizeof(num)) {
+	warn(__func__, "snprintf error formatting a double");
+	w->failed = true;
+	return false;
+    }
+    writer_put(w, num, (size_t)len);
+    return writer_done(w);
+}
+
+
+/*
+ * json_writer_bool - write a JSON boolean
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	value	boolean to write
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_bool(struct json_writer *w, char const *name, bool value)
+{
+    if (writer_begin(w, name, name != NULL ? strlen(name) : 0, false) == false) {
+	return false;
+    }
+    if (value == true) {
+	writer_put(w, "true", LITLEN("true"));
+    } else {
+	writer_put(w, "false", LITLEN("false"));
+    }
+    return writer_done(w);
+}
+
+
+/*
+ * json_writer_null - write a JSON null
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_null(struct json_writer *w, char const *name)
+{
+    if (writer_begin(w, name, name != NULL ? strlen(name) : 0, false) == false) {
+	return false;
+    }
+    writer_put(w, "null", LITLEN("null"));
+    return writer_done(w);
+}
+
+
+/*
+ * json_writer_number - write a JSON number given as text
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	text	JSON number text, written as is
+ *	len	length of text
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed
+ *
+ * NOTE: The text is not checked: it must be a valid JSON number.
+ */
+bool
+json_writer_number(struct json_writer *w, char const *name, char const *text, size_t len)
+{
+    /*
+     * firewall
+     */
+    if (text == NULL || len == 0) {
+	warn(__func__, "called with NULL or empty text");
+	if (w != NULL) {
+	    w->failed = true;
+	}
+	return false;
+    }
+
+    if (writer_begin(w, name, name != NULL ? strlen(name) : 0, false) == false) {
+	return false;
+    }
+    writer_put(w, text, len);
+    return writer_done(w);
+}
+
+
+/*
+ * json_writer_tree - write a JSON parse tree
+ *
+ * JSON strings and numbers are written as they were in the parsed JSON, so
+ * their text is not encoded again.
+ *
+ * given:
+ *	w	JSON writer
+ *	name	member name in a JSON object, NULL in a JSON array or at the top level
+ *	node	top of a JSON parse tree
+ *
+ * returns:
+ *	true ==> all is well so far,
+ *	false ==> the writer has failed, or the tree holds a node that is not part of a JSON value
+ *
+ * NOTE: This function does not return on an allocation error.
+ */
+bool
+json_writer_tree(struct json_writer *w, char const *name, struct json const *node)
+{
+    /*
+     * firewall
+     */
+    if (w == NULL) {
+	warn(__func__, "called with NULL writer");
+	return false;
+    }
+
+    return writer_node(w, name, name != NULL ? strlen(name) : 0, false, node);
+}
+
+
+/*
+ * json_writer_flush - write the output buffer of a JSON writer to its stream
+ *
+ * given:
+ *	w	JSON writer
+ *
+ * returns:
+ *	true ==> all that was written reached the stream,
+ *	false ==> the writer has failed
+ */
+bool
+json_writer_flush(struct json_writer *w)
+{
+    /*
+     * firewall
+     */
+    if (w == NULL) {
+	warn(__func__, "called with NULL writer");
+	return false;
+    }
+
+    writer_drain(w);
+    errno = 0;			/* pre-clear errno for warnp() */
+    if (fflush(w->stream) == EOF && w->failed == false) {
+	warnp(__func__, "fflush error");
+	w->failed = true;
+    }
+    return !w->failed;
+}
+
+
+/*
+ * json_writer_free - flush and free a JSON writer
+ *
+ * The stream of the writer is not closed.
+ *
+ * given:
+ *	w	JSON writer, or NULL
+ *
+ * returns:
+ *	true ==> all that was written reached the stream,
+ *	false ==> the writer failed, or a JSON object or array was not ended
+ */
+bool
+json_writer_free(struct json_writer *w)
+{
+    bool ret = false;	/* true ==> all was written */
+
+    /*
+     * firewall
+     */
+    if (w == NULL) {
+	return true;
+    }
+
+    /*
+     * flush what is buffered
+     */
+    ret = json_writer_flush(w);
+    if (ret == true && w->depth > 0) {
+	warn(__func__, "%ju JSON object(s) or array(s) not ended", (uintmax_t)w->depth);
+	ret = false;
+    }
+
+    /*
+     * free the writer
+     */
+    if (w->buf != NULL) {
+	free(w->buf);
+	w->buf = NULL;
+    }
+    if (w->indent != NULL) {
+	free(w->indent);
+	w->indent = NULL;
+    }
+    if (w->name_sep != NULL) {
+	free(w->name_sep);
+	w->name_sep = NULL;
+    }
+    if (w->level != NULL) {
+	free(w->level);
+	w->level = NULL;
+    }
+    free(w);
+    return ret;
+}
@@ -0,0 +1,87 @@
+/*
+ * json_write - buffered JSON writer
+ *
+ * "Because sometimes the JSON has to go back out again." :-)
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_WRITE_H)
+#    define  INCLUDE_JSON_WRITE_H
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * util - entry common utility functions for the IOCCC toolkit
+ */
+#include "util.h"
+
+/*
+ * json_parse - JSON parser support code
+ */
+#include "json_parse.h"
+
+
+/*
+ * definitions
+ */
+#define JSON_WRITER_BUF (65536)		/* default size of the output buffer of a JSON writer */
+#define JSON_WRITER_INDENT "\t"		/* default indent of each level of a JSON writer */
+#define JSON_WRITER_NAME_SEP " : "	/* default text between a member name and its value */
+
+
+/*
+ * json_writer - state of a buffered JSON writer
+ *
+ * A JSON writer formats JSON values into an output buffer that is written
+ * to its stream only when it fills, or when the writer is flushed or freed.
+ * The writer keeps the indentation of each JSON object and array it is in
+ * and puts the ','s between their members or values, so a caller gives only
+ * the names and values.
+ *
+ * Each JSON object or array is written one member or value to a line,
+ * indented by one indent a level, unless it is begun on one line, in which
+ * case it and all it holds are written on a single line.  Each JSON value at
+ * the top level is followed by a newline.
+ *
+ * The members are private to json_write.c.
+ */
+struct json_writer;
+
+
+/*
+ * function prototypes
+ */
+extern struct json_writer *json_writer_create(FILE *stream, size_t buf_size, char const *indent, char const *name_sep);
+extern bool json_writer_object(struct json_writer *w, char const *name, bool one_line);
+extern bool json_writer_array(struct json_writer *w, char const *name, bool one_line);
+extern bool json_writer_end(struct json_writer *w);
+extern bool json_writer_string(struct json_writer *w, char const *name, char const *value);
+extern bool json_writer_intmax(struct json_writer *w, char const *name, intmax_t value);
+extern bool json_writer_uintmax(struct json_writer *w, char const *name, uintmax_t value);
+extern bool json_writer_time_t(struct json_writer *w, char const *name, time_t value);
+extern bool json_writer_double(struct json_writer *w, char const *name, double value);
+extern bool json_writer_bool(struct json_writer *w, char const *name, bool value);
+extern bool json_writer_null(struct json_writer *w, char const *name);
+extern bool json_writer_number(struct json_writer *w, char const *name, char const *text, size_t len);
+extern bool json_writer_tree(struct json_writer *w, char const *name, struct json const *node);
+extern bool json_writer_flush(struct json_writer *w);
+extern bool json_writer_free(struct json_writer *w);
+
+
+#endif /* INCLUDE_JSON_WRITE_H */
@@ -42,7 +42,7 @@
 /*
  * official jstrencode version
  */
-#define JSTRENCODE_VERSION "1.0 2023-02-04"	/* format: major.minor YYYY-MM-DD */
+#define JSTRENCODE_VERSION "1.1 2026-10-16"	/* format: major.minor YYYY-MM-DD */
 
 /*
  * usage message
@@ -88,18 +88,20 @@ static void usage(int exitcode, char const *prog, char const *str) __attribute__
  *	skip_quote	true ==> ignore any double quotes if they are both
  *				 at the start and end of the memory block
  *			false ==> process all bytes in the block
+ *	buf		pointer to reusable encode buffer (see json_encode_buf())
+ *	bufalloc	pointer to allocated size of *buf
  *
  * returns:
  *	true ==> encoding was successful,
  *	false ==> error in encoding, or NULL stream, or read error
  */
 static bool
-jstrencode_stream(FILE *in_stream, FILE *out_stream, bool skip_quote)
+jstrencode_stream(FILE *in_stream, FILE *out_stream, bool skip_quote, char **buf, size_t *bufalloc)
 {
     char *input = NULL;		/* argument to process */
     size_t inputlen;		/* length of input buffer */
-    char *buf = NULL;		/* encode buffer */
-    size_t bufsiz;		/* length of the buffer */
+    char *enc = NULL;		/* encoded data in *buf */
+    size_t bufsiz;		/* length of the encoded data */
     size_t outputlen;		/* length of write of encode buffer */
     bool success = true;	/* true ==> encoding OK, false ==> error while encoding */
 
@@ -129,8 +131,8 @@ jstrencode_stream(FILE *in_stream, FILE *out_stream, bool skip_quote)
     /*
      * encode data read from input stream
      */
-    buf = json_encode(input, inputlen, &bufsiz, skip_quote);
-    if (buf == NULL) {
+    enc = json_encode_buf(input, inputlen, buf, bufalloc, &bufsiz, skip_quote);
+    if (enc == NULL) {
 	warn(__func__, "error while encoding buffer");
 	success = false;
 
@@ -140,7 +142,7 @@ jstrencode_stream(FILE *in_stream, FILE *out_stream, bool skip_quote)
     } else {
 	dbg(DBG_MED, "encode length: %ju", (uintmax_t)bufsiz);
 	errno = 0;		/* pre-clear errno for warnp() */
-	outputlen = fwrite(buf, 1, bufsiz, out_stream);
+	outputlen = fwrite(enc, 1, bufsiz, out_stream);
 	if (outputlen != bufsiz) {
 	    warnp(__func__, "error: fwrite of %ju bytes of data: returned: %ju",
 			    (uintmax_t)bufsiz, (uintmax_t)outputlen);
@@ -149,14 +151,6 @@ jstrencode_stream(FILE *in_stream, FILE *out_stream, bool skip_quote)
 	dbg(DBG_MED, "fwrite write length: %ju", (uintmax_t)outputlen);
     }
 
-    /*
-     * free buffer
-     */
-    if (buf != NULL) {
-	free(buf);
-	buf = NULL;
-    }
-
     /*
      * free input
      */
@@ -180,8 +174,10 @@ main(int argc, char *argv[])
     extern int optind;		/* argv index of the next arg */
     char *input;		/* argument to process */
     size_t inputlen;		/* length of input buffer */
-    char *buf;			/* encode buffer */
-    size_t bufsiz;		/* length of the buffer */
+    char *buf = NULL;		/* reusable encode buffer */
+    size_t bufalloc = 0;	/* allocated size of buf */
+    char *enc = NULL;		/* encoded data in buf */
+    size_t bufsiz;		/* length of the encoded data */
     size_t outputlen;		/* length of write of encode buffer */
     bool success = true;	/* true ==> encoding OK, false ==> error while encoding */
     bool nloutput = true;	/* true ==> output newline after JSON encode */
@@ -260,7 +256,7 @@ main(int argc, char *argv[])
 	    input = argv[i];
 	    if (!strcmp(input, "-")) {
 		/* encode stdin */
-		success = jstrencode_stream(stdin, stdout, skip_quote);
+		success = jstrencode_stream(stdin, stdout, skip_quote, &buf, &bufalloc);
 	    } else {
 		inputlen = strlen(input);
 		dbg(DBG_LOW, "processing arg: %d: <%s>", i-optind, input);
@@ -269,8 +265,8 @@ main(int argc, char *argv[])
 		/*
 		 * encode
 		 */
-		buf = json_encode_str(input, &bufsiz, skip_quote);
-		if (buf == NULL) {
+		enc = json_encode_buf(input, inputlen, &buf, &bufalloc, &bufsiz, skip_quote);
+		if (enc == NULL) {
 		    warn(__func__, "error while encoding processing arg: %d", i-optind);
 		    success = false;
 
@@ -280,21 +276,13 @@ main(int argc, char *argv[])
 		} else {
 		    dbg(DBG_MED, "encode length: %ju", (uintmax_t)bufsiz);
 		    errno = 0;		/* pre-clear errno for warnp() */
-		    outputlen = fwrite(buf, 1, bufsiz, stdout);
+		    outputlen = fwrite(enc, 1, bufsiz, stdout);
 		    if (outputlen != bufsiz) {
 			warnp(__func__, "error: write of %ju bytes of arg: %d returned: %ju",
 					(uintmax_t)bufsiz, i-optind, (uintmax_t)outputlen);
 			success = false;
 		    }
 		}
-
-		/*
-		 * free buffer
-		 */
-		if (buf == NULL) {
-		    free(buf);
-		    buf = NULL;
-		}
 	    }
 	}
 
@@ -305,7 +293,7 @@ main(int argc, char *argv[])
 	/*
 	 * read all of stdin
 	 */
-	success = jstrencode_stream(stdin, stdout, skip_quote);
+	success = jstrencode_stream(stdin, stdout, skip_quote, &buf, &bufalloc);
     }
 
     /*
@@ -320,6 +308,14 @@ main(int argc, char *argv[])
 	}
     }
 
+    /*
+     * free the encode buffer
+     */
+    if (buf != NULL) {
+	free(buf);
+	buf = NULL;
+    }
+
     /*
      * All Done!!! - Jessica Noll, age 2
      */
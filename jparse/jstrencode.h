@@ -47,7 +47,7 @@
 /*
  * forward declarations
  */
-static bool jstrencode_stream(FILE *in_stream, FILE *out_stream, bool skip_quote);
+static bool jstrencode_stream(FILE *in_stream, FILE *out_stream, bool skip_quote, char **buf, size_t *bufalloc);
 
 
 #endif /* INCLUDE_JSTRENCODE_H */
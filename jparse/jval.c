@@ -42,7 +42,7 @@ static bool quiet = false;				/* true ==> quiet mode */
 static const char * const usage_msg0 =
     "usage:\t%s [-h] [-V] [-v level] [-J level] [-q] [-L <num>{[t|s]}] [-t type] [-l lvl]\n"
     "\t[-Q] [-D] [-d] [-i] [-s] [-f] [-c] [-C] [-g] [-e] [-n op=num] [-S op=str] [-o ofile]\n"
-    "\t[-m common.max_depth] [-K] [-F fmt] file.json [arg ...]\n"
+    "\t[-m common.max_depth] [-K] [-F fmt] [-B dir] [-R limits] file.json [arg ...]\n"
     "\n"
     "\t-h\t\tPrint help and exit\n"
     "\t-V\t\tPrint version and exit\n"
@@ -102,8 +102,10 @@ static const char * const usage_msg0 =
     "\t-S op=str\n"
     "\t\t\top may be one of: eq, ne, lt, le, gt, ge\n"
     "\n"
-    "\t-o ofile\tWrite to ofile (def: stdout)\n"
-    "\n"
+    "\t-o ofile\tWrite to ofile (def: stdout)\n";
+
+
+static const char * const usage_msg1 =
     "\t-F fmt\t\tChange the JSON format style (def: use default)\n\n"
     "\t\t\ttty\t\tWhen output is to a TTY, use colour, otherwise use simple\n"
     "\t\t\tsimple\t\tEach line has one JSON level determined by '[]'s and '{}'s\n"
@@ -118,6 +120,15 @@ static const char * const usage_msg0 =
     "\n"
     "\t-K\t\tRun tests on jval constraints\n"
     "\n"
+    "\t-B dir\t\tKeep a .jtree tape of file.json in the cache directory dir, so that later runs\n"
+    "\t\t\ton the unchanged file.json map the tape instead of parsing (def: do not cache)\n"
+    "\n"
+    "\t-R limits\tStop parsing file.json at the first resource limit it crosses (def: no limits)\n"
+    "\n"
+    "\t\t\tlimits is a comma separated list of name=value where name is one of: bytes,\n"
+    "\t\t\tdepth, nodes, string, number or members and a value of 0 means no limit.\n"
+    "\t\t\tUsing -R with -B is an error.\n"
+    "\n"
     "\tfile.json\tJSON file to parse (- ==> read from stdin)\n"
     "\targ\t\tmatch arg(s)\n"
     "\n"
@@ -149,7 +160,6 @@ main(int argc, char **argv)
     extern char *optarg;
     extern int optind;
     struct jval *jval = NULL;	/* struct of all our options and other things */
-    size_t len = 0;			/* length of file contents */
     bool is_valid = false;		/* if file is valid json */
     int exit_code = 0;			/* for the end */
     int i;
@@ -168,7 +178,7 @@ main(int argc, char **argv)
      * parse args
      */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hVv:J:qL:t:l:QDdisfcCgen:S:o:m:KF:")) != -1) {
+    while ((i = getopt(argc, argv, ":hVv:J:qL:t:l:QDdisfcCgen:S:o:m:KF:B:R:")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 0 */
 	    free_jval(&jval);
@@ -300,6 +310,16 @@ main(int argc, char **argv)
 	    jval->common.format = JSON_FMT_TTY; /* assume default */
 	    jval->common.format = parse_json_util_format(&jval->common, "jval", optarg);
 	    break;
+	case 'B': /* -B dir - cache directory of .jtree tape files */
+	    jval->common.tape_dir = optarg;
+	    break;
+	case 'R': /* -R limits - resource limits of the parse */
+	    if (!json_util_parse_limits(optarg, &jval->common.limits)) {
+		usage(3, program, "invalid -R limits"); /*ooo*/
+		not_reached();
+	    }
+	    jval->common.limits_used = true;
+	    break;
 	case ':':   /* option requires an argument */
 	case '?':   /* illegal option */
 	default:    /* anything else but should not actually happen */
@@ -336,21 +356,22 @@ main(int argc, char **argv)
     }
 
     /*
-     * Read in contents of file.
+     * Read in contents of file (a regular file is mapped rather than copied).
      *
      * NOTE: why doesn't the jval_sanity_chks() function do this? Because this
      * is not so much about a sane environment as much as being unable to
      * continue after verifying the command line is correct.
      */
-    jval->common.file_contents = read_all(jval->common.json_file, &len);
+    jval->common.file_contents = json_read_all_limits(jval->common.json_file, &jval->common.file_len,
+						   &jval->common.file_mapped,
+						   jval->common.limits_used ? &jval->common.limits : NULL);
     if (jval->common.file_contents == NULL) {
 	err(4, "jval", "could not read in file: %s", argv[0]); /*ooo*/
 	not_reached();
     }
 
-    jval->common.json_tree = parse_json(jval->common.file_contents, strlen(jval->common.file_contents),
-	    jval->common.json_file_path, &is_valid);
-    if (!is_valid || jval->common.json_tree == NULL) {
+    is_valid = json_util_parse_json(&jval->common);
+    if (!is_valid) {
 	if (jval->common.json_file != stdin) {
 	    fclose(jval->common.json_file);  /* close file prior to exiting */
 	    jval->common.json_file = NULL;   /* set to NULL even though we're exiting as a safety precaution */
@@ -485,6 +506,13 @@ jval_sanity_chks(struct jval *jval, char const *program, int *argc, char ***argv
 	}
     }
 
+    /* use of -R with -B is an error: a mapped tape is not parsed, so it cannot be limited */
+    if (jval->common.limits_used && jval->common.tape_dir != NULL) {
+	free_jval(&jval);
+	err(3, __func__, "cannot use -R and -B together"); /*ooo*/
+	not_reached();
+    }
+
     /*
      * shift argc and argv for further processing. They're a pointer to those in
      * main() so we have to dereference them here because main() also requires
@@ -621,8 +649,8 @@ usage(int exitcode, char const *prog, char const *str)
     if (*str != '\0') {
 	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
     }
-    fprintf_usage(exitcode, stderr, usage_msg0, prog, DBG_DEFAULT, JSON_DBG_DEFAULT,
-	    JSON_DEFAULT_MAX_DEPTH,json_parser_version, JVAL_VERSION);
+    fprintf_usage(DO_NOT_EXIT, stderr, usage_msg0, prog, DBG_DEFAULT, JSON_DBG_DEFAULT);
+    fprintf_usage(exitcode, stderr, usage_msg1, JSON_DEFAULT_MAX_DEPTH, json_parser_version, JVAL_VERSION);
     exit(exitcode); /*ooo*/
     not_reached();
 }
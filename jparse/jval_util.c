@@ -47,6 +47,8 @@ alloc_jval(void)
     /* JSON file member variables */
     jval->common.is_stdin = false;			/* true if it's stdin */
     jval->common.file_contents = NULL;			/* file.json contents */
+    jval->common.file_len = 0;				/* length of file.json contents */
+    jval->common.file_mapped = false;			/* file.json contents not mapped */
     jval->common.json_file = NULL;			/* JSON file * */
     jval->common.json_file_path = NULL;			/* JSON file path */
 
@@ -107,6 +109,10 @@ alloc_jval(void)
     /* parsing related */
     jval->common.max_depth = JSON_DEFAULT_MAX_DEPTH;		/* max depth to traverse set by -m depth */
     jval->common.json_tree = NULL;
+    jval->common.tape_dir = NULL;				/* -B dir not used */
+    jval->common.limits_used = false;				/* -R limits not used */
+    memset(&jval->common.limits, 0, sizeof(jval->common.limits));
+    jval->common.json_tape = NULL;
 
 
     /* matches for -c / -C - subject to change */
@@ -152,6 +158,14 @@ free_jval(struct jval **jval)
     /* free the compare lists too */
     free_jval_cmp_op_lists(*jval);
 
+    /* free the tape of the JSON */
+    json_tape_free((*jval)->common.json_tape);
+    (*jval)->common.json_tape = NULL;
+
+    /* free the file contents */
+    json_free_all((*jval)->common.file_contents, (*jval)->common.file_len, (*jval)->common.file_mapped);
+    (*jval)->common.file_contents = NULL;
+
     free(*jval);
     *jval = NULL;
 }
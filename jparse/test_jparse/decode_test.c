@@ -0,0 +1,325 @@
+/*
+ * decode_test - test the decoding of JSON strings and their UTF-8 validity
+ *
+ * Each JSON string of a table is parsed as a JSON document.  The decoded
+ * string must be the bytes the table gives, and the utf8 boolean of the
+ * JSON string must be what the table says.  The table covers the bytes of
+ * UTF-8 sequences written as \u00xx escapes, UTF-16 surrogate pairs and
+ * lone surrogates.
+ *
+ * "Because \u00c3\u00a9 should be as good as é." :-)
+ *
+ * This JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * jparse - JSON parser
+ */
+#include "../jparse.h"
+
+
+/*
+ * official decode_test version
+ */
+#define DECODE_TEST_VERSION "1.0.0 2026-10-16"	/* format: major.minor YYYY-MM-DD */
+
+/*
+ * definitions
+ */
+#define REQUIRED_ARGS (0)	/* number of required arguments on the command line */
+
+
+/*
+ * decode_case - a JSON string and what it must decode to
+ */
+struct decode_case
+{
+    char const *json;		/* JSON document: a JSON string with its '"'s */
+    char const *str;		/* bytes the JSON string must decode to */
+    size_t str_len;		/* number of bytes the JSON string must decode to */
+    bool utf8;			/* true ==> the decoded JSON string must be valid UTF-8 */
+};
+
+/*
+ * JSON strings to decode
+ */
+static struct decode_case const decode_tbl[] = {
+    /* ASCII */
+    { "\"abc\"", "abc", 3, true },
+    { "\"a\\tb\"", "a\tb", 3, true },
+
+    /* raw UTF-8 */
+    { "\"\xc3\xa9\"", "\xc3\xa9", 2, true },
+    { "\"\xe2\x82\xac\"", "\xe2\x82\xac", 3, true },
+    { "\"\xc3\"", "\xc3", 1, false },
+    { "\"\xc3" "a\"", "\xc3" "a", 2, false },
+
+    /* the bytes of UTF-8 sequences as \u00xx escapes */
+    { "\"\\u00c3\\u00a9\"", "\xc3\xa9", 2, true },
+    { "\"\\u00e2\\u0082\\u00ac\"", "\xe2\x82\xac", 3, true },
+    { "\"\\u00c3\xa9\"", "\xc3\xa9", 2, true },
+    { "\"\xc3\\u00a9\"", "\xc3\xa9", 2, true },
+    { "\"x\\u00c3\\u00a9y\"", "x\xc3\xa9y", 4, true },
+    { "\"\\u00c3\"", "\xc3", 1, false },
+    { "\"\\u00e2\\u0082\"", "\xe2\x82", 2, false },
+    { "\"\\u00e9\"", "\xe9", 1, false },
+    { "\"\\u00c3\\u00c3\"", "\xc3\xc3", 2, false },
+    { "\"\\u00c3\\u0041\"", "\xc3" "A", 2, false },
+    { "\"\\u00c3\\n\"", "\xc3\n", 2, false },
+    { "\"\\u00c3a\"", "\xc3" "a", 2, false },
+    { "\"\\u00c3\\u00e9\"", "\xc3\xe9", 2, false },
+    { "\"\\u00c3\\u20ac\"", "\xc3\xe2\x82\xac", 4, false },
+
+    /* code points as \uxxxx escapes */
+    { "\"\\u00e9\\u0041\"", "\xe9" "A", 2, false },
+    { "\"\\u0100\"", "\xc4\x80", 2, true },
+    { "\"\\u20ac\"", "\xe2\x82\xac", 3, true },
+    { "\"\\uffff\"", "\xef\xbf\xbf", 3, true },
+
+    /* UTF-16 surrogate pairs */
+    { "\"\\ud83d\\ude00\"", "\xf0\x9f\x98\x80", 4, true },
+    { "\"\\uD834\\uDD1E\"", "\xf0\x9d\x84\x9e", 4, true },
+    { "\"\\udbff\\udfff\"", "\xf4\x8f\xbf\xbf", 4, true },
+    { "\"a\\ud800\\udc00b\"", "a\xf0\x90\x80\x80" "b", 6, true },
+
+    /* lone UTF-16 surrogates */
+    { "\"\\ud83d\"", "\xed\xa0\xbd", 3, false },
+    { "\"\\ude00\"", "\xed\xb8\x80", 3, false },
+    { "\"\\ud83dx\"", "\xed\xa0\xbdx", 4, false },
+    { "\"\\ud83d\\u0041\"", "\xed\xa0\xbd" "A", 4, false },
+    { "\"\\ude00\\ud83d\"", "\xed\xb8\x80\xed\xa0\xbd", 6, false },
+    { "\"\\ud83d\\ud83d\"", "\xed\xa0\xbd\xed\xa0\xbd", 6, false },
+};
+
+
+/*
+ * usage message
+ *
+ * Use the usage() function to print the usage_msg([0-9]?)+ strings.
+ */
+static const char * const usage_msg =
+    "usage: %s [-h] [-v level] [-J level] [-V]\n"
+    "\n"
+    "\t-h\t\tPrint help message and exit\n"
+    "\t-v level\tSet verbosity level (def level: %d)\n"
+    "\t-J level\tSet JSON verbosity level (def level: %d)\n"
+    "\t-V\t\tPrint version string and exit\n"
+    "\n"
+    "Exit codes:\n"
+    "\t0\t\tall JSON strings decoded as expected\n"
+    "\t1\t\tsome JSON string did not decode as expected\n"
+    "\t2\t\t-h and help string printed or -V and version string printed\n"
+    "\t3\t\tcommand line error\n"
+    "\t>=10\t\tinternal error\n"
+    "\n"
+    "decode_test version: %s\n"
+    "JSON parser version: %s";
+
+
+/*
+ * forward declarations
+ */
+static bool decode_chk(struct decode_case const *test);
+static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+int
+main(int argc, char *argv[])
+{
+    char const *program = NULL;		/* our name */
+    extern char *optarg;		/* option argument */
+    extern int optind;			/* argv index of the next arg */
+    uintmax_t failed = 0;		/* number of JSON strings that did not decode as expected */
+    size_t t;
+    int i;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:J:V")) != -1) {
+	switch (i) {
+	case 'h':		/* -h - print help to stderr and exit 0 */
+	    usage(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':		/* -v verbosity */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'J':		/* -J json_verbosity */
+	    json_verbosity_level = parse_verbosity(optarg);
+	    if (json_verbosity_level < 0) {
+		usage(3, program, "invalid -J json_verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':		/* -V - print version and exit */
+	    print("%s\n", DECODE_TEST_VERSION);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case ':':   /* option requires an argument */
+	case '?':   /* illegal option */
+	default:    /* anything else but should not actually happen */
+	    check_invalid_option(program, i, optopt);
+	    usage(3, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	}
+    }
+    if (argc - optind != REQUIRED_ARGS) {
+	usage(3, program, "wrong number of arguments"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * decode each JSON string
+     */
+    for (t=0; t < TBLLEN(decode_tbl); ++t) {
+	if (decode_chk(&decode_tbl[t]) == false) {
+	    ++failed;
+	}
+    }
+
+    /*
+     * report
+     */
+    if (failed > 0) {
+	warn(__func__, "%ju of %ju JSON string(s) did not decode as expected", failed, (uintmax_t)TBLLEN(decode_tbl));
+	exit(1); /*ooo*/
+    }
+    msg("all %ju JSON string(s) decoded as expected", (uintmax_t)TBLLEN(decode_tbl));
+    exit(0); /*ooo*/
+}
+
+
+/*
+ * decode_chk - parse a JSON string and check what it decodes to
+ *
+ * given:
+ *	test	JSON string and what it must decode to
+ *
+ * returns:
+ *	true ==> the JSON string decoded as expected
+ */
+static bool
+decode_chk(struct decode_case const *test)
+{
+    struct json *tree = NULL;		/* JSON parse tree of the JSON string */
+    struct json_string *item = NULL;	/* the JSON string */
+    bool is_valid = false;		/* true ==> JSON string is valid JSON */
+    bool ok = true;			/* false ==> the JSON string did not decode as expected */
+
+    /*
+     * firewall
+     */
+    if (test == NULL || test->json == NULL || test->str == NULL) {
+	err(10, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * parse the JSON string
+     */
+    tree = parse_json(test->json, strlen(test->json), "decode_tbl", &is_valid);
+    if (tree == NULL || is_valid == false || tree->type != JTYPE_STRING) {
+	warn(__func__, "%s: not parsed as a JSON string", test->json);
+	if (tree != NULL) {
+	    json_tree_free(tree, JSON_INFINITE_DEPTH);
+	    free(tree);
+	}
+	return false;
+    }
+    item = &(tree->item.string);
+
+    /*
+     * check the decoded string and its UTF-8 validity
+     */
+    if (item->converted == false || item->str == NULL) {
+	warn(__func__, "%s: not decoded", test->json);
+	ok = false;
+    } else if (item->str_len != test->str_len || memcmp(item->str, test->str, test->str_len) != 0) {
+	warn(__func__, "%s: decoded to %ju byte(s) that are not the %ju expected",
+		       test->json, (uintmax_t)item->str_len, (uintmax_t)test->str_len);
+	ok = false;
+    } else if (item->utf8 != test->utf8) {
+	warn(__func__, "%s: utf8: %s != expected: %s", test->json, booltostr(item->utf8), booltostr(test->utf8));
+	ok = false;
+    }
+    dbg(DBG_MED, "%s: %s", test->json, ok ? "OK" : "FAILED");
+
+    /*
+     * free the parse tree
+     */
+    json_tree_free(tree, JSON_INFINITE_DEPTH);
+    free(tree);
+    return ok;
+}
+
+
+/*
+ * usage - print usage to stderr
+ *
+ * Example:
+ *      usage(3, program, "wrong number of arguments");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * NOTE: We warn with extra newlines to help internal fault messages stand out.
+ *       Normally one should NOT include newlines in warn messages.
+ *
+ * This function does not return.
+ */
+static void
+usage(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (prog == NULL) {
+	prog = "((NULL prog))";
+	warn(__func__, "\nin usage(): prog was NULL, forcing it to be: %s\n", prog);
+    }
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage(): str was NULL, forcing it to be: %s\n", str);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprint(stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, JSON_DBG_DEFAULT,
+		  DECODE_TEST_VERSION, json_parser_version);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
@@ -44,7 +44,7 @@
 /*
  * official jnum_chk version
  */
-#define JNUM_CHK_VERSION "1.0 2023-02-04"      /* format: major.minor YYYY-MM-DD */
+#define JNUM_CHK_VERSION "1.1 2026-10-16"      /* format: major.minor YYYY-MM-DD */
 
 /*
  * usage message
@@ -97,6 +97,7 @@ main(int argc, char *argv[])
     bool strict = false;	/* true ==> strict testing for all struct integer element */
     struct json *node = NULL;	/* allocated JSON parser tree node */
     struct json_number *item = NULL;	/* JSON parser tree node for a JSON number */
+    struct json_number_expanded expanded;	/* item expanded into every C form */
     size_t len = 0;		/* length of str */
     int arg_count = 0;		/* number of args to process */
     int i;
@@ -178,11 +179,12 @@ main(int argc, char *argv[])
 	    not_reached();
 	}
 	item = &(node->item.number);
+	json_number_expand(item, &expanded);
 
 	/*
 	 * compare conversion with test case
 	 */
-	test = chk_test(i, item, &test_result[i], len, strict);
+	test = chk_test(i, &expanded, &test_result[i], len, strict);
 	if (test == false) {
 	    warn(__func__, "test: chk_test(%d, item, &test_result[%d], %ju, %s) failed",
 			   i, i, (uintmax_t)len, (strict ? "true" : "false"));
@@ -222,8 +224,8 @@ main(int argc, char *argv[])
  *
  * given:
  *	testnum - test number being checked
- *	item	- pointer to struct json converted JSON number
- *	test	- pointer to test suite struct json_number
+ *	item	- pointer to expanded struct json converted JSON number
+ *	test	- pointer to test suite struct json_number_expanded
  *	len	- converted JSON number length
  *	strict	- true ==> compare all struct json_member elements,
  *		  false ==> compare only select struct json_member elements
@@ -234,7 +236,7 @@ main(int argc, char *argv[])
  *		  NULL pointer given, or len was incorrect
  */
 static bool
-chk_test(int testnum, struct json_number *item, struct json_number *test, size_t len, bool strict)
+chk_test(int testnum, struct json_number_expanded *item, struct json_number_expanded *test, size_t len, bool strict)
 {
     bool test_error = false;	/* true ==> check failed */
 
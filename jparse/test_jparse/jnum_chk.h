@@ -59,13 +59,13 @@ static bool quiet = false;				/* true ==> quiet mode */
  */
 extern int const test_count;			/* number of tests to perform */
 extern char *test_set[];			/* test strings */
-extern struct json_number test_result[];	/* struct integer conversions of test strings */
+extern struct json_number_expanded test_result[];	/* struct integer conversions of test strings */
 
 /*
  * function prototypes
  */
 #if !defined(JNUM_TEST)
-static bool chk_test(int testnum, struct json_number *item, struct json_number *test, size_t len, bool strict);
+static bool chk_test(int testnum, struct json_number_expanded *item, struct json_number_expanded *test, size_t len, bool strict);
 static void check_val(bool *testp, char const *type, int testnum, bool size_a, bool size_b, intmax_t val_a, intmax_t val_b);
 static void check_uval(bool *testp, char const *type, int testnum, bool size_a, bool size_b, uintmax_t val_a, uintmax_t val_b);
 static void check_fval(bool *testp, char const *type, int testnum, bool size_a, bool size_b,
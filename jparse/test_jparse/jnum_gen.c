@@ -45,7 +45,7 @@
 /*
  * official jnum_gen version
  */
-#define JNUM_GEN_VERSION "1.0 2023-02-04"	/* format: major.minor YYYY-MM-DD */
+#define JNUM_GEN_VERSION "1.1 2026-10-16"	/* format: major.minor YYYY-MM-DD */
 
 /*
  * usage message
@@ -100,6 +100,7 @@ main(int argc, char *argv[])
     size_t len;			/* length of JSON test number */
     char *first = NULL;		/* start of JSON test number */
     struct json *node = NULL;	/* parsed JSON number */
+    struct json_number_expanded expanded;	/* parsed JSON number expanded into every C form */
     struct dyn_array *str_array = NULL;		/* dynamic array of test strings */
     struct dyn_array *result_array = NULL;	/* dynamic array of test results */
     bool moved = false;		/* true ==> realloc() moved data */
@@ -297,7 +298,7 @@ main(int argc, char *argv[])
     /*
      * output test results
      */
-    prstr("struct json_number test_result[TEST_COUNT+1] = {\n");
+    prstr("struct json_number_expanded test_result[TEST_COUNT+1] = {\n");
     for (i=0; i < count; ++i) {
 
 	/*
@@ -320,7 +321,8 @@ main(int argc, char *argv[])
 		    json_type_name(JTYPE_NUMBER));
 	    not_reached();
 	}
-	fpr_number(stdout, &node->item.number);
+	json_number_expand(&node->item.number, &expanded);
+	fpr_number(stdout, &expanded);
 
 	/*
 	 * print end of json_number structure
@@ -366,16 +368,16 @@ main(int argc, char *argv[])
 
 
 /*
- * fpr_number - print the contents of struct json_number on a stream
+ * fpr_number - print the contents of struct json_number_expanded on a stream
  *
  * given:
  *	stream		open stream to print on
- *	item		pointer to struct json_number to print
+ *	item		pointer to struct json_number_expanded to print
  *
  * This function does not return on error.
  */
 static void
-fpr_number(FILE *stream, struct json_number *item)
+fpr_number(FILE *stream, struct json_number_expanded *item)
 {
     /*
      * firewall
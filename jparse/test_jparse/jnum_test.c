@@ -509,7 +509,7 @@ char *test_set[TEST_COUNT+1] = {
     NULL
 };
 
-struct json_number test_result[TEST_COUNT+1] = {
+struct json_number_expanded test_result[TEST_COUNT+1] = {
     /* test_result[0]: -1e10000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000 */
     {
 	true,		/* true ==> able to parse JSON number string */
@@ -38,13 +38,13 @@
 
 # setup
 #
-export JPARSE_TEST_VERSION="1.0.3 2023-08-01"
+export JPARSE_TEST_VERSION="1.0.9 2026-10-16"
 export CHK_TEST_FILE="./jparse/test_jparse/json_teststr.txt"
 export JPARSE="./jparse/jparse"
 export PRINT_TEST="./jparse/test_jparse/print_test"
 export JSON_TREE="./jparse/test_jparse/test_JSON"
 export SUBDIR="."
-export USAGE="usage: $0 [-h] [-V] [-v level] [-D dbg_level] [-J level] [-q] [-j jparse] [-p print_test] [-d json_tree] [-s subdir] [-k] [-L] [file ..]
+export USAGE="usage: $0 [-h] [-V] [-v level] [-D dbg_level] [-J level] [-q] [-j jparse] [-p print_test] [-d json_tree] [-s subdir] [-k] [-L] [-c | -E | -I | -T] [-B tape_dir] [-P size] [file ..]
 
     -h			print help and exit
     -V			print version and exit
@@ -61,6 +61,14 @@ export USAGE="usage: $0 [-h] [-V] [-v level] [-D dbg_level] [-J level] [-q] [-j
     -s subdir		subdirectory under json_tree to find the good and bad subdirectories (def: $SUBDIR)
     -k			keep temporary files on exit (def: remove temporary files before exiting)
     -L			run error location reporting test
+    -c			run jparse -c: check syntax only, without a scanner or parse tree (def: form a parse tree)
+    -E			run jparse -E: validate with the event parser (def: form a parse tree)
+    -I			run jparse -I: validate with the SIMD structural index (def: form a parse tree)
+    -T			run jparse -T: check that the tape of the parse tree forms the same parse tree (def: no tape)
+    -B tape_dir		run jparse -B tape_dir on JSON files: cache their .jtree tapes in tape_dir (def: no cache)
+			    NOTE: -B cannot be used with -c, -E or -I
+    -P size		run jparse -P size: feed each JSON document to the push parser in pieces of size bytes (def: whole)
+			    NOTE: -P cannot be used with -c, -E, -I or -B
     [file ...]		read JSON documents, one per line, from these files, - means stdin (def: $CHK_TEST_FILE)
 			NOTE: To use stdin, end the command line with: -- -
 
@@ -89,10 +97,13 @@ export PRINT_TEST_FLAG_USED=""
 export PRINT_TEST_FAILURE=""
 export K_FLAG=""
 export L_FLAG=""
+export PARSE_FLAG=""
+export TAPE_DIR=""
+export PUSH_SIZE=""
 
 # parse args
 #
-while getopts :hVv:D:J:qj:p:d:s:kL flag; do
+while getopts :hVv:D:J:qj:p:d:s:kLcEITB:P: flag; do
     case "$flag" in
     h)	echo "$USAGE" 1>&2
 	exit 2
@@ -121,6 +132,18 @@ while getopts :hVv:D:J:qj:p:d:s:kL flag; do
         ;;
     L)  L_FLAG="true";
         ;;
+    c)  PARSE_FLAG="-c";
+        ;;
+    E)  PARSE_FLAG="-E";
+        ;;
+    I)  PARSE_FLAG="-I";
+        ;;
+    T)  PARSE_FLAG="-T";
+        ;;
+    B)  TAPE_DIR="$OPTARG";
+        ;;
+    P)  PUSH_SIZE="$OPTARG";
+        ;;
     \?) echo "$0: ERROR: invalid option: -$OPTARG" 1>&2
 	echo 1>&2
 	echo "$USAGE" 1>&2
@@ -234,6 +257,32 @@ if [[ ! -r $JSON_BAD_TREE ]]; then
     exit 6
 fi
 
+# tape cache directory
+#
+if [[ -n "$TAPE_DIR" ]]; then
+    if [[ $PARSE_FLAG == "-c" || $PARSE_FLAG == "-E" || $PARSE_FLAG == "-I" ]]; then
+	echo "$0: ERROR: -B tape_dir cannot be used with -c, -E or -I" 1>&2
+	exit 3
+    fi
+    if [[ ! -d $TAPE_DIR || ! -w $TAPE_DIR ]]; then
+	echo "$0: ERROR: tape_dir not a writable directory: $TAPE_DIR" 1>&2
+	exit 6
+    fi
+fi
+
+# push parser piece size
+#
+if [[ -n "$PUSH_SIZE" ]]; then
+    if [[ $PARSE_FLAG == "-c" || $PARSE_FLAG == "-E" || $PARSE_FLAG == "-I" || -n "$TAPE_DIR" ]]; then
+	echo "$0: ERROR: -P size cannot be used with -c, -E, -I or -B" 1>&2
+	exit 3
+    fi
+    if [[ ! $PUSH_SIZE =~ ^[1-9][0-9]*$ ]]; then
+	echo "$0: ERROR: -P size must be an integer > 0: $PUSH_SIZE" 1>&2
+	exit 3
+    fi
+fi
+
 # bad location tree
 #
 if [[ -n "$L_FLAG" ]]; then
@@ -346,10 +395,10 @@ run_location_err_test()
     fi
 
     if [[ $V_FLAG -ge 3 ]]; then
-	echo "$0: debug[3]: about to run test that must fail: $JPARSE -- $jparse_test_file >> ${LOGFILE} 2>$TMP_STDERR_FILE" 1>&2
+	echo "$0: debug[3]: about to run test that must fail: $JPARSE ${PUSH_SIZE:+-P $PUSH_SIZE} -- $jparse_test_file >> ${LOGFILE} 2>$TMP_STDERR_FILE" 1>&2
     fi
 
-    "$JPARSE" -- "$jparse_test_file" 2>"$TMP_STDERR_FILE" | tee -a -- "${LOGFILE}"
+    "$JPARSE" ${PUSH_SIZE:+-P "$PUSH_SIZE"} -- "$jparse_test_file" 2>"$TMP_STDERR_FILE" | tee -a -- "${LOGFILE}"
 
     if [[ $V_FLAG -ge 7 ]]; then
 	echo "$0: debug[7]: in run_location_err_test: jparse exit code: $status" 1>&2
@@ -423,16 +472,16 @@ run_file_test()
 
     if [[ -z $quiet_mode ]]; then
 	if [[ $V_FLAG -ge 3 ]]; then
-	    echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -- $json_doc_file >> ${LOGFILE} 2>&1" 1>&2
+	    echo "$0: debug[3]: about to run test that must $pass_fail: $jparse $PARSE_FLAG ${TAPE_DIR:+-B $TAPE_DIR} ${PUSH_SIZE:+-P $PUSH_SIZE} -v $dbg_level -J $json_dbg_level -- $json_doc_file >> ${LOGFILE} 2>&1" 1>&2
 	fi
-	echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -- $json_doc_file >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
-	"$jparse" -v "$dbg_level" -J "$json_dbg_level" -- "$json_doc_file" >> "${LOGFILE}" 2>&1
+	echo "$0: debug[3]: about to run test that must $pass_fail: $jparse $PARSE_FLAG ${TAPE_DIR:+-B $TAPE_DIR} ${PUSH_SIZE:+-P $PUSH_SIZE} -v $dbg_level -J $json_dbg_level -- $json_doc_file >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
+	"$jparse" ${PARSE_FLAG:+"$PARSE_FLAG"} ${TAPE_DIR:+-B "$TAPE_DIR"} ${PUSH_SIZE:+-P "$PUSH_SIZE"} -v "$dbg_level" -J "$json_dbg_level" -- "$json_doc_file" >> "${LOGFILE}" 2>&1
     else
 	if [[ $V_FLAG -ge 3 ]]; then
-	    echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -q -- $json_doc_file >> ${LOGFILE} 2>&1" 1>&2
+	    echo "$0: debug[3]: about to run test that must $pass_fail: $jparse $PARSE_FLAG ${TAPE_DIR:+-B $TAPE_DIR} ${PUSH_SIZE:+-P $PUSH_SIZE} -v $dbg_level -J $json_dbg_level -q -- $json_doc_file >> ${LOGFILE} 2>&1" 1>&2
 	fi
-	echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -q -- $json_doc_file >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
-	"$jparse" -v "$dbg_level" -J "$json_dbg_level" -q -- "$json_doc_file" >> "${LOGFILE}" 2>&1
+	echo "$0: debug[3]: about to run test that must $pass_fail: $jparse $PARSE_FLAG ${TAPE_DIR:+-B $TAPE_DIR} ${PUSH_SIZE:+-P $PUSH_SIZE} -v $dbg_level -J $json_dbg_level -q -- $json_doc_file >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
+	"$jparse" ${PARSE_FLAG:+"$PARSE_FLAG"} ${TAPE_DIR:+-B "$TAPE_DIR"} ${PUSH_SIZE:+-P "$PUSH_SIZE"} -v "$dbg_level" -J "$json_dbg_level" -q -- "$json_doc_file" >> "${LOGFILE}" 2>&1
     fi
     status="$?"
 
@@ -586,16 +635,16 @@ run_string_test()
 
     if [[ -z $quiet_mode ]]; then
 	if [[ $V_FLAG -ge 3 ]]; then
-	    echo "$0: debug[3]: about to run: $jparse -v $dbg_level -J $json_dbg_level -s -- $json_doc_string >> ${LOGFILE} 2>&1" 1>&2
+	    echo "$0: debug[3]: about to run: $jparse $PARSE_FLAG ${PUSH_SIZE:+-P $PUSH_SIZE} -v $dbg_level -J $json_dbg_level -s -- $json_doc_string >> ${LOGFILE} 2>&1" 1>&2
 	fi
-	echo "$0: debug[3]: about to run: $jparse -v $dbg_level -J $json_dbg_level -s -- $json_doc_string >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
-	"$jparse" -v "$dbg_level" -J "$json_dbg_level" -s -- "$json_doc_string" >> "${LOGFILE}" 2>&1
+	echo "$0: debug[3]: about to run: $jparse $PARSE_FLAG ${PUSH_SIZE:+-P $PUSH_SIZE} -v $dbg_level -J $json_dbg_level -s -- $json_doc_string >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
+	"$jparse" ${PARSE_FLAG:+"$PARSE_FLAG"} ${PUSH_SIZE:+-P "$PUSH_SIZE"} -v "$dbg_level" -J "$json_dbg_level" -s -- "$json_doc_string" >> "${LOGFILE}" 2>&1
     else
 	if [[ $V_FLAG -ge 3 ]]; then
-	    echo "$0: debug[3]: about to run: $jparse -v $dbg_level -J $json_dbg_level -q -s -- $json_doc_string >> ${LOGFILE} 2>&1" 1>&2
+	    echo "$0: debug[3]: about to run: $jparse $PARSE_FLAG ${PUSH_SIZE:+-P $PUSH_SIZE} -v $dbg_level -J $json_dbg_level -q -s -- $json_doc_string >> ${LOGFILE} 2>&1" 1>&2
 	fi
-	echo "$0: debug[3]: about to run: $jparse -v $dbg_level -J $json_dbg_level -q -s -- $json_doc_string >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
-	"$jparse" -v "$dbg_level" -J "$json_dbg_level" -q -s -- "$json_doc_string" >> "${LOGFILE}" 2>&1
+	echo "$0: debug[3]: about to run: $jparse $PARSE_FLAG ${PUSH_SIZE:+-P $PUSH_SIZE} -v $dbg_level -J $json_dbg_level -q -s -- $json_doc_string >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
+	"$jparse" ${PARSE_FLAG:+"$PARSE_FLAG"} ${PUSH_SIZE:+-P "$PUSH_SIZE"} -v "$dbg_level" -J "$json_dbg_level" -q -s -- "$json_doc_string" >> "${LOGFILE}" 2>&1
     fi
     status="$?"
 
@@ -0,0 +1,512 @@
+/*
+ * sem_match_test - test that a compiled JSON semantic table match finds what the table finds
+ *
+ * The JSON semantic table sem_test, and its compiled match sem_test_match(),
+ * are generated by jsemtblgen -C (see the sem_test.c and sem_test.h rules of
+ * the Makefile).  Each JSON file given is checked by json_sem_check() and by
+ * json_sem_check_match(): both must find the same JSON semantic count and
+ * validation errors.  A check by json_sem_check_opt() on worker threads must
+ * also find the same errors, and a fail-fast check must find the same first
+ * error on worker threads as on a single thread.
+ *
+ * "Because a switch should know what the table knows." :-)
+ *
+ * This JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * jparse - JSON parser
+ */
+#include "../jparse.h"
+
+/*
+ * sem_test - JSON semantic table and its compiled match, generated by jsemtblgen
+ */
+#include "sem_test.h"
+
+
+/*
+ * official sem_match_test version
+ */
+#define SEM_MATCH_TEST_VERSION "1.1.0 2026-10-16"	/* format: major.minor YYYY-MM-DD */
+
+/*
+ * definitions
+ */
+#define REQUIRED_ARGS (1)	/* number of required arguments on the command line */
+#define TEST_THREADS (4)	/* worker threads of the parallel checks */
+
+
+/*
+ * forward declarations
+ */
+static bool same_str(char const *a, char const *b);
+static bool same_errors(char const *file, struct dyn_array *count_a, struct dyn_array *count_b,
+			struct dyn_array *val_a, struct dyn_array *val_b);
+static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+/*
+ * usage message
+ *
+ * Use the usage() function to print the usage_msg([0-9]?)+ strings.
+ */
+static const char * const usage_msg =
+    "usage: %s [-h] [-v level] [-J level] [-V] file.json ...\n"
+    "\n"
+    "\t-h\t\tPrint help message and exit\n"
+    "\t-v level\tSet verbosity level (def level: %d)\n"
+    "\t-J level\tSet JSON verbosity level (def level: %d)\n"
+    "\t-V\t\tPrint version string and exit\n"
+    "\n"
+    "\tfile.json\tJSON file to check against the sem_test JSON semantic table\n"
+    "\n"
+    "Exit codes:\n"
+    "\t0\t\tthe compiled match and the parallel checks found what the table found for every file\n"
+    "\t1\t\tthe compiled match or a parallel check found different errors\n"
+    "\t2\t\t-h and help string printed or -V and version string printed\n"
+    "\t3\t\tcommand line error\n"
+    "\t>=10\t\tinternal error\n"
+    "\n"
+    "sem_match_test version: %s\n"
+    "JSON parser version: %s";
+
+
+int
+main(int argc, char *argv[])
+{
+    char const *program = NULL;		/* our name */
+    extern char *optarg;		/* option argument */
+    extern int optind;			/* argv index of the next arg */
+    struct json *tree = NULL;		/* JSON parse tree */
+    bool is_valid = false;		/* true ==> file is valid JSON */
+    struct dyn_array *count_tbl = NULL;	/* JSON semantic count errors found with the table */
+    struct dyn_array *val_tbl = NULL;	/* JSON semantic validation errors found with the table */
+    struct dyn_array *count_match = NULL;	/* JSON semantic count errors found with the compiled match */
+    struct dyn_array *val_match = NULL;	/* JSON semantic validation errors found with the compiled match */
+    uintmax_t errors_tbl = 0;		/* json_sem_check() return value */
+    uintmax_t errors_match = 0;		/* json_sem_check_match() return value */
+    struct json_sem_opt opt;		/* how json_sem_check_opt() checks */
+    struct dyn_array *count_par = NULL;	/* JSON semantic count errors found on worker threads */
+    struct dyn_array *val_par = NULL;	/* JSON semantic validation errors found on worker threads */
+    struct dyn_array *count_ff = NULL;	/* JSON semantic count errors found by fail-fast */
+    struct dyn_array *val_ff = NULL;	/* JSON semantic validation errors found by fail-fast */
+    struct dyn_array *count_ff_par = NULL;	/* JSON semantic count errors found by fail-fast on worker threads */
+    struct dyn_array *val_ff_par = NULL;	/* JSON semantic validation errors found by fail-fast on worker threads */
+    uintmax_t errors_par = 0;		/* json_sem_check_opt() return value on worker threads */
+    uintmax_t errors_ff = 0;		/* json_sem_check_opt() return value with fail-fast */
+    uintmax_t errors_ff_par = 0;	/* json_sem_check_opt() return value with fail-fast on worker threads */
+    uintmax_t checked = 0;		/* number of files checked */
+    uintmax_t mismatched = 0;		/* number of files where the errors were not the same */
+    int i;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:J:V")) != -1) {
+	switch (i) {
+	case 'h':		/* -h - print help to stderr and exit 0 */
+	    usage(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':		/* -v verbosity */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'J':		/* -J json_verbosity */
+	    json_verbosity_level = parse_verbosity(optarg);
+	    if (json_verbosity_level < 0) {
+		usage(3, program, "invalid -J json_verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':		/* -V - print version and exit */
+	    print("%s\n", SEM_MATCH_TEST_VERSION);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case ':':   /* option requires an argument */
+	case '?':   /* illegal option */
+	default:    /* anything else but should not actually happen */
+	    check_invalid_option(program, i, optopt);
+	    usage(3, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	}
+    }
+    if (argc - optind < REQUIRED_ARGS) {
+	usage(3, program, "wrong number of arguments"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * check each file both ways
+     */
+    for (i=optind; i < argc; ++i) {
+
+	/*
+	 * parse the file, skipping files that are not valid JSON
+	 */
+	tree = parse_json_file(argv[i], &is_valid);
+	if (tree == NULL || is_valid == false) {
+	    dbg(DBG_MED, "skipping invalid JSON file: %s", argv[i]);
+	    if (tree != NULL) {
+		json_tree_free(tree, JSON_INFINITE_DEPTH);
+		free(tree);
+		tree = NULL;
+	    }
+	    continue;
+	}
+
+	/*
+	 * check with the table and with the compiled match
+	 */
+	count_tbl = NULL;
+	val_tbl = NULL;
+	count_match = NULL;
+	val_match = NULL;
+	errors_tbl = json_sem_check(tree, JSON_DEFAULT_MAX_DEPTH, sem_test, &count_tbl, &val_tbl);
+	errors_match = json_sem_check_match(tree, JSON_DEFAULT_MAX_DEPTH, sem_test, sem_test_match,
+					    &count_match, &val_match);
+	if (count_tbl == NULL || val_tbl == NULL || count_match == NULL || val_match == NULL) {
+	    err(10, __func__, "JSON semantic check left an error array NULL for: %s", argv[i]);
+	    not_reached();
+	}
+	++checked;
+	dbg(DBG_MED, "%s: %ju error(s)", argv[i], errors_tbl);
+
+	/*
+	 * both ways must find the same errors
+	 */
+	if (errors_tbl != errors_match ||
+	    !same_errors(argv[i], count_tbl, count_match, val_tbl, val_match)) {
+	    warn(__func__, "%s: json_sem_check() found %ju error(s), json_sem_check_match() found %ju",
+			   argv[i], errors_tbl, errors_match);
+	    ++mismatched;
+	}
+
+	/*
+	 * check on worker threads, giving each as few as one node so that even small files are split
+	 */
+	count_par = NULL;
+	val_par = NULL;
+	count_ff = NULL;
+	val_ff = NULL;
+	count_ff_par = NULL;
+	val_ff_par = NULL;
+	opt.fail_fast = false;
+	opt.threads = TEST_THREADS;
+	opt.min_nodes = 1;
+	errors_par = json_sem_check_opt(tree, JSON_DEFAULT_MAX_DEPTH, sem_test, NULL, &opt, &count_par, &val_par);
+	opt.fail_fast = true;
+	opt.threads = 1;
+	errors_ff = json_sem_check_opt(tree, JSON_DEFAULT_MAX_DEPTH, sem_test, NULL, &opt, &count_ff, &val_ff);
+	opt.threads = TEST_THREADS;
+	errors_ff_par = json_sem_check_opt(tree, JSON_DEFAULT_MAX_DEPTH, sem_test, sem_test_match, &opt,
+					   &count_ff_par, &val_ff_par);
+	if (count_par == NULL || val_par == NULL || count_ff == NULL || val_ff == NULL ||
+	    count_ff_par == NULL || val_ff_par == NULL) {
+	    err(12, __func__, "JSON semantic check with options left an error array NULL for: %s", argv[i]);
+	    not_reached();
+	}
+
+	/*
+	 * the parallel check must find the same errors, and fail-fast must find an error when there is one
+	 */
+	if (errors_tbl != errors_par ||
+	    !same_errors(argv[i], count_tbl, count_par, val_tbl, val_par)) {
+	    warn(__func__, "%s: json_sem_check() found %ju error(s), %d worker threads found %ju",
+			   argv[i], errors_tbl, TEST_THREADS, errors_par);
+	    ++mismatched;
+	}
+	if ((errors_ff == 0) != (errors_tbl == 0) || errors_ff > errors_tbl ||
+	    errors_ff != errors_ff_par ||
+	    !same_errors(argv[i], count_ff, count_ff_par, val_ff, val_ff_par)) {
+	    warn(__func__, "%s: json_sem_check() found %ju error(s), fail-fast found %ju, "
+			   "fail-fast on %d worker threads found %ju",
+			   argv[i], errors_tbl, errors_ff, TEST_THREADS, errors_ff_par);
+	    ++mismatched;
+	}
+
+	/*
+	 * free the errors and the parse tree
+	 */
+	free_count_err(count_tbl);
+	free_val_err(val_tbl);
+	free_count_err(count_match);
+	free_val_err(val_match);
+	free_count_err(count_par);
+	free_val_err(val_par);
+	free_count_err(count_ff);
+	free_val_err(val_ff);
+	free_count_err(count_ff_par);
+	free_val_err(val_ff_par);
+	json_tree_free(tree, JSON_INFINITE_DEPTH);
+	free(tree);
+	tree = NULL;
+    }
+
+    /*
+     * report
+     */
+    if (checked == 0) {
+	err(11, __func__, "no valid JSON file was checked");
+	not_reached();
+    }
+    if (mismatched > 0) {
+	warn(__func__, "%ju of %ju file(s) had different errors", mismatched, checked);
+	exit(1); /*ooo*/
+    }
+    msg("the compiled match and the parallel checks found what the table found for %ju file(s)", checked);
+    exit(0); /*ooo*/
+}
+
+
+/*
+ * sem_test_member - JSON semantic check for each JSON member
+ *
+ * A member whose name has an odd length is not valid, so that both ways
+ * report some JSON semantic validation errors.
+ *
+ * given:
+ *	node	JSON parse node being checked
+ *	depth	depth of node in the JSON parse tree (0 ==> tree root)
+ *	sem	JSON semantic node triggering the check
+ *	val_err	pointer to address where to place a JSON semantic validation error,
+ *		NULL ==> do not report a JSON semantic validation error
+ *
+ * returns:
+ *	true ==> JSON element is valid
+ *	false ==> JSON element is NOT valid, or NULL pointer, or some internal error
+ */
+bool
+sem_test_member(struct json const *node,
+		unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
+{
+    char *name = NULL;				/* JTYPE_MEMBER name as decoded JSON string */
+
+    /*
+     * firewall - args and decoded name check
+     */
+    name = sem_member_name_decoded_str(node, depth, sem, __func__, val_err);
+    if (name == NULL) {
+	/* sem_member_name_decoded_str() will have set *val_err */
+	return false;
+    }
+
+    /*
+     * validate decoded JSON name
+     */
+    if (strlen(name) % 2 != 0) {
+	if (val_err != NULL) {
+	    *val_err = werr_sem_val(12, node, depth, sem, __func__, "name has an odd length: %s", name);
+	}
+	return false;
+    }
+
+    /*
+     * return validation success
+     */
+    if (val_err != NULL) {
+	*val_err = NULL;
+    }
+    return true;
+}
+
+
+/*
+ * sem_test_string - JSON semantic check for each JSON string that is not a member name
+ *
+ * An empty string is not valid.
+ *
+ * given:
+ *	node	JSON parse node being checked
+ *	depth	depth of node in the JSON parse tree (0 ==> tree root)
+ *	sem	JSON semantic node triggering the check
+ *	val_err	pointer to address where to place a JSON semantic validation error,
+ *		NULL ==> do not report a JSON semantic validation error
+ *
+ * returns:
+ *	true ==> JSON element is valid
+ *	false ==> JSON element is NOT valid, or NULL pointer, or some internal error
+ */
+bool
+sem_test_string(struct json const *node,
+		unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
+{
+    /*
+     * firewall - args
+     */
+    if (!sem_chk_null_args(node, depth, sem, __func__, val_err)) {
+	/* sem_chk_null_args() will have set *val_err */
+	return false;
+    }
+
+    /*
+     * validate JSON string
+     */
+    if (node->type != JTYPE_STRING || node->item.string.str_len == 0) {
+	if (val_err != NULL) {
+	    *val_err = werr_sem_val(13, node, depth, sem, __func__, "not a non-empty JSON string");
+	}
+	return false;
+    }
+
+    /*
+     * return validation success
+     */
+    if (val_err != NULL) {
+	*val_err = NULL;
+    }
+    return true;
+}
+
+
+/*
+ * same_str - report if two strings, either of which may be NULL, are the same
+ *
+ * given:
+ *	a	first string or NULL
+ *	b	second string or NULL
+ *
+ * returns:
+ *	true ==> both are NULL, or neither is NULL and the strings are the same
+ */
+static bool
+same_str(char const *a, char const *b)
+{
+    if (a == NULL || b == NULL) {
+	return a == b;
+    }
+    return strcmp(a, b) == 0;
+}
+
+
+/*
+ * same_errors - report if two checks found the same errors
+ *
+ * given:
+ *	file		JSON file that was checked
+ *	count_a		JSON semantic count errors found by the first check
+ *	count_b		JSON semantic count errors found by the second check
+ *	val_a		JSON semantic validation errors found by the first check
+ *	val_b		JSON semantic validation errors found by the second check
+ *
+ * returns:
+ *	true ==> same errors, in the same order
+ */
+static bool
+same_errors(char const *file, struct dyn_array *count_a, struct dyn_array *count_b,
+	    struct dyn_array *val_a, struct dyn_array *val_b)
+{
+    struct json_sem_count_err *ca = NULL;	/* JSON semantic count error found by the first check */
+    struct json_sem_count_err *cb = NULL;	/* JSON semantic count error found by the second check */
+    struct json_sem_val_err *va = NULL;		/* JSON semantic validation error found by the first check */
+    struct json_sem_val_err *vb = NULL;		/* JSON semantic validation error found by the second check */
+    intmax_t i;
+
+    /*
+     * compare JSON semantic count errors
+     */
+    if (dyn_array_tell(count_a) != dyn_array_tell(count_b)) {
+	dbg(DBG_LOW, "%s: %jd count error(s) != %jd", file, dyn_array_tell(count_a), dyn_array_tell(count_b));
+	return false;
+    }
+    for (i=0; i < dyn_array_tell(count_a); ++i) {
+	ca = dyn_array_addr(count_a, struct json_sem_count_err, i);
+	cb = dyn_array_addr(count_b, struct json_sem_count_err, i);
+	if (ca->node != cb->node || ca->sem != cb->sem || ca->count != cb->count ||
+	    ca->bad_min != cb->bad_min || ca->bad_max != cb->bad_max ||
+	    ca->unknown_node != cb->unknown_node || ca->sem_index != cb->sem_index ||
+	    !same_str(ca->diagnostic, cb->diagnostic)) {
+	    dbg(DBG_LOW, "%s: count error %jd differs", file, i);
+	    return false;
+	}
+    }
+
+    /*
+     * compare JSON semantic validation errors
+     */
+    if (dyn_array_tell(val_a) != dyn_array_tell(val_b)) {
+	dbg(DBG_LOW, "%s: %jd validation error(s) != %jd", file, dyn_array_tell(val_a), dyn_array_tell(val_b));
+	return false;
+    }
+    for (i=0; i < dyn_array_tell(val_a); ++i) {
+	va = dyn_array_addr(val_a, struct json_sem_val_err, i);
+	vb = dyn_array_addr(val_b, struct json_sem_val_err, i);
+	if (va->node != vb->node || va->depth != vb->depth || va->sem != vb->sem ||
+	    va->sem_index != vb->sem_index || !same_str(va->diagnostic, vb->diagnostic)) {
+	    dbg(DBG_LOW, "%s: validation error %jd differs", file, i);
+	    return false;
+	}
+    }
+    return true;
+}
+
+
+/*
+ * usage - print usage to stderr
+ *
+ * Example:
+ *      usage(3, program, "wrong number of arguments");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * NOTE: We warn with extra newlines to help internal fault messages stand out.
+ *       Normally one should NOT include newlines in warn messages.
+ *
+ * This function does not return.
+ */
+static void
+usage(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (prog == NULL) {
+	prog = "((NULL prog))";
+	warn(__func__, "\nin usage(): prog was NULL, forcing it to be: %s\n", prog);
+    }
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage(): str was NULL, forcing it to be: %s\n", str);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprint(stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, JSON_DBG_DEFAULT,
+		  SEM_MATCH_TEST_VERSION, json_parser_version);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
@@ -0,0 +1,30 @@
+/*
+ * sem_test - JSON semantic table and compiled match for sem_match_test
+ *
+ * "Because a switch should know what the table knows." :-)
+ *
+ * This file was auto-generated by:
+ *
+ *	make sem_test.c
+ *
+ * The JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/*
+ * sem_test - JSON semantic table and compiled match for sem_match_test
+ */
+#include "sem_test.h"
+
+
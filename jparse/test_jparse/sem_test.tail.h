@@ -0,0 +1,3 @@
+
+
+#endif /* INCLUDE_SEM_TEST_H */
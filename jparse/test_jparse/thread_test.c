@@ -0,0 +1,650 @@
+/*
+ * thread_test - stress test parsing and semantic checks on many threads at once
+ *
+ * Every thread parses the same JSON documents, in all of the ways the JSON
+ * parser can parse a block of memory, and checks each JSON parse tree against
+ * the same JSON semantic table.  Each result must be the same as the result of
+ * the same work done before any thread was started.
+ *
+ * Build this test with -fsanitize=thread (see the thread_test_tsan rule of
+ * the Makefile) to have ThreadSanitizer check that nothing is shared by
+ * parses and semantic checks running at the same time.
+ *
+ * "Because two parses should never have to agree on anything." :-)
+ *
+ * This JSON parser was co-developed in 2022 by:
+ *
+ *	@xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/*
+ * jparse - JSON parser
+ */
+#include "../jparse.h"
+
+
+/*
+ * official thread_test version
+ */
+#define THREAD_TEST_VERSION "1.0.0 2026-10-16"	/* format: major.minor YYYY-MM-DD */
+
+/*
+ * definitions
+ */
+#define REQUIRED_ARGS (0)	/* number of required arguments on the command line */
+#define DEF_THREADS (8)		/* default number of threads */
+#define DEF_ROUNDS (200)	/* default number of rounds each thread does */
+#define MAX_THREADS (256)	/* most threads that may be started */
+#define PARSE_WAYS (4)		/* parse_json(), parse_json_buf(), parse_json_arena(), parse_json_arena_ref() */
+
+
+/*
+ * the JSON documents every thread parses
+ *
+ * The top level JSON object of each document has enough members to be indexed
+ * by json_object_find_member().  The second document is valid JSON that does
+ * not match the JSON semantic table.
+ */
+static char const * const doc[] = {
+    "{\"name\":\"thread test\",\"version\":3,\"ratio\":0.25,\"ok\":true,\"none\":null,"
+    "\"tags\":[\"a\",\"b\\n\",\"\\u00e9\"],\"items\":[{\"id\":1,\"label\":\"one\"},{\"id\":2,\"label\":\"two\"}],"
+    "\"m00\":0,\"m01\":1,\"m02\":2,\"m03\":3,\"m04\":4,\"m05\":5,\"m06\":6,\"m07\":7,\"m08\":8,\"m09\":9,"
+    "\"m10\":10,\"m11\":11,\"m12\":12}\n",
+
+    "{\"name\":\"another test\",\"version\":3,\"ratio\":0.25,\"none\":null,\"extra\":false,"
+    "\"tags\":[\"a\",\"b\\n\",\"\\u00e9\"],\"items\":[{\"id\":1,\"label\":\"one\"},{\"id\":2}],"
+    "\"m00\":0,\"m01\":1,\"m02\":2,\"m03\":3,\"m04\":4,\"m05\":5,\"m06\":6,\"m07\":7,\"m08\":8,\"m09\":9,"
+    "\"m10\":10,\"m11\":11,\"m12\":12,\"m12\":12}\n",
+};
+#define DOC_COUNT (sizeof(doc)/sizeof(doc[0]))	/* number of JSON documents */
+
+
+/*
+ * result - what parsing a JSON document and checking it found
+ */
+struct result
+{
+    bool is_valid;		/* true ==> document is valid JSON */
+    uintmax_t sem_errors;	/* json_sem_check() return value */
+    intmax_t count_errors;	/* number of JSON semantic count errors */
+    intmax_t val_errors;	/* number of JSON semantic validation errors */
+    uintmax_t events;		/* number of JSON events */
+    bool has_name;		/* true ==> json_object_find_member() found the "name" member */
+    bool has_dup;		/* true ==> json_object_find_dup() found a duplicate member */
+};
+
+
+/*
+ * state of a thread
+ */
+struct thread
+{
+    pthread_t thread;		/* the thread */
+    unsigned int id;		/* thread number */
+    unsigned int rounds;	/* number of rounds to do */
+    uintmax_t checked;		/* number of results checked */
+    uintmax_t mismatched;	/* number of results that were not the expected result */
+};
+
+
+/*
+ * forward declarations
+ */
+static bool chk_name(struct json const *node,
+		     unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err);
+static bool count_event(struct json_event const *event, void *ctx);
+static void check_doc(size_t n, int way, struct json_arena *arena, struct result *res);
+static bool same_result(struct result const *a, struct result const *b);
+static void *run_thread(void *arg);
+static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+/*
+ * the JSON semantic table every thread checks against
+ *
+ * This was formed by jsemtblgen from the first JSON document.
+ */
+static struct json_sem sem_tbl[] = {
+/* depth    type        min     max   count   index  name_len validate  name */
+  { 5,	JTYPE_NUMBER,	1,	2,	2,	0,	0,	NULL,	NULL },
+  { 5,	JTYPE_STRING,	1,	6,	6,	1,	0,	NULL,	NULL },
+  { 4,	JTYPE_MEMBER,	1,	2,	2,	2,	2,	NULL,	"id" },
+  { 4,	JTYPE_MEMBER,	1,	2,	2,	3,	5,	NULL,	"label" },
+  { 3,	JTYPE_STRING,	1,	3,	3,	4,	0,	NULL,	NULL },
+  { 3,	JTYPE_OBJECT,	1,	2,	2,	5,	0,	NULL,	NULL },
+  { 2,	JTYPE_NUMBER,	1,	15,	15,	6,	0,	NULL,	NULL },
+  { 2,	JTYPE_STRING,	1,	21,	21,	7,	0,	NULL,	NULL },
+  { 2,	JTYPE_BOOL,	1,	1,	1,	8,	0,	NULL,	NULL },
+  { 2,	JTYPE_NULL,	1,	1,	1,	9,	0,	NULL,	NULL },
+  { 2,	JTYPE_ARRAY,	1,	2,	2,	10,	0,	NULL,	NULL },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	11,	5,	NULL,	"items" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	12,	3,	NULL,	"m00" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	13,	3,	NULL,	"m01" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	14,	3,	NULL,	"m02" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	15,	3,	NULL,	"m03" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	16,	3,	NULL,	"m04" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	17,	3,	NULL,	"m05" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	18,	3,	NULL,	"m06" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	19,	3,	NULL,	"m07" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	20,	3,	NULL,	"m08" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	21,	3,	NULL,	"m09" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	22,	3,	NULL,	"m10" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	23,	3,	NULL,	"m11" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	24,	3,	NULL,	"m12" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	25,	4,	chk_name,	"name" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	26,	4,	NULL,	"none" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	27,	2,	NULL,	"ok" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	28,	5,	NULL,	"ratio" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	29,	4,	NULL,	"tags" },
+  { 1,	JTYPE_MEMBER,	1,	1,	1,	30,	7,	NULL,	"version" },
+  { 0,	JTYPE_OBJECT,	1,	1,	1,	31,	0,	NULL,	NULL },
+  { 0,	JTYPE_UNSET,	0,	0,	0,	-1,	0,	NULL,	NULL }
+};
+
+
+/*
+ * usage message
+ *
+ * Use the usage() function to print the usage_msg([0-9]?)+ strings.
+ */
+static const char * const usage_msg =
+    "usage: %s [-h] [-v level] [-J level] [-V] [-t threads] [-r rounds]\n"
+    "\n"
+    "\t-h\t\tPrint help message and exit\n"
+    "\t-v level\tSet verbosity level (def level: %d)\n"
+    "\t-J level\tSet JSON verbosity level (def level: %d)\n"
+    "\t-V\t\tPrint version string and exit\n"
+    "\t-t threads\tNumber of threads to start (def: %d, max: %d)\n"
+    "\t-r rounds\tNumber of rounds each thread does (def: %d)\n"
+    "\n"
+    "Exit codes:\n"
+    "\t0\t\tevery thread found the expected results\n"
+    "\t1\t\ta thread found a result that was not expected\n"
+    "\t2\t\t-h and help string printed or -V and version string printed\n"
+    "\t3\t\tcommand line error\n"
+    "\t>=10\t\tinternal error\n"
+    "\n"
+    "thread_test version: %s\n"
+    "JSON parser version: %s";
+
+
+/*
+ * the expected result of each way of parsing each JSON document
+ *
+ * NOTE: This is set before any thread is started and only read by the threads.
+ */
+static struct result expected[DOC_COUNT][PARSE_WAYS];
+
+
+int
+main(int argc, char *argv[])
+{
+    char const *program = NULL;		/* our name */
+    extern char *optarg;		/* option argument */
+    extern int optind;			/* argv index of the next arg */
+    struct thread *threads = NULL;	/* state of each thread */
+    struct json_arena *arena = NULL;	/* arena for the expected results */
+    intmax_t nthreads = DEF_THREADS;	/* number of threads to start */
+    intmax_t rounds = DEF_ROUNDS;	/* number of rounds each thread does */
+    uintmax_t checked = 0;		/* number of results checked */
+    uintmax_t mismatched = 0;		/* number of results that were not the expected result */
+    int arg_count = 0;			/* number of args to process */
+    int ret = 0;			/* pthread function return value */
+    size_t n = 0;
+    int i;
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:J:Vt:r:")) != -1) {
+	switch (i) {
+	case 'h':		/* -h - print help to stderr and exit 0 */
+	    usage(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':		/* -v verbosity */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'J':		/* -J json_verbosity */
+	    json_verbosity_level = parse_verbosity(optarg);
+	    if (json_verbosity_level < 0) {
+		usage(3, program, "invalid -J json_verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':		/* -V - print version and exit */
+	    print("%s\n", THREAD_TEST_VERSION);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case 't':		/* -t threads */
+	    if (!string_to_intmax(optarg, &nthreads) || nthreads < 1 || nthreads > MAX_THREADS) {
+		usage(3, program, "invalid -t threads"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'r':		/* -r rounds */
+	    if (!string_to_intmax(optarg, &rounds) || rounds < 1 || rounds > INT_MAX) {
+		usage(3, program, "invalid -r rounds"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case ':':   /* option requires an argument */
+	case '?':   /* illegal option */
+	default:    /* anything else but should not actually happen */
+	    check_invalid_option(program, i, optopt);
+	    usage(3, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	}
+    }
+    arg_count = argc - optind;
+    if (arg_count != REQUIRED_ARGS) {
+	usage(3, program, "wrong number of arguments"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * find the expected results before any thread is started
+     */
+    arena = json_arena_create(0);
+    for (n=0; n < DOC_COUNT; ++n) {
+	for (i=0; i < PARSE_WAYS; ++i) {
+	    check_doc(n, i, arena, &expected[n][i]);
+	    json_arena_reset(arena);
+	    dbg(DBG_MED, "doc[%zu] way %d: valid: %s sem errors: %ju events: %ju",
+			 n, i, booltostr(expected[n][i].is_valid), expected[n][i].sem_errors,
+			 expected[n][i].events);
+	}
+    }
+    json_arena_free(arena);
+    arena = NULL;
+
+    /*
+     * firewall - the expected results must be what this test expects of them
+     */
+    if (expected[0][0].is_valid == false || expected[0][0].sem_errors != 0 || expected[0][0].has_dup == true) {
+	err(10, __func__, "doc[0] is not a valid JSON document that matches the JSON semantic table");
+	not_reached();
+    }
+    if (expected[1][0].is_valid == false || expected[1][0].count_errors == 0 || expected[1][0].val_errors == 0 ||
+	expected[1][0].has_dup == false) {
+	err(11, __func__, "doc[1] is not a valid JSON document with JSON semantic count and validation errors");
+	not_reached();
+    }
+
+    /*
+     * start the threads
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    threads = calloc((size_t)nthreads, sizeof(threads[0]));
+    if (threads == NULL) {
+	errp(12, __func__, "calloc of %jd threads failed", nthreads);
+	not_reached();
+    }
+    for (i=0; i < nthreads; ++i) {
+	threads[i].id = (unsigned int)i;
+	threads[i].rounds = (unsigned int)rounds;
+	ret = pthread_create(&threads[i].thread, NULL, run_thread, &threads[i]);
+	if (ret != 0) {
+	    errno = ret;
+	    errp(13, __func__, "pthread_create of thread %d failed", i);
+	    not_reached();
+	}
+    }
+
+    /*
+     * wait for the threads and collect their results
+     */
+    for (i=0; i < nthreads; ++i) {
+	ret = pthread_join(threads[i].thread, NULL);
+	if (ret != 0) {
+	    errno = ret;
+	    errp(14, __func__, "pthread_join of thread %d failed", i);
+	    not_reached();
+	}
+	checked += threads[i].checked;
+	mismatched += threads[i].mismatched;
+    }
+    free(threads);
+    threads = NULL;
+
+    /*
+     * report
+     */
+    dbg(DBG_LOW, "%jd threads checked %ju results, %ju not as expected", nthreads, checked, mismatched);
+    if (mismatched > 0) {
+	warn(__func__, "%ju of %ju results were not as expected", mismatched, checked);
+	exit(1); /*ooo*/
+    }
+    exit(0); /*ooo*/
+}
+
+
+/*
+ * chk_name - JSON semantic check for name
+ *
+ * given:
+ *	node	JSON parse node being checked
+ *	depth	depth of node in the JSON parse tree (0 ==> tree root)
+ *	sem	JSON semantic node triggering the check
+ *	val_err	pointer to address where to place a JSON semantic validation error,
+ *		NULL ==> do not report a JSON semantic validation error
+ *
+ * returns:
+ *	true ==> JSON element is valid
+ *	false ==> JSON element is NOT valid, or NULL pointer, or some internal error
+ */
+static bool
+chk_name(struct json const *node,
+	 unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
+{
+    char *str = NULL;				/* JTYPE_STRING as decoded JSON string */
+
+    /*
+     * firewall - args and decoded string check
+     */
+    str = sem_member_value_decoded_str(node, depth, sem, __func__, val_err);
+    if (str == NULL) {
+	/* sem_member_value_decoded_str() will have set *val_err */
+	return false;
+    }
+
+    /*
+     * validate decoded JSON string
+     */
+    if (strcmp(str, "thread test") != 0) {
+	if (val_err != NULL) {
+	    *val_err = werr_sem_val(15, node, depth, sem, __func__, "invalid name");
+	}
+	return false;
+    }
+
+    /*
+     * return validation success
+     */
+    if (val_err != NULL) {
+	*val_err = NULL;
+    }
+    return true;
+}
+
+
+/*
+ * count_event - count a JSON event
+ *
+ * given:
+ *	event	JSON event
+ *	ctx	uintmax_t * to the count of JSON events
+ *
+ * returns:
+ *	true ==> keep parsing
+ */
+static bool
+count_event(struct json_event const *event, void *ctx)
+{
+    uintmax_t *events = (uintmax_t *)ctx;	/* number of JSON events */
+
+    UNUSED_ARG(event);
+
+    if (events != NULL) {
+	++(*events);
+    }
+    return true;
+}
+
+
+/*
+ * check_doc - parse a JSON document one way and check it against the JSON semantic table
+ *
+ * given:
+ *	n	index of the JSON document in doc[]
+ *	way	0 ==> parse_json(), 1 ==> parse_json_buf(),
+ *		2 ==> parse_json_arena(), 3 ==> parse_json_arena_ref()
+ *	arena	arena of the calling thread
+ *	res	where to put the result
+ *
+ * NOTE: This function does not return on error.
+ */
+static void
+check_doc(size_t n, int way, struct json_arena *arena, struct result *res)
+{
+    struct json *tree = NULL;			/* JSON parse tree */
+    struct json *top = NULL;			/* top level JSON object */
+    struct dyn_array *count_err = NULL;		/* JSON semantic count errors */
+    struct dyn_array *val_err = NULL;		/* JSON semantic validation errors */
+    char *buf = NULL;				/* copy of the JSON document for parse_json_buf() */
+    size_t len = 0;				/* length of the JSON document */
+
+    /*
+     * firewall
+     */
+    if (n >= DOC_COUNT || arena == NULL || res == NULL) {
+	err(16, __func__, "called with bad args");
+	not_reached();
+    }
+    memset(res, 0, sizeof(*res));
+    len = strlen(doc[n]);
+
+    /*
+     * parse the JSON document
+     */
+    switch (way) {
+    case 0:
+	tree = parse_json(doc[n], len, "doc", &res->is_valid);
+	break;
+    case 1:
+	errno = 0;		/* pre-clear errno for errp() */
+	buf = calloc(len + JSON_SCAN_PAD, 1);
+	if (buf == NULL) {
+	    errp(17, __func__, "calloc of %zu bytes failed", len + JSON_SCAN_PAD);
+	    not_reached();
+	}
+	memcpy(buf, doc[n], len);
+	tree = parse_json_buf(buf, len, "doc", &res->is_valid);
+	break;
+    case 2:
+	tree = parse_json_arena(doc[n], len, "doc", &res->is_valid, arena);
+	break;
+    case 3:
+	tree = parse_json_arena_ref(doc[n], len, "doc", &res->is_valid, arena);
+	break;
+    default:
+	err(18, __func__, "unknown way: %d", way);
+	not_reached();
+	break;
+    }
+    if (tree == NULL) {
+	err(19, __func__, "doc[%zu] way %d: JSON parse tree is NULL", n, way);
+	not_reached();
+    }
+
+    /*
+     * look up members of the top level JSON object
+     */
+    top = tree;
+    if (top->type == JTYPE_OBJECT) {
+	res->has_name = (json_object_find_member(top, "name", strlen("name")) != NULL);
+	res->has_dup = (json_object_find_dup(top) != NULL);
+    }
+
+    /*
+     * check the JSON parse tree against the JSON semantic table
+     */
+    res->sem_errors = json_sem_check(tree, JSON_DEFAULT_MAX_DEPTH, sem_tbl, &count_err, &val_err);
+    res->count_errors = dyn_array_tell(count_err);
+    res->val_errors = dyn_array_tell(val_err);
+    free_count_err(count_err);
+    count_err = NULL;
+    free_val_err(val_err);
+    val_err = NULL;
+
+    /*
+     * count the JSON events of the JSON document
+     */
+    if (parse_json_events(doc[n], len, "doc", JSON_DEFAULT_MAX_DEPTH, count_event, &res->events) != res->is_valid) {
+	err(20, __func__, "doc[%zu] way %d: parse_json_events() does not agree on validity", n, way);
+	not_reached();
+    }
+
+    /*
+     * free the JSON parse tree
+     */
+    if (way < 2) {
+	json_tree_free(tree, JSON_INFINITE_DEPTH);
+	free(tree);
+    }
+    tree = NULL;
+    if (buf != NULL) {
+	free(buf);
+	buf = NULL;
+    }
+    return;
+}
+
+
+/*
+ * same_result - determine if two results are the same
+ *
+ * given:
+ *	a	first result
+ *	b	second result
+ *
+ * returns:
+ *	true ==> every field of a is the same as that of b
+ */
+static bool
+same_result(struct result const *a, struct result const *b)
+{
+    return a->is_valid == b->is_valid &&
+	   a->sem_errors == b->sem_errors &&
+	   a->count_errors == b->count_errors &&
+	   a->val_errors == b->val_errors &&
+	   a->events == b->events &&
+	   a->has_name == b->has_name &&
+	   a->has_dup == b->has_dup;
+}
+
+
+/*
+ * run_thread - parse and check each JSON document each way, for a number of rounds
+ *
+ * given:
+ *	arg	pointer to the struct thread of this thread
+ *
+ * returns:
+ *	NULL
+ */
+static void *
+run_thread(void *arg)
+{
+    struct thread *self = (struct thread *)arg;	/* state of this thread */
+    struct json_arena *arena = NULL;		/* arena of this thread */
+    struct result res;				/* result of a check */
+    unsigned int round = 0;			/* current round */
+    size_t n = 0;				/* current JSON document */
+    int way = 0;				/* current way of parsing */
+
+    /*
+     * firewall
+     */
+    if (self == NULL) {
+	err(21, __func__, "arg is NULL");
+	not_reached();
+    }
+
+    /*
+     * check every JSON document every way, each round in a different order
+     */
+    arena = json_arena_create(0);
+    for (round=0; round < self->rounds; ++round) {
+	for (n=0; n < DOC_COUNT; ++n) {
+	    for (way=0; way < PARSE_WAYS; ++way) {
+		size_t d = (n + round + self->id) % DOC_COUNT;	/* JSON document to check */
+		int w = (int)((way + round + self->id) % PARSE_WAYS);	/* way to parse it */
+
+		check_doc(d, w, arena, &res);
+		json_arena_reset(arena);
+		++self->checked;
+		if (same_result(&res, &expected[d][w]) == false) {
+		    warn(__func__, "thread %u round %u: doc[%zu] way %d: result is not as expected",
+				   self->id, round, d, w);
+		    ++self->mismatched;
+		}
+	    }
+	}
+    }
+    json_arena_free(arena);
+    arena = NULL;
+    return NULL;
+}
+
+
+/*
+ * usage - print usage to stderr
+ *
+ * Example:
+ *      usage(3, program, "wrong number of arguments");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * NOTE: We warn with extra newlines to help internal fault messages stand out.
+ *       Normally one should NOT include newlines in warn messages.
+ *
+ * This function does not return.
+ */
+static void
+usage(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (prog == NULL) {
+	prog = "((NULL prog))";
+	warn(__func__, "\nin usage(): prog was NULL, forcing it to be: %s\n", prog);
+    }
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage(): str was NULL, forcing it to be: %s\n", str);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprint(stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, JSON_DBG_DEFAULT, DEF_THREADS, MAX_THREADS,
+		  DEF_ROUNDS, THREAD_TEST_VERSION, json_parser_version);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
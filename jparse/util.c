@@ -44,6 +44,7 @@
 #include <errno.h>
 #include <stdarg.h>
 #include <poll.h>
+#include <sys/mman.h>
 
 /*
  * dbg - info, debug, warning, error, and usage message facility
@@ -2112,9 +2113,38 @@ readline_dup(char **linep, bool strip, size_t *lenp, FILE *stream)
  *	malloc buffer containing the entire contents of stream,
  *	or NULL is an error occurred.
  *
+ * This function is read_all_max() without a maximum: see read_all_max().
+ *
+ * NOTE: It is the caller's responsibility to free the returned string when it
+ * is no longer needed.
+ */
+void *
+read_all(FILE *stream, size_t *psize)
+{
+    return read_all_max(stream, psize, 0);
+}
+
+
+/*
+ * read_all_max - read all data from an open file, up to a maximum
+ *
+ * given:
+ *	stream	    - an open file stream to read from
+ *	psize	    - if psize != NULL, *psize is the amount of data read
+ *	max	    - read no more than max bytes, 0 ==> no maximum
+ *
+ * returns:
+ *	malloc buffer containing the entire contents of stream,
+ *	or NULL is an error occurred.
+ *
  * This function will update *psize, if it was non-NULL, to indicate
  * the amount of data that was read from stream before EOF.
  *
+ * When max > 0, reading stops once max bytes have been read, so a stream
+ * longer than max is not read to its end.  A caller that must reject such a
+ * stream without reading all of it should give one more than the longest
+ * it accepts and check for a *psize greater than that.
+ *
  * The allocated buffer may be larger than the amount of data read.
  * In this case *psize (if psize != NULL) will contain the exact
  * amount of data read, ignoring any extra allocated data.
@@ -2153,7 +2183,7 @@ readline_dup(char **linep, bool strip, size_t *lenp, FILE *stream)
  * is no longer needed.
  */
 void *
-read_all(FILE *stream, size_t *psize)
+read_all_max(FILE *stream, size_t *psize, size_t max)
 {
     struct dyn_array *array = NULL;	/* dynamic array for file content */
     long dyn_array_seek_cycle = 0;	/* number of dyn_array_seek() calls */
@@ -2162,6 +2192,7 @@ read_all(FILE *stream, size_t *psize)
     uint8_t *read_buf = NULL;		/* where next to read data into */
     long read_cycle = 0;		/* number of read cycles */
     size_t last_read = 0;		/* amount last fread read from open stream */
+    size_t want = 0;			/* amount to try to read in this read cycle */
     intmax_t used = 0;		        /* amount of data read into the buffer */
     uint8_t *ret = NULL;		/* buffer containing the while file to return */
     int fread_errno = 0;		/* errno after fread() call */
@@ -2197,16 +2228,26 @@ read_all(FILE *stream, size_t *psize)
     array = dyn_array_create(sizeof(uint8_t), READ_ALL_CHUNK, INITIAL_BUF_SIZE, true);
     ++dyn_array_seek_cycle;
 
+    /*
+     * double the buffer when it runs out, rather than grow it by a READ_ALL_CHUNK,
+     * so that a large stream is not copied again and again
+     */
+    dyn_array_set_growth(array, DYN_ARRAY_GROW_CAPPED, DYN_ARRAY_GROW_PCT, READ_ALL_GROW_CAP);
+
     /*
      * read until stream EOF or ERROR
      */
     do {
 
 	/*
-	 * expand buffer by a READ_ALL_CHUNK
+	 * expand buffer by a READ_ALL_CHUNK, or by what is left up to max
 	 */
 	used = dyn_array_tell(array);
-	moved = dyn_array_seek(array, READ_ALL_CHUNK, SEEK_CUR);
+	want = READ_ALL_CHUNK;
+	if (max > 0 && max - (size_t)used < want) {
+	    want = max - (size_t)used;
+	}
+	moved = dyn_array_seek(array, (off_t)want, SEEK_CUR);
 	if (moved == true) {
 	    ++move_cycle;
 	    dbg(DBG_VVVHIGH, "dyn_array_seek() caused a realloc data move, count: %ld", move_cycle);
@@ -2221,19 +2262,19 @@ read_all(FILE *stream, size_t *psize)
 	dbg(DBG_VVHIGH, "%s: about to start read cycle: %ld", __func__, read_cycle);
 	read_buf = dyn_array_addr(array, uint8_t, used);
 	errno = 0;			/* pre-clear errno for warnp() */
-	last_read = fread(read_buf, sizeof(uint8_t), READ_ALL_CHUNK, stream);
+	last_read = fread(read_buf, sizeof(uint8_t), want, stream);
 	fread_errno = errno;	/* save errno from fread() call for later reporting if needed */
-	dbg(DBG_VVHIGH, "%s: fread(read_buf, %ju, %d, stream) read cycle: %ld returned: %jd",
-			 __func__, (uintmax_t)sizeof(uint8_t), READ_ALL_CHUNK, read_cycle, (intmax_t)last_read);
+	dbg(DBG_VVHIGH, "%s: fread(read_buf, %ju, %ju, stream) read cycle: %ld returned: %jd",
+			 __func__, (uintmax_t)sizeof(uint8_t), (uintmax_t)want, read_cycle, (intmax_t)last_read);
 	++read_cycle;
 
 	/*
 	 * account for the amount of data read
 	 */
 	if (last_read > 0) {
-	    if (last_read != READ_ALL_CHUNK) {
+	    if (last_read != want) {
 		/* update the dynamic array size based on amount of read in last read */
-		moved = dyn_array_seek(array, (off_t)last_read-READ_ALL_CHUNK, SEEK_CUR);
+		moved = dyn_array_seek(array, (off_t)last_read-(off_t)want, SEEK_CUR);
 		if (moved == true) {
 		    ++move_cycle;
 		    dbg(DBG_VVVHIGH, "dyn_array_seek() caused a realloc data move, count: %ld", move_cycle);
@@ -2250,6 +2291,14 @@ read_all(FILE *stream, size_t *psize)
 	}
 	used = dyn_array_tell(array);
 
+	/*
+	 * stop at max without reading the rest of stream
+	 */
+	if (max > 0 && (size_t)used >= max) {
+	    dbg(DBG_HIGH, "stopped reading stream at the maximum of: %ju bytes", (uintmax_t)max);
+	    break;
+	}
+
 	/*
 	 * look for I/O errors and EOF
 	 */
@@ -2274,6 +2323,17 @@ read_all(FILE *stream, size_t *psize)
 	    break;
 	}
     } while (true);
+
+    /*
+     * free what the doubling allocated but did not use
+     *
+     * The guard chunk of NUL bytes beyond the data is kept.
+     */
+    moved = dyn_array_shrink_to_fit(array);
+    if (moved == true) {
+	++move_cycle;
+	dbg(DBG_VVVHIGH, "dyn_array_shrink_to_fit() caused a realloc data move, count: %ld", move_cycle);
+    }
     dbg(DBG_VVHIGH, "%s(stream, psize): last_read: %ju total bytes: %jd allocated: %jd "
 		    "read_cycle: %ld move_cycle: %ld seek_cycle: %ld",
 		    __func__, (uintmax_t)last_read, dyn_array_tell(array), dyn_array_alloced(array),
@@ -2294,6 +2354,150 @@ read_all(FILE *stream, size_t *psize)
 }
 
 
+/*
+ * map_all - map all data of an open regular file into memory
+ *
+ * given:
+ *	stream	    - an open file stream to map
+ *	psize	    - if psize != NULL, *psize is the amount of data mapped
+ *	pad	    - number of extra NUL bytes required after the data
+ *
+ * returns:
+ *	private writable mapping of the entire contents of stream followed by
+ *	at least pad NUL bytes, or NULL if stream cannot be mapped
+ *
+ * Unlike read_all(), the data is not copied: pages of the file are brought
+ * into memory as they are first accessed.  Writing to the returned memory
+ * does not modify the file (the mapping is copy-on-write).
+ *
+ * Only a non-empty regular file whose stream has not yet been read from
+ * can be mapped.  In all other cases (a pipe, a terminal, an empty file,
+ * mmap(2) failure, etc.) NULL is returned and the caller is expected to
+ * fall back to read_all().  NULL is NOT a fatal error and the stream is
+ * left as it was.
+ *
+ * NOTE: The returned memory must be released by unmap_all() with the same
+ *	 size and pad, NOT by free(3).
+ */
+void *
+map_all(FILE *stream, size_t *psize, size_t pad)
+{
+    struct stat buf;			/* stream status */
+    long pagesize = 0;			/* system page size */
+    size_t size = 0;			/* size of the file */
+    size_t maplen = 0;			/* size + pad rounded up to a multiple of the page size */
+    void *ret = NULL;			/* mapped data to return */
+    void *file_map = NULL;		/* mapping of the file over the reserved memory */
+    int fd = -1;			/* file descriptor of stream */
+
+    /*
+     * firewall
+     */
+    if (stream == NULL) {
+	err(159, __func__, "called with NULL stream"); /*ooo*/
+	not_reached();
+    }
+    if (psize != NULL) {
+	*psize = 0;
+    }
+
+    /*
+     * only a non-empty regular file that is at its beginning may be mapped
+     */
+    fd = fileno(stream);
+    if (fd < 0 || fstat(fd, &buf) != 0 || !S_ISREG(buf.st_mode) || buf.st_size <= 0) {
+	dbg(DBG_VVHIGH, "%s: stream is not a non-empty regular file", __func__);
+	return NULL;
+    }
+    if (feof(stream) || ferror(stream) || ftello(stream) != 0) {
+	dbg(DBG_VVHIGH, "%s: stream is not at the beginning of the file", __func__);
+	return NULL;
+    }
+    if ((uintmax_t)buf.st_size > (uintmax_t)(SIZE_MAX/2) - pad) {
+	dbg(DBG_VVHIGH, "%s: file is too large to map", __func__);
+	return NULL;
+    }
+    size = (size_t)buf.st_size;
+    pagesize = sysconf(_SC_PAGESIZE);
+    if (pagesize <= 0) {
+	dbg(DBG_VVHIGH, "%s: unable to determine the page size", __func__);
+	return NULL;
+    }
+    maplen = ((size + pad + (size_t)pagesize - 1) / (size_t)pagesize) * (size_t)pagesize;
+
+    /*
+     * reserve zeroized memory for the file data and the pad
+     *
+     * Bytes of the last page of a file mapping that are beyond the end of the
+     * file are zero.  However when the file ends on (or too close to) a page
+     * boundary there would be no room for the pad.  We first reserve anonymous
+     * memory for the file data plus the pad, and then map the file over the
+     * front of it.
+     */
+    ret = mmap(NULL, maplen, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (ret == MAP_FAILED) {
+	dbg(DBG_VVHIGH, "%s: unable to reserve %ju bytes: %s", __func__, (uintmax_t)maplen, strerror(errno));
+	return NULL;
+    }
+    file_map = mmap(ret, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, fd, 0);
+    if (file_map == MAP_FAILED) {
+	dbg(DBG_VVHIGH, "%s: unable to map %ju bytes: %s", __func__, (uintmax_t)size, strerror(errno));
+	(void) munmap(ret, maplen);
+	return NULL;
+    }
+
+    /*
+     * we expect to read the data once, from the front to the back
+     */
+    (void) madvise(ret, size, MADV_SEQUENTIAL);
+    dbg(DBG_HIGH, "%s: mapped %ju bytes", __func__, (uintmax_t)size);
+
+    /*
+     * report the amount of data mapped, if requested
+     */
+    if (psize != NULL) {
+	*psize = size;
+    }
+    return ret;
+}
+
+
+/*
+ * unmap_all - release memory returned by map_all()
+ *
+ * given:
+ *	data	    - memory returned by map_all()
+ *	size	    - amount of data mapped as returned by map_all()
+ *	pad	    - pad given to map_all()
+ *
+ * NOTE: This function does nothing if data is NULL.
+ */
+void
+unmap_all(void *data, size_t size, size_t pad)
+{
+    long pagesize = 0;			/* system page size */
+    size_t maplen = 0;			/* size + pad rounded up to a multiple of the page size */
+
+    /*
+     * firewall
+     */
+    if (data == NULL) {
+	return;
+    }
+
+    /*
+     * unmap the file data and the pad
+     */
+    pagesize = sysconf(_SC_PAGESIZE);
+    maplen = ((size + pad + (size_t)pagesize - 1) / (size_t)pagesize) * (size_t)pagesize;
+    errno = 0;			/* pre-clear errno for warnp() */
+    if (munmap(data, maplen) != 0) {
+	warnp(__func__, "munmap of %ju bytes failed", (uintmax_t)maplen);
+    }
+    return;
+}
+
+
 /*
  * is_string - determine if a block of memory is a C string
  *
@@ -3420,6 +3624,131 @@ posix_safe_chk(char const *str, size_t len, bool *slash, bool *posix_safe, bool
 }
 
 
+/*
+ * str_prop_chk - find the properties of a string in a single scan
+ *
+ * This function finds what posix_safe_chk() finds, along with the length in
+ * UTF-8 code points and the @ chars and URL prefix that the IOCCC tests of
+ * email addresses, accounts and URLs look for, so that those tests need not
+ * scan the string again.
+ *
+ * given:
+ *	str		- string to test
+ *	len		- length of str to test
+ *	prop		- properties of str to fill in
+ *
+ * NOTE: When str is NULL, all of the properties are false or 0.
+ */
+void
+str_prop_chk(char const *str, size_t len, struct str_prop *prop)
+{
+    bool found_unsafe = false;		/* true ==> found non-ASCII or non-POSIX portable safe plus +/ */
+    unsigned char c;			/* byte being tested */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (prop == NULL) {
+	warn(__func__, "prop is NULL");
+	return;
+    }
+
+    /*
+     * assume all tests will fail
+     */
+    memset(prop, 0, sizeof(*prop));
+    if (str == NULL) {
+	warn(__func__, "str is NULL");
+	return;
+    }
+    prop->len = len;
+
+    /*
+     * empty string fails all tests
+     */
+    if (len <= 0) {
+	dbg(DBG_VVHIGH, "str_prop_chk(): str is an empty string");
+	return;
+    }
+
+    /*
+     * test each character
+     */
+    for (i=0; i < len; ++i) {
+	c = (unsigned char)str[i];
+
+	/*
+	 * count UTF-8 code points and find NUL bytes
+	 */
+	if ((c & 0xc0) != 0x80) {
+	    ++prop->code_points;
+	}
+	if (c == '\0') {
+	    prop->nul = true;
+	}
+
+	/*
+	 * case: character is non-ASCII
+	 */
+	if (!isascii(c)) {
+	    found_unsafe = true;
+
+	/*
+	 * case: / check
+	 */
+	} else if (c == '/') {
+	    prop->slash = true;
+
+	/*
+	 * case: character is alphanumeric
+	 */
+	} else if (isalnum(c)) {
+	    if (i == 0) {
+		prop->first_alphanum = true;
+	    }
+	    if (isupper(c)) {
+		prop->upper = true;
+	    }
+
+	/*
+	 * case: @ check
+	 */
+	} else if (c == '@') {
+	    ++prop->at_count;
+	    if (i > 0 && str[i-1] == '@') {
+		prop->adjacent_at = true;
+	    }
+	    found_unsafe = true;
+
+	/*
+	 * case: is not POSIX portable safe plus +, where - may not be first
+	 */
+	} else if (c != '.' && c != '_' && c != '+' && (c != '-' || i == 0)) {
+	    found_unsafe = true;
+	}
+    }
+
+    /*
+     * report the properties that depend on the whole string
+     */
+    prop->posix_safe = !found_unsafe;
+    prop->posix_plus_safe = (prop->posix_safe == true && prop->first_alphanum == true && prop->slash == false);
+    prop->email = (prop->at_count == 1 && str[0] != '@' && str[len-1] != '@');
+    if (len > LITLEN("https://") && strncmp(str, "https://", LITLEN("https://")) == 0) {
+	prop->url = (str[LITLEN("https://")] != '/');
+    } else if (len > LITLEN("http://") && strncmp(str, "http://", LITLEN("http://")) == 0) {
+	prop->url = (str[LITLEN("http://")] != '/');
+    }
+    dbg(DBG_VVHIGH, "str_prop_chk(): len: %ju code points: %ju posix_safe: %s posix_plus_safe: %s "
+		    "at_count: %ju email: %s url: %s",
+		    (uintmax_t)prop->len, (uintmax_t)prop->code_points, booltostr(prop->posix_safe),
+		    booltostr(prop->posix_plus_safe), (uintmax_t)prop->at_count,
+		    booltostr(prop->email), booltostr(prop->url));
+    return;
+}
+
+
 
 /*
  * clearerr_or_fclose - clear FILE stream if stdin, stdout, or stderr OR close the stream
@@ -108,6 +108,7 @@ typedef unsigned char bool;
 #define LITLEN(x) (sizeof(x)-1)	/* length of a literal string w/o the NUL byte */
 #define INITIAL_BUF_SIZE (8192)	/* initial size of buffer allocated by read_all */
 #define READ_ALL_CHUNK (65536)	/* grow this read_all by this amount when needed */
+#define READ_ALL_GROW_CAP (67108864)	/* read_all doubles its buffer, but grows it by no more than this */
 #define LLONG_MAX_BASE10_DIGITS (19) /* for string to int functions */
 #define TBLLEN(x) (sizeof(x)/sizeof((x)[0]))	/* number of elements in an initialized table array */
 #define UNUSED_ARG(x) (void)(x)			/* prevent compiler from complaining about an unused arg */
@@ -174,6 +175,30 @@ typedef unsigned char bool;
 #define MATCH_PRECISION ((long double)(1<<22))
 
 
+/*
+ * str_prop - properties of a string, found in a single scan by str_prop_chk()
+ *
+ * The POSIX fields are those of posix_safe_chk().  A string with posix_plus_safe
+ * is one for which posix_plus_safe(str, false, false, true) is true, and so is
+ * one for which posix_plus_safe(str, true, false, true) is true unless upper.
+ */
+struct str_prop
+{
+    size_t len;			/* length in bytes, not including the final NUL */
+    size_t code_points;		/* number of UTF-8 code points (bytes that do not continue a UTF-8 sequence) */
+    bool nul;			/* true ==> a NUL byte was found before len */
+    bool slash;			/* true ==> a / was found */
+    bool posix_safe;		/* true ==> all chars are POSIX portable safe plus +/ */
+    bool first_alphanum;	/* true ==> first char is alphanumeric */
+    bool upper;			/* true ==> UPPER case chars found */
+    bool posix_plus_safe;	/* true ==> matches ^[0-9A-Za-z][0-9A-Za-z._+-]*$ */
+    size_t at_count;		/* number of @ chars */
+    bool adjacent_at;		/* true ==> @@ was found */
+    bool email;			/* true ==> x@y: one @ that is neither first nor last */
+    bool url;			/* true ==> starts with https:// or http:// followed by a char other than / */
+};
+
+
 /*
  * external function declarations
  */
@@ -204,6 +229,9 @@ extern ssize_t readline(char **linep, FILE * stream);
 extern char *readline_dup(char **linep, bool strip, size_t *lenp, FILE * stream);
 extern void jencchk(void);
 extern void *read_all(FILE *stream, size_t *psize);
+extern void *read_all_max(FILE *stream, size_t *psize, size_t max);
+extern void *map_all(FILE *stream, size_t *psize, size_t pad);
+extern void unmap_all(void *data, size_t size, size_t pad);
 extern bool is_string(char const * const ptr, size_t len);
 extern char const *strnull(char const * const str);
 extern bool string_to_intmax(char const *str, intmax_t *ret);
@@ -217,6 +245,7 @@ extern bool is_e_notation_str(char const *str, size_t *retlen);
 extern bool posix_plus_safe(char const *str, bool lower_only, bool slash_ok, bool first);
 extern void posix_safe_chk(char const *str, size_t len, bool *slash, bool *posix_safe,
 			   bool *first_alphanum, bool *upper);
+extern void str_prop_chk(char const *str, size_t len, struct str_prop *prop);
 extern void clearerr_or_fclose(FILE *stream);
 extern ssize_t fprint_line_buf(FILE *stream, const void *buf, size_t len, int start, int end);
 extern ssize_t fprint_line_str(FILE *stream, char *str, size_t *retlen, int start, int end);
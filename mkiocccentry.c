@@ -3897,7 +3897,7 @@ get_author_info(struct author **author_set_p)
 	    /*
 	     * sanity check the Email address
 	     */
-	    pass = test_email(author_set[i].email);
+	    pass = test_email(author_set[i].email, NULL);
 	    if (pass == false) {
 
 		/*
@@ -4402,7 +4402,7 @@ get_author_info(struct author **author_set_p)
 	    /*
 	     * reject if handle is invalid
 	     */
-	    if (test_author_handle(author_set[i].author_handle) == false) {
+	    if (test_author_handle(author_set[i].author_handle, NULL) == false) {
 
 		/*
 		 * issue rejection message
@@ -4659,6 +4659,7 @@ write_info(struct info *infop, char const *entry_dir, char const *chkentry, char
     char *info_path;		/* path to .info.json file */
     size_t info_path_len;	/* length of path to .info.json */
     FILE *info_stream;		/* open write stream to the .info.json file */
+    struct json_writer *info_writer;	/* buffered JSON writer of the .info.json file */
     size_t strftime_ret;	/* length of strftime() string without the trailing newline */
     size_t utctime_len;		/* length of utctime string (utctime() + " UTC") */
     int ret;			/* libc function return */
@@ -4758,57 +4759,65 @@ write_info(struct info *infop, char const *entry_dir, char const *chkentry, char
     /*
      * write leading part of info to the open .info.json file
      */
+    info_writer = json_writer_create(info_stream, 0, "\t", " : ");
     errno = 0;			/* pre-clear errno for errp() */
-    ret = fprintf(info_stream, "{\n") > 0 &&
-	json_fprintf_value_string(info_stream, "\t", JSON_PARSING_DIRECTIVE_NAME, " : ", JSON_PARSING_DIRECTIVE_VALUE, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "IOCCC_info_version", " : ", INFO_VERSION, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "IOCCC_contest", " : ", IOCCC_CONTEST, ",\n") &&
-	json_fprintf_value_long(info_stream, "\t", "IOCCC_year", " : ", (long)IOCCC_YEAR, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "mkiocccentry_version", " : ", MKIOCCCENTRY_VERSION, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "iocccsize_version", " : ", infop->iocccsize_ver, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "chkentry_version", " : ", CHKENTRY_VERSION, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "fnamchk_version", " : ", FNAMCHK_VERSION, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "txzchk_version", " : ", TXZCHK_VERSION, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "IOCCC_contest_id", " : ", infop->ioccc_id, ",\n") &&
-	json_fprintf_value_long(info_stream, "\t", "entry_num", " : ", (long)infop->entry_num, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "title", " : ", infop->title, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "abstract", " : ", infop->abstract, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "tarball", " : ", infop->tarball, ",\n") &&
-	json_fprintf_value_long(info_stream, "\t", "rule_2a_size", " : ", (long)infop->rule_2a_size, ",\n") &&
-	json_fprintf_value_long(info_stream, "\t", "rule_2b_size", " : ", (long)infop->rule_2b_size, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "empty_override", " : ", infop->empty_override, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "rule_2a_override", " : ", infop->rule_2a_override, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "rule_2a_mismatch", " : ", infop->rule_2a_mismatch, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "rule_2b_override", " : ", infop->rule_2b_override, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "highbit_warning", " : ", infop->highbit_warning, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "nul_warning", " : ", infop->nul_warning, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "trigraph_warning", " : ", infop->trigraph_warning, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "wordbuf_warning", " : ", infop->wordbuf_warning, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "ungetc_warning", " : ", infop->ungetc_warning, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "Makefile_override", " : ", infop->Makefile_override, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "first_rule_is_all", " : ", infop->first_rule_is_all, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "found_all_rule", " : ", infop->found_all_rule, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "found_clean_rule", " : ", infop->found_clean_rule, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "found_clobber_rule", " : ", infop->found_clobber_rule, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "found_try_rule", " : ", infop->found_try_rule, ",\n") &&
-	json_fprintf_value_bool(info_stream, "\t", "test_mode", " : ", infop->test_mode, ",\n") &&
-	fprintf(info_stream, "\t\"manifest\" : [\n") > 0;
+    ret = json_writer_object(info_writer, NULL, false) &&
+	json_writer_string(info_writer, JSON_PARSING_DIRECTIVE_NAME, JSON_PARSING_DIRECTIVE_VALUE) &&
+	json_writer_string(info_writer, "IOCCC_info_version", INFO_VERSION) &&
+	json_writer_string(info_writer, "IOCCC_contest", IOCCC_CONTEST) &&
+	json_writer_intmax(info_writer, "IOCCC_year", (intmax_t)IOCCC_YEAR) &&
+	json_writer_string(info_writer, "mkiocccentry_version", MKIOCCCENTRY_VERSION) &&
+	json_writer_string(info_writer, "iocccsize_version", infop->iocccsize_ver) &&
+	json_writer_string(info_writer, "chkentry_version", CHKENTRY_VERSION) &&
+	json_writer_string(info_writer, "fnamchk_version", FNAMCHK_VERSION) &&
+	json_writer_string(info_writer, "txzchk_version", TXZCHK_VERSION) &&
+	json_writer_string(info_writer, "IOCCC_contest_id", infop->ioccc_id) &&
+	json_writer_intmax(info_writer, "entry_num", (intmax_t)infop->entry_num) &&
+	json_writer_string(info_writer, "title", infop->title) &&
+	json_writer_string(info_writer, "abstract", infop->abstract) &&
+	json_writer_string(info_writer, "tarball", infop->tarball) &&
+	json_writer_intmax(info_writer, "rule_2a_size", (intmax_t)infop->rule_2a_size) &&
+	json_writer_intmax(info_writer, "rule_2b_size", (intmax_t)infop->rule_2b_size) &&
+	json_writer_bool(info_writer, "empty_override", infop->empty_override) &&
+	json_writer_bool(info_writer, "rule_2a_override", infop->rule_2a_override) &&
+	json_writer_bool(info_writer, "rule_2a_mismatch", infop->rule_2a_mismatch) &&
+	json_writer_bool(info_writer, "rule_2b_override", infop->rule_2b_override) &&
+	json_writer_bool(info_writer, "highbit_warning", infop->highbit_warning) &&
+	json_writer_bool(info_writer, "nul_warning", infop->nul_warning) &&
+	json_writer_bool(info_writer, "trigraph_warning", infop->trigraph_warning) &&
+	json_writer_bool(info_writer, "wordbuf_warning", infop->wordbuf_warning) &&
+	json_writer_bool(info_writer, "ungetc_warning", infop->ungetc_warning) &&
+	json_writer_bool(info_writer, "Makefile_override", infop->Makefile_override) &&
+	json_writer_bool(info_writer, "first_rule_is_all", infop->first_rule_is_all) &&
+	json_writer_bool(info_writer, "found_all_rule", infop->found_all_rule) &&
+	json_writer_bool(info_writer, "found_clean_rule", infop->found_clean_rule) &&
+	json_writer_bool(info_writer, "found_clobber_rule", infop->found_clobber_rule) &&
+	json_writer_bool(info_writer, "found_try_rule", infop->found_try_rule) &&
+	json_writer_bool(info_writer, "test_mode", infop->test_mode) &&
+	json_writer_array(info_writer, "manifest", false);
     if (!ret) {
-	errp(150, __func__, "fprintf error writing leading part of info to %s", info_path);
+	errp(150, __func__, "error writing leading part of info to %s", info_path);
 	not_reached();
     }
 
     /*
      * write mandatory files to the open .info.json file
+     *
+     * Each file is a JSON object of one member on a line of its own.
      */
-    ret = json_fprintf_value_string(info_stream, "\t\t{", "info_JSON", " : ", INFO_JSON_FILENAME, "},\n") &&
-	  json_fprintf_value_string(info_stream, "\t\t{", "auth_JSON", " : ", AUTH_JSON_FILENAME, "},\n") &&
-	  json_fprintf_value_string(info_stream, "\t\t{", "c_src", " : ", infop->prog_c, "},\n") &&
-	  json_fprintf_value_string(info_stream, "\t\t{", "Makefile", " : ", infop->Makefile, "},\n") &&
-	  json_fprintf_value_string(info_stream, "\t\t{", "remarks", " : ", infop->remarks_md,
-				    ((infop->extra_count > 0) ?  "},\n" : "}\n"));
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = json_writer_object(info_writer, NULL, true) &&
+	  json_writer_string(info_writer, "info_JSON", INFO_JSON_FILENAME) && json_writer_end(info_writer) &&
+	  json_writer_object(info_writer, NULL, true) &&
+	  json_writer_string(info_writer, "auth_JSON", AUTH_JSON_FILENAME) && json_writer_end(info_writer) &&
+	  json_writer_object(info_writer, NULL, true) &&
+	  json_writer_string(info_writer, "c_src", infop->prog_c) && json_writer_end(info_writer) &&
+	  json_writer_object(info_writer, NULL, true) &&
+	  json_writer_string(info_writer, "Makefile", infop->Makefile) && json_writer_end(info_writer) &&
+	  json_writer_object(info_writer, NULL, true) &&
+	  json_writer_string(info_writer, "remarks", infop->remarks_md) && json_writer_end(info_writer);
     if (!ret) {
-	errp(151, __func__, "fprintf error writing mandatory filename to %s", info_path);
+	errp(151, __func__, "error writing mandatory filename to %s", info_path);
 	not_reached();
     }
 
@@ -4816,9 +4825,12 @@ write_info(struct info *infop, char const *entry_dir, char const *chkentry, char
      * write extra files to the open .info.json file
      */
     for (i=0, q=infop->extra_file; i < infop->extra_count && *q != NULL; ++i, ++q) {
-        if (json_fprintf_value_string(info_stream, "\t\t{", "extra_file", " : ", *q,
-				     (((i+1) < infop->extra_count) ? "},\n" : "}\n")) != true) {
-	    errp(152, __func__, "fprintf error writing extra filename[%d] to %s", i, info_path);
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = json_writer_object(info_writer, NULL, true) &&
+	      json_writer_string(info_writer, "extra_file", *q) &&
+	      json_writer_end(info_writer);
+	if (!ret) {
+	    errp(152, __func__, "error writing extra filename[%d] to %s", i, info_path);
 	    not_reached();
 	}
     }
@@ -4827,15 +4839,16 @@ write_info(struct info *infop, char const *entry_dir, char const *chkentry, char
      * write trailing part of info to the open .info.json file
      */
     errno = 0;			/* pre-clear errno for errp() */
-    ret = fprintf(info_stream, "\t],\n") > 0 &&
-	json_fprintf_value_time_t(info_stream, "\t", "formed_timestamp", " : ", infop->tstamp, ",\n") &&
-	json_fprintf_value_long(info_stream, "\t", "formed_timestamp_usec", " : ", (long)infop->usec, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "timestamp_epoch", " : ", TIMESTAMP_EPOCH, ",\n") &&
-	json_fprintf_value_long(info_stream, "\t", "min_timestamp", " : ", MIN_TIMESTAMP, ",\n") &&
-	json_fprintf_value_string(info_stream, "\t", "formed_UTC", " : ", infop->utctime, "\n") &&
-	fprintf(info_stream, "}\n") > 0;
+    ret = json_writer_end(info_writer) &&
+	json_writer_time_t(info_writer, "formed_timestamp", infop->tstamp) &&
+	json_writer_intmax(info_writer, "formed_timestamp_usec", (intmax_t)infop->usec) &&
+	json_writer_string(info_writer, "timestamp_epoch", TIMESTAMP_EPOCH) &&
+	json_writer_intmax(info_writer, "min_timestamp", (intmax_t)MIN_TIMESTAMP) &&
+	json_writer_string(info_writer, "formed_UTC", infop->utctime) &&
+	json_writer_end(info_writer) &&
+	json_writer_free(info_writer);
     if (!ret) {
-	errp(153, __func__, "fprintf error writing trailing part of info to %s", info_path);
+	errp(153, __func__, "error writing trailing part of info to %s", info_path);
 	not_reached();
     }
 
@@ -4985,6 +4998,7 @@ write_auth(struct auth *authp, char const *entry_dir, char const *chkentry, char
     char *auth_path;		/* path to .auth.json file */
     size_t auth_path_len;	/* length of path to .auth.json */
     FILE *auth_stream;	/* open write stream to the .auth.json file */
+    struct json_writer *auth_writer;	/* buffered JSON writer of the .auth.json file */
     int ret;			/* libc function return */
     int exit_code;		/* exit code from shell_cmd() */
     int i;
@@ -5032,23 +5046,24 @@ write_auth(struct auth *authp, char const *entry_dir, char const *chkentry, char
     /*
      * write leading part of authorship to the open .auth.json file
      */
+    auth_writer = json_writer_create(auth_stream, 0, "\t", " : ");
     errno = 0;			/* pre-clear errno for errp() */
-    ret = fprintf(auth_stream, "{\n") > 0 &&
-	json_fprintf_value_string(auth_stream, "\t", JSON_PARSING_DIRECTIVE_NAME, " : ", JSON_PARSING_DIRECTIVE_VALUE, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "IOCCC_auth_version", " : ", AUTH_VERSION, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "IOCCC_contest", " : ", IOCCC_CONTEST, ",\n") &&
-	json_fprintf_value_long(auth_stream, "\t", "IOCCC_year", " : ", (long)IOCCC_YEAR, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "mkiocccentry_version", " : ", MKIOCCCENTRY_VERSION, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "chkentry_version", " : ", CHKENTRY_VERSION, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "fnamchk_version", " : ", FNAMCHK_VERSION, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "IOCCC_contest_id", " : ", authp->ioccc_id, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "tarball", " : ", authp->tarball, ",\n") &&
-	json_fprintf_value_long(auth_stream, "\t", "entry_num", " : ", (long)authp->entry_num, ",\n") &&
-	json_fprintf_value_long(auth_stream, "\t", "author_count", " : ", (long)authp->author_count, ",\n") &&
-	json_fprintf_value_bool(auth_stream, "\t", "test_mode", " : ", authp->test_mode, ",\n") &&
-	fprintf(auth_stream, "\t\"authors\" : [\n") > 0;
+    ret = json_writer_object(auth_writer, NULL, false) &&
+	json_writer_string(auth_writer, JSON_PARSING_DIRECTIVE_NAME, JSON_PARSING_DIRECTIVE_VALUE) &&
+	json_writer_string(auth_writer, "IOCCC_auth_version", AUTH_VERSION) &&
+	json_writer_string(auth_writer, "IOCCC_contest", IOCCC_CONTEST) &&
+	json_writer_intmax(auth_writer, "IOCCC_year", (intmax_t)IOCCC_YEAR) &&
+	json_writer_string(auth_writer, "mkiocccentry_version", MKIOCCCENTRY_VERSION) &&
+	json_writer_string(auth_writer, "chkentry_version", CHKENTRY_VERSION) &&
+	json_writer_string(auth_writer, "fnamchk_version", FNAMCHK_VERSION) &&
+	json_writer_string(auth_writer, "IOCCC_contest_id", authp->ioccc_id) &&
+	json_writer_string(auth_writer, "tarball", authp->tarball) &&
+	json_writer_intmax(auth_writer, "entry_num", (intmax_t)authp->entry_num) &&
+	json_writer_intmax(auth_writer, "author_count", (intmax_t)authp->author_count) &&
+	json_writer_bool(auth_writer, "test_mode", authp->test_mode) &&
+	json_writer_array(auth_writer, "authors", false);
     if (!ret) {
-	errp(169, __func__, "fprintf error writing leading part of authorship to %s", auth_path);
+	errp(169, __func__, "error writing leading part of authorship to %s", auth_path);
 	not_reached();
     }
 
@@ -5058,23 +5073,23 @@ write_auth(struct auth *authp, char const *entry_dir, char const *chkentry, char
     for (i = 0; i < authp->author_count; ++i) {
 	struct author *ap = &(authp->author[i]);
 	errno = 0;		/* pre-clear errno for errp() */
-	ret = fprintf(auth_stream, "\t\t{\n") > 0 &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "name", " : ", ap->name, ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "location_code", " : ", ap->location_code, ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "location_name", " : ", ap->location_name, ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "email", " : ", strnull(ap->email), ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "url", " : ", strnull(ap->url), ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "alt_url", " : ", strnull(ap->alt_url), ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "mastodon", " : ", strnull(ap->mastodon), ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "github", " : ", strnull(ap->github), ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "affiliation", " : ", strnull(ap->affiliation), ",\n") &&
-	    json_fprintf_value_bool(auth_stream, "\t\t\t", "past_winner", " : ", ap->past_winner, ",\n") &&
-	    json_fprintf_value_bool(auth_stream, "\t\t\t", "default_handle", " : ", ap->default_handle, ",\n") &&
-	    json_fprintf_value_string(auth_stream, "\t\t\t", "author_handle", " : ", strnull(ap->author_handle), ",\n") &&
-	    json_fprintf_value_long(auth_stream, "\t\t\t", "author_number", " : ", ap->author_num, "\n") &&
-	    fprintf(auth_stream, "\t\t}%s\n", (((i + 1) < authp->author_count) ? "," : "")) > 0;
+	ret = json_writer_object(auth_writer, NULL, false) &&
+	    json_writer_string(auth_writer, "name", ap->name) &&
+	    json_writer_string(auth_writer, "location_code", ap->location_code) &&
+	    json_writer_string(auth_writer, "location_name", ap->location_name) &&
+	    json_writer_string(auth_writer, "email", strnull(ap->email)) &&
+	    json_writer_string(auth_writer, "url", strnull(ap->url)) &&
+	    json_writer_string(auth_writer, "alt_url", strnull(ap->alt_url)) &&
+	    json_writer_string(auth_writer, "mastodon", strnull(ap->mastodon)) &&
+	    json_writer_string(auth_writer, "github", strnull(ap->github)) &&
+	    json_writer_string(auth_writer, "affiliation", strnull(ap->affiliation)) &&
+	    json_writer_bool(auth_writer, "past_winner", ap->past_winner) &&
+	    json_writer_bool(auth_writer, "default_handle", ap->default_handle) &&
+	    json_writer_string(auth_writer, "author_handle", strnull(ap->author_handle)) &&
+	    json_writer_intmax(auth_writer, "author_number", (intmax_t)ap->author_num) &&
+	    json_writer_end(auth_writer);
 	if (ret == false) {
-	    errp(170, __func__, "fprintf error writing author %d info to %s", i, auth_path);
+	    errp(170, __func__, "error writing author %d info to %s", i, auth_path);
 	    not_reached();
 	}
     }
@@ -5083,18 +5098,18 @@ write_auth(struct auth *authp, char const *entry_dir, char const *chkentry, char
      * write trailing part of authorship to the open .auth.json file
      */
     errno = 0;			/* pre-clear errno for errp() */
-    ret = fprintf(auth_stream, "\t],\n") > 0 &&
-	json_fprintf_value_time_t(auth_stream, "\t", "formed_timestamp", " : ", authp->tstamp, ",\n") &&
-	json_fprintf_value_long(auth_stream, "\t", "formed_timestamp_usec", " : ", (long)authp->usec, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "timestamp_epoch", " : ", authp->epoch, ",\n") &&
-	json_fprintf_value_long(auth_stream, "\t", "min_timestamp", " : ", MIN_TIMESTAMP, ",\n") &&
-	json_fprintf_value_string(auth_stream, "\t", "formed_UTC", " : ", authp->utctime, "\n") &&
-	fprintf(auth_stream, "}\n") > 0;
+    ret = json_writer_end(auth_writer) &&
+	json_writer_time_t(auth_writer, "formed_timestamp", authp->tstamp) &&
+	json_writer_intmax(auth_writer, "formed_timestamp_usec", (intmax_t)authp->usec) &&
+	json_writer_string(auth_writer, "timestamp_epoch", authp->epoch) &&
+	json_writer_intmax(auth_writer, "min_timestamp", (intmax_t)MIN_TIMESTAMP) &&
+	json_writer_string(auth_writer, "formed_UTC", authp->utctime) &&
+	json_writer_end(auth_writer) &&
+	json_writer_free(auth_writer);
     if (!ret) {
-	errp(171, __func__, "fprintf error writing trailing part of authorship to %s", auth_path);
+	errp(171, __func__, "error writing trailing part of authorship to %s", auth_path);
 	not_reached();
     }
-
     /*
      * close the file before checking it with chkentry
      */
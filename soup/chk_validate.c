@@ -336,7 +336,7 @@ chk_abstract(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_abstract(str);
+    test = test_abstract(str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(105, node, depth, sem, __func__, "invalid abstract");
@@ -402,7 +402,7 @@ chk_affiliation(struct json const *node,
 	}
 	return false;
     }
-    test = test_affiliation(val.str);
+    test = test_affiliation(val.str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(107, node, depth, sem, __func__, "invalid affiliation");
@@ -489,14 +489,13 @@ bool
 chk_author_count(struct json const *node,
 	     unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    int *value = NULL;				/* JSON_NUMBER as decoded int */
+    int value = 0;				/* JSON_NUMBER as decoded int */
     bool test = false;				/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_int(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_int(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -504,7 +503,7 @@ chk_author_count(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_author_count(*value);
+    test = test_author_count(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(109, node, depth, sem, __func__, "invalid author_count");
@@ -555,7 +554,7 @@ chk_author_handle(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_author_handle(str);
+    test = test_author_handle(str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(110, node, depth, sem, __func__, "invalid author_handle");
@@ -591,14 +590,13 @@ bool
 chk_author_number(struct json const *node,
 		  unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    int *value = NULL;				/* JSON_NUMBER as decoded int */
+    int value = 0;				/* JSON_NUMBER as decoded int */
     bool test = false;				/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_int(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_int(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -606,7 +604,7 @@ chk_author_number(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_author_number(*value);
+    test = test_author_number(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(111, node, depth, sem, __func__, "invalid author_number");
@@ -647,7 +645,7 @@ chk_authors(struct json const *node,
     struct json *author_count_node = NULL;	/* JSON parse node containing author_count */
     struct json_array *array = NULL;	/* JSON parse node value as JTYPE_ARRAY */
     struct author *aset = NULL;		/* array of authors converted from array of JSON parse tree JSON_OBJECT */
-    int *author_count = NULL;		/* pointer to author count as int from JSON parse node for author_count */
+    int author_count = 0;		/* author count as int from JSON parse node for author_count */
     bool test = false;			/* validation test result */
     int i;
 
@@ -698,12 +696,11 @@ chk_authors(struct json const *node,
     /*
      * obtain the author_count
      */
-    author_count = sem_member_value_int(author_count_node, depth, sem, __func__, val_err);
-    if (author_count == NULL) {
+    if (sem_member_value_int(author_count_node, depth, sem, __func__, val_err, &author_count) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
-    test = test_author_count(*author_count);
+    test = test_author_count(author_count);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(113, node, depth, sem, __func__, "invalid author_count");
@@ -738,11 +735,11 @@ chk_authors(struct json const *node,
     /*
      * firewall - author count must match array length
      */
-    if (*author_count != array->len) {
+    if (author_count != array->len) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(116, node, depth, sem, __func__,
 				    "author_count: %d != array len: %ju",
-				    *author_count, array->len);
+				    author_count, array->len);
 	}
 	return false;
     }
@@ -751,11 +748,11 @@ chk_authors(struct json const *node,
      * allocate array of authors
      */
     errno = 0;		/* pre-clear errno for werrp_sem_val() */
-    aset = calloc((size_t)*author_count, sizeof(aset[0]));
+    aset = calloc((size_t)author_count, sizeof(aset[0]));
     if (aset == NULL) {
 	if (val_err != NULL) {
 	    *val_err = werrp_sem_val(117, node, depth, sem, __func__,
-				     "calloc of %d authors failed", *author_count);
+				     "calloc of %d authors failed", author_count);
 	}
 	return false;
     }
@@ -763,7 +760,7 @@ chk_authors(struct json const *node,
     /*
      * look at each JSON node (author) of node value (JTYPE_ARRAY)
      */
-    for (i=0; i < *author_count; ++i) {
+    for (i=0; i < author_count; ++i) {
 	struct json *e = array->set[i];		/* next item in the JTYPE_ARRAY */
 	bool load = false;			/* true ==> able to load author array item */
 
@@ -780,7 +777,7 @@ chk_authors(struct json const *node,
     /*
      * look at the authors array for unique authors
      */
-    test = test_authors(*author_count, aset);
+    test = test_authors(author_count, aset);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(118, node, depth, sem, __func__,
@@ -1001,7 +998,7 @@ chk_email(struct json const *node,
 	}
 	return false;
     }
-    test = test_email(val.str);
+    test = test_email(val.str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(123, node, depth, sem, __func__, "invalid email");
@@ -1088,14 +1085,13 @@ bool
 chk_entry_num(struct json const *node,
 	      unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    int *value = NULL;				/* JSON_NUMBER as decoded int */
+    int value = 0;				/* JSON_NUMBER as decoded int */
     bool test = false;				/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_int(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_int(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -1103,7 +1099,7 @@ chk_entry_num(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_entry_num(*value);
+    test = test_entry_num(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(125, node, depth, sem, __func__, "invalid entry_num");
@@ -1154,7 +1150,7 @@ chk_extra_file(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_extra_file(str);
+    test = test_extra_file(str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(126, node, depth, sem, __func__, "invalid extra_file filename");
@@ -1294,7 +1290,7 @@ chk_formed_UTC(struct json const *node,
 {
     struct json *parent = NULL;		/* JSON parse tree node parent */
     struct json *formed_timestamp_node = NULL;	/* JSON parse node containing formed_timestamp */
-    time_t *formed_timestamp = NULL;	/* pointer to formed_timestamp as time_t */
+    time_t formed_timestamp = 0;	/* formed_timestamp as time_t */
     char *str = NULL;			/* JTYPE_STRING as decoded JSON string */
     bool test = false;			/* validation test result */
 
@@ -1341,12 +1337,11 @@ chk_formed_UTC(struct json const *node,
     /*
      * obtain the "formed_timestamp" from under the parent node
      */
-    formed_timestamp = sem_member_value_time_t(formed_timestamp_node, depth, sem, __func__, val_err);
-    if (formed_timestamp == NULL) {
+    if (sem_member_value_time_t(formed_timestamp_node, depth, sem, __func__, val_err, &formed_timestamp) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
-    test = test_formed_timestamp(*formed_timestamp);
+    test = test_formed_timestamp(formed_timestamp);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(131, node, depth, sem, __func__, "invalid formed_timestamp");
@@ -1357,7 +1352,7 @@ chk_formed_UTC(struct json const *node,
     /*
      * verify that formed_UTC timestamp is same as formed_timestamp
      */
-    test = timestr_eq_tstamp(str, *formed_timestamp);
+    test = timestr_eq_tstamp(str, formed_timestamp);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(132, node, depth, sem, __func__,
@@ -1394,14 +1389,13 @@ bool
 chk_formed_timestamp(struct json const *node,
 	      unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    time_t *value = NULL;			/* JSON_NUMBER as decoded time_t */
+    time_t value = 0;			/* JSON_NUMBER as decoded time_t */
     bool test = false;				/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_time_t(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_time_t(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -1409,7 +1403,7 @@ chk_formed_timestamp(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_formed_timestamp(*value);
+    test = test_formed_timestamp(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(133, node, depth, sem, __func__, "invalid formed_timestamp");
@@ -1445,14 +1439,13 @@ bool
 chk_formed_timestamp_usec(struct json const *node,
 	      unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    int *value = NULL;			/* JSON_NUMBER as decoded int */
+    int value = 0;			/* JSON_NUMBER as decoded int */
     bool test = false;			/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_int(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_int(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -1460,7 +1453,7 @@ chk_formed_timestamp_usec(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_formed_timestamp_usec(*value);
+    test = test_formed_timestamp_usec(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(134, node, depth, sem, __func__, "invalid formed_timestamp_usec");
@@ -1730,7 +1723,7 @@ chk_github(struct json const *node,
 	}
 	return false;
     }
-    test = test_github(val.str);
+    test = test_github(val.str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(140, node, depth, sem, __func__, "invalid github");
@@ -1919,14 +1912,13 @@ bool
 chk_IOCCC_year(struct json const *node,
 	       unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    int *value = NULL;			/* JSON_NUMBER as decoded int */
+    int value = 0;			/* JSON_NUMBER as decoded int */
     bool test = false;			/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_int(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_int(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -1934,7 +1926,7 @@ chk_IOCCC_year(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_IOCCC_year(*value);
+    test = test_IOCCC_year(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(144, node, depth, sem, __func__, "invalid IOCCC_year");
@@ -2273,14 +2265,13 @@ bool
 chk_min_timestamp(struct json const *node,
 		  unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    time_t *value = NULL;			/* JSON_NUMBER as decoded time_t */
+    time_t value = 0;			/* JSON_NUMBER as decoded time_t */
     bool test = false;				/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_time_t(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_time_t(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -2288,7 +2279,7 @@ chk_min_timestamp(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_min_timestamp(*value);
+    test = test_min_timestamp(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(153, node, depth, sem, __func__, "invalid min_timestamp");
@@ -2390,7 +2381,7 @@ chk_name(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_name(str);
+    test = test_name(str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(155, node, depth, sem, __func__, "invalid name");
@@ -2732,14 +2723,13 @@ bool
 chk_rule_2a_size(struct json const *node,
 	     unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    int *value = NULL;				/* JSON_NUMBER as decoded int */
+    int value = 0;				/* JSON_NUMBER as decoded int */
     bool test = false;				/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_int(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_int(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -2747,7 +2737,7 @@ chk_rule_2a_size(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_rule_2a_size(*value);
+    test = test_rule_2a_size(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(162, node, depth, sem, __func__, "invalid rule_2a_size");
@@ -2834,14 +2824,13 @@ bool
 chk_rule_2b_size(struct json const *node,
 	     unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err)
 {
-    size_t *value = NULL;				/* JSON_NUMBER as decoded size_t */
+    size_t value = 0;				/* JSON_NUMBER as decoded size_t */
     bool test = false;				/* validation test result */
 
     /*
      * firewall - args and JSON number as int check
      */
-    value = sem_member_value_size_t(node, depth, sem, __func__, val_err);
-    if (value == NULL) {
+    if (sem_member_value_size_t(node, depth, sem, __func__, val_err, &value) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
@@ -2849,7 +2838,7 @@ chk_rule_2b_size(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_rule_2b_size(*value);
+    test = test_rule_2b_size(value);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(164, node, depth, sem, __func__, "invalid rule_2b_size");
@@ -2890,11 +2879,11 @@ chk_tarball(struct json const *node,
     struct json *IOCCC_contest_id_node = NULL;	/* JSON parse node containing IOCCC_contest_id */
     char const *IOCCC_contest_id = NULL;	/* pointer to author count as int from JSON parse node for IOCCC_contest_id */
     struct json *entry_num_node = NULL;		/* JSON parse node containing entry_num */
-    int *entry_num = NULL;			/* pointer to author count as int from JSON parse node for entry_num */
+    int entry_num = 0;			/* author count as int from JSON parse node for entry_num */
     struct json *test_mode_node = NULL;		/* JSON parse node containing test_mode */
     bool *test_mode = NULL;			/* pointer to author count as int from JSON parse node for test_mode */
     struct json *formed_timestamp_node = NULL;	/* JSON parse node containing formed_timestamp */
-    time_t *formed_timestamp = NULL;		/* pointer to formed_timestamp as time_t */
+    time_t formed_timestamp = 0;		/* formed_timestamp as time_t */
     bool test = false;				/* validation test result */
 
     /*
@@ -2980,12 +2969,11 @@ chk_tarball(struct json const *node,
     /*
      * obtain the entry number
      */
-    entry_num = sem_member_value_int(entry_num_node, depth, sem, __func__, val_err);
-    if (entry_num == NULL) {
+    if (sem_member_value_int(entry_num_node, depth, sem, __func__, val_err, &entry_num) == false) {
 	/* sem_member_value_int() will have set *val_err */
 	return false;
     }
-    test = test_entry_num(*entry_num);
+    test = test_entry_num(entry_num);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(167, node, depth, sem, __func__, "invalid entry_num");
@@ -3034,12 +3022,11 @@ chk_tarball(struct json const *node,
     /*
      * obtain the "formed_timestamp" from under the parent node
      */
-    formed_timestamp = sem_member_value_time_t(formed_timestamp_node, depth, sem, __func__, val_err);
-    if (formed_timestamp == NULL) {
+    if (sem_member_value_time_t(formed_timestamp_node, depth, sem, __func__, val_err, &formed_timestamp) == false) {
 	/* sem_member_value_time_t() will have set *val_err */
 	return false;
     }
-    test = test_formed_timestamp(*formed_timestamp);
+    test = test_formed_timestamp(formed_timestamp);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(169, node, depth, sem, __func__, "invalid formed_timestamp");
@@ -3050,7 +3037,7 @@ chk_tarball(struct json const *node,
     /*
      * test the tarball with related data
      */
-    test = test_tarball(str, IOCCC_contest_id, *entry_num, *test_mode, *formed_timestamp);
+    test = test_tarball(str, IOCCC_contest_id, entry_num, *test_mode, formed_timestamp);
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(170, node, depth, sem, __func__, "invalid tarball");
@@ -3203,7 +3190,7 @@ chk_title(struct json const *node,
     /*
      * validate decoded JSON string
      */
-    test = test_title(str);
+    test = test_title(str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(173, node, depth, sem, __func__, "invalid title");
@@ -3320,7 +3307,7 @@ chk_mastodon(struct json const *node,
 	}
 	return false;
     }
-    test = test_mastodon(val.str);
+    test = test_mastodon(val.str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(176, node, depth, sem, __func__, "invalid mastodon");
@@ -3488,7 +3475,7 @@ chk_alt_url(struct json const *node,
 	}
 	return false;
     }
-    test = test_url(val.str);
+    test = test_url(val.str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(180, node, depth, sem, __func__, "invalid url");
@@ -3554,7 +3541,7 @@ chk_url(struct json const *node,
 	}
 	return false;
     }
-    test = test_url(val.str);
+    test = test_url(val.str, sem_member_value_str_prop(node));
     if (test == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(182, node, depth, sem, __func__, "invalid url");
@@ -498,10 +498,18 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
     bool found_author_number = false;	/* true ==> found author_number in node */
     struct json_object *obj = NULL;	/* JSON node as JTYPE_OBJECT */
     int obj_len = 0;			/* length in JTYPE_MEMBER of the JSON node as JTYPE_OBJECT */
+    struct json const *name_member = NULL;	/* JTYPE_MEMBER of name or NULL */
+    struct json const *email_member = NULL;	/* JTYPE_MEMBER of email or NULL */
+    struct json const *url_member = NULL;	/* JTYPE_MEMBER of url or NULL */
+    struct json const *alt_url_member = NULL;	/* JTYPE_MEMBER of alt_url or NULL */
+    struct json const *mastodon_member = NULL;	/* JTYPE_MEMBER of mastodon or NULL */
+    struct json const *github_member = NULL;	/* JTYPE_MEMBER of github or NULL */
+    struct json const *affiliation_member = NULL;	/* JTYPE_MEMBER of affiliation or NULL */
+    struct json const *author_handle_member = NULL;	/* JTYPE_MEMBER of author_handle or NULL */
     bool test = false;			/* validation test result */
     struct str_or_null val_or_null;	/* JTYPE_MEMBER value that can be a JTYPE_STRING or JTYPE_NULL */
     bool *bool_val = NULL;		/* pointer to a converted JTYPE_BOOL */
-    int *int_val = NULL;		/* pointer to a converted JTYPE_NUMBER as int */
+    int int_val = 0;		/* a converted JTYPE_NUMBER as int */
     int i;
 
     /*
@@ -598,6 +606,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		return false;
 	    }
 	    found_name = true;
+	    name_member = e;
 
 	    /* obtain value as JTYPE_STRING */
 	    auth_name = sem_member_value_decoded_str(e, depth+2, sem, __func__, NULL);
@@ -652,6 +661,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		return false;
 	    }
 	    found_email = true;
+	    email_member = e;
 
 	    /* obtain value as JTYPE_STRING or JTYPE_NULL */
 	    val_or_null = sem_member_value_str_or_null(e, depth+2, sem, __func__, NULL);
@@ -684,6 +694,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		return false;
 	    }
 	    found_url = true;
+	    url_member = e;
 
 	    /* obtain value as JTYPE_STRING or JTYPE_NULL */
 	    val_or_null = sem_member_value_str_or_null(e, depth+2, sem, __func__, NULL);
@@ -716,6 +727,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		return false;
 	    }
 	    found_alt_url = true;
+	    alt_url_member = e;
 
 	    /* obtain value as JTYPE_STRING or JTYPE_NULL */
 	    val_or_null = sem_member_value_str_or_null(e, depth+2, sem, __func__, NULL);
@@ -748,6 +760,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		return false;
 	    }
 	    found_mastodon = true;
+	    mastodon_member = e;
 
 	    /* obtain value as JTYPE_STRING or JTYPE_NULL */
 	    val_or_null = sem_member_value_str_or_null(e, depth+2, sem, __func__, NULL);
@@ -780,6 +793,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		return false;
 	    }
 	    found_github = true;
+	    github_member = e;
 
 	    /* obtain value as JTYPE_STRING or JTYPE_NULL */
 	    val_or_null = sem_member_value_str_or_null(e, depth+2, sem, __func__, NULL);
@@ -812,6 +826,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		return false;
 	    }
 	    found_affiliation = true;
+	    affiliation_member = e;
 
 	    /* obtain value as JTYPE_STRING or JTYPE_NULL */
 	    val_or_null = sem_member_value_str_or_null(e, depth+2, sem, __func__, NULL);
@@ -896,6 +911,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		return false;
 	    }
 	    found_author_handle = true;
+	    author_handle_member = e;
 
 	    /* obtain value as JTYPE_STRING */
 	    author_handle = sem_member_value_decoded_str(e, depth+2, sem, __func__, NULL);
@@ -916,8 +932,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 	    found_author_number = true;
 
 	    /* obtain value as JTYPE_NUMBER as int */
-	    int_val = sem_member_value_int(e, depth+2, sem, __func__, NULL);
-	    if (int_val == NULL) {
+	    if (sem_member_value_int(e, depth+2, sem, __func__, NULL, &int_val) == false) {
 		if (val_err != NULL) {
 		    *val_err = werr_sem_val(81, e, depth+2, sem, __func__,
 					    "author array index[%d] JTYPE_OBJECT[%d] invalid author number",
@@ -925,7 +940,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 		}
 		return false;
 	    }
-	    author_number = *int_val;
+	    author_number = int_val;
 
 	/* case: invalid JTYPE_MEMBER - not part of an IOCCC author's JTYPE_OBJECT */
 	} else {
@@ -1091,7 +1106,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
     /*
      * validate elements
      */
-    if (test_name(auth_name) == false) {
+    if (test_name(auth_name, sem_member_value_str_prop(name_member)) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(100, node, depth, sem, __func__,
 				    "author array index[%d]: auth_name is invalid", author_num);
@@ -1112,7 +1127,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 	}
 	return false;
     }
-    if (email_withheld == false && test_email(email) == false) {
+    if (email_withheld == false && test_email(email, sem_member_value_str_prop(email_member)) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(103, node, depth, sem, __func__,
 				    "author array index[%d]: email is invalid", author_num);
@@ -1120,14 +1135,14 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 	return false;
     }
 
-    if (url_withheld == false && test_url(url) == false) {
+    if (url_withheld == false && test_url(url, sem_member_value_str_prop(url_member)) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(104, node, depth, sem, __func__,
 				    "author array index[%d]: url is invalid", author_num);
 	}
 	return false;
     }
-    if (alt_url_withheld == false && test_alt_url(alt_url) == false) {
+    if (alt_url_withheld == false && test_alt_url(alt_url, sem_member_value_str_prop(alt_url_member)) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(105, node, depth, sem, __func__,
 				    "author array index[%d]: alt_url is invalid", author_num);
@@ -1136,21 +1151,21 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
     }
 
 
-    if (mastodon_withheld == false && test_mastodon(mastodon) == false) {
+    if (mastodon_withheld == false && test_mastodon(mastodon, sem_member_value_str_prop(mastodon_member)) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(106, node, depth, sem, __func__,
 				    "author array index[%d]: mastodon is invalid", author_num);
 	}
 	return false;
     }
-    if (github_withheld == false && test_github(github) == false) {
+    if (github_withheld == false && test_github(github, sem_member_value_str_prop(github_member)) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(107, node, depth, sem, __func__,
 				    "author array index[%d]: github is invalid", author_num);
 	}
 	return false;
     }
-    if (affiliation_withheld == false && test_affiliation(affiliation) == false) {
+    if (affiliation_withheld == false && test_affiliation(affiliation, sem_member_value_str_prop(affiliation_member)) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(108, node, depth, sem, __func__,
 				    "author array index[%d]: affiliation is invalid", author_num);
@@ -1171,7 +1186,7 @@ object2author(struct json *node, unsigned int depth, struct json_sem *sem,
 	}
 	return false;
     }
-    if (test_author_handle(author_handle) == false) {
+    if (test_author_handle(author_handle, sem_member_value_str_prop(author_handle_member)) == false) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(111, node, depth, sem, __func__,
 				    "author array index[%d]: author_handle is invalid", author_num);
@@ -1661,7 +1676,7 @@ object2manifest(struct json *node, unsigned int depth, struct json_sem *sem,
 	} else if (strcmp(arr_name, "extra_file") == 0) {
 
 	    /* validate extra_file filename */
-	    test = test_extra_file(value);
+	    test = test_extra_file(value, sem_member_value_str_prop(jo));
 	    if (test == false) {
 		if (val_err != NULL) {
 		    *val_err = werr_sem_val(142, jo, depth+2, sem, __func__,
@@ -2162,14 +2177,16 @@ test_Makefile_override(bool boolean)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
  *	false ==> string is NOT valid, or NULL pointer, or some internal error
  */
 bool
-test_abstract(char const *str)
+test_abstract(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;		/* length of string */
 
     /*
@@ -2180,10 +2197,18 @@ test_abstract(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
-    length = strlen(str);
+    length = prop->len;
     /* check for a valid length */
     if (length <= 0) {
 	json_dbg(JSON_DBG_MED, __func__,
@@ -2208,14 +2233,16 @@ test_abstract(char const *str)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
  *	false ==> string is NOT valid, or NULL pointer, or some internal error
  */
 bool
-test_affiliation(char const *str)
+test_affiliation(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;
 
     /*
@@ -2226,6 +2253,14 @@ test_affiliation(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
@@ -2235,7 +2270,7 @@ test_affiliation(char const *str)
 		 "invalid: empty affiliation");
 	return false;
     }
-    length = strlen(str);
+    length = prop->len;
     if (length > MAX_AFFILIATION_LEN) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: affiliation length %ju > max %d", (uintmax_t)length, MAX_AFFILIATION_LEN);
@@ -2325,14 +2360,16 @@ test_author_count(int author_count)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
  *	false ==> string is NOT valid, or NULL pointer, or some internal error
  */
 bool
-test_author_handle(char const *str)
+test_author_handle(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;		/* length of string */
     bool test = false;		/* character test result */
 
@@ -2344,10 +2381,18 @@ test_author_handle(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
-    length = strlen(str);
+    length = prop->len;
     /* check for a valid length */
     if (length <= 0) {
 	json_dbg(JSON_DBG_MED, __func__,
@@ -2361,7 +2406,7 @@ test_author_handle(char const *str)
 	return false;
     }
     /* IOCCC author handle must use only lower case POSIX portable filename and + chars */
-    test = posix_plus_safe(str, false, false, true);
+    test = prop->posix_plus_safe;
     if (test == false) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: author_handle does not match regexp: ^[0-9a-z][0-9a-z._+-]*$");
@@ -2705,6 +2750,7 @@ test_default_handle(bool boolean)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
@@ -2717,10 +2763,10 @@ test_default_handle(bool boolean)
  * Official Standard: RFC 5322' for details.
  */
 bool
-test_email(char const *str)
+test_email(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;
-    char *p = NULL;		/* location of @ */
 
     /*
      * firewall
@@ -2730,6 +2776,14 @@ test_email(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
@@ -2737,7 +2791,7 @@ test_email(char const *str)
     /*
      * reject if too long or empty
      */
-    length = strlen(str);
+    length = prop->len;
     if (length == 0) {
 	json_dbg(JSON_DBG_MED, __func__, "email is empty (address withheld)");
 	return true;
@@ -2752,8 +2806,7 @@ test_email(char const *str)
     /*
      * reject if no @ or the first char is @ or the last char is @ or if more than one @
      */
-    p = strchr(str, '@');
-    if (p == NULL) {
+    if (prop->at_count == 0) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: email is missing @");
 	json_dbg(JSON_DBG_HIGH, __func__,
@@ -2771,7 +2824,7 @@ test_email(char const *str)
 	json_dbg(JSON_DBG_HIGH, __func__,
 		 "invalid: email <%s> ends with @", str);
 	return false;
-    } else if (p != strrchr(str, '@')) {
+    } else if (prop->at_count > 1) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: email contains 2 or more @");
 	json_dbg(JSON_DBG_HIGH, __func__,
@@ -2849,14 +2902,16 @@ test_entry_num(int entry_num)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
  *	false ==> string is NOT valid, or NULL pointer, or some internal error
  */
 bool
-test_extra_file(char const *str)
+test_extra_file(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     /*
      * firewall
      */
@@ -2865,12 +2920,20 @@ test_extra_file(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
 
     /* validate that the filename is POSIX portable safe plus + chars */
-    if (posix_plus_safe(str, false, false, true) == false) {
+    if (prop->posix_plus_safe == false) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: posix_plus_safe check on extra_file failed");
 	json_dbg(JSON_DBG_HIGH, __func__,
@@ -3203,18 +3266,18 @@ test_found_try_rule(bool boolean)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
  *	false ==> string is NOT valid, or NULL pointer, or some internal error
  */
 bool
-test_github(char const *str)
+test_github(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;
 
-    char *p = NULL;
-
     /*
      * firewall
      */
@@ -3223,6 +3286,14 @@ test_github(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
@@ -3232,7 +3303,7 @@ test_github(char const *str)
 		 "empty github is invalid");
 	return false;
     }
-    length = strlen(str);
+    length = prop->len;
     if (length > MAX_GITHUB_LEN) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: github length %ju > max %d: <%s>", (uintmax_t)length, MAX_GITHUB_LEN, str);
@@ -3241,14 +3312,13 @@ test_github(char const *str)
 	return false;
     }
     /* check for valid github account chars */
-    p = strchr(str, '@');
-    if (p == NULL || str[0] != '@') {
+    if (str[0] != '@') {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: github account does not start with '@'");
 	json_dbg(JSON_DBG_HIGH, __func__,
 		 "invalid: github: <%s> is invalid", str);
 	return false;
-    } else if (p != strrchr(str, '@')) {
+    } else if (prop->at_count > 1) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: github account has more than one '@'");
 	json_dbg(JSON_DBG_HIGH, __func__,
@@ -3534,7 +3604,8 @@ test_location_name(char const *str)
  * test_manifest - test is the manifest is complete and has unique extra files
  *
  * We verify that the manifest has all of the required files, and that if
- * there are extra files, those files are valid and unique.
+ * there are extra files, those files are unique.  The extra filenames are
+ * validated by object2manifest() as it forms the manifest.
  *
  * The IOCCC manifest MUST contain 1 and only 1 of these mandatory files:
  *
@@ -3564,7 +3635,6 @@ bool
 test_manifest(struct manifest *manp)
 {
     intmax_t count_extra_file = -1;		/* number of extra files */
-    bool test = false;			/* test_extra_file() test result */
     char *extra_filename = NULL;	/* filename of an extra file */
     char *extra_filename2 = NULL;	/* second filename of an extra file */
     intmax_t i;
@@ -3630,7 +3700,11 @@ test_manifest(struct manifest *manp)
     }
 
     /*
-     * verify that extra files are valid filenames and do not match a mandatory file
+     * verify that there is a filename for each extra file
+     *
+     * NOTE: object2manifest() only adds an extra filename to the manifest
+     *	     once test_extra_file() has validated it, with the properties of
+     *	     its decoded JSON string, so it is not tested again here.
      */
     for (i=0; i < count_extra_file; ++i) {
 
@@ -3641,16 +3715,6 @@ test_manifest(struct manifest *manp)
 		     "invalid: manifest extra[%jd] is NULL", i);
 	    return false;
 	}
-
-	/* validate filename for this extra file */
-	test = test_extra_file(extra_filename);
-	if (test == false) {
-	    json_dbg(JSON_DBG_MED, __func__,
-		     "invalid: manifest extra[%jd] filename is invalid", i);
-	    json_dbg(JSON_DBG_HIGH, __func__,
-		     "invalid: manifest extra[%jd] filename: <%s> is invalid", i, extra_filename);
-	    return false;
-	}
     }
 
     /*
@@ -3798,6 +3862,7 @@ test_mkiocccentry_version(char const *str)
  *
  * given:
  *	str	name to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid
@@ -3805,8 +3870,9 @@ test_mkiocccentry_version(char const *str)
  *
  */
 bool
-test_name(char const *str)
+test_name(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length;
 
     /*
@@ -3817,7 +3883,15 @@ test_name(char const *str)
 	return false;
     }
 
-    length = strlen(str);
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
+    length = prop->len;
     if (length <= 0) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: empty name");
@@ -4314,14 +4388,16 @@ test_timestamp_epoch(char const *str)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
  *	false ==> string is NOT valid, or NULL pointer, or some internal error
  */
 bool
-test_title(char const *str)
+test_title(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;
 
     /*
@@ -4332,6 +4408,14 @@ test_title(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
@@ -4341,7 +4425,7 @@ test_title(char const *str)
 		 "invalid: empty title");
 	return false;
     }
-    length = strlen(str);
+    length = prop->len;
     if (length > MAX_TITLE_LEN) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: title length %ju > max %d: <%s>", (uintmax_t)length, MAX_TITLE_LEN, str);
@@ -4350,7 +4434,7 @@ test_title(char const *str)
 	return false;
     }
     /* check for valid title chars */
-    if (!posix_plus_safe(str, true, false, true)) {
+    if (prop->posix_plus_safe == false || prop->upper == true) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: title does not match regexp ^[0-9a-z][0-9a-z._+-]*$: '%s'", str);
 	json_dbg(JSON_DBG_HIGH, __func__,
@@ -4392,6 +4476,7 @@ test_trigraph_warning(bool boolean)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
@@ -4404,11 +4489,10 @@ test_trigraph_warning(bool boolean)
  * Official Standard: RFC 5322' for details.
  */
 bool
-test_mastodon(char const *str)
+test_mastodon(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;
-    char *p = NULL;
-    char *last_at = NULL;
 
     /*
      * firewall
@@ -4418,6 +4502,14 @@ test_mastodon(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
@@ -4427,7 +4519,7 @@ test_mastodon(char const *str)
 		 "empty mastodon is invalid");
 	return false;
     }
-    length = strlen(str);
+    length = prop->len;
     if (length > MAX_MASTODON_LEN) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: mastodon length %ju > max %d: <%s>", (uintmax_t)length, MAX_MASTODON_LEN, str);
@@ -4436,9 +4528,7 @@ test_mastodon(char const *str)
 	return false;
     }
     /* check for valid mastodon account chars */
-    p = strchr(str, '@');
-    last_at = strrchr(str, '@');
-    if (p == NULL || str[0] != '@') {
+    if (str[0] != '@') {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: mastodon account does not start with '@'");
 	json_dbg(JSON_DBG_HIGH, __func__,
@@ -4450,19 +4540,19 @@ test_mastodon(char const *str)
 	json_dbg(JSON_DBG_HIGH, __func__,
 		 "invalid: mastodon: <%s> is invalid", str);
 	return false;
-    } else if (last_at == NULL || last_at == p) {
+    } else if (prop->at_count == 1) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: mastodon account has only one '@'");
 	json_dbg(JSON_DBG_HIGH, __func__,
 		 "invalid: mastodon: <%s> is invalid", str);
 	return false;
-    } else if (strstr(str, "@@") != NULL) {
+    } else if (prop->adjacent_at == true) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: mastodon account has adjacent '@'s");
 	json_dbg(JSON_DBG_HIGH, __func__,
 		 "invalid: mastodon: <%s> is invalid", str);
 	return false;
-    } else if (count_char(str, '@') != 2) {
+    } else if (prop->at_count != 2) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: mastodon account does not have exactly two '@'s");
 	json_dbg(JSON_DBG_HIGH, __func__,
@@ -4558,14 +4648,16 @@ test_ungetc_warning(bool boolean)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
  *	false ==> string is NOT valid, or NULL pointer, or some internal error
  */
 bool
-test_alt_url(char const *str)
+test_alt_url(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;
 
     /*
@@ -4576,6 +4668,14 @@ test_alt_url(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
@@ -4585,7 +4685,7 @@ test_alt_url(char const *str)
 		 "empty alt_url is invalid");
 	return false;
     }
-    length = strlen(str);
+    length = prop->len;
     if (length > MAX_URL_LEN) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: alt_url length %ju > max %d: <%s>", (uintmax_t)length, MAX_URL_LEN, str);
@@ -4667,14 +4767,16 @@ test_alt_url(char const *str)
  *
  * given:
  *	str	string to test
+ *	prop	properties of str (see str_prop_chk()) or NULL ==> find them here
  *
  * returns:
  *	true ==> string is valid,
  *	false ==> string is NOT valid, or NULL pointer, or some internal error
  */
 bool
-test_url(char const *str)
+test_url(char const *str, struct str_prop const *prop)
 {
+    struct str_prop scan;		/* properties of str when prop is NULL */
     size_t length = 0;
 
     /*
@@ -4685,6 +4787,14 @@ test_url(char const *str)
 	return false;
     }
 
+    /*
+     * find the properties of str unless the caller has them
+     */
+    if (prop == NULL) {
+	str_prop_chk(str, strlen(str), &scan);
+	prop = &scan;
+    }
+
     /*
      * validate str
      */
@@ -4694,7 +4804,7 @@ test_url(char const *str)
 		 "empty url is invalid");
 	return false;
     }
-    length = strlen(str);
+    length = prop->len;
     if (length > MAX_URL_LEN) {
 	json_dbg(JSON_DBG_MED, __func__,
 		 "invalid: url length %ju > max %d: <%s>", (uintmax_t)length, MAX_URL_LEN, str);
@@ -219,20 +219,20 @@ extern bool test_IOCCC_contest_id(char const *str);
 extern bool test_IOCCC_info_version(char const *str);
 extern bool test_Makefile(char const *str);
 extern bool test_Makefile_override(bool boolean);
-extern bool test_abstract(char const *str);
-extern bool test_affiliation(char const *str);
+extern bool test_abstract(char const *str, struct str_prop const *prop);
+extern bool test_affiliation(char const *str, struct str_prop const *prop);
 extern bool test_auth_JSON(char const *str);
 extern bool test_author_count(int author_count);
-extern bool test_author_handle(char const *str);
+extern bool test_author_handle(char const *str, struct str_prop const *prop);
 extern bool test_author_number(int author_number);
 extern bool test_authors(int author_count, struct author const *authorp);
 extern bool test_c_src(char const *str);
 extern bool test_chkentry_version(char const *str);
 extern bool test_default_handle(bool boolean);
-extern bool test_email(char const *str);
+extern bool test_email(char const *str, struct str_prop const *prop);
 extern bool test_empty_override(bool boolean);
 extern bool test_entry_num(int entry_num);
-extern bool test_extra_file(char const *str);
+extern bool test_extra_file(char const *str, struct str_prop const *prop);
 extern bool test_first_rule_is_all(bool boolean);
 extern bool test_fnamchk_version(char const *str);
 extern bool test_formed_timestamp(time_t tstamp);
@@ -241,7 +241,7 @@ extern bool test_found_all_rule(bool boolean);
 extern bool test_found_clean_rule(bool boolean);
 extern bool test_found_clobber_rule(bool boolean);
 extern bool test_found_try_rule(bool boolean);
-extern bool test_github(char const *str);
+extern bool test_github(char const *str, struct str_prop const *prop);
 extern bool test_highbit_warning(bool boolean);
 extern bool test_info_JSON(char const *str);
 extern bool test_IOCCC_contest(char const *str);
@@ -252,7 +252,7 @@ extern bool test_location_name(char const *str);
 extern bool test_manifest(struct manifest *manp);
 extern bool test_min_timestamp(time_t tstamp);
 extern bool test_mkiocccentry_version(char const *str);
-extern bool test_name(char const *str);
+extern bool test_name(char const *str, struct str_prop const *prop);
 extern bool test_no_comment(char const *str);
 extern bool test_nul_warning(bool boolean);
 extern bool test_past_winner(bool boolean);
@@ -266,13 +266,13 @@ extern bool test_tarball(char const *str, char const *IOCCC_contest_id, int entr
 			 time_t formed_timestamp);
 extern bool test_test_mode(bool boolean);
 extern bool test_timestamp_epoch(char const *str);
-extern bool test_title(char const *str);
+extern bool test_title(char const *str, struct str_prop const *prop);
 extern bool test_trigraph_warning(bool boolean);
-extern bool test_mastodon(char const *str);
+extern bool test_mastodon(char const *str, struct str_prop const *prop);
 extern bool test_txzchk_version(char const *str);
 extern bool test_ungetc_warning(bool boolean);
-extern bool test_url(char const *str);
-extern bool test_alt_url(char const *str);
+extern bool test_url(char const *str, struct str_prop const *prop);
+extern bool test_alt_url(char const *str, struct str_prop const *prop);
 extern bool test_wordbuf_warning(bool boolean);
 
 
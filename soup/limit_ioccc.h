@@ -77,6 +77,20 @@
 #define MIN_TIMESTAMP ((time_t)1675547786)
 
 
+/*
+ * resource limits on parsing the .info.json and .auth.json files of an entry
+ *
+ * These are far above what mkiocccentry writes for the largest entry, yet
+ * small enough that a hostile JSON file is rejected before it costs much.
+ */
+#define MAX_ENTRY_JSON_BYTES ((size_t)(64*1024))	/* max length of an entry JSON file */
+#define MAX_ENTRY_JSON_DEPTH (16)		/* max nesting depth of an entry JSON file */
+#define MAX_ENTRY_JSON_NODES (8192)		/* max JSON nodes of an entry JSON file */
+#define MAX_ENTRY_JSON_STR_LEN ((size_t)(4096))	/* max JSON string length of an entry JSON file */
+#define MAX_ENTRY_JSON_NUM_LEN ((size_t)(64))	/* max JSON number length of an entry JSON file */
+#define MAX_ENTRY_JSON_MEMBERS (256)		/* max members of a JSON object of an entry JSON file */
+
+
 /*
  * IOCCC contest name
  *
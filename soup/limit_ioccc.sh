@@ -0,0 +1,56 @@
+export RUN_BISON_VERSION="1.0 2023-02-04"
+export MIN_BISON_VERSION="3.8.2"		# minimum bison version needed to build the JSON parser
+export RUN_FLEX_VERSION="1.0 2023-02-04"
+export MIN_FLEX_VERSION="2.6.4"		# minimum flex version needed to build the JSON parser
+export RULE_2A_SIZE="4096"
+export RULE_2B_SIZE="2503"
+export MAX_TARBALL_LEN="3999971"
+export MAX_SUM_FILELEN="27651*1024"
+export MAX_FILE_COUNT="42"
+export MAX_ENTRY_NUM="9"
+export MAX_ENTRY_CHARS="1"
+export MAX_AUTHORS="5"
+export MAX_AUTHORS_CHARS="1"
+export MAX_NAME_LEN="48"
+export MAX_EMAIL_LEN="48"
+export MAX_URL_LEN="64"
+export MAX_MASTODON_LEN="20+64"
+export MAX_GITHUB_LEN="16"
+export MAX_AFFILIATION_LEN="48"
+export MAX_TITLE_LEN="32"
+export MAX_ABSTRACT_LEN="64"
+export MAX_HANDLE="32"
+export MAX_BASENAME_LEN="99"
+export UUID_LEN="36"
+export UUID_VERSION="4"
+export UUID_VARIANT="0"
+export MAX_TIMESTAMP_LEN="48"
+export MAX_CLOCK_ERROR="42*60-1"
+export MIN_TIMESTAMP="1675547786"
+export MAX_ENTRY_JSON_BYTES="64*1024"
+export MAX_ENTRY_JSON_DEPTH="16"
+export MAX_ENTRY_JSON_NODES="8192"
+export MAX_ENTRY_JSON_STR_LEN="4096"
+export MAX_ENTRY_JSON_NUM_LEN="64"
+export MAX_ENTRY_JSON_MEMBERS="256"
+export IOCCC_CONTEST="IOCCCMOCK"
+export IOCCC_YEAR="2023"
+export MKIOCCCENTRY_REPO_VERSION="1.0.1 2023-02-14"
+export SOUP_VERSION="1.2 2026-10-16"
+export IOCCCSIZE_VERSION="28.13 2023-02-04"
+export MKIOCCCENTRY_VERSION="1.0.1 2023-07-22"
+export INFO_VERSION="1.14 2023-02-04"
+export AUTH_VERSION="1.19 2023-02-04"
+export FNAMCHK_VERSION="1.0 2023-02-04"
+export TXZCHK_VERSION="1.0.1 2023-06-16"
+export CHKENTRY_VERSION="1.0 2023-02-04"
+export TIMESTAMP_EPOCH="Thu Jan 01 00:00:00 1970 UTC"
+export JSON_PARSING_DIRECTIVE_NAME="no_comment"
+export JSON_PARSING_DIRECTIVE_VALUE="mandatory comment: because comments were removed from the original JSON spec"
+export DBG_VERSION="3.0 2023-08-05"
+export DYN_ARRAY_VERSION="2.4 2026-10-16"
+export JPARSE_VERSION="1.1.12 2026-10-16"
+export JSON_PARSER_VERSION="1.1.26 2026-10-16"
+export VERGE_VERSION="1.0 2023-02-04"
+export DIGRAPHS=
+export TRIGRAPHS=
@@ -71,7 +71,7 @@
 /*
  * official soup version (aka recipe :-) )
  */
-#define SOUP_VERSION "1.1 2023-02-04"		/* format: major.minor YYYY-MM-DD */
+#define SOUP_VERSION "1.2 2026-10-16"		/* format: major.minor YYYY-MM-DD */
 
 /*
  * official iocccsize version
@@ -517,6 +517,295 @@ else
     echo "PASSED: jparse/test_jparse/jparse_test.sh for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
 fi
 
+# jparse_test.sh -E for test_jparse/test_JSON
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: jparse/test_jparse/jparse_test.sh -E for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+echo "jparse/test_jparse/jparse_test.sh -E -J $V_FLAG -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt" | tee -a -- "$LOGFILE"
+jparse/test_jparse/jparse_test.sh -E -J "$V_FLAG" -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: jparse/test_jparse/jparse_test.sh -E for test_jparse/test_JSON non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    jparse/test_jparse/jparse_test.sh -E for test_jparse/test_JSON non-zero exit code: $status"
+    EXIT_CODE="29"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: jparse/test_jparse/jparse_test.sh -E for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: jparse/test_jparse/jparse_test.sh -E for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+fi
+
+# jparse_test.sh -I for test_jparse/test_JSON
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+echo "jparse/test_jparse/jparse_test.sh -I -J $V_FLAG -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt" | tee -a -- "$LOGFILE"
+jparse/test_jparse/jparse_test.sh -I -J "$V_FLAG" -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON non-zero exit code: $status"
+    EXIT_CODE="30"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+fi
+
+# jparse_test.sh -I for test_jparse/test_JSON with each structural index kernel
+#
+# JSON_INDEX_KERNEL forces the kernel so that the kernels that are not the
+# fastest on this CPU are tested too.  A kernel the CPU does not support falls
+# back to the fastest one that it does.
+#
+for kernel in scalar sse2 avx2; do
+    echo | tee -a -- "$LOGFILE"
+    echo "RUNNING: JSON_INDEX_KERNEL=$kernel jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "JSON_INDEX_KERNEL=$kernel jparse/test_jparse/jparse_test.sh -I -J $V_FLAG -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt" | tee -a -- "$LOGFILE"
+    JSON_INDEX_KERNEL="$kernel" jparse/test_jparse/jparse_test.sh -I -J "$V_FLAG" -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt | tee -a -- "$LOGFILE"
+    status="${PIPESTATUS[0]}"
+    if [[ $status -ne 0 ]]; then
+	echo "$0: ERROR: JSON_INDEX_KERNEL=$kernel jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+	FAILURE_SUMMARY="$FAILURE_SUMMARY
+	JSON_INDEX_KERNEL=$kernel jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON non-zero exit code: $status"
+	EXIT_CODE="41"
+	echo | tee -a -- "$LOGFILE"
+	echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+	echo | tee -a -- "$LOGFILE"
+	echo "FAILED: JSON_INDEX_KERNEL=$kernel jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    else
+	echo | tee -a -- "$LOGFILE"
+	echo "PASSED: JSON_INDEX_KERNEL=$kernel jparse/test_jparse/jparse_test.sh -I for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    fi
+done
+
+# jparse_test.sh -c for test_jparse/test_JSON
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: jparse/test_jparse/jparse_test.sh -c for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+echo "jparse/test_jparse/jparse_test.sh -c -J $V_FLAG -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt" | tee -a -- "$LOGFILE"
+jparse/test_jparse/jparse_test.sh -c -J "$V_FLAG" -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: jparse/test_jparse/jparse_test.sh -c for test_jparse/test_JSON non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    jparse/test_jparse/jparse_test.sh -c for test_jparse/test_JSON non-zero exit code: $status"
+    EXIT_CODE="36"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: jparse/test_jparse/jparse_test.sh -c for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: jparse/test_jparse/jparse_test.sh -c for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+fi
+
+# jparse_test.sh -T for test_jparse/test_JSON
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: jparse/test_jparse/jparse_test.sh -T for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+echo "jparse/test_jparse/jparse_test.sh -T -J $V_FLAG -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt" | tee -a -- "$LOGFILE"
+jparse/test_jparse/jparse_test.sh -T -J "$V_FLAG" -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: jparse/test_jparse/jparse_test.sh -T for test_jparse/test_JSON non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    jparse/test_jparse/jparse_test.sh -T for test_jparse/test_JSON non-zero exit code: $status"
+    EXIT_CODE="34"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: jparse/test_jparse/jparse_test.sh -T for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: jparse/test_jparse/jparse_test.sh -T for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+fi
+
+# jparse_test.sh -T -B for test_jparse/test_JSON
+#
+# The first pass writes the .jtree tape of each good JSON file to a cache
+# directory and the second pass forms the parse trees from those tapes.
+#
+TAPE_DIR=$(mktemp -d .ioccc_test.tape.XXXXXXXXXX)
+for pass in write read; do
+    echo | tee -a -- "$LOGFILE"
+    echo "RUNNING: jparse/test_jparse/jparse_test.sh -T -B to $pass tapes for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "jparse/test_jparse/jparse_test.sh -T -B $TAPE_DIR -J $V_FLAG -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt" | tee -a -- "$LOGFILE"
+    jparse/test_jparse/jparse_test.sh -T -B "$TAPE_DIR" -J "$V_FLAG" -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt | tee -a -- "$LOGFILE"
+    status="${PIPESTATUS[0]}"
+    if [[ $status -ne 0 ]]; then
+	echo "$0: ERROR: jparse/test_jparse/jparse_test.sh -T -B to $pass tapes for test_jparse/test_JSON non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+	FAILURE_SUMMARY="$FAILURE_SUMMARY
+	jparse/test_jparse/jparse_test.sh -T -B to $pass tapes for test_jparse/test_JSON non-zero exit code: $status"
+	EXIT_CODE="35"
+	echo | tee -a -- "$LOGFILE"
+	echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+	echo | tee -a -- "$LOGFILE"
+	echo "FAILED: jparse/test_jparse/jparse_test.sh -T -B to $pass tapes for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    else
+	echo | tee -a -- "$LOGFILE"
+	echo "PASSED: jparse/test_jparse/jparse_test.sh -T -B to $pass tapes for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    fi
+done
+rm -rf "$TAPE_DIR"
+
+# jparse_test.sh -P for test_jparse/test_JSON
+#
+# Each JSON document is fed to the push parser a byte at a time, and then in
+# pieces of a size that does not divide the tokens evenly.
+#
+for size in 1 7; do
+    echo | tee -a -- "$LOGFILE"
+    echo "RUNNING: jparse/test_jparse/jparse_test.sh -P $size for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "jparse/test_jparse/jparse_test.sh -P $size -J $V_FLAG -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt" | tee -a -- "$LOGFILE"
+    jparse/test_jparse/jparse_test.sh -P "$size" -J "$V_FLAG" -d ./jparse/test_jparse/test_JSON -s . -j jparse/jparse jparse/test_jparse/json_teststr.txt | tee -a -- "$LOGFILE"
+    status="${PIPESTATUS[0]}"
+    if [[ $status -ne 0 ]]; then
+	echo "$0: ERROR: jparse/test_jparse/jparse_test.sh -P $size for test_jparse/test_JSON non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+	FAILURE_SUMMARY="$FAILURE_SUMMARY
+	jparse/test_jparse/jparse_test.sh -P $size for test_jparse/test_JSON non-zero exit code: $status"
+	EXIT_CODE="38"
+	echo | tee -a -- "$LOGFILE"
+	echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+	echo | tee -a -- "$LOGFILE"
+	echo "FAILED: jparse/test_jparse/jparse_test.sh -P $size for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    else
+	echo | tee -a -- "$LOGFILE"
+	echo "PASSED: jparse/test_jparse/jparse_test.sh -P $size for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+    fi
+done
+
+# jfmt for test_jparse/test_JSON
+#
+# The JSON that jfmt writes for each good JSON file must be valid JSON that
+# jfmt writes again unchanged.
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: jparse/jfmt for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+JFMT_OUT1=$(mktemp .ioccc_test.jfmt1.XXXXXXXXXX)
+JFMT_OUT2=$(mktemp .ioccc_test.jfmt2.XXXXXXXXXX)
+JFMT_FAILED=""
+while read -r file; do
+    echo "jparse/jfmt -v $V_FLAG -- $file" >> "$LOGFILE"
+    if ! jparse/jfmt -v "$V_FLAG" -- "$file" > "$JFMT_OUT1" 2>> "$LOGFILE" ||
+       ! jparse/jparse -q -- "$JFMT_OUT1" >> "$LOGFILE" 2>&1 ||
+       ! jparse/jfmt -v "$V_FLAG" -- "$JFMT_OUT1" > "$JFMT_OUT2" 2>> "$LOGFILE" ||
+       ! cmp -s "$JFMT_OUT1" "$JFMT_OUT2"; then
+	echo "$0: ERROR: jparse/jfmt output of $file is not valid JSON that jfmt writes unchanged" 1>&2 | tee -a -- "$LOGFILE"
+	JFMT_FAILED="$file"
+    fi
+done < <(find jparse/test_jparse/test_JSON -path '*/good/*' -type f -name '*.json')
+rm -f "$JFMT_OUT1" "$JFMT_OUT2"
+if [[ -n "$JFMT_FAILED" ]]; then
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    jparse/jfmt for test_jparse/test_JSON failed"
+    EXIT_CODE="39"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: jparse/jfmt for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: jparse/jfmt for test_jparse/test_JSON" | tee -a -- "$LOGFILE"
+fi
+
+# jparse -L for json_teststr.txt
+#
+# json_teststr.txt holds one JSON document per line, which makes it JSON Lines.
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: jparse/jparse -L -t 4 for json_teststr.txt" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+echo "jparse/jparse -v $V_FLAG -L -t 4 jparse/test_jparse/json_teststr.txt" | tee -a -- "$LOGFILE"
+jparse/jparse -v "$V_FLAG" -L -t 4 jparse/test_jparse/json_teststr.txt | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: jparse/jparse -L -t 4 for json_teststr.txt non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    jparse/jparse -L -t 4 for json_teststr.txt non-zero exit code: $status"
+    EXIT_CODE="33"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: jparse/jparse -L -t 4 for json_teststr.txt" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: jparse/jparse -L -t 4 for json_teststr.txt" | tee -a -- "$LOGFILE"
+fi
+
+# jparse -R for each resource limit
+#
+# Each JSON string is parsed with a limit it crosses, which must fail, and
+# with a limit it is just within, which must pass.
+#
+R_JSON='{"a":[1,[2,[3]]],"b":"hello","c":12345}'
+for limit in "bytes=38 bytes=39" "depth=3 depth=4" "nodes=14 nodes=15" \
+	     "string=6 string=7" "number=4 number=5" "members=2 members=3"; do
+    read -r over within <<< "$limit"
+    echo | tee -a -- "$LOGFILE"
+    echo "RUNNING: jparse/jparse -R $over and -R $within" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "jparse/jparse -v $V_FLAG -q -R $over -s '$R_JSON'" | tee -a -- "$LOGFILE"
+    jparse/jparse -v "$V_FLAG" -q -R "$over" -s "$R_JSON" >> "$LOGFILE" 2>&1
+    over_status="$?"
+    echo "jparse/jparse -v $V_FLAG -q -R $within -s '$R_JSON'" | tee -a -- "$LOGFILE"
+    jparse/jparse -v "$V_FLAG" -q -R "$within" -s "$R_JSON" >> "$LOGFILE" 2>&1
+    status="$?"
+    if [[ $over_status -ne 1 || $status -ne 0 ]]; then
+	echo "$0: ERROR: jparse/jparse -R $over exit code: $over_status != 1 or -R $within exit code: $status != 0" 1>&2 | tee -a -- "$LOGFILE"
+	FAILURE_SUMMARY="$FAILURE_SUMMARY
+	jparse/jparse -R $over exit code: $over_status != 1 or -R $within exit code: $status != 0"
+	EXIT_CODE="37"
+	echo | tee -a -- "$LOGFILE"
+	echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+	echo | tee -a -- "$LOGFILE"
+	echo "FAILED: jparse/jparse -R $over and -R $within" | tee -a -- "$LOGFILE"
+    else
+	echo | tee -a -- "$LOGFILE"
+	echo "PASSED: jparse/jparse -R $over and -R $within" | tee -a -- "$LOGFILE"
+    fi
+done
+
+# jparse -R bytes on a pipe longer than the limit
+#
+# The pipe must be read no further than just beyond the limit, so that head,
+# which has far more to write, is stopped by the closed pipe.
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: jparse/jparse -R bytes=1024 on a pipe" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+echo "yes '[1]' | head -c 67108864 | jparse/jparse -v $V_FLAG -q -R bytes=1024 -" | tee -a -- "$LOGFILE"
+yes '[1]' 2>/dev/null | head -c 67108864 2>/dev/null | jparse/jparse -v "$V_FLAG" -q -R bytes=1024 - >> "$LOGFILE" 2>&1
+read -r yes_status head_status status <<< "${PIPESTATUS[*]}"
+if [[ $head_status -eq 0 || $status -ne 1 ]]; then
+    echo "$0: ERROR: jparse/jparse -R bytes=1024 read all of the pipe or exit code: $status != 1" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    jparse/jparse -R bytes=1024 read all of the pipe or exit code: $status != 1"
+    EXIT_CODE="40"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: jparse/jparse -R bytes=1024 on a pipe" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: jparse/jparse -R bytes=1024 on a pipe" | tee -a -- "$LOGFILE"
+fi
+
 # jparse_test.sh for general.json
 #
 echo | tee -a -- "$LOGFILE"
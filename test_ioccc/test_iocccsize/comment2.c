@@ -0,0 +1,5 @@
+/*
+comment block
+multiline
+*/
+int x;
@@ -0,0 +1,2 @@
+#  include <stdio.h>
+#/*hi*/include <ctype.h>
@@ -0,0 +1,2 @@
+// Will the next line be executed????????????????/
+int a = 666;
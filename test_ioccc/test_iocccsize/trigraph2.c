@@ -0,0 +1,3 @@
+/??/
+* A comment *??/
+/